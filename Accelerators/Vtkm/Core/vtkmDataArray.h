@@ -108,6 +108,11 @@ protected:
   using Superclass::ComputeFiniteVectorRange;
   bool ComputeFiniteVectorRange(
     double range[2], const unsigned char* ghosts, unsigned char ghostsToSkip = 0xff) override;
+  /// Keep using the overrides above instead of a fused pass over the tuples on the host
+  bool ComputeFusedRanges(vtkIdType, vtkIdType, double*, double*, double[2], double[2]) override
+  {
+    return false;
+  }
 
   /// concept methods for \c vtkGenericDataArray
   bool AllocateTuples(vtkIdType numberOfTuples);
@@ -123,6 +123,7 @@ set(vtk_cmake_module_files
   Findutf8cpp.cmake
   FindCGNS.cmake
   FindzSpace.cmake
+  Findzstd.cmake
 
   vtkCMakeBackports.cmake
   vtkDetectLibraryType.cmake
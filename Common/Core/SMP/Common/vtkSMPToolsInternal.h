@@ -4,7 +4,9 @@
 #ifndef vtkSMPToolsInternal_h
 #define vtkSMPToolsInternal_h
 
-#include <iterator> // For std::advance
+#include <algorithm> // For std::min
+#include <iterator>  // For std::advance
+#include <vector>    // For std::vector
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace vtk
@@ -90,6 +92,175 @@ public:
   T operator()(T vtkNotUsed(inValue)) { return Value; }
 };
 
+//--------------------------------------------------------------------------------
+// Blocked scan for backends without a native scan primitive. The range is split in
+// blocks: a first parallel pass reduces each block, the block sums are scanned
+// serially to get the value carried into each block, then a second parallel pass
+// scans each block starting from its carry. Reading an input value always happens
+// before writing the matching output, so the scan can be done in place.
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+class ScanCall
+{
+  InputIt In;
+  OutputIt Out;
+  BinaryOp& Op;
+  vtkIdType Size;
+  vtkIdType BlockSize;
+  vtkIdType NumberOfBlocks;
+  std::vector<T> BlockValues;
+  bool Exclusive;
+
+public:
+  ScanCall(InputIt _in, OutputIt _out, vtkIdType size, vtkIdType numberOfBlocks, BinaryOp& _op,
+    bool exclusive)
+    : In(_in)
+    , Out(_out)
+    , Op(_op)
+    , Size(size)
+    , Exclusive(exclusive)
+  {
+    // Blocks smaller than this are not worth the threading overhead
+    const vtkIdType minimumBlockSize = 1024;
+    numberOfBlocks =
+      (std::max)(vtkIdType(1), (std::min)(numberOfBlocks, size / minimumBlockSize));
+    this->BlockSize = (size + numberOfBlocks - 1) / numberOfBlocks;
+    this->NumberOfBlocks = (size + this->BlockSize - 1) / this->BlockSize;
+    this->BlockValues.resize(static_cast<std::size_t>(this->NumberOfBlocks));
+  }
+
+  vtkIdType GetNumberOfBlocks() const { return this->NumberOfBlocks; }
+
+  // First pass: reduce the blocks in [begin, end)
+  struct ReducePass
+  {
+    ScanCall& Self;
+    void Execute(vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        const vtkIdType first = block * Self.BlockSize;
+        const vtkIdType last = (std::min)(first + Self.BlockSize, Self.Size);
+        InputIt itIn(Self.In);
+        std::advance(itIn, first);
+        T sum = *itIn;
+        ++itIn;
+        for (vtkIdType i = first + 1; i < last; ++i, ++itIn)
+        {
+          sum = Self.Op(sum, *itIn);
+        }
+        Self.BlockValues[block] = sum;
+      }
+    }
+  };
+
+  // Second pass: scan the blocks in [begin, end) from their carried value
+  struct ScanPass
+  {
+    ScanCall& Self;
+    void Execute(vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        const vtkIdType first = block * Self.BlockSize;
+        const vtkIdType last = (std::min)(first + Self.BlockSize, Self.Size);
+        InputIt itIn(Self.In);
+        OutputIt itOut(Self.Out);
+        std::advance(itIn, first);
+        std::advance(itOut, first);
+        vtkIdType i = first;
+        T acc;
+        if (!Self.Exclusive && block == 0)
+        {
+          acc = *itIn;
+          *itOut = acc;
+          ++itIn;
+          ++itOut;
+          ++i;
+        }
+        else
+        {
+          acc = Self.BlockValues[block];
+        }
+        for (; i < last; ++i, ++itIn, ++itOut)
+        {
+          const T value = *itIn;
+          if (Self.Exclusive)
+          {
+            *itOut = acc;
+            acc = Self.Op(acc, value);
+          }
+          else
+          {
+            acc = Self.Op(acc, value);
+            *itOut = acc;
+          }
+        }
+      }
+    }
+  };
+
+  // Run both passes with the given backend. Returns the reduction of `init` with
+  // all the input values (only meaningful for exclusive scans).
+  template <typename Backend>
+  T Run(Backend& backend, T init)
+  {
+    ReducePass reduce{ *this };
+    backend.For(0, this->NumberOfBlocks, 1, reduce);
+
+    // Turn block sums into carries
+    T carry = init;
+    for (vtkIdType block = 0; block < this->NumberOfBlocks; ++block)
+    {
+      const T sum = this->BlockValues[block];
+      if (this->Exclusive)
+      {
+        this->BlockValues[block] = carry;
+        carry = this->Op(carry, sum);
+      }
+      else
+      {
+        this->BlockValues[block] = carry;
+        carry = block == 0 ? sum : this->Op(carry, sum);
+      }
+    }
+
+    ScanPass scan{ *this };
+    backend.For(0, this->NumberOfBlocks, 1, scan);
+    return carry;
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename Backend, typename InputIt, typename OutputIt, typename BinaryOp>
+void InclusiveScanBlocked(Backend& backend, InputIt inBegin, InputIt inEnd, OutputIt outBegin,
+  BinaryOp& op, int numberOfThreads)
+{
+  using T = typename std::iterator_traits<InputIt>::value_type;
+  const vtkIdType size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return;
+  }
+  ScanCall<InputIt, OutputIt, T, BinaryOp> exec(
+    inBegin, outBegin, size, numberOfThreads * 4, op, false);
+  exec.Run(backend, T());
+}
+
+//--------------------------------------------------------------------------------
+template <typename Backend, typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T ExclusiveScanBlocked(Backend& backend, InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init,
+  BinaryOp& op, int numberOfThreads)
+{
+  const vtkIdType size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return init;
+  }
+  ScanCall<InputIt, OutputIt, T, BinaryOp> exec(
+    inBegin, outBegin, size, numberOfThreads * 4, op, true);
+  return exec.Run(backend, init);
+}
+
 VTK_ABI_NAMESPACE_END
 
 } // namespace smp
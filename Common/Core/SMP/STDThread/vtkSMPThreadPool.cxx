@@ -7,9 +7,19 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <condition_variable>
+#include <cstdlib>
+#include <fstream>
 #include <future>
 #include <iostream>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace vtk
 {
@@ -21,6 +31,182 @@ VTK_ABI_NAMESPACE_BEGIN
 
 static constexpr std::size_t NoRunningJob = (std::numeric_limits<std::size_t>::max)();
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Thread placement policies selected by the VTK_SMP_AFFINITY environment variable.
+enum class AffinityMode
+{
+  None,    // let the system schedule threads
+  Compact, // pin consecutive threads to consecutive cores, filling a NUMA domain first
+  Scatter, // pin consecutive threads to cores of different NUMA domains
+  Domain   // bind consecutive blocks of threads to all the cores of a NUMA domain
+};
+
+AffinityMode GetAffinityMode()
+{
+  const char* env = std::getenv("VTK_SMP_AFFINITY");
+  if (!env)
+  {
+    return AffinityMode::None;
+  }
+  std::string value(env);
+  std::transform(value.begin(), value.end(), value.begin(),
+    [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  if (value == "compact")
+  {
+    return AffinityMode::Compact;
+  }
+  if (value == "scatter")
+  {
+    return AffinityMode::Scatter;
+  }
+  if (value == "numa")
+  {
+    return AffinityMode::Domain;
+  }
+  if (!value.empty() && value != "none")
+  {
+    vtkWarningWithObjectMacro(nullptr,
+      "Unknown VTK_SMP_AFFINITY value \"" << env
+                                          << "\", expected none, compact, scatter or numa.");
+  }
+  return AffinityMode::None;
+}
+
+#if defined(__linux__)
+//------------------------------------------------------------------------------
+// Parse a sysfs CPU list such as "0-3,8-11"
+std::vector<int> ParseCPUList(const std::string& list)
+{
+  std::vector<int> cpus;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ','))
+  {
+    const auto dash = item.find('-');
+    const int first = std::atoi(item.substr(0, dash).c_str());
+    const int last = dash == std::string::npos ? first : std::atoi(item.substr(dash + 1).c_str());
+    for (int cpu = first; cpu <= last; ++cpu)
+    {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+//------------------------------------------------------------------------------
+// CPUs usable by the process, grouped by NUMA domain
+std::vector<std::vector<int>> GetNUMADomains()
+{
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+  {
+    return {};
+  }
+
+  std::vector<std::vector<int>> domains;
+  std::ifstream online("/sys/devices/system/node/online");
+  std::string nodes;
+  if (online && std::getline(online, nodes))
+  {
+    for (const int node : ParseCPUList(nodes))
+    {
+      std::ifstream cpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+      std::string cpus;
+      if (!cpuList || !std::getline(cpuList, cpus))
+      {
+        continue;
+      }
+      std::vector<int> domain;
+      for (const int cpu : ParseCPUList(cpus))
+      {
+        if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))
+        {
+          domain.push_back(cpu);
+        }
+      }
+      if (!domain.empty())
+      {
+        domains.emplace_back(std::move(domain));
+      }
+    }
+  }
+
+  if (domains.empty()) // no NUMA information, use a single domain
+  {
+    std::vector<int> domain;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+      if (CPU_ISSET(cpu, &allowed))
+      {
+        domain.push_back(cpu);
+      }
+    }
+    domains.emplace_back(std::move(domain));
+  }
+  return domains;
+}
+#endif
+
+//------------------------------------------------------------------------------
+void ApplyAffinity(const std::vector<std::thread*>& threads)
+{
+  const AffinityMode mode = GetAffinityMode();
+  if (mode == AffinityMode::None || threads.empty())
+  {
+    return;
+  }
+
+#if defined(__linux__)
+  const auto domains = GetNUMADomains();
+  std::vector<int> cpus; // all CPUs, domain by domain
+  for (const auto& domain : domains)
+  {
+    cpus.insert(cpus.end(), domain.begin(), domain.end());
+  }
+  if (cpus.empty())
+  {
+    return;
+  }
+
+  const std::size_t threadCount = threads.size();
+  for (std::size_t i = 0; i < threadCount; ++i)
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    switch (mode)
+    {
+      case AffinityMode::Compact:
+        CPU_SET(cpus[i % cpus.size()], &set);
+        break;
+      case AffinityMode::Scatter:
+      {
+        const auto& domain = domains[i % domains.size()];
+        CPU_SET(domain[(i / domains.size()) % domain.size()], &set);
+        break;
+      }
+      case AffinityMode::Domain:
+      default:
+        for (const int cpu : domains[i * domains.size() / threadCount])
+        {
+          CPU_SET(cpu, &set);
+        }
+        break;
+    }
+    if (pthread_setaffinity_np(threads[i]->native_handle(), sizeof(set), &set) != 0)
+    {
+      vtkWarningWithObjectMacro(nullptr, "Failed to set the affinity of SMP thread " << i << ".");
+      return;
+    }
+  }
+#else
+  vtkWarningWithObjectMacro(nullptr, "VTK_SMP_AFFINITY is not supported on this platform.");
+#endif
+}
+} // anonymous namespace
+
 struct vtkSMPThreadPool::ThreadJob
 {
   // This constructor is needed because aggregate initialization can not have default value
@@ -223,6 +409,13 @@ vtkSMPThreadPool::vtkSMPThreadPool()
     this->Threads.emplace_back(std::move(data));
   }
 
+  std::vector<std::thread*> systemThreads;
+  for (auto& threadData : this->Threads)
+  {
+    systemThreads.push_back(&threadData->SystemThread);
+  }
+  ApplyAffinity(systemThreads);
+
   this->Initialized.store(true, std::memory_order_release);
 }
 
@@ -8,6 +8,10 @@
 // The DoJob() method is used attributes the job to a free thread, if all
 // threads are working, the job is kept in a queue. Note that vtkSMPThreadPool
 // destructor joins threads and finish the jobs in the queue.
+// The VTK_SMP_AFFINITY environment variable controls the placement of the
+// threads of the pool on Linux: "compact" pins threads to consecutive cores,
+// "scatter" pins them round-robin over NUMA domains and "numa" binds blocks of
+// consecutive threads to a NUMA domain. Threads are not pinned by default.
 
 #ifndef vtkSMPThreadPool_h
 #define vtkSMPThreadPool_h
@@ -5,6 +5,7 @@
 #define SequentialvtkSMPToolsImpl_txx
 
 #include <algorithm> // For std::sort, std::transform, std::fill
+#include <iterator>  // For std::iterator_traits
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
@@ -93,6 +94,41 @@ void vtkSMPToolsImpl<BackendType::Sequential>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::Sequential>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  using T = typename std::iterator_traits<InputIt>::value_type;
+  if (inBegin == inEnd)
+  {
+    return;
+  }
+  T acc = *inBegin;
+  *outBegin = acc;
+  for (++inBegin, ++outBegin; inBegin != inEnd; ++inBegin, ++outBegin)
+  {
+    acc = op(acc, *inBegin);
+    *outBegin = acc;
+  }
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::Sequential>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  for (; inBegin != inEnd; ++inBegin, ++outBegin)
+  {
+    const T value = *inBegin;
+    *outBegin = init;
+    init = op(init, value);
+  }
+  return init;
+}
+
 //--------------------------------------------------------------------------------
 template <>
 VTKCOMMONCORE_EXPORT void vtkSMPToolsImpl<BackendType::Sequential>::Initialize(int);
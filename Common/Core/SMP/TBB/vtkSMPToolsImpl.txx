@@ -8,6 +8,8 @@
 #include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
 #include "vtkCommonCoreModule.h"            // For export macro
 
+#include <iterator> // For std::iterator_traits
+
 #ifdef _MSC_VER
 #pragma push_macro("__TBB_NO_IMPLICIT_LINKAGE")
 #define __TBB_NO_IMPLICIT_LINKAGE 1
@@ -15,6 +17,7 @@
 
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_scan.h>
 #include <tbb/parallel_sort.h>
 
 #ifdef _MSC_VER
@@ -194,6 +197,112 @@ void vtkSMPToolsImpl<BackendType::TBB>::Sort(
   tbb::parallel_sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+// Body for tbb::parallel_scan. HasSum tracks whether Sum holds a value since the
+// operator is not required to have an identity element.
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+class ScanBodyTBB
+{
+  InputIt In;
+  OutputIt Out;
+  BinaryOp& Op;
+  bool Exclusive;
+
+public:
+  T Sum;
+  bool HasSum;
+
+  ScanBodyTBB(InputIt _in, OutputIt _out, BinaryOp& _op, bool exclusive, T init, bool hasInit)
+    : In(_in)
+    , Out(_out)
+    , Op(_op)
+    , Exclusive(exclusive)
+    , Sum(init)
+    , HasSum(hasInit)
+  {
+  }
+
+  ScanBodyTBB(ScanBodyTBB& other, tbb::split)
+    : In(other.In)
+    , Out(other.Out)
+    , Op(other.Op)
+    , Exclusive(other.Exclusive)
+    , Sum(other.Sum)
+    , HasSum(false)
+  {
+  }
+
+  template <typename Tag>
+  void operator()(const tbb::blocked_range<vtkIdType>& r, Tag)
+  {
+    InputIt itIn(In);
+    OutputIt itOut(Out);
+    std::advance(itIn, r.begin());
+    std::advance(itOut, r.begin());
+    for (vtkIdType i = r.begin(); i < r.end(); ++i, ++itIn, ++itOut)
+    {
+      const T value = *itIn;
+      if (Tag::is_final_scan() && this->Exclusive)
+      {
+        *itOut = this->Sum;
+      }
+      this->Sum = this->HasSum ? this->Op(this->Sum, value) : value;
+      this->HasSum = true;
+      if (Tag::is_final_scan() && !this->Exclusive)
+      {
+        *itOut = this->Sum;
+      }
+    }
+  }
+
+  void reverse_join(ScanBodyTBB& left)
+  {
+    if (left.HasSum)
+    {
+      this->Sum = this->HasSum ? this->Op(left.Sum, this->Sum) : left.Sum;
+      this->HasSum = true;
+    }
+  }
+
+  void assign(ScanBodyTBB& other)
+  {
+    this->Sum = other.Sum;
+    this->HasSum = other.HasSum;
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::TBB>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  using T = typename std::iterator_traits<InputIt>::value_type;
+  const vtkIdType size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return;
+  }
+  ScanBodyTBB<InputIt, OutputIt, T, BinaryOp> body(inBegin, outBegin, op, false, T(), false);
+  tbb::parallel_scan(tbb::blocked_range<vtkIdType>(0, size), body);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::TBB>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  const vtkIdType size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return init;
+  }
+  ScanBodyTBB<InputIt, OutputIt, T, BinaryOp> body(inBegin, outBegin, op, true, init, true);
+  tbb::parallel_scan(tbb::blocked_range<vtkIdType>(0, size), body);
+  return body.Sum;
+}
+
 //--------------------------------------------------------------------------------
 template <>
 VTKCOMMONCORE_EXPORT void vtkSMPToolsImpl<BackendType::TBB>::Initialize(int);
@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+
+#include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NumberOfValues = 300000;
+constexpr vtkTypeInt64 HeaderSize = 24;
+
+double ExpectedValue(vtkIdType idx)
+{
+  return 0.5 * static_cast<double>(idx);
+}
+
+bool WriteFile(const std::string& fileName)
+{
+  vtksys::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  std::vector<char> header(HeaderSize, 'h');
+  file.write(header.data(), header.size());
+  std::vector<double> values(NumberOfValues);
+  for (vtkIdType i = 0; i < NumberOfValues; ++i)
+  {
+    values[i] = ::ExpectedValue(i);
+  }
+  file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+  return static_cast<bool>(file);
+}
+
+double ReadFileValue(const std::string& fileName, vtkIdType idx)
+{
+  vtksys::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  file.seekg(HeaderSize + idx * sizeof(double));
+  double value = -1.0;
+  file.read(reinterpret_cast<char*>(&value), sizeof(double));
+  return value;
+}
+}
+
+int TestDataArrayMapFile(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cout << "Usage: " << argv[0] << " outputFilename" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = argv[1];
+  if (!::WriteFile(fileName))
+  {
+    std::cerr << "Could not write " << fileName << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int status = EXIT_SUCCESS;
+  {
+    vtkNew<vtkDoubleArray> array;
+    array->SetNumberOfComponents(3);
+    if (!array->MapFile(fileName.c_str(), HeaderSize, NumberOfValues))
+    {
+#if defined(_WIN32) || defined(__unix__) || defined(__APPLE__)
+      std::cerr << "Could not map " << fileName << std::endl;
+      return EXIT_FAILURE;
+#else
+      return EXIT_SUCCESS;
+#endif
+    }
+    if (!array->IsFileMapped() || array->GetNumberOfTuples() != NumberOfValues / 3)
+    {
+      std::cerr << "Unexpected mapped array state" << std::endl;
+      status = EXIT_FAILURE;
+    }
+    for (vtkIdType i = 0; i < NumberOfValues; ++i)
+    {
+      if (array->GetValue(i) != ::ExpectedValue(i))
+      {
+        std::cerr << "Wrong value at " << i << ": " << array->GetValue(i) << std::endl;
+        status = EXIT_FAILURE;
+        break;
+      }
+    }
+    double range[2];
+    array->GetRange(range, 0);
+    if (range[0] != 0.0 || range[1] != ::ExpectedValue(NumberOfValues - 3))
+    {
+      std::cerr << "Wrong range: " << range[0] << ", " << range[1] << std::endl;
+      status = EXIT_FAILURE;
+    }
+
+    // Writes must stay private to the process
+    array->SetValue(10, -1.0);
+    if (array->GetValue(10) != -1.0 || ::ReadFileValue(fileName, 10) != ::ExpectedValue(10))
+    {
+      std::cerr << "Writing to a mapped array is not private" << std::endl;
+      status = EXIT_FAILURE;
+    }
+
+    // Growing the array copies it out of the mapping
+    array->InsertNextValue(42.0);
+    if (array->IsFileMapped() || array->GetValue(10) != -1.0 ||
+      array->GetValue(NumberOfValues - 1) != ::ExpectedValue(NumberOfValues - 1) ||
+      array->GetValue(NumberOfValues) != 42.0)
+    {
+      std::cerr << "Reallocation of a mapped array failed" << std::endl;
+      status = EXIT_FAILURE;
+    }
+
+    // Mapping beyond the end of the file or at a misaligned offset fails
+    vtkNew<vtkIntArray> ints;
+    ints->SetNumberOfValues(2);
+    ints->SetValue(0, 7);
+    if (ints->MapFile(fileName.c_str(), HeaderSize, NumberOfValues * 3) ||
+      ints->MapFile(fileName.c_str(), 1, 10) || ints->MapFile("/nonexistent/file", 0, 10) ||
+      ints->GetNumberOfValues() != 2 || ints->GetValue(0) != 7)
+    {
+      std::cerr << "Invalid mappings must fail and leave the array untouched" << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+
+  vtksys::SystemTools::RemoveFile(fileName);
+  return status;
+}
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkFloatArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Brute force reference for GetRange / GetFiniteRange
+void ReferenceRange(vtkDataArray* array, int comp, bool finite, double range[2])
+{
+  range[0] = VTK_DOUBLE_MAX;
+  range[1] = VTK_DOUBLE_MIN;
+  const int numComps = array->GetNumberOfComponents();
+  for (vtkIdType t = 0; t < array->GetNumberOfTuples(); ++t)
+  {
+    double value = 0.0;
+    if (comp < 0)
+    {
+      for (int c = 0; c < numComps; ++c)
+      {
+        value += array->GetComponent(t, c) * array->GetComponent(t, c);
+      }
+    }
+    else
+    {
+      value = array->GetComponent(t, comp);
+    }
+    if (std::isnan(value) || (finite && std::isinf(value)))
+    {
+      continue;
+    }
+    range[0] = std::min(range[0], value);
+    range[1] = std::max(range[1], value);
+  }
+  if (comp < 0)
+  {
+    range[0] = std::sqrt(range[0]);
+    range[1] = std::sqrt(range[1]);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool CheckRanges(vtkDataArray* array, const char* step)
+{
+  bool success = true;
+  for (int comp = -1; comp < array->GetNumberOfComponents(); ++comp)
+  {
+    for (int finite = 0; finite < 2; ++finite)
+    {
+      double range[2];
+      double expected[2];
+      if (finite)
+      {
+        array->GetFiniteRange(range, comp);
+      }
+      else
+      {
+        array->GetRange(range, comp);
+      }
+      ReferenceRange(array, comp, finite != 0, expected);
+      if (range[0] != expected[0] || range[1] != expected[1])
+      {
+        std::cerr << step << ": wrong " << (finite ? "finite " : "") << "range for component "
+                  << comp << ", got [" << range[0] << ", " << range[1] << "] instead of ["
+                  << expected[0] << ", " << expected[1] << "]\n";
+        success = false;
+      }
+    }
+  }
+  return success;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDataArrayRangeTracking(int, char*[])
+{
+  vtkNew<vtkFloatArray> array;
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(1000);
+  for (vtkIdType t = 0; t < 1000; ++t)
+  {
+    array->SetTuple3(t, t % 17, -(t % 23), 0.5 * (t % 11));
+  }
+  array->SetTuple3(10, std::numeric_limits<float>::infinity(), 0, vtkMath::Nan());
+
+  bool success = CheckRanges(array, "Initial");
+
+  array->RangeTrackingOn();
+  success &= CheckRanges(array, "Tracking enabled");
+
+  // Extend the ranges without overwriting an extremum
+  array->SetTuple3(500, 40, -40, 20);
+  array->Modified();
+  success &= CheckRanges(array, "Extended");
+
+  // Overwrite the maximum of the first component: ranges must shrink
+  array->SetComponent(500, 0, 1);
+  array->Modified();
+  success &= CheckRanges(array, "Shrunk");
+
+  // Appended tuples are scanned too
+  array->InsertNextTuple3(-5, 100, 3);
+  array->Modified();
+  success &= CheckRanges(array, "Appended");
+
+  // Untracked writes must be announced
+  array->MarkTuplesModified(20, 21);
+  array->SetTypedComponent(20, 2, 50);
+  array->Modified();
+  success &= CheckRanges(array, "Marked");
+
+  array->Fill(2);
+  array->Modified();
+  success &= CheckRanges(array, "Filled");
+
+  array->RangeTrackingOff();
+  array->SetTuple3(0, 7, 8, 9);
+  array->Modified();
+  success &= CheckRanges(array, "Tracking disabled");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkFloatArray.h"
+#include "vtkMemoryArena.h"
+#include "vtkNew.h"
+
+#include <cstdint>
+#include <iostream>
+
+int TestMemoryArena(int, char*[])
+{
+  int status = EXIT_SUCCESS;
+  vtkMemoryArena::ReleaseCachedMemory();
+
+  // Blocks are aligned and reused once released
+  void* block = vtkMemoryArena::Malloc(1000);
+  if (reinterpret_cast<std::uintptr_t>(block) % vtkMemoryArena::GetAlignment() != 0)
+  {
+    std::cerr << "Block is not aligned on " << vtkMemoryArena::GetAlignment() << " bytes.\n";
+    status = EXIT_FAILURE;
+  }
+  vtkMemoryArena::Free(block);
+  if (vtkMemoryArena::GetCachedSize() == 0)
+  {
+    std::cerr << "Released block was not cached.\n";
+    status = EXIT_FAILURE;
+  }
+  if (vtkMemoryArena::Malloc(990) != block)
+  {
+    std::cerr << "Block of the same size class was not reused.\n";
+    status = EXIT_FAILURE;
+  }
+  vtkMemoryArena::Free(block);
+
+  // Realloc keeps the content
+  int* values = static_cast<int*>(vtkMemoryArena::Malloc(16 * sizeof(int)));
+  for (int i = 0; i < 16; ++i)
+  {
+    values[i] = i;
+  }
+  values = static_cast<int*>(vtkMemoryArena::Realloc(values, 100000 * sizeof(int)));
+  for (int i = 0; i < 16; ++i)
+  {
+    if (values[i] != i)
+    {
+      std::cerr << "Realloc lost value " << i << ".\n";
+      status = EXIT_FAILURE;
+      break;
+    }
+  }
+  vtkMemoryArena::Free(values);
+
+  // Arrays allocated in a scope go through the arena
+  vtkMemoryArena::ReleaseCachedMemory();
+  {
+    vtkMemoryArena::Scope arenaScope;
+    for (int i = 0; i < 3; ++i)
+    {
+      vtkNew<vtkFloatArray> array;
+      array->SetNumberOfComponents(3);
+      array->SetNumberOfTuples(10000 + i);
+      array->Fill(1.0);
+      array->InsertNextTuple3(1.0, 2.0, 3.0);
+      if (reinterpret_cast<std::uintptr_t>(array->GetPointer(0)) % 64 != 0)
+      {
+        std::cerr << "Array buffer is not aligned.\n";
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+  if (vtkMemoryArena::GetCachedSize() == 0)
+  {
+    std::cerr << "Array buffers were not released to the arena.\n";
+    status = EXIT_FAILURE;
+  }
+  vtkMemoryArena::ReleaseCachedMemory();
+  if (vtkMemoryArena::GetCachedSize() != 0)
+  {
+    std::cerr << "Cached memory was not released.\n";
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkSIMDKernels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+namespace simd = vtk::detail::simd;
+
+template <typename T>
+std::vector<T> MakeValues(std::size_t size, std::mt19937& generator)
+{
+  std::uniform_real_distribution<T> distribution(-100, 100);
+  std::vector<T> values(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    values[i] = distribution(generator);
+  }
+  // Sprinkle special values that the kernels must skip
+  if (size > 20)
+  {
+    values[3] = std::numeric_limits<T>::quiet_NaN();
+    values[size / 2] = std::numeric_limits<T>::infinity();
+    values[size - 2] = -std::numeric_limits<T>::infinity();
+    values[size - 7] = std::numeric_limits<T>::quiet_NaN();
+  }
+  return values;
+}
+
+template <typename T>
+bool SameBits(const T* a, const T* b, std::size_t count)
+{
+  return std::memcmp(a, b, count * sizeof(T)) == 0;
+}
+
+bool Compare(const char* what, bool same)
+{
+  if (!same)
+  {
+    std::cerr << what << " differs from the scalar kernel with "
+              << simd::GetInstructionSetName(simd::GetInstructionSet()) << ".\n";
+  }
+  return same;
+}
+
+// Run every kernel with the current instruction set and compare it to the scalar one
+template <typename T>
+bool TestKernels(simd::InstructionSet isa, std::size_t numTuples, std::mt19937& generator)
+{
+  const std::vector<T> a = MakeValues<T>(3 * numTuples, generator);
+  const std::vector<T> b = MakeValues<T>(3 * numTuples, generator);
+  const vtkIdType n = static_cast<vtkIdType>(numTuples);
+
+  struct Results
+  {
+    T Range[2] = { std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest() };
+    T FiniteRange[2] = { std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest() };
+    std::vector<float> Magnitudes;
+    float MaxMagnitude = 0.f;
+    std::vector<float> Dots;
+    float DotRange[2] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() };
+    std::vector<unsigned char> EdgeCases;
+    vtkIdType Crossings = 0;
+    vtkIdType CrossingRange[2] = { 0, 0 };
+  };
+  // The iso-value is not representable as a float.
+  const double isoValue = 0.3;
+  const vtkIdType numEdges = n > 0 ? 3 * n - 1 : 0;
+  Results results[2];
+  const simd::InstructionSet isas[2] = { simd::InstructionSet::Scalar, isa };
+  for (int i = 0; i < 2; ++i)
+  {
+    simd::SetInstructionSet(isas[i]);
+    Results& r = results[i];
+    simd::MinMax(a.data(), 3 * n, r.Range, r.FiniteRange);
+    r.Magnitudes.resize(numTuples);
+    simd::Magnitude3(a.data(), n, r.Magnitudes.data(), r.MaxMagnitude);
+    r.Dots.resize(numTuples);
+    simd::Dot3(a.data(), b.data(), n, r.Dots.data(), r.DotRange);
+    r.EdgeCases.resize(numEdges);
+    r.Crossings = simd::ClassifyEdges(
+      a.data(), numEdges, isoValue, r.EdgeCases.data(), r.CrossingRange[0], r.CrossingRange[1]);
+  }
+
+  // The scalar kernel classifies like a comparison in double.
+  vtkIdType crossings = 0;
+  vtkIdType crossingRange[2] = { numEdges, 0 };
+  bool sameCases = true;
+  for (vtkIdType i = 0; i < numEdges; ++i)
+  {
+    const int left = static_cast<double>(a[i]) >= isoValue ? 1 : 0;
+    const int right = static_cast<double>(a[i + 1]) >= isoValue ? 1 : 0;
+    sameCases &= results[0].EdgeCases[i] == (left | (right << 1));
+    if (left != right)
+    {
+      ++crossings;
+      crossingRange[0] = std::min(crossingRange[0], i);
+      crossingRange[1] = i + 1;
+    }
+  }
+
+  const Results& ref = results[0];
+  const Results& res = results[1];
+  bool ok = true;
+  ok &= Compare("MinMax", SameBits(ref.Range, res.Range, 2));
+  ok &= Compare("MinMax finite", SameBits(ref.FiniteRange, res.FiniteRange, 2));
+  ok &= Compare("Magnitude3", SameBits(ref.Magnitudes.data(), res.Magnitudes.data(), numTuples));
+  ok &= Compare("Magnitude3 maximum", ref.MaxMagnitude == res.MaxMagnitude);
+  ok &= Compare("Dot3", SameBits(ref.Dots.data(), res.Dots.data(), numTuples));
+  ok &= Compare("Dot3 range", SameBits(ref.DotRange, res.DotRange, 2));
+  ok &= Compare("ClassifyEdges reference", sameCases && ref.Crossings == crossings &&
+      ref.CrossingRange[0] == crossingRange[0] && ref.CrossingRange[1] == crossingRange[1]);
+  ok &= Compare("ClassifyEdges", ref.EdgeCases == res.EdgeCases && ref.Crossings == res.Crossings &&
+      ref.CrossingRange[0] == res.CrossingRange[0] && ref.CrossingRange[1] == res.CrossingRange[1]);
+  return ok;
+}
+}
+
+int TestSIMDKernels(int, char*[])
+{
+  const simd::InstructionSet initial = simd::GetInstructionSet();
+  std::cout << "Best instruction set: "
+            << simd::GetInstructionSetName(simd::GetBestInstructionSet()) << "\n";
+
+  std::mt19937 generator(1234);
+  bool ok = true;
+  for (simd::InstructionSet isa : { simd::InstructionSet::Scalar, simd::InstructionSet::NEON,
+         simd::InstructionSet::AVX2, simd::InstructionSet::AVX512 })
+  {
+    if (!simd::SetInstructionSet(isa))
+    {
+      continue;
+    }
+    // Sizes below, at and above the vector widths exercise the scalar remainders
+    for (std::size_t numTuples : { 0, 1, 5, 8, 17, 33, 1000, 1031 })
+    {
+      ok &= TestKernels<float>(isa, numTuples, generator);
+      ok &= TestKernels<double>(isa, numTuples, generator);
+    }
+  }
+
+  // NaN values are skipped, infinite values only in the finite range
+  const float values[] = { std::numeric_limits<float>::quiet_NaN(), 1.f, -2.f,
+    std::numeric_limits<float>::infinity(), 3.f, std::numeric_limits<float>::quiet_NaN(), 0.f,
+    -1.f, 2.f, 1.f, 0.5f, -0.5f, 2.5f, 1.5f, -1.5f, 0.25f, 0.75f };
+  float range[2] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() };
+  float finiteRange[2] = { range[0], range[1] };
+  simd::SetInstructionSet(simd::GetBestInstructionSet());
+  simd::MinMax(values, sizeof(values) / sizeof(float), range, finiteRange);
+  if (range[0] != -2.f || range[1] != std::numeric_limits<float>::infinity() ||
+    finiteRange[0] != -2.f || finiteRange[1] != 3.f)
+  {
+    std::cerr << "Wrong ranges: [" << range[0] << ", " << range[1] << "] and [" << finiteRange[0]
+              << ", " << finiteRange[1] << "].\n";
+    ok = false;
+  }
+
+  simd::SetInstructionSet(initial);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
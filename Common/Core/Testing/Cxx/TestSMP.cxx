@@ -7,11 +7,14 @@
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <deque>
 #include <functional>
 #include <numeric>
 #include <set>
+#include <utility>
 #include <vector>
 
 static const int Target = 10000;
@@ -480,6 +483,153 @@ int doTestSMP()
       return EXIT_FAILURE;
     }
   }
+
+  // Test scans, large enough to be split in several blocks
+  std::vector<vtkIdType> scanData(100000);
+  for (std::size_t i = 0; i < scanData.size(); ++i)
+  {
+    scanData[i] = static_cast<vtkIdType>(i % 7);
+  }
+  std::vector<vtkIdType> inclusiveResult(scanData.size());
+  std::vector<vtkIdType> exclusiveResult(scanData);
+  vtkSMPTools::InclusiveScan(scanData.begin(), scanData.end(), inclusiveResult.begin());
+  const vtkIdType scanTotal = vtkSMPTools::ExclusiveScan(
+    exclusiveResult.begin(), exclusiveResult.end(), exclusiveResult.begin(), vtkIdType(10));
+  vtkIdType expected = 0;
+  for (std::size_t i = 0; i < scanData.size(); ++i)
+  {
+    if (exclusiveResult[i] != expected + 10)
+    {
+      cerr << "Error: Invalid output for vtkSMPTools::ExclusiveScan at " << i << endl;
+      return EXIT_FAILURE;
+    }
+    expected += scanData[i];
+    if (inclusiveResult[i] != expected)
+    {
+      cerr << "Error: Invalid output for vtkSMPTools::InclusiveScan at " << i << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (scanTotal != expected + 10)
+  {
+    cerr << "Error: Invalid total returned by vtkSMPTools::ExclusiveScan" << endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<int> segmentData = { 1, 2, 3, 4, 5, 6 };
+  std::vector<int> segmentOffsets = { 0, 2, 2, 6 };
+  std::vector<int> segmentResult(segmentData.size());
+  vtkSMPTools::SegmentedInclusiveScan(
+    segmentData.begin(), segmentOffsets.begin(), segmentOffsets.end(), segmentResult.begin());
+  if (segmentResult != std::vector<int>{ 1, 3, 3, 7, 12, 18 })
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::SegmentedInclusiveScan" << endl;
+    return EXIT_FAILURE;
+  }
+  vtkSMPTools::SegmentedExclusiveScan(segmentData.begin(), segmentOffsets.begin(),
+    segmentOffsets.end(), segmentResult.begin(), 0);
+  if (segmentResult != std::vector<int>{ 0, 1, 0, 3, 7, 12 })
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::SegmentedExclusiveScan" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Test reduce
+  const vtkIdType reduceSum = vtkSMPTools::Reduce(
+    0, static_cast<vtkIdType>(scanData.size()), vtkIdType(0),
+    [&](vtkIdType i) { return scanData[i]; },
+    [](vtkIdType a, vtkIdType b) { return a + b; });
+  if (reduceSum != expected)
+  {
+    cerr << "Error: vtkSMPTools::Reduce computed " << reduceSum << " instead of " << expected
+         << endl;
+    return EXIT_FAILURE;
+  }
+  using MinMax = std::pair<vtkIdType, vtkIdType>;
+  const MinMax reduceRange = vtkSMPTools::Reduce(
+    10, 20, MinMax(VTK_ID_MAX, VTK_ID_MIN), [](vtkIdType i) { return MinMax(i, i); },
+    [](const MinMax& a, const MinMax& b) {
+      return MinMax(std::min(a.first, b.first), std::max(a.second, b.second));
+    });
+  if (reduceRange.first != 10 || reduceRange.second != 19)
+  {
+    cerr << "Error: vtkSMPTools::Reduce computed an invalid range" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Test task group: a diamond of dependent tasks, each one using vtkSMPTools::For
+  std::vector<int> taskData(Target, 0);
+  std::atomic<int> order(0);
+  int countOrder = -1, leftOrder = -1, rightOrder = -1, mergeOrder = -1;
+  vtkSMPTools::TaskGroup group;
+  auto countTask = group.Add([&]() {
+    vtkSMPTools::Fill(taskData.begin(), taskData.end(), 1);
+    countOrder = order++;
+  });
+  auto leftTask = group.Add(
+    [&]() {
+      vtkSMPTools::For(0, Target / 2, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          taskData[i] += 1;
+        }
+      });
+      leftOrder = order++;
+    },
+    { countTask });
+  auto rightTask = group.Add(
+    [&]() {
+      vtkSMPTools::For(Target / 2, Target, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          taskData[i] += 2;
+        }
+      });
+      rightOrder = order++;
+    },
+    { countTask });
+  group.Add([&]() { mergeOrder = order++; }, { leftTask, rightTask });
+  group.Execute();
+
+  if (group.GetNumberOfTasks() != 4 || countOrder != 0 || mergeOrder != 3 || leftOrder <= 0 ||
+    rightOrder <= 0)
+  {
+    cerr << "Error: vtkSMPTools::TaskGroup did not honor task dependencies!" << endl;
+    return EXIT_FAILURE;
+  }
+  const int taskSum = std::accumulate(taskData.begin(), taskData.end(), 0);
+  if (taskSum != 2 * (Target / 2) + 3 * (Target - Target / 2))
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::TaskGroup, got " << taskSum << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Test task group with nested parallelism: more dependent tasks than threads, each
+  // one running a nested vtkSMPTools::For that the backend may schedule on any thread.
+  const int numberOfChains = 4 * vtkSMPTools::GetEstimatedNumberOfThreads();
+  std::vector<std::atomic<vtkIdType>> chainSums(numberOfChains);
+  vtkSMPTools::TaskGroup nestedGroup;
+  for (int chain = 0; chain < numberOfChains; ++chain)
+  {
+    chainSums[chain] = 0;
+    auto nestedFor = [&chainSums, chain]() {
+      vtkSMPTools::For(0, Target, 100, [&chainSums, chain](vtkIdType begin, vtkIdType end) {
+        chainSums[chain] += end - begin;
+      });
+    };
+    auto first = nestedGroup.Add(nestedFor);
+    nestedGroup.Add(nestedFor, { first });
+  }
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ true }, [&]() { nestedGroup.Execute(); });
+  for (int chain = 0; chain < numberOfChains; ++chain)
+  {
+    if (chainSums[chain] != 2 * Target)
+    {
+      cerr << "Error: Invalid output for nested vtkSMPTools::TaskGroup, got " << chainSums[chain]
+           << endl;
+      return EXIT_FAILURE;
+    }
+  }
   return EXIT_SUCCESS;
 }
 
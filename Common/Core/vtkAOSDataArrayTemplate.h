@@ -236,6 +236,31 @@ public:
   void SetVoidArray(void* array, vtkIdType size, int save, int deleteMethod) override;
   ///@}
 
+  ///@{
+  /**
+   * Make the array hold the @a numberOfValues values stored in the file
+   * @a fileName starting at byte @a offset, without reading them. The values
+   * must be stored in the native byte order. Pages of the file are only read
+   * when the values they hold are first accessed, optionally following the
+   * access pattern @a advice. The file itself is never modified: writing to
+   * the array copies the modified pages in memory.
+   *
+   * Returns false, and leaves the array untouched, if the file cannot be
+   * mapped, for instance on platforms without memory mapping support.
+   */
+  bool MapFile(const char* fileName, vtkTypeInt64 offset, vtkIdType numberOfValues);
+#ifndef __VTK_WRAP__
+  bool MapFile(const char* fileName, vtkTypeInt64 offset, vtkIdType numberOfValues,
+    vtk::detail::vtkBufferMappingAdvice advice);
+#endif
+  ///@}
+
+  /**
+   * Return true if the values of the array are mapped from a file with
+   * MapFile().
+   */
+  bool IsFileMapped() const { return this->Buffer->IsFileMapped(); }
+
   /**
    * This method allows the user to specify a custom free function to be
    * called when the array is deallocated. Calling this method will implicitly
@@ -107,6 +107,30 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::SetVoidArray(
   this->SetArray(static_cast<ValueType*>(array), size, save, deleteMethod);
 }
 
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkAOSDataArrayTemplate<ValueTypeT>::MapFile(
+  const char* fileName, vtkTypeInt64 offset, vtkIdType numberOfValues)
+{
+  return this->MapFile(
+    fileName, offset, numberOfValues, vtk::detail::vtkBufferMappingAdvice::Normal);
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkAOSDataArrayTemplate<ValueTypeT>::MapFile(const char* fileName, vtkTypeInt64 offset,
+  vtkIdType numberOfValues, vtk::detail::vtkBufferMappingAdvice advice)
+{
+  if (!this->Buffer->MapFile(fileName, offset, numberOfValues, advice))
+  {
+    return false;
+  }
+  this->Size = numberOfValues;
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 template <class ValueType>
 void vtkAOSDataArrayTemplate<ValueType>::SetArrayFreeFunction(void (*callback)(void*))
@@ -121,6 +145,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::SetTuple(vtkIdType tupleIdx, const flo
   // While std::copy is the obvious choice here, it kills performance on MSVC
   // debugging builds as their STL calls are poorly optimized. Just use a for
   // loop instead.
+  this->TupleAboutToBeModified(tupleIdx);
   ValueTypeT* data = this->Buffer->GetBuffer() + tupleIdx * this->NumberOfComponents;
   for (int i = 0; i < this->NumberOfComponents; ++i)
   {
@@ -133,6 +158,7 @@ template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::SetTuple(vtkIdType tupleIdx, const double* tuple)
 {
   // See note in SetTuple about std::copy vs for loops on MSVC.
+  this->TupleAboutToBeModified(tupleIdx);
   ValueTypeT* data = this->Buffer->GetBuffer() + tupleIdx * this->NumberOfComponents;
   for (int i = 0; i < this->NumberOfComponents; ++i)
   {
@@ -147,6 +173,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuple(vtkIdType tupleIdx, const
   if (this->EnsureAccessToTuple(tupleIdx))
   {
     // See note in SetTuple about std::copy vs for loops on MSVC.
+    this->TupleAboutToBeModified(tupleIdx);
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
     ValueTypeT* data = this->Buffer->GetBuffer() + valueIdx;
     for (int i = 0; i < this->NumberOfComponents; ++i)
@@ -164,6 +191,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuple(vtkIdType tupleIdx, const
   if (this->EnsureAccessToTuple(tupleIdx))
   {
     // See note in SetTuple about std::copy vs for loops on MSVC.
+    this->TupleAboutToBeModified(tupleIdx);
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
     ValueTypeT* data = this->Buffer->GetBuffer() + valueIdx;
     for (int i = 0; i < this->NumberOfComponents; ++i)
@@ -378,6 +406,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::FillTypedComponent(int compIdx, ValueT
 template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::FillValue(ValueType value)
 {
+  this->ResetRangeTracking();
   std::ptrdiff_t offset = this->MaxId + 1;
   std::fill(this->Buffer->GetBuffer(), this->Buffer->GetBuffer() + offset, value);
 }
@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBuffer.h"
+
+#include <mutex>         // For std::mutex
+#include <unordered_map> // For std::unordered_map
+
+#if defined(_WIN32)
+#include "vtkWindows.h"
+#include <vtksys/Encoding.hxx>
+#define VTK_BUFFER_HAS_FILE_MAPPING
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VTK_BUFFER_HAS_FILE_MAPPING
+#endif
+
+namespace
+{
+#if defined(VTK_BUFFER_HAS_FILE_MAPPING)
+//------------------------------------------------------------------------------
+// The system mapping a pointer handed out to a vtkBuffer belongs to.
+struct FileMapping
+{
+  void* Base;
+  std::size_t Length;
+};
+
+struct FileMappingRegistry
+{
+  std::mutex Mutex;
+  std::unordered_map<void*, FileMapping> Mappings;
+};
+
+FileMappingRegistry& GetFileMappings()
+{
+  static FileMappingRegistry registry;
+  return registry;
+}
+#endif
+}
+
+namespace vtk
+{
+namespace detail
+{
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+void* vtkBufferMapFile(const char* fileName, vtkTypeInt64 offset, std::size_t numberOfBytes,
+  vtkBufferMappingAdvice advice)
+{
+#if defined(VTK_BUFFER_HAS_FILE_MAPPING)
+  if (!fileName || offset < 0 || numberOfBytes == 0)
+  {
+    return nullptr;
+  }
+
+#if defined(_WIN32)
+  (void)advice; // No equivalent of madvise for file views
+  HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+    GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return nullptr;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) ||
+    static_cast<vtkTypeUInt64>(offset) + numberOfBytes >
+      static_cast<vtkTypeUInt64>(fileSize.QuadPart))
+  {
+    CloseHandle(file);
+    return nullptr;
+  }
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+  {
+    return nullptr;
+  }
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  const vtkTypeInt64 granularity = info.dwAllocationGranularity;
+  const vtkTypeInt64 alignedOffset = offset - offset % granularity;
+  const std::size_t length = numberOfBytes + static_cast<std::size_t>(offset - alignedOffset);
+  // The view keeps the mapping object alive
+  void* base = MapViewOfFile(mapping, FILE_MAP_COPY, static_cast<DWORD>(alignedOffset >> 32),
+    static_cast<DWORD>(alignedOffset & 0xffffffff), length);
+  CloseHandle(mapping);
+  if (!base)
+  {
+    return nullptr;
+  }
+#else
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+  {
+    return nullptr;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 ||
+    static_cast<vtkTypeUInt64>(offset) + numberOfBytes >
+      static_cast<vtkTypeUInt64>(fileStat.st_size))
+  {
+    close(fd);
+    return nullptr;
+  }
+  const vtkTypeInt64 pageSize = sysconf(_SC_PAGESIZE);
+  const vtkTypeInt64 alignedOffset = offset - offset % pageSize;
+  const std::size_t length = numberOfBytes + static_cast<std::size_t>(offset - alignedOffset);
+  // Private writable mapping: writes copy the pages and never reach the file
+  void* base = mmap(
+    nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(alignedOffset));
+  // The mapping stays valid once the descriptor is closed
+  close(fd);
+  if (base == MAP_FAILED)
+  {
+    return nullptr;
+  }
+  int systemAdvice = POSIX_MADV_NORMAL;
+  switch (advice)
+  {
+    case vtkBufferMappingAdvice::Sequential:
+      systemAdvice = POSIX_MADV_SEQUENTIAL;
+      break;
+    case vtkBufferMappingAdvice::Random:
+      systemAdvice = POSIX_MADV_RANDOM;
+      break;
+    case vtkBufferMappingAdvice::WillNeed:
+      systemAdvice = POSIX_MADV_WILLNEED;
+      break;
+    case vtkBufferMappingAdvice::Normal:
+      break;
+  }
+  if (systemAdvice != POSIX_MADV_NORMAL)
+  {
+    posix_madvise(base, length, systemAdvice);
+  }
+#endif
+
+  void* data = static_cast<char*>(base) + (offset - alignedOffset);
+  FileMappingRegistry& registry = ::GetFileMappings();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  registry.Mappings[data] = FileMapping{ base, length };
+  return data;
+#else
+  (void)fileName;
+  (void)offset;
+  (void)numberOfBytes;
+  (void)advice;
+  return nullptr;
+#endif
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferUnmapFile(void* data)
+{
+#if defined(VTK_BUFFER_HAS_FILE_MAPPING)
+  FileMapping mapping;
+  {
+    FileMappingRegistry& registry = ::GetFileMappings();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    auto it = registry.Mappings.find(data);
+    if (it == registry.Mappings.end())
+    {
+      return;
+    }
+    mapping = it->second;
+    registry.Mappings.erase(it);
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(mapping.Base);
+#else
+  munmap(mapping.Base, mapping.Length);
+#endif
+#else
+  (void)data;
+#endif
+}
+VTK_ABI_NAMESPACE_END
+} // namespace detail
+} // namespace vtk
@@ -13,10 +13,41 @@
 #ifndef vtkBuffer_h
 #define vtkBuffer_h
 
+#include "vtkMemoryArena.h" // For vtkMemoryArena
 #include "vtkObject.h"
 #include "vtkObjectFactory.h" // New() implementation
 
 #include <algorithm> // for std::min and std::copy
+#include <cstddef>   // for std::size_t
+
+namespace vtk
+{
+namespace detail
+{
+VTK_ABI_NAMESPACE_BEGIN
+// Parallel first touch of large allocations, see vtkSMPTools::SetFirstTouchAllocation()
+VTKCOMMONCORE_EXPORT void vtkBufferFirstTouch(void* data, std::size_t numberOfBytes);
+
+/**
+ * Access pattern hints given to the system for file mapped buffers.
+ */
+enum class vtkBufferMappingAdvice
+{
+  Normal,     // Default read-ahead
+  Sequential, // Aggressive read-ahead, pages are released soon after being read
+  Random,     // No read-ahead
+  WillNeed    // Start paging in the whole mapping in the background
+};
+
+// Map numberOfBytes bytes of fileName starting at byte offset with copy-on-write
+// semantics. Returns nullptr if the file cannot be mapped.
+VTKCOMMONCORE_EXPORT void* vtkBufferMapFile(const char* fileName, vtkTypeInt64 offset,
+  std::size_t numberOfBytes, vtkBufferMappingAdvice advice);
+// Release a pointer returned by vtkBufferMapFile.
+VTKCOMMONCORE_EXPORT void vtkBufferUnmapFile(void* data);
+VTK_ABI_NAMESPACE_END
+} // namespace detail
+} // namespace vtk
 
 VTK_ABI_NAMESPACE_BEGIN
 template <class ScalarTypeT>
@@ -60,6 +91,24 @@ public:
    **/
   void SetFreeFunction(bool noFreeFunction, vtkFreeingFunction deleteFunction = free);
 
+  /**
+   * Make this buffer point to @a size elements stored in the file @a fileName,
+   * starting at byte @a offset, instead of allocating memory. Pages are only
+   * read from the file when they are first accessed.
+   *
+   * The mapping is private: the file is never modified, writing to the buffer
+   * copies the modified pages in memory. The file must not be truncated while
+   * it is mapped. Returns false, and leaves the buffer untouched, if the file
+   * cannot be mapped or if @a offset is not aligned for ScalarType.
+   */
+  bool MapFile(const char* fileName, vtkTypeInt64 offset, vtkIdType size,
+    vtk::detail::vtkBufferMappingAdvice advice = vtk::detail::vtkBufferMappingAdvice::Normal);
+
+  /**
+   * Return true if the buffer points into a file mapped with MapFile().
+   */
+  inline bool IsFileMapped() const { return this->FileMapped; }
+
   /**
    * Return the number of elements the current buffer can hold.
    */
@@ -80,10 +129,20 @@ protected:
   vtkBuffer()
     : Pointer(nullptr)
     , Size(0)
+    , FileMapped(false)
   {
-    this->SetMallocFunction(vtkObjectBase::GetCurrentMallocFunction());
-    this->SetReallocFunction(vtkObjectBase::GetCurrentReallocFunction());
-    this->SetFreeFunction(false, vtkObjectBase::GetCurrentFreeFunction());
+    if (vtkMemoryArena::IsActive() && !vtkObjectBase::GetUsingMemkind())
+    {
+      this->SetMallocFunction(vtkMemoryArena::Malloc);
+      this->SetReallocFunction(vtkMemoryArena::Realloc);
+      this->SetFreeFunction(false, vtkMemoryArena::Free);
+    }
+    else
+    {
+      this->SetMallocFunction(vtkObjectBase::GetCurrentMallocFunction());
+      this->SetReallocFunction(vtkObjectBase::GetCurrentReallocFunction());
+      this->SetFreeFunction(false, vtkObjectBase::GetCurrentFreeFunction());
+    }
   }
 
   ~vtkBuffer() override { this->SetBuffer(nullptr, 0); }
@@ -93,6 +152,7 @@ protected:
   vtkMallocingFunction MallocFunction;
   vtkReallocingFunction ReallocFunction;
   vtkFreeingFunction DeleteFunction;
+  bool FileMapped;
 
 private:
   vtkBuffer(const vtkBuffer&) = delete;
@@ -118,7 +178,12 @@ void vtkBuffer<ScalarT>::SetBuffer(typename vtkBuffer<ScalarT>::ScalarType* arra
 {
   if (this->Pointer != array)
   {
-    if (this->DeleteFunction)
+    if (this->FileMapped)
+    {
+      vtk::detail::vtkBufferUnmapFile(this->Pointer);
+      this->FileMapped = false;
+    }
+    else if (this->DeleteFunction)
     {
       this->DeleteFunction(this->Pointer);
     }
@@ -126,6 +191,26 @@ void vtkBuffer<ScalarT>::SetBuffer(typename vtkBuffer<ScalarT>::ScalarType* arra
   }
   this->Size = sz;
 }
+
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+bool vtkBuffer<ScalarT>::MapFile(const char* fileName, vtkTypeInt64 offset, vtkIdType size,
+  vtk::detail::vtkBufferMappingAdvice advice)
+{
+  if (!fileName || offset < 0 || size <= 0 || offset % alignof(ScalarType) != 0)
+  {
+    return false;
+  }
+  void* data = vtk::detail::vtkBufferMapFile(
+    fileName, offset, static_cast<std::size_t>(size) * sizeof(ScalarType), advice);
+  if (!data)
+  {
+    return false;
+  }
+  this->SetBuffer(static_cast<ScalarType*>(data), size);
+  this->FileMapped = true;
+  return true;
+}
 //------------------------------------------------------------------------------
 template <typename ScalarT>
 void vtkBuffer<ScalarT>::SetMallocFunction(vtkMallocingFunction mallocFunction)
@@ -172,6 +257,7 @@ bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
     }
     if (newArray)
     {
+      vtk::detail::vtkBufferFirstTouch(newArray, size * sizeof(ScalarType));
       this->SetBuffer(newArray, size);
       if (!this->MallocFunction)
       {
@@ -193,7 +279,10 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     return this->Allocate(0);
   }
 
-  if (this->Pointer && this->DeleteFunction != free)
+  // Buffers owned by the memory arena can be grown by its realloc function
+  const bool arenaBuffer = this->DeleteFunction == vtkMemoryArena::Free &&
+    this->ReallocFunction == vtkMemoryArena::Realloc;
+  if (this->Pointer && (this->FileMapped || (this->DeleteFunction != free && !arenaBuffer)))
   {
     ScalarType* newArray;
     bool forceFreeFunction = false;
@@ -34,6 +34,7 @@
 #include "vtkUnsignedShortArray.h"
 
 #include <algorithm> // for min(), max()
+#include <cmath>     // for std::isinf(), std::sqrt()
 #include <vector>
 
 namespace
@@ -61,10 +62,73 @@ bool hasValidKey(InfoType info, KeyType key, ComponentKeyType ckey, double range
   return false;
 }
 
+//------------------------------------------------------------------------------
+void setComponentRangeKeys(vtkInformation* info, vtkInformationInformationVectorKey* key,
+  vtkInformationDoubleVectorKey* ckey, const double* ranges, int numComps)
+{
+  vtkInformationVector* infoVec = vtkInformationVector::New();
+  info->Set(key, infoVec);
+
+  infoVec->SetNumberOfInformationObjects(numComps);
+  for (int i = 0; i < numComps; ++i)
+  {
+    infoVec->GetInformationObject(i)->Set(ckey, ranges + (i * 2), 2);
+  }
+  infoVec->FastDelete();
+}
+
+//------------------------------------------------------------------------------
+// Return true if value is an extremum of range, in which case overwriting it may
+// shrink the range.
+bool isRangeExtremum(const double range[2], double value)
+{
+  return value <= range[0] || value >= range[1];
+}
+
+//------------------------------------------------------------------------------
+// Extend range to include other, ignoring other if it is empty (max to min).
+void mergeRange(double range[2], const double other[2])
+{
+  if (other[0] <= other[1])
+  {
+    range[0] = (std::min)(range[0], other[0]);
+    range[1] = (std::max)(range[1], other[1]);
+  }
+}
+
 } // end anon namespace
 
 VTK_ABI_NAMESPACE_BEGIN
 
+//------------------------------------------------------------------------------
+// Ranges of the array as of the last full or patched computation, used when range
+// tracking is enabled to only scan the tuples modified since then.
+struct vtkDataArray::vtkRangeCache
+{
+  bool Valid = false;
+  bool NeedsFullScan = false;
+  int NumberOfComponents = 0;
+  vtkIdType NumberOfTuples = 0;
+  std::vector<double> Ranges;
+  std::vector<double> FiniteRanges;
+  double L2Range[2];
+  double FiniteL2Range[2];
+  // Bounds of the overwritten tuples, empty if DirtyBegin >= DirtyEnd.
+  vtkIdType DirtyBegin = 0;
+  vtkIdType DirtyEnd = 0;
+  // Avoids checking a tuple twice when SetTuple() is implemented with SetComponent().
+  vtkIdType LastMarkedTuple = -1;
+  std::vector<double> Tuple;
+
+  void Invalidate()
+  {
+    this->Valid = false;
+    this->NeedsFullScan = false;
+    this->DirtyBegin = this->DirtyEnd = 0;
+    this->LastMarkedTuple = -1;
+  }
+};
+
 vtkInformationKeyRestrictedMacro(vtkDataArray, COMPONENT_RANGE, DoubleVector, 2);
 vtkInformationKeyRestrictedMacro(vtkDataArray, L2_NORM_RANGE, DoubleVector, 2);
 vtkInformationKeyRestrictedMacro(vtkDataArray, L2_NORM_FINITE_RANGE, DoubleVector, 2);
@@ -89,6 +153,7 @@ vtkDataArray::~vtkDataArray()
     this->LookupTable->Delete();
   }
   this->SetName(nullptr);
+  delete this->RangeCache;
 }
 
 //------------------------------------------------------------------------------
@@ -119,6 +184,7 @@ void vtkDataArray::ShallowCopy(vtkDataArray* other)
 //------------------------------------------------------------------------------
 void vtkDataArray::SetTuple(vtkIdType i, const float* source)
 {
+  this->TupleAboutToBeModified(i);
   for (int c = 0; c < this->NumberOfComponents; ++c)
   {
     this->SetComponent(i, c, static_cast<double>(source[c]));
@@ -128,6 +194,7 @@ void vtkDataArray::SetTuple(vtkIdType i, const float* source)
 //------------------------------------------------------------------------------
 void vtkDataArray::SetTuple(vtkIdType i, const double* source)
 {
+  this->TupleAboutToBeModified(i);
   for (int c = 0; c < this->NumberOfComponents; ++c)
   {
     this->SetComponent(i, c, source[c]);
@@ -701,6 +768,7 @@ void vtkDataArray::FillComponent(int compIdx, double value)
   // Xcode 8.2 calls GetNumberOfTuples() after each iteration.
   // Prevent this by storing the result in a local variable.
   vtkIdType numberOfTuples = this->GetNumberOfTuples();
+  this->ResetRangeTracking();
   for (vtkIdType i = 0; i < numberOfTuples; i++)
   {
     this->SetComponent(i, compIdx, value);
@@ -790,7 +858,8 @@ void vtkDataArray::ComputeFiniteRange(
     }
     rkey = L2_NORM_FINITE_RANGE();
     // hasValidKey will update range to the cached value if it exists.
-    if (!hasValidKey(info, rkey, range))
+    if (!hasValidKey(info, rkey, range) &&
+      !(this->UpdateCachedRanges() && hasValidKey(info, rkey, range)))
     {
       this->ComputeFiniteVectorRange(range);
       info->Set(rkey, range, 2);
@@ -812,21 +881,15 @@ void vtkDataArray::ComputeFiniteRange(
     rkey = COMPONENT_RANGE();
 
     // hasValidKey will update range to the cached value if it exists.
-    if (!hasValidKey(info, PER_FINITE_COMPONENT(), rkey, range, comp))
+    if (!hasValidKey(info, PER_FINITE_COMPONENT(), rkey, range, comp) &&
+      !(this->UpdateCachedRanges() && hasValidKey(info, PER_FINITE_COMPONENT(), rkey, range, comp)))
     {
       const bool computed = this->ComputeFiniteScalarRange(allCompRanges.data());
       if (computed)
       {
         // construct the keys and add them to the info object
-        vtkInformationVector* infoVec = vtkInformationVector::New();
-        info->Set(PER_FINITE_COMPONENT(), infoVec);
-
-        infoVec->SetNumberOfInformationObjects(this->NumberOfComponents);
-        for (int i = 0; i < this->NumberOfComponents; ++i)
-        {
-          infoVec->GetInformationObject(i)->Set(rkey, allCompRanges.data() + (i * 2), 2);
-        }
-        infoVec->FastDelete();
+        setComponentRangeKeys(
+          info, PER_FINITE_COMPONENT(), rkey, allCompRanges.data(), this->NumberOfComponents);
 
         // update the range passed in since we have a valid range.
         range[0] = allCompRanges[comp * 2];
@@ -872,7 +935,8 @@ void vtkDataArray::ComputeRange(
     }
     rkey = L2_NORM_RANGE();
     // hasValidKey will update range to the cached value if it exists.
-    if (!hasValidKey(info, rkey, range))
+    if (!hasValidKey(info, rkey, range) &&
+      !(this->UpdateCachedRanges() && hasValidKey(info, rkey, range)))
     {
       this->ComputeVectorRange(range);
       info->Set(rkey, range, 2);
@@ -894,21 +958,15 @@ void vtkDataArray::ComputeRange(
     rkey = COMPONENT_RANGE();
 
     // hasValidKey will update range to the cached value if it exists.
-    if (!hasValidKey(info, PER_COMPONENT(), rkey, range, comp))
+    if (!hasValidKey(info, PER_COMPONENT(), rkey, range, comp) &&
+      !(this->UpdateCachedRanges() && hasValidKey(info, PER_COMPONENT(), rkey, range, comp)))
     {
       const bool computed = this->ComputeScalarRange(allCompRanges.data());
       if (computed)
       {
         // construct the keys and add them to the info object
-        vtkInformationVector* infoVec = vtkInformationVector::New();
-        info->Set(PER_COMPONENT(), infoVec);
-
-        infoVec->SetNumberOfInformationObjects(this->NumberOfComponents);
-        for (int i = 0; i < this->NumberOfComponents; ++i)
-        {
-          infoVec->GetInformationObject(i)->Set(rkey, allCompRanges.data() + (i * 2), 2);
-        }
-        infoVec->FastDelete();
+        setComponentRangeKeys(
+          info, PER_COMPONENT(), rkey, allCompRanges.data(), this->NumberOfComponents);
 
         // update the range passed in since we have a valid range.
         range[0] = allCompRanges[comp * 2];
@@ -918,6 +976,181 @@ void vtkDataArray::ComputeRange(
   }
 }
 
+//------------------------------------------------------------------------------
+bool vtkDataArray::UpdateCachedRanges()
+{
+  const int numComps = this->NumberOfComponents;
+  const vtkIdType numTuples = this->GetNumberOfTuples();
+  std::vector<double> ranges(2 * numComps);
+  std::vector<double> finiteRanges(2 * numComps);
+  double l2Range[2];
+  double finiteL2Range[2];
+
+  vtkRangeCache* cache = this->RangeCache;
+  if (cache && cache->Valid && !cache->NeedsFullScan &&
+    cache->NumberOfComponents == numComps && cache->NumberOfTuples <= numTuples)
+  {
+    // Only scan the overwritten and the appended tuples, then merge with the
+    // cached ranges. This is exact since no overwritten value was an extremum.
+    vtkIdType begin = cache->NumberOfTuples;
+    if (cache->DirtyBegin < cache->DirtyEnd)
+    {
+      begin = (std::min)(begin, cache->DirtyBegin);
+    }
+    const vtkIdType end = numTuples > cache->NumberOfTuples ? numTuples : cache->DirtyEnd;
+    if (begin < end &&
+      this->ComputeFusedRanges(
+        begin, end, ranges.data(), finiteRanges.data(), l2Range, finiteL2Range))
+    {
+      for (int i = 0; i < 2 * numComps; i += 2)
+      {
+        mergeRange(&cache->Ranges[i], &ranges[i]);
+        mergeRange(&cache->FiniteRanges[i], &finiteRanges[i]);
+      }
+      if (numComps > 1)
+      {
+        mergeRange(cache->L2Range, l2Range);
+        mergeRange(cache->FiniteL2Range, finiteL2Range);
+      }
+    }
+    std::copy(cache->Ranges.begin(), cache->Ranges.end(), ranges.begin());
+    std::copy(cache->FiniteRanges.begin(), cache->FiniteRanges.end(), finiteRanges.begin());
+    std::copy(cache->L2Range, cache->L2Range + 2, l2Range);
+    std::copy(cache->FiniteL2Range, cache->FiniteL2Range + 2, finiteL2Range);
+  }
+  else if (!this->ComputeFusedRanges(
+             0, numTuples, ranges.data(), finiteRanges.data(), l2Range, finiteL2Range))
+  {
+    if (cache)
+    {
+      cache->Invalidate();
+    }
+    return false;
+  }
+
+  if (cache)
+  {
+    cache->Valid = true;
+    cache->NeedsFullScan = false;
+    cache->NumberOfComponents = numComps;
+    cache->NumberOfTuples = numTuples;
+    cache->Ranges = ranges;
+    cache->FiniteRanges = finiteRanges;
+    std::copy(l2Range, l2Range + 2, cache->L2Range);
+    std::copy(finiteL2Range, finiteL2Range + 2, cache->FiniteL2Range);
+    cache->DirtyBegin = cache->DirtyEnd = 0;
+    cache->LastMarkedTuple = -1;
+  }
+
+  vtkInformation* info = this->GetInformation();
+  setComponentRangeKeys(info, PER_COMPONENT(), COMPONENT_RANGE(), ranges.data(), numComps);
+  setComponentRangeKeys(
+    info, PER_FINITE_COMPONENT(), COMPONENT_RANGE(), finiteRanges.data(), numComps);
+  if (numComps > 1)
+  {
+    info->Set(L2_NORM_RANGE(), l2Range, 2);
+    info->Set(L2_NORM_FINITE_RANGE(), finiteL2Range, 2);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArray::SetRangeTracking(bool tracking)
+{
+  if (tracking == (this->RangeCache != nullptr))
+  {
+    return;
+  }
+  if (tracking)
+  {
+    this->RangeCache = new vtkRangeCache;
+  }
+  else
+  {
+    delete this->RangeCache;
+    this->RangeCache = nullptr;
+  }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArray::ResetRangeTracking()
+{
+  if (this->RangeCache)
+  {
+    this->RangeCache->NeedsFullScan = true;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArray::MarkTuplesModified(vtkIdType begin, vtkIdType end)
+{
+  vtkRangeCache* cache = this->RangeCache;
+  if (!cache || !cache->Valid || cache->NeedsFullScan || begin >= end)
+  {
+    return;
+  }
+  if (begin == cache->LastMarkedTuple && end == begin + 1)
+  {
+    return;
+  }
+
+  const int numComps = this->NumberOfComponents;
+  // Appended tuples are scanned anyway, only overwritten ones need to be checked.
+  begin = (std::max)(begin, vtkIdType(0));
+  end = (std::min)(end, (std::min)(cache->NumberOfTuples, this->GetNumberOfTuples()));
+  if (numComps != cache->NumberOfComponents || 4 * (end - begin) > cache->NumberOfTuples)
+  {
+    // Scanning the whole array is cheaper than checking that many tuples.
+    cache->NeedsFullScan = true;
+    return;
+  }
+
+  cache->Tuple.resize(numComps);
+  double* tuple = cache->Tuple.data();
+  for (vtkIdType tupleIdx = begin; tupleIdx < end; ++tupleIdx)
+  {
+    this->GetTuple(tupleIdx, tuple);
+    double squaredSum = 0.0;
+    for (int c = 0; c < numComps; ++c)
+    {
+      const double value = tuple[c];
+      if (isRangeExtremum(&cache->Ranges[2 * c], value) ||
+        (!std::isinf(value) && isRangeExtremum(&cache->FiniteRanges[2 * c], value)))
+      {
+        cache->NeedsFullScan = true;
+        return;
+      }
+      squaredSum += value * value;
+    }
+    if (numComps > 1)
+    {
+      const double magnitude = std::sqrt(squaredSum);
+      if (isRangeExtremum(cache->L2Range, magnitude) ||
+        (!std::isinf(squaredSum) && isRangeExtremum(cache->FiniteL2Range, magnitude)))
+      {
+        cache->NeedsFullScan = true;
+        return;
+      }
+    }
+  }
+
+  if (begin < end)
+  {
+    if (cache->DirtyBegin < cache->DirtyEnd)
+    {
+      cache->DirtyBegin = (std::min)(cache->DirtyBegin, begin);
+      cache->DirtyEnd = (std::max)(cache->DirtyEnd, end);
+    }
+    else
+    {
+      cache->DirtyBegin = begin;
+      cache->DirtyEnd = end;
+    }
+    cache->LastMarkedTuple = end == begin + 1 ? begin : -1;
+  }
+}
+
 //------------------------------------------------------------------------------
 // call modified on superclass
 void vtkDataArray::Modified()
@@ -1064,6 +1297,7 @@ void vtkDataArray::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Tuples: " << this->GetNumberOfTuples() << "\n";
   os << indent << "Size: " << this->Size << "\n";
   os << indent << "MaxId: " << this->MaxId << "\n";
+  os << indent << "RangeTracking: " << (this->RangeCache ? "On" : "Off") << "\n";
   if (this->LookupTable)
   {
     os << indent << "Lookup Table:\n";
@@ -487,6 +487,33 @@ public:
    */
   void GetFiniteRange(double range[2]) { this->GetFiniteRange(range, 0); }
 
+  ///@{
+  /**
+   * Track the tuples modified after the ranges have been computed. When enabled,
+   * the next GetRange() or GetFiniteRange() call following a Modified() only scans
+   * the modified and the appended tuples to update the cached ranges, instead of
+   * the whole array. The whole array is scanned again when an overwritten value was
+   * one of the extrema of a cached range, or when a large part of the array changed.
+   *
+   * Writes through the vtkDataArray API (SetTuple(), SetComponent(), InsertTuple(),
+   * InsertTuples(), Fill()...) are tracked. Writes through the typed API of the
+   * subclasses (SetValue(), SetTypedTuple()...) or through raw pointers are not, and
+   * must be announced with MarkTuplesModified() before the values change.
+   *
+   * Default is false.
+   */
+  void SetRangeTracking(bool tracking);
+  bool GetRangeTracking() const { return this->RangeCache != nullptr; }
+  vtkBooleanMacro(RangeTracking, bool);
+  ///@}
+
+  /**
+   * Announce that the tuples in [begin, end) are about to be overwritten. Only
+   * needed when range tracking is enabled, see SetRangeTracking(), and must be
+   * called before the values are changed.
+   */
+  void MarkTuplesModified(vtkIdType begin, vtkIdType end);
+
   ///@{
   /**
    * These methods return the Min and Max possible range of the native
@@ -694,6 +721,38 @@ protected:
     double range[2], const unsigned char* ghosts, unsigned char ghostsToSkip = 0xff);
   ///@}
 
+  /**
+   * Compute in a single pass over the tuples in [begin, end) the range and the
+   * finite range of each component and, for arrays with more than one component,
+   * the range and the finite range of the L2 norm. \a ranges and \a finiteRanges
+   * must hold two times the number of components.
+   *
+   * Returns false if nothing was computed, because the tuple range is empty or
+   * because the subclass computes its ranges differently. In that case the
+   * Compute*Range methods above are used instead.
+   */
+  virtual bool ComputeFusedRanges(vtkIdType begin, vtkIdType end, double* ranges,
+    double* finiteRanges, double l2Range[2], double finiteL2Range[2]);
+
+  /**
+   * Record for range tracking that a tuple is about to be overwritten,
+   * see SetRangeTracking(). Does nothing when range tracking is disabled.
+   */
+  void TupleAboutToBeModified(vtkIdType tupleIdx)
+  {
+    if (this->RangeCache)
+    {
+      this->MarkTuplesModified(tupleIdx, tupleIdx + 1);
+    }
+  }
+
+  /**
+   * Discard the tracked ranges after a change of the whole array, so that the next
+   * range computation scans all the tuples. Does nothing when range tracking is
+   * disabled.
+   */
+  void ResetRangeTracking();
+
   // Construct object with default tuple dimension (number of components) of 1.
   vtkDataArray();
   ~vtkDataArray() override;
@@ -705,6 +764,17 @@ protected:
 private:
   double* GetTupleN(vtkIdType i, int n);
 
+  /**
+   * Compute all the cached ranges at once, either with a full pass or, if range
+   * tracking allows it, by only scanning the modified tuples. Fills the information
+   * keys used by ComputeRange() and ComputeFiniteRange(), and returns false if
+   * nothing was computed.
+   */
+  bool UpdateCachedRanges();
+
+  struct vtkRangeCache;
+  vtkRangeCache* RangeCache = nullptr;
+
   vtkDataArray(const vtkDataArray&) = delete;
   void operator=(const vtkDataArray&) = delete;
 };
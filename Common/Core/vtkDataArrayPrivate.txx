@@ -9,6 +9,7 @@
 #include "vtkDataArray.h"
 #include "vtkDataArrayRange.h"
 #include "vtkMathUtilities.h"
+#include "vtkSIMDKernels.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
 #include "vtkTypeTraits.h"
@@ -92,6 +93,30 @@ bool isinf(T x)
 }
 }
 
+//----------------------------------------------------------------------------
+// Contiguous single component float and double arrays are processed by the
+// vectorized kernels, which skip NaN values branchlessly. Return false for the
+// other arrays.
+template <typename ArrayT, typename APIType>
+bool VectorizedMinAndMax(ArrayT*, vtkIdType, vtkIdType, APIType*, APIType*)
+{
+  return false;
+}
+
+inline bool VectorizedMinAndMax(vtkAOSDataArrayTemplate<float>* array, vtkIdType begin,
+  vtkIdType end, float* range, float* finiteRange)
+{
+  vtk::detail::simd::MinMax(array->GetPointer(begin), end - begin, range, finiteRange);
+  return true;
+}
+
+inline bool VectorizedMinAndMax(vtkAOSDataArrayTemplate<double>* array, vtkIdType begin,
+  vtkIdType end, double* range, double* finiteRange)
+{
+  vtk::detail::simd::MinMax(array->GetPointer(begin), end - begin, range, finiteRange);
+  return true;
+}
+
 template <typename APIType, int NumComps>
 class MinAndMax
 {
@@ -164,6 +189,11 @@ public:
   {
     const auto tuples = vtk::DataArrayTupleRange<NumComps>(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
+    if (NumComps == 1 && !this->Ghosts &&
+      VectorizedMinAndMax(this->Array, begin, end, range.data(), static_cast<APIType*>(nullptr)))
+    {
+      return;
+    }
     const unsigned char* ghostIt = this->Ghosts ? this->Ghosts + begin : nullptr;
     for (const auto tuple : tuples)
     {
@@ -205,6 +235,12 @@ public:
   {
     const auto tuples = vtk::DataArrayTupleRange<NumComps>(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
+    APIType allRange[2] = { vtkTypeTraits<APIType>::Max(), vtkTypeTraits<APIType>::Min() };
+    if (NumComps == 1 && !this->Ghosts &&
+      VectorizedMinAndMax(this->Array, begin, end, allRange, range.data()))
+    {
+      return;
+    }
     const unsigned char* ghostIt = this->Ghosts ? this->Ghosts + begin : nullptr;
     for (const auto tuple : tuples)
     {
@@ -623,6 +659,208 @@ bool DoComputeVectorRange(ArrayT* array, RangeValueType range[2], FiniteValues,
   return true;
 }
 
+//----------------------------------------------------------------------------
+// Compute in a single pass the range and the finite range of every component
+// and, optionally, the range and the finite range of the L2 norm. Reading the
+// array once instead of once per kind of range matters for large arrays, whose
+// range computation is bound by the memory bandwidth.
+template <int TupleSize, typename ArrayT, typename APIType = typename vtk::GetAPIType<ArrayT>>
+class FusedMinAndMax
+{
+private:
+  struct LocalRanges
+  {
+    std::vector<APIType> Ranges;
+    std::vector<APIType> FiniteRanges;
+    double Magnitude[2];
+    double FiniteMagnitude[2];
+  };
+
+  ArrayT* Array;
+  int NumComps;
+  bool ComputeMagnitude;
+  vtkSMPThreadLocal<LocalRanges> TLRanges;
+
+public:
+  std::vector<double> Ranges;
+  std::vector<double> FiniteRanges;
+  double Magnitude[2];
+  double FiniteMagnitude[2];
+
+  FusedMinAndMax(ArrayT* array, bool computeMagnitude)
+    : Array(array)
+    , NumComps(array->GetNumberOfComponents())
+    , ComputeMagnitude(computeMagnitude)
+    , Ranges(2 * this->NumComps)
+    , FiniteRanges(2 * this->NumComps)
+  {
+    for (int i = 0, j = 0; i < this->NumComps; ++i, j += 2)
+    {
+      this->Ranges[j] = this->FiniteRanges[j] = vtkTypeTraits<double>::Max();
+      this->Ranges[j + 1] = this->FiniteRanges[j + 1] = vtkTypeTraits<double>::Min();
+    }
+    this->Magnitude[0] = this->FiniteMagnitude[0] = vtkTypeTraits<double>::Max();
+    this->Magnitude[1] = this->FiniteMagnitude[1] = vtkTypeTraits<double>::Min();
+  }
+  void Initialize()
+  {
+    auto& local = this->TLRanges.Local();
+    local.Ranges.resize(2 * this->NumComps);
+    local.FiniteRanges.resize(2 * this->NumComps);
+    for (int i = 0, j = 0; i < this->NumComps; ++i, j += 2)
+    {
+      local.Ranges[j] = local.FiniteRanges[j] = vtkTypeTraits<APIType>::Max();
+      local.Ranges[j + 1] = local.FiniteRanges[j + 1] = vtkTypeTraits<APIType>::Min();
+    }
+    local.Magnitude[0] = local.FiniteMagnitude[0] = vtkTypeTraits<double>::Max();
+    local.Magnitude[1] = local.FiniteMagnitude[1] = vtkTypeTraits<double>::Min();
+  }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const auto tuples = vtk::DataArrayTupleRange<TupleSize>(this->Array, begin, end);
+    auto& local = this->TLRanges.Local();
+    APIType* range = local.Ranges.data();
+    APIType* finiteRange = local.FiniteRanges.data();
+    // Single component arrays have no magnitude range to compute
+    if (TupleSize == 1 && VectorizedMinAndMax(this->Array, begin, end, range, finiteRange))
+    {
+      return;
+    }
+    for (const auto tuple : tuples)
+    {
+      // Magnitudes are always computed at double precision, see DoComputeVectorRange.
+      double squaredSum = 0.0;
+      size_t j = 0;
+      for (const APIType value : tuple)
+      {
+        vtkMathUtilities::UpdateRange(range[j], range[j + 1], value);
+        if (!detail::isinf(value))
+        {
+          vtkMathUtilities::UpdateRange(finiteRange[j], finiteRange[j + 1], value);
+        }
+        squaredSum += static_cast<double>(value) * static_cast<double>(value);
+        j += 2;
+      }
+      if (this->ComputeMagnitude)
+      {
+        local.Magnitude[0] = detail::min(local.Magnitude[0], squaredSum);
+        local.Magnitude[1] = detail::max(local.Magnitude[1], squaredSum);
+        if (!detail::isinf(squaredSum))
+        {
+          local.FiniteMagnitude[0] = detail::min(local.FiniteMagnitude[0], squaredSum);
+          local.FiniteMagnitude[1] = detail::max(local.FiniteMagnitude[1], squaredSum);
+        }
+      }
+    }
+  }
+  void Reduce()
+  {
+    for (auto itr = this->TLRanges.begin(); itr != this->TLRanges.end(); ++itr)
+    {
+      const auto& local = *itr;
+      for (int i = 0, j = 0; i < this->NumComps; ++i, j += 2)
+      {
+        // Empty thread local ranges are still max to min and thus do not contribute.
+        if (local.Ranges[j] <= local.Ranges[j + 1])
+        {
+          this->Ranges[j] = detail::min(this->Ranges[j], static_cast<double>(local.Ranges[j]));
+          this->Ranges[j + 1] =
+            detail::max(this->Ranges[j + 1], static_cast<double>(local.Ranges[j + 1]));
+        }
+        if (local.FiniteRanges[j] <= local.FiniteRanges[j + 1])
+        {
+          this->FiniteRanges[j] =
+            detail::min(this->FiniteRanges[j], static_cast<double>(local.FiniteRanges[j]));
+          this->FiniteRanges[j + 1] =
+            detail::max(this->FiniteRanges[j + 1], static_cast<double>(local.FiniteRanges[j + 1]));
+        }
+      }
+      this->Magnitude[0] = detail::min(this->Magnitude[0], local.Magnitude[0]);
+      this->Magnitude[1] = detail::max(this->Magnitude[1], local.Magnitude[1]);
+      this->FiniteMagnitude[0] = detail::min(this->FiniteMagnitude[0], local.FiniteMagnitude[0]);
+      this->FiniteMagnitude[1] = detail::max(this->FiniteMagnitude[1], local.FiniteMagnitude[1]);
+    }
+    if (this->ComputeMagnitude)
+    {
+      // now that we have computed the smallest and largest value, take the
+      // square root of that value.
+      this->Magnitude[0] = std::sqrt(this->Magnitude[0]);
+      this->Magnitude[1] = std::sqrt(this->Magnitude[1]);
+      this->FiniteMagnitude[0] = std::sqrt(this->FiniteMagnitude[0]);
+      this->FiniteMagnitude[1] = std::sqrt(this->FiniteMagnitude[1]);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+template <int TupleSize, typename ArrayT>
+void ComputeFusedRangesImpl(ArrayT* array, vtkIdType begin, vtkIdType end, double* ranges,
+  double* finiteRanges, double magnitudeRange[2], double finiteMagnitudeRange[2])
+{
+  const bool computeMagnitude = array->GetNumberOfComponents() > 1;
+  FusedMinAndMax<TupleSize, ArrayT> minmax(array, computeMagnitude);
+  vtkSMPTools::For(begin, end, minmax);
+  std::copy(minmax.Ranges.begin(), minmax.Ranges.end(), ranges);
+  std::copy(minmax.FiniteRanges.begin(), minmax.FiniteRanges.end(), finiteRanges);
+  if (computeMagnitude)
+  {
+    std::copy(minmax.Magnitude, minmax.Magnitude + 2, magnitudeRange);
+    std::copy(minmax.FiniteMagnitude, minmax.FiniteMagnitude + 2, finiteMagnitudeRange);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Compute all the ranges cached by vtkDataArray for the tuples [begin, end).
+// The magnitude ranges are only computed for arrays with several components.
+template <typename ArrayT>
+bool DoComputeFusedRanges(ArrayT* array, vtkIdType begin, vtkIdType end, double* ranges,
+  double* finiteRanges, double magnitudeRange[2], double finiteMagnitudeRange[2])
+{
+  const int numComp = array->GetNumberOfComponents();
+  for (int i = 0, j = 0; i < numComp; ++i, j += 2)
+  {
+    ranges[j] = finiteRanges[j] = vtkTypeTraits<double>::Max();
+    ranges[j + 1] = finiteRanges[j + 1] = vtkTypeTraits<double>::Min();
+  }
+  magnitudeRange[0] = finiteMagnitudeRange[0] = vtkTypeTraits<double>::Max();
+  magnitudeRange[1] = finiteMagnitudeRange[1] = vtkTypeTraits<double>::Min();
+
+  if (begin >= end)
+  {
+    return false;
+  }
+
+  // Fixed tuple sizes let the compiler unroll the loop over components.
+  switch (numComp)
+  {
+    case 1:
+      ComputeFusedRangesImpl<1>(
+        array, begin, end, ranges, finiteRanges, magnitudeRange, finiteMagnitudeRange);
+      break;
+    case 2:
+      ComputeFusedRangesImpl<2>(
+        array, begin, end, ranges, finiteRanges, magnitudeRange, finiteMagnitudeRange);
+      break;
+    case 3:
+      ComputeFusedRangesImpl<3>(
+        array, begin, end, ranges, finiteRanges, magnitudeRange, finiteMagnitudeRange);
+      break;
+    case 4:
+      ComputeFusedRangesImpl<4>(
+        array, begin, end, ranges, finiteRanges, magnitudeRange, finiteMagnitudeRange);
+      break;
+    case 9:
+      ComputeFusedRangesImpl<9>(
+        array, begin, end, ranges, finiteRanges, magnitudeRange, finiteMagnitudeRange);
+      break;
+    default:
+      ComputeFusedRangesImpl<vtk::detail::DynamicTupleSize>(
+        array, begin, end, ranges, finiteRanges, magnitudeRange, finiteMagnitudeRange);
+      break;
+  }
+  return true;
+}
+
 VTK_ABI_NAMESPACE_END
 } // end namespace vtkDataArrayPrivate
 #endif // VTK_GDA_TEMPLATE_EXTERN
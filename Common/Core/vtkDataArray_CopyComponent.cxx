@@ -64,6 +64,7 @@ void vtkDataArray::CopyComponent(int dstComponent, vtkDataArray* src, int srcCom
     return;
   }
 
+  this->ResetRangeTracking();
   CopyComponentWorker copyComponentWorker(srcComponent, dstComponent);
   if (!vtkArrayDispatch::Dispatch2::Execute(this, src, copyComponentWorker))
   {
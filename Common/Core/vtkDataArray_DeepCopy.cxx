@@ -140,6 +140,7 @@ void vtkDataArray::DeepCopy(vtkDataArray* da)
   if (this != da)
   {
     this->Superclass::DeepCopy(da); // copy Information object
+    this->ResetRangeTracking();
 
     vtkIdType numTuples = da->GetNumberOfTuples();
     int numComps = da->NumberOfComponents;
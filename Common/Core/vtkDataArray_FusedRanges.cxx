@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArray.h"
+
+// Must come before vtkArrayDispatch.h: once vtkGenericDataArray.h declares the
+// range functions extern, vtkDataArrayPrivate.txx is skipped.
+#include "vtkDataArrayPrivate.txx"
+
+#include "vtkArrayDispatch.h"
+
+namespace
+{
+
+// Wrap the DoComputeFusedRanges calls for vtkArrayDispatch:
+struct FusedRangesDispatchWrapper
+{
+  bool Success;
+  vtkIdType Begin;
+  vtkIdType End;
+  double* Ranges;
+  double* FiniteRanges;
+  double* MagnitudeRange;
+  double* FiniteMagnitudeRange;
+
+  FusedRangesDispatchWrapper(vtkIdType begin, vtkIdType end, double* ranges, double* finiteRanges,
+    double* magnitudeRange, double* finiteMagnitudeRange)
+    : Success(false)
+    , Begin(begin)
+    , End(end)
+    , Ranges(ranges)
+    , FiniteRanges(finiteRanges)
+    , MagnitudeRange(magnitudeRange)
+    , FiniteMagnitudeRange(finiteMagnitudeRange)
+  {
+  }
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    this->Success = vtkDataArrayPrivate::DoComputeFusedRanges(array, this->Begin, this->End,
+      this->Ranges, this->FiniteRanges, this->MagnitudeRange, this->FiniteMagnitudeRange);
+  }
+};
+
+} // end anon namespace
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+bool vtkDataArray::ComputeFusedRanges(vtkIdType begin, vtkIdType end, double* ranges,
+  double* finiteRanges, double l2Range[2], double finiteL2Range[2])
+{
+  FusedRangesDispatchWrapper worker(begin, end, ranges, finiteRanges, l2Range, finiteL2Range);
+  if (!vtkArrayDispatch::Dispatch::Execute(this, worker))
+  {
+    worker(this);
+  }
+  return worker.Success;
+}
+VTK_ABI_NAMESPACE_END
@@ -94,6 +94,14 @@ void vtkDataArray::InsertTuples(vtkIdList* dstIds, vtkIdList* srcIds, vtkAbstrac
 
   this->MaxId = std::max(this->MaxId, newSize - 1);
 
+  if (this->GetRangeTracking())
+  {
+    for (vtkIdType i = 0; i < dstIds->GetNumberOfIds(); ++i)
+    {
+      this->TupleAboutToBeModified(dstIds->GetId(i));
+    }
+  }
+
   SetTuplesIdListWorker worker(srcIds, dstIds);
   if (!vtkArrayDispatch::Dispatch2::Execute(srcDA, this, worker))
   {
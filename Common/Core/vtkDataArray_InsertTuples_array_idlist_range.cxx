@@ -84,6 +84,7 @@ void vtkDataArray::InsertTuplesStartingAt(
 
   this->MaxId = std::max(this->MaxId, newSize - 1);
 
+  this->MarkTuplesModified(dstStart, dstStart + srcIds->GetNumberOfIds());
   SetTuplesIdListRangeWorker worker(srcIds, dstStart);
   if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(srcDA, this, worker))
   {
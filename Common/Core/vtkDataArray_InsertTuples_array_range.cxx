@@ -88,6 +88,7 @@ void vtkDataArray::InsertTuples(
 
   this->MaxId = std::max(this->MaxId, newSize - 1);
 
+  this->MarkTuplesModified(dstStart, dstStart + n);
   SetTuplesRangeWorker worker(srcStart, dstStart, n);
   if (!vtkArrayDispatch::Dispatch2::Execute(srcDA, this, worker))
   {
@@ -51,6 +51,7 @@ void vtkDataArray::SetTuple(vtkIdType dstTupleIdx, vtkIdType srcTupleIdx, vtkAbs
     return;
   }
 
+  this->TupleAboutToBeModified(dstTupleIdx);
   SetTupleArrayWorker worker(srcTupleIdx, dstTupleIdx);
   if (!vtkArrayDispatch::Dispatch2::Execute(srcDA, this, worker))
   {
@@ -145,6 +145,7 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::SetComponent(
   vtkIdType tupleIdx, int compIdx, double value)
 {
   // Reimplemented for efficiency (base impl allocates heap memory)
+  this->TupleAboutToBeModified(tupleIdx);
   this->SetTypedComponent(tupleIdx, compIdx, static_cast<ValueType>(value));
 }
 
@@ -319,6 +320,7 @@ template <class DerivedT, class ValueTypeT>
 void vtkGenericDataArray<DerivedT, ValueTypeT>::DataChanged()
 {
   this->Lookup.ClearLookup();
+  this->ResetRangeTracking();
 }
 
 //-----------------------------------------------------------------------------
@@ -502,6 +504,7 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::SetTuple(
     return;
   }
 
+  this->TupleAboutToBeModified(dstTupleIdx);
   for (int c = 0; c < numComps; ++c)
   {
     this->SetTypedComponent(dstTupleIdx, c, other->GetTypedComponent(srcTupleIdx, c));
@@ -581,6 +584,7 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::InsertTuples(
   {
     vtkIdType srcT = srcIds->GetId(t);
     vtkIdType dstT = dstIds->GetId(t);
+    this->TupleAboutToBeModified(dstT);
     for (int c = 0; c < numComps; ++c)
     {
       this->SetTypedComponent(dstT, c, other->GetTypedComponent(srcT, c));
@@ -649,6 +653,7 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::InsertTuplesStartingAt(
   this->MaxId = (std::max)(this->MaxId, newSize - 1);
 
   vtkIdType numTuples = srcIds->GetNumberOfIds();
+  this->MarkTuplesModified(dstStart, dstStart + numTuples);
   for (vtkIdType t = 0; t < numTuples; ++t)
   {
     vtkIdType srcT = srcIds->GetId(t);
@@ -950,6 +955,7 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::FillTypedComponent(int compIdx,
                   << this->NumberOfComponents << ")");
     return;
   }
+  this->ResetRangeTracking();
   for (vtkIdType i = 0; i < this->GetNumberOfTuples(); ++i)
   {
     this->SetTypedComponent(i, compIdx, value);
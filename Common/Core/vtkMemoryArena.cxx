@@ -0,0 +1,386 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkMemoryArena.h"
+
+#include "vtkObject.h"
+
+#include <algorithm>     // For std::min
+#include <atomic>        // For std::atomic
+#include <cstdint>       // For std::uintptr_t
+#include <cstdlib>       // For std::malloc, std::getenv
+#include <cstring>       // For std::memcpy
+#include <iterator>      // For std::next
+#include <mutex>         // For std::mutex
+#include <unordered_map> // For std::unordered_map
+#include <vector>        // For std::vector
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Stored right before each block returned to the user.
+struct BlockHeader
+{
+  void* Base;             // Start of the system allocation
+  std::size_t Capacity;   // Usable bytes, i.e. the size class of the block
+  std::size_t SystemSize; // Size of the system allocation
+  std::size_t Alignment;  // Alignment used to place the block
+  unsigned int Magic;     // Detects blocks that do not come from the arena
+  bool Mapped;            // True if allocated with mmap
+};
+
+constexpr unsigned int BlockMagic = 0x76746b41; // "vtkA"
+constexpr std::size_t HugePageThreshold = 2 << 20;
+
+//------------------------------------------------------------------------------
+// Round a size up to its size class: multiples of 64 bytes below 4KB, then four
+// classes per power of two so that at most a quarter of a block is wasted.
+std::size_t GetSizeClass(std::size_t size)
+{
+  if (size <= 4096)
+  {
+    return ((std::max)(size, std::size_t(1)) + 63) & ~std::size_t(63);
+  }
+  std::size_t power = 4096;
+  while (power < size / 2)
+  {
+    power *= 2;
+  }
+  const std::size_t step = power / 4;
+  return (size + step - 1) / step * step;
+}
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment)
+{
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+//------------------------------------------------------------------------------
+struct ArenaState
+{
+  std::mutex Mutex;
+  std::unordered_map<std::size_t, std::vector<BlockHeader*>> FreeBlocks;
+  std::size_t CachedSize = 0;
+  std::size_t MaximumCachedSize = std::size_t(1) << 30;
+  std::size_t Alignment = 64;
+  int HugePages = vtkMemoryArena::HUGE_PAGES_NONE;
+  std::atomic<bool> Enabled{ false };
+
+  ArenaState()
+  {
+    const char* env = std::getenv("VTK_MEMORY_ARENA");
+    this->Enabled = env && std::atoi(env) != 0;
+  }
+
+  // Must be called with the mutex locked
+  void ReleaseAll()
+  {
+    for (auto& freeBlocks : this->FreeBlocks)
+    {
+      for (BlockHeader* header : freeBlocks.second)
+      {
+        ReleaseSystemBlock(header);
+      }
+    }
+    this->FreeBlocks.clear();
+    this->CachedSize = 0;
+  }
+
+  static void ReleaseSystemBlock(BlockHeader* header)
+  {
+#if defined(__linux__)
+    if (header->Mapped)
+    {
+      munmap(header->Base, header->SystemSize);
+      return;
+    }
+#endif
+    std::free(header->Base);
+  }
+};
+
+// Intentionally leaked: blocks may be released during static destruction.
+ArenaState& GetState()
+{
+  static ArenaState* state = new ArenaState;
+  return *state;
+}
+
+VTK_THREAD_LOCAL int ScopeEnabled = -1; // -1: no scope, use the global setting
+
+//------------------------------------------------------------------------------
+BlockHeader* AllocateSystemBlock(std::size_t capacity, std::size_t alignment, int hugePages)
+{
+  // The header sits right before the aligned user block
+  const std::size_t headerSize = AlignUp(sizeof(BlockHeader), alignment);
+  void* base = nullptr;
+  std::size_t systemSize = headerSize + capacity;
+  bool mapped = false;
+
+#if defined(__linux__)
+  if (hugePages != vtkMemoryArena::HUGE_PAGES_NONE && capacity >= HugePageThreshold)
+  {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    std::size_t pageSize = HugePageThreshold;
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+    if (hugePages == vtkMemoryArena::HUGE_PAGES_2MB)
+    {
+      flags |= MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+    }
+    else if (hugePages == vtkMemoryArena::HUGE_PAGES_1GB)
+    {
+      flags |= MAP_HUGETLB | (30 << MAP_HUGE_SHIFT);
+      pageSize = std::size_t(1) << 30;
+    }
+#endif
+    const std::size_t mappedSize = AlignUp(systemSize, pageSize);
+    void* address = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (address == MAP_FAILED && (flags & ~(MAP_PRIVATE | MAP_ANONYMOUS)))
+    {
+      // No explicit huge pages available, fall back to transparent ones
+      address =
+        mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (address != MAP_FAILED)
+    {
+#if defined(MADV_HUGEPAGE)
+      madvise(address, mappedSize, MADV_HUGEPAGE);
+#endif
+      base = address;
+      systemSize = mappedSize;
+      mapped = true;
+    }
+  }
+#else
+  (void)hugePages;
+#endif
+
+  if (!base)
+  {
+    // Over-allocate so the header and user block can be aligned
+    systemSize += alignment;
+    base = std::malloc(systemSize);
+    if (!base)
+    {
+      return nullptr;
+    }
+  }
+
+  const std::uintptr_t user =
+    AlignUp(reinterpret_cast<std::uintptr_t>(base) + sizeof(BlockHeader), alignment);
+  BlockHeader* header = reinterpret_cast<BlockHeader*>(user) - 1;
+  header->Base = base;
+  header->Capacity = capacity;
+  header->SystemSize = systemSize;
+  header->Alignment = alignment;
+  header->Magic = BlockMagic;
+  header->Mapped = mapped;
+  return header;
+}
+
+BlockHeader* GetHeader(void* block)
+{
+  BlockHeader* header = static_cast<BlockHeader*>(block) - 1;
+  if (header->Magic != BlockMagic)
+  {
+    vtkGenericWarningMacro(
+      "vtkMemoryArena: releasing a block that was not allocated by the arena.");
+    return nullptr;
+  }
+  return header;
+}
+} // anonymous namespace
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+void vtkMemoryArena::SetEnabled(bool enabled)
+{
+  GetState().Enabled = enabled;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMemoryArena::GetEnabled()
+{
+  return GetState().Enabled;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMemoryArena::IsActive()
+{
+  return ScopeEnabled >= 0 ? ScopeEnabled != 0 : vtkMemoryArena::GetEnabled();
+}
+
+//------------------------------------------------------------------------------
+vtkMemoryArena::Scope::Scope(bool enabled)
+  : Previous(ScopeEnabled)
+{
+  ScopeEnabled = enabled ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+vtkMemoryArena::Scope::~Scope()
+{
+  ScopeEnabled = this->Previous;
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryArena::SetAlignment(std::size_t alignment)
+{
+  if (alignment < alignof(BlockHeader) || (alignment & (alignment - 1)) != 0)
+  {
+    vtkGenericWarningMacro(
+      "vtkMemoryArena: alignment must be a power of two, " << alignment << " ignored.");
+    return;
+  }
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.Alignment = alignment;
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkMemoryArena::GetAlignment()
+{
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.Alignment;
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryArena::SetHugePages(int mode)
+{
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.HugePages = (std::max)(
+    int(HUGE_PAGES_NONE), (std::min)(mode, int(HUGE_PAGES_1GB)));
+}
+
+//------------------------------------------------------------------------------
+int vtkMemoryArena::GetHugePages()
+{
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.HugePages;
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryArena::SetMaximumCachedSize(std::size_t numberOfBytes)
+{
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.MaximumCachedSize = numberOfBytes;
+  if (state.CachedSize > numberOfBytes)
+  {
+    state.ReleaseAll();
+  }
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkMemoryArena::GetMaximumCachedSize()
+{
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.MaximumCachedSize;
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkMemoryArena::GetCachedSize()
+{
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.CachedSize;
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryArena::ReleaseCachedMemory()
+{
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.ReleaseAll();
+}
+
+//------------------------------------------------------------------------------
+void* vtkMemoryArena::Malloc(std::size_t size)
+{
+  const std::size_t capacity = GetSizeClass(size);
+  auto& state = GetState();
+  std::size_t alignment;
+  int hugePages;
+  {
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    alignment = state.Alignment;
+    hugePages = state.HugePages;
+    auto it = state.FreeBlocks.find(capacity);
+    if (it != state.FreeBlocks.end())
+    {
+      auto& freeBlocks = it->second;
+      // Reuse the most recently released block with a matching alignment
+      for (auto blockIt = freeBlocks.rbegin(); blockIt != freeBlocks.rend(); ++blockIt)
+      {
+        BlockHeader* header = *blockIt;
+        if (header->Alignment == alignment)
+        {
+          freeBlocks.erase(std::next(blockIt).base());
+          state.CachedSize -= header->Capacity;
+          return header + 1;
+        }
+      }
+    }
+  }
+
+  BlockHeader* header = AllocateSystemBlock(capacity, alignment, hugePages);
+  return header ? header + 1 : nullptr;
+}
+
+//------------------------------------------------------------------------------
+void* vtkMemoryArena::Realloc(void* block, std::size_t size)
+{
+  if (!block)
+  {
+    return vtkMemoryArena::Malloc(size);
+  }
+  BlockHeader* header = GetHeader(block);
+  if (!header)
+  {
+    return nullptr;
+  }
+  if (size <= header->Capacity)
+  {
+    return block;
+  }
+  void* newBlock = vtkMemoryArena::Malloc(size);
+  if (newBlock)
+  {
+    std::memcpy(newBlock, block, header->Capacity);
+    vtkMemoryArena::Free(block);
+  }
+  return newBlock;
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryArena::Free(void* block)
+{
+  if (!block)
+  {
+    return;
+  }
+  BlockHeader* header = GetHeader(block);
+  if (!header)
+  {
+    return;
+  }
+  auto& state = GetState();
+  {
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    if (state.CachedSize + header->Capacity <= state.MaximumCachedSize)
+    {
+      state.FreeBlocks[header->Capacity].push_back(header);
+      state.CachedSize += header->Capacity;
+      return;
+    }
+  }
+  ArenaState::ReleaseSystemBlock(header);
+}
+VTK_ABI_NAMESPACE_END
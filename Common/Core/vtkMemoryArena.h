@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkMemoryArena
+ * @brief   pooling allocator for the buffers of data arrays.
+ *
+ * Pipelines re-executed every time step allocate and release many arrays of
+ * identical sizes. When enabled, vtkMemoryArena is used by vtkBuffer (and thus
+ * vtkAOSDataArrayTemplate and vtkSOADataArrayTemplate) instead of malloc/free:
+ * released blocks are kept in size classes and handed back to the next allocation
+ * of a similar size, so repeated executions reuse memory instead of paying page
+ * faults again.
+ *
+ * The arena is enabled process-wide with SetEnabled() or the VTK_MEMORY_ARENA
+ * environment variable, or for the current thread only (e.g. around a pipeline
+ * Update()) with a vtkMemoryArena::Scope. Blocks remember they come from the arena,
+ * so they can be released after the arena has been disabled.
+ *
+ * Allocations are aligned on GetAlignment() bytes, which defaults to 64 for SIMD
+ * loads and cache line alignment. On Linux, large blocks can be backed by huge
+ * pages, see SetHugePages().
+ *
+ * All methods are thread safe.
+ *
+ * @sa
+ * vtkBuffer
+ */
+
+#ifndef vtkMemoryArena_h
+#define vtkMemoryArena_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSystemIncludes.h"
+
+#include <cstddef> // For std::size_t
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONCORE_EXPORT vtkMemoryArena
+{
+public:
+  enum HugePagesModes
+  {
+    HUGE_PAGES_NONE = 0,        ///< Regular pages
+    HUGE_PAGES_TRANSPARENT = 1, ///< Advise the kernel to use transparent huge pages
+    HUGE_PAGES_2MB = 2,         ///< Explicit 2MB huge pages, falls back to regular pages
+    HUGE_PAGES_1GB = 3          ///< Explicit 1GB huge pages, falls back to regular pages
+  };
+
+  ///@{
+  /**
+   * Enable or disable the arena for all threads. Default to false, unless the
+   * VTK_MEMORY_ARENA environment variable is set to 1.
+   */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+  ///@}
+
+  /**
+   * Return true if allocations made by the calling thread go through the arena,
+   * taking the current Scope into account.
+   */
+  static bool IsActive();
+
+  /**
+   * Enable or disable the arena for the calling thread during the lifetime of this
+   * object, regardless of GetEnabled().
+   *
+   * \code
+   * vtkMemoryArena::Scope arenaScope;
+   * filter->Update();
+   * \endcode
+   */
+  class VTKCOMMONCORE_EXPORT Scope
+  {
+  public:
+    Scope(bool enabled = true);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    int Previous;
+  };
+
+  ///@{
+  /**
+   * Alignment in bytes of the returned blocks. Must be a power of two, default to 64.
+   * Only affects blocks allocated after the change.
+   */
+  static void SetAlignment(std::size_t alignment);
+  static std::size_t GetAlignment();
+  ///@}
+
+  ///@{
+  /**
+   * Use huge pages for blocks of at least 2MB. Default to HUGE_PAGES_NONE.
+   * Only supported on Linux, ignored elsewhere.
+   */
+  static void SetHugePages(int mode);
+  static int GetHugePages();
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of bytes kept in the arena for reuse. Released blocks that would
+   * exceed this limit are returned to the system. Default to 1GB.
+   */
+  static void SetMaximumCachedSize(std::size_t numberOfBytes);
+  static std::size_t GetMaximumCachedSize();
+  ///@}
+
+  /**
+   * Number of bytes currently kept in the arena for reuse.
+   */
+  static std::size_t GetCachedSize();
+
+  /**
+   * Return all the cached blocks to the system.
+   */
+  static void ReleaseCachedMemory();
+
+  ///@{
+  /**
+   * Allocation functions with the signatures of vtkMallocingFunction,
+   * vtkReallocingFunction and vtkFreeingFunction. Blocks allocated by Malloc() or
+   * Realloc() must be released with Free().
+   */
+  static void* Malloc(std::size_t size);
+  static void* Realloc(void* block, std::size_t size);
+  static void Free(void* block);
+  ///@}
+};
+VTK_ABI_NAMESPACE_END
+
+#endif
+// VTK-HeaderTest-Exclude: vtkMemoryArena.h
@@ -0,0 +1,1220 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkSIMDKernels.h"
+
+#include <atomic>           // For std::atomic
+#include <cfloat>           // For FLT_MAX
+#include <cmath>            // For std::sqrt, std::isfinite, std::nextafter
+#include <cstdint>          // For std::uint64_t
+#include <cstdlib>          // For std::getenv
+#include <cstring>          // For std::strcmp, std::memcpy
+#include <initializer_list> // For std::initializer_list
+
+// This file must be compiled without floating point contraction (-ffp-contract=off)
+// so that the vectorized and scalar kernels round identically.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define VTK_SIMD_HAS_X86 1
+#include <immintrin.h>
+#define VTK_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define VTK_SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define VTK_SIMD_HAS_X86 0
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define VTK_SIMD_HAS_NEON 1
+#include <arm_neon.h>
+#else
+#define VTK_SIMD_HAS_NEON 0
+#endif
+
+namespace
+{
+using vtk::detail::simd::InstructionSet;
+
+//------------------------------------------------------------------------------
+// Scalar reference implementations. The vectorized kernels process the bulk of
+// the values and use these for the remainder.
+template <typename T>
+void ScalarMinMax(const T* values, vtkIdType numValues, T range[2], T* finiteRange)
+{
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    const T value = values[i];
+    range[0] = value < range[0] ? value : range[0];
+    range[1] = value > range[1] ? value : range[1];
+    if (finiteRange && std::isfinite(value))
+    {
+      finiteRange[0] = value < finiteRange[0] ? value : finiteRange[0];
+      finiteRange[1] = value > finiteRange[1] ? value : finiteRange[1];
+    }
+  }
+}
+
+template <typename T>
+void ScalarMagnitude3(const T* xyz, vtkIdType numTuples, float* magnitudes, float& maxMagnitude)
+{
+  for (vtkIdType i = 0; i < numTuples; ++i, xyz += 3)
+  {
+    const T squared = xyz[0] * xyz[0] + xyz[1] * xyz[1] + xyz[2] * xyz[2];
+    // For floats, rounding the double square root is the same as sqrtf
+    const float magnitude = static_cast<float>(std::sqrt(static_cast<double>(squared)));
+    magnitudes[i] = magnitude;
+    maxMagnitude = magnitude > maxMagnitude ? magnitude : maxMagnitude;
+  }
+}
+
+template <typename T>
+void ScalarDot3(const T* a, const T* b, vtkIdType numTuples, float* dots, float range[2])
+{
+  for (vtkIdType i = 0; i < numTuples; ++i, a += 3, b += 3)
+  {
+    const float dot = static_cast<float>(a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+    dots[i] = dot;
+    range[0] = dot < range[0] ? dot : range[0];
+    range[1] = dot > range[1] ? dot : range[1];
+  }
+}
+
+//------------------------------------------------------------------------------
+// Return the smallest float greater than or equal to `value`, so that comparing
+// floats to it gives the same result as comparing them to `value` in double.
+float FloatThreshold(double value)
+{
+  if (std::isnan(value) || value == -HUGE_VAL)
+  {
+    return static_cast<float>(value);
+  }
+  if (value > FLT_MAX)
+  {
+    return HUGE_VALF;
+  }
+  if (value < -FLT_MAX)
+  {
+    return -FLT_MAX;
+  }
+  float threshold = static_cast<float>(value);
+  if (static_cast<double>(threshold) < value)
+  {
+    threshold = std::nextafter(threshold, HUGE_VALF);
+  }
+  return threshold;
+}
+
+// Classify the edges [begin, numEdges) and return the number of crossings.
+template <typename T>
+vtkIdType ScalarClassifyEdges(const T* values, vtkIdType begin, vtkIdType numEdges, T threshold,
+  unsigned char* cases, vtkIdType& firstCrossing, vtkIdType& endCrossing)
+{
+  if (begin >= numEdges)
+  {
+    return 0;
+  }
+  vtkIdType crossings = 0;
+  unsigned char left = values[begin] >= threshold ? 1 : 0;
+  for (vtkIdType i = begin; i < numEdges; ++i)
+  {
+    const unsigned char right = values[i + 1] >= threshold ? 1 : 0;
+    cases[i] = static_cast<unsigned char>(left | (right << 1));
+    if (left != right)
+    {
+      ++crossings;
+      firstCrossing = i < firstCrossing ? i : firstCrossing;
+      endCrossing = i + 1;
+    }
+    left = right;
+  }
+  return crossings;
+}
+
+#if VTK_SIMD_HAS_X86
+// Note that the x86 min and max instructions return their second operand when
+// either is NaN: the accumulators are always passed second to skip NaN values.
+
+//------------------------------------------------------------------------------
+VTK_SIMD_TARGET_AVX2 float HorizontalMin(__m256 v)
+{
+  __m128 m = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  m = _mm_min_ps(m, _mm_movehl_ps(m, m));
+  m = _mm_min_ss(m, _mm_shuffle_ps(m, m, 1));
+  return _mm_cvtss_f32(m);
+}
+
+VTK_SIMD_TARGET_AVX2 float HorizontalMax(__m256 v)
+{
+  __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+  m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+  return _mm_cvtss_f32(m);
+}
+
+VTK_SIMD_TARGET_AVX2 float HorizontalMax(__m128 m)
+{
+  m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+  m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+  return _mm_cvtss_f32(m);
+}
+
+VTK_SIMD_TARGET_AVX2 double HorizontalMin(__m256d v)
+{
+  __m128d m = _mm_min_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  m = _mm_min_sd(m, _mm_unpackhi_pd(m, m));
+  return _mm_cvtsd_f64(m);
+}
+
+VTK_SIMD_TARGET_AVX2 double HorizontalMax(__m256d v)
+{
+  __m128d m = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  m = _mm_max_sd(m, _mm_unpackhi_pd(m, m));
+  return _mm_cvtsd_f64(m);
+}
+
+//------------------------------------------------------------------------------
+// Gather the values at `offsets` from `p`. The masked gathers are used with a
+// zeroed source, as the unmasked ones start from an undefined register that GCC
+// reports as uninitialized.
+VTK_SIMD_TARGET_AVX2 __m256 Gather(const float* p, __m256i offsets)
+{
+  const __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+  return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), p, offsets, mask, 4);
+}
+
+VTK_SIMD_TARGET_AVX2 __m256d Gather(const double* p, __m128i offsets)
+{
+  const __m256d mask = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+  return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), p, offsets, mask, 8);
+}
+
+//------------------------------------------------------------------------------
+VTK_SIMD_TARGET_AVX2 void AVX2MinMax(
+  const float* values, vtkIdType numValues, float range[2], float* finiteRange)
+{
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  const __m256 infinity = _mm256_set1_ps(HUGE_VALF);
+  __m256 vmin = _mm256_set1_ps(range[0]);
+  __m256 vmax = _mm256_set1_ps(range[1]);
+  __m256 fmin = _mm256_set1_ps(finiteRange ? finiteRange[0] : 0.f);
+  __m256 fmax = _mm256_set1_ps(finiteRange ? finiteRange[1] : 0.f);
+  vtkIdType i = 0;
+  for (; i + 8 <= numValues; i += 8)
+  {
+    const __m256 x = _mm256_loadu_ps(values + i);
+    vmin = _mm256_min_ps(x, vmin);
+    vmax = _mm256_max_ps(x, vmax);
+    if (finiteRange)
+    {
+      const __m256 finite = _mm256_cmp_ps(_mm256_and_ps(x, absMask), infinity, _CMP_LT_OQ);
+      fmin = _mm256_min_ps(_mm256_blendv_ps(fmin, x, finite), fmin);
+      fmax = _mm256_max_ps(_mm256_blendv_ps(fmax, x, finite), fmax);
+    }
+  }
+  range[0] = HorizontalMin(vmin);
+  range[1] = HorizontalMax(vmax);
+  if (finiteRange)
+  {
+    finiteRange[0] = HorizontalMin(fmin);
+    finiteRange[1] = HorizontalMax(fmax);
+  }
+  ScalarMinMax(values + i, numValues - i, range, finiteRange);
+}
+
+VTK_SIMD_TARGET_AVX2 void AVX2MinMax(
+  const double* values, vtkIdType numValues, double range[2], double* finiteRange)
+{
+  const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+  const __m256d infinity = _mm256_set1_pd(HUGE_VAL);
+  __m256d vmin = _mm256_set1_pd(range[0]);
+  __m256d vmax = _mm256_set1_pd(range[1]);
+  __m256d fmin = _mm256_set1_pd(finiteRange ? finiteRange[0] : 0.);
+  __m256d fmax = _mm256_set1_pd(finiteRange ? finiteRange[1] : 0.);
+  vtkIdType i = 0;
+  for (; i + 4 <= numValues; i += 4)
+  {
+    const __m256d x = _mm256_loadu_pd(values + i);
+    vmin = _mm256_min_pd(x, vmin);
+    vmax = _mm256_max_pd(x, vmax);
+    if (finiteRange)
+    {
+      const __m256d finite = _mm256_cmp_pd(_mm256_and_pd(x, absMask), infinity, _CMP_LT_OQ);
+      fmin = _mm256_min_pd(_mm256_blendv_pd(fmin, x, finite), fmin);
+      fmax = _mm256_max_pd(_mm256_blendv_pd(fmax, x, finite), fmax);
+    }
+  }
+  range[0] = HorizontalMin(vmin);
+  range[1] = HorizontalMax(vmax);
+  if (finiteRange)
+  {
+    finiteRange[0] = HorizontalMin(fmin);
+    finiteRange[1] = HorizontalMax(fmax);
+  }
+  ScalarMinMax(values + i, numValues - i, range, finiteRange);
+}
+
+//------------------------------------------------------------------------------
+VTK_SIMD_TARGET_AVX2 void AVX2Magnitude3(
+  const float* xyz, vtkIdType numTuples, float* magnitudes, float& maxMagnitude)
+{
+  const __m256i offsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+  __m256 vmax = _mm256_set1_ps(maxMagnitude);
+  vtkIdType i = 0;
+  for (; i + 8 <= numTuples; i += 8)
+  {
+    const float* p = xyz + 3 * i;
+    const __m256 x = Gather(p, offsets);
+    const __m256 y = Gather(p + 1, offsets);
+    const __m256 z = Gather(p + 2, offsets);
+    const __m256 squared =
+      _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+    const __m256 magnitude = _mm256_sqrt_ps(squared);
+    _mm256_storeu_ps(magnitudes + i, magnitude);
+    vmax = _mm256_max_ps(magnitude, vmax);
+  }
+  maxMagnitude = HorizontalMax(vmax);
+  ScalarMagnitude3(xyz + 3 * i, numTuples - i, magnitudes + i, maxMagnitude);
+}
+
+VTK_SIMD_TARGET_AVX2 void AVX2Magnitude3(
+  const double* xyz, vtkIdType numTuples, float* magnitudes, float& maxMagnitude)
+{
+  const __m128i offsets = _mm_setr_epi32(0, 3, 6, 9);
+  __m128 vmax = _mm_set1_ps(maxMagnitude);
+  vtkIdType i = 0;
+  for (; i + 4 <= numTuples; i += 4)
+  {
+    const double* p = xyz + 3 * i;
+    const __m256d x = Gather(p, offsets);
+    const __m256d y = Gather(p + 1, offsets);
+    const __m256d z = Gather(p + 2, offsets);
+    const __m256d squared =
+      _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)), _mm256_mul_pd(z, z));
+    const __m128 magnitude = _mm256_cvtpd_ps(_mm256_sqrt_pd(squared));
+    _mm_storeu_ps(magnitudes + i, magnitude);
+    vmax = _mm_max_ps(magnitude, vmax);
+  }
+  maxMagnitude = HorizontalMax(vmax);
+  ScalarMagnitude3(xyz + 3 * i, numTuples - i, magnitudes + i, maxMagnitude);
+}
+
+//------------------------------------------------------------------------------
+VTK_SIMD_TARGET_AVX2 void AVX2Dot3(
+  const float* a, const float* b, vtkIdType numTuples, float* dots, float range[2])
+{
+  const __m256i offsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+  __m256 vmin = _mm256_set1_ps(range[0]);
+  __m256 vmax = _mm256_set1_ps(range[1]);
+  vtkIdType i = 0;
+  for (; i + 8 <= numTuples; i += 8)
+  {
+    const float* pa = a + 3 * i;
+    const float* pb = b + 3 * i;
+    const __m256 xx = _mm256_mul_ps(Gather(pa, offsets), Gather(pb, offsets));
+    const __m256 yy = _mm256_mul_ps(Gather(pa + 1, offsets), Gather(pb + 1, offsets));
+    const __m256 zz = _mm256_mul_ps(Gather(pa + 2, offsets), Gather(pb + 2, offsets));
+    const __m256 dot = _mm256_add_ps(_mm256_add_ps(xx, yy), zz);
+    _mm256_storeu_ps(dots + i, dot);
+    vmin = _mm256_min_ps(dot, vmin);
+    vmax = _mm256_max_ps(dot, vmax);
+  }
+  range[0] = HorizontalMin(vmin);
+  range[1] = HorizontalMax(vmax);
+  ScalarDot3(a + 3 * i, b + 3 * i, numTuples - i, dots + i, range);
+}
+
+VTK_SIMD_TARGET_AVX2 void AVX2Dot3(
+  const double* a, const double* b, vtkIdType numTuples, float* dots, float range[2])
+{
+  const __m128i offsets = _mm_setr_epi32(0, 3, 6, 9);
+  __m128 vmin = _mm_set1_ps(range[0]);
+  __m128 vmax = _mm_set1_ps(range[1]);
+  vtkIdType i = 0;
+  for (; i + 4 <= numTuples; i += 4)
+  {
+    const double* pa = a + 3 * i;
+    const double* pb = b + 3 * i;
+    const __m256d xx = _mm256_mul_pd(Gather(pa, offsets), Gather(pb, offsets));
+    const __m256d yy = _mm256_mul_pd(Gather(pa + 1, offsets), Gather(pb + 1, offsets));
+    const __m256d zz = _mm256_mul_pd(Gather(pa + 2, offsets), Gather(pb + 2, offsets));
+    const __m128 dot = _mm256_cvtpd_ps(_mm256_add_pd(_mm256_add_pd(xx, yy), zz));
+    _mm_storeu_ps(dots + i, dot);
+    vmin = _mm_min_ps(dot, vmin);
+    vmax = _mm_max_ps(dot, vmax);
+  }
+  __m128 m = _mm_min_ps(vmin, _mm_movehl_ps(vmin, vmin));
+  range[0] = _mm_cvtss_f32(_mm_min_ss(m, _mm_shuffle_ps(m, m, 1)));
+  range[1] = HorizontalMax(vmax);
+  ScalarDot3(a + 3 * i, b + 3 * i, numTuples - i, dots + i, range);
+}
+
+//------------------------------------------------------------------------------
+// Like the unmasked gathers, most unmasked AVX-512 intrinsics start from an
+// undefined register. Their masked forms with every lane set are used instead.
+VTK_SIMD_TARGET_AVX512 __m512 Gather(const float* p, __m512i offsets)
+{
+  return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, offsets, p, 4);
+}
+
+VTK_SIMD_TARGET_AVX512 __m512d Gather(const double* p, __m256i offsets)
+{
+  return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, offsets, p, 8);
+}
+
+VTK_SIMD_TARGET_AVX512 __m512 Min(__m512 a, __m512 b)
+{
+  return _mm512_mask_min_ps(b, 0xFFFF, a, b);
+}
+
+VTK_SIMD_TARGET_AVX512 __m512 Max(__m512 a, __m512 b)
+{
+  return _mm512_mask_max_ps(b, 0xFFFF, a, b);
+}
+
+VTK_SIMD_TARGET_AVX512 __m512d Min(__m512d a, __m512d b)
+{
+  return _mm512_mask_min_pd(b, 0xFF, a, b);
+}
+
+VTK_SIMD_TARGET_AVX512 __m512d Max(__m512d a, __m512d b)
+{
+  return _mm512_mask_max_pd(b, 0xFF, a, b);
+}
+
+VTK_SIMD_TARGET_AVX512 __m512 Sqrt(__m512 v)
+{
+  return _mm512_maskz_sqrt_ps(0xFFFF, v);
+}
+
+VTK_SIMD_TARGET_AVX512 __m512d Sqrt(__m512d v)
+{
+  return _mm512_maskz_sqrt_pd(0xFF, v);
+}
+
+VTK_SIMD_TARGET_AVX512 __m256 ConvertToFloat(__m512d v)
+{
+  return _mm512_mask_cvtpd_ps(_mm256_setzero_ps(), 0xFF, v);
+}
+
+VTK_SIMD_TARGET_AVX512 __m256d LowHalf(__m512d v)
+{
+  return _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xF, v, 0);
+}
+
+VTK_SIMD_TARGET_AVX512 __m256d HighHalf(__m512d v)
+{
+  return _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xF, v, 1);
+}
+
+VTK_SIMD_TARGET_AVX512 float HorizontalMin(__m512 v)
+{
+  const __m512d d = _mm512_castps_pd(v);
+  const __m256 low = _mm256_castpd_ps(LowHalf(d));
+  const __m256 high = _mm256_castpd_ps(HighHalf(d));
+  return HorizontalMin(_mm256_min_ps(low, high));
+}
+
+VTK_SIMD_TARGET_AVX512 float HorizontalMax(__m512 v)
+{
+  const __m512d d = _mm512_castps_pd(v);
+  const __m256 low = _mm256_castpd_ps(LowHalf(d));
+  const __m256 high = _mm256_castpd_ps(HighHalf(d));
+  return HorizontalMax(_mm256_max_ps(low, high));
+}
+
+VTK_SIMD_TARGET_AVX512 double HorizontalMin(__m512d v)
+{
+  return HorizontalMin(_mm256_min_pd(LowHalf(v), HighHalf(v)));
+}
+
+VTK_SIMD_TARGET_AVX512 double HorizontalMax(__m512d v)
+{
+  return HorizontalMax(_mm256_max_pd(LowHalf(v), HighHalf(v)));
+}
+
+//------------------------------------------------------------------------------
+VTK_SIMD_TARGET_AVX512 void AVX512MinMax(
+  const float* values, vtkIdType numValues, float range[2], float* finiteRange)
+{
+  const __m512 infinity = _mm512_set1_ps(HUGE_VALF);
+  __m512 vmin = _mm512_set1_ps(range[0]);
+  __m512 vmax = _mm512_set1_ps(range[1]);
+  __m512 fmin = _mm512_set1_ps(finiteRange ? finiteRange[0] : 0.f);
+  __m512 fmax = _mm512_set1_ps(finiteRange ? finiteRange[1] : 0.f);
+  vtkIdType i = 0;
+  for (; i + 16 <= numValues; i += 16)
+  {
+    const __m512 x = _mm512_loadu_ps(values + i);
+    vmin = Min(x, vmin);
+    vmax = Max(x, vmax);
+    if (finiteRange)
+    {
+      const __mmask16 finite = _mm512_cmp_ps_mask(_mm512_abs_ps(x), infinity, _CMP_LT_OQ);
+      fmin = _mm512_mask_min_ps(fmin, finite, x, fmin);
+      fmax = _mm512_mask_max_ps(fmax, finite, x, fmax);
+    }
+  }
+  range[0] = HorizontalMin(vmin);
+  range[1] = HorizontalMax(vmax);
+  if (finiteRange)
+  {
+    finiteRange[0] = HorizontalMin(fmin);
+    finiteRange[1] = HorizontalMax(fmax);
+  }
+  ScalarMinMax(values + i, numValues - i, range, finiteRange);
+}
+
+VTK_SIMD_TARGET_AVX512 void AVX512MinMax(
+  const double* values, vtkIdType numValues, double range[2], double* finiteRange)
+{
+  const __m512d infinity = _mm512_set1_pd(HUGE_VAL);
+  __m512d vmin = _mm512_set1_pd(range[0]);
+  __m512d vmax = _mm512_set1_pd(range[1]);
+  __m512d fmin = _mm512_set1_pd(finiteRange ? finiteRange[0] : 0.);
+  __m512d fmax = _mm512_set1_pd(finiteRange ? finiteRange[1] : 0.);
+  vtkIdType i = 0;
+  for (; i + 8 <= numValues; i += 8)
+  {
+    const __m512d x = _mm512_loadu_pd(values + i);
+    vmin = Min(x, vmin);
+    vmax = Max(x, vmax);
+    if (finiteRange)
+    {
+      const __mmask8 finite = _mm512_cmp_pd_mask(_mm512_abs_pd(x), infinity, _CMP_LT_OQ);
+      fmin = _mm512_mask_min_pd(fmin, finite, x, fmin);
+      fmax = _mm512_mask_max_pd(fmax, finite, x, fmax);
+    }
+  }
+  range[0] = HorizontalMin(vmin);
+  range[1] = HorizontalMax(vmax);
+  if (finiteRange)
+  {
+    finiteRange[0] = HorizontalMin(fmin);
+    finiteRange[1] = HorizontalMax(fmax);
+  }
+  ScalarMinMax(values + i, numValues - i, range, finiteRange);
+}
+
+//------------------------------------------------------------------------------
+VTK_SIMD_TARGET_AVX512 void AVX512Magnitude3(
+  const float* xyz, vtkIdType numTuples, float* magnitudes, float& maxMagnitude)
+{
+  const __m512i offsets =
+    _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45);
+  __m512 vmax = _mm512_set1_ps(maxMagnitude);
+  vtkIdType i = 0;
+  for (; i + 16 <= numTuples; i += 16)
+  {
+    const float* p = xyz + 3 * i;
+    const __m512 x = Gather(p, offsets);
+    const __m512 y = Gather(p + 1, offsets);
+    const __m512 z = Gather(p + 2, offsets);
+    const __m512 squared =
+      _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x, x), _mm512_mul_ps(y, y)), _mm512_mul_ps(z, z));
+    const __m512 magnitude = Sqrt(squared);
+    _mm512_storeu_ps(magnitudes + i, magnitude);
+    vmax = Max(magnitude, vmax);
+  }
+  maxMagnitude = HorizontalMax(vmax);
+  ScalarMagnitude3(xyz + 3 * i, numTuples - i, magnitudes + i, maxMagnitude);
+}
+
+VTK_SIMD_TARGET_AVX512 void AVX512Magnitude3(
+  const double* xyz, vtkIdType numTuples, float* magnitudes, float& maxMagnitude)
+{
+  const __m256i offsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+  __m256 vmax = _mm256_set1_ps(maxMagnitude);
+  vtkIdType i = 0;
+  for (; i + 8 <= numTuples; i += 8)
+  {
+    const double* p = xyz + 3 * i;
+    const __m512d x = Gather(p, offsets);
+    const __m512d y = Gather(p + 1, offsets);
+    const __m512d z = Gather(p + 2, offsets);
+    const __m512d squared =
+      _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(x, x), _mm512_mul_pd(y, y)), _mm512_mul_pd(z, z));
+    const __m256 magnitude = ConvertToFloat(Sqrt(squared));
+    _mm256_storeu_ps(magnitudes + i, magnitude);
+    vmax = _mm256_max_ps(magnitude, vmax);
+  }
+  maxMagnitude = HorizontalMax(vmax);
+  ScalarMagnitude3(xyz + 3 * i, numTuples - i, magnitudes + i, maxMagnitude);
+}
+
+//------------------------------------------------------------------------------
+VTK_SIMD_TARGET_AVX512 void AVX512Dot3(
+  const float* a, const float* b, vtkIdType numTuples, float* dots, float range[2])
+{
+  const __m512i offsets =
+    _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45);
+  __m512 vmin = _mm512_set1_ps(range[0]);
+  __m512 vmax = _mm512_set1_ps(range[1]);
+  vtkIdType i = 0;
+  for (; i + 16 <= numTuples; i += 16)
+  {
+    const float* pa = a + 3 * i;
+    const float* pb = b + 3 * i;
+    const __m512 xx = _mm512_mul_ps(Gather(pa, offsets), Gather(pb, offsets));
+    const __m512 yy = _mm512_mul_ps(Gather(pa + 1, offsets), Gather(pb + 1, offsets));
+    const __m512 zz = _mm512_mul_ps(Gather(pa + 2, offsets), Gather(pb + 2, offsets));
+    const __m512 dot = _mm512_add_ps(_mm512_add_ps(xx, yy), zz);
+    _mm512_storeu_ps(dots + i, dot);
+    vmin = Min(dot, vmin);
+    vmax = Max(dot, vmax);
+  }
+  range[0] = HorizontalMin(vmin);
+  range[1] = HorizontalMax(vmax);
+  ScalarDot3(a + 3 * i, b + 3 * i, numTuples - i, dots + i, range);
+}
+
+VTK_SIMD_TARGET_AVX512 void AVX512Dot3(
+  const double* a, const double* b, vtkIdType numTuples, float* dots, float range[2])
+{
+  const __m256i offsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+  __m256 vmin = _mm256_set1_ps(range[0]);
+  __m256 vmax = _mm256_set1_ps(range[1]);
+  vtkIdType i = 0;
+  for (; i + 8 <= numTuples; i += 8)
+  {
+    const double* pa = a + 3 * i;
+    const double* pb = b + 3 * i;
+    const __m512d xx = _mm512_mul_pd(Gather(pa, offsets), Gather(pb, offsets));
+    const __m512d yy = _mm512_mul_pd(Gather(pa + 1, offsets), Gather(pb + 1, offsets));
+    const __m512d zz = _mm512_mul_pd(Gather(pa + 2, offsets), Gather(pb + 2, offsets));
+    const __m256 dot = ConvertToFloat(_mm512_add_pd(_mm512_add_pd(xx, yy), zz));
+    _mm256_storeu_ps(dots + i, dot);
+    vmin = _mm256_min_ps(dot, vmin);
+    vmax = _mm256_max_ps(dot, vmax);
+  }
+  range[0] = HorizontalMin(vmin);
+  range[1] = HorizontalMax(vmax);
+  ScalarDot3(a + 3 * i, b + 3 * i, numTuples - i, dots + i, range);
+}
+
+//------------------------------------------------------------------------------
+// Edge classification works on the bit masks of the comparisons: bit i of
+// the mask is set when value i is above the threshold. A lookup table spreads
+// the 8 bits of a mask to the 8 bytes of a 64-bit word.
+struct BitsToBytesTable
+{
+  BitsToBytesTable()
+  {
+    for (unsigned int bits = 0; bits < 256; ++bits)
+    {
+      std::uint64_t bytes = 0;
+      for (unsigned int j = 0; j < 8; ++j)
+      {
+        bytes |= static_cast<std::uint64_t>((bits >> j) & 1) << (8 * j);
+      }
+      this->Bytes[bits] = bytes;
+    }
+  }
+  std::uint64_t Bytes[256];
+};
+const BitsToBytesTable BitsToBytes;
+
+// Store the cases of `numLanes` edges given the masks of their two vertices.
+inline void StoreEdgeCases(
+  unsigned int left, unsigned int right, unsigned int numLanes, unsigned char* cases)
+{
+  for (unsigned int j = 0; j < numLanes; j += 8)
+  {
+    const std::uint64_t bytes = BitsToBytes.Bytes[(left >> j) & 0xff] |
+      (BitsToBytes.Bytes[(right >> j) & 0xff] << 1);
+    // x86 is little endian: byte j of the word is the case of edge j.
+    std::memcpy(cases + j, &bytes, numLanes - j < 8 ? numLanes - j : 8);
+  }
+}
+
+// Account for the edges of a block starting at `base` whose bit is set in
+// `crossing`.
+inline void AddEdgeCrossings(unsigned int crossing, vtkIdType base, vtkIdType& crossings,
+  vtkIdType& firstCrossing, vtkIdType& endCrossing)
+{
+  if (crossing)
+  {
+    crossings += __builtin_popcount(crossing);
+    const vtkIdType first = base + __builtin_ctz(crossing);
+    firstCrossing = first < firstCrossing ? first : firstCrossing;
+    endCrossing = base + (31 - __builtin_clz(crossing)) + 1;
+  }
+}
+
+//------------------------------------------------------------------------------
+VTK_SIMD_TARGET_AVX2 vtkIdType AVX2ClassifyEdges(const float* values, vtkIdType numEdges,
+  float threshold, unsigned char* cases, vtkIdType& firstCrossing, vtkIdType& endCrossing)
+{
+  const __m256 t = _mm256_set1_ps(threshold);
+  vtkIdType crossings = 0;
+  vtkIdType i = 0;
+  for (; i + 8 <= numEdges; i += 8)
+  {
+    const unsigned int left = static_cast<unsigned int>(
+      _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(values + i), t, _CMP_GE_OQ)));
+    const unsigned int right = static_cast<unsigned int>(
+      _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(values + i + 1), t, _CMP_GE_OQ)));
+    StoreEdgeCases(left, right, 8, cases + i);
+    AddEdgeCrossings(left ^ right, i, crossings, firstCrossing, endCrossing);
+  }
+  return crossings +
+    ScalarClassifyEdges(values, i, numEdges, threshold, cases, firstCrossing, endCrossing);
+}
+
+VTK_SIMD_TARGET_AVX2 vtkIdType AVX2ClassifyEdges(const double* values, vtkIdType numEdges,
+  double threshold, unsigned char* cases, vtkIdType& firstCrossing, vtkIdType& endCrossing)
+{
+  const __m256d t = _mm256_set1_pd(threshold);
+  vtkIdType crossings = 0;
+  vtkIdType i = 0;
+  for (; i + 4 <= numEdges; i += 4)
+  {
+    const unsigned int left = static_cast<unsigned int>(
+      _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(values + i), t, _CMP_GE_OQ)));
+    const unsigned int right = static_cast<unsigned int>(
+      _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(values + i + 1), t, _CMP_GE_OQ)));
+    StoreEdgeCases(left, right, 4, cases + i);
+    AddEdgeCrossings(left ^ right, i, crossings, firstCrossing, endCrossing);
+  }
+  return crossings +
+    ScalarClassifyEdges(values, i, numEdges, threshold, cases, firstCrossing, endCrossing);
+}
+
+//------------------------------------------------------------------------------
+VTK_SIMD_TARGET_AVX512 vtkIdType AVX512ClassifyEdges(const float* values, vtkIdType numEdges,
+  float threshold, unsigned char* cases, vtkIdType& firstCrossing, vtkIdType& endCrossing)
+{
+  const __m512 t = _mm512_set1_ps(threshold);
+  vtkIdType crossings = 0;
+  vtkIdType i = 0;
+  for (; i + 16 <= numEdges; i += 16)
+  {
+    const unsigned int left = _mm512_cmp_ps_mask(_mm512_loadu_ps(values + i), t, _CMP_GE_OQ);
+    const unsigned int right = _mm512_cmp_ps_mask(_mm512_loadu_ps(values + i + 1), t, _CMP_GE_OQ);
+    StoreEdgeCases(left, right, 16, cases + i);
+    AddEdgeCrossings(left ^ right, i, crossings, firstCrossing, endCrossing);
+  }
+  return crossings +
+    ScalarClassifyEdges(values, i, numEdges, threshold, cases, firstCrossing, endCrossing);
+}
+
+VTK_SIMD_TARGET_AVX512 vtkIdType AVX512ClassifyEdges(const double* values, vtkIdType numEdges,
+  double threshold, unsigned char* cases, vtkIdType& firstCrossing, vtkIdType& endCrossing)
+{
+  const __m512d t = _mm512_set1_pd(threshold);
+  vtkIdType crossings = 0;
+  vtkIdType i = 0;
+  for (; i + 8 <= numEdges; i += 8)
+  {
+    const unsigned int left = _mm512_cmp_pd_mask(_mm512_loadu_pd(values + i), t, _CMP_GE_OQ);
+    const unsigned int right = _mm512_cmp_pd_mask(_mm512_loadu_pd(values + i + 1), t, _CMP_GE_OQ);
+    StoreEdgeCases(left, right, 8, cases + i);
+    AddEdgeCrossings(left ^ right, i, crossings, firstCrossing, endCrossing);
+  }
+  return crossings +
+    ScalarClassifyEdges(values, i, numEdges, threshold, cases, firstCrossing, endCrossing);
+}
+#endif // VTK_SIMD_HAS_X86
+
+#if VTK_SIMD_HAS_NEON
+// The NEON minnm/maxnm instructions return the non-NaN operand.
+
+//------------------------------------------------------------------------------
+void NEONMinMax(const float* values, vtkIdType numValues, float range[2], float* finiteRange)
+{
+  const float32x4_t infinity = vdupq_n_f32(HUGE_VALF);
+  float32x4_t vmin = vdupq_n_f32(range[0]);
+  float32x4_t vmax = vdupq_n_f32(range[1]);
+  float32x4_t fmin = vdupq_n_f32(finiteRange ? finiteRange[0] : 0.f);
+  float32x4_t fmax = vdupq_n_f32(finiteRange ? finiteRange[1] : 0.f);
+  vtkIdType i = 0;
+  for (; i + 4 <= numValues; i += 4)
+  {
+    const float32x4_t x = vld1q_f32(values + i);
+    vmin = vminnmq_f32(x, vmin);
+    vmax = vmaxnmq_f32(x, vmax);
+    if (finiteRange)
+    {
+      const uint32x4_t finite = vcltq_f32(vabsq_f32(x), infinity);
+      fmin = vminnmq_f32(vbslq_f32(finite, x, fmin), fmin);
+      fmax = vmaxnmq_f32(vbslq_f32(finite, x, fmax), fmax);
+    }
+  }
+  range[0] = vminvq_f32(vmin);
+  range[1] = vmaxvq_f32(vmax);
+  if (finiteRange)
+  {
+    finiteRange[0] = vminvq_f32(fmin);
+    finiteRange[1] = vmaxvq_f32(fmax);
+  }
+  ScalarMinMax(values + i, numValues - i, range, finiteRange);
+}
+
+void NEONMinMax(const double* values, vtkIdType numValues, double range[2], double* finiteRange)
+{
+  const float64x2_t infinity = vdupq_n_f64(HUGE_VAL);
+  float64x2_t vmin = vdupq_n_f64(range[0]);
+  float64x2_t vmax = vdupq_n_f64(range[1]);
+  float64x2_t fmin = vdupq_n_f64(finiteRange ? finiteRange[0] : 0.);
+  float64x2_t fmax = vdupq_n_f64(finiteRange ? finiteRange[1] : 0.);
+  vtkIdType i = 0;
+  for (; i + 2 <= numValues; i += 2)
+  {
+    const float64x2_t x = vld1q_f64(values + i);
+    vmin = vminnmq_f64(x, vmin);
+    vmax = vmaxnmq_f64(x, vmax);
+    if (finiteRange)
+    {
+      const uint64x2_t finite = vcltq_f64(vabsq_f64(x), infinity);
+      fmin = vminnmq_f64(vbslq_f64(finite, x, fmin), fmin);
+      fmax = vmaxnmq_f64(vbslq_f64(finite, x, fmax), fmax);
+    }
+  }
+  range[0] = vminvq_f64(vmin);
+  range[1] = vmaxvq_f64(vmax);
+  if (finiteRange)
+  {
+    finiteRange[0] = vminvq_f64(fmin);
+    finiteRange[1] = vmaxvq_f64(fmax);
+  }
+  ScalarMinMax(values + i, numValues - i, range, finiteRange);
+}
+
+//------------------------------------------------------------------------------
+void NEONMagnitude3(const float* xyz, vtkIdType numTuples, float* magnitudes, float& maxMagnitude)
+{
+  float32x4_t vmax = vdupq_n_f32(maxMagnitude);
+  vtkIdType i = 0;
+  for (; i + 4 <= numTuples; i += 4)
+  {
+    const float32x4x3_t v = vld3q_f32(xyz + 3 * i);
+    const float32x4_t squared = vaddq_f32(
+      vaddq_f32(vmulq_f32(v.val[0], v.val[0]), vmulq_f32(v.val[1], v.val[1])),
+      vmulq_f32(v.val[2], v.val[2]));
+    const float32x4_t magnitude = vsqrtq_f32(squared);
+    vst1q_f32(magnitudes + i, magnitude);
+    vmax = vmaxnmq_f32(magnitude, vmax);
+  }
+  maxMagnitude = vmaxvq_f32(vmax);
+  ScalarMagnitude3(xyz + 3 * i, numTuples - i, magnitudes + i, maxMagnitude);
+}
+
+void NEONMagnitude3(
+  const double* xyz, vtkIdType numTuples, float* magnitudes, float& maxMagnitude)
+{
+  float32x2_t vmax = vdup_n_f32(maxMagnitude);
+  vtkIdType i = 0;
+  for (; i + 2 <= numTuples; i += 2)
+  {
+    const float64x2x3_t v = vld3q_f64(xyz + 3 * i);
+    const float64x2_t squared = vaddq_f64(
+      vaddq_f64(vmulq_f64(v.val[0], v.val[0]), vmulq_f64(v.val[1], v.val[1])),
+      vmulq_f64(v.val[2], v.val[2]));
+    const float32x2_t magnitude = vcvt_f32_f64(vsqrtq_f64(squared));
+    vst1_f32(magnitudes + i, magnitude);
+    vmax = vmaxnm_f32(magnitude, vmax);
+  }
+  maxMagnitude = vmaxv_f32(vmax);
+  ScalarMagnitude3(xyz + 3 * i, numTuples - i, magnitudes + i, maxMagnitude);
+}
+
+//------------------------------------------------------------------------------
+void NEONDot3(const float* a, const float* b, vtkIdType numTuples, float* dots, float range[2])
+{
+  float32x4_t vmin = vdupq_n_f32(range[0]);
+  float32x4_t vmax = vdupq_n_f32(range[1]);
+  vtkIdType i = 0;
+  for (; i + 4 <= numTuples; i += 4)
+  {
+    const float32x4x3_t va = vld3q_f32(a + 3 * i);
+    const float32x4x3_t vb = vld3q_f32(b + 3 * i);
+    const float32x4_t dot = vaddq_f32(
+      vaddq_f32(vmulq_f32(va.val[0], vb.val[0]), vmulq_f32(va.val[1], vb.val[1])),
+      vmulq_f32(va.val[2], vb.val[2]));
+    vst1q_f32(dots + i, dot);
+    vmin = vminnmq_f32(dot, vmin);
+    vmax = vmaxnmq_f32(dot, vmax);
+  }
+  range[0] = vminvq_f32(vmin);
+  range[1] = vmaxvq_f32(vmax);
+  ScalarDot3(a + 3 * i, b + 3 * i, numTuples - i, dots + i, range);
+}
+
+void NEONDot3(const double* a, const double* b, vtkIdType numTuples, float* dots, float range[2])
+{
+  float32x2_t vmin = vdup_n_f32(range[0]);
+  float32x2_t vmax = vdup_n_f32(range[1]);
+  vtkIdType i = 0;
+  for (; i + 2 <= numTuples; i += 2)
+  {
+    const float64x2x3_t va = vld3q_f64(a + 3 * i);
+    const float64x2x3_t vb = vld3q_f64(b + 3 * i);
+    const float32x2_t dot = vcvt_f32_f64(vaddq_f64(
+      vaddq_f64(vmulq_f64(va.val[0], vb.val[0]), vmulq_f64(va.val[1], vb.val[1])),
+      vmulq_f64(va.val[2], vb.val[2])));
+    vst1_f32(dots + i, dot);
+    vmin = vminnm_f32(dot, vmin);
+    vmax = vmaxnm_f32(dot, vmax);
+  }
+  range[0] = vminv_f32(vmin);
+  range[1] = vmaxv_f32(vmax);
+  ScalarDot3(a + 3 * i, b + 3 * i, numTuples - i, dots + i, range);
+}
+
+//------------------------------------------------------------------------------
+// The comparisons give 0xff bytes for values above the threshold, narrowed to
+// one byte per lane. ARM64 is little endian: lane j is byte j of a word.
+inline void AddEdgeCrossings(std::uint64_t crossing, vtkIdType base, vtkIdType& crossings,
+  vtkIdType& firstCrossing, vtkIdType& endCrossing)
+{
+  if (crossing)
+  {
+    crossings += __builtin_popcountll(crossing) / 8;
+    const vtkIdType first = base + __builtin_ctzll(crossing) / 8;
+    firstCrossing = first < firstCrossing ? first : firstCrossing;
+    endCrossing = base + (63 - __builtin_clzll(crossing)) / 8 + 1;
+  }
+}
+
+vtkIdType NEONClassifyEdges(const float* values, vtkIdType numEdges, float threshold,
+  unsigned char* cases, vtkIdType& firstCrossing, vtkIdType& endCrossing)
+{
+  const float32x4_t t = vdupq_n_f32(threshold);
+  const uint8x8_t one = vdup_n_u8(1);
+  const uint8x8_t two = vdup_n_u8(2);
+  vtkIdType crossings = 0;
+  vtkIdType i = 0;
+  for (; i + 8 <= numEdges; i += 8)
+  {
+    const uint8x8_t left = vmovn_u16(vcombine_u16(vmovn_u32(vcgeq_f32(vld1q_f32(values + i), t)),
+      vmovn_u32(vcgeq_f32(vld1q_f32(values + i + 4), t))));
+    const uint8x8_t right =
+      vmovn_u16(vcombine_u16(vmovn_u32(vcgeq_f32(vld1q_f32(values + i + 1), t)),
+        vmovn_u32(vcgeq_f32(vld1q_f32(values + i + 5), t))));
+    vst1_u8(cases + i, vorr_u8(vand_u8(left, one), vand_u8(right, two)));
+    AddEdgeCrossings(vget_lane_u64(vreinterpret_u64_u8(veor_u8(left, right)), 0), i, crossings,
+      firstCrossing, endCrossing);
+  }
+  return crossings +
+    ScalarClassifyEdges(values, i, numEdges, threshold, cases, firstCrossing, endCrossing);
+}
+
+vtkIdType NEONClassifyEdges(const double* values, vtkIdType numEdges, double threshold,
+  unsigned char* cases, vtkIdType& firstCrossing, vtkIdType& endCrossing)
+{
+  const float64x2_t t = vdupq_n_f64(threshold);
+  const uint8x8_t one = vdup_n_u8(1);
+  const uint8x8_t two = vdup_n_u8(2);
+  vtkIdType crossings = 0;
+  vtkIdType i = 0;
+  for (; i + 4 <= numEdges; i += 4)
+  {
+    // Only the 4 low bytes are used.
+    const uint16x4_t left16 =
+      vmovn_u32(vcombine_u32(vmovn_u64(vcgeq_f64(vld1q_f64(values + i), t)),
+        vmovn_u64(vcgeq_f64(vld1q_f64(values + i + 2), t))));
+    const uint16x4_t right16 =
+      vmovn_u32(vcombine_u32(vmovn_u64(vcgeq_f64(vld1q_f64(values + i + 1), t)),
+        vmovn_u64(vcgeq_f64(vld1q_f64(values + i + 3), t))));
+    const uint8x8_t left = vmovn_u16(vcombine_u16(left16, vdup_n_u16(0)));
+    const uint8x8_t right = vmovn_u16(vcombine_u16(right16, vdup_n_u16(0)));
+    const std::uint32_t edgeCases = vget_lane_u32(
+      vreinterpret_u32_u8(vorr_u8(vand_u8(left, one), vand_u8(right, two))), 0);
+    std::memcpy(cases + i, &edgeCases, 4);
+    AddEdgeCrossings(vget_lane_u64(vreinterpret_u64_u8(veor_u8(left, right)), 0), i, crossings,
+      firstCrossing, endCrossing);
+  }
+  return crossings +
+    ScalarClassifyEdges(values, i, numEdges, threshold, cases, firstCrossing, endCrossing);
+}
+#endif // VTK_SIMD_HAS_NEON
+
+//------------------------------------------------------------------------------
+bool IsSupported(InstructionSet isa)
+{
+  switch (isa)
+  {
+    case InstructionSet::Scalar:
+      return true;
+    case InstructionSet::NEON:
+      return VTK_SIMD_HAS_NEON != 0;
+#if VTK_SIMD_HAS_X86
+    case InstructionSet::AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+    case InstructionSet::AVX512:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+      return false;
+  }
+}
+
+InstructionSet DetectInstructionSet()
+{
+  const InstructionSet best = vtk::detail::simd::GetBestInstructionSet();
+  const char* env = std::getenv("VTK_SIMD");
+  if (env)
+  {
+    for (InstructionSet isa : { InstructionSet::Scalar, InstructionSet::NEON, InstructionSet::AVX2,
+           InstructionSet::AVX512 })
+    {
+      // Never select an instruction set above the best supported one
+      if (std::strcmp(env, vtk::detail::simd::GetInstructionSetName(isa)) == 0 &&
+        IsSupported(isa) && isa <= best)
+      {
+        return isa;
+      }
+    }
+  }
+  return best;
+}
+
+std::atomic<InstructionSet>& CurrentInstructionSet()
+{
+  static std::atomic<InstructionSet> isa(DetectInstructionSet());
+  return isa;
+}
+} // anonymous namespace
+
+namespace vtk
+{
+namespace detail
+{
+namespace simd
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+//------------------------------------------------------------------------------
+InstructionSet GetInstructionSet()
+{
+  return CurrentInstructionSet().load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+bool SetInstructionSet(InstructionSet isa)
+{
+  if (!IsSupported(isa))
+  {
+    return false;
+  }
+  CurrentInstructionSet().store(isa, std::memory_order_relaxed);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+InstructionSet GetBestInstructionSet()
+{
+  for (InstructionSet isa :
+    { InstructionSet::AVX512, InstructionSet::AVX2, InstructionSet::NEON })
+  {
+    if (IsSupported(isa))
+    {
+      return isa;
+    }
+  }
+  return InstructionSet::Scalar;
+}
+
+//------------------------------------------------------------------------------
+const char* GetInstructionSetName(InstructionSet isa)
+{
+  switch (isa)
+  {
+    case InstructionSet::NEON:
+      return "neon";
+    case InstructionSet::AVX2:
+      return "avx2";
+    case InstructionSet::AVX512:
+      return "avx512";
+    default:
+      return "scalar";
+  }
+}
+
+//------------------------------------------------------------------------------
+void MinMax(const float* values, vtkIdType numValues, float range[2], float* finiteRange)
+{
+  switch (GetInstructionSet())
+  {
+#if VTK_SIMD_HAS_X86
+    case InstructionSet::AVX512:
+      AVX512MinMax(values, numValues, range, finiteRange);
+      return;
+    case InstructionSet::AVX2:
+      AVX2MinMax(values, numValues, range, finiteRange);
+      return;
+#endif
+#if VTK_SIMD_HAS_NEON
+    case InstructionSet::NEON:
+      NEONMinMax(values, numValues, range, finiteRange);
+      return;
+#endif
+    default:
+      ScalarMinMax(values, numValues, range, finiteRange);
+  }
+}
+
+//------------------------------------------------------------------------------
+void MinMax(const double* values, vtkIdType numValues, double range[2], double* finiteRange)
+{
+  switch (GetInstructionSet())
+  {
+#if VTK_SIMD_HAS_X86
+    case InstructionSet::AVX512:
+      AVX512MinMax(values, numValues, range, finiteRange);
+      return;
+    case InstructionSet::AVX2:
+      AVX2MinMax(values, numValues, range, finiteRange);
+      return;
+#endif
+#if VTK_SIMD_HAS_NEON
+    case InstructionSet::NEON:
+      NEONMinMax(values, numValues, range, finiteRange);
+      return;
+#endif
+    default:
+      ScalarMinMax(values, numValues, range, finiteRange);
+  }
+}
+
+//------------------------------------------------------------------------------
+void Magnitude3(const float* xyz, vtkIdType numTuples, float* magnitudes, float& maxMagnitude)
+{
+  switch (GetInstructionSet())
+  {
+#if VTK_SIMD_HAS_X86
+    case InstructionSet::AVX512:
+      AVX512Magnitude3(xyz, numTuples, magnitudes, maxMagnitude);
+      return;
+    case InstructionSet::AVX2:
+      AVX2Magnitude3(xyz, numTuples, magnitudes, maxMagnitude);
+      return;
+#endif
+#if VTK_SIMD_HAS_NEON
+    case InstructionSet::NEON:
+      NEONMagnitude3(xyz, numTuples, magnitudes, maxMagnitude);
+      return;
+#endif
+    default:
+      ScalarMagnitude3(xyz, numTuples, magnitudes, maxMagnitude);
+  }
+}
+
+//------------------------------------------------------------------------------
+void Magnitude3(const double* xyz, vtkIdType numTuples, float* magnitudes, float& maxMagnitude)
+{
+  switch (GetInstructionSet())
+  {
+#if VTK_SIMD_HAS_X86
+    case InstructionSet::AVX512:
+      AVX512Magnitude3(xyz, numTuples, magnitudes, maxMagnitude);
+      return;
+    case InstructionSet::AVX2:
+      AVX2Magnitude3(xyz, numTuples, magnitudes, maxMagnitude);
+      return;
+#endif
+#if VTK_SIMD_HAS_NEON
+    case InstructionSet::NEON:
+      NEONMagnitude3(xyz, numTuples, magnitudes, maxMagnitude);
+      return;
+#endif
+    default:
+      ScalarMagnitude3(xyz, numTuples, magnitudes, maxMagnitude);
+  }
+}
+
+//------------------------------------------------------------------------------
+void Dot3(const float* a, const float* b, vtkIdType numTuples, float* dots, float range[2])
+{
+  switch (GetInstructionSet())
+  {
+#if VTK_SIMD_HAS_X86
+    case InstructionSet::AVX512:
+      AVX512Dot3(a, b, numTuples, dots, range);
+      return;
+    case InstructionSet::AVX2:
+      AVX2Dot3(a, b, numTuples, dots, range);
+      return;
+#endif
+#if VTK_SIMD_HAS_NEON
+    case InstructionSet::NEON:
+      NEONDot3(a, b, numTuples, dots, range);
+      return;
+#endif
+    default:
+      ScalarDot3(a, b, numTuples, dots, range);
+  }
+}
+
+//------------------------------------------------------------------------------
+void Dot3(const double* a, const double* b, vtkIdType numTuples, float* dots, float range[2])
+{
+  switch (GetInstructionSet())
+  {
+#if VTK_SIMD_HAS_X86
+    case InstructionSet::AVX512:
+      AVX512Dot3(a, b, numTuples, dots, range);
+      return;
+    case InstructionSet::AVX2:
+      AVX2Dot3(a, b, numTuples, dots, range);
+      return;
+#endif
+#if VTK_SIMD_HAS_NEON
+    case InstructionSet::NEON:
+      NEONDot3(a, b, numTuples, dots, range);
+      return;
+#endif
+    default:
+      ScalarDot3(a, b, numTuples, dots, range);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkIdType ClassifyEdges(const float* values, vtkIdType numEdges, double isoValue,
+  unsigned char* cases, vtkIdType& firstCrossing, vtkIdType& endCrossing)
+{
+  const float threshold = FloatThreshold(isoValue);
+  firstCrossing = numEdges;
+  endCrossing = 0;
+  switch (GetInstructionSet())
+  {
+#if VTK_SIMD_HAS_X86
+    case InstructionSet::AVX512:
+      return AVX512ClassifyEdges(values, numEdges, threshold, cases, firstCrossing, endCrossing);
+    case InstructionSet::AVX2:
+      return AVX2ClassifyEdges(values, numEdges, threshold, cases, firstCrossing, endCrossing);
+#endif
+#if VTK_SIMD_HAS_NEON
+    case InstructionSet::NEON:
+      return NEONClassifyEdges(values, numEdges, threshold, cases, firstCrossing, endCrossing);
+#endif
+    default:
+      return ScalarClassifyEdges(values, 0, numEdges, threshold, cases, firstCrossing, endCrossing);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkIdType ClassifyEdges(const double* values, vtkIdType numEdges, double isoValue,
+  unsigned char* cases, vtkIdType& firstCrossing, vtkIdType& endCrossing)
+{
+  firstCrossing = numEdges;
+  endCrossing = 0;
+  switch (GetInstructionSet())
+  {
+#if VTK_SIMD_HAS_X86
+    case InstructionSet::AVX512:
+      return AVX512ClassifyEdges(values, numEdges, isoValue, cases, firstCrossing, endCrossing);
+    case InstructionSet::AVX2:
+      return AVX2ClassifyEdges(values, numEdges, isoValue, cases, firstCrossing, endCrossing);
+#endif
+#if VTK_SIMD_HAS_NEON
+    case InstructionSet::NEON:
+      return NEONClassifyEdges(values, numEdges, isoValue, cases, firstCrossing, endCrossing);
+#endif
+    default:
+      return ScalarClassifyEdges(values, 0, numEdges, isoValue, cases, firstCrossing, endCrossing);
+  }
+}
+
+VTK_ABI_NAMESPACE_END
+} // namespace simd
+} // namespace detail
+} // namespace vtk
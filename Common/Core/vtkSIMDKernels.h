@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @file   vtkSIMDKernels.h
+ * @brief  internal vectorized kernels for the hot loops over contiguous arrays.
+ *
+ * These kernels implement loops that compilers fail to auto-vectorize because of
+ * the branches needed to skip NaN values when tracking ranges or to classify
+ * values against a threshold. The implementation
+ * is selected at runtime from the instruction sets supported by the CPU (AVX2 and
+ * AVX-512 on x86-64, NEON on ARM64), with a scalar fallback elsewhere.
+ *
+ * All the implementations, including the scalar fallback, produce identical
+ * results: operations are performed in the same order and precision, without
+ * fused multiply-add contraction. The only difference allowed is the sign of a
+ * zero range bound when both -0.0 and +0.0 are present.
+ *
+ * The default instruction set can be overridden with the VTK_SIMD environment
+ * variable (scalar, neon, avx2 or avx512) or with SetInstructionSet().
+ *
+ * This is an internal API and may change without notice.
+ */
+
+#ifndef vtkSIMDKernels_h
+#define vtkSIMDKernels_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkType.h"             // For vtkIdType
+
+namespace vtk
+{
+namespace detail
+{
+namespace simd
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+enum class InstructionSet
+{
+  Scalar,
+  NEON,
+  AVX2,
+  AVX512
+};
+
+///@{
+/**
+ * Instruction set used by the kernels. SetInstructionSet() returns false and does
+ * nothing if the CPU or the build does not support @a isa.
+ */
+VTKCOMMONCORE_EXPORT InstructionSet GetInstructionSet();
+VTKCOMMONCORE_EXPORT bool SetInstructionSet(InstructionSet isa);
+///@}
+
+/**
+ * Most capable instruction set supported by both the build and the CPU.
+ */
+VTKCOMMONCORE_EXPORT InstructionSet GetBestInstructionSet();
+
+/**
+ * Human readable name of an instruction set.
+ */
+VTKCOMMONCORE_EXPORT const char* GetInstructionSetName(InstructionSet isa);
+
+///@{
+/**
+ * Extend `range` with the minimum and maximum of the non-NaN `values`. If
+ * `finiteRange` is not null, it is extended with the finite values as well.
+ */
+VTKCOMMONCORE_EXPORT void MinMax(
+  const float* values, vtkIdType numValues, float range[2], float* finiteRange = nullptr);
+VTKCOMMONCORE_EXPORT void MinMax(
+  const double* values, vtkIdType numValues, double range[2], double* finiteRange = nullptr);
+///@}
+
+///@{
+/**
+ * Compute the euclidean norm of `numTuples` interleaved 3-component tuples into
+ * `magnitudes`, and raise `maxMagnitude` to the largest non-NaN norm.
+ */
+VTKCOMMONCORE_EXPORT void Magnitude3(
+  const float* xyz, vtkIdType numTuples, float* magnitudes, float& maxMagnitude);
+VTKCOMMONCORE_EXPORT void Magnitude3(
+  const double* xyz, vtkIdType numTuples, float* magnitudes, float& maxMagnitude);
+///@}
+
+///@{
+/**
+ * Compute the dot products of `numTuples` interleaved 3-component tuples of `a`
+ * and `b` into `dots`, and extend `range` with the non-NaN results.
+ */
+VTKCOMMONCORE_EXPORT void Dot3(
+  const float* a, const float* b, vtkIdType numTuples, float* dots, float range[2]);
+VTKCOMMONCORE_EXPORT void Dot3(
+  const double* a, const double* b, vtkIdType numTuples, float* dots, float range[2]);
+///@}
+
+///@{
+/**
+ * Classify the `numEdges` edges joining consecutive `values` against `isoValue`
+ * into `cases`, as the x-edge cases of vtkFlyingEdges3D: bit 0 is set when the
+ * first vertex of the edge is >= isoValue and bit 1 when the second one is.
+ * `values` holds `numEdges + 1` values. Return the number of edges crossing the
+ * iso-value and set [firstCrossing, endCrossing) to the range of the crossing
+ * edges, or to [numEdges, 0) when there is none. Float values are classified
+ * exactly as if they were converted to double.
+ */
+VTKCOMMONCORE_EXPORT vtkIdType ClassifyEdges(const float* values, vtkIdType numEdges,
+  double isoValue, unsigned char* cases, vtkIdType& firstCrossing, vtkIdType& endCrossing);
+VTKCOMMONCORE_EXPORT vtkIdType ClassifyEdges(const double* values, vtkIdType numEdges,
+  double isoValue, unsigned char* cases, vtkIdType& firstCrossing, vtkIdType& endCrossing);
+///@}
+
+VTK_ABI_NAMESPACE_END
+} // namespace simd
+} // namespace detail
+} // namespace vtk
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSIMDKernels.h
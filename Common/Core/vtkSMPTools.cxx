@@ -5,6 +5,11 @@
 
 #include "vtkSMP.h"
 
+#include <algorithm> // For std::max
+#include <cstdlib>   // For std::getenv
+#include <exception> // For std::exception_ptr
+#include <mutex>     // For std::mutex
+
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
 const char* vtkSMPTools::GetBackend()
@@ -68,4 +73,176 @@ bool vtkSMPTools::GetSingleThread()
   auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
   return SMPToolsAPI.GetSingleThread();
 }
+
+//------------------------------------------------------------------------------
+namespace
+{
+bool& FirstTouchAllocation()
+{
+  static bool firstTouch = []() {
+    const char* env = std::getenv("VTK_SMP_FIRST_TOUCH");
+    return env && std::atoi(env) != 0;
+  }();
+  return firstTouch;
+}
+
+// Smaller buffers are not worth the threading overhead
+constexpr std::size_t FirstTouchMinimumSize = 4 << 20;
+constexpr std::size_t FirstTouchPageSize = 4096;
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetFirstTouchAllocation(bool firstTouch)
+{
+  FirstTouchAllocation() = firstTouch;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::GetFirstTouchAllocation()
+{
+  return FirstTouchAllocation();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::FirstTouch(void* data, std::size_t numberOfBytes)
+{
+  if (!data || numberOfBytes == 0)
+  {
+    return;
+  }
+  volatile char* bytes = static_cast<char*>(data);
+  const vtkIdType numberOfPages =
+    static_cast<vtkIdType>((numberOfBytes + FirstTouchPageSize - 1) / FirstTouchPageSize);
+  vtkSMPTools::For(0, numberOfPages, [bytes](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType page = begin; page < end; ++page)
+    {
+      bytes[page * FirstTouchPageSize] = 0;
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+struct vtkSMPTools::TaskGroup::vtkInternals
+{
+  struct Task
+  {
+    std::function<void()> Function;
+    // Length of the longest dependency chain ending at this task.
+    std::size_t Level = 0;
+  };
+
+  std::vector<Task> Tasks;
+  std::size_t NumberOfLevels = 0;
+};
+
+//------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::TaskGroup()
+  : Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::~TaskGroup() = default;
+
+//------------------------------------------------------------------------------
+vtkSMPTools::TaskGroup::TaskId vtkSMPTools::TaskGroup::Add(
+  std::function<void()> task, const std::vector<TaskId>& dependencies)
+{
+  auto& tasks = this->Internals->Tasks;
+  const TaskId id = tasks.size();
+  tasks.emplace_back();
+  tasks[id].Function = std::move(task);
+
+  for (const TaskId dependency : dependencies)
+  {
+    if (dependency >= id)
+    {
+      vtkGenericWarningMacro(
+        "TaskGroup: task " << id << " depends on unknown task " << dependency << ", ignoring.");
+      continue;
+    }
+    tasks[id].Level = std::max(tasks[id].Level, tasks[dependency].Level + 1);
+  }
+  this->Internals->NumberOfLevels =
+    std::max(this->Internals->NumberOfLevels, tasks[id].Level + 1);
+  return id;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::Execute()
+{
+  const auto& tasks = this->Internals->Tasks;
+  if (tasks.empty())
+  {
+    return;
+  }
+
+  // Tasks are run in waves of equal level, so every task of a wave only depends on
+  // tasks of previous waves. No task ever waits inside a vtkSMPTools::For body: a
+  // blocked task could otherwise be stolen onto the thread running the task it waits
+  // for by a nested For of the TBB or OpenMP backends, and deadlock.
+  std::vector<std::vector<TaskId>> waves(this->Internals->NumberOfLevels);
+  for (TaskId id = 0; id < tasks.size(); ++id)
+  {
+    waves[tasks[id].Level].push_back(id);
+  }
+
+  std::mutex mutex;
+  std::exception_ptr error;
+  for (const auto& wave : waves)
+  {
+    const vtkIdType waveSize = static_cast<vtkIdType>(wave.size());
+    vtkSMPTools::For(0, waveSize, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        try
+        {
+          tasks[wave[i]].Function();
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!error)
+          {
+            error = std::current_exception();
+          }
+        }
+      }
+    });
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::TaskGroup::Clear()
+{
+  this->Internals->Tasks.clear();
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkSMPTools::TaskGroup::GetNumberOfTasks() const
+{
+  return this->Internals->Tasks.size();
+}
+VTK_ABI_NAMESPACE_END
+
+namespace vtk
+{
+namespace detail
+{
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+void vtkBufferFirstTouch(void* data, std::size_t numberOfBytes)
+{
+  if (numberOfBytes >= FirstTouchMinimumSize && FirstTouchAllocation() &&
+    !vtkSMPTools::IsParallelScope())
+  {
+    vtkSMPTools::FirstTouch(data, numberOfBytes);
+  }
+}
 VTK_ABI_NAMESPACE_END
+} // namespace detail
+} // namespace vtk
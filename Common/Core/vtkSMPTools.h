@@ -24,8 +24,13 @@
 #include "SMP/Common/vtkSMPToolsAPI.h"
 #include "vtkSMPThreadLocal.h" // For Initialized
 
+#include <algorithm>   // For std::min
+#include <cstddef>     // For std::size_t
 #include <functional>  // For std::function
+#include <iterator>    // For std::iterator_traits
+#include <memory>      // For std::unique_ptr
 #include <type_traits> // For std:::enable_if
+#include <vector>      // For std::vector
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace vtk
@@ -207,6 +212,62 @@ public:
 
 template <typename T>
 using resolvedNotInt = typename std::enable_if<!std::is_integral<T>::value, void>::type;
+
+// Functor used by vtkSMPTools::Reduce. Each block is reduced into a local
+// accumulator and written once in its own slot, so threads do not share cache
+// lines while reducing. Slots are then combined pairwise as a balanced tree.
+template <typename T, typename MapFunctor, typename CombineFunctor>
+struct vtkSMPTools_ReduceFunctor
+{
+  vtkIdType First;
+  vtkIdType Last;
+  vtkIdType BlockSize;
+  const T& Identity;
+  MapFunctor& Map;
+  CombineFunctor& Combine;
+  std::vector<T> Slots;
+
+  vtkSMPTools_ReduceFunctor(vtkIdType first, vtkIdType last, vtkIdType numberOfBlocks,
+    const T& identity, MapFunctor& map, CombineFunctor& combine)
+    : First(first)
+    , Last(last)
+    , Identity(identity)
+    , Map(map)
+    , Combine(combine)
+  {
+    const vtkIdType size = last - first;
+    this->BlockSize = (size + numberOfBlocks - 1) / numberOfBlocks;
+    this->Slots.resize(static_cast<std::size_t>((size + this->BlockSize - 1) / this->BlockSize),
+      identity);
+  }
+
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
+  {
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      const vtkIdType begin = this->First + block * this->BlockSize;
+      const vtkIdType end = (std::min)(begin + this->BlockSize, this->Last);
+      T acc = this->Identity;
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        acc = this->Combine(acc, this->Map(i));
+      }
+      this->Slots[block] = acc;
+    }
+  }
+
+  T TreeCombine()
+  {
+    for (std::size_t stride = 1; stride < this->Slots.size(); stride *= 2)
+    {
+      for (std::size_t i = 0; i + stride < this->Slots.size(); i += 2 * stride)
+      {
+        this->Slots[i] = this->Combine(this->Slots[i], this->Slots[i + stride]);
+      }
+    }
+    return this->Slots[0];
+  }
+};
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
@@ -442,6 +503,27 @@ public:
    */
   static bool IsParallelScope();
 
+  ///@{
+  /**
+   * /!\ This method is not thread safe.
+   * If true, large vtkBuffer allocations (used by vtkAOSDataArrayTemplate and
+   * vtkSOADataArrayTemplate) are first touched in parallel by the SMP backend. Since
+   * operating systems usually map a page on the NUMA domain of the thread writing it
+   * first, memory-bound vtkSMPTools::For loops then mostly read local memory. This is
+   * best combined with pinned threads, see VTK_SMP_AFFINITY for the STDThread backend.
+   *
+   * Default to false, unless the VTK_SMP_FIRST_TOUCH env variable is set to 1.
+   */
+  static void SetFirstTouchAllocation(bool firstTouch);
+  static bool GetFirstTouchAllocation();
+  ///@}
+
+  /**
+   * Write every memory page of the given buffer from the threads of the active backend,
+   * splitting it the same way vtkSMPTools::For splits a range with the default grain.
+   */
+  static void FirstTouch(void* data, std::size_t numberOfBytes);
+
   /**
    * Returns true if the given thread is specified thread
    * for single scope. Returns false otherwise.
@@ -623,6 +705,241 @@ public:
     auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
     SMPToolsAPI.Sort(begin, end, comp);
   }
+
+  ///@{
+  /**
+   * A convenience method for computing prefix sums. It is a drop in replacement for
+   * std::inclusive_scan(): the i-th output is the reduction of the input values up to
+   * and including the i-th one. The operation must be associative, it defaults to
+   * addition. Iterators must be random access, and the output range can be the input
+   * range itself.
+   *
+   * Usage example, converting per-cell point counts to offsets:
+   * \code
+   * std::vector<vtkIdType> counts = ...;
+   * vtkSMPTools::InclusiveScan(counts.begin(), counts.end(), offsets.begin() + 1);
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  static void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.InclusiveScan(inBegin, inEnd, outBegin, op);
+  }
+
+  template <typename InputIt, typename OutputIt>
+  static void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin)
+  {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    vtkSMPTools::InclusiveScan(inBegin, inEnd, outBegin, std::plus<T>());
+  }
+  ///@}
+
+  ///@{
+  /**
+   * A convenience method for computing prefix sums. It is a drop in replacement for
+   * std::exclusive_scan(): the i-th output is the reduction of `init` with the input
+   * values preceding the i-th one. The operation must be associative, it defaults to
+   * addition. Iterators must be random access, and the output range can be the input
+   * range itself.
+   *
+   * Returns the reduction of `init` with all the input values, e.g. the total size to
+   * allocate when converting counts to offsets:
+   * \code
+   * vtkIdType total = vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(),
+   *   counts.begin(), vtkIdType(0));
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static T ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+  }
+
+  template <typename InputIt, typename OutputIt, typename T>
+  static T ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init)
+  {
+    return vtkSMPTools::ExclusiveScan(inBegin, inEnd, outBegin, init, std::plus<T>());
+  }
+  ///@}
+
+  /**
+   * Parallel reduction of the values `map(i)` for `i` in [first, last) with the
+   * associative operation `combine`, starting from `identity`. This replaces the
+   * usual vtkSMPThreadLocal accumulator followed by a serial Reduce() loop.
+   *
+   * The range is split in blocks, each one reduced in a local accumulator, then the
+   * block results are combined as a balanced tree. For a given number of threads the
+   * blocks are always the same, so floating point results are reproducible from one
+   * run to another.
+   *
+   * Usage example, computing the range of an array:
+   * \code
+   * using Range = std::array<double, 2>;
+   * const Range init{ VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+   * Range range = vtkSMPTools::Reduce(0, n, init,
+   *   [&](vtkIdType i) { return Range{ values[i], values[i] }; },
+   *   [](const Range& a, const Range& b) {
+   *     return Range{ std::min(a[0], b[0]), std::max(a[1], b[1]) };
+   *   });
+   * \endcode
+   */
+  template <typename T, typename MapFunctor, typename CombineFunctor>
+  static T Reduce(
+    vtkIdType first, vtkIdType last, const T& identity, MapFunctor map, CombineFunctor combine)
+  {
+    if (last <= first)
+    {
+      return identity;
+    }
+    const vtkIdType numberOfBlocks = (std::min)(
+      static_cast<vtkIdType>(vtkSMPTools::GetEstimatedNumberOfThreads()) * 4, last - first);
+    vtk::detail::smp::vtkSMPTools_ReduceFunctor<T, MapFunctor, CombineFunctor> reducer(
+      first, last, numberOfBlocks, identity, map, combine);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(reducer.Slots.size()), 1, reducer);
+    return reducer.TreeCombine();
+  }
+
+  ///@{
+  /**
+   * Segmented versions of InclusiveScan() and ExclusiveScan(). The input is split in
+   * segments by `offsets`, a range of `numberOfSegments + 1` increasing indices in the
+   * same layout as vtkCellArray offsets, and each segment is scanned independently.
+   * Segments are processed in parallel, each one serially, so this is best suited for
+   * many small segments such as per-cell or per-batch lists. Exclusive scans restart
+   * from `init` at each segment.
+   */
+  template <typename InputIt, typename OffsetIt, typename OutputIt, typename BinaryOp>
+  static void SegmentedInclusiveScan(
+    InputIt inBegin, OffsetIt offsetsBegin, OffsetIt offsetsEnd, OutputIt outBegin, BinaryOp op)
+  {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    const vtkIdType numberOfSegments = std::distance(offsetsBegin, offsetsEnd) - 1;
+    vtkSMPTools::For(0, numberOfSegments, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType segment = begin; segment < end; ++segment)
+      {
+        const vtkIdType first = static_cast<vtkIdType>(offsetsBegin[segment]);
+        const vtkIdType last = static_cast<vtkIdType>(offsetsBegin[segment + 1]);
+        if (first >= last)
+        {
+          continue;
+        }
+        T acc = inBegin[first];
+        outBegin[first] = acc;
+        for (vtkIdType i = first + 1; i < last; ++i)
+        {
+          acc = op(acc, inBegin[i]);
+          outBegin[i] = acc;
+        }
+      }
+    });
+  }
+
+  template <typename InputIt, typename OffsetIt, typename OutputIt>
+  static void SegmentedInclusiveScan(
+    InputIt inBegin, OffsetIt offsetsBegin, OffsetIt offsetsEnd, OutputIt outBegin)
+  {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    vtkSMPTools::SegmentedInclusiveScan(
+      inBegin, offsetsBegin, offsetsEnd, outBegin, std::plus<T>());
+  }
+
+  template <typename InputIt, typename OffsetIt, typename OutputIt, typename T, typename BinaryOp>
+  static void SegmentedExclusiveScan(InputIt inBegin, OffsetIt offsetsBegin, OffsetIt offsetsEnd,
+    OutputIt outBegin, T init, BinaryOp op)
+  {
+    const vtkIdType numberOfSegments = std::distance(offsetsBegin, offsetsEnd) - 1;
+    vtkSMPTools::For(0, numberOfSegments, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType segment = begin; segment < end; ++segment)
+      {
+        const vtkIdType first = static_cast<vtkIdType>(offsetsBegin[segment]);
+        const vtkIdType last = static_cast<vtkIdType>(offsetsBegin[segment + 1]);
+        T acc = init;
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          const T value = inBegin[i];
+          outBegin[i] = acc;
+          acc = op(acc, value);
+        }
+      }
+    });
+  }
+
+  template <typename InputIt, typename OffsetIt, typename OutputIt, typename T>
+  static void SegmentedExclusiveScan(
+    InputIt inBegin, OffsetIt offsetsBegin, OffsetIt offsetsEnd, OutputIt outBegin, T init)
+  {
+    vtkSMPTools::SegmentedExclusiveScan(
+      inBegin, offsetsBegin, offsetsEnd, outBegin, init, std::plus<T>());
+  }
+  ///@}
+
+  /**
+   * A dependency graph of tasks executed by the active backend.
+   *
+   * Multi-phase algorithms usually chain several vtkSMPTools::For calls, each one
+   * acting as a barrier. A TaskGroup lets independent phases run concurrently: tasks
+   * are executed in waves, a wave holding every task whose longest dependency chain
+   * has the same length, and all the tasks of a wave run in parallel once the previous
+   * wave is done. A task never waits for another one, so tasks can safely nest
+   * vtkSMPTools calls with any backend.
+   *
+   * Dependencies can only refer to tasks already added to the group, which guarantees
+   * that the graph is acyclic. Execute() blocks until every task is done. If a task
+   * throws, no further wave is started and the first exception is rethrown by
+   * Execute() once the current wave is done.
+   *
+   * Tasks may themselves call vtkSMPTools methods. Whether those run in parallel
+   * follows the nested parallelism setting, see SetNestedParallelism().
+   *
+   * Usage example:
+   * \code
+   * vtkSMPTools::TaskGroup group;
+   * auto count = group.Add([&]() { vtkSMPTools::For(0, numCells, countFunctor); });
+   * auto pointData = group.Add([&]() { InterpolatePointData(); });
+   * auto cellData = group.Add([&]() { InterpolateCellData(); }, { count });
+   * group.Add([&]() { GenerateOutput(); }, { count, pointData, cellData });
+   * group.Execute();
+   * \endcode
+   */
+  class VTKCOMMONCORE_EXPORT TaskGroup
+  {
+  public:
+    using TaskId = std::size_t;
+
+    TaskGroup();
+    ~TaskGroup();
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /**
+     * Add a task to the group and return its identifier. The task will only be
+     * started once all the tasks listed in `dependencies` are done. Identifiers that
+     * do not refer to a previously added task are ignored with a warning.
+     */
+    TaskId Add(std::function<void()> task, const std::vector<TaskId>& dependencies = {});
+
+    /**
+     * Execute all the tasks of the group, honoring their dependencies, and wait for
+     * their completion. The group is left untouched so it can be executed again.
+     */
+    void Execute();
+
+    /**
+     * Remove all the tasks of the group.
+     */
+    void Clear();
+
+    /**
+     * Get the number of tasks in the group.
+     */
+    std::size_t GetNumberOfTasks() const;
+
+  private:
+    struct vtkInternals;
+    std::unique_ptr<vtkInternals> Internals;
+  };
 };
 
 VTK_ABI_NAMESPACE_END
@@ -224,6 +224,7 @@ void vtkSOADataArrayTemplate<ValueType>::InsertTuples(
 template <class ValueType>
 void vtkSOADataArrayTemplate<ValueType>::FillTypedComponent(int compIdx, ValueType value)
 {
+  this->ResetRangeTracking();
   if (this->StorageType == StorageTypeEnum::SOA)
   {
     ValueType* buffer = this->Data[compIdx]->GetBuffer();
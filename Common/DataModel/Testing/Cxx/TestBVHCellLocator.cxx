@@ -0,0 +1,392 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check the queries of vtkBVHCellLocator against vtkCellTreeLocator and brute
+// force searches on a triangulated height field and on a tetrahedralized
+// cube, with and without cached cell bounds, and check that the batched
+// intersections of IntersectWithLines match the intersections of the
+// segments one by one.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellArray.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A height field over the unit square, split in n^2 pairs of triangles.
+void CreateSurface(vtkPolyData* surface, int n)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= n; ++j)
+  {
+    for (int i = 0; i <= n; ++i)
+    {
+      const double x = static_cast<double>(i) / n;
+      const double y = static_cast<double>(j) / n;
+      points->InsertNextPoint(x, y, 0.1 * std::sin(6.0 * x) * std::cos(5.0 * y));
+    }
+  }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < n; ++j)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      const vtkIdType p = i + (n + 1) * j;
+      const vtkIdType tri0[3] = { p, p + 1, p + n + 2 };
+      const vtkIdType tri1[3] = { p, p + n + 2, p + n + 1 };
+      polys->InsertNextCell(3, tri0);
+      polys->InsertNextCell(3, tri1);
+    }
+  }
+  surface->SetPoints(points);
+  surface->SetPolys(polys);
+}
+
+//------------------------------------------------------------------------------
+// The unit cube, split in n^3 hexahedra of 6 tetrahedra each.
+void CreateTetrahedra(vtkUnstructuredGrid* grid, int n)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= n; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        points->InsertNextPoint(
+          static_cast<double>(i) / n, static_cast<double>(j) / n, static_cast<double>(k) / n);
+      }
+    }
+  }
+  grid->SetPoints(points);
+
+  // The tetrahedra around the diagonal of the hexahedra.
+  const int permutations[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 },
+    { 2, 0, 1 }, { 2, 1, 0 } };
+  grid->AllocateExact(6 * n * n * n, 4);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        for (const auto& axes : permutations)
+        {
+          int corner[3] = { i, j, k };
+          vtkIdType ids[4];
+          ids[0] = corner[0] + (n + 1) * (corner[1] + (n + 1) * corner[2]);
+          for (int c = 1; c < 4; ++c)
+          {
+            ++corner[axes[c - 1]];
+            ids[c] = corner[0] + (n + 1) * (corner[1] + (n + 1) * corner[2]);
+          }
+          grid->InsertNextCell(VTK_TETRA, 4, ids);
+        }
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Segments crossing the height field from above, slightly slanted.
+void CreateSegments(int numberOfSegments, std::vector<double>& p1s, std::vector<double>& p2s)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  p1s.resize(3 * numberOfSegments);
+  p2s.resize(3 * numberOfSegments);
+  for (int s = 0; s < numberOfSegments; ++s)
+  {
+    const double x = random->GetNextRangeValue(-0.1, 1.1);
+    const double y = random->GetNextRangeValue(-0.1, 1.1);
+    p1s[3 * s] = x;
+    p1s[3 * s + 1] = y;
+    p1s[3 * s + 2] = 1.0;
+    p2s[3 * s] = x + random->GetNextRangeValue(-0.2, 0.2);
+    p2s[3 * s + 1] = y + random->GetNextRangeValue(-0.2, 0.2);
+    p2s[3 * s + 2] = -1.0;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool TestIntersections(vtkPolyData* surface, vtkBVHCellLocator* locator)
+{
+  vtkNew<vtkCellTreeLocator> reference;
+  reference->SetDataSet(surface);
+  reference->BuildLocator();
+
+  const int numSegments = 2000;
+  std::vector<double> p1s, p2s;
+  CreateSegments(numSegments, p1s, p2s);
+
+  // The closest intersections match the ones of vtkCellTreeLocator.
+  vtkNew<vtkGenericCell> cell;
+  std::vector<vtkIdType> cellIds(numSegments);
+  std::vector<double> ts(numSegments);
+  const double tol = 1e-8;
+  int numHits = 0;
+  for (int s = 0; s < numSegments; ++s)
+  {
+    double t, x[3], pcoords[3], tRef, xRef[3];
+    int subId;
+    vtkIdType cellId, cellIdRef;
+    const int hit = locator->IntersectWithLine(
+      &p1s[3 * s], &p2s[3 * s], tol, t, x, pcoords, subId, cellId, cell);
+    const int hitRef = reference->IntersectWithLine(
+      &p1s[3 * s], &p2s[3 * s], tol, tRef, xRef, pcoords, subId, cellIdRef, cell);
+    if (hit != hitRef || (hit && std::abs(t - tRef) > 1e-12))
+    {
+      std::cerr << "Segment " << s << " hits cell " << cellId << " at " << t << " instead of "
+                << cellIdRef << " at " << tRef << std::endl;
+      return false;
+    }
+    cellIds[s] = hit ? cellId : -1;
+    ts[s] = hit ? t : 0.0;
+    numHits += hit;
+  }
+  if (numHits == 0 || numHits == numSegments)
+  {
+    std::cerr << "Unexpected number of hits " << numHits << std::endl;
+    return false;
+  }
+
+  // The batched intersections match the intersections one by one.
+  std::vector<vtkIdType> batchIds(numSegments);
+  std::vector<double> batchTs(numSegments);
+  std::vector<double> batchXs(3 * numSegments);
+  locator->IntersectWithLines(numSegments, p1s.data(), p2s.data(), tol, batchIds.data(),
+    batchTs.data(), batchXs.data());
+  for (int s = 0; s < numSegments; ++s)
+  {
+    if ((batchIds[s] < 0) != (cellIds[s] < 0) ||
+      (batchIds[s] >= 0 && std::abs(batchTs[s] - ts[s]) > 1e-12))
+    {
+      std::cerr << "Batched segment " << s << " hits cell " << batchIds[s] << " at " << batchTs[s]
+                << " instead of " << cellIds[s] << " at " << ts[s] << std::endl;
+      return false;
+    }
+  }
+
+  // All the intersections of a segment grazing the height field.
+  const double p1[3] = { -0.1, 0.3, 0.01 };
+  const double p2[3] = { 1.1, 0.7, -0.01 };
+  vtkNew<vtkIdList> ids;
+  vtkNew<vtkIdList> idsRef;
+  vtkNew<vtkPoints> points;
+  locator->IntersectWithLine(p1, p2, tol, points, ids, cell);
+  reference->IntersectWithLine(p1, p2, tol, nullptr, idsRef, cell);
+  if (ids->GetNumberOfIds() < 2 || ids->GetNumberOfIds() != idsRef->GetNumberOfIds() ||
+    points->GetNumberOfPoints() != ids->GetNumberOfIds())
+  {
+    std::cerr << "Got " << ids->GetNumberOfIds() << " intersections instead of "
+              << idsRef->GetNumberOfIds() << std::endl;
+    return false;
+  }
+  double previous[3];
+  points->GetPoint(0, previous);
+  for (vtkIdType i = 1; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    if (x[0] < previous[0] - 1e-9)
+    {
+      std::cerr << "The intersections are not sorted." << std::endl;
+      return false;
+    }
+    std::copy(x, x + 3, previous);
+  }
+
+  // The cells whose bounds intersect the segment.
+  locator->FindCellsAlongLine(p1, p2, tol, ids);
+  reference->FindCellsAlongLine(p1, p2, tol, idsRef);
+  std::vector<vtkIdType> sorted(ids->begin(), ids->end());
+  std::vector<vtkIdType> sortedRef(idsRef->begin(), idsRef->end());
+  std::sort(sorted.begin(), sorted.end());
+  std::sort(sortedRef.begin(), sortedRef.end());
+  if (sorted.empty() || sorted != sortedRef)
+  {
+    std::cerr << "Got " << sorted.size() << " cells along the line instead of "
+              << sortedRef.size() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestClosestPoints(vtkPolyData* surface, vtkBVHCellLocator* locator)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(2);
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(surface->GetMaxCellSize());
+  for (int q = 0; q < 50; ++q)
+  {
+    double x[3] = { random->GetNextRangeValue(-0.2, 1.2), random->GetNextRangeValue(-0.2, 1.2),
+      random->GetNextRangeValue(-0.3, 0.3) };
+    double closest[3], dist2;
+    vtkIdType cellId = -1;
+    int subId;
+    locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+
+    double dist2Ref = VTK_DOUBLE_MAX;
+    for (vtkIdType c = 0; c < surface->GetNumberOfCells(); ++c)
+    {
+      double point[3], pcoords[3], d2;
+      surface->GetCell(c, cell);
+      if (cell->EvaluatePosition(x, point, subId, pcoords, d2, weights.data()) != -1)
+      {
+        dist2Ref = std::min(dist2Ref, d2);
+      }
+    }
+    if (cellId < 0 || std::abs(dist2 - dist2Ref) > 1e-12)
+    {
+      std::cerr << "Closest point at distance " << std::sqrt(dist2) << " instead of "
+                << std::sqrt(dist2Ref) << std::endl;
+      return false;
+    }
+  }
+
+  // The cells within bounds.
+  double bbox[6] = { 0.2, 0.45, 0.6, 0.7, -1.0, 0.0 };
+  vtkNew<vtkIdList> ids;
+  locator->FindCellsWithinBounds(bbox, ids);
+  std::vector<vtkIdType> sorted(ids->begin(), ids->end());
+  std::sort(sorted.begin(), sorted.end());
+  std::vector<vtkIdType> sortedRef;
+  for (vtkIdType c = 0; c < surface->GetNumberOfCells(); ++c)
+  {
+    double bounds[6];
+    surface->GetCellBounds(c, bounds);
+    if (bounds[0] <= bbox[1] && bbox[0] <= bounds[1] && bounds[2] <= bbox[3] &&
+      bbox[2] <= bounds[3] && bounds[4] <= bbox[5] && bbox[4] <= bounds[5])
+    {
+      sortedRef.push_back(c);
+    }
+  }
+  if (sorted.empty() || sorted != sortedRef)
+  {
+    std::cerr << "Got " << sorted.size() << " cells within bounds instead of " << sortedRef.size()
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestFindCell(vtkUnstructuredGrid* grid, vtkBVHCellLocator* locator)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3);
+  vtkNew<vtkGenericCell> cell;
+  double pcoords[3], weights[4], closest[3], dist2;
+  int subId;
+  for (int q = 0; q < 500; ++q)
+  {
+    double x[3] = { random->GetNextRangeValue(-0.1, 1.1), random->GetNextRangeValue(-0.1, 1.1),
+      random->GetNextRangeValue(-0.1, 1.1) };
+    const bool inside = x[0] >= 0.0 && x[0] <= 1.0 && x[1] >= 0.0 && x[1] <= 1.0 && x[2] >= 0.0 &&
+      x[2] <= 1.0;
+    const vtkIdType cellId = locator->FindCell(x, 0.0, cell, subId, pcoords, weights);
+    if (inside != (cellId >= 0))
+    {
+      std::cerr << "Point " << q << (inside ? " is not found." : " is found outside.") << std::endl;
+      return false;
+    }
+    if (cellId >= 0)
+    {
+      grid->GetCell(cellId, cell);
+      if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights) != 1)
+      {
+        std::cerr << "Point " << q << " is not in cell " << cellId << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename DataSetT, typename TestT>
+bool TestLocator(DataSetT* dataSet, TestT test)
+{
+  for (bool cacheCellBounds : { true, false })
+  {
+    vtkNew<vtkBVHCellLocator> locator;
+    locator->SetDataSet(dataSet);
+    locator->SetCacheCellBounds(cacheCellBounds);
+    locator->BuildLocator();
+    if (!test(dataSet, locator))
+    {
+      std::cerr << "Failed with" << (cacheCellBounds ? "" : "out") << " cached cell bounds."
+                << std::endl;
+      return false;
+    }
+  }
+
+  // A shallow copy shares the hierarchy.
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(dataSet);
+  locator->SetNumberOfCellsPerNode(2);
+  locator->SetNumberOfBins(4);
+  locator->BuildLocator();
+  vtkNew<vtkBVHCellLocator> copy;
+  copy->SetDataSet(dataSet);
+  copy->ShallowCopy(locator);
+  if (!test(dataSet, copy))
+  {
+    std::cerr << "Failed with a shallow copy." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestBVHCellLocator(int, char*[])
+{
+  vtkNew<vtkPolyData> surface;
+  CreateSurface(surface, 60);
+  if (!TestLocator(surface.GetPointer(), TestIntersections) ||
+    !TestLocator(surface.GetPointer(), TestClosestPoints))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  CreateTetrahedra(grid, 8);
+  if (!TestLocator(grid.GetPointer(), TestFindCell))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The representation of the leaves has the 12 edges of each leaf.
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(grid);
+  locator->BuildLocator();
+  vtkNew<vtkPolyData> leaves;
+  locator->GenerateRepresentation(-1, leaves);
+  vtkNew<vtkPolyData> root;
+  locator->GenerateRepresentation(0, root);
+  if (leaves->GetNumberOfLines() < 12 * (grid->GetNumberOfCells() / 8) ||
+    root->GetNumberOfLines() != 12)
+  {
+    std::cerr << "Got " << leaves->GetNumberOfLines() << " lines for the leaves and "
+              << root->GetNumberOfLines() << " for the root." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,276 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the batched FindCells of the cell locators finds the same cells
+// and parametric coordinates as FindCell for each point, and that the batched
+// FindCells of the find cell strategies finds cells containing the points
+// inside of a tetrahedralized cube, independently of the number of threads.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellLocator.h"
+#include "vtkCellLocatorStrategy.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkClosestPointStrategy.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// The unit cube, split in n^3 hexahedra of 6 tetrahedra each.
+void CreateTetrahedra(vtkUnstructuredGrid* grid, int n)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= n; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        points->InsertNextPoint(
+          static_cast<double>(i) / n, static_cast<double>(j) / n, static_cast<double>(k) / n);
+      }
+    }
+  }
+  grid->SetPoints(points);
+
+  // The tetrahedra around the diagonal of the hexahedra.
+  const int permutations[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 },
+    { 2, 0, 1 }, { 2, 1, 0 } };
+  grid->AllocateExact(6 * n * n * n, 4);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        for (const auto& axes : permutations)
+        {
+          int corner[3] = { i, j, k };
+          vtkIdType ids[4];
+          ids[0] = corner[0] + (n + 1) * (corner[1] + (n + 1) * corner[2]);
+          for (int c = 1; c < 4; ++c)
+          {
+            ++corner[axes[c - 1]];
+            ids[c] = corner[0] + (n + 1) * (corner[1] + (n + 1) * corner[2]);
+          }
+          grid->InsertNextCell(VTK_TETRA, 4, ids);
+        }
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Random points around the cube, a few of them outside of it.
+void CreateQueries(vtkPoints* queries, int numberOfQueries)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  queries->SetNumberOfPoints(numberOfQueries);
+  for (int i = 0; i < numberOfQueries; ++i)
+  {
+    double x[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] = random->GetNextRangeValue(-0.1, 1.1);
+    }
+    queries->SetPoint(i, x);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool IsInside(const double x[3])
+{
+  return x[0] > 0.0 && x[0] < 1.0 && x[1] > 0.0 && x[1] < 1.0 && x[2] > 0.0 && x[2] < 1.0;
+}
+
+//------------------------------------------------------------------------------
+// Check that the weights of the found cells interpolate the points.
+bool CheckWeights(vtkUnstructuredGrid* grid, vtkPoints* queries, vtkIdList* cellIds,
+  vtkDoubleArray* weights, const char* name)
+{
+  vtkNew<vtkIdList> pointIds;
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    const vtkIdType cellId = cellIds->GetId(i);
+    if (cellId < 0)
+    {
+      continue;
+    }
+    grid->GetCellPoints(cellId, pointIds);
+    double x[3], y[3] = { 0.0, 0.0, 0.0 };
+    queries->GetPoint(i, x);
+    for (vtkIdType j = 0; j < pointIds->GetNumberOfIds(); ++j)
+    {
+      double p[3];
+      grid->GetPoint(pointIds->GetId(j), p);
+      const double w = weights->GetComponent(i, static_cast<int>(j));
+      for (int c = 0; c < 3; ++c)
+      {
+        y[c] += w * p[c];
+      }
+    }
+    if (std::abs(x[0] - y[0]) + std::abs(x[1] - y[1]) + std::abs(x[2] - y[2]) > 1e-9)
+    {
+      std::cerr << name << ": the weights of point " << i << " do not interpolate it."
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestLocator(vtkAbstractCellLocator* locator, vtkUnstructuredGrid* grid, vtkPoints* queries,
+  const char* name)
+{
+  locator->SetDataSet(grid);
+  locator->BuildLocator();
+
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  vtkNew<vtkDoubleArray> weights;
+  locator->FindCells(queries, cellIds, pcoords, weights);
+  if (cellIds->GetNumberOfIds() != queries->GetNumberOfPoints() ||
+    pcoords->GetNumberOfTuples() != queries->GetNumberOfPoints() ||
+    weights->GetNumberOfComponents() != grid->GetMaxCellSize())
+  {
+    std::cerr << name << ": wrong output sizes." << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkGenericCell> cell;
+  double expectedWeights[4];
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    double x[3], expectedPCoords[3];
+    int subId;
+    queries->GetPoint(i, x);
+    const vtkIdType expected =
+      locator->FindCell(x, 0.0, cell, subId, expectedPCoords, expectedWeights);
+    if (cellIds->GetId(i) != expected)
+    {
+      std::cerr << name << ": point " << i << " is in cell " << cellIds->GetId(i)
+                << " instead of " << expected << std::endl;
+      return false;
+    }
+    if (expected < 0)
+    {
+      if (IsInside(x))
+      {
+        std::cerr << name << ": point " << i << " is not found." << std::endl;
+        return false;
+      }
+      continue;
+    }
+    for (int c = 0; c < 3; ++c)
+    {
+      if (pcoords->GetComponent(i, c) != expectedPCoords[c])
+      {
+        std::cerr << name << ": wrong parametric coordinates for point " << i << std::endl;
+        return false;
+      }
+    }
+  }
+
+  // Without the optional outputs.
+  vtkNew<vtkIdList> cellIdsOnly;
+  locator->FindCells(queries, cellIdsOnly);
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    if (cellIdsOnly->GetId(i) != cellIds->GetId(i))
+    {
+      std::cerr << name << ": the cells depend on the optional outputs." << std::endl;
+      return false;
+    }
+  }
+  return CheckWeights(grid, queries, cellIds, weights, name);
+}
+
+//------------------------------------------------------------------------------
+bool TestStrategy(vtkFindCellStrategy* strategy, vtkUnstructuredGrid* grid, vtkPoints* queries,
+  const char* name)
+{
+  strategy->Initialize(grid);
+
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> weights;
+  strategy->FindCells(queries, 0.0, cellIds, nullptr, weights);
+  if (cellIds->GetNumberOfIds() != queries->GetNumberOfPoints())
+  {
+    std::cerr << name << ": wrong output size." << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    queries->GetPoint(i, x);
+    if (IsInside(x) != (cellIds->GetId(i) >= 0))
+    {
+      std::cerr << name << ": point " << i << " is in cell " << cellIds->GetId(i) << std::endl;
+      return false;
+    }
+  }
+  if (!CheckWeights(grid, queries, cellIds, weights, name))
+  {
+    return false;
+  }
+
+  // The hints of the previous points do not depend on the number of threads.
+  vtkNew<vtkIdList> singleThread;
+  vtkSMPTools::LocalScope(
+    vtkSMPTools::Config{ 1 }, [&]() { strategy->FindCells(queries, 0.0, singleThread); });
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    if (singleThread->GetId(i) != cellIds->GetId(i))
+    {
+      std::cerr << name << ": the cells depend on the number of threads." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestFindCells(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  CreateTetrahedra(grid, 12);
+  vtkNew<vtkPoints> queries;
+  CreateQueries(queries, 5000);
+
+  vtkNew<vtkStaticCellLocator> staticLocator;
+  vtkNew<vtkCellTreeLocator> cellTree;
+  vtkNew<vtkCellLocator> cellLocator;
+  vtkNew<vtkBVHCellLocator> bvh;
+  if (!TestLocator(staticLocator, grid, queries, "vtkStaticCellLocator") ||
+    !TestLocator(cellTree, grid, queries, "vtkCellTreeLocator") ||
+    !TestLocator(cellLocator, grid, queries, "vtkCellLocator") ||
+    !TestLocator(bvh, grid, queries, "vtkBVHCellLocator"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkCellLocatorStrategy> cellLocatorStrategy;
+  cellLocatorStrategy->SetCellLocator(staticLocator);
+  vtkNew<vtkClosestPointStrategy> closestPointStrategy;
+  if (!TestStrategy(cellLocatorStrategy, grid, queries, "vtkCellLocatorStrategy") ||
+    !TestStrategy(closestPointStrategy, grid, queries, "vtkClosestPointStrategy"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the kernels of vtkLinearCellKernels give the interpolation
+// functions, derivatives, parametric coordinates and inside tests of the
+// corresponding vtkCell classes, on distorted cells.
+
+#include "vtkHexahedron.h"
+#include "vtkLinearCellKernels.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPyramid.h"
+#include "vtkQuad.h"
+#include "vtkTetra.h"
+#include "vtkTriangle.h"
+#include "vtkWedge.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool Compare(const double* a, const double* b, int n, double tolerance)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    if (std::abs(a[i] - b[i]) > tolerance * (1.0 + std::abs(b[i])))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Random parametric coordinates inside the cell, away from the pyramid apex.
+void RandomParametricCoordinates(
+  int cellType, vtkMinimalStandardRandomSequence* random, double pcoords[3])
+{
+  do
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      pcoords[i] = random->GetNextRangeValue(0.0, 1.0);
+    }
+    if (cellType == VTK_TRIANGLE || cellType == VTK_QUAD)
+    {
+      pcoords[2] = 0.0;
+    }
+  } while (!vtkLinearCellKernels::IsInside(cellType, pcoords, 0.0) ||
+    (cellType == VTK_PYRAMID && pcoords[2] > 0.9));
+}
+
+//------------------------------------------------------------------------------
+template <int CellType, typename CellT>
+bool TestCell(const char* name)
+{
+  const int numPts = vtkLinearCellKernels::CellTraits<CellType>::NumberOfPoints;
+  const int dim = vtkLinearCellKernels::CellTraits<CellType>::Dimension;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(CellType);
+
+  // The parametric points of the cell, perturbed (in the plane of 2D cells)
+  // and mapped by an affine transform.
+  vtkNew<CellT> cell;
+  const double* parametricPoints = cell->GetParametricCoords();
+  const double transform[3][4] = { { 1.2, 0.3, -0.2, 0.5 }, { -0.1, 0.9, 0.4, -1.0 },
+    { 0.2, -0.3, 1.1, 2.0 } };
+  double x[3 * vtkLinearCellKernels::MaximumNumberOfPoints];
+  for (int i = 0; i < numPts; ++i)
+  {
+    double p[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      p[j] = parametricPoints[3 * i + j] + (j < dim ? random->GetNextRangeValue(-0.1, 0.1) : 0.0);
+    }
+    for (int j = 0; j < 3; ++j)
+    {
+      x[3 * i + j] = transform[j][0] * p[0] + transform[j][1] * p[1] + transform[j][2] * p[2] +
+        transform[j][3];
+    }
+    cell->GetPoints()->SetPoint(i, x + 3 * i);
+    cell->GetPointIds()->SetId(i, i);
+  }
+
+  double values[2 * vtkLinearCellKernels::MaximumNumberOfPoints];
+  for (int i = 0; i < 2 * numPts; ++i)
+  {
+    values[i] = random->GetNextRangeValue(-1.0, 1.0);
+  }
+
+  for (int q = 0; q < 50; ++q)
+  {
+    double pcoords[3];
+    RandomParametricCoordinates(CellType, random, pcoords);
+
+    double weights[vtkLinearCellKernels::MaximumNumberOfPoints];
+    double expectedWeights[vtkLinearCellKernels::MaximumNumberOfPoints];
+    vtkLinearCellKernels::InterpolationFunctions<CellType>(pcoords, weights);
+    CellT::InterpolationFunctions(pcoords, expectedWeights);
+    double derivs[3 * vtkLinearCellKernels::MaximumNumberOfPoints];
+    double expectedDerivs[3 * vtkLinearCellKernels::MaximumNumberOfPoints];
+    vtkLinearCellKernels::InterpolationDerivatives<CellType>(pcoords, derivs);
+    CellT::InterpolationDerivs(pcoords, expectedDerivs);
+    if (!Compare(weights, expectedWeights, numPts, 1e-14) ||
+      !Compare(derivs, expectedDerivs, dim * numPts, 1e-14))
+    {
+      std::cerr << name << ": wrong interpolation functions." << std::endl;
+      return false;
+    }
+
+    double valueDerivs[6], expectedValueDerivs[6];
+    if (!vtkLinearCellKernels::Derivatives<CellType>(x, pcoords, values, 2, valueDerivs))
+    {
+      std::cerr << name << ": unexpected degenerate cell." << std::endl;
+      return false;
+    }
+    cell->Derivatives(0, pcoords, values, 2, expectedValueDerivs);
+    if (!Compare(valueDerivs, expectedValueDerivs, 6, 1e-9))
+    {
+      std::cerr << name << ": wrong derivatives." << std::endl;
+      return false;
+    }
+
+    // The position of pcoords gives back pcoords.
+    double p[3] = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < numPts; ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        p[j] += weights[i] * x[3 * i + j];
+      }
+    }
+    double found[3];
+    if (!vtkLinearCellKernels::ParametricCoordinates(CellType, x, p, found, weights) ||
+      !Compare(found, pcoords, 3, 1e-9) || !Compare(weights, expectedWeights, numPts, 1e-9))
+    {
+      std::cerr << name << ": wrong parametric coordinates." << std::endl;
+      return false;
+    }
+    double closest[3], expectedPcoords[3], dist2;
+    int subId;
+    if (cell->EvaluatePosition(p, closest, subId, expectedPcoords, dist2, expectedWeights) != 1)
+    {
+      std::cerr << name << ": the position is not inside the cell." << std::endl;
+      return false;
+    }
+  }
+
+  // A position outside the cell.
+  const double outside[3] = { 1.3, 0.1, 0.0 };
+  double weights[vtkLinearCellKernels::MaximumNumberOfPoints];
+  vtkLinearCellKernels::InterpolationFunctions<CellType>(outside, weights);
+  double p[3] = { 0.0, 0.0, 0.0 };
+  for (int i = 0; i < numPts; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      p[j] += weights[i] * x[3 * i + j];
+    }
+  }
+  double found[3], closest[3], expectedPcoords[3], dist2;
+  int subId;
+  if (!vtkLinearCellKernels::ParametricCoordinates<CellType>(x, p, found, weights) ||
+    vtkLinearCellKernels::IsInside<CellType>(found, 1e-6) ||
+    cell->EvaluatePosition(p, closest, subId, expectedPcoords, dist2, weights) == 1)
+  {
+    std::cerr << name << ": the outside position is inside the cell." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestLinearCellKernels(int, char*[])
+{
+  if (!TestCell<VTK_TETRA, vtkTetra>("vtkTetra") ||
+    !TestCell<VTK_HEXAHEDRON, vtkHexahedron>("vtkHexahedron") ||
+    !TestCell<VTK_WEDGE, vtkWedge>("vtkWedge") ||
+    !TestCell<VTK_PYRAMID, vtkPyramid>("vtkPyramid") ||
+    !TestCell<VTK_TRIANGLE, vtkTriangle>("vtkTriangle") ||
+    !TestCell<VTK_QUAD, vtkQuad>("vtkQuad"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (vtkLinearCellKernels::IsSupported(VTK_VOXEL) ||
+    vtkLinearCellKernels::NumberOfPoints(VTK_VOXEL) != 0)
+  {
+    std::cerr << "Unexpected support of voxels." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkStaticCellLocator and vtkBVHCellLocator refitted to a
+// deformed tetrahedralized cube find the same cells as locators built for
+// the deformed cube, for a deformation staying in the initial bounds and for
+// one leaving them.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// The unit cube, split in n^3 hexahedra of 6 tetrahedra each.
+void CreateTetrahedra(vtkUnstructuredGrid* grid, int n)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= n; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        points->InsertNextPoint(
+          static_cast<double>(i) / n, static_cast<double>(j) / n, static_cast<double>(k) / n);
+      }
+    }
+  }
+  grid->SetPoints(points);
+
+  // The tetrahedra around the diagonal of the hexahedra.
+  const int permutations[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 },
+    { 2, 0, 1 }, { 2, 1, 0 } };
+  grid->AllocateExact(6 * n * n * n, 4);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        for (const auto& axes : permutations)
+        {
+          int corner[3] = { i, j, k };
+          vtkIdType ids[4];
+          ids[0] = corner[0] + (n + 1) * (corner[1] + (n + 1) * corner[2]);
+          for (int c = 1; c < 4; ++c)
+          {
+            ++corner[axes[c - 1]];
+            ids[c] = corner[0] + (n + 1) * (corner[1] + (n + 1) * corner[2]);
+          }
+          grid->InsertNextCell(VTK_TETRA, 4, ids);
+        }
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Move the points of the grid with a smooth deformation, scaled by scale
+// around the center of the cube.
+void Deform(vtkUnstructuredGrid* grid, const std::vector<double>& initial, double scale)
+{
+  vtkPoints* points = grid->GetPoints();
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    const double* x = initial.data() + 3 * ptId;
+    const double wave = 0.02 * std::sin(6.0 * x[0]) * std::sin(5.0 * x[1]) * std::sin(4.0 * x[2]);
+    points->SetPoint(ptId, 0.5 + scale * (x[0] - 0.5) + wave, 0.5 + scale * (x[1] - 0.5) - wave,
+      0.5 + scale * (x[2] - 0.5) + 0.5 * wave);
+  }
+  points->Modified();
+  grid->Modified();
+}
+
+//------------------------------------------------------------------------------
+bool Compare(vtkAbstractCellLocator* refitted, vtkAbstractCellLocator* built,
+  vtkUnstructuredGrid* grid, const char* name)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkGenericCell> cell;
+  double pcoords[3], weights[4];
+  int subId;
+  for (int q = 0; q < 5000; ++q)
+  {
+    double x[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] = random->GetNextRangeValue(-0.1, 1.1);
+    }
+    const vtkIdType expected = built->FindCell(x, 0.0, cell, subId, pcoords, weights);
+    const vtkIdType cellId = refitted->FindCell(x, 0.0, cell, subId, pcoords, weights);
+    if ((cellId < 0) != (expected < 0))
+    {
+      std::cerr << name << ": found cell " << cellId << " instead of " << expected << std::endl;
+      return false;
+    }
+    if (cellId < 0)
+    {
+      continue;
+    }
+    double closest[3], dist2;
+    grid->GetCell(cellId, cell);
+    if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights) != 1)
+    {
+      std::cerr << name << ": cell " << cellId << " does not contain the point." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename LocatorT>
+bool TestRefit(const char* name)
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  CreateTetrahedra(grid, 12);
+  std::vector<double> initial(3 * grid->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < grid->GetNumberOfPoints(); ++ptId)
+  {
+    grid->GetPoint(ptId, initial.data() + 3 * ptId);
+  }
+
+  vtkNew<LocatorT> refitted;
+  refitted->SetDataSet(grid);
+  refitted->BuildLocator();
+
+  // A shallow copy keeps the search structure it was copied from.
+  vtkNew<LocatorT> copy;
+  copy->SetDataSet(grid);
+  copy->ShallowCopy(refitted);
+
+  for (double scale : { 0.9, 0.8, 1.1 })
+  {
+    Deform(grid, initial, scale);
+    refitted->RefitLocator();
+    vtkNew<LocatorT> built;
+    built->SetDataSet(grid);
+    built->BuildLocator();
+    if (!Compare(refitted, built, grid, name))
+    {
+      std::cerr << name << " failed for the scale " << scale << std::endl;
+      return false;
+    }
+  }
+
+  // Back to the initial points, the shallow copy still finds the cells.
+  for (vtkIdType ptId = 0; ptId < grid->GetNumberOfPoints(); ++ptId)
+  {
+    grid->GetPoints()->SetPoint(ptId, initial.data() + 3 * ptId);
+  }
+  grid->GetPoints()->Modified();
+  grid->Modified();
+  vtkNew<LocatorT> built;
+  built->SetDataSet(grid);
+  built->BuildLocator();
+  copy->SetUseExistingSearchStructure(true);
+  if (!Compare(copy, built, grid, name))
+  {
+    std::cerr << name << ": the shallow copy is modified by the refit." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestRefitCellLocators(int, char*[])
+{
+  if (!TestRefit<vtkStaticCellLocator>("vtkStaticCellLocator") ||
+    !TestRefit<vtkBVHCellLocator>("vtkBVHCellLocator"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
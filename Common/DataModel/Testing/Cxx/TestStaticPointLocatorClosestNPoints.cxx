@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the batched FindClosestNPoints of vtkStaticPointLocator finds
+// the closest points found by brute force, ordered by distance and id, with
+// the same distances as the per-query FindClosestNPoints, independently of the
+// number of threads.
+
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Random points in the unit cube, with a few duplicated points to check the
+// ordering of the ties.
+void CreatePoints(vtkPolyData* polyData, int numberOfPoints)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3];
+    if (i % 100 == 99)
+    {
+      points->GetPoint(i - 50, x);
+    }
+    else
+    {
+      for (int c = 0; c < 3; ++c)
+      {
+        x[c] = random->GetNextValue();
+      }
+    }
+    points->InsertNextPoint(x);
+  }
+  polyData->SetPoints(points);
+}
+
+//------------------------------------------------------------------------------
+bool TestQueries(vtkStaticPointLocator* locator, vtkPolyData* polyData,
+  const std::vector<double>& queries, int N)
+{
+  const vtkIdType numQueries = static_cast<vtkIdType>(queries.size() / 3);
+  std::vector<vtkIdType> ids(numQueries * N);
+  std::vector<double> dist2(numQueries * N);
+  locator->FindClosestNPoints(numQueries, queries.data(), N, ids.data(), dist2.data());
+
+  const vtkIdType numPts = polyData->GetNumberOfPoints();
+  std::vector<std::pair<double, vtkIdType>> expected(numPts);
+  vtkNew<vtkIdList> result;
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    const double* x = queries.data() + 3 * q;
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      double p[3];
+      polyData->GetPoint(ptId, p);
+      expected[ptId] = std::make_pair(vtkMath::Distance2BetweenPoints(x, p), ptId);
+    }
+    std::sort(expected.begin(), expected.end());
+    for (int k = 0; k < N; ++k)
+    {
+      const vtkIdType expectedId = k < numPts ? expected[k].second : -1;
+      const double expectedDist2 = k < numPts ? expected[k].first : VTK_DOUBLE_MAX;
+      if (ids[q * N + k] != expectedId || dist2[q * N + k] != expectedDist2)
+      {
+        std::cerr << "Query " << q << ": point " << k << " is " << ids[q * N + k] << " instead of "
+                  << expectedId << " for N = " << N << std::endl;
+        return false;
+      }
+    }
+
+    // The per-query method finds points at the same distances.
+    locator->FindClosestNPoints(N, x, result);
+    for (vtkIdType k = 0; k < result->GetNumberOfIds(); ++k)
+    {
+      double p[3];
+      polyData->GetPoint(result->GetId(k), p);
+      if (vtkMath::Distance2BetweenPoints(x, p) != dist2[q * N + k])
+      {
+        std::cerr << "Query " << q << ": point " << k << " differs from the per-query method."
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+
+  // Without the distances, and with a single thread.
+  std::vector<vtkIdType> singleThread(numQueries * N);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() {
+    locator->FindClosestNPoints(numQueries, queries.data(), N, singleThread.data());
+  });
+  if (singleThread != ids)
+  {
+    std::cerr << "The closest points depend on the number of threads for N = " << N << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestStaticPointLocatorClosestNPoints(int, char*[])
+{
+  vtkNew<vtkPolyData> polyData;
+  CreatePoints(polyData, 2000);
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(polyData);
+  locator->SetNumberOfPointsPerBucket(3);
+  locator->BuildLocator();
+
+  // Queries around the cube, a few of them outside of it, plus some of the
+  // points themselves.
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(2);
+  std::vector<double> queries;
+  for (int q = 0; q < 500; ++q)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      queries.push_back(random->GetNextRangeValue(-0.5, 1.5));
+    }
+  }
+  for (vtkIdType ptId = 0; ptId < 2000; ptId += 37)
+  {
+    double x[3];
+    polyData->GetPoint(ptId, x);
+    queries.insert(queries.end(), x, x + 3);
+  }
+
+  if (!TestQueries(locator, polyData, queries, 1) || !TestQueries(locator, polyData, queries, 10))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // More points requested than the locator holds.
+  vtkNew<vtkPolyData> fewPoints;
+  CreatePoints(fewPoints, 7);
+  locator->SetDataSet(fewPoints);
+  locator->BuildLocator();
+  if (!TestQueries(locator, fewPoints, queries, 10))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
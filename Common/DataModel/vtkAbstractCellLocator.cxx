@@ -6,6 +6,7 @@
 #include "vtkCellArray.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -13,9 +14,13 @@
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -78,6 +83,12 @@ void vtkAbstractCellLocator::ComputeCellBounds()
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::RefitLocator()
+{
+  this->ForceBuildLocator();
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractCellLocator::UpdateInternalWeights()
 {
@@ -258,6 +269,65 @@ vtkIdType vtkAbstractCellLocator::FindCell(
   return returnVal;
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::InitializeFindCellsOutputs(vtkIdType numberOfPoints, int maxCellSize,
+  vtkIdList* cellIds, vtkDoubleArray* pcoords, vtkDoubleArray* weights, double*& pcoordsPtr,
+  double*& weightsPtr)
+{
+  cellIds->SetNumberOfIds(numberOfPoints);
+  pcoordsPtr = nullptr;
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numberOfPoints);
+    pcoordsPtr = pcoords->GetPointer(0);
+  }
+  weightsPtr = nullptr;
+  if (weights)
+  {
+    weights->SetNumberOfComponents(std::max(maxCellSize, 1));
+    weights->SetNumberOfTuples(numberOfPoints);
+    weightsPtr = weights->GetPointer(0);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCells(
+  vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords, vtkDoubleArray* weights)
+{
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  // GetMaxCellSize() may build the cells, so it is called before the threads.
+  const int maxCellSize = this->DataSet ? this->DataSet->GetMaxCellSize() : 0;
+  double *pcoordsPtr, *weightsPtr;
+  vtkAbstractCellLocator::InitializeFindCellsOutputs(
+    numPts, maxCellSize, cellIds, pcoords, weights, pcoordsPtr, weightsPtr);
+  vtkIdType* ids = cellIds->GetPointer(0);
+  if (!this->DataSet)
+  {
+    std::fill(ids, ids + numPts, -1);
+    return;
+  }
+  this->BuildLocator();
+
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPThreadLocal<std::vector<double>> tlWeights;
+  const int numWeights = std::max(maxCellSize, 1);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = tlCell.Local();
+    std::vector<double>& localWeights = tlWeights.Local();
+    localWeights.resize(numWeights);
+    double x[3], localPCoords[3];
+    int subId;
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      points->GetPoint(ptId, x);
+      ids[ptId] = this->FindCell(x, 0.0, cell, subId,
+        pcoordsPtr ? pcoordsPtr + 3 * ptId : localPCoords,
+        weightsPtr ? weightsPtr + numWeights * ptId : localWeights.data());
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
 {
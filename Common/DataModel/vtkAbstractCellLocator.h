@@ -34,6 +34,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
+class vtkDoubleArray;
 class vtkGenericCell;
 class vtkIdList;
 class vtkPoints;
@@ -74,6 +75,16 @@ public:
    */
   void ComputeCellBounds();
 
+  /**
+   * Update the search structure after the points of the data set moved, the
+   * cells being the same. Locators able to update their structure, such as
+   * vtkStaticCellLocator and vtkBVHCellLocator, do so in less time than
+   * ForceBuildLocator(), at the cost of a structure which may be less
+   * efficient than a new one. The default implementation calls
+   * ForceBuildLocator().
+   */
+  virtual void RefitLocator();
+
   ///@{
   /**
    * Boolean controls whether to maintain list of cells in each node.
@@ -287,6 +298,25 @@ public:
     double pcoords[3], double* weights);
   ///@}
 
+  /**
+   * Find the cells containing a batch of points, in parallel. cellIds is
+   * resized to the number of points and set to the id of the cell containing
+   * each point, or -1 if no cell contains it. If pcoords is not nullptr, it
+   * is resized to 3 components per point and set to the parametric
+   * coordinates of the points in their cells. If weights is not nullptr, it
+   * is resized to GetMaxCellSize() components per point, the maximum cell
+   * size of the data set, and set to the interpolation weights of the points
+   * in their cells. The parametric coordinates and weights of the points
+   * that are not found are undefined.
+   *
+   * The default implementation calls the thread safe FindCell() in
+   * parallel, subclasses may reorder the points to locate them faster.
+   *
+   * THIS FUNCTION IS THREAD SAFE.
+   */
+  virtual void FindCells(vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords = nullptr,
+    vtkDoubleArray* weights = nullptr);
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * Some locators cache cell bounds and this function can make use
@@ -323,6 +353,16 @@ protected:
    */
   void UpdateInternalWeights();
 
+  /**
+   * To be called in `FindCells()`. Resize the outputs for numberOfPoints
+   * points and cells of at most maxCellSize points, and return pointers to
+   * the values of the parametric coordinates and of the weights, or nullptr
+   * for the outputs that are not requested.
+   */
+  static void InitializeFindCellsOutputs(vtkIdType numberOfPoints, int maxCellSize,
+    vtkIdList* cellIds, vtkDoubleArray* pcoords, vtkDoubleArray* weights, double*& pcoordsPtr,
+    double*& weightsPtr);
+
   int NumberOfCellsPerNode;
   vtkTypeBool RetainCellLists;
   vtkTypeBool CacheCellBounds;
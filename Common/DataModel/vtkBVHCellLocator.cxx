@@ -0,0 +1,1369 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkBVHCellLocator.h"
+
+#include "vtkBoundingBox.h"
+#include "vtkBox.h"
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+vtkStandardNewMacro(vtkBVHCellLocator);
+VTK_ABI_NAMESPACE_END
+
+namespace
+{
+// Ranges of cells larger than this are binned and partitioned in parallel.
+constexpr vtkIdType ParallelGrain = 1 << 15;
+// Levels of the hierarchy with at least this number of nodes are split in
+// parallel over the nodes.
+constexpr std::size_t ParallelNodes = 64;
+// Number of consecutive segments traversed together by IntersectWithLines().
+constexpr int PacketSize = 4;
+
+//------------------------------------------------------------------------------
+// Expand bounds by other bounds.
+void AddBounds(double bounds[6], const double other[6])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    bounds[2 * i] = std::min(bounds[2 * i], other[2 * i]);
+    bounds[2 * i + 1] = std::max(bounds[2 * i + 1], other[2 * i + 1]);
+  }
+}
+
+//------------------------------------------------------------------------------
+void InitializeBounds(double bounds[6])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    bounds[2 * i] = VTK_DOUBLE_MAX;
+    bounds[2 * i + 1] = -VTK_DOUBLE_MAX;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Half of the surface area of bounds, which is all the surface area heuristic
+// needs.
+double HalfArea(const double bounds[6])
+{
+  const double dx = bounds[1] - bounds[0];
+  const double dy = bounds[3] - bounds[2];
+  const double dz = bounds[5] - bounds[4];
+  return dx * dy + dy * dz + dz * dx;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+double Distance2ToBounds(const double x[3], const T bounds[6])
+{
+  double dist2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    double delta = 0.0;
+    if (x[i] < bounds[2 * i])
+    {
+      delta = bounds[2 * i] - x[i];
+    }
+    else if (x[i] > bounds[2 * i + 1])
+    {
+      delta = x[i] - bounds[2 * i + 1];
+    }
+    dist2 += delta * delta;
+  }
+  return dist2;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+bool Contains(const T bounds[6], const double x[3])
+{
+  return bounds[0] <= x[0] && x[0] <= bounds[1] && bounds[2] <= x[1] && x[1] <= bounds[3] &&
+    bounds[4] <= x[2] && x[2] <= bounds[5];
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+bool Overlaps(const T bounds[6], const double other[6])
+{
+  return bounds[0] <= other[1] && other[0] <= bounds[1] && bounds[2] <= other[3] &&
+    other[2] <= bounds[3] && bounds[4] <= other[5] && other[4] <= bounds[5];
+}
+
+//------------------------------------------------------------------------------
+// Accumulate over [begin, end), in parallel with one local result per thread
+// when parallel is true. The combination of the local results must not depend
+// on their order, so that the result does not depend on the number of threads.
+template <typename T, typename Accumulate, typename Combine>
+void Reduce(vtkIdType begin, vtkIdType end, bool parallel, T& result, Accumulate accumulate,
+  Combine combine)
+{
+  if (!parallel)
+  {
+    accumulate(begin, end, result);
+    return;
+  }
+  vtkSMPThreadLocal<T> locals(result);
+  vtkSMPTools::For(
+    begin, end, [&](vtkIdType first, vtkIdType last) { accumulate(first, last, locals.Local()); });
+  for (const T& local : locals)
+  {
+    combine(result, local);
+  }
+}
+
+//------------------------------------------------------------------------------
+// A line segment, with the inverse of its direction for the slab tests.
+struct Segment
+{
+  double P1[3];
+  double P2[3];
+  double Direction[3];
+  double InverseDirection[3];
+  double Tolerance;
+
+  void Initialize(const double p1[3], const double p2[3], double tol)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->P1[i] = p1[i];
+      this->P2[i] = p2[i];
+      this->Direction[i] = p2[i] - p1[i];
+      this->InverseDirection[i] = this->Direction[i] != 0.0 ? 1.0 / this->Direction[i] : 0.0;
+    }
+    // vtkBox::IntersectBox pads the degenerate cell bounds by this tolerance.
+    this->Tolerance = tol > 0.0 ? tol : FLT_EPSILON;
+  }
+
+  // Return whether the segment intersects the bounds padded by the tolerance
+  // before the parametric coordinate tMax, and the parametric coordinate it
+  // enters them at. The axes the segment is parallel to are tested apart,
+  // which avoids the products of infinities and zeros.
+  template <typename T>
+  bool Intersects(const T bounds[6], double tMax, double& tEntry) const
+  {
+    double t0 = 0.0;
+    double t1 = std::min(tMax, 1.0);
+    for (int i = 0; i < 3; ++i)
+    {
+      const double lo = bounds[2 * i] - this->Tolerance;
+      const double hi = bounds[2 * i + 1] + this->Tolerance;
+      if (this->Direction[i] == 0.0)
+      {
+        if (this->P1[i] < lo || this->P1[i] > hi)
+        {
+          return false;
+        }
+        continue;
+      }
+      double ta = (lo - this->P1[i]) * this->InverseDirection[i];
+      double tb = (hi - this->P1[i]) * this->InverseDirection[i];
+      if (ta > tb)
+      {
+        std::swap(ta, tb);
+      }
+      t0 = std::max(t0, ta);
+      t1 = std::min(t1, tb);
+      if (t0 > t1)
+      {
+        return false;
+      }
+    }
+    tEntry = t0;
+    return true;
+  }
+};
+
+//------------------------------------------------------------------------------
+// The closest intersections of a packet of segments.
+struct PacketHits
+{
+  vtkIdType CellId[PacketSize];
+  double T[PacketSize];
+  double X[PacketSize][3];
+  double PCoords[PacketSize][3];
+  int SubId[PacketSize];
+};
+
+//------------------------------------------------------------------------------
+// An intersection of a segment with a cell or with its bounds.
+struct IntersectionInfo
+{
+  vtkIdType CellId;
+  double X[3];
+  double T;
+};
+
+//------------------------------------------------------------------------------
+void AddBox(vtkPoints* points, vtkCellArray* lines, const float bounds[6])
+{
+  vtkIdType corners[8];
+  for (int c = 0; c < 8; ++c)
+  {
+    corners[c] = points->InsertNextPoint(
+      bounds[c & 1], bounds[2 + ((c >> 1) & 1)], bounds[4 + ((c >> 2) & 1)]);
+  }
+  for (int c = 0; c < 8; ++c)
+  {
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (!(c & (1 << axis)))
+      {
+        const vtkIdType edge[2] = { corners[c], corners[c | (1 << axis)] };
+        lines->InsertNextCell(2, edge);
+      }
+    }
+  }
+}
+} // anonymous namespace
+
+namespace detail
+{
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+// A node of the hierarchy. The children of an internal node are the nodes
+// Offset and Offset + 1, and the cells of a leaf are the Count cells starting
+// at Offset in the cell ids of the tree. The bounds are rounded outwards to
+// single precision.
+struct BVHNode
+{
+  float Bounds[6];
+  int Offset;
+  int Count;
+
+  bool IsLeaf() const { return this->Count > 0; }
+
+  void SetBounds(const double bounds[6])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      float lo = static_cast<float>(bounds[2 * i]);
+      if (lo > bounds[2 * i])
+      {
+        lo = std::nextafter(lo, -std::numeric_limits<float>::infinity());
+      }
+      float hi = static_cast<float>(bounds[2 * i + 1]);
+      if (hi < bounds[2 * i + 1])
+      {
+        hi = std::nextafter(hi, std::numeric_limits<float>::infinity());
+      }
+      this->Bounds[2 * i] = lo;
+      this->Bounds[2 * i + 1] = hi;
+    }
+  }
+};
+static_assert(sizeof(BVHNode) == 32, "The nodes of the hierarchy must be 32 bytes.");
+
+//------------------------------------------------------------------------------
+// The cells of a node being built, CellIds[Begin] to CellIds[End - 1].
+struct BVHBuildTask
+{
+  vtkIdType Begin;
+  vtkIdType End;
+  vtkIdType Node;
+};
+
+//------------------------------------------------------------------------------
+// The bounds of a range of cells and of their centroids.
+struct BVHRangeBounds
+{
+  double Bounds[6];
+  double CentroidBounds[6];
+};
+
+//------------------------------------------------------------------------------
+// The bounds and the number of the cells whose centroids fall in a bin.
+struct BVHBin
+{
+  double Bounds[6];
+  vtkIdType Count;
+};
+
+//------------------------------------------------------------------------------
+// Split the nodes of the hierarchy with the binned surface area heuristic,
+// partitioning the cell ids of each node in place.
+class BVHBuilder
+{
+public:
+  BVHBuilder(const double* cellBounds, vtkIdType* ids, vtkIdType numberOfCells, int numberOfBins,
+    int leafSize)
+    : CellBounds(cellBounds)
+    , Ids(ids)
+    , Scratch(numberOfCells)
+    , NumberOfBins(numberOfBins)
+    , LeafSize(leafSize)
+  {
+  }
+
+  // Set the bounds of the node of a task and split its cells in two ranges.
+  // Return the start of the second range, or -1 if the node is a leaf. The
+  // large ranges are processed in parallel when parallel is true.
+  vtkIdType Split(const BVHBuildTask& task, BVHNode& node, bool parallel)
+  {
+    const vtkIdType begin = task.Begin;
+    const vtkIdType end = task.End;
+    parallel = parallel && end - begin > ParallelGrain;
+
+    BVHRangeBounds range;
+    InitializeBounds(range.Bounds);
+    InitializeBounds(range.CentroidBounds);
+    Reduce(
+      begin, end, parallel, range,
+      [this](vtkIdType first, vtkIdType last, BVHRangeBounds& local) {
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          const double* bounds = this->CellBounds + 6 * this->Ids[i];
+          AddBounds(local.Bounds, bounds);
+          for (int axis = 0; axis < 3; ++axis)
+          {
+            const double c = 0.5 * (bounds[2 * axis] + bounds[2 * axis + 1]);
+            local.CentroidBounds[2 * axis] = std::min(local.CentroidBounds[2 * axis], c);
+            local.CentroidBounds[2 * axis + 1] = std::max(local.CentroidBounds[2 * axis + 1], c);
+          }
+        }
+      },
+      [](BVHRangeBounds& result, const BVHRangeBounds& local) {
+        AddBounds(result.Bounds, local.Bounds);
+        AddBounds(result.CentroidBounds, local.CentroidBounds);
+      });
+    node.SetBounds(range.Bounds);
+    if (end - begin <= this->LeafSize)
+    {
+      return -1;
+    }
+
+    // Bin the centroids along the axes they spread along.
+    const int numBins = this->NumberOfBins;
+    const double* centroidBounds = range.CentroidBounds;
+    double scales[3];
+    bool spread = false;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const double extent = centroidBounds[2 * axis + 1] - centroidBounds[2 * axis];
+      scales[axis] = extent > 0.0 ? numBins / extent : 0.0;
+      spread |= extent > 0.0;
+    }
+    if (!spread)
+    {
+      // All the centroids coincide, split the cells in halves.
+      return begin + (end - begin) / 2;
+    }
+
+    BVHBin empty;
+    InitializeBounds(empty.Bounds);
+    empty.Count = 0;
+    std::vector<BVHBin> bins(3 * numBins, empty);
+    Reduce(
+      begin, end, parallel, bins,
+      [&](vtkIdType first, vtkIdType last, std::vector<BVHBin>& local) {
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          const double* bounds = this->CellBounds + 6 * this->Ids[i];
+          for (int axis = 0; axis < 3; ++axis)
+          {
+            if (scales[axis] > 0.0)
+            {
+              BVHBin& bin = local[axis * numBins +
+                this->BinIndex(0.5 * (bounds[2 * axis] + bounds[2 * axis + 1]),
+                  centroidBounds[2 * axis], scales[axis])];
+              AddBounds(bin.Bounds, bounds);
+              ++bin.Count;
+            }
+          }
+        }
+      },
+      [](std::vector<BVHBin>& result, const std::vector<BVHBin>& local) {
+        for (std::size_t b = 0; b < result.size(); ++b)
+        {
+          AddBounds(result[b].Bounds, local[b].Bounds);
+          result[b].Count += local[b].Count;
+        }
+      });
+
+    // Evaluate the cost of the splits between the bins: the cells of the
+    // bins [0, split) go to the first child.
+    double bestCost = VTK_DOUBLE_MAX;
+    int bestAxis = -1;
+    int bestSplit = 0;
+    std::vector<double> leftCosts(numBins);
+    std::vector<vtkIdType> leftCounts(numBins);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (scales[axis] == 0.0)
+      {
+        continue;
+      }
+      const BVHBin* axisBins = bins.data() + axis * numBins;
+      BVHBin left = empty;
+      for (int split = 1; split < numBins; ++split)
+      {
+        AddBounds(left.Bounds, axisBins[split - 1].Bounds);
+        left.Count += axisBins[split - 1].Count;
+        leftCounts[split] = left.Count;
+        leftCosts[split] = left.Count > 0 ? left.Count * HalfArea(left.Bounds) : 0.0;
+      }
+      BVHBin right = empty;
+      for (int split = numBins - 1; split > 0; --split)
+      {
+        AddBounds(right.Bounds, axisBins[split].Bounds);
+        right.Count += axisBins[split].Count;
+        if (leftCounts[split] > 0 && right.Count > 0)
+        {
+          const double cost = leftCosts[split] + right.Count * HalfArea(right.Bounds);
+          if (cost < bestCost)
+          {
+            bestCost = cost;
+            bestAxis = axis;
+            bestSplit = split;
+          }
+        }
+      }
+    }
+    if (bestAxis < 0)
+    {
+      return begin + (end - begin) / 2;
+    }
+
+    const double minimum = centroidBounds[2 * bestAxis];
+    const double scale = scales[bestAxis];
+    return this->Partition(
+      begin, end,
+      [&](vtkIdType cellId) {
+        const double* bounds = this->CellBounds + 6 * cellId;
+        return this->BinIndex(0.5 * (bounds[2 * bestAxis] + bounds[2 * bestAxis + 1]), minimum,
+                 scale) < bestSplit;
+      },
+      parallel);
+  }
+
+private:
+  int BinIndex(double c, double minimum, double scale) const
+  {
+    const int bin = static_cast<int>((c - minimum) * scale);
+    return std::min(std::max(bin, 0), this->NumberOfBins - 1);
+  }
+
+  // Stable partition of the ids of [begin, end) through the scratch ids.
+  // Return the start of the ids not satisfying the predicate.
+  template <typename Predicate>
+  vtkIdType Partition(vtkIdType begin, vtkIdType end, Predicate predicate, bool parallel)
+  {
+    vtkIdType* ids = this->Ids;
+    vtkIdType* scratch = this->Scratch.data();
+    if (!parallel)
+    {
+      vtkIdType left = begin;
+      vtkIdType right = begin;
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkIdType cellId = ids[i];
+        if (predicate(cellId))
+        {
+          ids[left++] = cellId;
+        }
+        else
+        {
+          scratch[right++] = cellId;
+        }
+      }
+      std::copy(scratch + begin, scratch + right, ids + left);
+      return left;
+    }
+
+    // Count the ids of the first range in chunks, then scatter the chunks at
+    // their offsets and copy back.
+    const vtkIdType numChunks = (end - begin + ParallelGrain - 1) / ParallelGrain;
+    std::vector<vtkIdType> offsets(numChunks + 1, 0);
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType firstChunk, vtkIdType lastChunk) {
+      for (vtkIdType chunk = firstChunk; chunk < lastChunk; ++chunk)
+      {
+        const vtkIdType last = std::min(begin + (chunk + 1) * ParallelGrain, end);
+        vtkIdType count = 0;
+        for (vtkIdType i = begin + chunk * ParallelGrain; i < last; ++i)
+        {
+          count += predicate(ids[i]) ? 1 : 0;
+        }
+        offsets[chunk + 1] = count;
+      }
+    });
+    for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+    {
+      offsets[chunk + 1] += offsets[chunk];
+    }
+    const vtkIdType numLeft = offsets[numChunks];
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType firstChunk, vtkIdType lastChunk) {
+      for (vtkIdType chunk = firstChunk; chunk < lastChunk; ++chunk)
+      {
+        const vtkIdType first = begin + chunk * ParallelGrain;
+        const vtkIdType last = std::min(first + ParallelGrain, end);
+        vtkIdType left = begin + offsets[chunk];
+        vtkIdType right = begin + numLeft + (first - begin - offsets[chunk]);
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          const vtkIdType cellId = ids[i];
+          scratch[predicate(cellId) ? left++ : right++] = cellId;
+        }
+      }
+    });
+    vtkSMPTools::For(begin, end, [&](vtkIdType first, vtkIdType last) {
+      std::copy(scratch + first, scratch + last, ids + first);
+    });
+    return begin + numLeft;
+  }
+
+  const double* CellBounds;
+  vtkIdType* Ids;
+  std::vector<vtkIdType> Scratch;
+  int NumberOfBins;
+  int LeafSize;
+};
+
+//------------------------------------------------------------------------------
+struct BVHTree
+{
+  std::vector<BVHNode> Nodes;
+  std::vector<vtkIdType> CellIds;
+
+  void Build(vtkBVHCellLocator* locator);
+  void Refit(vtkBVHCellLocator* locator);
+
+  void IntersectPacket(vtkBVHCellLocator* locator, const Segment* segments, int numberOfSegments,
+    double tol, vtkGenericCell* cell, PacketHits& hits) const;
+
+  int IntersectWithLine(vtkBVHCellLocator* locator, const double p1[3], const double p2[3],
+    double tol, double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId,
+    vtkGenericCell* cell) const;
+  int IntersectWithLine(vtkBVHCellLocator* locator, const double p1[3], const double p2[3],
+    double tol, vtkPoints* points, vtkIdList* cellIds, vtkGenericCell* cell) const;
+  void IntersectWithLines(vtkBVHCellLocator* locator, vtkIdType numberOfLines, const double* p1s,
+    const double* p2s, double tol, vtkIdType* cellIds, double* ts, double* xs) const;
+
+  vtkIdType FindClosestPointWithinRadius(vtkBVHCellLocator* locator, const double x[3],
+    double radius, double closestPoint[3], vtkGenericCell* cell, vtkIdType& closestCellId,
+    int& closestSubId, double& minDist2, int& inside) const;
+  void FindCellsWithinBounds(
+    vtkBVHCellLocator* locator, const double bbox[6], vtkIdList* cells) const;
+  vtkIdType FindCell(vtkBVHCellLocator* locator, double pos[3], vtkGenericCell* cell, int& subId,
+    double pcoords[3], double* weights) const;
+  void GenerateRepresentation(int level, vtkPolyData* pd) const;
+};
+
+//------------------------------------------------------------------------------
+// The hierarchy is built level by level. The nodes of the large levels are
+// split in parallel, and the few large nodes of the first levels are binned
+// and partitioned in parallel. Both give the same splits, so the hierarchy
+// does not depend on the number of threads.
+void BVHTree::Build(vtkBVHCellLocator* locator)
+{
+  vtkDataSet* dataSet = locator->DataSet;
+  const vtkIdType numCells = dataSet->GetNumberOfCells();
+
+  const double* cellBounds = locator->CacheCellBounds ? locator->CellBounds : nullptr;
+  std::vector<double> computedBounds;
+  if (!cellBounds)
+  {
+    computedBounds.resize(6 * numCells);
+    // Calling GetCellBounds() once first makes the subsequent calls thread safe.
+    dataSet->GetCellBounds(0, computedBounds.data());
+    vtkSMPTools::For(1, numCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        dataSet->GetCellBounds(cellId, computedBounds.data() + 6 * cellId);
+      }
+    });
+    cellBounds = computedBounds.data();
+  }
+
+  this->CellIds.resize(numCells);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      this->CellIds[cellId] = cellId;
+    }
+  });
+
+  BVHBuilder builder(cellBounds, this->CellIds.data(), numCells, locator->NumberOfBins,
+    std::max(locator->NumberOfCellsPerNode, 1));
+  this->Nodes.assign(1, BVHNode());
+  std::vector<BVHBuildTask> level(1, BVHBuildTask{ 0, numCells, 0 });
+  std::vector<BVHBuildTask> nextLevel;
+  std::vector<vtkIdType> middles;
+  while (!level.empty())
+  {
+    middles.resize(level.size());
+    if (level.size() >= ParallelNodes)
+    {
+      const vtkIdType numTasks = static_cast<vtkIdType>(level.size());
+      vtkSMPTools::For(0, numTasks, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          middles[i] = builder.Split(level[i], this->Nodes[level[i].Node], false);
+        }
+      });
+    }
+    else
+    {
+      for (std::size_t i = 0; i < level.size(); ++i)
+      {
+        middles[i] = builder.Split(level[i], this->Nodes[level[i].Node], true);
+      }
+    }
+
+    // Allocate the children of the split nodes next to each other.
+    nextLevel.clear();
+    for (std::size_t i = 0; i < level.size(); ++i)
+    {
+      const BVHBuildTask& task = level[i];
+      BVHNode& node = this->Nodes[task.Node];
+      if (middles[i] < 0)
+      {
+        node.Offset = static_cast<int>(task.Begin);
+        node.Count = static_cast<int>(task.End - task.Begin);
+        continue;
+      }
+      const vtkIdType child = static_cast<vtkIdType>(this->Nodes.size());
+      node.Offset = static_cast<int>(child);
+      node.Count = 0;
+      nextLevel.push_back(BVHBuildTask{ task.Begin, middles[i], child });
+      nextLevel.push_back(BVHBuildTask{ middles[i], task.End, child + 1 });
+      this->Nodes.resize(this->Nodes.size() + 2);
+    }
+    level.swap(nextLevel);
+  }
+  this->Nodes.shrink_to_fit();
+}
+
+//------------------------------------------------------------------------------
+// Recompute the bounds of the nodes from the current bounds of their cells,
+// keeping the hierarchy. The leaves are refitted in parallel, then the inner
+// nodes, whose children always follow them, in reverse order.
+void BVHTree::Refit(vtkBVHCellLocator* locator)
+{
+  vtkDataSet* dataSet = locator->DataSet;
+  const double* cellBounds = locator->CacheCellBounds ? locator->CellBounds : nullptr;
+  if (!cellBounds)
+  {
+    // Calling GetCellBounds() once first makes the subsequent calls thread safe.
+    double bounds[6];
+    dataSet->GetCellBounds(0, bounds);
+  }
+
+  const vtkIdType numNodes = static_cast<vtkIdType>(this->Nodes.size());
+  vtkSMPTools::For(0, numNodes, [&](vtkIdType begin, vtkIdType end) {
+    double bounds[6];
+    for (vtkIdType n = begin; n < end; ++n)
+    {
+      BVHNode& node = this->Nodes[n];
+      if (!node.IsLeaf())
+      {
+        continue;
+      }
+      vtkBoundingBox bbox;
+      for (vtkIdType i = node.Offset; i < node.Offset + node.Count; ++i)
+      {
+        const vtkIdType cellId = this->CellIds[i];
+        if (cellBounds)
+        {
+          bbox.AddBounds(cellBounds + 6 * cellId);
+        }
+        else
+        {
+          dataSet->GetCellBounds(cellId, bounds);
+          bbox.AddBounds(bounds);
+        }
+      }
+      bbox.GetBounds(bounds);
+      node.SetBounds(bounds);
+    }
+  });
+
+  for (vtkIdType n = numNodes - 1; n >= 0; --n)
+  {
+    BVHNode& node = this->Nodes[n];
+    if (node.IsLeaf())
+    {
+      continue;
+    }
+    const BVHNode& left = this->Nodes[node.Offset];
+    const BVHNode& right = this->Nodes[node.Offset + 1];
+    for (int i = 0; i < 3; ++i)
+    {
+      node.Bounds[2 * i] = std::min(left.Bounds[2 * i], right.Bounds[2 * i]);
+      node.Bounds[2 * i + 1] = std::max(left.Bounds[2 * i + 1], right.Bounds[2 * i + 1]);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Traverse the hierarchy with a packet of segments. A node is visited when at
+// least one segment of the packet enters it before its closest intersection,
+// and the children are visited in the order the packet enters them.
+void BVHTree::IntersectPacket(vtkBVHCellLocator* locator, const Segment* segments,
+  int numberOfSegments, double tol, vtkGenericCell* cell, PacketHits& hits) const
+{
+  // The parametric coordinates the segments enter a node at, or infinity for
+  // the segments that do not intersect it.
+  struct StackEntry
+  {
+    vtkIdType Node;
+    double TEntry[PacketSize];
+  };
+  const double miss = std::numeric_limits<double>::infinity();
+
+  StackEntry root;
+  root.Node = 0;
+  bool hitRoot = false;
+  for (int r = 0; r < PacketSize; ++r)
+  {
+    hits.CellId[r] = -1;
+    hits.T[r] = VTK_DOUBLE_MAX;
+    root.TEntry[r] = miss;
+    if (r < numberOfSegments)
+    {
+      hitRoot |= segments[r].Intersects(this->Nodes[0].Bounds, 1.0, root.TEntry[r]);
+    }
+  }
+  if (!hitRoot)
+  {
+    return;
+  }
+
+  std::vector<StackEntry> stack;
+  stack.reserve(64);
+  stack.push_back(root);
+  double cellBounds[6], *cellBoundsPtr = cellBounds;
+  double t, x[3], pcoords[3];
+  int subId;
+  while (!stack.empty())
+  {
+    const StackEntry entry = stack.back();
+    stack.pop_back();
+    int active = 0;
+    for (int r = 0; r < numberOfSegments; ++r)
+    {
+      if (entry.TEntry[r] <= hits.T[r])
+      {
+        active |= 1 << r;
+      }
+    }
+    if (!active)
+    {
+      continue;
+    }
+
+    const BVHNode& node = this->Nodes[entry.Node];
+    if (node.IsLeaf())
+    {
+      for (vtkIdType i = node.Offset; i < node.Offset + node.Count; ++i)
+      {
+        const vtkIdType cellId = this->CellIds[i];
+        locator->GetCellBounds(cellId, cellBoundsPtr);
+        bool cellLoaded = false;
+        for (int r = 0; r < numberOfSegments; ++r)
+        {
+          double tBounds;
+          if (!(active & (1 << r)) || !segments[r].Intersects(cellBoundsPtr, hits.T[r], tBounds))
+          {
+            continue;
+          }
+          if (!cellLoaded)
+          {
+            locator->DataSet->GetCell(cellId, cell);
+            cellLoaded = true;
+          }
+          if (cell->IntersectWithLine(segments[r].P1, segments[r].P2, tol, t, x, pcoords, subId) &&
+            t < hits.T[r])
+          {
+            hits.CellId[r] = cellId;
+            hits.T[r] = t;
+            std::copy(x, x + 3, hits.X[r]);
+            std::copy(pcoords, pcoords + 3, hits.PCoords[r]);
+            hits.SubId[r] = subId;
+          }
+        }
+      }
+      continue;
+    }
+
+    StackEntry children[2];
+    double nearest[2] = { miss, miss };
+    for (int c = 0; c < 2; ++c)
+    {
+      children[c].Node = node.Offset + c;
+      const float* bounds = this->Nodes[node.Offset + c].Bounds;
+      for (int r = 0; r < PacketSize; ++r)
+      {
+        children[c].TEntry[r] = miss;
+        if ((active & (1 << r)) && segments[r].Intersects(bounds, hits.T[r], children[c].TEntry[r]))
+        {
+          nearest[c] = std::min(nearest[c], children[c].TEntry[r]);
+        }
+      }
+    }
+    // Push the farthest child first, so that the nearest is traversed first.
+    const int first = nearest[0] <= nearest[1] ? 0 : 1;
+    if (nearest[1 - first] != miss)
+    {
+      stack.push_back(children[1 - first]);
+    }
+    if (nearest[first] != miss)
+    {
+      stack.push_back(children[first]);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+int BVHTree::IntersectWithLine(vtkBVHCellLocator* locator, const double p1[3], const double p2[3],
+  double tol, double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId,
+  vtkGenericCell* cell) const
+{
+  Segment segment;
+  segment.Initialize(p1, p2, tol);
+  PacketHits hits;
+  this->IntersectPacket(locator, &segment, 1, tol, cell, hits);
+  cellId = hits.CellId[0];
+  if (cellId < 0)
+  {
+    return 0;
+  }
+  // The cell has been overwritten by the cells tested after the closest one.
+  locator->DataSet->GetCell(cellId, cell);
+  t = hits.T[0];
+  std::copy(hits.X[0], hits.X[0] + 3, x);
+  std::copy(hits.PCoords[0], hits.PCoords[0] + 3, pcoords);
+  subId = hits.SubId[0];
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int BVHTree::IntersectWithLine(vtkBVHCellLocator* locator, const double p1[3], const double p2[3],
+  double tol, vtkPoints* points, vtkIdList* cellIds, vtkGenericCell* cell) const
+{
+  // Initialize the list of points/cells
+  if (points)
+  {
+    points->Reset();
+  }
+  if (cellIds)
+  {
+    cellIds->Reset();
+  }
+  Segment segment;
+  segment.Initialize(p1, p2, tol);
+  double tEntry;
+  if (!segment.Intersects(this->Nodes[0].Bounds, 1.0, tEntry))
+  {
+    return 0;
+  }
+
+  // Each cell is in one leaf only, so no cell is tested twice.
+  std::vector<IntersectionInfo> intersections;
+  std::vector<vtkIdType> stack(1, 0);
+  double cellBounds[6], *cellBoundsPtr = cellBounds;
+  double t, x[3], pcoords[3];
+  int subId;
+  while (!stack.empty())
+  {
+    const BVHNode& node = this->Nodes[stack.back()];
+    stack.pop_back();
+    if (!node.IsLeaf())
+    {
+      for (int c = 1; c >= 0; --c)
+      {
+        if (segment.Intersects(this->Nodes[node.Offset + c].Bounds, 1.0, tEntry))
+        {
+          stack.push_back(node.Offset + c);
+        }
+      }
+      continue;
+    }
+    for (vtkIdType i = node.Offset; i < node.Offset + node.Count; ++i)
+    {
+      const vtkIdType cellId = this->CellIds[i];
+      locator->GetCellBounds(cellId, cellBoundsPtr);
+      if (!vtkBox::IntersectBox(cellBoundsPtr, p1, segment.Direction, x, t, tol))
+      {
+        continue;
+      }
+      if (cell)
+      {
+        locator->DataSet->GetCell(cellId, cell);
+        if (cell->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId))
+        {
+          intersections.push_back(IntersectionInfo{ cellId, { x[0], x[1], x[2] }, t });
+        }
+      }
+      else
+      {
+        intersections.push_back(IntersectionInfo{ cellId, { x[0], x[1], x[2] }, t });
+      }
+    }
+  }
+  if (intersections.empty())
+  {
+    return 0;
+  }
+
+  // Sort the intersections by increasing t, and by cell id for equal t.
+  std::sort(intersections.begin(), intersections.end(),
+    [](const IntersectionInfo& a, const IntersectionInfo& b) {
+      return a.T < b.T || (a.T == b.T && a.CellId < b.CellId);
+    });
+  const vtkIdType numIntersections = static_cast<vtkIdType>(intersections.size());
+  if (points)
+  {
+    points->SetNumberOfPoints(numIntersections);
+    for (vtkIdType i = 0; i < numIntersections; ++i)
+    {
+      points->SetPoint(i, intersections[i].X);
+    }
+  }
+  if (cellIds)
+  {
+    cellIds->SetNumberOfIds(numIntersections);
+    for (vtkIdType i = 0; i < numIntersections; ++i)
+    {
+      cellIds->SetId(i, intersections[i].CellId);
+    }
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void BVHTree::IntersectWithLines(vtkBVHCellLocator* locator, vtkIdType numberOfLines,
+  const double* p1s, const double* p2s, double tol, vtkIdType* cellIds, double* ts,
+  double* xs) const
+{
+  const vtkIdType numPackets = (numberOfLines + PacketSize - 1) / PacketSize;
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPTools::For(0, numPackets, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = tlCell.Local();
+    Segment segments[PacketSize];
+    PacketHits hits;
+    for (vtkIdType packet = begin; packet < end; ++packet)
+    {
+      const vtkIdType first = packet * PacketSize;
+      const int count = static_cast<int>(std::min<vtkIdType>(PacketSize, numberOfLines - first));
+      for (int r = 0; r < count; ++r)
+      {
+        segments[r].Initialize(p1s + 3 * (first + r), p2s + 3 * (first + r), tol);
+      }
+      this->IntersectPacket(locator, segments, count, tol, cell, hits);
+      for (int r = 0; r < count; ++r)
+      {
+        const vtkIdType line = first + r;
+        cellIds[line] = hits.CellId[r];
+        if (ts)
+        {
+          ts[line] = hits.CellId[r] < 0 ? 0.0 : hits.T[r];
+        }
+        if (xs && hits.CellId[r] >= 0)
+        {
+          std::copy(hits.X[r], hits.X[r] + 3, xs + 3 * line);
+        }
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// Visit the nodes by increasing distance, until they are farther than the
+// closest point found.
+vtkIdType BVHTree::FindClosestPointWithinRadius(vtkBVHCellLocator* locator, const double x[3],
+  double radius, double closestPoint[3], vtkGenericCell* cell, vtkIdType& closestCellId,
+  int& closestSubId, double& minDist2, int& inside) const
+{
+  vtkDataSet* dataSet = locator->DataSet;
+  std::vector<double> weights(dataSet->GetMaxCellSize());
+  double cellBounds[6], *cellBoundsPtr = cellBounds;
+  double pcoords[3], point[3], dist2;
+  int subId, stat;
+  vtkIdType retVal = 0;
+
+  using QueueEntry = std::pair<double, vtkIdType>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+  queue.emplace(Distance2ToBounds(x, this->Nodes[0].Bounds), 0);
+
+  // minimum squared distance to the closest point
+  minDist2 = radius * radius;
+  while (!queue.empty())
+  {
+    const QueueEntry top = queue.top();
+    // stop if the node is further away than the current closest point
+    if (top.first > minDist2)
+    {
+      break;
+    }
+    queue.pop();
+
+    const BVHNode& node = this->Nodes[top.second];
+    if (!node.IsLeaf())
+    {
+      for (int c = 0; c < 2; ++c)
+      {
+        const double nodeDist2 = Distance2ToBounds(x, this->Nodes[node.Offset + c].Bounds);
+        if (nodeDist2 <= minDist2)
+        {
+          queue.emplace(nodeDist2, node.Offset + c);
+        }
+      }
+      continue;
+    }
+    for (vtkIdType i = node.Offset; i < node.Offset + node.Count; ++i)
+    {
+      const vtkIdType cellId = this->CellIds[i];
+      locator->GetCellBounds(cellId, cellBoundsPtr);
+      // compute distance to cell only if distance to bounding box smaller than minDist2
+      if (Distance2ToBounds(x, cellBoundsPtr) < minDist2)
+      {
+        dataSet->GetCell(cellId, cell);
+        // stat==(-1) is numerical error; stat==0 means outside;
+        // stat=1 means inside.
+        stat = cell->EvaluatePosition(x, point, subId, pcoords, dist2, weights.data());
+        if (stat != -1 && dist2 < minDist2)
+        {
+          retVal = 1;
+          inside = stat;
+          minDist2 = dist2;
+          closestCellId = cellId;
+          closestSubId = subId;
+          std::copy(point, point + 3, closestPoint);
+        }
+      }
+    }
+  }
+  return retVal;
+}
+
+//------------------------------------------------------------------------------
+void BVHTree::FindCellsWithinBounds(
+  vtkBVHCellLocator* locator, const double bbox[6], vtkIdList* cells) const
+{
+  double cellBounds[6], *cellBoundsPtr = cellBounds;
+  std::vector<vtkIdType> stack(1, 0);
+  while (!stack.empty())
+  {
+    const BVHNode& node = this->Nodes[stack.back()];
+    stack.pop_back();
+    if (!Overlaps(node.Bounds, bbox))
+    {
+      continue;
+    }
+    if (!node.IsLeaf())
+    {
+      stack.push_back(node.Offset + 1);
+      stack.push_back(node.Offset);
+      continue;
+    }
+    for (vtkIdType i = node.Offset; i < node.Offset + node.Count; ++i)
+    {
+      const vtkIdType cellId = this->CellIds[i];
+      locator->GetCellBounds(cellId, cellBoundsPtr);
+      if (Overlaps(cellBoundsPtr, bbox))
+      {
+        cells->InsertNextId(cellId);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkIdType BVHTree::FindCell(vtkBVHCellLocator* locator, double pos[3], vtkGenericCell* cell,
+  int& subId, double pcoords[3], double* weights) const
+{
+  double dist2;
+  std::vector<vtkIdType> stack(1, 0);
+  while (!stack.empty())
+  {
+    const BVHNode& node = this->Nodes[stack.back()];
+    stack.pop_back();
+    if (!Contains(node.Bounds, pos))
+    {
+      continue;
+    }
+    if (!node.IsLeaf())
+    {
+      stack.push_back(node.Offset + 1);
+      stack.push_back(node.Offset);
+      continue;
+    }
+    for (vtkIdType i = node.Offset; i < node.Offset + node.Count; ++i)
+    {
+      const vtkIdType cellId = this->CellIds[i];
+      if (locator->InsideCellBounds(pos, cellId))
+      {
+        locator->DataSet->GetCell(cellId, cell);
+        if (cell->EvaluatePosition(pos, nullptr, subId, pcoords, dist2, weights) == 1)
+        {
+          return cellId;
+        }
+      }
+    }
+  }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+void BVHTree::GenerateRepresentation(int level, vtkPolyData* pd) const
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  vtkNew<vtkCellArray> lines;
+  pd->SetPoints(points);
+  pd->SetLines(lines);
+
+  std::vector<std::pair<vtkIdType, int>> stack(1, std::make_pair(vtkIdType(0), 0));
+  while (!stack.empty())
+  {
+    const BVHNode& node = this->Nodes[stack.back().first];
+    const int depth = stack.back().second;
+    stack.pop_back();
+    if (level == -1 ? node.IsLeaf() : depth == level)
+    {
+      AddBox(points, lines, node.Bounds);
+    }
+    else if (!node.IsLeaf())
+    {
+      stack.emplace_back(node.Offset + 1, depth + 1);
+      stack.emplace_back(node.Offset, depth + 1);
+    }
+  }
+}
+VTK_ABI_NAMESPACE_END
+} // namespace detail
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->NumberOfCellsPerNode = 8;
+  this->NumberOfBins = 16;
+}
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->FreeSearchStructure();
+  this->FreeCellBounds();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  this->Tree.reset();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  // don't rebuild if build time is newer than modified and dataset modified time
+  if (this->Tree && this->BuildTime > this->MTime && this->BuildTime > this->DataSet->GetMTime())
+  {
+    return;
+  }
+  // don't rebuild if UseExistingSearchStructure is ON and a search structure already exists
+  if (this->Tree && this->UseExistingSearchStructure)
+  {
+    this->BuildTime.Modified();
+    vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
+    return;
+  }
+  this->BuildLocatorInternal();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::ForceBuildLocator()
+{
+  this->BuildLocatorInternal();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocatorInternal()
+{
+  vtkIdType numCells;
+  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1)
+  {
+    vtkErrorMacro(<< " No Cells in the data set\n");
+    return;
+  }
+  // The nodes index the cells and the other nodes with 32-bit integers.
+  if (numCells >= VTK_INT_MAX / 2)
+  {
+    vtkErrorMacro(<< "Too many cells in the data set: " << numCells);
+    return;
+  }
+  this->FreeSearchStructure();
+  this->ComputeCellBounds();
+
+  auto tree = std::make_shared<detail::BVHTree>();
+  tree->Build(this);
+  this->Tree = tree;
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::RefitLocator()
+{
+  if (!this->Tree || !this->DataSet ||
+    this->DataSet->GetNumberOfCells() != static_cast<vtkIdType>(this->Tree->CellIds.size()))
+  {
+    this->BuildLocatorInternal();
+    return;
+  }
+  vtkDebugMacro(<< "Refitting BVH cell locator");
+  this->ComputeCellBounds();
+
+  // The hierarchy may be shared with shallow copies.
+  if (this->Tree.use_count() > 1)
+  {
+    this->Tree = std::make_shared<detail::BVHTree>(*this->Tree);
+  }
+  this->Tree->Refit(this);
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindCell(
+  double pos[3], double, vtkGenericCell* cell, int& subId, double pcoords[3], double* weights)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return -1;
+  }
+  return this->Tree->FindCell(this, pos, cell, subId, pcoords, weights);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindClosestPointWithinRadius(double x[3], double radius,
+  double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2,
+  int& inside)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  return this->Tree->FindClosestPointWithinRadius(
+    this, x, radius, closestPoint, cell, cellId, subId, dist2, inside);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsWithinBounds(double* bbox, vtkIdList* cells)
+{
+  if (!cells)
+  {
+    return;
+  }
+  cells->Reset();
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+  this->Tree->FindCellsWithinBounds(this, bbox, cells);
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+{
+  cellId = -1;
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  return this->Tree->IntersectWithLine(this, p1, p2, tol, t, x, pcoords, subId, cellId, cell);
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+  vtkPoints* points, vtkIdList* cellIds, vtkGenericCell* cell)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  return this->Tree->IntersectWithLine(this, p1, p2, tol, points, cellIds, cell);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::IntersectWithLines(vtkIdType numberOfLines, const double* p1s,
+  const double* p2s, double tol, vtkIdType* cellIds, double* ts, double* xs)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    std::fill(cellIds, cellIds + numberOfLines, -1);
+    return;
+  }
+  this->Tree->IntersectWithLines(this, numberOfLines, p1s, p2s, tol, cellIds, ts, xs);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData* pd)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+  this->Tree->GenerateRepresentation(level, pd);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::ShallowCopy(vtkAbstractCellLocator* locator)
+{
+  vtkBVHCellLocator* cellLocator = vtkBVHCellLocator::SafeDownCast(locator);
+  if (!cellLocator)
+  {
+    vtkErrorMacro("Cannot cast " << locator->GetClassName() << " to vtkBVHCellLocator.");
+    return;
+  }
+  // we only copy what's actually used by vtkBVHCellLocator
+
+  // vtkLocator parameters
+  this->SetUseExistingSearchStructure(cellLocator->GetUseExistingSearchStructure());
+
+  // vtkAbstractCellLocator parameters
+  this->SetNumberOfCellsPerNode(cellLocator->GetNumberOfCellsPerNode());
+  this->CacheCellBounds = cellLocator->CacheCellBounds;
+  this->CellBoundsSharedPtr = cellLocator->CellBoundsSharedPtr; // This is important
+  this->CellBounds = this->CellBoundsSharedPtr.get() ? this->CellBoundsSharedPtr->data() : nullptr;
+
+  // vtkBVHCellLocator parameters
+  this->NumberOfBins = cellLocator->NumberOfBins;
+  this->Tree = cellLocator->Tree;
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfBins: " << this->NumberOfBins << "\n";
+  os << indent << "NumberOfNodes: " << (this->Tree ? this->Tree->Nodes.size() : 0) << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,226 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkBVHCellLocator
+ * @brief   a cell locator based on a bounding volume hierarchy
+ *
+ * vtkBVHCellLocator is a cell locator organizing the bounding boxes of the
+ * cells in a binary bounding volume hierarchy (BVH). Each node of the
+ * hierarchy stores the bounds of its cells, so that the children of a node
+ * may overlap, and each cell is referenced by exactly one leaf. The hierarchy
+ * is built top-down with the binned surface area heuristic (SAH): the
+ * centroids of the cell bounds of a node are sorted in NumberOfBins bins
+ * along each axis, and the node is split at the bin boundary minimizing the
+ * sum over both children of their surface area times their number of cells.
+ * The nodes of each level of the hierarchy are split in parallel, and the
+ * large nodes are binned and partitioned in parallel, so that the build
+ * scales with the number of threads. The hierarchy does not depend on the
+ * number of threads.
+ *
+ * The nodes are stored in a compact layout of 32 bytes, with single precision
+ * bounds rounded outwards, so that large hierarchies fit in the caches.
+ * Besides the queries of vtkAbstractCellLocator, IntersectWithLines()
+ * intersects a batch of line segments in parallel, traversing the hierarchy
+ * with packets of consecutive segments. Coherent segments, such as the rays
+ * of neighboring pixels or the lines of a probe, share most of their
+ * traversal.
+ *
+ * vtkBVHCellLocator utilizes the following parent class parameters:
+ * - NumberOfCellsPerNode        (default 8)
+ * - CacheCellBounds             (default true)
+ * - UseExistingSearchStructure  (default false)
+ *
+ * vtkBVHCellLocator does NOT utilize the following parameters:
+ * - Automatic
+ * - Level
+ * - MaxLevel
+ * - Tolerance
+ * - RetainCellLists
+ *
+ * @warning
+ * The number of cells of the data set must be smaller than VTK_INT_MAX / 2.
+ *
+ * @sa
+ * vtkAbstractCellLocator vtkCellLocator vtkStaticCellLocator vtkCellTreeLocator
+ * vtkModifiedBSPTree vtkOBBTree
+ */
+
+#ifndef vtkBVHCellLocator_h
+#define vtkBVHCellLocator_h
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkCommonDataModelModule.h" // For export macro
+
+#include <memory> // For shared_ptr
+
+namespace detail
+{
+VTK_ABI_NAMESPACE_BEGIN
+// Forward declaration for PIMPL
+struct BVHTree;
+VTK_ABI_NAMESPACE_END
+}
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONDATAMODEL_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+  friend struct detail::BVHTree;
+
+public:
+  ///@{
+  /**
+   * Standard methods to print and obtain type-related information.
+   */
+  vtkTypeMacro(vtkBVHCellLocator, vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  ///@}
+
+  /**
+   * Constructor sets the maximum number of cells in a leaf to 8 and the
+   * number of bins to 16.
+   */
+  static vtkBVHCellLocator* New();
+
+  ///@{
+  /**
+   * Set/Get the number of bins the centroids of the cells of a node are
+   * sorted in along each axis to evaluate the surface area heuristic. More
+   * bins give a better hierarchy, at the cost of a slower build.
+   *
+   * Default is 16.
+   */
+  vtkSetClampMacro(NumberOfBins, int, 2, 256);
+  vtkGetMacro(NumberOfBins, int);
+  ///@}
+
+  // Re-use any superclass signatures that we don't override.
+  using vtkAbstractCellLocator::FindCell;
+  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
+  using vtkAbstractCellLocator::IntersectWithLine;
+
+  /**
+   * Return intersection point (if any) AND the cell which was intersected by
+   * the finite line. The cell is returned as a cell id and as a generic cell.
+   *
+   * For other IntersectWithLine signatures, see vtkAbstractCellLocator.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
+
+  /**
+   * Take the passed line segment and intersect it with the data set.
+   * The return value of the function is 0 if no intersections were found.
+   * For each intersection with the bounds of a cell or with a cell (if a cell is provided),
+   * the points and cellIds have the relevant information added sorted by t.
+   * If points or cellIds are nullptr pointers, then no information is generated for that list.
+   *
+   * For other IntersectWithLine signatures, see vtkAbstractCellLocator.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, vtkPoints* points,
+    vtkIdList* cellIds, vtkGenericCell* cell) override;
+
+  /**
+   * Intersect a batch of numberOfLines line segments with the data set, in
+   * parallel. The segments go from p1s[3*i] to p2s[3*i]. For each segment,
+   * cellIds[i] is set to the id of the closest intersected cell, or -1 if
+   * the segment does not intersect any cell, and if they are not nullptr,
+   * ts[i] and xs[3*i] are set to the parametric coordinate along the segment
+   * and to the position of the intersection. The results are the ones of
+   * IntersectWithLine() for each segment, up to the choice between cells
+   * intersected at the same parametric coordinate.
+   *
+   * Consecutive segments are traversed together, so the batch is faster
+   * when consecutive segments are close to each other.
+   */
+  void IntersectWithLines(vtkIdType numberOfLines, const double* p1s, const double* p2s,
+    double tol, vtkIdType* cellIds, double* ts = nullptr, double* xs = nullptr);
+
+  /**
+   * Return the closest point within a specified radius and the cell which is
+   * closest to the point x. The closest point is somewhere on a cell, it
+   * need not be one of the vertices of the cell. This method returns 1 if a
+   * point is found within the specified radius. If there are no cells within
+   * the specified radius, the method returns 0 and the values of
+   * closestPoint, cellId, subId, and dist2 are undefined. If a closest point
+   * is found, inside returns the return value of the EvaluatePosition call to
+   * the closest cell; inside(=1) or outside(=0).
+   *
+   * For other FindClosestPointWithinRadius signatures, see vtkAbstractCellLocator.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
+    vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside) override;
+
+  /**
+   * Return a list of unique cell ids inside of a given bounding box. The
+   * user must provide the vtkIdList to populate.
+   */
+  void FindCellsWithinBounds(double* bbox, vtkIdList* cells) override;
+
+  /**
+   * Take the passed line segment and intersect it with the data set.
+   * For each intersection with the bounds of a cell, the cellIds
+   * have the relevant information added sort by t. If cellIds is nullptr
+   * pointer, then no information is generated for that list.
+   *
+   * Reimplemented from vtkAbstractCellLocator to showcase that it's a supported function.
+   */
+  void FindCellsAlongLine(
+    const double p1[3], const double p2[3], double tolerance, vtkIdList* cellsIds) override
+  {
+    this->Superclass::FindCellsAlongLine(p1, p2, tolerance, cellsIds);
+  }
+
+  /**
+   * Find the cell containing a given point. returns -1 if no cell found
+   * the cell parameters are copied into the supplied variables, a cell must
+   * be provided to store the information.
+   */
+  vtkIdType FindCell(double pos[3], double vtkNotUsed(tol2), vtkGenericCell* cell, int& subId,
+    double pcoords[3], double* weights) override;
+
+  ///@{
+  /**
+   * Satisfy vtkLocator abstract interface.
+   *
+   * GenerateRepresentation() outputs the bounds of the nodes at the given
+   * level of the hierarchy, or of the leaves if level is -1.
+   */
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  void ForceBuildLocator() override;
+  void GenerateRepresentation(int level, vtkPolyData* pd) override;
+  ///@}
+
+  /**
+   * Update the hierarchy after the points of the data set moved, the cells
+   * being the same. The bounds of the nodes are recomputed from the bounds
+   * of their cells, in parallel, without splitting the nodes again. This is
+   * much faster than ForceBuildLocator(), but the hierarchy gets less
+   * efficient as the cells move away from their initial neighbors, so it
+   * should be rebuilt from time to time for large motions.
+   */
+  void RefitLocator() override;
+
+  /**
+   * Shallow copy of a vtkBVHCellLocator. The hierarchy is shared.
+   *
+   * Before you shallow copy, make sure to call SetDataSet()
+   */
+  void ShallowCopy(vtkAbstractCellLocator* locator) override;
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator() override;
+
+  void BuildLocatorInternal() override;
+
+  int NumberOfBins;
+  std::shared_ptr<detail::BVHTree> Tree;
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&) = delete;
+  void operator=(const vtkBVHCellLocator&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -531,6 +531,7 @@ bool vtkCellArray::DefaultStorageIs64Bit = true;
 #else
 bool vtkCellArray::DefaultStorageIs64Bit = false;
 #endif
+bool vtkCellArray::PreferSmallestStorage = false;
 
 //=================== Begin Legacy Methods ===================================
 // These should be deprecated at some point as they are confusing or very slow
@@ -1088,6 +1089,12 @@ bool vtkCellArray::ConvertToSmallestStorage()
   return true;
 }
 
+//------------------------------------------------------------------------------
+bool vtkCellArray::ConvertToPreferredStorage()
+{
+  return vtkCellArray::PreferSmallestStorage ? this->ConvertToSmallestStorage() : true;
+}
+
 //------------------------------------------------------------------------------
 bool vtkCellArray::AllocateExact(vtkIdType numCells, vtkIdType connectivitySize)
 {
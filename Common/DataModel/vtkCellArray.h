@@ -83,6 +83,7 @@
  * - `bool ConvertTo64BitStorage()`
  * - `bool ConvertToDefaultStorage() // Depends on vtkIdType`
  * - `bool ConvertToSmallestStorage() // Depends on current values in arrays`
+ * - `bool ConvertToPreferredStorage() // Depends on PreferSmallestStorage`
  *
  * Note that some legacy methods are still available that reflect the
  * previous storage format of this data, which embedded the cell sizes into
@@ -489,6 +490,17 @@ public:
   bool ConvertToSmallestStorage();
   /**@}*/
 
+  /**
+   * Convert to the smallest storage if GetPreferSmallestStorage() is true,
+   * leave the storage unchanged otherwise. Filters call this method on the
+   * cell arrays they generate.
+   *
+   * @return True on success, false on failure. The internal arrays are
+   * replaced by the conversion, so it must not be used on cell arrays sharing
+   * them with other cell arrays.
+   */
+  bool ConvertToPreferredStorage();
+
   /**
    * Return the array used to store cell offsets. The 32/64 variants are only
    * valid when IsStorage64Bit() returns the appropriate value.
@@ -1049,6 +1061,19 @@ public:
 
 #endif // __VTK_WRAP__
 
+  /**
+   * Control whether the filters generating cell arrays, such as vtkExtractCells,
+   * vtkThreshold and vtkGeometryFilter, convert them to 32-bit storage when
+   * all of their values fit (see ConvertToPreferredStorage()). This halves
+   * the memory used by the topology of meshes with less than 2^31 points and
+   * connectivity entries. This setting applies to the whole application and is
+   * off by default.
+   * @{
+   */
+  static bool GetPreferSmallestStorage() { return vtkCellArray::PreferSmallestStorage; }
+  static void SetPreferSmallestStorage(bool val) { vtkCellArray::PreferSmallestStorage = val; }
+  /** @} */
+
   //=================== Begin Legacy Methods ===================================
   // These should be deprecated at some point as they are confusing or very slow
 
@@ -1337,6 +1362,7 @@ protected:
   vtkNew<vtkIdTypeArray> LegacyData; // For GetData().
 
   static bool DefaultStorageIs64Bit;
+  static bool PreferSmallestStorage;
 
 private:
   vtkCellArray(const vtkCellArray&) = delete;
@@ -129,6 +129,19 @@ vtkIdType vtkCellLocatorStrategy::FindCell(double x[3], vtkCell* cell, vtkGeneri
   return this->CellLocator->FindCell(x, tol2, gencell, subId, pcoords, weights);
 }
 
+//------------------------------------------------------------------------------
+void vtkCellLocatorStrategy::FindCells(vtkPoints* points, double tol2, vtkIdList* cellIds,
+  vtkDoubleArray* pcoords, vtkDoubleArray* weights)
+{
+  if (!this->CellLocator)
+  {
+    // Reports the missing initialization.
+    this->Superclass::FindCells(points, tol2, cellIds, pcoords, weights);
+    return;
+  }
+  this->CellLocator->FindCells(points, cellIds, pcoords, weights);
+}
+
 //------------------------------------------------------------------------------
 vtkIdType vtkCellLocatorStrategy::FindClosestPointWithinRadius(double x[3], double radius,
   double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2,
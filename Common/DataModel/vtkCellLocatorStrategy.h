@@ -50,6 +50,15 @@ public:
   vtkIdType FindCell(double x[3], vtkCell* cell, vtkGenericCell* gencell, vtkIdType cellId,
     double tol2, int& subId, double pcoords[3], double* weights) override;
 
+  /**
+   * Find the cells containing a batch of points with
+   * vtkAbstractCellLocator::FindCells(), which the cell locators may
+   * specialize, e.g. to process the points in the order of their bins.
+   * As in FindCell(), tol2 is not used by the cell locators.
+   */
+  void FindCells(vtkPoints* points, double tol2, vtkIdList* cellIds,
+    vtkDoubleArray* pcoords = nullptr, vtkDoubleArray* weights = nullptr) override;
+
   /**
    * Implement the specific strategy.
    */
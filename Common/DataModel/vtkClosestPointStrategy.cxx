@@ -7,6 +7,8 @@
 #include "vtkIdList.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
 
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
@@ -364,6 +366,22 @@ vtkIdType vtkClosestPointStrategy::FindClosestPointWithinRadius(double x[3], dou
   return retVal;
 }
 
+//------------------------------------------------------------------------------
+void vtkClosestPointStrategy::FindCells(vtkPoints* points, double tol2, vtkIdList* cellIds,
+  vtkDoubleArray* pcoords, vtkDoubleArray* weights)
+{
+  // GetPointCells() builds the links on first use, which is not thread safe.
+  if (auto polyData = vtkPolyData::SafeDownCast(this->PointSet))
+  {
+    polyData->BuildLinks();
+  }
+  else if (auto unstructuredGrid = vtkUnstructuredGrid::SafeDownCast(this->PointSet))
+  {
+    unstructuredGrid->BuildLinks();
+  }
+  this->Superclass::FindCells(points, tol2, cellIds, pcoords, weights);
+}
+
 //------------------------------------------------------------------------------
 bool vtkClosestPointStrategy::InsideCellBounds(double x[3], vtkIdType cellId)
 {
@@ -63,6 +63,15 @@ public:
   vtkIdType FindCell(double x[3], vtkCell* cell, vtkGenericCell* gencell, vtkIdType cellId,
     double tol2, int& subId, double pcoords[3], double* weights) override;
 
+  /**
+   * Find the cells containing a batch of points, in parallel. The links of
+   * the point set are built first, since they are needed to walk through the
+   * neighbors of the cells. This method should only be called after the
+   * Initialize() method has been invoked.
+   */
+  void FindCells(vtkPoints* points, double tol2, vtkIdList* cellIds,
+    vtkDoubleArray* pcoords = nullptr, vtkDoubleArray* weights = nullptr) override;
+
   /**
    * Implement the specific strategy. This method should only be called
    * after the Initialize() method has been invoked.
@@ -2,8 +2,87 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkFindCellStrategy.h"
 
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkLogger.h"
+#include "vtkNew.h"
 #include "vtkPointSet.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// The hint of the previous point is reset at the start of each block of
+// points, so that the results do not depend on the number of threads.
+constexpr vtkIdType FindCellsBlockSize = 1024;
+
+//------------------------------------------------------------------------------
+// Find the cells of a batch of points with a copy of the strategy per thread.
+struct FindCellsFunctor
+{
+  vtkFindCellStrategy* Strategy;
+  vtkPointSet* PointSet;
+  vtkPoints* Points;
+  double Tol2;
+  vtkIdType* CellIds;
+  double* PCoords;
+  double* Weights;
+  int NumberOfWeights;
+
+  vtkSMPThreadLocal<vtkSmartPointer<vtkFindCellStrategy>> LocalStrategy;
+  vtkSMPThreadLocalObject<vtkGenericCell> LocalCell;
+  vtkSMPThreadLocalObject<vtkGenericCell> LocalLastCell;
+  vtkSMPThreadLocal<std::vector<double>> LocalWeights;
+
+  void Initialize()
+  {
+    vtkSmartPointer<vtkFindCellStrategy>& strategy = this->LocalStrategy.Local();
+    strategy.TakeReference(this->Strategy->NewInstance());
+    strategy->CopyParameters(this->Strategy);
+    strategy->Initialize(this->PointSet);
+    this->LocalWeights.Local().resize(this->NumberOfWeights);
+  }
+
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
+  {
+    vtkFindCellStrategy* strategy = this->LocalStrategy.Local();
+    vtkGenericCell* cell = this->LocalCell.Local();
+    vtkGenericCell* lastCell = this->LocalLastCell.Local();
+    double* localWeights = this->LocalWeights.Local().data();
+    const vtkIdType numPts = this->Points->GetNumberOfPoints();
+    double x[3], localPCoords[3];
+    int subId;
+
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      vtkIdType lastCellId = -1;
+      const vtkIdType end = std::min((block + 1) * FindCellsBlockSize, numPts);
+      for (vtkIdType ptId = block * FindCellsBlockSize; ptId < end; ++ptId)
+      {
+        this->Points->GetPoint(ptId, x);
+        double* pcoords = this->PCoords ? this->PCoords + 3 * ptId : localPCoords;
+        double* weights =
+          this->Weights ? this->Weights + this->NumberOfWeights * ptId : localWeights;
+        const vtkIdType cellId = strategy->FindCell(x, lastCellId >= 0 ? lastCell : nullptr, cell,
+          lastCellId, this->Tol2, subId, pcoords, weights);
+        if (cellId >= 0 && cellId != lastCellId)
+        {
+          this->PointSet->GetCell(cellId, lastCell);
+        }
+        this->CellIds[ptId] = lastCellId = cellId;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+}
 
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
@@ -34,6 +113,51 @@ int vtkFindCellStrategy::Initialize(vtkPointSet* ps)
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkFindCellStrategy::FindCells(vtkPoints* points, double tol2, vtkIdList* cellIds,
+  vtkDoubleArray* pcoords, vtkDoubleArray* weights)
+{
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  const int numWeights = this->PointSet ? std::max(this->PointSet->GetMaxCellSize(), 1) : 1;
+  cellIds->SetNumberOfIds(numPts);
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numPts);
+  }
+  if (weights)
+  {
+    weights->SetNumberOfComponents(numWeights);
+    weights->SetNumberOfTuples(numPts);
+  }
+  if (!this->PointSet)
+  {
+    vtkErrorMacro("FindCells must be called on an initialized strategy.");
+    std::fill_n(cellIds->GetPointer(0), numPts, -1);
+    return;
+  }
+
+  // make the point set API thread safe by calling it once in a single thread.
+  if (this->PointSet->GetNumberOfCells() > 0)
+  {
+    vtkNew<vtkGenericCell> cell;
+    this->PointSet->GetCellType(0);
+    this->PointSet->GetCell(0, cell);
+  }
+
+  FindCellsFunctor functor;
+  functor.Strategy = this;
+  functor.PointSet = this->PointSet;
+  functor.Points = points;
+  functor.Tol2 = tol2;
+  functor.CellIds = cellIds->GetPointer(0);
+  functor.PCoords = pcoords ? pcoords->GetPointer(0) : nullptr;
+  functor.Weights = weights ? weights->GetPointer(0) : nullptr;
+  functor.NumberOfWeights = numWeights;
+  const vtkIdType numBlocks = (numPts + FindCellsBlockSize - 1) / FindCellsBlockSize;
+  vtkSMPTools::For(0, numBlocks, 1, functor);
+}
+
 //------------------------------------------------------------------------------
 void vtkFindCellStrategy::CopyParameters(vtkFindCellStrategy* from)
 {
@@ -41,8 +41,11 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCell;
+class vtkDoubleArray;
 class vtkGenericCell;
+class vtkIdList;
 class vtkPointSet;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkFindCellStrategy : public vtkObject
 {
@@ -75,6 +78,24 @@ public:
   virtual vtkIdType FindCell(double x[3], vtkCell* cell, vtkGenericCell* gencell, vtkIdType cellId,
     double tol2, int& subId, double pcoords[3], double* weights) = 0;
 
+  /**
+   * Find the cells containing a batch of points, in parallel, as FindCell()
+   * would without a starting cell. cellIds is resized to the number of
+   * points and receives -1 for the points outside of any cell. If pcoords
+   * (resp. weights) is not nullptr, it is resized to 3 (resp. the
+   * maximum cell size of the point set) components per point and receives the
+   * parametric coordinates (resp. the interpolation weights) in the found
+   * cells. The strategy must be initialized.
+   *
+   * The default implementation runs a copy of this strategy per thread, see
+   * CopyParameters(), and tries the cell found for the previous point of a
+   * block of points before searching, so that coherent points, such as the
+   * points of a probe, are found faster. The blocks do not depend on the
+   * number of threads, and neither do the results.
+   */
+  virtual void FindCells(vtkPoints* points, double tol2, vtkIdList* cellIds,
+    vtkDoubleArray* pcoords = nullptr, vtkDoubleArray* weights = nullptr);
+
   /**
    * Return the closest point within a specified radius and the cell which is
    * closest to the point x. The closest point is somewhere on a cell, it
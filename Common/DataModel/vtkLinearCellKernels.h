@@ -0,0 +1,761 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @file   vtkLinearCellKernels.h
+ * @brief  header-only, non-virtual computations on linear cells
+ *
+ * vtkLinearCellKernels gathers the computations of the linear cells
+ * (VTK_TETRA, VTK_HEXAHEDRON, VTK_WEDGE, VTK_PYRAMID, VTK_TRIANGLE and
+ * VTK_QUAD) as inline templates: interpolation functions and their
+ * derivatives, parametric centers, parametric inside tests, derivatives of
+ * point values, and parametric coordinates of positions. They use the same
+ * point ordering and parametric coordinates as vtkTetra, vtkHexahedron,
+ * vtkWedge, vtkPyramid, vtkTriangle and vtkQuad.
+ *
+ * The kernels work on the cell point coordinates stored contiguously (x0,
+ * y0, z0, x1, ...), which GatherPoints() extracts from a point array range
+ * and the point ids of a cell (e.g. from vtkCellArray::GetCellAtId()). Hot
+ * loops over the cells of a mesh can then avoid vtkDataSet::GetCell(),
+ * which copies the points and ids into a vtkGenericCell and calls virtual
+ * methods on it:
+ *
+ * @code
+ * auto points = vtk::DataArrayTupleRange<3>(grid->GetPoints()->GetData());
+ * grid->GetCells()->GetCellAtId(cellId, npts, pts, ids);
+ * double x[3 * vtkLinearCellKernels::MaximumNumberOfPoints], pcoords[3];
+ * vtkLinearCellKernels::GatherPoints(points, npts, pts, x);
+ * vtkLinearCellKernels::ParametricCenter<VTK_HEXAHEDRON>(pcoords);
+ * vtkLinearCellKernels::Derivatives<VTK_HEXAHEDRON>(x, pcoords, values, 1, derivs);
+ * @endcode
+ *
+ * Each kernel also exists with the cell type given at run time as first
+ * argument, returning false for the unsupported cell types so that callers
+ * can fall back on vtkCell.
+ *
+ * The derivatives of the 2D cells are the derivatives in the tangent plane
+ * of the cell at the given parametric coordinates, which matches vtkTriangle
+ * and vtkQuad for planar cells.
+ *
+ * @sa
+ * vtkCell vtkCellArray vtkCellDerivatives
+ */
+
+#ifndef vtkLinearCellKernels_h
+#define vtkLinearCellKernels_h
+
+#include "vtkABINamespace.h"
+#include "vtkCellType.h"
+#include "vtkType.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace vtkLinearCellKernels
+{
+/**
+ * The largest number of points of the supported cells.
+ */
+constexpr int MaximumNumberOfPoints = 8;
+
+/**
+ * The number of points and the parametric dimension of the supported cells.
+ */
+template <int CellType>
+struct CellTraits;
+
+template <>
+struct CellTraits<VTK_TETRA>
+{
+  static constexpr int NumberOfPoints = 4;
+  static constexpr int Dimension = 3;
+};
+
+template <>
+struct CellTraits<VTK_HEXAHEDRON>
+{
+  static constexpr int NumberOfPoints = 8;
+  static constexpr int Dimension = 3;
+};
+
+template <>
+struct CellTraits<VTK_WEDGE>
+{
+  static constexpr int NumberOfPoints = 6;
+  static constexpr int Dimension = 3;
+};
+
+template <>
+struct CellTraits<VTK_PYRAMID>
+{
+  static constexpr int NumberOfPoints = 5;
+  static constexpr int Dimension = 3;
+};
+
+template <>
+struct CellTraits<VTK_TRIANGLE>
+{
+  static constexpr int NumberOfPoints = 3;
+  static constexpr int Dimension = 2;
+};
+
+template <>
+struct CellTraits<VTK_QUAD>
+{
+  static constexpr int NumberOfPoints = 4;
+  static constexpr int Dimension = 2;
+};
+
+/**
+ * Return whether the kernels support the cell type.
+ */
+inline bool IsSupported(int cellType)
+{
+  return cellType == VTK_TETRA || cellType == VTK_HEXAHEDRON || cellType == VTK_WEDGE ||
+    cellType == VTK_PYRAMID || cellType == VTK_TRIANGLE || cellType == VTK_QUAD;
+}
+
+/**
+ * Copy the coordinates of the points ptIds of a point array range (e.g.
+ * vtk::DataArrayTupleRange<3>) contiguously into x, which must hold 3 * npts
+ * values.
+ */
+template <typename PointsRange>
+void GatherPoints(const PointsRange& points, vtkIdType npts, const vtkIdType* ptIds, double* x)
+{
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    const auto point = points[ptIds[i]];
+    x[3 * i] = static_cast<double>(point[0]);
+    x[3 * i + 1] = static_cast<double>(point[1]);
+    x[3 * i + 2] = static_cast<double>(point[2]);
+  }
+}
+
+///@{
+/**
+ * Compute the parametric center of the cell.
+ */
+template <int CellType>
+void ParametricCenter(double pcoords[3]);
+
+template <>
+inline void ParametricCenter<VTK_TETRA>(double pcoords[3])
+{
+  pcoords[0] = pcoords[1] = pcoords[2] = 0.25;
+}
+
+template <>
+inline void ParametricCenter<VTK_HEXAHEDRON>(double pcoords[3])
+{
+  pcoords[0] = pcoords[1] = pcoords[2] = 0.5;
+}
+
+template <>
+inline void ParametricCenter<VTK_WEDGE>(double pcoords[3])
+{
+  pcoords[0] = pcoords[1] = 0.333333;
+  pcoords[2] = 0.5;
+}
+
+template <>
+inline void ParametricCenter<VTK_PYRAMID>(double pcoords[3])
+{
+  pcoords[0] = pcoords[1] = 0.4;
+  pcoords[2] = 0.2;
+}
+
+template <>
+inline void ParametricCenter<VTK_TRIANGLE>(double pcoords[3])
+{
+  pcoords[0] = pcoords[1] = 1.0 / 3.0;
+  pcoords[2] = 0.0;
+}
+
+template <>
+inline void ParametricCenter<VTK_QUAD>(double pcoords[3])
+{
+  pcoords[0] = pcoords[1] = 0.5;
+  pcoords[2] = 0.0;
+}
+///@}
+
+///@{
+/**
+ * Return whether the parametric coordinates are inside the cell, within the
+ * parametric tolerance.
+ */
+template <int CellType>
+bool IsInside(const double pcoords[3], double tolerance);
+
+template <>
+inline bool IsInside<VTK_TETRA>(const double pcoords[3], double tolerance)
+{
+  return pcoords[0] >= -tolerance && pcoords[1] >= -tolerance && pcoords[2] >= -tolerance &&
+    pcoords[0] + pcoords[1] + pcoords[2] <= 1.0 + tolerance;
+}
+
+template <>
+inline bool IsInside<VTK_HEXAHEDRON>(const double pcoords[3], double tolerance)
+{
+  return pcoords[0] >= -tolerance && pcoords[0] <= 1.0 + tolerance && pcoords[1] >= -tolerance &&
+    pcoords[1] <= 1.0 + tolerance && pcoords[2] >= -tolerance && pcoords[2] <= 1.0 + tolerance;
+}
+
+template <>
+inline bool IsInside<VTK_WEDGE>(const double pcoords[3], double tolerance)
+{
+  return pcoords[0] >= -tolerance && pcoords[1] >= -tolerance &&
+    pcoords[0] + pcoords[1] <= 1.0 + tolerance && pcoords[2] >= -tolerance &&
+    pcoords[2] <= 1.0 + tolerance;
+}
+
+template <>
+inline bool IsInside<VTK_PYRAMID>(const double pcoords[3], double tolerance)
+{
+  return IsInside<VTK_HEXAHEDRON>(pcoords, tolerance);
+}
+
+template <>
+inline bool IsInside<VTK_TRIANGLE>(const double pcoords[3], double tolerance)
+{
+  return pcoords[0] >= -tolerance && pcoords[1] >= -tolerance &&
+    pcoords[0] + pcoords[1] <= 1.0 + tolerance;
+}
+
+template <>
+inline bool IsInside<VTK_QUAD>(const double pcoords[3], double tolerance)
+{
+  return pcoords[0] >= -tolerance && pcoords[0] <= 1.0 + tolerance && pcoords[1] >= -tolerance &&
+    pcoords[1] <= 1.0 + tolerance;
+}
+///@}
+
+///@{
+/**
+ * Compute the interpolation functions (aka shape functions) of the cell at
+ * the parametric coordinates, one weight per cell point.
+ */
+template <int CellType>
+void InterpolationFunctions(const double pcoords[3], double* weights);
+
+template <>
+inline void InterpolationFunctions<VTK_TETRA>(const double pcoords[3], double* weights)
+{
+  weights[0] = 1.0 - pcoords[0] - pcoords[1] - pcoords[2];
+  weights[1] = pcoords[0];
+  weights[2] = pcoords[1];
+  weights[3] = pcoords[2];
+}
+
+template <>
+inline void InterpolationFunctions<VTK_HEXAHEDRON>(const double pcoords[3], double* weights)
+{
+  const double rm = 1.0 - pcoords[0];
+  const double sm = 1.0 - pcoords[1];
+  const double tm = 1.0 - pcoords[2];
+  weights[0] = rm * sm * tm;
+  weights[1] = pcoords[0] * sm * tm;
+  weights[2] = pcoords[0] * pcoords[1] * tm;
+  weights[3] = rm * pcoords[1] * tm;
+  weights[4] = rm * sm * pcoords[2];
+  weights[5] = pcoords[0] * sm * pcoords[2];
+  weights[6] = pcoords[0] * pcoords[1] * pcoords[2];
+  weights[7] = rm * pcoords[1] * pcoords[2];
+}
+
+template <>
+inline void InterpolationFunctions<VTK_WEDGE>(const double pcoords[3], double* weights)
+{
+  const double u = 1.0 - pcoords[0] - pcoords[1];
+  const double tm = 1.0 - pcoords[2];
+  weights[0] = u * tm;
+  weights[1] = pcoords[0] * tm;
+  weights[2] = pcoords[1] * tm;
+  weights[3] = u * pcoords[2];
+  weights[4] = pcoords[0] * pcoords[2];
+  weights[5] = pcoords[1] * pcoords[2];
+}
+
+template <>
+inline void InterpolationFunctions<VTK_PYRAMID>(const double pcoords[3], double* weights)
+{
+  const double rm = 1.0 - pcoords[0];
+  const double sm = 1.0 - pcoords[1];
+  const double tm = 1.0 - pcoords[2];
+  weights[0] = rm * sm * tm;
+  weights[1] = pcoords[0] * sm * tm;
+  weights[2] = pcoords[0] * pcoords[1] * tm;
+  weights[3] = rm * pcoords[1] * tm;
+  weights[4] = pcoords[2];
+}
+
+template <>
+inline void InterpolationFunctions<VTK_TRIANGLE>(const double pcoords[3], double* weights)
+{
+  weights[0] = 1.0 - pcoords[0] - pcoords[1];
+  weights[1] = pcoords[0];
+  weights[2] = pcoords[1];
+}
+
+template <>
+inline void InterpolationFunctions<VTK_QUAD>(const double pcoords[3], double* weights)
+{
+  const double rm = 1.0 - pcoords[0];
+  const double sm = 1.0 - pcoords[1];
+  weights[0] = rm * sm;
+  weights[1] = pcoords[0] * sm;
+  weights[2] = pcoords[0] * pcoords[1];
+  weights[3] = rm * pcoords[1];
+}
+///@}
+
+///@{
+/**
+ * Compute the derivatives of the interpolation functions of the cell with
+ * respect to the parametric coordinates: the r-derivatives of all the points
+ * first, then the s-derivatives, then (for 3D cells) the t-derivatives.
+ */
+template <int CellType>
+void InterpolationDerivatives(const double pcoords[3], double* derivs);
+
+template <>
+inline void InterpolationDerivatives<VTK_TETRA>(const double*, double* derivs)
+{
+  const double d[12] = { -1.0, 1.0, 0.0, 0.0, -1.0, 0.0, 1.0, 0.0, -1.0, 0.0, 0.0, 1.0 };
+  for (int i = 0; i < 12; ++i)
+  {
+    derivs[i] = d[i];
+  }
+}
+
+template <>
+inline void InterpolationDerivatives<VTK_HEXAHEDRON>(const double pcoords[3], double* derivs)
+{
+  const double rm = 1.0 - pcoords[0];
+  const double sm = 1.0 - pcoords[1];
+  const double tm = 1.0 - pcoords[2];
+
+  // r-derivatives
+  derivs[0] = -sm * tm;
+  derivs[1] = sm * tm;
+  derivs[2] = pcoords[1] * tm;
+  derivs[3] = -pcoords[1] * tm;
+  derivs[4] = -sm * pcoords[2];
+  derivs[5] = sm * pcoords[2];
+  derivs[6] = pcoords[1] * pcoords[2];
+  derivs[7] = -pcoords[1] * pcoords[2];
+
+  // s-derivatives
+  derivs[8] = -rm * tm;
+  derivs[9] = -pcoords[0] * tm;
+  derivs[10] = pcoords[0] * tm;
+  derivs[11] = rm * tm;
+  derivs[12] = -rm * pcoords[2];
+  derivs[13] = -pcoords[0] * pcoords[2];
+  derivs[14] = pcoords[0] * pcoords[2];
+  derivs[15] = rm * pcoords[2];
+
+  // t-derivatives
+  derivs[16] = -rm * sm;
+  derivs[17] = -pcoords[0] * sm;
+  derivs[18] = -pcoords[0] * pcoords[1];
+  derivs[19] = -rm * pcoords[1];
+  derivs[20] = rm * sm;
+  derivs[21] = pcoords[0] * sm;
+  derivs[22] = pcoords[0] * pcoords[1];
+  derivs[23] = rm * pcoords[1];
+}
+
+template <>
+inline void InterpolationDerivatives<VTK_WEDGE>(const double pcoords[3], double* derivs)
+{
+  // r-derivatives
+  derivs[0] = -1.0 + pcoords[2];
+  derivs[1] = 1.0 - pcoords[2];
+  derivs[2] = 0.0;
+  derivs[3] = -pcoords[2];
+  derivs[4] = pcoords[2];
+  derivs[5] = 0.0;
+
+  // s-derivatives
+  derivs[6] = -1.0 + pcoords[2];
+  derivs[7] = 0.0;
+  derivs[8] = 1.0 - pcoords[2];
+  derivs[9] = -pcoords[2];
+  derivs[10] = 0.0;
+  derivs[11] = pcoords[2];
+
+  // t-derivatives
+  derivs[12] = -1.0 + pcoords[0] + pcoords[1];
+  derivs[13] = -pcoords[0];
+  derivs[14] = -pcoords[1];
+  derivs[15] = 1.0 - pcoords[0] - pcoords[1];
+  derivs[16] = pcoords[0];
+  derivs[17] = pcoords[1];
+}
+
+template <>
+inline void InterpolationDerivatives<VTK_PYRAMID>(const double pcoords[3], double* derivs)
+{
+  const double rm = 1.0 - pcoords[0];
+  const double sm = 1.0 - pcoords[1];
+  const double tm = 1.0 - pcoords[2];
+
+  // r-derivatives
+  derivs[0] = -sm * tm;
+  derivs[1] = sm * tm;
+  derivs[2] = pcoords[1] * tm;
+  derivs[3] = -pcoords[1] * tm;
+  derivs[4] = 0.0;
+
+  // s-derivatives
+  derivs[5] = -rm * tm;
+  derivs[6] = -pcoords[0] * tm;
+  derivs[7] = pcoords[0] * tm;
+  derivs[8] = rm * tm;
+  derivs[9] = 0.0;
+
+  // t-derivatives
+  derivs[10] = -rm * sm;
+  derivs[11] = -pcoords[0] * sm;
+  derivs[12] = -pcoords[0] * pcoords[1];
+  derivs[13] = -rm * pcoords[1];
+  derivs[14] = 1.0;
+}
+
+template <>
+inline void InterpolationDerivatives<VTK_TRIANGLE>(const double*, double* derivs)
+{
+  derivs[0] = -1.0;
+  derivs[1] = 1.0;
+  derivs[2] = 0.0;
+  derivs[3] = -1.0;
+  derivs[4] = 0.0;
+  derivs[5] = 1.0;
+}
+
+template <>
+inline void InterpolationDerivatives<VTK_QUAD>(const double pcoords[3], double* derivs)
+{
+  // r-derivatives
+  derivs[0] = -1.0 + pcoords[1];
+  derivs[1] = 1.0 - pcoords[1];
+  derivs[2] = pcoords[1];
+  derivs[3] = -pcoords[1];
+
+  // s-derivatives
+  derivs[4] = -1.0 + pcoords[0];
+  derivs[5] = -pcoords[0];
+  derivs[6] = pcoords[0];
+  derivs[7] = 1.0 - pcoords[0];
+}
+///@}
+
+/**
+ * Compute the derivatives of the parametric coordinates with respect to x,
+ * y and z (inverse[j][a] is the derivative of the parametric coordinate a
+ * with respect to x_j), given the cell points x and the derivatives of the
+ * interpolation functions. For 2D cells, this is the pseudo-inverse of the
+ * Jacobian, i.e. the derivatives in the tangent plane of the cell. Return
+ * false if the cell is degenerate.
+ */
+template <int CellType>
+bool JacobianInverse(const double* x, const double* functionDerivs, double inverse[3][3])
+{
+  const int numPts = CellTraits<CellType>::NumberOfPoints;
+  const int dim = CellTraits<CellType>::Dimension;
+
+  // The rows of m are the derivatives of the position with respect to the
+  // parametric coordinates.
+  double m[3][3];
+  for (int a = 0; a < dim; ++a)
+  {
+    m[a][0] = m[a][1] = m[a][2] = 0.0;
+    for (int i = 0; i < numPts; ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        m[a][j] += functionDerivs[a * numPts + i] * x[3 * i + j];
+      }
+    }
+  }
+
+  if (dim == 3)
+  {
+    const double c[3][3] = { { m[1][1] * m[2][2] - m[1][2] * m[2][1],
+                               m[1][2] * m[2][0] - m[1][0] * m[2][2],
+                               m[1][0] * m[2][1] - m[1][1] * m[2][0] },
+      { m[0][2] * m[2][1] - m[0][1] * m[2][2], m[0][0] * m[2][2] - m[0][2] * m[2][0],
+        m[0][1] * m[2][0] - m[0][0] * m[2][1] },
+      { m[0][1] * m[1][2] - m[0][2] * m[1][1], m[0][2] * m[1][0] - m[0][0] * m[1][2],
+        m[0][0] * m[1][1] - m[0][1] * m[1][0] } };
+    const double det = m[0][0] * c[0][0] + m[0][1] * c[0][1] + m[0][2] * c[0][2];
+    if (det == 0.0 || !std::isfinite(det))
+    {
+      return false;
+    }
+    for (int j = 0; j < 3; ++j)
+    {
+      for (int a = 0; a < 3; ++a)
+      {
+        inverse[j][a] = c[a][j] / det;
+      }
+    }
+    return true;
+  }
+
+  const double g00 = m[0][0] * m[0][0] + m[0][1] * m[0][1] + m[0][2] * m[0][2];
+  const double g01 = m[0][0] * m[1][0] + m[0][1] * m[1][1] + m[0][2] * m[1][2];
+  const double g11 = m[1][0] * m[1][0] + m[1][1] * m[1][1] + m[1][2] * m[1][2];
+  const double det = g00 * g11 - g01 * g01;
+  if (det <= 0.0 || !std::isfinite(det))
+  {
+    return false;
+  }
+  for (int j = 0; j < 3; ++j)
+  {
+    inverse[j][0] = (m[0][j] * g11 - m[1][j] * g01) / det;
+    inverse[j][1] = (m[1][j] * g00 - m[0][j] * g01) / det;
+    inverse[j][2] = 0.0;
+  }
+  return true;
+}
+
+/**
+ * Compute the derivatives of the interpolation functions with respect to x,
+ * y and z at the parametric coordinates, given the cell points x: the
+ * x-derivatives of all the points first, then the y- and the z-derivatives.
+ * Return false, with zero derivatives, if the cell is degenerate there.
+ */
+template <int CellType>
+bool SpatialInterpolationDerivatives(const double* x, const double pcoords[3], double* derivs)
+{
+  const int numPts = CellTraits<CellType>::NumberOfPoints;
+  const int dim = CellTraits<CellType>::Dimension;
+  double functionDerivs[3 * MaximumNumberOfPoints];
+  InterpolationDerivatives<CellType>(pcoords, functionDerivs);
+  double inverse[3][3];
+  if (!JacobianInverse<CellType>(x, functionDerivs, inverse))
+  {
+    for (int i = 0; i < 3 * numPts; ++i)
+    {
+      derivs[i] = 0.0;
+    }
+    return false;
+  }
+
+  for (int j = 0; j < 3; ++j)
+  {
+    for (int i = 0; i < numPts; ++i)
+    {
+      double sum = 0.0;
+      for (int a = 0; a < dim; ++a)
+      {
+        sum += inverse[j][a] * functionDerivs[a * numPts + i];
+      }
+      derivs[j * numPts + i] = sum;
+    }
+  }
+  return true;
+}
+
+/**
+ * Compute the derivatives of the point values of the cell (dim values per
+ * point) at the parametric coordinates, given the cell points x, with the
+ * layout of vtkCell::Derivatives(): derivs[3 * k + j] is the derivative of
+ * the value k with respect to x_j. Return false, with zero derivatives, if
+ * the cell is degenerate there.
+ */
+template <int CellType>
+bool Derivatives(
+  const double* x, const double pcoords[3], const double* values, int dim, double* derivs)
+{
+  const int numPts = CellTraits<CellType>::NumberOfPoints;
+  if (CellType == VTK_PYRAMID && pcoords[2] > 0.999)
+  {
+    // The Jacobian vanishes at the apex of pyramids: extrapolate linearly
+    // the derivatives below it, as vtkPyramid does.
+    const double pcoords1[3] = { 0.5, 0.5, 2.0 * 0.998 - pcoords[2] };
+    const double pcoords2[3] = { 0.5, 0.5, 0.998 };
+    std::vector<double> derivs1(3 * dim);
+    const bool valid1 = Derivatives<CellType>(x, pcoords1, values, dim, derivs1.data());
+    const bool valid2 = Derivatives<CellType>(x, pcoords2, values, dim, derivs);
+    for (int i = 0; i < 3 * dim; ++i)
+    {
+      derivs[i] = 2.0 * derivs[i] - derivs1[i];
+    }
+    return valid1 && valid2;
+  }
+
+  double spatialDerivs[3 * MaximumNumberOfPoints];
+  const bool valid = SpatialInterpolationDerivatives<CellType>(x, pcoords, spatialDerivs);
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      double sum = 0.0;
+      for (int i = 0; i < numPts; ++i)
+      {
+        sum += spatialDerivs[j * numPts + i] * values[dim * i + k];
+      }
+      derivs[3 * k + j] = sum;
+    }
+  }
+  return valid;
+}
+
+/**
+ * Compute the parametric coordinates and the interpolation weights of the
+ * position p in the cell given by its points x with a Newton iteration (for
+ * 2D cells, of the projection of p onto the cell surface). Return false if
+ * the iteration does not converge. Combine with IsInside() to find whether
+ * p is inside the cell.
+ */
+template <int CellType>
+bool ParametricCoordinates(const double* x, const double p[3], double pcoords[3], double* weights)
+{
+  const int numPts = CellTraits<CellType>::NumberOfPoints;
+  const int dim = CellTraits<CellType>::Dimension;
+  const int maxIterations = 20;
+  ParametricCenter<CellType>(pcoords);
+  for (int iteration = 0; iteration < maxIterations; ++iteration)
+  {
+    InterpolationFunctions<CellType>(pcoords, weights);
+    double residual[3] = { -p[0], -p[1], -p[2] };
+    for (int i = 0; i < numPts; ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        residual[j] += weights[i] * x[3 * i + j];
+      }
+    }
+
+    // Newton step (Gauss-Newton for 2D cells).
+    double functionDerivs[3 * MaximumNumberOfPoints];
+    InterpolationDerivatives<CellType>(pcoords, functionDerivs);
+    double inverse[3][3];
+    if (!JacobianInverse<CellType>(x, functionDerivs, inverse))
+    {
+      return false;
+    }
+    double step = 0.0;
+    for (int a = 0; a < dim; ++a)
+    {
+      const double delta =
+        inverse[0][a] * residual[0] + inverse[1][a] * residual[1] + inverse[2][a] * residual[2];
+      pcoords[a] -= delta;
+      step = std::max(step, std::abs(delta));
+    }
+    if (!std::isfinite(step))
+    {
+      return false;
+    }
+    if (step < 1.0e-12)
+    {
+      InterpolationFunctions<CellType>(pcoords, weights);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Call the kernel in __VA_ARGS__ with CellT defined as the cell type.
+#define vtkLinearCellKernelsDispatchMacro(cellType, ...)                                          \
+  switch (cellType)                                                                                \
+  {                                                                                                \
+    case VTK_TETRA:                                                                                \
+    {                                                                                              \
+      constexpr int CellT = VTK_TETRA;                                                             \
+      __VA_ARGS__;                                                                                 \
+    }                                                                                              \
+    case VTK_HEXAHEDRON:                                                                           \
+    {                                                                                              \
+      constexpr int CellT = VTK_HEXAHEDRON;                                                        \
+      __VA_ARGS__;                                                                                 \
+    }                                                                                              \
+    case VTK_WEDGE:                                                                                \
+    {                                                                                              \
+      constexpr int CellT = VTK_WEDGE;                                                             \
+      __VA_ARGS__;                                                                                 \
+    }                                                                                              \
+    case VTK_PYRAMID:                                                                              \
+    {                                                                                              \
+      constexpr int CellT = VTK_PYRAMID;                                                           \
+      __VA_ARGS__;                                                                                 \
+    }                                                                                              \
+    case VTK_TRIANGLE:                                                                             \
+    {                                                                                              \
+      constexpr int CellT = VTK_TRIANGLE;                                                          \
+      __VA_ARGS__;                                                                                 \
+    }                                                                                              \
+    case VTK_QUAD:                                                                                 \
+    {                                                                                              \
+      constexpr int CellT = VTK_QUAD;                                                              \
+      __VA_ARGS__;                                                                                 \
+    }                                                                                              \
+    default:                                                                                       \
+      break;                                                                                       \
+  }
+
+///@{
+/**
+ * The kernels with the cell type given at run time. They return false (or
+ * 0 points) for the unsupported cell types.
+ */
+inline int NumberOfPoints(int cellType)
+{
+  vtkLinearCellKernelsDispatchMacro(cellType, return CellTraits<CellT>::NumberOfPoints);
+  return 0;
+}
+
+inline bool ParametricCenter(int cellType, double pcoords[3])
+{
+  vtkLinearCellKernelsDispatchMacro(cellType, ParametricCenter<CellT>(pcoords); return true);
+  return false;
+}
+
+inline bool IsInside(int cellType, const double pcoords[3], double tolerance)
+{
+  vtkLinearCellKernelsDispatchMacro(cellType, return IsInside<CellT>(pcoords, tolerance));
+  return false;
+}
+
+inline bool InterpolationFunctions(int cellType, const double pcoords[3], double* weights)
+{
+  vtkLinearCellKernelsDispatchMacro(
+    cellType, InterpolationFunctions<CellT>(pcoords, weights); return true);
+  return false;
+}
+
+inline bool InterpolationDerivatives(int cellType, const double pcoords[3], double* derivs)
+{
+  vtkLinearCellKernelsDispatchMacro(
+    cellType, InterpolationDerivatives<CellT>(pcoords, derivs); return true);
+  return false;
+}
+
+inline bool Derivatives(int cellType, const double* x, const double pcoords[3],
+  const double* values, int dim, double* derivs)
+{
+  vtkLinearCellKernelsDispatchMacro(
+    cellType, return Derivatives<CellT>(x, pcoords, values, dim, derivs));
+  return false;
+}
+
+inline bool ParametricCoordinates(
+  int cellType, const double* x, const double p[3], double pcoords[3], double* weights)
+{
+  vtkLinearCellKernelsDispatchMacro(
+    cellType, return ParametricCoordinates<CellT>(x, p, pcoords, weights));
+  return false;
+}
+///@}
+
+#undef vtkLinearCellKernelsDispatchMacro
+} // namespace vtkLinearCellKernels
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkLinearCellKernels_h
+// VTK-HeaderTest-Exclude: vtkLinearCellKernels.h
@@ -349,6 +349,15 @@ protected:
    */
   bool ComputeFiniteVectorRange(double range[2]) override;
 
+  /**
+   * Ranges are computed from the original array by the methods above, not with
+   * a pass over the transformed tuples.
+   */
+  bool ComputeFusedRanges(vtkIdType, vtkIdType, double*, double*, double[2], double[2]) override
+  {
+    return false;
+  }
+
   /**
    * Update the transformed periodic range
    */
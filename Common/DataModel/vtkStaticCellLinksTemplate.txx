@@ -12,6 +12,7 @@
 #include "vtkPolyData.h"
 #include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
+#include <algorithm>
 #include <array>
 #include <atomic>
 
@@ -416,16 +417,42 @@ void vtkStaticCellLinksTemplate<TIds>::ThreadedBuildLinksFromMultipleArrays(
     vtkSMPTools::For(0, cellArrays[i]->GetNumberOfCells(), count);
   }
 
-  // Perform prefix sum to determine offsets
-  vtkIdType ptId, npts;
+  // Perform prefix sum to determine offsets. The points are split in blocks
+  // whose sums are computed in parallel, then the blocks are scanned in
+  // parallel starting from the serial prefix sum of the block sums.
   this->OffsetsSharedPtr.reset(new TIds[numPts + 1], std::default_delete<TIds[]>());
   this->Offsets = this->OffsetsSharedPtr.get();
-  this->Offsets[0] = 0;
-  for (ptId = 1; ptId < numPts; ++ptId)
+  const vtkIdType blockSize = 65536;
+  const vtkIdType numBlocks = (numPts + blockSize - 1) / blockSize;
+  std::vector<TIds> blockOffsets(numBlocks + 1, 0);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+    for (; block < endBlock; ++block)
+    {
+      const vtkIdType endPtId = std::min(numPts, (block + 1) * blockSize);
+      TIds sum = 0;
+      for (vtkIdType ptId = block * blockSize; ptId < endPtId; ++ptId)
+      {
+        sum += counts[ptId].load(std::memory_order_relaxed);
+      }
+      blockOffsets[block + 1] = sum;
+    }
+  });
+  for (vtkIdType block = 0; block < numBlocks; ++block)
   {
-    npts = counts[ptId - 1].load(std::memory_order_relaxed);
-    this->Offsets[ptId] = this->Offsets[ptId - 1] + npts;
+    blockOffsets[block + 1] += blockOffsets[block];
   }
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+    for (; block < endBlock; ++block)
+    {
+      const vtkIdType endPtId = std::min(numPts, (block + 1) * blockSize);
+      TIds offset = blockOffsets[block];
+      for (vtkIdType ptId = block * blockSize; ptId < endPtId; ++ptId)
+      {
+        this->Offsets[ptId] = offset;
+        offset += counts[ptId].load(std::memory_order_relaxed);
+      }
+    }
+  });
   this->Offsets[numPts] = this->LinksSize;
 
   // Now insert cell ids into cell links.
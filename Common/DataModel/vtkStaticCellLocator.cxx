@@ -15,10 +15,16 @@
 #include "vtkPlane.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 
+#include <algorithm>
 #include <array>
+#include <limits>
+#include <memory>
 #include <queue>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -158,6 +164,15 @@ struct vtkCellBinner
 
   vtkIdType GetBinIndex(int ijk[3]) const { return ijk[0] + ijk[1] * xD + ijk[2] * xyD; }
 
+  // Given the bounds of a cell, determine the range of bins it touches.
+  void GetBinRange(const double* bds, int ijkMin[3], int ijkMax[3]) const
+  {
+    const double xmin[3] = { bds[0], bds[2], bds[4] };
+    const double xmax[3] = { bds[1], bds[3], bds[5] };
+    this->GetBinIndices(xmin, ijkMin);
+    this->GetBinIndices(xmax, ijkMax);
+  }
+
   // These are helper functions
   vtkIdType CountBins(const int ijkMin[3], const int ijkMax[3])
   {
@@ -285,6 +300,10 @@ struct vtkCellProcessor
 
   // Convenience for computing
   virtual int IsEmpty(vtkIdType binId) = 0;
+
+  // Support refitting the locator
+  virtual bool Refit(const double* oldCellBounds, const std::vector<vtkIdType>& movedCells,
+    const unsigned char* moved) = 0;
 };
 
 namespace
@@ -366,6 +385,124 @@ struct CellProcessor : public vtkCellProcessor
     return (this->GetNumberOfIds(static_cast<T>(binId)) > 0 ? 0 : 1);
   }
 
+  // Move the fragments of the movedCells, whose bounds before moving are in
+  // oldCellBounds, to their new bins. The other fragments keep their order
+  // in their bins. Returns false if the new number of fragments needs larger
+  // ids than T.
+  bool Refit(const double* oldCellBounds, const std::vector<vtkIdType>& movedCells,
+    const unsigned char* moved) override
+  {
+    const vtkIdType numBins = this->NumBins;
+    int ijkMin[3], ijkMax[3];
+    int i, j, k;
+
+    // Count the fragments removed, and the fragments added to each bin.
+    std::vector<vtkIdType> addedOffsets(numBins + 1, 0);
+    vtkIdType numRemoved = 0;
+    for (vtkIdType cellId : movedCells)
+    {
+      this->Binner->GetBinRange(oldCellBounds + 6 * cellId, ijkMin, ijkMax);
+      numRemoved += this->Binner->CountBins(ijkMin, ijkMax);
+      this->Binner->GetBinRange(this->CellBounds + 6 * cellId, ijkMin, ijkMax);
+      for (k = ijkMin[2]; k <= ijkMax[2]; ++k)
+      {
+        for (j = ijkMin[1]; j <= ijkMax[1]; ++j)
+        {
+          for (i = ijkMin[0]; i <= ijkMax[0]; ++i)
+          {
+            ++addedOffsets[i + j * xD + k * xyD + 1];
+          }
+        }
+      }
+    }
+    for (vtkIdType binId = 0; binId < numBins; ++binId)
+    {
+      addedOffsets[binId + 1] += addedOffsets[binId];
+    }
+    const vtkIdType numAdded = addedOffsets[numBins];
+    const vtkIdType numFragments = this->NumFragments - numRemoved + numAdded;
+    if (numFragments >= static_cast<vtkIdType>(std::numeric_limits<T>::max()))
+    {
+      return false;
+    }
+
+    // The added cells of each bin, in the order of their ids.
+    std::vector<T> addedCells(numAdded);
+    std::vector<vtkIdType> cursors(addedOffsets.begin(), addedOffsets.end() - 1);
+    for (vtkIdType cellId : movedCells)
+    {
+      this->Binner->GetBinRange(this->CellBounds + 6 * cellId, ijkMin, ijkMax);
+      for (k = ijkMin[2]; k <= ijkMax[2]; ++k)
+      {
+        for (j = ijkMin[1]; j <= ijkMax[1]; ++j)
+        {
+          for (i = ijkMin[0]; i <= ijkMax[0]; ++i)
+          {
+            addedCells[cursors[i + j * xD + k * xyD]++] = static_cast<T>(cellId);
+          }
+        }
+      }
+    }
+
+    // Count the fragments of each bin, then merge the fragments kept with
+    // the added ones. New arrays are used since they may be shared with
+    // shallow copies of the locator.
+    auto offsetsSharedPtr = std::make_shared<std::vector<T>>(numBins + 1);
+    T* offsets = offsetsSharedPtr->data();
+    vtkSMPTools::For(0, numBins, [&](vtkIdType binId, vtkIdType endBinId) {
+      for (; binId < endBinId; ++binId)
+      {
+        T count = static_cast<T>(addedOffsets[binId + 1] - addedOffsets[binId]);
+        for (T f = this->Offsets[binId]; f < this->Offsets[binId + 1]; ++f)
+        {
+          count += moved[this->Map[f].CellId] ? 0 : 1;
+        }
+        offsets[binId] = count;
+      }
+    });
+    T total = 0;
+    for (vtkIdType binId = 0; binId < numBins; ++binId)
+    {
+      const T count = offsets[binId];
+      offsets[binId] = total;
+      total += count;
+    }
+    offsets[numBins] = static_cast<T>(numFragments);
+
+    auto mapSharedPtr = std::make_shared<std::vector<CellFragments<T>>>(numFragments + 1);
+    CellFragments<T>* map = mapSharedPtr->data();
+    vtkSMPTools::For(0, numBins, [&](vtkIdType binId, vtkIdType endBinId) {
+      for (; binId < endBinId; ++binId)
+      {
+        CellFragments<T>* t = map + offsets[binId];
+        for (T f = this->Offsets[binId]; f < this->Offsets[binId + 1]; ++f)
+        {
+          if (!moved[this->Map[f].CellId])
+          {
+            *t++ = this->Map[f];
+          }
+        }
+        for (vtkIdType a = addedOffsets[binId]; a < addedOffsets[binId + 1]; ++a)
+        {
+          t->CellId = addedCells[a];
+          t->BinId = static_cast<T>(binId);
+          t++;
+        }
+      }
+    });
+    map[numFragments].BinId = static_cast<T>(numBins);
+
+    this->MapSharedPtr = mapSharedPtr;
+    this->Map = map;
+    this->OffsetsShardPtr = offsetsSharedPtr;
+    this->Offsets = offsets;
+    this->NumFragments = numFragments;
+    this->NumBatches =
+      static_cast<int>(std::ceil(static_cast<double>(this->NumFragments) / this->BatchSize));
+    this->Binner->NumFragments = numFragments;
+    return true;
+  }
+
   // This functor is used to perform the final cell binning
   void Initialize() {}
 
@@ -1371,6 +1508,66 @@ vtkIdType vtkStaticCellLocator::FindCell(
   return this->Processor->FindCell(pos, cell, subId, pcoords, weights);
 }
 
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCells(
+  vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords, vtkDoubleArray* weights)
+{
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  if (this->DataSet)
+  {
+    this->BuildLocator();
+  }
+  const int maxCellSize = this->Processor ? static_cast<int>(this->Processor->MaxCellSize) : 0;
+  double *pcoordsPtr, *weightsPtr;
+  vtkAbstractCellLocator::InitializeFindCellsOutputs(
+    numPts, maxCellSize, cellIds, pcoords, weights, pcoordsPtr, weightsPtr);
+  vtkIdType* ids = cellIds->GetPointer(0);
+  if (!this->Processor)
+  {
+    std::fill(ids, ids + numPts, -1);
+    return;
+  }
+
+  // Sort the points by bin. The points outside of the locator get the bin -1.
+  std::vector<std::pair<vtkIdType, vtkIdType>> order(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      points->GetPoint(ptId, x);
+      order[ptId].first = vtkAbstractCellLocator::IsInBounds(this->Processor->Bounds, x)
+        ? this->Binner->GetBinIndex(x)
+        : -1;
+      order[ptId].second = ptId;
+    }
+  });
+  vtkSMPTools::Sort(order.begin(), order.end());
+
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPThreadLocal<std::vector<double>> tlWeights;
+  const int numWeights = std::max(maxCellSize, 1);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = tlCell.Local();
+    std::vector<double>& localWeights = tlWeights.Local();
+    localWeights.resize(numWeights);
+    double x[3], localPCoords[3];
+    int subId;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType ptId = order[i].second;
+      if (order[i].first < 0)
+      {
+        ids[ptId] = -1;
+        continue;
+      }
+      points->GetPoint(ptId, x);
+      ids[ptId] = this->Processor->FindCell(x, cell, subId,
+        pcoordsPtr ? pcoordsPtr + 3 * ptId : localPCoords,
+        weightsPtr ? weightsPtr + numWeights * ptId : localWeights.data());
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 vtkIdType vtkStaticCellLocator::FindClosestPointWithinRadius(double x[3], double radius,
   double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2,
@@ -1543,6 +1740,72 @@ void vtkStaticCellLocator::BuildLocatorInternal()
   this->BuildTime.Modified();
 }
 
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::RefitLocator()
+{
+  vtkIdType numCells;
+  if (!this->Binner || !this->Processor || !this->DataSet ||
+    (numCells = this->DataSet->GetNumberOfCells()) != this->Binner->NumCells)
+  {
+    this->BuildLocatorInternal();
+    return;
+  }
+
+  // The bins must still cover the data set, otherwise they are laid out again.
+  const double* bounds = this->DataSet->GetBounds();
+  const double* binBounds = this->Binner->Bounds;
+  if (bounds[0] < binBounds[0] || bounds[1] > binBounds[1] || bounds[2] < binBounds[2] ||
+    bounds[3] > binBounds[3] || bounds[4] < binBounds[4] || bounds[5] > binBounds[5])
+  {
+    this->BuildLocatorInternal();
+    return;
+  }
+  vtkDebugMacro(<< "Refitting static cell locator");
+
+  // Compute the new cell bounds, and find the cells which touch other bins
+  // than before. The old bounds may be shared with shallow copies, so they
+  // are kept, and they are needed to remove the old fragments.
+  auto oldCellBoundsSharedPtr = this->Binner->CellBoundsSharedPtr;
+  const double* oldCellBounds = this->Binner->CellBounds;
+  auto cellBoundsSharedPtr = std::make_shared<std::vector<double>>(6 * numCells);
+  double* cellBounds = cellBoundsSharedPtr->data();
+  std::vector<unsigned char> moved(numCells);
+  // This is done to cause non-thread safe initialization to occur due to
+  // side effects from GetCellBounds().
+  this->DataSet->GetCellBounds(0, cellBounds);
+  const vtkCellBinner* binner = this->Binner;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    int oldMin[3], oldMax[3], newMin[3], newMax[3];
+    for (; cellId < endCellId; ++cellId)
+    {
+      double* bds = cellBounds + 6 * cellId;
+      this->DataSet->GetCellBounds(cellId, bds);
+      binner->GetBinRange(oldCellBounds + 6 * cellId, oldMin, oldMax);
+      binner->GetBinRange(bds, newMin, newMax);
+      moved[cellId] =
+        !std::equal(oldMin, oldMin + 3, newMin) || !std::equal(oldMax, oldMax + 3, newMax);
+    }
+  });
+  std::vector<vtkIdType> movedCells;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (moved[cellId])
+    {
+      movedCells.push_back(cellId);
+    }
+  }
+
+  this->Binner->CellBoundsSharedPtr = cellBoundsSharedPtr;
+  this->Binner->CellBounds = cellBounds;
+  this->Processor->CellBounds = cellBounds;
+  if (!movedCells.empty() && !this->Processor->Refit(oldCellBounds, movedCells, moved.data()))
+  {
+    this->BuildLocatorInternal();
+    return;
+  }
+  this->BuildTime.Modified();
+}
+
 //------------------------------------------------------------------------------
 // Produce a polygonal representation of the locator. Each bin which contains
 // a potential cell candidate contributes to the representation. Note that
@@ -193,6 +193,16 @@ public:
   vtkIdType FindCell(double x[3], double vtkNotUsed(tol2), vtkGenericCell* GenCell, int& subId,
     double pcoords[3], double* weights) override;
 
+  /**
+   * Find the cells containing a batch of points, in parallel. The points are
+   * located in the order of the bins containing them, so that the cells of
+   * a bin are evaluated for all its points while they are in cache.
+   *
+   * For more details, see vtkAbstractCellLocator::FindCells().
+   */
+  void FindCells(vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords = nullptr,
+    vtkDoubleArray* weights = nullptr) override;
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * This function should be used ONLY after the locator is built.
@@ -209,6 +219,16 @@ public:
   void ForceBuildLocator() override;
   ///@}
 
+  /**
+   * Update the locator after the points of the data set moved, the cells
+   * being the same. The cell bounds are recomputed in parallel, and only
+   * the cells that touch other bins than before are moved to their new bins,
+   * which is much faster than ForceBuildLocator() for small motions. The
+   * locator is rebuilt if the number of cells changed, or if the data set
+   * moved out of the bins.
+   */
+  void RefitLocator() override;
+
   /**
    * Shallow copy of a vtkStaticCellLocator.
    *
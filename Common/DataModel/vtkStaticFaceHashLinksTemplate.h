@@ -31,8 +31,9 @@
  *    a cell can have less than 2^7 faces, so use vtkTypeInt8. Otherwise, use vtkTypeInt32
  *    when the input grid has polyhedron cells.
  *
- * @warning
- * This class handles only linear cells.
+ * The faces of nonlinear 3D cells are hashed by their corner points, so that the
+ * faces of adjacent nonlinear cells fall in the same hash as long as they share
+ * their corners.
  *
  * @warning
  * This class has been threaded with vtkSMPTools. Using TBB or other
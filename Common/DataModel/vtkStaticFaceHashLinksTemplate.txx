@@ -299,20 +299,27 @@ struct vtkStaticFaceHashLinksTemplate<TInputIdType, TFaceIdType>::CreateFacesInf
               }
               break;
             default:
-              // Other types of 3D linear cells handled by vtkGeometryFilter. Exactly what
-              // is a linear cell is defined by vtkCellTypes::IsLinear().
+              // Other types of 3D cells, linear or not. The faces of nonlinear cells
+              // are hashed by their corner points, which come first in their point ids.
               This->Input->GetCell(cellId, cell);
-              if (cell->GetCellDimension() == 3 && cell->IsLinear())
+              cellOffsets[cellId] = facesOffset;
+              if (cell->GetCellDimension() == 3)
               {
-                cellOffsets[cellId] = facesOffset;
                 for (faceId = 0, numFaces = cell->GetNumberOfFaces(); faceId < numFaces; faceId++)
                 {
                   vtkCell* faceCell = cell->GetFace(faceId);
-                  faceHashValues[facesOffset++] =
-                    *std::min_element(faceCell->PointIds->GetPointer(0),
-                      faceCell->PointIds->GetPointer(faceCell->PointIds->GetNumberOfIds()));
+                  const vtkIdType numCorners = faceCell->IsLinear()
+                    ? faceCell->PointIds->GetNumberOfIds()
+                    : faceCell->GetNumberOfEdges();
+                  faceHashValues[facesOffset++] = *std::min_element(
+                    faceCell->PointIds->GetPointer(0), faceCell->PointIds->GetPointer(numCorners));
                 }
               }
+              else
+              {
+                // Nonlinear 0-1-2d cells.
+                faceHashValues[facesOffset++] = This->NumberOfPoints;
+              }
           }
         }
       }
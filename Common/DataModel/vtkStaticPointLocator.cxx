@@ -18,6 +18,8 @@
 #include "vtkSMPTools.h"
 #include "vtkStructuredData.h"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -479,6 +481,8 @@ struct BucketList : public vtkBucketList
   vtkIdType FindClosestPointWithinRadius(
     double radius, const double x[3], double inputDataLength, double& dist2);
   void FindClosestNPoints(int N, const double x[3], vtkIdList* result);
+  void FindClosestNPoints(
+    vtkIdType numQueries, const double* queries, int N, vtkIdType* ids, double* dist2);
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result);
   int IntersectWithLine(double a0[3], double a1[3], double tol, double& t, double lineX[3],
     double ptX[3], vtkIdType& ptId);
@@ -487,6 +491,8 @@ struct BucketList : public vtkBucketList
   void GenerateRepresentation(int vtkNotUsed(level), vtkPolyData* pd);
 
   // Internal methods
+  using NeighborHeap = std::vector<std::pair<double, vtkIdType>>;
+  void FindClosestNPoints(int N, const double x[3], NeighborBuckets* buckets, NeighborHeap& heap);
   void GetOverlappingBuckets(
     NeighborBuckets* buckets, const double x[3], const int ijk[3], double dist, int level);
   void GetOverlappingBuckets(NeighborBuckets* buckets, const double x[3], double dist,
@@ -1393,6 +1399,124 @@ void BucketList<TIds>::FindClosestNPoints(int N, const double x[3], vtkIdList* r
   }
 }
 
+//------------------------------------------------------------------------------
+// The N closest points are kept in a bounded max-heap of (distance, id)
+// pairs, so that ties are broken by the point ids and the result does not
+// depend on the order in which the buckets are visited. The levels of buckets
+// around the query are visited until the heap is full and the points outside
+// of the visited block of buckets cannot be closer than its farthest point.
+template <typename TIds>
+void BucketList<TIds>::FindClosestNPoints(
+  int N, const double x[3], NeighborBuckets* buckets, NeighborHeap& heap)
+{
+  const size_t maxSize = static_cast<size_t>(N);
+  heap.clear();
+
+  int ijk[3];
+  this->GetBucketIndices(x, ijk);
+  const double origin[3] = { this->bX, this->bY, this->bZ };
+  double pt[3];
+  for (int level = 0;; ++level)
+  {
+    this->GetBucketNeighbors(buckets, ijk, this->Divisions, level);
+    if (!buckets->GetNumberOfNeighbors())
+    {
+      break; // all of the buckets have been visited
+    }
+    for (int i = 0; i < buckets->GetNumberOfNeighbors(); ++i)
+    {
+      int* nei = buckets->GetPoint(i);
+      const vtkIdType cno = nei[0] + nei[1] * this->xD + nei[2] * this->xyD;
+      const vtkIdType numIds = this->GetNumberOfIds(cno);
+      if (numIds == 0 ||
+        (heap.size() == maxSize && this->Distance2ToBucket(x, nei) > heap.front().first))
+      {
+        continue;
+      }
+      const LocatorTuple<TIds>* ids = this->GetIds(cno);
+      for (vtkIdType j = 0; j < numIds; ++j)
+      {
+        const vtkIdType ptId = ids[j].PtId;
+        this->DataSet->GetPoint(ptId, pt);
+        const std::pair<double, vtkIdType> candidate(vtkMath::Distance2BetweenPoints(x, pt), ptId);
+        if (heap.size() < maxSize)
+        {
+          heap.push_back(candidate);
+          std::push_heap(heap.begin(), heap.end());
+        }
+        else if (candidate < heap.front())
+        {
+          std::pop_heap(heap.begin(), heap.end());
+          heap.back() = candidate;
+          std::push_heap(heap.begin(), heap.end());
+        }
+      }
+    }
+
+    // The unvisited points lie beyond the faces of the visited block which
+    // are not on the boundary of the locator.
+    if (heap.size() == maxSize)
+    {
+      double gap = VTK_DOUBLE_MAX;
+      for (int c = 0; c < 3; ++c)
+      {
+        if (ijk[c] - level > 0)
+        {
+          gap = std::min(gap, x[c] - (origin[c] + (ijk[c] - level) * this->H[c]));
+        }
+        if (ijk[c] + level < this->Divisions[c] - 1)
+        {
+          gap = std::min(gap, origin[c] + (ijk[c] + level + 1) * this->H[c] - x[c]);
+        }
+      }
+      if (gap == VTK_DOUBLE_MAX || (gap > 0.0 && gap * gap > heap.front().first))
+      {
+        break;
+      }
+    }
+  }
+  std::sort_heap(heap.begin(), heap.end());
+}
+
+//------------------------------------------------------------------------------
+// The queries are processed in the order of their buckets, so that the
+// threads visit the same buckets and points for nearby queries.
+template <typename TIds>
+void BucketList<TIds>::FindClosestNPoints(
+  vtkIdType numQueries, const double* queries, int N, vtkIdType* ids, double* dist2)
+{
+  std::vector<std::pair<vtkIdType, vtkIdType>> order(numQueries);
+  vtkSMPTools::For(0, numQueries, [&](vtkIdType q, vtkIdType endQ) {
+    for (; q < endQ; ++q)
+    {
+      order[q] = std::make_pair(this->GetBucketIndex(queries + 3 * q), q);
+    }
+  });
+  vtkSMPTools::Sort(order.begin(), order.end());
+
+  vtkSMPTools::For(0, numQueries, [&](vtkIdType i, vtkIdType endI) {
+    NeighborBuckets buckets;
+    NeighborHeap heap;
+    heap.reserve(N);
+    for (; i < endI; ++i)
+    {
+      const vtkIdType q = order[i].second;
+      this->FindClosestNPoints(N, queries + 3 * q, &buckets, heap);
+      vtkIdType* qIds = ids + q * N;
+      double* qDist2 = dist2 ? dist2 + q * N : nullptr;
+      for (int k = 0; k < N; ++k)
+      {
+        const bool found = static_cast<size_t>(k) < heap.size();
+        qIds[k] = found ? heap[k].second : -1;
+        if (qDist2)
+        {
+          qDist2[k] = found ? heap[k].first : VTK_DOUBLE_MAX;
+        }
+      }
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 // The Radius defines a block of buckets which the sphere of radius R may
 // touch.
@@ -2218,6 +2342,37 @@ void vtkStaticPointLocator::FindClosestNPoints(int N, const double x[3], vtkIdLi
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestNPoints(
+  vtkIdType numberOfQueries, const double* queries, int N, vtkIdType* ids, double* dist2)
+{
+  if (numberOfQueries <= 0 || N <= 0)
+  {
+    return;
+  }
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (!this->Buckets)
+  {
+    std::fill(ids, ids + numberOfQueries * N, -1);
+    if (dist2)
+    {
+      std::fill(dist2, dist2 + numberOfQueries * N, VTK_DOUBLE_MAX);
+    }
+    return;
+  }
+
+  if (this->LargeIds)
+  {
+    static_cast<BucketList<vtkIdType>*>(this->Buckets)
+      ->FindClosestNPoints(numberOfQueries, queries, N, ids, dist2);
+  }
+  else
+  {
+    static_cast<BucketList<int>*>(this->Buckets)
+      ->FindClosestNPoints(numberOfQueries, queries, N, ids, dist2);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkStaticPointLocator::FindPointsWithinRadius(double R, const double x[3], vtkIdList* result)
 {
@@ -2324,6 +2479,74 @@ void vtkStaticPointLocator::GetBucketIds(vtkIdType bNum, vtkIdList* bList)
   }
 }
 
+//------------------------------------------------------------------------------
+// Traverse the buckets in serpentine order: the rows of buckets along x are
+// traversed back and forth, as are the slices of rows along y. The point ids
+// of the buckets are then gathered in parallel.
+namespace
+{
+template <typename TIds>
+void GetSpatialOrderImpl(BucketList<TIds>* bList, const int divs[3], vtkIdList* order)
+{
+  std::vector<vtkIdType> buckets;
+  std::vector<vtkIdType> offsets(1, 0);
+  for (int k = 0; k < divs[2]; ++k)
+  {
+    for (int jj = 0; jj < divs[1]; ++jj)
+    {
+      int j = (k % 2 ? divs[1] - 1 - jj : jj);
+      for (int ii = 0; ii < divs[0]; ++ii)
+      {
+        int i = ((jj + k * divs[1]) % 2 ? divs[0] - 1 - ii : ii);
+        vtkIdType bucket =
+          i + static_cast<vtkIdType>(divs[0]) * (j + static_cast<vtkIdType>(divs[1]) * k);
+        vtkIdType numIds = bList->GetNumberOfIds(bucket);
+        if (numIds > 0)
+        {
+          buckets.push_back(bucket);
+          offsets.push_back(offsets.back() + numIds);
+        }
+      }
+    }
+  }
+
+  order->SetNumberOfIds(offsets.back());
+  vtkIdType* orderIds = order->GetPointer(0);
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(buckets.size()), [&](vtkIdType bucket, vtkIdType endBucket) {
+      for (; bucket < endBucket; ++bucket)
+      {
+        const LocatorTuple<TIds>* ids = bList->GetIds(buckets[bucket]);
+        for (vtkIdType i = offsets[bucket]; i < offsets[bucket + 1]; ++i)
+        {
+          orderIds[i] = (ids++)->PtId;
+        }
+      }
+    });
+}
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::GetSpatialOrder(vtkIdList* order)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  order->Reset();
+  if (!this->Buckets)
+  {
+    return;
+  }
+
+  if (this->LargeIds)
+  {
+    GetSpatialOrderImpl(
+      static_cast<BucketList<vtkIdType>*>(this->Buckets), this->Divisions, order);
+  }
+  else
+  {
+    GetSpatialOrderImpl(static_cast<BucketList<int>*>(this->Buckets), this->Divisions, order);
+  }
+}
+
 //------------------------------------------------------------------------------
 // Merge the points in the locator, return a merge map.
 void vtkStaticPointLocator::MergePoints(double tol, vtkIdType* pointMap)
@@ -131,6 +131,23 @@ public:
    */
   void FindClosestNPoints(int N, const double x[3], vtkIdList* result) override;
 
+  /**
+   * Find the closest N points to each of numberOfQueries positions, given as
+   * consecutive (x,y,z) triplets in queries. The N ids of the closest points
+   * to query q are written from closest to farthest in ids[q*N] to
+   * ids[q*N+N-1], and their squared distances in dist2 if it is not
+   * nullptr. Both arrays must be preallocated with numberOfQueries*N values.
+   * If the locator has fewer than N points, the remaining ids are set to -1
+   * and their distances to VTK_DOUBLE_MAX. Points at the same distance are
+   * ordered by id, so that the results do not depend on the number of
+   * threads. The queries are sorted along the buckets and processed in
+   * parallel, without allocating memory for each of them. This method is
+   * thread safe if BuildLocator() is directly or indirectly called from a
+   * single thread first.
+   */
+  void FindClosestNPoints(vtkIdType numberOfQueries, const double* queries, int N, vtkIdType* ids,
+    double* dist2 = nullptr);
+
   /**
    * Find all points within a specified radius R of position x.
    * The result is not sorted in any specific manner.
@@ -207,6 +224,16 @@ public:
    */
   void GetBucketIds(vtkIdType bNum, vtkIdList* bList);
 
+  /**
+   * Return the ids of all the points in the locator, bucket after bucket,
+   * the buckets being traversed in a serpentine order so that consecutive
+   * points are spatially close. Incremental algorithms that search from the
+   * last inserted point, such as vtkDelaunay2D and vtkDelaunay3D, are much
+   * faster when the points are inserted in this order. The user must provide
+   * an instance of vtkIdList to contain the result.
+   */
+  void GetSpatialOrder(vtkIdList* order);
+
   ///@{
   /**
    * Set the maximum number of buckets in the locator. By default the value
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+void CountExecution(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+double GetElevationRange(vtkPolyData* output)
+{
+  vtkDataArray* elevation = output->GetPointData()->GetArray("Elevation");
+  return elevation ? elevation->GetRange()[1] : -1.0;
+}
+}
+
+int TestDeclaredInputArrays(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->GenerateNormalsOff();
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->SetLowPoint(0.0, 0.0, -0.5);
+  elevation->SetHighPoint(0.0, 0.0, 0.5);
+  vtkNew<vtkPolyDataNormals> normals;
+  normals->SetInputConnection(elevation->GetOutputPort());
+  normals->SplittingOff();
+
+  int normalsExecutions = 0;
+  vtkNew<vtkCallbackCommand> counter;
+  counter->SetCallback(::CountExecution);
+  counter->SetClientData(&normalsExecutions);
+  normals->AddObserver(vtkCommand::StartEvent, counter);
+
+  normals->Update();
+  if (normalsExecutions != 1 || !normals->GetOutput()->GetPointData()->GetNormals())
+  {
+    std::cerr << "Wrong first execution of the normals." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The normals do not depend on the elevation: the new elevation is passed to
+  // the output without computing the normals again.
+  elevation->SetScalarRange(0.0, 10.0);
+  normals->Update();
+  if (normalsExecutions != 1)
+  {
+    std::cerr << "The normals were computed again for a new scalar array." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (::GetElevationRange(normals->GetOutput()) != 10.0)
+  {
+    std::cerr << "The new elevation was not passed to the output." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A new mesh executes the normals again.
+  sphere->SetThetaResolution(16);
+  normals->Update();
+  if (normalsExecutions != 2 ||
+    normals->GetOutput()->GetNumberOfPoints() != sphere->GetOutput()->GetNumberOfPoints())
+  {
+    std::cerr << "The normals were not computed for a new mesh." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Without declaration, any change of the input executes the algorithm.
+  normals->ClearInputArrayDeclarations(0);
+  normals->Update();
+  const int executions = normalsExecutions;
+  elevation->SetScalarRange(0.0, 5.0);
+  normals->Update();
+  if (normalsExecutions != executions + 1 || ::GetElevationRange(normals->GetOutput()) != 5.0)
+  {
+    std::cerr << "The normals did not execute for a new input without declaration." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkElevationFilter.h"
+#include "vtkNew.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+int TestPipelineProfiler(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+
+  vtkNew<vtkPipelineProfiler> profiler;
+  profiler->Start();
+  if (!profiler->IsStarted() || vtkPipelineProfiler::GetStartedProfiler() != profiler)
+  {
+    std::cerr << "The profiler is not started." << std::endl;
+    return EXIT_FAILURE;
+  }
+  elevation->Update();
+  const double start = vtkPipelineProfiler::GetTime();
+  profiler->AddEvent("Wait", "MPI", start, start + 0.001);
+  profiler->Stop();
+
+  const int numberOfEvents = profiler->GetNumberOfEvents();
+  if (numberOfEvents < 3)
+  {
+    std::cerr << "Wrong number of events: " << numberOfEvents << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ostringstream trace;
+  profiler->PrintChromeTrace(trace);
+  for (const char* expected : { "\"traceEvents\"", "vtkSphereSource", "vtkElevationFilter",
+         "\"cat\":\"REQUEST_DATA\"", "\"cat\":\"REQUEST_INFORMATION\"", "\"output_bytes\"",
+         "\"cat\":\"MPI\"" })
+  {
+    if (trace.str().find(expected) == std::string::npos)
+    {
+      std::cerr << "Missing " << expected << " in the trace:\n" << trace.str() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::ostringstream summary;
+  profiler->PrintSummary(summary);
+  if (summary.str().find("vtkElevationFilter") == std::string::npos)
+  {
+    std::cerr << "Wrong summary:\n" << summary.str() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Nothing is recorded once stopped.
+  sphere->SetThetaResolution(16);
+  elevation->Update();
+  if (profiler->GetNumberOfEvents() != numberOfEvents)
+  {
+    std::cerr << "Events recorded by a stopped profiler." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  profiler->Clear();
+  if (profiler->GetNumberOfEvents() != 0)
+  {
+    std::cerr << "Events not cleared." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
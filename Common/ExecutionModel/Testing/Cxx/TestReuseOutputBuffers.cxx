@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArray.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationDataObjectKey.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+#include <iostream>
+
+int TestReuseOutputBuffers(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  vtkDemandDrivenPipeline* executive =
+    vtkDemandDrivenPipeline::SafeDownCast(elevation->GetExecutive());
+  if (!executive || executive->GetReuseOutputBuffers(0) ||
+    !executive->SetReuseOutputBuffers(0, 1) || !executive->GetReuseOutputBuffers(0))
+  {
+    std::cerr << "Cannot turn on the reuse of the output buffers." << std::endl;
+    return EXIT_FAILURE;
+  }
+  elevation->Update();
+  vtkDataArray* scalars = elevation->GetOutput()->GetPointData()->GetArray("Elevation");
+  void* buffer = scalars->GetVoidPointer(0);
+  double range[2];
+  scalars->GetRange(range);
+
+  // The same buffer is filled with the new values.
+  elevation->SetLowPoint(0, 0, -1);
+  elevation->SetHighPoint(0, 0, 1);
+  elevation->Update();
+  vtkDataArray* newScalars = elevation->GetOutput()->GetPointData()->GetArray("Elevation");
+  if (newScalars != scalars || newScalars->GetVoidPointer(0) != buffer)
+  {
+    std::cerr << "The elevation array has not been reused." << std::endl;
+    return EXIT_FAILURE;
+  }
+  double newRange[2];
+  newScalars->GetRange(newRange);
+  if (newRange[0] == range[0] && newRange[1] == range[1])
+  {
+    std::cerr << "The range of the reused array is not updated." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (elevation->GetOutputInformation(0)->Has(vtkDemandDrivenPipeline::PREVIOUS_OUTPUT()))
+  {
+    std::cerr << "The previous output is kept after the execution." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Arrays still used elsewhere are never overwritten.
+  vtkSmartPointer<vtkDataArray> kept = newScalars;
+  elevation->SetLowPoint(0, 0, -2);
+  elevation->Update();
+  if (elevation->GetOutput()->GetPointData()->GetArray("Elevation") == kept)
+  {
+    std::cerr << "An array used elsewhere has been reused." << std::endl;
+    return EXIT_FAILURE;
+  }
+  kept->GetRange(range);
+  if (range[0] != newRange[0] || range[1] != newRange[1])
+  {
+    std::cerr << "An array used elsewhere has been modified." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
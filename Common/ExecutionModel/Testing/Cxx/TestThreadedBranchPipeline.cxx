@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkAppendPolyData.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkContourFilter.h"
+#include "vtkCutter.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkThreadedBranchPipeline.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+void CountExecution(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+bool SameOutput(vtkAppendPolyData* append, vtkAppendPolyData* reference)
+{
+  vtkPolyData* output = append->GetOutput();
+  vtkPolyData* expected = reference->GetOutput();
+  if (output->GetNumberOfPoints() == 0 ||
+    output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    std::cerr << "Wrong output of the threaded branches: " << output->GetNumberOfPoints()
+              << " points instead of " << expected->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Join independent branches and branches sharing producers whose output has
+// EXACT_EXTENT set by their vtkCutter consumers, one of them being connected
+// twice. Only the independent groups may be updated concurrently.
+bool TestSharedProducers()
+{
+  vtkNew<vtkRTAnalyticSource> wavelets[3];
+  int executions[3] = { 0, 0, 0 };
+  vtkNew<vtkCallbackCommand> counters[3];
+  vtkNew<vtkPlane> plane;
+  vtkNew<vtkCutter> slices[3];
+  vtkNew<vtkContourFilter> contours[3];
+  vtkNew<vtkAppendPolyData> append;
+  vtkNew<vtkAppendPolyData> reference;
+  for (int i = 0; i < 3; ++i)
+  {
+    wavelets[i]->SetWholeExtent(-8 - i, 8, -8, 8 + i, -8, 8);
+    counters[i]->SetCallback(::CountExecution);
+    counters[i]->SetClientData(executions + i);
+    wavelets[i]->AddObserver(vtkCommand::StartEvent, counters[i]);
+    slices[i]->SetCutFunction(plane);
+    slices[i]->SetInputConnection(wavelets[i]->GetOutputPort());
+    contours[i]->SetInputConnection(wavelets[i]->GetOutputPort());
+    contours[i]->SetValue(0, 150.0);
+  }
+  // The first wavelet feeds three branches, slices[0] being connected twice,
+  // the second one two branches and the third one a single branch.
+  vtkAlgorithm* producers[] = { slices[0], contours[0], slices[0], slices[1], contours[1],
+    slices[2] };
+  for (vtkAlgorithm* producer : producers)
+  {
+    append->AddInputConnection(producer->GetOutputPort());
+    reference->AddInputConnection(producer->GetOutputPort());
+  }
+
+  vtkNew<vtkThreadedBranchPipeline> executive;
+  append->SetExecutive(executive);
+  for (int update = 0; update < 3; ++update)
+  {
+    // The upstream pipelines are up to date after the first update, their
+    // executives still process the requests of the branches.
+    append->Modified();
+    append->Update();
+    reference->Update();
+    if (!::SameOutput(append, reference))
+    {
+      return false;
+    }
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    if (executions[i] != 1)
+    {
+      std::cerr << "Wavelet " << i << " executed " << executions[i] << " times." << std::endl;
+      return false;
+    }
+  }
+
+  // Modifying a shared source executes it once more.
+  wavelets[0]->SetMaximum(300.0);
+  append->Update();
+  reference->Update();
+  if (executions[0] != 2 || executions[1] != 1 || !::SameOutput(append, reference))
+  {
+    std::cerr << "Wrong update after modifying a shared source." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestThreadedBranchPipeline(int, char*[])
+{
+  // One source shared by four branches joined by an append filter.
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-16, 16, -16, 16, -16, 16);
+  int waveletExecutions = 0;
+  vtkNew<vtkCallbackCommand> counter;
+  counter->SetCallback(::CountExecution);
+  counter->SetClientData(&waveletExecutions);
+  wavelet->AddObserver(vtkCommand::StartEvent, counter);
+
+  vtkNew<vtkContourFilter> contours[3];
+  vtkNew<vtkAppendPolyData> append;
+  vtkNew<vtkAppendPolyData> reference;
+  for (int i = 0; i < 3; ++i)
+  {
+    contours[i]->SetInputConnection(wavelet->GetOutputPort());
+    contours[i]->SetValue(0, 100.0 + 50.0 * i);
+    append->AddInputConnection(contours[i]->GetOutputPort());
+    reference->AddInputConnection(contours[i]->GetOutputPort());
+  }
+  vtkNew<vtkPlane> plane;
+  vtkNew<vtkCutter> slice;
+  slice->SetCutFunction(plane);
+  slice->SetInputConnection(wavelet->GetOutputPort());
+  append->AddInputConnection(slice->GetOutputPort());
+  reference->AddInputConnection(slice->GetOutputPort());
+
+  vtkNew<vtkThreadedBranchPipeline> executive;
+  append->SetExecutive(executive);
+  append->Update();
+  reference->Update();
+
+  if (waveletExecutions != 1)
+  {
+    std::cerr << "The shared source executed " << waveletExecutions << " times." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!::SameOutput(append, reference))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Only the modified branch executes again.
+  contours[1]->SetValue(0, 175.0);
+  append->Update();
+  reference->Update();
+  if (waveletExecutions != 1 ||
+    append->GetOutput()->GetNumberOfPoints() != reference->GetOutput()->GetNumberOfPoints())
+  {
+    std::cerr << "Wrong output after modifying a branch." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A modified shared source executes once more.
+  wavelet->SetMaximum(300.0);
+  append->Update();
+  if (waveletExecutions != 2)
+  {
+    std::cerr << "The shared source executed " << waveletExecutions << " times." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return ::TestSharedProducers() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
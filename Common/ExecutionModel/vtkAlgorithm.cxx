@@ -53,6 +53,8 @@ vtkInformationKeyMacro(vtkAlgorithm, INPUT_ARRAYS_TO_PROCESS, InformationVector)
 vtkInformationKeyMacro(vtkAlgorithm, CAN_PRODUCE_SUB_EXTENT, Integer);
 vtkInformationKeyMacro(vtkAlgorithm, CAN_HANDLE_PIECE_REQUEST, Integer);
 vtkInformationKeyMacro(vtkAlgorithm, ABORTED, Integer);
+vtkInformationKeyMacro(vtkAlgorithm, INPUT_DEPENDS_ON_DECLARED_ARRAYS, Integer);
+vtkInformationKeyMacro(vtkAlgorithm, INPUT_DECLARED_ARRAYS, StringVector);
 
 vtkExecutive* vtkAlgorithm::DefaultExecutivePrototype = nullptr;
 vtkTimeStamp vtkAlgorithm::LastAbortTime;
@@ -335,6 +337,36 @@ vtkInformation* vtkAlgorithm::GetInputArrayInformation(int idx)
   return inArrayInfo;
 }
 
+//------------------------------------------------------------------------------
+void vtkAlgorithm::DeclareInputArrays(int port, const std::vector<std::string>& names)
+{
+  vtkInformation* info = this->GetInputPortInformation(port);
+  if (!info)
+  {
+    return;
+  }
+  info->Set(INPUT_DEPENDS_ON_DECLARED_ARRAYS(), 1);
+  info->Remove(INPUT_DECLARED_ARRAYS());
+  for (const std::string& name : names)
+  {
+    INPUT_DECLARED_ARRAYS()->Append(info, name);
+  }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkAlgorithm::ClearInputArrayDeclarations(int port)
+{
+  vtkInformation* info = this->GetInputPortInformation(port);
+  if (!info)
+  {
+    return;
+  }
+  info->Remove(INPUT_DEPENDS_ON_DECLARED_ARRAYS());
+  info->Remove(INPUT_DECLARED_ARRAYS());
+  this->Modified();
+}
+
 //------------------------------------------------------------------------------
 void vtkAlgorithm::SetInputArrayToProcess(int idx, vtkInformation* inInfo)
 {
@@ -24,6 +24,9 @@
 #include "vtkObject.h"
 #include "vtkWrappingHints.h" // For VTK_MARSHALMANUAL
 
+#include <string> // For std::string
+#include <vector> // For std::vector
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkAbstractArray;
 class vtkAlgorithmInternals;
@@ -344,6 +347,44 @@ public:
    */
   static vtkInformationIntegerKey* ABORTED();
 
+  /**
+   * Key set in input port information to declare that the algorithm only
+   * reads the structure of the input data, the arrays named in
+   * INPUT_DECLARED_ARRAYS and its arrays to process. See DeclareInputArrays().
+   * \ingroup InformationKeys
+   */
+  static vtkInformationIntegerKey* INPUT_DEPENDS_ON_DECLARED_ARRAYS();
+  /**
+   * \ingroup InformationKeys
+   */
+  static vtkInformationStringVectorKey* INPUT_DECLARED_ARRAYS();
+
+  ///@{
+  /**
+   * Declare that the algorithm only reads, on the input port `port`, the
+   * structure of the input (points, cells, extent...), the arrays named
+   * `names`, whatever their association, and the arrays to process. A name can
+   * also be an attribute type, as given by
+   * vtkDataSetAttributes::GetAttributeTypeAsString(), such as "Normals", to
+   * declare the active attribute of that type. An empty list declares that the
+   * algorithm only reads the structure.
+   *
+   * When only other input arrays changed since the last execution, the
+   * executive does not execute the algorithm again. It keeps the previous
+   * output and replaces the arrays it shares with the first input by their new
+   * version. The algorithm executes as usual when arrays are added to or
+   * removed from the input, when the active attributes change, or when the
+   * output holds an array named like a changed input array without sharing it,
+   * for instance a copy with duplicated points.
+   *
+   * Only vtkDataSet inputs and outputs are supported. Algorithms can also set
+   * INPUT_DEPENDS_ON_DECLARED_ARRAYS and INPUT_DECLARED_ARRAYS in
+   * FillInputPortInformation().
+   */
+  void DeclareInputArrays(int port, const std::vector<std::string>& names);
+  void ClearInputArrayDeclarations(int port);
+  ///@}
+
   ///@{
   /**
    * Set the input data arrays that this algorithm will
@@ -13,7 +13,30 @@
 #include "vtkInformationVector.h"
 #include "vtkPointData.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+std::atomic<unsigned long> GlobalCacheMemoryLimit(0);
+
+// All the executives sharing the global cache memory limit.
+struct vtkCacheRegistry
+{
+  std::mutex Mutex;
+  std::set<vtkCachedStreamingDemandDrivenPipeline*> Executives;
+};
+
+vtkCacheRegistry& GetCacheRegistry()
+{
+  static vtkCacheRegistry registry;
+  return registry;
+}
+}
+
 vtkStandardNewMacro(vtkCachedStreamingDemandDrivenPipeline);
 
 //------------------------------------------------------------------------------
@@ -24,14 +47,96 @@ vtkCachedStreamingDemandDrivenPipeline ::vtkCachedStreamingDemandDrivenPipeline(
   this->Times = nullptr;
 
   this->SetCacheSize(10);
+
+  vtkCacheRegistry& registry = ::GetCacheRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  registry.Executives.insert(this);
 }
 
 //------------------------------------------------------------------------------
 vtkCachedStreamingDemandDrivenPipeline ::~vtkCachedStreamingDemandDrivenPipeline()
 {
+  {
+    vtkCacheRegistry& registry = ::GetCacheRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    registry.Executives.erase(this);
+  }
   this->SetCacheSize(0);
 }
 
+//------------------------------------------------------------------------------
+void vtkCachedStreamingDemandDrivenPipeline::SetGlobalCacheMemoryLimit(unsigned long limit)
+{
+  ::GlobalCacheMemoryLimit = limit;
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkCachedStreamingDemandDrivenPipeline::GetGlobalCacheMemoryLimit()
+{
+  return ::GlobalCacheMemoryLimit;
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkCachedStreamingDemandDrivenPipeline::GetCacheMemorySize()
+{
+  unsigned long size = 0;
+  for (int i = 0; i < this->CacheSize; ++i)
+  {
+    if (this->Data[i])
+    {
+      size += this->Data[i]->GetActualMemorySize();
+    }
+  }
+  return size;
+}
+
+//------------------------------------------------------------------------------
+void vtkCachedStreamingDemandDrivenPipeline::EnforceGlobalCacheMemoryLimit(int keptIndex)
+{
+  const unsigned long limit = ::GlobalCacheMemoryLimit;
+  if (limit == 0)
+  {
+    return;
+  }
+
+  vtkCacheRegistry& registry = ::GetCacheRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  unsigned long total = 0;
+  for (vtkCachedStreamingDemandDrivenPipeline* executive : registry.Executives)
+  {
+    total += executive->GetCacheMemorySize();
+  }
+  while (total > limit)
+  {
+    // Evict the oldest entry of all the caches.
+    vtkCachedStreamingDemandDrivenPipeline* oldestExecutive = nullptr;
+    int oldestIndex = -1;
+    for (vtkCachedStreamingDemandDrivenPipeline* executive : registry.Executives)
+    {
+      for (int i = 0; i < executive->CacheSize; ++i)
+      {
+        if (executive->Data[i] && (executive != this || i != keptIndex) &&
+          (!oldestExecutive || executive->Times[i] < oldestExecutive->Times[oldestIndex]))
+        {
+          oldestExecutive = executive;
+          oldestIndex = i;
+        }
+      }
+    }
+    if (!oldestExecutive)
+    {
+      vtkWarningMacro(<< "The cached data object alone exceeds the global cache memory limit of "
+                      << limit << " KiB.");
+      return;
+    }
+    vtkDataObject*& evicted = oldestExecutive->Data[oldestIndex];
+    total -= std::min(total, evicted->GetActualMemorySize());
+    evicted->Delete();
+    evicted = nullptr;
+    oldestExecutive->Times[oldestIndex] = 0;
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkCachedStreamingDemandDrivenPipeline::SetCacheSize(int size)
 {
@@ -259,6 +364,7 @@ int vtkCachedStreamingDemandDrivenPipeline ::ExecuteData(
   }
 
   this->Times[bestIdx] = dataObject->GetUpdateTime();
+  this->EnforceGlobalCacheMemoryLimit(bestIdx);
 
   return result;
 }
@@ -33,6 +33,25 @@ public:
   vtkGetMacro(CacheSize, int);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get the maximum memory, in kibibytes, held by the caches of all the
+   * vtkCachedStreamingDemandDrivenPipeline executives of the process. When
+   * caching a new data object exceeds this budget, the oldest data objects of
+   * all the caches are evicted, and a warning is emitted when the new data
+   * object alone exceeds it. Eviction happens while an executive executes, so
+   * the executives sharing the budget must not execute concurrently.
+   * 0, the default, means no limit.
+   */
+  static void SetGlobalCacheMemoryLimit(unsigned long limit);
+  static unsigned long GetGlobalCacheMemoryLimit();
+  ///@}
+
+  /**
+   * Return the memory, in kibibytes, held by the cache of this executive.
+   */
+  unsigned long GetCacheMemorySize();
+
 protected:
   vtkCachedStreamingDemandDrivenPipeline();
   ~vtkCachedStreamingDemandDrivenPipeline() override;
@@ -47,6 +66,12 @@ protected:
   vtkDataObject** Data;
   vtkMTimeType* Times;
 
+  /**
+   * Evict the oldest cached data objects of all the executives, but the entry
+   * `keptIndex` of this one, until the global cache memory limit is met.
+   */
+  void EnforceGlobalCacheMemoryLimit(int keptIndex);
+
 private:
   vtkCachedStreamingDemandDrivenPipeline(const vtkCachedStreamingDemandDrivenPipeline&) = delete;
   void operator=(const vtkCachedStreamingDemandDrivenPipeline&) = delete;
@@ -12,28 +12,136 @@
 #include "vtkDataSet.h"
 #include "vtkGarbageCollector.h"
 #include "vtkInformation.h"
+#include "vtkInformationDataObjectKey.h"
 #include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationExecutivePortVectorKey.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationRequestKey.h"
+#include "vtkInformationStringKey.h"
+#include "vtkInformationStringVectorKey.h"
 #include "vtkInformationUnsignedLongKey.h"
 #include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkWeakPointer.h"
 
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+// State of the inputs at the last execution of an algorithm that declared the
+// input arrays it depends on.
+class vtkDemandDrivenPipelineInternals
+{
+public:
+  struct ArrayState
+  {
+    vtkWeakPointer<vtkAbstractArray> Array;
+    vtkMTimeType MTime;
+    // Attribute type when the array is an active attribute, -1 otherwise.
+    int Attribute;
+  };
+
+  struct InputState
+  {
+    vtkWeakPointer<vtkDataSet> Data;
+    vtkMTimeType MeshMTime = 0;
+    // Arrays of the point, cell and field data, by name.
+    std::map<std::string, ArrayState> Arrays[vtkDataObject::FIELD + 1];
+  };
+
+  // Indexed by input port, then by connection.
+  std::vector<std::vector<InputState>> Inputs;
+  bool Valid = false;
+};
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Fill `names` with the arrays the algorithm declared to read on `port`.
+// Return false when the algorithm did not declare them.
+bool GetDeclaredInputArrays(vtkAlgorithm* algorithm, int port, std::set<std::string>& names)
+{
+  vtkInformation* info = algorithm->GetInputPortInformation(port);
+  if (!info || !info->Get(vtkAlgorithm::INPUT_DEPENDS_ON_DECLARED_ARRAYS()))
+  {
+    return false;
+  }
+  for (int i = 0; i < vtkAlgorithm::INPUT_DECLARED_ARRAYS()->Length(info); ++i)
+  {
+    names.insert(vtkAlgorithm::INPUT_DECLARED_ARRAYS()->Get(info, i));
+  }
+  // The arrays to process are dependencies as well. Arrays selected by
+  // attribute type cannot be tracked by name.
+  vtkInformationVector* arrays =
+    algorithm->GetInformation()->Get(vtkAlgorithm::INPUT_ARRAYS_TO_PROCESS());
+  for (int i = 0; arrays && i < arrays->GetNumberOfInformationObjects(); ++i)
+  {
+    vtkInformation* arrayInfo = arrays->GetInformationObject(i);
+    if (arrayInfo->Get(vtkAlgorithm::INPUT_PORT()) != port)
+    {
+      continue;
+    }
+    const char* name = arrayInfo->Get(vtkDataObject::FIELD_NAME());
+    if (!name)
+    {
+      return false;
+    }
+    names.insert(name);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Return false when the state of `data` cannot be tracked.
+bool GetInputState(vtkDataObject* data, vtkDemandDrivenPipelineInternals::InputState& state)
+{
+  vtkDataSet* dataSet = vtkDataSet::SafeDownCast(data);
+  if (!dataSet)
+  {
+    return false;
+  }
+  state.Data = dataSet;
+  state.MeshMTime = dataSet->GetMeshMTime();
+  for (int type = vtkDataObject::POINT; type <= vtkDataObject::FIELD; ++type)
+  {
+    vtkFieldData* attributes = dataSet->GetAttributesAsFieldData(type);
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(attributes);
+    for (int i = 0; attributes && i < attributes->GetNumberOfArrays(); ++i)
+    {
+      vtkAbstractArray* array = attributes->GetAbstractArray(i);
+      const int attribute = dsa ? dsa->IsArrayAnAttribute(i) : -1;
+      if (!array->GetName() ||
+        !state.Arrays[type]
+           .insert(std::make_pair(std::string(array->GetName()),
+             vtkDemandDrivenPipelineInternals::ArrayState{ array, array->GetMTime(), attribute }))
+           .second)
+      {
+        // Unnamed or duplicated arrays cannot be tracked.
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
 vtkStandardNewMacro(vtkDemandDrivenPipeline);
 
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, DATA_NOT_GENERATED, Integer);
+vtkInformationKeyMacro(vtkDemandDrivenPipeline, PREVIOUS_OUTPUT, DataObject);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, RELEASE_DATA, Integer);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_DATA, Request);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_DATA_NOT_GENERATED, Request);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_DATA_OBJECT, Request);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_INFORMATION, Request);
+vtkInformationKeyMacro(vtkDemandDrivenPipeline, REUSE_OUTPUT_BUFFERS, Integer);
 
 //------------------------------------------------------------------------------
 vtkDemandDrivenPipeline::vtkDemandDrivenPipeline()
@@ -42,6 +150,7 @@ vtkDemandDrivenPipeline::vtkDemandDrivenPipeline()
   this->DataObjectRequest = nullptr;
   this->DataRequest = nullptr;
   this->PipelineMTime = 0;
+  this->Internals = new vtkDemandDrivenPipelineInternals;
 }
 
 //------------------------------------------------------------------------------
@@ -59,6 +168,7 @@ vtkDemandDrivenPipeline::~vtkDemandDrivenPipeline()
   {
     this->DataRequest->Delete();
   }
+  delete this->Internals;
 }
 
 //------------------------------------------------------------------------------
@@ -244,9 +354,18 @@ vtkTypeBool vtkDemandDrivenPipeline::ProcessRequest(
         return 0;
       }
 
-      // Request data from the algorithm.
-      vtkLogF(TRACE, "%s execute-data", vtkLogIdentifier(this->Algorithm));
-      result = this->ExecuteData(request, inInfoVec, outInfoVec);
+      // Request data from the algorithm, unless it does not depend on what
+      // changed in its inputs.
+      if (this->ReuseOutputsForUnchangedDependencies(request, outputPort, inInfoVec, outInfoVec))
+      {
+        vtkLogF(TRACE, "%s reuse-data", vtkLogIdentifier(this->Algorithm));
+      }
+      else
+      {
+        vtkLogF(TRACE, "%s execute-data", vtkLogIdentifier(this->Algorithm));
+        result = this->ExecuteData(request, inInfoVec, outInfoVec);
+      }
+      this->RecordInputDependencies(inInfoVec, result && !this->Algorithm->GetAbortOutput());
 
       // Data are now up to date.
       this->DataTime.Modified();
@@ -480,6 +599,13 @@ void vtkDemandDrivenPipeline::ExecuteDataStart(
     vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
     if (data && !outInfo->Get(DATA_NOT_GENERATED()))
     {
+      if (outInfo->Get(REUSE_OUTPUT_BUFFERS()))
+      {
+        // Keep the previous buffers alive for GetReusableArray().
+        auto previous = vtkSmartPointer<vtkDataObject>::Take(data->NewInstance());
+        previous->ShallowCopy(data);
+        outInfo->Set(PREVIOUS_OUTPUT(), previous);
+      }
       data->PrepareForNewData();
       data->CopyInformationFromPipeline(outInfo);
     }
@@ -555,6 +681,7 @@ void vtkDemandDrivenPipeline::ExecuteDataEnd(
   {
     vtkInformation* outInfo = outputs->GetInformationObject(i);
     outInfo->Remove(DATA_NOT_GENERATED());
+    outInfo->Remove(PREVIOUS_OUTPUT());
   }
 
   // Release input data if requested.
@@ -572,6 +699,162 @@ void vtkDemandDrivenPipeline::ExecuteDataEnd(
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkDemandDrivenPipeline::RecordInputDependencies(vtkInformationVector** inInfoVec, bool valid)
+{
+  auto& internals = *this->Internals;
+  internals.Valid = false;
+  internals.Inputs.clear();
+  const int numberOfPorts = this->GetNumberOfInputPorts();
+  if (!valid || numberOfPorts == 0)
+  {
+    return;
+  }
+  internals.Inputs.resize(numberOfPorts);
+  for (int port = 0; port < numberOfPorts; ++port)
+  {
+    std::set<std::string> declared;
+    if (!::GetDeclaredInputArrays(this->Algorithm, port, declared))
+    {
+      return;
+    }
+    const int numberOfConnections = inInfoVec[port]->GetNumberOfInformationObjects();
+    internals.Inputs[port].resize(numberOfConnections);
+    for (int j = 0; j < numberOfConnections; ++j)
+    {
+      vtkDataObject* data =
+        inInfoVec[port]->GetInformationObject(j)->Get(vtkDataObject::DATA_OBJECT());
+      if (!::GetInputState(data, internals.Inputs[port][j]))
+      {
+        return;
+      }
+    }
+  }
+  internals.Valid = true;
+}
+
+//------------------------------------------------------------------------------
+int vtkDemandDrivenPipeline::ReuseOutputsForUnchangedDependencies(vtkInformation* request,
+  int outputPort, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  auto& internals = *this->Internals;
+  if (!internals.Valid || this->Algorithm->GetMTime() > this->DataTime.GetMTime())
+  {
+    return 0;
+  }
+
+  // Execute when something else than the inputs requires it, such as a new
+  // update extent.
+  this->IgnorePipelineMTime = true;
+  const int needToExecute = this->NeedToExecuteData(outputPort, inInfoVec, outInfoVec);
+  this->IgnorePipelineMTime = false;
+  if (needToExecute)
+  {
+    return 0;
+  }
+
+  // Changed arrays of the first input, with their previous version.
+  std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*>> changed[vtkDataObject::FIELD + 1];
+  for (int port = 0; port < this->GetNumberOfInputPorts(); ++port)
+  {
+    std::set<std::string> declared;
+    const int numberOfConnections = inInfoVec[port]->GetNumberOfInformationObjects();
+    if (!::GetDeclaredInputArrays(this->Algorithm, port, declared) ||
+      numberOfConnections != static_cast<int>(internals.Inputs[port].size()))
+    {
+      return 0;
+    }
+    for (int j = 0; j < numberOfConnections; ++j)
+    {
+      const vtkDemandDrivenPipelineInternals::InputState& previous = internals.Inputs[port][j];
+      vtkDemandDrivenPipelineInternals::InputState current;
+      vtkDataObject* data =
+        inInfoVec[port]->GetInformationObject(j)->Get(vtkDataObject::DATA_OBJECT());
+      if (!::GetInputState(data, current) || current.Data != previous.Data ||
+        current.MeshMTime != previous.MeshMTime)
+      {
+        return 0;
+      }
+      for (int type = vtkDataObject::POINT; type <= vtkDataObject::FIELD; ++type)
+      {
+        if (current.Arrays[type].size() != previous.Arrays[type].size())
+        {
+          return 0;
+        }
+        for (const auto& entry : current.Arrays[type])
+        {
+          auto previousEntry = previous.Arrays[type].find(entry.first);
+          if (previousEntry == previous.Arrays[type].end() ||
+            previousEntry->second.Attribute != entry.second.Attribute)
+          {
+            return 0;
+          }
+          if (previousEntry->second.Array == entry.second.Array &&
+            previousEntry->second.MTime == entry.second.MTime)
+          {
+            continue;
+          }
+          const int attribute = entry.second.Attribute;
+          if (declared.count(entry.first) ||
+            (attribute >= 0 &&
+              declared.count(vtkDataSetAttributes::GetAttributeTypeAsString(attribute))))
+          {
+            return 0;
+          }
+          if (port == 0 && j == 0)
+          {
+            changed[type].push_back(
+              std::make_pair(entry.second.Array.Get(), previousEntry->second.Array.Get()));
+          }
+        }
+      }
+    }
+  }
+
+  // The outputs must share the changed arrays they hold with the input.
+  for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+  {
+    vtkDataSet* output = vtkDataSet::SafeDownCast(
+      outInfoVec->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT()));
+    if (!output)
+    {
+      return 0;
+    }
+    for (int type = vtkDataObject::POINT; type <= vtkDataObject::FIELD; ++type)
+    {
+      vtkFieldData* attributes = output->GetAttributesAsFieldData(type);
+      for (const auto& arrays : changed[type])
+      {
+        vtkAbstractArray* outputArray =
+          attributes ? attributes->GetAbstractArray(arrays.first->GetName()) : nullptr;
+        if (outputArray && (!arrays.second || outputArray != arrays.second))
+        {
+          return 0;
+        }
+      }
+    }
+  }
+
+  // Pass the new version of the changed arrays.
+  for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+  {
+    vtkDataSet* output = vtkDataSet::GetData(outInfoVec, i);
+    for (int type = vtkDataObject::POINT; type <= vtkDataObject::FIELD; ++type)
+    {
+      vtkFieldData* attributes = output->GetAttributesAsFieldData(type);
+      for (const auto& arrays : changed[type])
+      {
+        if (attributes && attributes->GetAbstractArray(arrays.first->GetName()))
+        {
+          attributes->AddArray(arrays.first);
+        }
+      }
+    }
+  }
+  this->MarkOutputsGenerated(request, inInfoVec, outInfoVec);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkDemandDrivenPipeline::MarkOutputsGenerated(
   vtkInformation*, vtkInformationVector** /* inInfoVec */, vtkInformationVector* outputs)
@@ -996,7 +1279,7 @@ int vtkDemandDrivenPipeline ::NeedToExecuteData(
   // last execution then we must execute.  This is a shortcut for most
   // filters since all outputs will have the same UpdateTime.  This
   // also handles the case in which there are no outputs.
-  if (this->PipelineMTime > this->DataTime.GetMTime())
+  if (!this->IgnorePipelineMTime && this->PipelineMTime > this->DataTime.GetMTime())
   {
     return 1;
   }
@@ -1014,7 +1297,7 @@ int vtkDemandDrivenPipeline ::NeedToExecuteData(
     // If the output on the port making the request is out-of-date
     // then we must execute.
     vtkDataObject* data = info->Get(vtkDataObject::DATA_OBJECT());
-    if (!data || this->PipelineMTime > data->GetUpdateTime())
+    if (!data || (!this->IgnorePipelineMTime && this->PipelineMTime > data->GetUpdateTime()))
     {
       return 1;
     }
@@ -1065,4 +1348,55 @@ vtkTypeBool vtkDemandDrivenPipeline::GetReleaseDataFlag(int port)
   }
   return info->Get(RELEASE_DATA());
 }
+
+//------------------------------------------------------------------------------
+int vtkDemandDrivenPipeline::SetReuseOutputBuffers(int port, vtkTypeBool n)
+{
+  if (!this->OutputPortIndexInRange(port, "set reuse output buffers flag on"))
+  {
+    return 0;
+  }
+  vtkInformation* info = this->GetOutputInformation(port);
+  if (this->GetReuseOutputBuffers(port) != n)
+  {
+    info->Set(REUSE_OUTPUT_BUFFERS(), n);
+    return 1;
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeBool vtkDemandDrivenPipeline::GetReuseOutputBuffers(int port)
+{
+  if (!this->OutputPortIndexInRange(port, "get reuse output buffers flag from"))
+  {
+    return 0;
+  }
+  return this->GetOutputInformation(port)->Get(REUSE_OUTPUT_BUFFERS());
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> vtkDemandDrivenPipeline::GetReusableArray(vtkInformation* outInfo,
+  int attributeType, const char* name, int dataType, int numberOfComponents)
+{
+  vtkDataObject* previous = outInfo ? outInfo->Get(PREVIOUS_OUTPUT()) : nullptr;
+  vtkFieldData* attributes = previous ? previous->GetAttributesAsFieldData(attributeType) : nullptr;
+  if (!attributes || !name)
+  {
+    return nullptr;
+  }
+  int index;
+  vtkDataArray* array = attributes->GetArray(name, index);
+  // The previous output is the only owner of arrays that nobody else uses.
+  if (!array || array->GetDataType() != dataType ||
+    array->GetNumberOfComponents() != numberOfComponents || array->GetReferenceCount() != 1)
+  {
+    return nullptr;
+  }
+  vtkSmartPointer<vtkDataArray> reusable = array;
+  attributes->RemoveArray(index);
+  // Its values are about to be overwritten.
+  reusable->Modified();
+  return reusable;
+}
 VTK_ABI_NAMESPACE_END
@@ -14,6 +14,7 @@
 
 #include "vtkCommonExecutionModelModule.h" // For export macro
 #include "vtkExecutive.h"
+#include "vtkSmartPointer.h"  // For vtkSmartPointer
 #include "vtkWrappingHints.h" // For VTK_MARSHALAUTO
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -23,6 +24,7 @@ class vtkDataSetAttributes;
 class vtkDemandDrivenPipelineInternals;
 class vtkFieldData;
 class vtkInformation;
+class vtkInformationDataObjectKey;
 class vtkInformationIntegerKey;
 class vtkInformationVector;
 class vtkInformationKeyVectorKey;
@@ -82,6 +84,32 @@ public:
    */
   virtual vtkTypeBool GetReleaseDataFlag(int port);
 
+  /**
+   * Set whether the data object of the given output port keeps its buffers
+   * available to the algorithm when it re-executes, see GetReusableArray().
+   * Returns 1 if the value changes and 0 otherwise.
+   */
+  virtual int SetReuseOutputBuffers(int port, vtkTypeBool n);
+
+  /**
+   * Get whether the data object of the given output port keeps its buffers
+   * available to the algorithm when it re-executes.
+   */
+  virtual vtkTypeBool GetReuseOutputBuffers(int port);
+
+  /**
+   * Return the array named `name` of the attributes `attributeType` (see
+   * vtkDataObject::AttributeTypes) of the previous output of the port described
+   * by `outInfo`, or nullptr when there is no such array with the data type
+   * `dataType` and `numberOfComponents` components. Only arrays no longer used
+   * by anyone else are returned, so the algorithm may overwrite them, and resize
+   * them with SetNumberOfTuples() without allocating new memory when their
+   * capacity suffices. The previous output is only available during REQUEST_DATA
+   * for the ports whose ReuseOutputBuffers flag is on.
+   */
+  static vtkSmartPointer<vtkDataArray> GetReusableArray(vtkInformation* outInfo,
+    int attributeType, const char* name, int dataType, int numberOfComponents);
+
   /**
    * Bring the PipelineMTime up to date.
    */
@@ -138,6 +166,20 @@ public:
    */
   static vtkInformationIntegerKey* RELEASE_DATA();
 
+  /**
+   * Key to specify in pipeline information that the buffers of the previous
+   * output be handed to the algorithm when it re-executes.
+   * @ingroup InformationKeys
+   */
+  static vtkInformationIntegerKey* REUSE_OUTPUT_BUFFERS();
+
+  /**
+   * Key storing, in the output information during REQUEST_DATA, a shallow copy
+   * of the previous output when REUSE_OUTPUT_BUFFERS is set.
+   * @ingroup InformationKeys
+   */
+  static vtkInformationDataObjectKey* PREVIOUS_OUTPUT();
+
   /**
    * Key to store a mark for an output that will not be generated.
    * Algorithms use this to tell the executive that they will not
@@ -195,6 +237,15 @@ protected:
   virtual int NeedToExecuteData(
     int outputPort, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec);
 
+  // Update the outputs without executing the algorithm when only input arrays
+  // it does not depend on changed since its last execution, see
+  // vtkAlgorithm::DeclareInputArrays(). Return 1 when the outputs are updated.
+  virtual int ReuseOutputsForUnchangedDependencies(vtkInformation* request, int outputPort,
+    vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec);
+
+  // Record the state of the inputs used by ReuseOutputsForUnchangedDependencies.
+  void RecordInputDependencies(vtkInformationVector** inInfoVec, bool valid);
+
   // Handle before/after operations for ExecuteData method.
   virtual void ExecuteDataStart(
     vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec);
@@ -219,6 +270,9 @@ protected:
   vtkInformation* DataRequest;
 
 private:
+  vtkDemandDrivenPipelineInternals* Internals;
+  bool IgnorePipelineMTime = false;
+
   vtkDemandDrivenPipeline(const vtkDemandDrivenPipeline&) = delete;
   void operator=(const vtkDemandDrivenPipeline&) = delete;
 };
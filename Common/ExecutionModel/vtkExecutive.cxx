@@ -14,6 +14,7 @@
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 
 #include <sstream>
@@ -720,7 +721,11 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
 
   // Invoke the request on the algorithm.
   this->InAlgorithm = 1;
-  int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  int result;
+  {
+    vtkPipelineProfilerScope profilerScope(this->Algorithm, request, outInfo);
+    result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  }
   this->InAlgorithm = 0;
 
   // If the algorithm failed report it now.
@@ -0,0 +1,347 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationIterator.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <vtksys/FStream.hxx>
+
+//------------------------------------------------------------------------------
+namespace
+{
+std::atomic<vtkPipelineProfiler*> StartedProfiler(nullptr);
+
+//------------------------------------------------------------------------------
+std::string EscapeJSON(const std::string& text)
+{
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (char c : text)
+  {
+    if (c == '"' || c == '\\')
+    {
+      escaped += '\\';
+      escaped += c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      escaped += ' ';
+    }
+    else
+    {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+//------------------------------------------------------------------------------
+// Return the name of the request key of a pipeline request, such as
+// REQUEST_DATA.
+std::string GetPassName(vtkInformation* request)
+{
+  vtkNew<vtkInformationIterator> iter;
+  iter->SetInformationWeak(request);
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkInformationKey* key = iter->GetCurrentKey();
+    if (vtkInformationRequestKey::SafeDownCast(key))
+    {
+      return key->GetName();
+    }
+  }
+  return "UNKNOWN_REQUEST";
+}
+}
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+class vtkPipelineProfiler::vtkInternals
+{
+public:
+  struct Event
+  {
+    std::string Name;
+    std::string Category;
+    double Start;
+    double End;
+    double CPUTime;
+    int Thread;
+    long long OutputBytes;
+  };
+
+  void Add(Event&& event)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto thread = this->Threads.insert(
+      std::make_pair(std::this_thread::get_id(), static_cast<int>(this->Threads.size())));
+    event.Thread = thread.first->second;
+    this->Events.push_back(std::move(event));
+  }
+
+  std::mutex Mutex;
+  std::vector<Event> Events;
+  std::map<std::thread::id, int> Threads;
+};
+
+vtkStandardNewMacro(vtkPipelineProfiler);
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler()
+  : Internals(new vtkInternals())
+{
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler()
+{
+  this->Stop();
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Start()
+{
+  ::StartedProfiler = this;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Stop()
+{
+  vtkPipelineProfiler* self = this;
+  ::StartedProfiler.compare_exchange_strong(self, nullptr);
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineProfiler::IsStarted()
+{
+  return ::StartedProfiler == this;
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler* vtkPipelineProfiler::GetStartedProfiler()
+{
+  return ::StartedProfiler;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Events.clear();
+  this->Internals->Threads.clear();
+}
+
+//------------------------------------------------------------------------------
+int vtkPipelineProfiler::GetNumberOfEvents()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return static_cast<int>(this->Internals->Events.size());
+}
+
+//------------------------------------------------------------------------------
+double vtkPipelineProfiler::GetTime()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::AddEvent(
+  const std::string& name, const std::string& category, double start, double end)
+{
+  this->Internals->Add(vtkInternals::Event{ name, category, start, end, -1.0, 0, -1 });
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineProfiler::WriteChromeTrace(const char* fileName)
+{
+  if (!fileName)
+  {
+    vtkErrorMacro(<< "No file name to write the trace to.");
+    return false;
+  }
+  vtksys::ofstream file(fileName);
+  if (!file)
+  {
+    vtkErrorMacro(<< "Cannot open " << fileName << " for writing.");
+    return false;
+  }
+  this->PrintChromeTrace(file);
+  file.close();
+  if (file.fail())
+  {
+    vtkErrorMacro(<< "Cannot write " << fileName << ".");
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintChromeTrace(ostream& os)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  const auto& events = this->Internals->Events;
+  double origin = 0.0;
+  if (!events.empty())
+  {
+    origin = std::min_element(events.begin(), events.end(),
+      [](const vtkInternals::Event& a, const vtkInternals::Event& b)
+      { return a.Start < b.Start; })->Start;
+  }
+
+  // Timestamps and durations are in microseconds.
+  std::ios::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+  os << std::fixed << std::setprecision(3);
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  const char* separator = "\n";
+  for (const auto& event : events)
+  {
+    os << separator << "{\"name\":\"" << ::EscapeJSON(event.Name) << "\",\"cat\":\""
+       << ::EscapeJSON(event.Category) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.Thread
+       << ",\"ts\":" << (event.Start - origin) * 1e6
+       << ",\"dur\":" << (event.End - event.Start) * 1e6 << ",\"args\":{";
+    const char* argSeparator = "";
+    if (event.CPUTime >= 0.0)
+    {
+      os << "\"cpu_time_us\":" << event.CPUTime * 1e6;
+      if (event.End > event.Start)
+      {
+        os << ",\"thread_utilization\":" << event.CPUTime / (event.End - event.Start);
+      }
+      argSeparator = ",";
+    }
+    if (event.OutputBytes >= 0)
+    {
+      os << argSeparator << "\"output_bytes\":" << event.OutputBytes;
+    }
+    os << "}}";
+    separator = ",\n";
+  }
+  os << "\n]}\n";
+  os.flags(flags);
+  os.precision(precision);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSummary(ostream& os)
+{
+  struct Total
+  {
+    double WallTime = 0.0;
+    double CPUTime = 0.0;
+    int Count = 0;
+  };
+  std::map<std::pair<std::string, std::string>, Total> totals;
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    for (const auto& event : this->Internals->Events)
+    {
+      Total& total = totals[std::make_pair(event.Name, event.Category)];
+      total.WallTime += event.End - event.Start;
+      total.CPUTime += std::max(event.CPUTime, 0.0);
+      ++total.Count;
+    }
+  }
+  std::vector<std::pair<std::pair<std::string, std::string>, Total>> sorted(
+    totals.begin(), totals.end());
+  std::sort(sorted.begin(), sorted.end(),
+    [](const std::pair<std::pair<std::string, std::string>, Total>& a,
+      const std::pair<std::pair<std::string, std::string>, Total>& b) {
+      return a.second.WallTime > b.second.WallTime;
+    });
+
+  std::ios::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+  os << std::fixed << std::setprecision(6);
+  for (const auto& entry : sorted)
+  {
+    os << entry.first.first << " " << entry.first.second << ": " << entry.second.WallTime
+       << " s wall, " << entry.second.CPUTime << " s CPU, " << entry.second.Count
+       << (entry.second.Count > 1 ? " calls\n" : " call\n");
+  }
+  os.flags(flags);
+  os.precision(precision);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Started: " << (this->IsStarted() ? "true" : "false") << "\n";
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << "\n";
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfilerScope::vtkPipelineProfilerScope(
+  vtkAlgorithm* algorithm, vtkInformation* request, vtkInformationVector* outInfo)
+  : Profiler(vtkPipelineProfiler::GetStartedProfiler())
+{
+  if (!this->Profiler)
+  {
+    return;
+  }
+  // Keep the profiler alive while the algorithm executes.
+  this->Profiler->Register(nullptr);
+  this->Algorithm = algorithm;
+  this->Request = request;
+  this->OutputInformation = outInfo;
+  this->StartCPUTime = vtkTimerLog::GetCPUTime();
+  this->StartTime = vtkPipelineProfiler::GetTime();
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfilerScope::~vtkPipelineProfilerScope()
+{
+  if (!this->Profiler)
+  {
+    return;
+  }
+  vtkPipelineProfiler::vtkInternals::Event event;
+  event.End = vtkPipelineProfiler::GetTime();
+  event.CPUTime = vtkTimerLog::GetCPUTime() - this->StartCPUTime;
+  event.Start = this->StartTime;
+  event.Thread = 0;
+  event.Name = this->Algorithm->GetObjectDescription();
+  event.Category = ::GetPassName(this->Request);
+  event.OutputBytes = -1;
+  if (this->Request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    event.OutputBytes = 0;
+    for (int i = 0; this->OutputInformation &&
+         i < this->OutputInformation->GetNumberOfInformationObjects();
+         ++i)
+    {
+      vtkDataObject* output =
+        this->OutputInformation->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+      if (output)
+      {
+        // The memory size is given in KiB.
+        event.OutputBytes += static_cast<long long>(output->GetActualMemorySize()) * 1024;
+      }
+    }
+  }
+  this->Profiler->Internals->Add(std::move(event));
+  this->Profiler->UnRegister(nullptr);
+}
+VTK_ABI_NAMESPACE_END
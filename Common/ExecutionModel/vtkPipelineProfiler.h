@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPipelineProfiler
+ * @brief   record the execution of every algorithm of the pipelines
+ *
+ * While a vtkPipelineProfiler is started, the executives record each pipeline
+ * pass they invoke on their algorithm, such as REQUEST_INFORMATION or
+ * REQUEST_DATA. An event holds the algorithm, the pass, the thread, the wall
+ * clock time and the process CPU time spent in the algorithm and, for the
+ * REQUEST_DATA pass, the memory size of the outputs.
+ *
+ * The ratio of CPU time to wall clock time gives the thread utilization of an
+ * algorithm running vtkSMPTools regions. As the CPU time is measured for the
+ * whole process, this ratio is overestimated for algorithms running
+ * concurrently with others, for instance with vtkThreadedBranchPipeline.
+ *
+ * Other code, for instance MPI communication in a parallel application, can
+ * add custom events with AddEvent() and GetTime().
+ *
+ * The events can be exported as a Chrome trace, which can be opened with
+ * Perfetto or chrome://tracing, or summarized per algorithm with
+ * PrintSummary().
+ *
+ * Only one profiler can be started at a time. Starting a profiler stops the
+ * one previously started. A profiler must be stopped before being destroyed
+ * while pipelines execute in other threads.
+ *
+ * @code{.cpp}
+ * vtkNew<vtkPipelineProfiler> profiler;
+ * profiler->Start();
+ * mapper->Update();
+ * profiler->Stop();
+ * profiler->WriteChromeTrace("pipeline.json");
+ * @endcode
+ *
+ * @sa vtkExecutionTimer vtkLogger
+ */
+
+#ifndef vtkPipelineProfiler_h
+#define vtkPipelineProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+#include "vtkWrappingHints.h" // For VTK_WRAPEXCLUDE
+
+#include <string> // For std::string
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkInformation;
+class vtkInformationVector;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineProfiler : public vtkObject
+{
+public:
+  static vtkPipelineProfiler* New();
+  vtkTypeMacro(vtkPipelineProfiler, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Start recording the pipeline executions. The events recorded previously
+   * are kept, call Clear() to remove them.
+   */
+  void Start();
+
+  /**
+   * Stop recording the pipeline executions.
+   */
+  void Stop();
+
+  /**
+   * Return true when this profiler records the pipeline executions.
+   */
+  bool IsStarted();
+
+  /**
+   * Return the started profiler, or nullptr when no profiler is started.
+   */
+  static vtkPipelineProfiler* GetStartedProfiler();
+
+  /**
+   * Remove all the recorded events.
+   */
+  void Clear();
+
+  /**
+   * Return the number of recorded events.
+   */
+  int GetNumberOfEvents();
+
+  /**
+   * Return the time in seconds used to timestamp the events.
+   */
+  static double GetTime();
+
+  /**
+   * Record a custom event named `name` in the category `category`, for instance
+   * "MPI", that started at `start` and ended at `end` on the calling thread.
+   * Times are given by GetTime().
+   */
+  void AddEvent(const std::string& name, const std::string& category, double start, double end);
+
+  ///@{
+  /**
+   * Write the recorded events in the Chrome trace event JSON format, which can
+   * be loaded by Perfetto or chrome://tracing. Return false when the file cannot
+   * be written.
+   */
+  bool WriteChromeTrace(const char* fileName);
+  void PrintChromeTrace(ostream& os);
+  ///@}
+
+  /**
+   * Print the wall clock time, CPU time and number of invocations of each
+   * algorithm and pass, sorted by decreasing wall clock time.
+   */
+  void PrintSummary(ostream& os);
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler() override;
+
+private:
+  vtkPipelineProfiler(const vtkPipelineProfiler&) = delete;
+  void operator=(const vtkPipelineProfiler&) = delete;
+
+  friend class vtkPipelineProfilerScope;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+/**
+ * Record the invocation of a pipeline pass on an algorithm in the started
+ * vtkPipelineProfiler, if any, from its construction to its destruction. Used by
+ * the executives around the calls to vtkAlgorithm::ProcessRequest.
+ */
+class VTKCOMMONEXECUTIONMODEL_EXPORT VTK_WRAPEXCLUDE vtkPipelineProfilerScope
+{
+public:
+  vtkPipelineProfilerScope(
+    vtkAlgorithm* algorithm, vtkInformation* request, vtkInformationVector* outInfo);
+  ~vtkPipelineProfilerScope();
+
+private:
+  vtkPipelineProfilerScope(const vtkPipelineProfilerScope&) = delete;
+  void operator=(const vtkPipelineProfilerScope&) = delete;
+
+  vtkPipelineProfiler* Profiler;
+  vtkAlgorithm* Algorithm = nullptr;
+  vtkInformation* Request = nullptr;
+  vtkInformationVector* OutputInformation = nullptr;
+  double StartTime = 0.0;
+  double StartCPUTime = 0.0;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkThreadedBranchPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkAlgorithmOutput.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------
+namespace
+{
+struct vtkBranch
+{
+  vtkExecutive* Producer;
+  int ProducerPort;
+};
+
+//------------------------------------------------------------------------------
+// Insert `executive` and all the executives upstream of it in `upstream`.
+void CollectUpstream(vtkExecutive* executive, std::set<vtkExecutive*>& upstream)
+{
+  if (!executive || !upstream.insert(executive).second)
+  {
+    return;
+  }
+  vtkAlgorithm* algorithm = executive->GetAlgorithm();
+  for (int i = 0; algorithm && i < algorithm->GetNumberOfInputPorts(); ++i)
+  {
+    for (int j = 0; j < algorithm->GetNumberOfInputConnections(i); ++j)
+    {
+      ::CollectUpstream(executive->GetInputExecutive(i, j), upstream);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Return the representative of the group of branch `i`.
+std::size_t FindGroup(std::vector<std::size_t>& groupOf, std::size_t i)
+{
+  while (groupOf[i] != i)
+  {
+    groupOf[i] = groupOf[groupOf[i]];
+    i = groupOf[i];
+  }
+  return i;
+}
+
+//------------------------------------------------------------------------------
+// Merge the groups of branches `i` and `j`.
+void MergeGroups(std::vector<std::size_t>& groupOf, std::size_t i, std::size_t j)
+{
+  i = ::FindGroup(groupOf, i);
+  j = ::FindGroup(groupOf, j);
+  groupOf[std::max(i, j)] = std::min(i, j);
+}
+
+//------------------------------------------------------------------------------
+// Forward `request` to the output port `port` of `executive`.
+int ProcessBranchRequest(vtkInformation* request, vtkExecutive* executive, int port)
+{
+  request->Set(vtkExecutive::FROM_OUTPUT_PORT(), port);
+  return executive->ProcessRequest(
+    request, executive->GetInputInformation(), executive->GetOutputInformation());
+}
+}
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkThreadedBranchPipeline);
+
+//------------------------------------------------------------------------------
+vtkThreadedBranchPipeline::vtkThreadedBranchPipeline() = default;
+
+//------------------------------------------------------------------------------
+vtkThreadedBranchPipeline::~vtkThreadedBranchPipeline() = default;
+
+//------------------------------------------------------------------------------
+int vtkThreadedBranchPipeline::ForwardUpstream(vtkInformation* request)
+{
+  // Only the data pass is worth running concurrently, the other passes are
+  // cheap and must keep their ordering.
+  if (!request->Has(REQUEST_DATA()) || this->SharedInputInformation || !this->Algorithm)
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  std::vector<vtkBranch> branches;
+  for (int i = 0; i < this->GetNumberOfInputPorts(); ++i)
+  {
+    for (int j = 0; j < this->Algorithm->GetNumberOfInputConnections(i); ++j)
+    {
+      vtkExecutive* producer = this->GetInputExecutive(i, j);
+      if (producer)
+      {
+        branches.push_back(
+          vtkBranch{ producer, this->Algorithm->GetInputConnection(i, j)->GetIndex() });
+      }
+    }
+  }
+  if (branches.size() < 2)
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  // Group the branches whose upstream pipelines share an executive. Even an
+  // up to date executive writes to its output information when it processes
+  // the request, so the branches of a group must not be updated concurrently:
+  // they are updated one after the other by a single task. Different groups
+  // share nothing and are updated in parallel.
+  std::vector<std::size_t> groupOf(branches.size());
+  std::map<vtkExecutive*, std::size_t> owners;
+  for (std::size_t i = 0; i < branches.size(); ++i)
+  {
+    groupOf[i] = i;
+    std::set<vtkExecutive*> upstream;
+    ::CollectUpstream(branches[i].Producer, upstream);
+    for (vtkExecutive* executive : upstream)
+    {
+      auto owner = owners.insert(std::make_pair(executive, i));
+      if (!owner.second)
+      {
+        ::MergeGroups(groupOf, owner.first->second, i);
+      }
+    }
+  }
+  std::map<std::size_t, std::vector<std::size_t>> groupMap;
+  for (std::size_t i = 0; i < branches.size(); ++i)
+  {
+    groupMap[::FindGroup(groupOf, i)].push_back(i);
+  }
+  if (groupMap.size() < 2)
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+  std::vector<std::vector<std::size_t>> groups;
+  groups.reserve(groupMap.size());
+  for (auto& group : groupMap)
+  {
+    groups.push_back(std::move(group.second));
+  }
+
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+  {
+    return 0;
+  }
+
+  // Each branch gets its own copy of the request since executives modify the
+  // request while processing it.
+  std::vector<vtkSmartPointer<vtkInformation>> requests(branches.size());
+  for (auto& branchRequest : requests)
+  {
+    branchRequest = vtkSmartPointer<vtkInformation>::New();
+    branchRequest->Copy(request);
+  }
+  std::atomic<int> result(1);
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(groups.size()), 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType g = begin; g < end; ++g)
+      {
+        for (const std::size_t i : groups[g])
+        {
+          if (!::ProcessBranchRequest(requests[i], branches[i].Producer, branches[i].ProducerPort))
+          {
+            result = 0;
+          }
+        }
+      }
+    });
+
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+  {
+    return 0;
+  }
+
+  return result.load();
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedBranchPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
+VTK_ABI_NAMESPACE_END
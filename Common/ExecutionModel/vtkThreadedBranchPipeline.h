@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkThreadedBranchPipeline
+ * @brief   Executive that updates independent input branches in parallel
+ *
+ * vtkThreadedBranchPipeline is a vtkCompositeDataPipeline that forwards the
+ * REQUEST_DATA pass to its input connections concurrently using the SMP
+ * framework. It is meant for algorithms that join several independent
+ * branches of a pipeline, for instance an append filter fed by the contours of
+ * several readers.
+ *
+ * Before running the branches, the executive walks the upstream pipeline of
+ * each input connection and groups the connections whose upstream pipelines
+ * share an executive, such as a common reader. An executive writes to its
+ * output information whenever it processes a request, even when its data is up
+ * to date, so the branches of a group are updated one after the other by a
+ * single task. The groups do not share any pipeline state and are updated
+ * concurrently with vtkSMPTools::For. When all the connections form one group,
+ * the request is forwarded serially as with the superclass. The
+ * REQUEST_DATA_OBJECT, REQUEST_INFORMATION and REQUEST_UPDATE_EXTENT passes are
+ * always forwarded serially, so that their ordering is preserved.
+ *
+ * The algorithms of the branches, and the observers of their events such as
+ * progress, must be safe to run concurrently with the algorithms of the other
+ * branches. Nested vtkSMPTools calls made by these algorithms run according to
+ * the nested parallelism setting of the SMP backend.
+ *
+ * The executive may be set on the joining algorithm with
+ * vtkAlgorithm::SetExecutive, or as the default executive of all the
+ * algorithms with vtkAlgorithm::SetDefaultExecutivePrototype.
+ *
+ * @sa vtkThreadedCompositeDataPipeline vtkSMPTools
+ */
+
+#ifndef vtkThreadedBranchPipeline_h
+#define vtkThreadedBranchPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkThreadedBranchPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkThreadedBranchPipeline* New();
+  vtkTypeMacro(vtkThreadedBranchPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+protected:
+  vtkThreadedBranchPipeline();
+  ~vtkThreadedBranchPipeline() override;
+
+  int ForwardUpstream(vtkInformation* request) override;
+  using Superclass::ForwardUpstream;
+
+private:
+  vtkThreadedBranchPipeline(const vtkThreadedBranchPipeline&) = delete;
+  void operator=(const vtkThreadedBranchPipeline&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -20,6 +20,7 @@
 #include "vtkImageData.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 #include "vtkTimerLog.h"
 
@@ -265,7 +266,11 @@ int vtkThreadedCompositeDataPipeline::CallAlgorithm(vtkInformation* request, int
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
-  int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  int result;
+  {
+    vtkPipelineProfilerScope profilerScope(this->Algorithm, request, outInfo);
+    result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  }
 
   // If the algorithm failed report it now.
   if (!result)
@@ -0,0 +1,298 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded copy of the inputs of vtkAppendPolyData and
+// vtkAppendFilter places the points, cells and attributes of each input at
+// the right offsets of the output.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Create a polydata with verts, lines, polys and strips and with point and
+// cell arrays, including a string array and a bit array.
+void CreateInput(vtkPolyData* pd, int index)
+{
+  const vtkIdType numPts = 50 + 10 * index;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  vtkNew<vtkStringArray> pointNames;
+  pointNames->SetName("PointNames");
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    points->InsertNextPoint(static_cast<double>(i), static_cast<double>(index), 0.0);
+    pointScalars->InsertNextValue(static_cast<float>(1000 * index + i));
+    pointNames->InsertNextValue(std::to_string(index) + "_" + std::to_string(i));
+  }
+  pd->SetPoints(points);
+  pd->GetPointData()->SetScalars(pointScalars);
+  pd->GetPointData()->AddArray(pointNames);
+
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> strips;
+  for (vtkIdType i = 0; i + 3 < numPts; i += 4)
+  {
+    const vtkIdType ids[4] = { i, i + 1, i + 2, i + 3 };
+    verts->InsertNextCell(1, ids);
+    if (index != 1)
+    {
+      lines->InsertNextCell(2, ids);
+    }
+    polys->InsertNextCell(3 + (i / 4) % 2, ids);
+    strips->InsertNextCell(4, ids);
+  }
+  pd->SetVerts(verts);
+  pd->SetLines(lines);
+  pd->SetPolys(polys);
+  pd->SetStrips(strips);
+
+  const vtkIdType numCells = pd->GetNumberOfCells();
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  vtkNew<vtkBitArray> cellBits;
+  cellBits->SetName("CellBits");
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    cellIds->InsertNextValue(1000 * index + i);
+    cellBits->InsertNextValue(static_cast<int>((index + i) % 2));
+  }
+  pd->GetCellData()->AddArray(cellIds);
+  pd->GetCellData()->AddArray(cellBits);
+}
+
+//------------------------------------------------------------------------------
+// Check that the point ptId of input is the point outPtId of output.
+bool CheckPoint(vtkDataSet* input, vtkIdType ptId, vtkDataSet* output, vtkIdType outPtId)
+{
+  double x[3], y[3];
+  input->GetPoint(ptId, x);
+  output->GetPoint(outPtId, y);
+  auto inScalars = input->GetPointData()->GetArray("PointScalars");
+  auto outScalars = output->GetPointData()->GetArray("PointScalars");
+  auto inNames =
+    vtkStringArray::SafeDownCast(input->GetPointData()->GetAbstractArray("PointNames"));
+  auto outNames =
+    vtkStringArray::SafeDownCast(output->GetPointData()->GetAbstractArray("PointNames"));
+  if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+    (outScalars && inScalars->GetTuple1(ptId) != outScalars->GetTuple1(outPtId)) ||
+    (outNames && inNames->GetValue(ptId) != outNames->GetValue(outPtId)))
+  {
+    std::cerr << "Wrong output point " << outPtId << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Check that the cell cellId of input, whose points start at ptOffset in the
+// output, is the cell outCellId of output.
+bool CheckCell(vtkDataSet* input, vtkIdType cellId, vtkIdType ptOffset, vtkDataSet* output,
+  vtkIdType outCellId)
+{
+  vtkNew<vtkIdList> ptIds;
+  vtkNew<vtkIdList> outPtIds;
+  input->GetCellPoints(cellId, ptIds);
+  output->GetCellPoints(outCellId, outPtIds);
+  bool same = input->GetCellType(cellId) == output->GetCellType(outCellId) &&
+    ptIds->GetNumberOfIds() == outPtIds->GetNumberOfIds();
+  for (vtkIdType i = 0; same && i < ptIds->GetNumberOfIds(); ++i)
+  {
+    same = ptIds->GetId(i) + ptOffset == outPtIds->GetId(i);
+  }
+  auto inIds = input->GetCellData()->GetArray("CellIds");
+  auto outIds = output->GetCellData()->GetArray("CellIds");
+  auto inBits = vtkBitArray::SafeDownCast(input->GetCellData()->GetAbstractArray("CellBits"));
+  auto outBits = vtkBitArray::SafeDownCast(output->GetCellData()->GetAbstractArray("CellBits"));
+  if (!same || (outIds && inIds->GetTuple1(cellId) != outIds->GetTuple1(outCellId)) ||
+    (outBits && inBits->GetValue(cellId) != outBits->GetValue(outCellId)))
+  {
+    std::cerr << "Wrong output cell " << outCellId << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestPolyData(const std::vector<vtkPolyData*>& inputs)
+{
+  vtkNew<vtkAppendPolyData> append;
+  for (vtkPolyData* input : inputs)
+  {
+    append->AddInputData(input);
+  }
+  append->Update();
+  vtkPolyData* output = append->GetOutput();
+
+  // The points of the inputs follow each other, and so do the cells of each
+  // type: all the verts, then all the lines, the polys and the strips.
+  vtkIdType outPtId = 0;
+  for (vtkPolyData* input : inputs)
+  {
+    for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId, ++outPtId)
+    {
+      if (!CheckPoint(input, ptId, output, outPtId))
+      {
+        return false;
+      }
+    }
+  }
+  if (outPtId != output->GetNumberOfPoints())
+  {
+    std::cerr << "Wrong number of points: " << output->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+
+  vtkIdType outCellId = 0;
+  for (int type = 0; type < 4; ++type)
+  {
+    vtkIdType ptOffset = 0;
+    for (vtkPolyData* input : inputs)
+    {
+      vtkCellArray* arrays[4] = { input->GetVerts(), input->GetLines(), input->GetPolys(),
+        input->GetStrips() };
+      // Cells of each type are numbered after the cells of the previous types.
+      vtkIdType cellId = 0;
+      for (int previous = 0; previous < type; ++previous)
+      {
+        cellId += arrays[previous]->GetNumberOfCells();
+      }
+      for (vtkIdType i = 0; i < arrays[type]->GetNumberOfCells(); ++i, ++cellId, ++outCellId)
+      {
+        if (!CheckCell(input, cellId, ptOffset, output, outCellId))
+        {
+          return false;
+        }
+      }
+      ptOffset += input->GetNumberOfPoints();
+    }
+  }
+  if (outCellId != output->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of cells: " << output->GetNumberOfCells() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestUnstructuredGrid(const std::vector<vtkDataSet*>& inputs)
+{
+  vtkNew<vtkAppendFilter> append;
+  for (vtkDataSet* input : inputs)
+  {
+    append->AddInputData(input);
+  }
+  append->Update();
+  vtkUnstructuredGrid* output = append->GetOutput();
+
+  vtkIdType outPtId = 0;
+  vtkIdType outCellId = 0;
+  for (vtkDataSet* input : inputs)
+  {
+    const vtkIdType ptOffset = outPtId;
+    for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId, ++outPtId)
+    {
+      if (!CheckPoint(input, ptId, output, outPtId))
+      {
+        return false;
+      }
+    }
+    for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId, ++outCellId)
+    {
+      if (!CheckCell(input, cellId, ptOffset, output, outCellId))
+      {
+        return false;
+      }
+    }
+  }
+  if (outPtId != output->GetNumberOfPoints() || outCellId != output->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of points or cells: " << output->GetNumberOfPoints() << ", "
+              << output->GetNumberOfCells() << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestAppendThreaded(int, char*[])
+{
+  const int numInputs = 8;
+  std::vector<vtkNew<vtkPolyData>> polyDatas(numInputs);
+  std::vector<vtkNew<vtkUnstructuredGrid>> grids(numInputs);
+  std::vector<vtkPolyData*> pdInputs;
+  std::vector<vtkDataSet*> ugInputs;
+  for (int i = 0; i < numInputs; ++i)
+  {
+    CreateInput(polyDatas[i], i);
+    pdInputs.push_back(polyDatas[i]);
+
+    vtkNew<vtkIdList> ids;
+    grids[i]->SetPoints(polyDatas[i]->GetPoints());
+    grids[i]->Allocate(polyDatas[i]->GetNumberOfCells());
+    for (vtkIdType cellId = 0; cellId < polyDatas[i]->GetNumberOfCells(); ++cellId)
+    {
+      polyDatas[i]->GetCellPoints(cellId, ids);
+      grids[i]->InsertNextCell(polyDatas[i]->GetCellType(cellId), ids);
+    }
+    grids[i]->GetPointData()->ShallowCopy(polyDatas[i]->GetPointData());
+    grids[i]->GetCellData()->ShallowCopy(polyDatas[i]->GetCellData());
+    ugInputs.push_back(grids[i]);
+  }
+
+  if (!TestPolyData(pdInputs))
+  {
+    std::cerr << "vtkAppendPolyData failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A single non-empty input is passed through.
+  vtkNew<vtkPolyData> empty;
+  if (!TestPolyData({ empty, pdInputs[2], empty }))
+  {
+    std::cerr << "vtkAppendPolyData failed with a single non-empty input." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Unstructured grids are copied concurrently.
+  if (!TestUnstructuredGrid(ugInputs))
+  {
+    std::cerr << "vtkAppendFilter failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Other datasets use the serial copy of the cells.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(4, 5, 6);
+  ugInputs.insert(ugInputs.begin() + 3, image);
+  if (!TestUnstructuredGrid(ugInputs))
+  {
+    std::cerr << "vtkAppendFilter failed with an image input." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
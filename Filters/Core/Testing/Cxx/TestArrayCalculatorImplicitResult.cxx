@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <vtkArrayCalculator.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// Run three chained calculators with stored or implicit results.
+vtkSmartPointer<vtkPolyData> RunCalculators(vtkPolyData* input,
+  vtkArrayCalculator::FunctionParserTypes parserType, bool implicitResult)
+{
+  vtkNew<vtkArrayCalculator> calc;
+  calc->SetInputData(input);
+  calc->SetFunctionParserType(parserType);
+  calc->SetImplicitResult(implicitResult);
+  calc->SetAttributeTypeToPointData();
+  calc->AddScalarArrayName("Temp");
+  calc->AddCoordinateScalarVariable("coordsX", 0);
+  calc->SetFunction("Temp * coordsX + 1");
+  calc->SetResultArrayName("Scaled");
+
+  vtkNew<vtkArrayCalculator> calc2;
+  calc2->SetInputConnection(calc->GetOutputPort());
+  calc2->SetFunctionParserType(parserType);
+  calc2->SetImplicitResult(implicitResult);
+  calc2->SetAttributeTypeToPointData();
+  calc2->AddScalarArrayName("Scaled");
+  calc2->AddVectorArrayName("Velocity");
+  calc2->AddCoordinateVectorVariable("coords", 0, 1, 2);
+  calc2->SetFunction("Scaled * Velocity + coords");
+  calc2->SetResultArrayName("Shifted");
+
+  vtkNew<vtkArrayCalculator> calc3;
+  calc3->SetInputConnection(calc2->GetOutputPort());
+  calc3->SetFunctionParserType(parserType);
+  calc3->SetImplicitResult(implicitResult);
+  calc3->SetAttributeTypeToPointData();
+  calc3->AddVectorArrayName("Shifted");
+  calc3->SetFunction("mag(Shifted)");
+  calc3->SetResultArrayName("Magnitude");
+  calc3->Update();
+
+  return vtkPolyData::SafeDownCast(calc3->GetOutput());
+}
+
+bool CompareArrays(vtkDataArray* expected, vtkDataArray* result)
+{
+  if (!expected || !result ||
+    expected->GetNumberOfComponents() != result->GetNumberOfComponents() ||
+    expected->GetNumberOfTuples() != result->GetNumberOfTuples())
+  {
+    std::cerr << "Missing or mismatching array.\n";
+    return false;
+  }
+  if (result->GetArrayType() != vtkAbstractArray::ImplicitArray)
+  {
+    std::cerr << "Array " << result->GetName() << " is not implicit.\n";
+    return false;
+  }
+  // Access the values out of order, then in bulk, then by component
+  const vtkIdType numTuples = result->GetNumberOfTuples();
+  for (vtkIdType i = numTuples - 1; i >= 0; i -= 7)
+  {
+    if (expected->GetComponent(i, 0) != result->GetComponent(i, 0))
+    {
+      std::cerr << "Unexpected value for tuple " << i << " of " << result->GetName() << ".\n";
+      return false;
+    }
+  }
+  const int numComps = result->GetNumberOfComponents();
+  double expectedTuple[3];
+  double resultTuple[3];
+  for (vtkIdType i = 0; i < numTuples; ++i)
+  {
+    expected->GetTuple(i, expectedTuple);
+    result->GetTuple(i, resultTuple);
+    for (int c = 0; c < numComps; ++c)
+    {
+      if (expectedTuple[c] != resultTuple[c] ||
+        expected->GetComponent(i, c) != result->GetComponent(i, c))
+      {
+        std::cerr << "Unexpected value for tuple " << i << " of " << result->GetName() << ".\n";
+        return false;
+      }
+    }
+  }
+  double expectedRange[2];
+  double resultRange[2];
+  expected->GetRange(expectedRange, -1);
+  result->GetRange(resultRange, -1);
+  if (expectedRange[0] != resultRange[0] || expectedRange[1] != resultRange[1])
+  {
+    std::cerr << "Unexpected range for " << result->GetName() << ".\n";
+    return false;
+  }
+  return true;
+}
+}
+
+int TestArrayCalculatorImplicitResult(int, char*[])
+{
+  const vtkIdType numPoints = 1000;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> temp;
+  temp->SetName("Temp");
+  vtkNew<vtkDoubleArray> velocity;
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    const double t = 0.01 * i;
+    points->InsertNextPoint(std::cos(t), std::sin(t), t);
+    temp->InsertNextValue(static_cast<float>(300.0 + 10.0 * std::sin(3.0 * t)));
+    velocity->InsertNextTuple3(t, -t, 2.0 * t);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(temp);
+  input->GetPointData()->AddArray(velocity);
+
+  for (int i = 0; i < vtkArrayCalculator::NumberOfFunctionParserTypes; ++i)
+  {
+    auto parserType = static_cast<vtkArrayCalculator::FunctionParserTypes>(i);
+    auto expected = RunCalculators(input, parserType, false);
+    auto result = RunCalculators(input, parserType, true);
+    for (const char* name : { "Scaled", "Shifted", "Magnitude" })
+    {
+      if (!CompareArrays(
+            expected->GetPointData()->GetArray(name), result->GetPointData()->GetArray(name)))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
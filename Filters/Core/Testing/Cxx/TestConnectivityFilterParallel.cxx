@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel labeling of vtkConnectivityFilter and
+// vtkPolyDataConnectivityFilter extracts the same regions as the serial
+// traversal, for all the extraction modes.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Spheres of different sizes, so that the largest region is well defined.
+vtkSmartPointer<vtkPolyData> CreateSpheres()
+{
+  vtkNew<vtkAppendPolyData> append;
+  for (int i = 0; i < 5; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(3.0 * i, 0.0, 0.0);
+    sphere->SetThetaResolution(8 + 4 * ((i + 2) % 5));
+    sphere->SetPhiResolution(8 + 4 * ((i + 2) % 5));
+    sphere->Update();
+    append->AddInputData(sphere->GetOutput());
+  }
+  append->Update();
+
+  vtkSmartPointer<vtkPolyData> spheres = append->GetOutput();
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < spheres->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+  }
+  spheres->GetCellData()->AddArray(cellIds);
+  return spheres;
+}
+
+//------------------------------------------------------------------------------
+// Check that both outputs have the same cells, with the same point coordinates
+// and region ids.
+bool CompareOutputs(vtkPointSet* serial, vtkPointSet* parallel)
+{
+  if (serial->GetNumberOfCells() != parallel->GetNumberOfCells() ||
+    serial->GetNumberOfPoints() != parallel->GetNumberOfPoints())
+  {
+    std::cerr << "Got " << parallel->GetNumberOfCells() << " cells and "
+              << parallel->GetNumberOfPoints() << " points instead of "
+              << serial->GetNumberOfCells() << " cells and " << serial->GetNumberOfPoints()
+              << " points." << std::endl;
+    return false;
+  }
+  vtkDataArray* serialIds = serial->GetCellData()->GetArray("CellIds");
+  vtkDataArray* parallelIds = parallel->GetCellData()->GetArray("CellIds");
+  vtkDataArray* serialRegions = serial->GetPointData()->GetArray("RegionId");
+  vtkDataArray* parallelRegions = parallel->GetPointData()->GetArray("RegionId");
+  vtkNew<vtkIdList> serialPts;
+  vtkNew<vtkIdList> parallelPts;
+  for (vtkIdType cellId = 0; cellId < serial->GetNumberOfCells(); ++cellId)
+  {
+    if (serialIds->GetTuple1(cellId) != parallelIds->GetTuple1(cellId))
+    {
+      std::cerr << "Wrong cell " << cellId << std::endl;
+      return false;
+    }
+    serial->GetCellPoints(cellId, serialPts);
+    parallel->GetCellPoints(cellId, parallelPts);
+    for (vtkIdType i = 0; i < serialPts->GetNumberOfIds(); ++i)
+    {
+      double x[3], y[3];
+      serial->GetPoint(serialPts->GetId(i), x);
+      parallel->GetPoint(parallelPts->GetId(i), y);
+      if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+        (serialRegions &&
+          serialRegions->GetTuple1(serialPts->GetId(i)) !=
+            parallelRegions->GetTuple1(parallelPts->GetId(i))))
+      {
+        std::cerr << "Wrong point " << i << " of cell " << cellId << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename FilterT>
+bool TestExtractionModes(vtkDataSet* input, vtkIdType seedPoint, vtkIdType seedCell)
+{
+  for (int mode = VTK_EXTRACT_POINT_SEEDED_REGIONS; mode <= VTK_EXTRACT_CLOSEST_POINT_REGION;
+       ++mode)
+  {
+    vtkNew<FilterT> filters[2];
+    for (int parallel = 0; parallel < 2; ++parallel)
+    {
+      FilterT* filter = filters[parallel];
+      filter->SetInputData(input);
+      filter->SetExtractionMode(mode);
+      filter->AddSeed(mode == VTK_EXTRACT_CELL_SEEDED_REGIONS ? seedCell : seedPoint);
+      filter->AddSpecifiedRegion(1);
+      filter->AddSpecifiedRegion(3);
+      filter->SetClosestPoint(6.0, 0.0, 0.0);
+      filter->SetColorRegions(true);
+      filter->SetParallelLabeling(parallel != 0);
+      filter->Update();
+    }
+    if (filters[0]->GetNumberOfExtractedRegions() != filters[1]->GetNumberOfExtractedRegions())
+    {
+      std::cerr << "Wrong number of regions in mode " << filters[0]->GetExtractionModeAsString()
+                << ": " << filters[1]->GetNumberOfExtractedRegions() << " instead of "
+                << filters[0]->GetNumberOfExtractedRegions() << std::endl;
+      return false;
+    }
+    if (!CompareOutputs(vtkPointSet::SafeDownCast(filters[0]->GetOutputDataObject(0)),
+          vtkPointSet::SafeDownCast(filters[1]->GetOutputDataObject(0))))
+    {
+      std::cerr << "Wrong output in mode " << filters[0]->GetExtractionModeAsString()
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestConnectivityFilterParallel(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> spheres = CreateSpheres();
+  const vtkIdType seedPoint = spheres->GetNumberOfPoints() / 2;
+  const vtkIdType seedCell = spheres->GetNumberOfCells() - 1;
+
+  if (!TestExtractionModes<vtkPolyDataConnectivityFilter>(spheres, seedPoint, seedCell))
+  {
+    std::cerr << "vtkPolyDataConnectivityFilter failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!TestExtractionModes<vtkConnectivityFilter>(spheres, seedPoint, seedCell))
+  {
+    std::cerr << "vtkConnectivityFilter failed with a polydata." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkAppendFilter> toGrid;
+  toGrid->AddInputData(spheres);
+  toGrid->Update();
+  if (!TestExtractionModes<vtkConnectivityFilter>(toGrid->GetOutput(), seedPoint, seedCell))
+  {
+    std::cerr << "vtkConnectivityFilter failed with an unstructured grid." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
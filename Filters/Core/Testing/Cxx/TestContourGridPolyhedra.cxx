@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the parallel contouring of polyhedra and of mixed dimension
+// grids gives the same output as the sequential one.
+
+#include "vtkCellData.h"
+#include "vtkContourGrid.h"
+#include "vtkCutter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphere.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A grid of n^3 voxels stored as polyhedra, with quads on the z = 0 side so
+// that the contour also has lines.
+void CreateGrid(int n, vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Distance");
+  for (int k = 0; k <= n; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        double x[3] = { static_cast<double>(i) / n, static_cast<double>(j) / n,
+          static_cast<double>(k) / n };
+        points->InsertNextPoint(x);
+        scalars->InsertNextValue(
+          (x[0] - 0.5) * (x[0] - 0.5) + (x[1] - 0.5) * (x[1] - 0.5) + x[2] * x[2]);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+
+  auto id = [n](int i, int j, int k) -> vtkIdType { return i + (n + 1) * (j + (n + 1) * k); };
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType p[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        const vtkIdType faces[] = { 4, p[0], p[3], p[2], p[1], 4, p[4], p[5], p[6], p[7], 4, p[0],
+          p[1], p[5], p[4], 4, p[1], p[2], p[6], p[5], 4, p[2], p[3], p[7], p[6], 4, p[3], p[0],
+          p[4], p[7] };
+        grid->InsertNextCell(VTK_POLYHEDRON, 8, p, 6, faces);
+        if (k == 0)
+        {
+          grid->InsertNextCell(VTK_QUAD, 4, p);
+        }
+      }
+    }
+  }
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+  }
+  grid->GetCellData()->AddArray(cellIds);
+}
+
+//------------------------------------------------------------------------------
+bool Compare(vtkPolyData* sequential, vtkPolyData* parallel, const char* name)
+{
+  if (sequential->GetNumberOfPolys() == 0 || sequential->GetNumberOfLines() == 0)
+  {
+    std::cerr << name << ": missing polygons or lines." << std::endl;
+    return false;
+  }
+  if (sequential->GetNumberOfPoints() != parallel->GetNumberOfPoints() ||
+    sequential->GetNumberOfLines() != parallel->GetNumberOfLines() ||
+    sequential->GetNumberOfPolys() != parallel->GetNumberOfPolys())
+  {
+    std::cerr << name << ": " << parallel->GetNumberOfPoints() << " points, "
+              << parallel->GetNumberOfLines() << " lines and " << parallel->GetNumberOfPolys()
+              << " polygons instead of " << sequential->GetNumberOfPoints() << ", "
+              << sequential->GetNumberOfLines() << " and " << sequential->GetNumberOfPolys()
+              << std::endl;
+    return false;
+  }
+  vtkDataArray* cellIds = parallel->GetCellData()->GetArray("CellIds");
+  if (!cellIds || cellIds->GetNumberOfTuples() != parallel->GetNumberOfCells() ||
+    parallel->GetPointData()->GetNumberOfTuples() != parallel->GetNumberOfPoints())
+  {
+    std::cerr << name << ": wrong point or cell data." << std::endl;
+    return false;
+  }
+  // Lines come from the quads, which follow the polyhedra of the first layer.
+  for (vtkIdType lineId = 0; lineId < parallel->GetNumberOfLines(); ++lineId)
+  {
+    if (cellIds->GetComponent(lineId, 0) == 0)
+    {
+      std::cerr << name << ": wrong cell data for line " << lineId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestContourGridPolyhedra(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  CreateGrid(12, grid);
+
+  vtkNew<vtkContourGrid> contour;
+  contour->SetInputData(grid);
+  contour->SetValue(0, 0.15);
+  contour->SetValue(1, 0.4);
+  contour->SequentialProcessingOn();
+  contour->Update();
+  vtkNew<vtkPolyData> sequential;
+  sequential->DeepCopy(contour->GetOutput());
+  contour->SequentialProcessingOff();
+  contour->Update();
+  if (!Compare(sequential, contour->GetOutput(), "vtkContourGrid"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(0.5, 0.5, 0.0);
+  sphere->SetRadius(0.0);
+  vtkNew<vtkCutter> cutter;
+  cutter->SetInputData(grid);
+  cutter->SetCutFunction(sphere);
+  cutter->SetValue(0, 0.15);
+  cutter->SetValue(1, 0.4);
+  cutter->SetSortByToSortByCell();
+  cutter->Update();
+  sequential->DeepCopy(cutter->GetOutput());
+  cutter->SetSortByToSortByValue();
+  cutter->Update();
+  if (!Compare(sequential, cutter->GetOutput(), "vtkCutter"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
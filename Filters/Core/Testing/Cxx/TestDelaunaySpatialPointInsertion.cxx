@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that inserting the points in spatial order gives the same Delaunay
+// triangulation as inserting them in the given order.
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkDelaunay2D.h"
+#include "vtkDelaunay3D.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+
+namespace
+{
+using CellSet = std::set<std::array<vtkIdType, 4>>;
+
+//------------------------------------------------------------------------------
+void CreatePoints(vtkIdType numPoints, bool planar, vtkPolyData* pointSet)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    double x[3] = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < (planar ? 2 : 3); ++i)
+    {
+      x[i] = random->GetNextValue();
+    }
+    points->InsertNextPoint(x);
+  }
+  pointSet->SetPoints(points);
+}
+
+//------------------------------------------------------------------------------
+// Gather the cells with their sorted point ids, independently of their order.
+CellSet GetCells(vtkCellArray* cells)
+{
+  CellSet cellSet;
+  auto iter = vtk::TakeSmartPointer(cells->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    vtkIdList* ids = iter->GetCurrentCell();
+    std::array<vtkIdType, 4> cell = { { -1, -1, -1, -1 } };
+    std::copy(ids->begin(), ids->end(), cell.begin());
+    std::sort(cell.begin(), cell.begin() + ids->GetNumberOfIds());
+    cellSet.insert(cell);
+  }
+  return cellSet;
+}
+}
+
+int TestDelaunaySpatialPointInsertion(int, char*[])
+{
+  // The spatial order is a permutation of the points.
+  vtkNew<vtkPolyData> planarPoints;
+  CreatePoints(5000, true, planarPoints);
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(planarPoints);
+  vtkNew<vtkIdList> order;
+  locator->GetSpatialOrder(order);
+  std::set<vtkIdType> orderedIds(order->begin(), order->end());
+  if (order->GetNumberOfIds() != 5000 || orderedIds.size() != 5000 || *orderedIds.begin() != 0 ||
+    *orderedIds.rbegin() != 4999)
+  {
+    std::cerr << "The spatial order is not a permutation of the points." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkDelaunay2D> delaunay2D;
+  delaunay2D->SetInputData(planarPoints);
+  delaunay2D->Update();
+  CellSet triangles = GetCells(delaunay2D->GetOutput()->GetPolys());
+  delaunay2D->SpatialPointInsertionOn();
+  delaunay2D->Update();
+  if (triangles.empty() || triangles != GetCells(delaunay2D->GetOutput()->GetPolys()))
+  {
+    std::cerr << "vtkDelaunay2D: the spatial insertion order changes the triangulation."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPolyData> points;
+  CreatePoints(1000, false, points);
+  vtkNew<vtkDelaunay3D> delaunay3D;
+  delaunay3D->SetInputData(points);
+  delaunay3D->Update();
+  CellSet tetras = GetCells(delaunay3D->GetOutput()->GetCells());
+  delaunay3D->SpatialPointInsertionOn();
+  delaunay3D->Update();
+  if (tetras.empty() || tetras != GetCells(delaunay3D->GetOutput()->GetCells()))
+  {
+    std::cerr << "vtkDelaunay3D: the spatial insertion order changes the tetrahedralization."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
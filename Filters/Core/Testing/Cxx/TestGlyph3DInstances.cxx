@@ -0,0 +1,252 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded vtkGlyph3D places the glyphs of all the points, with
+// their cells grouped by type, and that the instances it outputs when
+// OutputInstances is on describe the same glyphs.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFloatArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A source with a vert, a line and a triangle, so that the cells of the
+// glyphs are grouped by type in the output.
+void CreateSource(vtkPolyData* source, double size)
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(size, 0.0, 0.0);
+  points->InsertNextPoint(0.0, size, 0.0);
+  points->InsertNextPoint(0.0, 0.0, size);
+  source->SetPoints(points);
+  source->AllocateEstimate(3, 3);
+  const vtkIdType triangle[3] = { 1, 2, 3 };
+  source->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  const vtkIdType line[2] = { 0, 3 };
+  source->InsertNextCell(VTK_LINE, 2, line);
+  const vtkIdType vert[1] = { 2 };
+  source->InsertNextCell(VTK_VERTEX, 1, vert);
+}
+
+//------------------------------------------------------------------------------
+// Points on a helix with varying vectors and scalars. Every tenth point is a
+// duplicated ghost point, which is not glyphed.
+void CreateInput(vtkPolyData* input, vtkIdType numPts)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkIntArray> data;
+  data->SetName("Data");
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    const double t = 0.01 * i;
+    points->InsertNextPoint(std::cos(t), std::sin(t), 0.1 * t);
+    vectors->InsertNextTuple3(std::sin(3.0 * t), -1.0 + t, (i % 7) * 0.25);
+    scalars->InsertNextValue(static_cast<float>(i % 13) / 13.0f);
+    data->InsertNextValue(static_cast<int>(3 * i));
+    ghosts->InsertNextValue(i % 10 == 9 ? vtkDataSetAttributes::DUPLICATEPOINT : 0);
+  }
+  input->SetPoints(points);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->AddArray(data);
+  input->GetPointData()->AddArray(ghosts);
+}
+
+//------------------------------------------------------------------------------
+bool Near(const double x[3], const double y[3])
+{
+  return std::abs(x[0] - y[0]) < 1e-4 && std::abs(x[1] - y[1]) < 1e-4 &&
+    std::abs(x[2] - y[2]) < 1e-4;
+}
+
+//------------------------------------------------------------------------------
+// Check that each glyph is the source transformed by its instance, and that
+// the cells of the glyphs follow each other by type.
+bool CompareGlyphsAndInstances(vtkIdType numInputPts, vtkPolyData* source, vtkPolyData* glyphs,
+  vtkPolyData* instances)
+{
+  const vtkIdType numSourcePts = source->GetNumberOfPoints();
+  const vtkIdType numInstances = instances->GetNumberOfPoints();
+  const vtkIdType numGlyphed = numInputPts - numInputPts / 10;
+  if (numInstances != numGlyphed || instances->GetNumberOfCells() != 0 ||
+    glyphs->GetNumberOfPoints() != numInstances * numSourcePts ||
+    glyphs->GetNumberOfCells() != numInstances * source->GetNumberOfCells())
+  {
+    std::cerr << "Got " << numInstances << " instances and " << glyphs->GetNumberOfPoints()
+              << " glyph points instead of " << numGlyphed << " and "
+              << numGlyphed * numSourcePts << std::endl;
+    return false;
+  }
+
+  vtkDataArray* orientations = instances->GetPointData()->GetArray("GlyphOrientation");
+  vtkDataArray* scaleFactors = instances->GetPointData()->GetArray("GlyphScaleFactors");
+  vtkDataArray* instanceData = instances->GetPointData()->GetArray("Data");
+  vtkDataArray* glyphData = glyphs->GetPointData()->GetArray("Data");
+  vtkDataArray* cellData = glyphs->GetCellData()->GetArray("Data");
+  if (!orientations || !scaleFactors || !instanceData || !glyphData || !cellData)
+  {
+    std::cerr << "Missing arrays." << std::endl;
+    return false;
+  }
+
+  for (vtkIdType instance = 0; instance < numInstances; ++instance)
+  {
+    double x[3], quaternion[4], scale[3], rotation[3][3];
+    instances->GetPoint(instance, x);
+    orientations->GetTuple(instance, quaternion);
+    scaleFactors->GetTuple(instance, scale);
+    vtkMath::QuaternionToMatrix3x3(quaternion, rotation);
+    // The input points are glyphed in order, skipping the ghost points.
+    const vtkIdType inPtId = instance + instance / 9;
+    if (instanceData->GetTuple1(instance) != 3 * inPtId)
+    {
+      std::cerr << "Wrong data for instance " << instance << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < numSourcePts; ++i)
+    {
+      double p[3], y[3], glyphPt[3];
+      source->GetPoint(i, p);
+      for (int c = 0; c < 3; ++c)
+      {
+        p[c] *= scale[c];
+      }
+      vtkMath::Multiply3x3(rotation, p, y);
+      vtkMath::Add(x, y, y);
+      const vtkIdType glyphPtId = instance * numSourcePts + i;
+      glyphs->GetPoint(glyphPtId, glyphPt);
+      if (!Near(y, glyphPt) || glyphData->GetTuple1(glyphPtId) != 3 * inPtId)
+      {
+        std::cerr << "Wrong point " << i << " of glyph " << instance << std::endl;
+        return false;
+      }
+    }
+  }
+
+  // A vert, a line and a triangle per glyph: all the verts, then the lines
+  // and the triangles.
+  const int types[3] = { VTK_VERTEX, VTK_LINE, VTK_TRIANGLE };
+  const vtkIdType sourceCells[3] = { 2, 1, 0 };
+  vtkNew<vtkIdList> sourcePts;
+  vtkNew<vtkIdList> glyphPts;
+  for (int type = 0; type < 3; ++type)
+  {
+    source->GetCellPoints(sourceCells[type], sourcePts);
+    for (vtkIdType instance = 0; instance < numInstances; ++instance)
+    {
+      const vtkIdType cellId = type * numInstances + instance;
+      glyphs->GetCellPoints(cellId, glyphPts);
+      bool same = glyphs->GetCellType(cellId) == types[type] &&
+        glyphPts->GetNumberOfIds() == sourcePts->GetNumberOfIds() &&
+        cellData->GetTuple1(cellId) == 3 * (instance + instance / 9);
+      for (vtkIdType i = 0; same && i < glyphPts->GetNumberOfIds(); ++i)
+      {
+        same = glyphPts->GetId(i) == sourcePts->GetId(i) + instance * numSourcePts;
+      }
+      if (!same)
+      {
+        std::cerr << "Wrong cell " << cellId << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestGlyph3DInstances(int, char*[])
+{
+  // More points than a batch of the threaded pass.
+  const vtkIdType numPts = 4321;
+  vtkNew<vtkPolyData> input;
+  CreateInput(input, numPts);
+  vtkNew<vtkPolyData> source;
+  CreateSource(source, 0.05);
+
+  for (int scaleMode : { VTK_SCALE_BY_SCALAR, VTK_SCALE_BY_VECTORCOMPONENTS })
+  {
+    vtkNew<vtkGlyph3D> glyphs[2];
+    for (int instances = 0; instances < 2; ++instances)
+    {
+      glyphs[instances]->SetInputData(input);
+      glyphs[instances]->SetSourceData(source);
+      glyphs[instances]->SetScaleMode(scaleMode);
+      glyphs[instances]->SetScaleFactor(2.0);
+      glyphs[instances]->SetFillCellData(true);
+      glyphs[instances]->SetOutputInstances(instances != 0);
+      glyphs[instances]->Update();
+    }
+    if (!CompareGlyphsAndInstances(
+          numPts, source, glyphs[0]->GetOutput(), glyphs[1]->GetOutput()))
+    {
+      std::cerr << "Failed with scale mode " << glyphs[0]->GetScaleModeAsString() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // With a table of sources, the instances record the source of each glyph.
+  vtkNew<vtkPolyData> largeSource;
+  CreateSource(largeSource, 0.2);
+  vtkNew<vtkGlyph3D> indexed[2];
+  for (int instances = 0; instances < 2; ++instances)
+  {
+    indexed[instances]->SetInputData(input);
+    indexed[instances]->SetSourceData(0, source);
+    indexed[instances]->SetSourceData(1, largeSource);
+    indexed[instances]->SetIndexModeToScalar();
+    indexed[instances]->SetOutputInstances(instances != 0);
+    indexed[instances]->Update();
+  }
+  vtkPolyData* glyphOutput = indexed[0]->GetOutput();
+  vtkPolyData* instanceOutput = indexed[1]->GetOutput();
+  vtkDataArray* glyphIndices = instanceOutput->GetPointData()->GetArray("GlyphIndex");
+  vtkDataArray* scalars = input->GetPointData()->GetScalars();
+  if (!glyphIndices || glyphOutput->GetNumberOfPoints() != 4 * instanceOutput->GetNumberOfPoints())
+  {
+    std::cerr << "Wrong output with a table of sources." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType instance = 0; instance < instanceOutput->GetNumberOfPoints(); ++instance)
+  {
+    // Each source has 4 points, the size of the glyph tells its source.
+    const vtkIdType inPtId = instance + instance / 9;
+    const int index = scalars->GetTuple1(inPtId) < 0.5 ? 0 : 1;
+    double x[3], y[3];
+    glyphOutput->GetPoint(4 * instance, x);
+    glyphOutput->GetPoint(4 * instance + 3, y);
+    const double size = std::sqrt(vtkMath::Distance2BetweenPoints(x, y));
+    const double scale = scalars->GetTuple1(inPtId) == 0.0 ? 1e-10 : scalars->GetTuple1(inPtId);
+    if (glyphIndices->GetTuple1(instance) != index ||
+      std::abs(size - (index == 0 ? 0.05 : 0.2) * scale) > 1e-5)
+    {
+      std::cerr << "Wrong source for instance " << instance << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
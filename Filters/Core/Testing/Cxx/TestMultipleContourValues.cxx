@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that contouring several values at once gives the same surfaces as
+// contouring each value separately.
+
+#include "vtkContour3DLinearGrid.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkFlyingEdges3D.h"
+#include "vtkMathUtilities.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const double Values[] = { 60.0, 90.0, 120.0, 150.0, 180.0, 210.0, 240.0 };
+const int NumberOfValues = static_cast<int>(sizeof(Values) / sizeof(Values[0]));
+
+//------------------------------------------------------------------------------
+// Contour all the values at once, then one value at a time, and compare the
+// number of points and triangles. When samePoints is true, the points of the
+// first output must also be the points of the separate outputs, in order.
+template <typename ContourFilter>
+bool TestFilter(ContourFilter* contour, const char* name, bool samePoints)
+{
+  for (int i = 0; i < NumberOfValues; ++i)
+  {
+    contour->SetValue(i, Values[i]);
+  }
+  contour->Update();
+  vtkNew<vtkPolyData> all;
+  all->DeepCopy(contour->GetOutputDataObject(0));
+  if (all->GetNumberOfCells() == 0)
+  {
+    std::cerr << name << ": empty output." << std::endl;
+    return false;
+  }
+
+  vtkIdType numPts = 0, numCells = 0;
+  contour->SetNumberOfContours(1);
+  for (int i = 0; i < NumberOfValues; ++i)
+  {
+    contour->SetValue(0, Values[i]);
+    contour->Update();
+    vtkPolyData* one = vtkPolyData::SafeDownCast(contour->GetOutputDataObject(0));
+    if (samePoints)
+    {
+      for (vtkIdType ptId = 0; ptId < one->GetNumberOfPoints(); ++ptId)
+      {
+        double x[3], y[3];
+        one->GetPoint(ptId, x);
+        all->GetPoint(numPts + ptId, y);
+        if (!vtkMathUtilities::FuzzyCompare(x[0], y[0]) ||
+          !vtkMathUtilities::FuzzyCompare(x[1], y[1]) ||
+          !vtkMathUtilities::FuzzyCompare(x[2], y[2]))
+        {
+          std::cerr << name << ": wrong point " << numPts + ptId << " for value " << Values[i]
+                    << std::endl;
+          return false;
+        }
+      }
+    }
+    numPts += one->GetNumberOfPoints();
+    numCells += one->GetNumberOfCells();
+  }
+
+  if (numPts != all->GetNumberOfPoints() || numCells != all->GetNumberOfCells())
+  {
+    std::cerr << name << ": " << all->GetNumberOfPoints() << " points and "
+              << all->GetNumberOfCells() << " triangles instead of " << numPts << " and "
+              << numCells << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestMultipleContourValues(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-16, 16, -16, 16, -16, 16);
+
+  vtkNew<vtkFlyingEdges3D> flyingEdges;
+  flyingEdges->SetInputConnection(wavelet->GetOutputPort());
+  flyingEdges->ComputeNormalsOff();
+  if (!TestFilter(flyingEdges.Get(), "vtkFlyingEdges3D", true))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputConnection(wavelet->GetOutputPort());
+  vtkNew<vtkContour3DLinearGrid> linearGrid;
+  linearGrid->SetInputConnection(tetrahedralize->GetOutputPort());
+  linearGrid->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+  if (!TestFilter(linearGrid.Get(), "vtkContour3DLinearGrid", false))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
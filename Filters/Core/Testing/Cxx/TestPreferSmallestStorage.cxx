@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkThreshold, vtkExtractCells and vtkGeometryFilter generate
+// cell arrays with 32-bit storage and the same cells when
+// vtkCellArray::SetPreferSmallestStorage is on.
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkExtractCells.h"
+#include "vtkGeometryFilter.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool CompareCells(vtkCellArray* expected, vtkCellArray* cells, const char* name)
+{
+  if (cells->IsStorage64Bit() || cells->GetNumberOfCells() != expected->GetNumberOfCells() ||
+    cells->GetNumberOfCells() == 0)
+  {
+    std::cerr << name << ": the cells do not use the smallest storage." << std::endl;
+    return false;
+  }
+  vtkNew<vtkIdList> expectedIds;
+  auto iter = vtk::TakeSmartPointer(cells->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    expected->GetCellAtId(iter->GetCurrentCellId(), expectedIds);
+    vtkIdList* ids = iter->GetCurrentCell();
+    bool same = ids->GetNumberOfIds() == expectedIds->GetNumberOfIds();
+    for (vtkIdType i = 0; same && i < ids->GetNumberOfIds(); ++i)
+    {
+      same = ids->GetId(i) == expectedIds->GetId(i);
+    }
+    if (!same)
+    {
+      std::cerr << name << ": cell " << iter->GetCurrentCellId() << " differs." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestPreferSmallestStorage(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-8, 8, -8, 8, -8, 8);
+
+  vtkNew<vtkThreshold> threshold;
+  threshold->SetInputConnection(source->GetOutputPort());
+  threshold->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+  threshold->SetLowerThreshold(100.0);
+  threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_UPPER);
+
+  vtkNew<vtkExtractCells> extract;
+  extract->SetInputConnection(source->GetOutputPort());
+  extract->AddCellRange(100, 2000);
+
+  vtkNew<vtkGeometryFilter> geometry;
+  geometry->SetInputConnection(threshold->GetOutputPort());
+
+  const bool preferSmallestStorage = vtkCellArray::GetPreferSmallestStorage();
+  vtkCellArray::SetPreferSmallestStorage(false);
+  threshold->Update();
+  extract->Update();
+  geometry->Update();
+  vtkNew<vtkUnstructuredGrid> thresholdCells;
+  thresholdCells->DeepCopy(threshold->GetOutput());
+  vtkNew<vtkUnstructuredGrid> extractCells;
+  extractCells->DeepCopy(extract->GetOutput());
+  vtkNew<vtkPolyData> geometryCells;
+  geometryCells->DeepCopy(geometry->GetOutput());
+
+  vtkCellArray::SetPreferSmallestStorage(true);
+  threshold->Modified();
+  extract->Modified();
+  geometry->Modified();
+  threshold->Update();
+  extract->Update();
+  geometry->Update();
+  vtkCellArray::SetPreferSmallestStorage(preferSmallestStorage);
+
+  if (!CompareCells(
+        thresholdCells->GetCells(), threshold->GetOutput()->GetCells(), "vtkThreshold") ||
+    !CompareCells(extractCells->GetCells(), extract->GetOutput()->GetCells(), "vtkExtractCells") ||
+    !CompareCells(
+      geometryCells->GetPolys(), geometry->GetOutput()->GetPolys(), "vtkGeometryFilter"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
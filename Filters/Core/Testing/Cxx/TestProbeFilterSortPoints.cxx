@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that probing random points along a Morton curve with
+// SortPointsSpatially gives the same values and valid points as probing them
+// in the order of their ids, with the default strategy and with a cell
+// locator.
+
+#include "vtkCharArray.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointSource.h"
+#include "vtkProbeFilter.h"
+#include "vtkStaticCellLocator.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Return the probed values, with the valid points in mask.
+vtkDataArray* Probe(vtkProbeFilter* probe, vtkCharArray*& mask)
+{
+  probe->Update();
+  vtkPointData* outPD = probe->GetOutput()->GetPointData();
+  mask = vtkArrayDownCast<vtkCharArray>(outPD->GetArray(probe->GetValidPointMaskArrayName()));
+  return outPD->GetArray("Linear");
+}
+}
+
+//------------------------------------------------------------------------------
+int TestProbeFilterSortPoints(int, char*[])
+{
+  // A linear field is interpolated exactly in any of the cells containing a
+  // point.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(21, 21, 21);
+  image->SetSpacing(0.05, 0.05, 0.05);
+  vtkNew<vtkDoubleArray> linear;
+  linear->SetName("Linear");
+  linear->SetNumberOfValues(image->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < image->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    image->GetPoint(ptId, x);
+    linear->SetValue(ptId, x[0] + 2.0 * x[1] + 3.0 * x[2]);
+  }
+  image->GetPointData()->AddArray(linear);
+  vtkNew<vtkDataSetTriangleFilter> tetrahedra;
+  tetrahedra->SetInputData(image);
+
+  // Random points, a few of them outside of the source.
+  vtkNew<vtkPointSource> points;
+  points->SetNumberOfPoints(20000);
+  points->SetCenter(0.5, 0.5, 0.5);
+  points->SetRadius(0.6);
+
+  vtkNew<vtkStaticCellLocator> locator;
+  for (int useLocator = 0; useLocator < 2; ++useLocator)
+  {
+    vtkNew<vtkProbeFilter> probes[2];
+    vtkDataArray* values[2];
+    vtkCharArray* masks[2];
+    for (int sort = 0; sort < 2; ++sort)
+    {
+      probes[sort]->SetInputConnection(points->GetOutputPort());
+      probes[sort]->SetSourceConnection(tetrahedra->GetOutputPort());
+      probes[sort]->SetSortPointsSpatially(sort != 0);
+      if (useLocator)
+      {
+        probes[sort]->SetCellLocatorPrototype(locator);
+      }
+      values[sort] = Probe(probes[sort], masks[sort]);
+    }
+    if (!values[0] || !values[1] || !masks[0] || !masks[1])
+    {
+      std::cerr << "Missing probed arrays." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vtkIdType numValid = 0;
+    for (vtkIdType ptId = 0; ptId < values[0]->GetNumberOfTuples(); ++ptId)
+    {
+      if (masks[0]->GetValue(ptId) != masks[1]->GetValue(ptId))
+      {
+        std::cerr << "Point " << ptId << " is valid in one order only." << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (!masks[0]->GetValue(ptId))
+      {
+        continue;
+      }
+      ++numValid;
+      if (std::abs(values[0]->GetTuple1(ptId) - values[1]->GetTuple1(ptId)) > 1e-9)
+      {
+        std::cerr << "Point " << ptId << " is probed to " << values[1]->GetTuple1(ptId)
+                  << " instead of " << values[0]->GetTuple1(ptId) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (numValid == 0 || numValid == values[0]->GetNumberOfTuples())
+    {
+      std::cerr << "Unexpected number of valid points " << numValid << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel edge collapses of vtkQuadricDecimation reach the
+// target reduction with an error comparable to the serial collapses, with
+// and without boundaries and mapped point data.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A unit sphere, or half of it, with a point scalar to map.
+void CreateSphere(vtkPolyData* sphere, bool half)
+{
+  vtkNew<vtkSphereSource> source;
+  source->SetRadius(1.0);
+  source->SetThetaResolution(80);
+  source->SetPhiResolution(60);
+  source->SetEndTheta(half ? 180.0 : 360.0);
+  source->Update();
+  sphere->ShallowCopy(source->GetOutput());
+
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Analytical");
+  scalars->SetNumberOfTuples(sphere->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < sphere->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    sphere->GetPoint(ptId, x);
+    scalars->SetValue(ptId, std::sin(3.0 * (x[0] + x[1] + x[2])));
+  }
+  sphere->GetPointData()->SetScalars(scalars);
+}
+
+//------------------------------------------------------------------------------
+// Return the largest distance of the points of the output triangles to the
+// unit sphere, or a negative value for a degenerate output.
+double ComputeError(vtkPolyData* output)
+{
+  double error = 0.0;
+  vtkCellArray* polys = output->GetPolys();
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    if (npts != 3 || pts[0] == pts[1] || pts[1] == pts[2] || pts[2] == pts[0])
+    {
+      return -1.0;
+    }
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      double x[3];
+      output->GetPoint(pts[i], x);
+      error = std::max(error, std::abs(vtkMath::Norm(x) - 1.0));
+    }
+  }
+  return error;
+}
+
+//------------------------------------------------------------------------------
+bool TestDecimation(vtkPolyData* input, bool mapPointData)
+{
+  vtkNew<vtkQuadricDecimation> decimators[2];
+  for (int parallel = 0; parallel < 2; ++parallel)
+  {
+    decimators[parallel]->SetInputData(input);
+    decimators[parallel]->SetTargetReduction(0.9);
+    decimators[parallel]->SetMapPointData(mapPointData);
+    decimators[parallel]->SetParallelCollapses(parallel != 0);
+    decimators[parallel]->Update();
+  }
+  vtkPolyData* serial = decimators[0]->GetOutput();
+  vtkPolyData* parallel = decimators[1]->GetOutput();
+
+  const double reduction = decimators[1]->GetActualReduction();
+  const vtkIdType numTris = input->GetNumberOfPolys();
+  if (reduction < 0.9 ||
+    parallel->GetNumberOfPolys() != numTris - std::lround(reduction * numTris))
+  {
+    std::cerr << "Got " << parallel->GetNumberOfPolys() << " triangles for a reduction of "
+              << reduction << std::endl;
+    return false;
+  }
+
+  const double serialError = ComputeError(serial);
+  const double parallelError = ComputeError(parallel);
+  std::cout << "Serial error: " << serialError << ", parallel error: " << parallelError
+            << std::endl;
+  if (parallelError < 0.0 || parallelError > 2.0 * serialError + 1e-3)
+  {
+    std::cerr << "Parallel error " << parallelError << " instead of " << serialError << std::endl;
+    return false;
+  }
+
+  if (mapPointData)
+  {
+    vtkDataArray* scalars = parallel->GetPointData()->GetArray("Analytical");
+    if (!scalars || scalars->GetNumberOfTuples() != parallel->GetNumberOfPoints())
+    {
+      std::cerr << "Point data is not mapped." << std::endl;
+      return false;
+    }
+    for (vtkIdType ptId = 0; ptId < scalars->GetNumberOfTuples(); ++ptId)
+    {
+      if (std::abs(scalars->GetTuple1(ptId)) > 1.0 + 1e-6)
+      {
+        std::cerr << "Wrong mapped value at point " << ptId << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestQuadricDecimationParallel(int, char*[])
+{
+  for (bool half : { false, true })
+  {
+    vtkNew<vtkPolyData> sphere;
+    CreateSphere(sphere, half);
+    for (bool mapPointData : { false, true })
+    {
+      if (!TestDecimation(sphere, mapPointData))
+      {
+        std::cerr << "Failed with " << (half ? "a half sphere" : "a sphere")
+                  << (mapPointData ? " and mapped point data." : ".") << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The attribute error metric is not threaded, the collapses are serial.
+  vtkNew<vtkPolyData> sphere;
+  CreateSphere(sphere, false);
+  vtkNew<vtkQuadricDecimation> decimators[2];
+  for (int parallel = 0; parallel < 2; ++parallel)
+  {
+    decimators[parallel]->SetInputData(sphere);
+    decimators[parallel]->SetTargetReduction(0.8);
+    decimators[parallel]->SetAttributeErrorMetric(true);
+    decimators[parallel]->SetParallelCollapses(parallel != 0);
+    decimators[parallel]->Update();
+  }
+  if (decimators[0]->GetOutput()->GetNumberOfPolys() !=
+    decimators[1]->GetOutput()->GetNumberOfPolys())
+  {
+    std::cerr << "The attribute error metric does not use the serial collapses." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
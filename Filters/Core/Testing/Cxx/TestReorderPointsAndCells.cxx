@@ -0,0 +1,290 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkReorderPointsAndCells renumbers the points and cells of a
+// shuffled grid of hexahedra and of a sphere without changing them, that each
+// ordering reduces the spread of the point ids of the cells of the grid, that
+// the indexed arrays map the data between the two orders, and that the
+// result does not depend on the number of threads.
+
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkReorderPointsAndCells.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A random permutation of [0, n).
+std::vector<vtkIdType> Shuffle(vtkIdType n, vtkMinimalStandardRandomSequence* random)
+{
+  std::vector<vtkIdType> permutation(n);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  for (vtkIdType i = n - 1; i > 0; --i)
+  {
+    const vtkIdType j = static_cast<vtkIdType>(random->GetNextRangeValue(0.0, i + 1.0));
+    std::swap(permutation[i], permutation[std::min(j, i)]);
+  }
+  return permutation;
+}
+
+//------------------------------------------------------------------------------
+// A grid of n^3 hexahedra with shuffled points and cells, and point and cell
+// data giving the ids of the unshuffled grid.
+void CreateShuffledGrid(vtkUnstructuredGrid* grid, int n)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  const vtkIdType numPts = (n + 1) * (n + 1) * (n + 1);
+  const std::vector<vtkIdType> pointIds = Shuffle(numPts, random);
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkDoubleArray> position;
+  position->SetName("Position");
+  position->SetNumberOfComponents(3);
+  position->SetNumberOfTuples(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    const double x[3] = { static_cast<double>(ptId % (n + 1)),
+      static_cast<double>((ptId / (n + 1)) % (n + 1)),
+      static_cast<double>(ptId / (n + 1) / (n + 1)) };
+    points->SetPoint(pointIds[ptId], x);
+    position->SetTuple(pointIds[ptId], x);
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(position);
+
+  const vtkIdType numCells = n * n * n;
+  const std::vector<vtkIdType> cellIds = Shuffle(numCells, random);
+  std::vector<vtkIdType> order(numCells);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    order[cellIds[cellId]] = cellId;
+  }
+  vtkNew<vtkIntArray> index;
+  index->SetName("Index");
+  index->SetNumberOfValues(numCells);
+  grid->AllocateExact(numCells, 8);
+  const int corners[8][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+    { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    const vtkIdType hex = order[cellId];
+    const int ijk[3] = { static_cast<int>(hex % n), static_cast<int>((hex / n) % n),
+      static_cast<int>(hex / n / n) };
+    vtkIdType ids[8];
+    for (int c = 0; c < 8; ++c)
+    {
+      ids[c] = pointIds[(ijk[0] + corners[c][0]) +
+        (n + 1) * ((ijk[1] + corners[c][1]) + (n + 1) * (ijk[2] + corners[c][2]))];
+    }
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+    index->SetValue(cellId, static_cast<int>(hex));
+  }
+  grid->GetCellData()->AddArray(index);
+}
+
+//------------------------------------------------------------------------------
+// The sum over the cells of the difference between their largest and
+// smallest point ids.
+vtkIdType Spread(vtkPointSet* dataSet)
+{
+  vtkNew<vtkIdList> ids;
+  vtkIdType spread = 0;
+  for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
+  {
+    dataSet->GetCellPoints(cellId, ids);
+    const auto range = std::minmax_element(ids->begin(), ids->end());
+    spread += *range.second - *range.first;
+  }
+  return spread;
+}
+
+//------------------------------------------------------------------------------
+// Check that the output has the points, cells and data of the input in the
+// order of the original ids.
+bool CheckOutput(vtkPointSet* input, vtkPointSet* output)
+{
+  auto originalPointIds = vtkArrayDownCast<vtkIdTypeArray>(
+    output->GetPointData()->GetArray("vtkOriginalPointIds"));
+  auto originalCellIds =
+    vtkArrayDownCast<vtkIdTypeArray>(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  if (!originalPointIds || !originalCellIds ||
+    output->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != input->GetNumberOfCells())
+  {
+    std::cerr << "The output does not have the points and cells of the input." << std::endl;
+    return false;
+  }
+
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], expected[3];
+    output->GetPoint(ptId, x);
+    input->GetPoint(originalPointIds->GetValue(ptId), expected);
+    if (x[0] != expected[0] || x[1] != expected[1] || x[2] != expected[2])
+    {
+      std::cerr << "Point " << ptId << " is moved." << std::endl;
+      return false;
+    }
+  }
+
+  vtkNew<vtkIdList> ids, expectedIds;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType inCellId = originalCellIds->GetValue(cellId);
+    output->GetCellPoints(cellId, ids);
+    input->GetCellPoints(inCellId, expectedIds);
+    bool same = output->GetCellType(cellId) == input->GetCellType(inCellId) &&
+      ids->GetNumberOfIds() == expectedIds->GetNumberOfIds();
+    for (vtkIdType i = 0; same && i < ids->GetNumberOfIds(); ++i)
+    {
+      same = originalPointIds->GetValue(ids->GetId(i)) == expectedIds->GetId(i);
+    }
+    if (!same)
+    {
+      std::cerr << "Cell " << cellId << " differs from the input cell " << inCellId << std::endl;
+      return false;
+    }
+  }
+
+  // The data arrays are permuted, and map back to the input order.
+  for (int association = 0; association < 2; ++association)
+  {
+    vtkDataSetAttributes* inData = association
+      ? static_cast<vtkDataSetAttributes*>(input->GetCellData())
+      : static_cast<vtkDataSetAttributes*>(input->GetPointData());
+    vtkDataSetAttributes* outData = association
+      ? static_cast<vtkDataSetAttributes*>(output->GetCellData())
+      : static_cast<vtkDataSetAttributes*>(output->GetPointData());
+    vtkIdTypeArray* originalIds = association ? originalCellIds : originalPointIds;
+    for (int a = 0; a < inData->GetNumberOfArrays(); ++a)
+    {
+      vtkDataArray* inArray = inData->GetArray(a);
+      vtkDataArray* outArray = outData->GetArray(inArray->GetName());
+      auto inputOrder = vtkReorderPointsAndCells::GetArrayInInputOrder(outArray, originalIds);
+      auto outputOrder = vtkReorderPointsAndCells::GetArrayInOutputOrder(inArray, originalIds);
+      if (!outArray || outArray->GetDataType() != inArray->GetDataType() || !inputOrder ||
+        !outputOrder)
+      {
+        std::cerr << "The array " << inArray->GetName() << " is not permuted." << std::endl;
+        return false;
+      }
+      for (vtkIdType i = 0; i < outArray->GetNumberOfValues(); ++i)
+      {
+        const vtkIdType c = outArray->GetNumberOfComponents();
+        const double value = outArray->GetComponent(i / c, i % c);
+        if (value != inArray->GetComponent(originalIds->GetValue(i / c), i % c) ||
+          inputOrder->GetComponent(i / c, i % c) != inArray->GetComponent(i / c, i % c) ||
+          outputOrder->GetComponent(i / c, i % c) != value)
+        {
+          std::cerr << "The array " << inArray->GetName() << " differs at " << i << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestOrdering(vtkPointSet* input, int mode, bool shuffled)
+{
+  vtkNew<vtkReorderPointsAndCells> reorder;
+  reorder->SetInputData(input);
+  reorder->SetOrderingMode(mode);
+  reorder->Update();
+  vtkPointSet* output = vtkPointSet::SafeDownCast(reorder->GetOutputDataObject(0));
+  if (!output || output->GetDataObjectType() != input->GetDataObjectType() ||
+    !CheckOutput(input, output))
+  {
+    std::cerr << "Ordering " << mode << " failed." << std::endl;
+    return false;
+  }
+  if (shuffled && Spread(output) >= Spread(input))
+  {
+    std::cerr << "Ordering " << mode << " does not improve the locality: " << Spread(output)
+              << " instead of " << Spread(input) << std::endl;
+    return false;
+  }
+
+  // The same order with a single thread.
+  vtkNew<vtkReorderPointsAndCells> serial;
+  serial->SetInputData(input);
+  serial->SetOrderingMode(mode);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { serial->Update(); });
+  vtkPointSet* serialOutput = vtkPointSet::SafeDownCast(serial->GetOutputDataObject(0));
+  const std::pair<vtkDataArray*, vtkDataArray*> ids[2] = {
+    { output->GetPointData()->GetArray("vtkOriginalPointIds"),
+      serialOutput->GetPointData()->GetArray("vtkOriginalPointIds") },
+    { output->GetCellData()->GetArray("vtkOriginalCellIds"),
+      serialOutput->GetCellData()->GetArray("vtkOriginalCellIds") }
+  };
+  for (const auto& pair : ids)
+  {
+    for (vtkIdType i = 0; i < pair.first->GetNumberOfTuples(); ++i)
+    {
+      if (pair.first->GetTuple1(i) != pair.second->GetTuple1(i))
+      {
+        std::cerr << "Ordering " << mode << " depends on the number of threads." << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestReorderPointsAndCells(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  CreateShuffledGrid(grid, 12);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(30);
+  sphere->Update();
+  vtkPolyData* polyData = sphere->GetOutput();
+
+  for (int mode : { vtkReorderPointsAndCells::MORTON, vtkReorderPointsAndCells::HILBERT,
+         vtkReorderPointsAndCells::REVERSE_CUTHILL_MCKEE })
+  {
+    if (!TestOrdering(grid, mode, true) || !TestOrdering(polyData, mode, false))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Only the cells are reordered, the points keep their ids.
+  vtkNew<vtkReorderPointsAndCells> reorder;
+  reorder->SetInputData(grid);
+  reorder->ReorderPointsOff();
+  reorder->Update();
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(reorder->GetOutput());
+  if (output->GetPoints() != grid->GetPoints() ||
+    output->GetPointData()->GetArray("vtkOriginalPointIds") ||
+    !output->GetCellData()->GetArray("vtkOriginalCellIds"))
+  {
+    std::cerr << "The points are reordered." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,202 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded generation of vtkTubeFilter and the serial traversal
+// produce the same tubes, for polylines sharing points, with degenerate
+// segments, and with polylines that cannot be tubed.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTubeFilter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Helices around the z axis, which start at the same point. Some polylines
+// repeat a point, one has a single point, and the last one is along the z
+// axis, which cannot be tubed with a default normal along z. A vertex comes
+// first so that the polylines do not start at cell 0.
+void CreateLines(vtkPolyData* lines, int numLines, int numPtsPerLine)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> polylines;
+  vtkNew<vtkIntArray> cellData;
+  cellData->SetName("CellData");
+
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  scalars->InsertNextValue(0.0);
+  verts->InsertNextCell(1);
+  verts->InsertCellPoint(0);
+  cellData->InsertNextValue(-1);
+
+  for (int line = 0; line < numLines; ++line)
+  {
+    std::vector<vtkIdType> ids = { 0 };
+    for (int i = 1; i < numPtsPerLine && line % 17 != 3; ++i)
+    {
+      const double t = 0.1 * i;
+      const double angle = t + 0.05 * line;
+      ids.push_back(points->InsertNextPoint(
+        (1.0 + 0.01 * line) * std::cos(angle), std::sin(angle), 0.2 * t));
+      scalars->InsertNextValue(t);
+      if (line % 5 == 1 && i == numPtsPerLine / 2)
+      {
+        ids.push_back(ids.back());
+      }
+    }
+    polylines->InsertNextCell(static_cast<vtkIdType>(ids.size()), ids.data());
+    cellData->InsertNextValue(line);
+  }
+
+  polylines->InsertNextCell(numPtsPerLine);
+  for (int i = 0; i < numPtsPerLine; ++i)
+  {
+    polylines->InsertCellPoint(points->InsertNextPoint(0.0, 0.0, 0.5 * i));
+    scalars->InsertNextValue(0.1 * i);
+  }
+  cellData->InsertNextValue(numLines);
+
+  lines->SetPoints(points);
+  lines->SetVerts(verts);
+  lines->SetLines(polylines);
+  lines->GetPointData()->SetScalars(scalars);
+  lines->GetCellData()->AddArray(cellData);
+}
+
+//------------------------------------------------------------------------------
+bool CompareArrays(vtkDataArray* serial, vtkDataArray* parallel)
+{
+  if (!serial || !parallel || serial->GetNumberOfTuples() != parallel->GetNumberOfTuples() ||
+    serial->GetNumberOfComponents() != parallel->GetNumberOfComponents())
+  {
+    return false;
+  }
+  const int numComps = serial->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < serial->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < numComps; ++c)
+    {
+      if (serial->GetComponent(i, c) != parallel->GetComponent(i, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool CompareAttributes(vtkDataSetAttributes* serial, vtkDataSetAttributes* parallel)
+{
+  if (serial->GetNumberOfArrays() != parallel->GetNumberOfArrays())
+  {
+    std::cerr << "Wrong number of arrays." << std::endl;
+    return false;
+  }
+  for (int i = 0; i < serial->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = serial->GetArray(i);
+    if (!CompareArrays(array, parallel->GetArray(array->GetName())))
+    {
+      std::cerr << "The arrays " << array->GetName() << " differ." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Check that both outputs have the same points, strips and attributes.
+bool CompareOutputs(vtkPolyData* serial, vtkPolyData* parallel)
+{
+  if (serial->GetNumberOfPoints() != parallel->GetNumberOfPoints() ||
+    serial->GetNumberOfStrips() != parallel->GetNumberOfStrips() ||
+    serial->GetNumberOfCells() != parallel->GetNumberOfCells())
+  {
+    std::cerr << "Got " << parallel->GetNumberOfPoints() << " points and "
+              << parallel->GetNumberOfStrips() << " strips instead of "
+              << serial->GetNumberOfPoints() << " and " << serial->GetNumberOfStrips()
+              << std::endl;
+    return false;
+  }
+  if (serial->GetNumberOfPoints() == 0 ||
+    !CompareArrays(serial->GetPoints()->GetData(), parallel->GetPoints()->GetData()))
+  {
+    std::cerr << "The points differ." << std::endl;
+    return false;
+  }
+  vtkNew<vtkIdList> serialPts;
+  vtkNew<vtkIdList> parallelPts;
+  for (vtkIdType cellId = 0; cellId < serial->GetNumberOfCells(); ++cellId)
+  {
+    serial->GetCellPoints(cellId, serialPts);
+    parallel->GetCellPoints(cellId, parallelPts);
+    bool same = serialPts->GetNumberOfIds() == parallelPts->GetNumberOfIds();
+    for (vtkIdType i = 0; same && i < serialPts->GetNumberOfIds(); ++i)
+    {
+      same = serialPts->GetId(i) == parallelPts->GetId(i);
+    }
+    if (!same)
+    {
+      std::cerr << "Wrong strip " << cellId << std::endl;
+      return false;
+    }
+  }
+  if (!CompareAttributes(serial->GetPointData(), parallel->GetPointData()) ||
+    !CompareAttributes(serial->GetCellData(), parallel->GetCellData()))
+  {
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestTubeFilterParallel(int, char*[])
+{
+  vtkNew<vtkPolyData> lines;
+  CreateLines(lines, 200, 60);
+
+  for (int config = 0; config < 4; ++config)
+  {
+    vtkNew<vtkTubeFilter> tubes[2];
+    for (int parallel = 0; parallel < 2; ++parallel)
+    {
+      vtkTubeFilter* tube = tubes[parallel];
+      tube->SetInputData(lines);
+      tube->SetRadius(0.02);
+      tube->SetNumberOfSides(config == 2 ? 5 : 8);
+      tube->SetCapping(config % 2 != 0);
+      tube->SetSidesShareVertices(config < 2);
+      tube->SetOnRatio(config == 2 ? 2 : 1);
+      tube->SetOffset(config == 2 ? 1 : 0);
+      tube->SetVaryRadius(config == 3 ? VTK_VARY_RADIUS_BY_SCALAR : VTK_VARY_RADIUS_OFF);
+      tube->SetGenerateTCoords(config == 1 ? VTK_TCOORDS_FROM_LENGTH : VTK_TCOORDS_FROM_SCALARS);
+      tube->SetUseDefaultNormal(config == 3);
+      tube->SetParallelGeneration(parallel != 0);
+      tube->Update();
+    }
+    if (!CompareOutputs(tubes[0]->GetOutput(), tubes[1]->GetOutput()))
+    {
+      std::cerr << "Failed with configuration " << config << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
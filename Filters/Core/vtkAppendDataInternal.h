@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkAppendDataInternal
+ * @brief   threaded copy of the inputs of the append filters
+ *
+ * vtkAppendDataInternal provides the pieces shared by vtkAppendPolyData and
+ * vtkAppendFilter to copy their inputs in parallel: once the offset of each
+ * input in the output is known and the output arrays and cell arrays are
+ * sized, each input is copied to its own range of the output, concurrently
+ * with the other inputs.
+ *
+ * Only vtkDataArray attributes, excepting vtkBitArray, can be written
+ * concurrently. The other arrays, such as vtkStringArray, are copied in a
+ * serial pass after the threaded one.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkAppendPolyData vtkAppendFilter
+ */
+
+#ifndef vtkAppendDataInternal_h
+#define vtkAppendDataInternal_h
+
+#include "vtkArrayDispatch.h"
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSetAttributes.h"
+
+#include <algorithm>
+
+namespace
+{ // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Copy NumberOfTuples tuples of src, starting at SrcStart, to dst, starting at
+// DstStart. dst must have enough tuples.
+struct CopyTuplesWorker
+{
+  vtkIdType DstStart;
+  vtkIdType SrcStart;
+  vtkIdType NumberOfTuples;
+
+  template <typename DstArrayT, typename SrcArrayT>
+  void operator()(DstArrayT* dst, SrcArrayT* src)
+  {
+    const auto srcTuples =
+      vtk::DataArrayTupleRange(src, this->SrcStart, this->SrcStart + this->NumberOfTuples);
+    auto dstTuples = vtk::DataArrayTupleRange(dst, this->DstStart);
+    std::copy(srcTuples.cbegin(), srcTuples.cend(), dstTuples.begin());
+  }
+};
+
+//------------------------------------------------------------------------------
+// Copy NumberOfValues values of src plus Shift to dst, starting at DstStart.
+// Used to renumber the offsets and connectivity of appended cell arrays.
+struct ShiftValuesWorker
+{
+  vtkIdType DstStart;
+  vtkIdType NumberOfValues;
+  vtkIdType Shift;
+
+  template <typename DstArrayT, typename SrcArrayT>
+  void operator()(DstArrayT* dst, SrcArrayT* src)
+  {
+    using DstValueType = vtk::GetAPIType<DstArrayT>;
+    const auto srcValues = vtk::DataArrayValueRange<1>(src, 0, this->NumberOfValues);
+    auto dstValues = vtk::DataArrayValueRange<1>(dst, this->DstStart);
+    const vtkIdType shift = this->Shift;
+    std::transform(srcValues.cbegin(), srcValues.cend(), dstValues.begin(),
+      [shift](vtkIdType value) { return static_cast<DstValueType>(value + shift); });
+  }
+};
+
+//------------------------------------------------------------------------------
+// Size the cell array appending numCells cells of connectivitySize point ids,
+// whose offsets and connectivity are then filled by AppendCellsInRange().
+inline void SizeAppendedCells(
+  vtkCellArray* cells, vtkIdType numCells, vtkIdType connectivitySize)
+{
+  cells->GetOffsetsArray()->SetNumberOfTuples(numCells + 1);
+  cells->GetOffsetsArray()->SetComponent(numCells, 0, static_cast<double>(connectivitySize));
+  cells->GetConnectivityArray()->SetNumberOfTuples(connectivitySize);
+}
+
+//------------------------------------------------------------------------------
+// Copy the cells of src to dst, starting at cell cellStart and at connectivity
+// connectivityStart, and shift their point ids by ptOffset. Thread safe when
+// the ranges of the calls do not overlap.
+inline void AppendCellsInRange(vtkCellArray* dst, vtkCellArray* src, vtkIdType cellStart,
+  vtkIdType connectivityStart, vtkIdType ptOffset)
+{
+  using StorageArrays = vtkCellArray::StorageArrayList;
+  using Dispatcher = vtkArrayDispatch::Dispatch2ByArray<StorageArrays, StorageArrays>;
+  if (!src || src->GetNumberOfCells() == 0)
+  {
+    return;
+  }
+  ShiftValuesWorker offsetsWorker{ cellStart, src->GetNumberOfCells(), connectivityStart };
+  if (!Dispatcher::Execute(dst->GetOffsetsArray(), src->GetOffsetsArray(), offsetsWorker))
+  {
+    offsetsWorker(dst->GetOffsetsArray(), src->GetOffsetsArray());
+  }
+  ShiftValuesWorker connectivityWorker{ connectivityStart,
+    src->GetNumberOfConnectivityIds(), ptOffset };
+  if (!Dispatcher::Execute(
+        dst->GetConnectivityArray(), src->GetConnectivityArray(), connectivityWorker))
+  {
+    connectivityWorker(dst->GetConnectivityArray(), src->GetConnectivityArray());
+  }
+}
+
+//------------------------------------------------------------------------------
+// Return true when the tuples of array can be written concurrently.
+inline bool IsThreadSafeArray(vtkAbstractArray* array)
+{
+  return vtkDataArray::SafeDownCast(array) && !vtkBitArray::SafeDownCast(array);
+}
+
+//------------------------------------------------------------------------------
+// Size the output arrays, allocated by CopyAllocate(), to numTuples tuples.
+inline void SizeAppendedArrays(vtkDataSetAttributes* output, vtkIdType numTuples)
+{
+  for (int i = 0; i < output->GetNumberOfArrays(); ++i)
+  {
+    output->GetAbstractArray(i)->SetNumberOfTuples(numTuples);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Copy numTuples tuples of the arrays of input, starting at srcStart, to the
+// arrays of output, starting at dstStart. When threadSafe is true, only the
+// arrays for which IsThreadSafeArray() is true are copied and the call is
+// thread safe for non-overlapping output ranges. Otherwise, the other arrays
+// are copied.
+inline void CopyAppendedTuples(const vtkDataSetAttributes::FieldList& list, int inputIndex,
+  vtkDataSetAttributes* input, vtkIdType srcStart, vtkIdType numTuples,
+  vtkDataSetAttributes* output, vtkIdType dstStart, bool threadSafe)
+{
+  if (numTuples <= 0)
+  {
+    return;
+  }
+  list.TransformData(
+    inputIndex, input, output, [&](vtkAbstractArray* inArray, vtkAbstractArray* outArray) {
+      if (IsThreadSafeArray(outArray) != threadSafe)
+      {
+        return;
+      }
+      if (!threadSafe)
+      {
+        outArray->InsertTuples(dstStart, numTuples, srcStart, inArray);
+        return;
+      }
+      vtkDataArray* dst = vtkDataArray::SafeDownCast(outArray);
+      vtkDataArray* src = vtkDataArray::SafeDownCast(inArray);
+      CopyTuplesWorker worker{ dstStart, srcStart, numTuples };
+      if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(dst, src, worker))
+      {
+        // Use vtkDataArray API when fast-path dispatch fails.
+        worker(dst, src);
+      }
+    });
+}
+
+} // anonymous namespace
+
+#endif // vtkAppendDataInternal_h
+// VTK-HeaderTest-Exclude: vtkAppendDataInternal.h
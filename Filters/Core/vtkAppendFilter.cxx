@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkAppendFilter.h"
 
+#include "vtkAppendDataInternal.h"
 #include "vtkBoundingBox.h"
 #include "vtkCell.h"
 #include "vtkCellData.h"
@@ -13,12 +14,16 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <numeric>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkAppendFilter);
@@ -236,6 +241,18 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // Offset of each input in the output points
+  std::vector<vtkDataSet*> dataSets;
+  std::vector<vtkIdType> ptOffsets;
+  vtkIdType numPtsSoFar = 0;
+  inputs->InitTraversal(iter);
+  while ((dataSet = inputs->GetNextDataSet(iter)))
+  {
+    dataSets.push_back(dataSet);
+    ptOffsets.push_back(numPtsSoFar);
+    numPtsSoFar += dataSet->GetNumberOfPoints();
+  }
+
   // If we aren't merging points, we need to allocate the points here.
   if (!reallyMergePoints)
   {
@@ -252,6 +269,101 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   // For optionally merging duplicate points
   vtkIdType* globalIndices = new vtkIdType[totalNumPts];
 
+  // Without merging, each input is copied to its own range of the output
+  // points, concurrently with the other inputs.
+  if (!reallyMergePoints)
+  {
+    for (vtkDataSet* ds : dataSets)
+    {
+      // GetPoint() is thread safe once called from a single thread.
+      if (!vtkPointSet::SafeDownCast(ds) && ds->GetNumberOfPoints() > 0)
+      {
+        double x[3];
+        ds->GetPoint(0, x);
+      }
+    }
+    vtkSMPTools::For(
+      0, static_cast<vtkIdType>(dataSets.size()), 1, [&](vtkIdType begin, vtkIdType end) {
+        double x[3];
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          vtkDataSet* ds = dataSets[i];
+          const vtkIdType offset = ptOffsets[i];
+          const vtkIdType numPts = ds->GetNumberOfPoints();
+          std::iota(globalIndices + offset, globalIndices + offset + numPts, offset);
+          vtkPointSet* ps = vtkPointSet::SafeDownCast(ds);
+          if (ps && ps->GetPoints())
+          {
+            CopyTuplesWorker worker{ offset, 0, numPts };
+            using Dispatcher = vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::Reals,
+              vtkArrayDispatch::Reals>;
+            if (!Dispatcher::Execute(newPts->GetData(), ps->GetPoints()->GetData(), worker))
+            {
+              worker(newPts->GetData(), ps->GetPoints()->GetData());
+            }
+          }
+          else
+          {
+            for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+            {
+              ds->GetPoint(ptId, x);
+              newPts->GetData()->SetTuple(offset + ptId, x);
+            }
+          }
+        }
+      });
+    this->UpdateProgress(0.25);
+  }
+
+  // Without merging, the cells of unstructured grids without polyhedra are
+  // also copied concurrently.
+  bool threadedCells = !reallyMergePoints;
+  vtkIdType numCells = 0;
+  vtkIdType connectivitySize = 0;
+  std::vector<vtkIdType> cellOffsets;
+  std::vector<vtkIdType> connectivityOffsets;
+  for (vtkDataSet* ds : dataSets)
+  {
+    vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(ds);
+    if (!threadedCells || !ug || (ug->GetPolyhedronFaces() && ug->GetNumberOfCells() > 0))
+    {
+      threadedCells = false;
+      break;
+    }
+    cellOffsets.push_back(numCells);
+    connectivityOffsets.push_back(connectivitySize);
+    if (ug->GetNumberOfCells() > 0)
+    {
+      numCells += ug->GetNumberOfCells();
+      connectivitySize += ug->GetCells()->GetNumberOfConnectivityIds();
+    }
+  }
+  if (threadedCells)
+  {
+    vtkNew<vtkCellArray> cells;
+    cells->AllocateExact(numCells, connectivitySize);
+    SizeAppendedCells(cells, numCells, connectivitySize);
+    vtkNew<vtkUnsignedCharArray> types;
+    types->SetNumberOfValues(numCells);
+    vtkSMPTools::For(
+      0, static_cast<vtkIdType>(dataSets.size()), 1, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          vtkUnstructuredGrid* ug = static_cast<vtkUnstructuredGrid*>(dataSets[i]);
+          if (ug->GetNumberOfCells() == 0)
+          {
+            continue;
+          }
+          AppendCellsInRange(
+            cells, ug->GetCells(), cellOffsets[i], connectivityOffsets[i], ptOffsets[i]);
+          const auto inTypes = vtk::DataArrayValueRange<1>(ug->GetCellTypesArray());
+          std::copy(inTypes.cbegin(), inTypes.cend(), types->GetPointer(cellOffsets[i]));
+        }
+      });
+    output->SetCells(types, cells);
+    this->UpdateProgress(0.5);
+  }
+
   vtkSmartPointer<vtkIncrementalOctreePointLocator> ptInserter;
   if (reallyMergePoints)
   {
@@ -298,7 +410,7 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
       : nullptr;
 
     // copy points
-    for (vtkIdType ptId = 0; ptId < dataSetNumPts && !abort; ++ptId)
+    for (vtkIdType ptId = 0; reallyMergePoints && ptId < dataSetNumPts && !abort; ++ptId)
     {
       if (reallyMergePoints)
       {
@@ -327,12 +439,6 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
           // The point inserter puts the point into newPts, so we don't have to do that here.
         }
       }
-      else
-      {
-        globalIndices[ptId + ptOffset] = ptId + ptOffset;
-        dataSet->GetPoint(ptId, p);
-        newPts->SetPoint(ptId + ptOffset, p);
-      }
 
       // Update progress
       count++;
@@ -346,7 +452,7 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
     // copy cell
     vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
-    for (vtkIdType cellId = 0; cellId < dataSetNumCells && !abort; ++cellId)
+    for (vtkIdType cellId = 0; !threadedCells && cellId < dataSetNumCells && !abort; ++cellId)
     {
       newPtIds->Reset();
       if (ug && dataSet->GetCellType(cellId) == VTK_POLYHEDRON)
@@ -396,8 +502,8 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->GetCellData()->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
 
   // Now copy the array data
-  this->AppendArrays(
-    vtkDataObject::POINT, inputVector, globalIndices, output, newPts->GetNumberOfPoints());
+  this->AppendArrays(vtkDataObject::POINT, inputVector, reallyMergePoints ? globalIndices : nullptr,
+    output, newPts->GetNumberOfPoints());
   this->UpdateProgress(0.75);
   this->AppendArrays(vtkDataObject::CELL, inputVector, nullptr, output, output->GetNumberOfCells());
   this->UpdateProgress(1.0);
@@ -467,26 +573,51 @@ void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** in
   // copy arrays.
   int inputIndex;
   vtkIdType offset = 0;
-  for (inputIndex = 0, dataSet = nullptr, inputs->InitTraversal(iter);
-       (dataSet = inputs->GetNextDataSet(iter));)
+  if (globalIds != nullptr)
   {
-    if (auto inputData = dataSet->GetAttributes(attributesType))
+    for (inputIndex = 0, dataSet = nullptr, inputs->InitTraversal(iter);
+         (dataSet = inputs->GetNextDataSet(iter));)
     {
-      const auto numberOfInputTuples = inputData->GetNumberOfTuples();
-      if (globalIds != nullptr)
+      if (auto inputData = dataSet->GetAttributes(attributesType))
       {
+        const auto numberOfInputTuples = inputData->GetNumberOfTuples();
         for (vtkIdType id = 0; id < numberOfInputTuples; ++id)
         {
           fieldList.CopyData(inputIndex, inputData, id, outputData, globalIds[offset + id]);
         }
+        offset += numberOfInputTuples;
+        ++inputIndex;
       }
-      else
+    }
+    return;
+  }
+
+  // Without renumbering, each input is copied to its own range of the output,
+  // concurrently with the other inputs.
+  std::vector<vtkDataSetAttributes*> inputDatas;
+  std::vector<vtkIdType> offsets;
+  for (dataSet = nullptr, inputs->InitTraversal(iter); (dataSet = inputs->GetNextDataSet(iter));)
+  {
+    if (auto inputData = dataSet->GetAttributes(attributesType))
+    {
+      inputDatas.push_back(inputData);
+      offsets.push_back(offset);
+      offset += inputData->GetNumberOfTuples();
+    }
+  }
+  SizeAppendedArrays(outputData, offset);
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(inputDatas.size()), 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
       {
-        fieldList.CopyData(inputIndex, inputData, 0, numberOfInputTuples, outputData, offset);
+        CopyAppendedTuples(fieldList, static_cast<int>(i), inputDatas[i], 0,
+          inputDatas[i]->GetNumberOfTuples(), outputData, offsets[i], true);
       }
-      offset += numberOfInputTuples;
-      ++inputIndex;
-    }
+    });
+  for (inputIndex = 0; inputIndex < static_cast<int>(inputDatas.size()); ++inputIndex)
+  {
+    CopyAppendedTuples(fieldList, inputIndex, inputDatas[inputIndex], 0,
+      inputDatas[inputIndex]->GetNumberOfTuples(), outputData, offsets[inputIndex], false);
   }
 }
 
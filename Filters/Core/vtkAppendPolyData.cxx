@@ -3,6 +3,7 @@
 #include "vtkAppendPolyData.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkAppendDataInternal.h"
 #include "vtkArrayDispatch.h"
 #include "vtkAssume.h"
 #include "vtkCellArray.h"
@@ -14,11 +15,13 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTrivialProducer.h"
 
 #include <cassert>
 #include <cstdlib>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkAppendPolyData);
@@ -113,13 +116,12 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
 {
   int idx;
   vtkPolyData* ds;
-  vtkPoints* inPts;
   vtkPoints* newPts;
-  vtkCellArray *inVerts, *newVerts;
-  vtkCellArray *inLines, *newLines;
-  vtkCellArray *inPolys, *newPolys;
+  vtkCellArray* newVerts;
+  vtkCellArray* newLines;
+  vtkCellArray* newPolys;
   vtkIdType sizePolys, numPolys;
-  vtkCellArray *inStrips, *newStrips;
+  vtkCellArray* newStrips;
   vtkIdType numPts, numCells;
   vtkPointData* inPD = nullptr;
   vtkCellData* inCD = nullptr;
@@ -141,11 +143,18 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
 
   // These Field lists are very picky.  Count the number of non empty inputs
   // so we can initialize them properly.
+  int numNonEmptyInputs = 0;
+  vtkPolyData* nonEmptyInput = nullptr;
   for (idx = 0; idx < numInputs; ++idx)
   {
     ds = inputs[idx];
     if (ds != nullptr)
     {
+      if (ds->GetNumberOfPoints() > 0 || ds->GetNumberOfCells() > 0)
+      {
+        ++numNonEmptyInputs;
+        nonEmptyInput = ds;
+      }
       if (ds->GetNumberOfPoints() > 0)
       {
         ++countPD;
@@ -233,6 +242,19 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
     vtkDebugMacro(<< "No data to append!");
     return 1;
   }
+
+  // A single non empty input is passed without copying anything, unless its
+  // points must be converted to another precision.
+  if (numNonEmptyInputs == 1 && nonEmptyInput->GetPoints() &&
+    (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION ||
+      nonEmptyInput->GetPoints()->GetDataType() ==
+        (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION ? VTK_FLOAT : VTK_DOUBLE)))
+  {
+    output->CopyStructure(nonEmptyInput);
+    outputPD->ShallowCopy(nonEmptyInput->GetPointData());
+    outputCD->ShallowCopy(nonEmptyInput->GetCellData());
+    return 1;
+  }
   this->UpdateProgress(0.10);
 
   // Examine the points and check if they're the same type. If not,
@@ -276,41 +298,32 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
 
   newPts->SetNumberOfPoints(numPts);
 
-  newVerts = vtkCellArray::New();
-  bool allocated = newVerts->AllocateExact(numVerts, sizeVerts);
-
-  if (sizeVerts > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
-  }
-
-  newLines = vtkCellArray::New();
-  allocated = newLines->AllocateExact(numLines, sizeLines);
-
-  if (sizeLines > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
-  }
-
-  newPolys = vtkCellArray::New();
-  allocated = newPolys->AllocateExact(numPolys, sizePolys);
-
-  if (sizePolys > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
-  }
-
-  newStrips = vtkCellArray::New();
-  allocated = newStrips->AllocateExact(numStrips, sizeStrips);
-
-  if (sizeStrips > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
+  vtkCellArray* newCells[4];
+  const vtkIdType numCellsOfType[4] = { numVerts, numLines, numPolys, numStrips };
+  const vtkIdType sizeOfType[4] = { sizeVerts, sizeLines, sizePolys, sizeStrips };
+  // These are the output cell ids at which each of the cell types start.
+  const vtkIdType firstCellOfType[4] = { 0, numVerts, numVerts + numLines,
+    numVerts + numLines + numPolys };
+  for (int type = 0; type < 4; ++type)
+  {
+    newCells[type] = vtkCellArray::New();
+    bool allocated = newCells[type]->AllocateExact(numCellsOfType[type], sizeOfType[type]);
+    if (sizeOfType[type] > 0 && !allocated)
+    {
+      vtkErrorMacro(<< "Memory allocation failed in append filter");
+      for (int i = 0; i <= type; ++i)
+      {
+        newCells[i]->Delete();
+      }
+      newPts->Delete();
+      return 0;
+    }
+    SizeAppendedCells(newCells[type], numCellsOfType[type], sizeOfType[type]);
   }
+  newVerts = newCells[0];
+  newLines = newCells[1];
+  newPolys = newCells[2];
+  newStrips = newCells[3];
 
   // Since points are cells are not merged,
   // this filter can easily pass all field arrays, including global ids.
@@ -320,79 +333,117 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
   // Allocate the point and cell data
   outputPD->CopyAllocate(ptList, numPts);
   outputCD->CopyAllocate(cellList, numCells);
-
-  // loop over all input sets
-  vtkIdType ptOffset = 0;
-  vtkIdType vertOffset = 0;
-  vtkIdType linesOffset = numVerts;
-  vtkIdType polysOffset = numVerts + numLines;
-  vtkIdType stripsOffset = numVerts + numLines + numPolys;
+  SizeAppendedArrays(outputPD, numPts);
+  SizeAppendedArrays(outputCD, numCells);
+
+  // Compute where each input goes in the output, so that the inputs can be
+  // copied concurrently. Cell[type] is the index of the first cell of the
+  // input in the cell array of that type.
+  struct InputRange
+  {
+    vtkIdType Point = 0;
+    vtkIdType Cell[4] = { 0, 0, 0, 0 };
+    vtkIdType Connectivity[4] = { 0, 0, 0, 0 };
+    int PointDataIndex = -1;
+    int CellDataIndex = -1;
+  };
+  std::vector<InputRange> ranges(numInputs);
+  InputRange next;
   countPD = countCD = 0;
-  int checkAbortInterval = std::min(numInputs / 10 + 1, 1000);
   for (idx = 0; idx < numInputs; ++idx)
   {
-    if (idx % checkAbortInterval == 0 && this->CheckAbort())
+    ds = inputs[idx];
+    if (ds == nullptr || (ds->GetNumberOfPoints() <= 0 && ds->GetNumberOfCells() <= 0))
     {
-      break;
+      continue;
     }
-    this->UpdateProgress(0.2 + 0.8 * idx / numInputs);
-    ds = inputs[idx];
-    // this check is not necessary, but I'll put it in anyway
-    if (ds != nullptr)
+    ranges[idx] = next;
+    if (ds->GetNumberOfPoints() > 0)
+    {
+      ranges[idx].PointDataIndex = countPD++;
+      next.Point += ds->GetNumberOfPoints();
+    }
+    if (ds->GetNumberOfCells() > 0)
     {
-      numPts = ds->GetNumberOfPoints();
-      numCells = ds->GetNumberOfCells();
-      if (numPts <= 0 && numCells <= 0)
+      ranges[idx].CellDataIndex = countCD++;
+      vtkCellArray* inCells[4] = { ds->GetVerts(), ds->GetLines(), ds->GetPolys(),
+        ds->GetStrips() };
+      for (int type = 0; type < 4; ++type)
       {
-        continue; // no input, just skip
+        if (inCells[type])
+        {
+          next.Cell[type] += inCells[type]->GetNumberOfCells();
+          next.Connectivity[type] += inCells[type]->GetNumberOfConnectivityIds();
+        }
       }
+    }
+  }
+  this->UpdateProgress(0.20);
 
-      inPD = ds->GetPointData();
-      inCD = ds->GetCellData();
-
-      inPts = ds->GetPoints();
-      inVerts = ds->GetVerts();
-      inLines = ds->GetLines();
-      inPolys = ds->GetPolys();
-      inStrips = ds->GetStrips();
-
-      if (ds->GetNumberOfPoints() > 0)
+  // Copy the inputs concurrently: each input has its own range of points,
+  // cells and tuples in the output.
+  vtkSMPTools::For(0, numInputs, 1, [&](vtkIdType begin, vtkIdType end) {
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      vtkPolyData* input = inputs[i];
+      const InputRange& range = ranges[i];
+      if (range.PointDataIndex >= 0)
       {
         // copy points directly
-        this->AppendData(newPts->GetData(), inPts->GetData(), ptOffset);
-        outputPD->CopyData(ptList, inPD, countPD, ptOffset, numPts, 0);
-        ++countPD;
+        this->AppendData(newPts->GetData(), input->GetPoints()->GetData(), range.Point);
+        CopyAppendedTuples(ptList, range.PointDataIndex, input->GetPointData(), 0,
+          input->GetNumberOfPoints(), outputPD, range.Point, true);
       }
+      if (range.CellDataIndex >= 0)
+      {
+        // copy the cells and their data, cell type by cell type
+        vtkCellArray* inCells[4] = { input->GetVerts(), input->GetLines(), input->GetPolys(),
+          input->GetStrips() };
+        vtkIdType inputCellId = 0;
+        for (int type = 0; type < 4; ++type)
+        {
+          vtkIdType numTypeCells = inCells[type] ? inCells[type]->GetNumberOfCells() : 0;
+          AppendCellsInRange(newCells[type], inCells[type], range.Cell[type],
+            range.Connectivity[type], range.Point);
+          CopyAppendedTuples(cellList, range.CellDataIndex, input->GetCellData(), inputCellId,
+            numTypeCells, outputCD, firstCellOfType[type] + range.Cell[type], true);
+          inputCellId += numTypeCells;
+        }
+      }
+    }
+  });
+  this->UpdateProgress(0.90);
 
-      if (ds->GetNumberOfCells() > 0)
+  // Copy the arrays that cannot be written concurrently, if any.
+  for (idx = 0; idx < numInputs && !this->GetAbortOutput(); ++idx)
+  {
+    ds = inputs[idx];
+    const InputRange& range = ranges[idx];
+    if (range.PointDataIndex >= 0)
+    {
+      CopyAppendedTuples(ptList, range.PointDataIndex, ds->GetPointData(), 0,
+        ds->GetNumberOfPoints(), outputPD, range.Point, false);
+    }
+    if (range.CellDataIndex >= 0)
+    {
+      vtkIdType inputCellId = 0;
+      const vtkIdType numTypeCells[4] = { ds->GetNumberOfVerts(), ds->GetNumberOfLines(),
+        ds->GetNumberOfPolys(), ds->GetNumberOfStrips() };
+      for (int type = 0; type < 4; ++type)
       {
-        // These are the cellIDs at which each of the cell types start.
-        vtkIdType vertsIndex = 0;
-        vtkIdType linesIndex = ds->GetNumberOfVerts();
-        vtkIdType polysIndex = linesIndex + ds->GetNumberOfLines();
-        vtkIdType stripsIndex = polysIndex + ds->GetNumberOfPolys();
-
-        // copy the cells
-        this->AppendCells(newVerts, inVerts, ptOffset);
-        this->AppendCells(newLines, inLines, ptOffset);
-        this->AppendCells(newPolys, inPolys, ptOffset);
-        this->AppendCells(newStrips, inStrips, ptOffset);
-
-        // copy cell data
-        outputCD->CopyData(cellList, inCD, countCD, vertOffset, ds->GetNumberOfVerts(), vertsIndex);
-        vertOffset += ds->GetNumberOfVerts();
-        outputCD->CopyData(
-          cellList, inCD, countCD, linesOffset, ds->GetNumberOfLines(), linesIndex);
-        linesOffset += ds->GetNumberOfLines();
-        outputCD->CopyData(
-          cellList, inCD, countCD, polysOffset, ds->GetNumberOfPolys(), polysIndex);
-        polysOffset += ds->GetNumberOfPolys();
-        outputCD->CopyData(
-          cellList, inCD, countCD, stripsOffset, ds->GetNumberOfStrips(), stripsIndex);
-        stripsOffset += ds->GetNumberOfStrips();
-        ++countCD;
+        CopyAppendedTuples(cellList, range.CellDataIndex, ds->GetCellData(), inputCellId,
+          numTypeCells[type], outputCD, firstCellOfType[type] + range.Cell[type], false);
+        inputCellId += numTypeCells[type];
       }
-      ptOffset += numPts;
     }
   }
 
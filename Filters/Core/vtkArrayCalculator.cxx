@@ -12,17 +12,23 @@
 #include "vtkFieldData.h"
 #include "vtkFunctionParser.h"
 #include "vtkGraph.h"
+#include "vtkImplicitArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMolecule.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkSMPTools.h"
 #include "vtkTable.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <string>
+#include <utility>
+
 VTK_ABI_NAMESPACE_BEGIN
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkArrayCalculator);
@@ -52,6 +58,7 @@ vtkArrayCalculator::vtkArrayCalculator()
   this->ReplacementValue = 0.0;
   this->IgnoreMissingArrays = false;
   this->ResultArrayType = VTK_DOUBLE;
+  this->ImplicitResult = false;
 }
 
 //------------------------------------------------------------------------------
@@ -430,6 +437,184 @@ struct vtkArrayCalculatorWorker
   }
 };
 
+//------------------------------------------------------------------------------
+// Variables of the function bound to the components of an array.
+struct vtkArrayCalculatorVariable
+{
+  vtkSmartPointer<vtkDataArray> Array;
+  int Index;
+  int Components[3];
+};
+
+//------------------------------------------------------------------------------
+// Implicit array backend evaluating the function on demand. Each thread evaluates
+// with its own parser and keeps the results of the last evaluated tuples: a
+// request for the tuple following them evaluates a whole block, so that bulk
+// accesses in order amortize the variable lookups, while random accesses only
+// evaluate the requested tuple.
+template <typename TFunctionParser>
+class vtkArrayCalculatorBackend
+{
+public:
+  static constexpr vtkIdType BlockSize = 256;
+
+  vtkArrayCalculatorBackend(TFunctionParser* parser, int numberOfComponents, vtkIdType numTuples,
+    std::vector<vtkArrayCalculatorVariable> scalarVariables,
+    std::vector<vtkArrayCalculatorVariable> vectorVariables, vtkDataArray* coordinates,
+    std::vector<vtkArrayCalculatorVariable> coordinateScalarVariables,
+    std::vector<vtkArrayCalculatorVariable> coordinateVectorVariables)
+    : Function(parser->GetFunction())
+    , ReplaceInvalidValues(parser->GetReplaceInvalidValues())
+    , ReplacementValue(parser->GetReplacementValue())
+    , NumberOfComponents(numberOfComponents)
+    , NumberOfTuples(numTuples)
+    , ScalarVariables(std::move(scalarVariables))
+    , VectorVariables(std::move(vectorVariables))
+    , Coordinates(coordinates)
+    , CoordinateScalarVariables(std::move(coordinateScalarVariables))
+    , CoordinateVectorVariables(std::move(coordinateVectorVariables))
+    , MaxTupleSize(3)
+  {
+    // Record the variables in the order of the parser so that their indices match
+    for (int i = 0; i < parser->GetNumberOfScalarVariables(); ++i)
+    {
+      this->ScalarNames.emplace_back(parser->GetScalarVariableName(i));
+    }
+    for (int i = 0; i < parser->GetNumberOfVectorVariables(); ++i)
+    {
+      this->VectorNames.emplace_back(parser->GetVectorVariableName(i));
+    }
+    for (const auto& variable : this->ScalarVariables)
+    {
+      this->MaxTupleSize = std::max(this->MaxTupleSize, variable.Array->GetNumberOfComponents());
+    }
+    for (const auto& variable : this->VectorVariables)
+    {
+      this->MaxTupleSize = std::max(this->MaxTupleSize, variable.Array->GetNumberOfComponents());
+    }
+  }
+
+  double operator()(vtkIdType idx) const
+  {
+    return this->mapComponent(idx / this->NumberOfComponents, idx % this->NumberOfComponents);
+  }
+
+  double mapComponent(vtkIdType tupleIdx, int comp) const
+  {
+    return this->GetTuple(tupleIdx)[comp];
+  }
+
+  void mapTuple(vtkIdType tupleIdx, double* tuple) const
+  {
+    const double* values = this->GetTuple(tupleIdx);
+    std::copy(values, values + this->NumberOfComponents, tuple);
+  }
+
+private:
+  struct Evaluator
+  {
+    vtkSmartPointer<TFunctionParser> Parser;
+    std::vector<double> Values;
+    std::vector<double> Tuple;
+    vtkIdType Begin = 0;
+    vtkIdType End = 0;
+  };
+
+  const double* GetTuple(vtkIdType tupleIdx) const
+  {
+    Evaluator& evaluator = this->Evaluators.Local();
+    if (tupleIdx < evaluator.Begin || tupleIdx >= evaluator.End)
+    {
+      this->Evaluate(evaluator, tupleIdx, tupleIdx == evaluator.End ? BlockSize : 1);
+    }
+    return evaluator.Values.data() + (tupleIdx - evaluator.Begin) * this->NumberOfComponents;
+  }
+
+  void Evaluate(Evaluator& evaluator, vtkIdType begin, vtkIdType count) const
+  {
+    if (!evaluator.Parser)
+    {
+      auto& parser = evaluator.Parser;
+      parser = vtkSmartPointer<TFunctionParser>::New();
+      parser->SetFunction(this->Function.c_str());
+      parser->SetReplaceInvalidValues(this->ReplaceInvalidValues);
+      parser->SetReplacementValue(this->ReplacementValue);
+      for (const auto& name : this->ScalarNames)
+      {
+        parser->SetScalarVariableValue(name.c_str(), 0.0);
+      }
+      for (const auto& name : this->VectorNames)
+      {
+        parser->SetVectorVariableValue(name.c_str(), 0.0, 0.0, 0.0);
+      }
+      evaluator.Values.resize(BlockSize * this->NumberOfComponents);
+      evaluator.Tuple.resize(this->MaxTupleSize);
+    }
+
+    TFunctionParser* parser = evaluator.Parser;
+    double* tuple = evaluator.Tuple.data();
+    const vtkIdType end = std::min(begin + count, this->NumberOfTuples);
+    double* result = evaluator.Values.data();
+    for (vtkIdType i = begin; i < end; ++i, result += this->NumberOfComponents)
+    {
+      for (const auto& variable : this->ScalarVariables)
+      {
+        variable.Array->GetTuple(i, tuple);
+        parser->SetScalarVariableValue(variable.Index, tuple[variable.Components[0]]);
+      }
+      for (const auto& variable : this->VectorVariables)
+      {
+        variable.Array->GetTuple(i, tuple);
+        parser->SetVectorVariableValue(variable.Index, tuple[variable.Components[0]],
+          tuple[variable.Components[1]], tuple[variable.Components[2]]);
+      }
+      if (this->Coordinates)
+      {
+        double pt[3];
+        this->Coordinates->GetTuple(i, pt);
+        for (const auto& variable : this->CoordinateScalarVariables)
+        {
+          parser->SetScalarVariableValue(variable.Index, pt[variable.Components[0]]);
+        }
+        for (const auto& variable : this->CoordinateVectorVariables)
+        {
+          parser->SetVectorVariableValue(variable.Index, pt[variable.Components[0]],
+            pt[variable.Components[1]], pt[variable.Components[2]]);
+        }
+      }
+      if (this->NumberOfComponents == 1)
+      {
+        result[0] = parser->GetScalarResult();
+      }
+      else
+      {
+        const double* vector = parser->GetVectorResult();
+        std::copy(vector, vector + 3, result);
+      }
+    }
+    evaluator.Begin = begin;
+    evaluator.End = end;
+  }
+
+  std::string Function;
+  vtkTypeBool ReplaceInvalidValues;
+  double ReplacementValue;
+  int NumberOfComponents;
+  vtkIdType NumberOfTuples;
+  std::vector<std::string> ScalarNames;
+  std::vector<std::string> VectorNames;
+  std::vector<vtkArrayCalculatorVariable> ScalarVariables;
+  std::vector<vtkArrayCalculatorVariable> VectorVariables;
+  vtkSmartPointer<vtkDataArray> Coordinates;
+  std::vector<vtkArrayCalculatorVariable> CoordinateScalarVariables;
+  std::vector<vtkArrayCalculatorVariable> CoordinateVectorVariables;
+  int MaxTupleSize;
+  mutable vtkSMPThreadLocal<Evaluator> Evaluators;
+};
+
+template <typename TFunctionParser>
+constexpr vtkIdType vtkArrayCalculatorBackend<TFunctionParser>::BlockSize;
+
 //------------------------------------------------------------------------------
 template <typename TFunctionParser>
 int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* output)
@@ -626,13 +811,17 @@ int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* o
     }
     return 1;
   }
-  else
+  else if (!this->ImplicitResult)
   {
     resultArray.TakeReference(
       vtkArrayDownCast<vtkDataArray>(vtkAbstractArray::CreateArray(this->ResultArrayType)));
   }
 
-  if (resultType == SCALAR_RESULT)
+  if (!resultArray)
+  {
+    // Implicit result, created once the variables are known
+  }
+  else if (resultType == SCALAR_RESULT)
   {
     resultArray->SetNumberOfComponents(1);
     resultArray->SetNumberOfTuples(numTuples);
@@ -695,23 +884,82 @@ int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* o
     }
   }
 
-  vtkArrayCalculatorWorker<TFunctionParser> arrayCalculatorWorker;
-  if (!vtkArrayDispatch::Dispatch::Execute(resultArray.Get(), arrayCalculatorWorker, dsInput,
-        graphInput, inFD, attributeType, this->Function, this->ReplaceInvalidValues,
-        this->ReplacementValue, this->IgnoreMissingArrays, this->ScalarArrayNames,
-        this->VectorArrayNames, this->ScalarVariableNames, this->VectorVariableNames,
-        this->SelectedScalarComponents, this->SelectedVectorComponents,
-        this->CoordinateScalarVariableNames, this->CoordinateVectorVariableNames,
-        this->SelectedCoordinateScalarComponents, this->SelectedCoordinateVectorComponents,
-        scalarArrays, vectorArrays, scalarArrayIndices, vectorArrayIndices, numTuples))
+  if (!resultArray)
   {
-    arrayCalculatorWorker(resultArray.Get(), dsInput, graphInput, inFD, attributeType,
-      this->Function, this->ReplaceInvalidValues, this->ReplacementValue, this->IgnoreMissingArrays,
-      this->ScalarArrayNames, this->VectorArrayNames, this->ScalarVariableNames,
-      this->VectorVariableNames, this->SelectedScalarComponents, this->SelectedVectorComponents,
-      this->CoordinateScalarVariableNames, this->CoordinateVectorVariableNames,
-      this->SelectedCoordinateScalarComponents, this->SelectedCoordinateVectorComponents,
-      scalarArrays, vectorArrays, scalarArrayIndices, vectorArrayIndices, numTuples);
+    // Bind the variables to the arrays, then let the backend evaluate on demand
+    std::vector<vtkArrayCalculatorVariable> scalarVariables;
+    for (size_t cc = 0; cc < scalarArrays.size(); cc++)
+    {
+      if (scalarArrays[cc])
+      {
+        scalarVariables.push_back({ scalarArrays[cc], scalarArrayIndices[cc],
+          { this->SelectedScalarComponents[cc], 0, 0 } });
+      }
+    }
+    std::vector<vtkArrayCalculatorVariable> vectorVariables;
+    for (size_t cc = 0; cc < vectorArrays.size(); cc++)
+    {
+      if (vectorArrays[cc])
+      {
+        const vtkTuple<int, 3>& components = this->SelectedVectorComponents[cc];
+        vectorVariables.push_back({ vectorArrays[cc], vectorArrayIndices[cc],
+          { components[0], components[1], components[2] } });
+      }
+    }
+    vtkDataArray* coordinates = nullptr;
+    std::vector<vtkArrayCalculatorVariable> coordinateScalarVariables;
+    std::vector<vtkArrayCalculatorVariable> coordinateVectorVariables;
+    if ((attributeType == vtkDataObject::POINT || attributeType == vtkDataObject::VERTEX) &&
+      (!this->CoordinateScalarVariableNames.empty() ||
+        !this->CoordinateVectorVariableNames.empty()))
+    {
+      vtkPoints* points = dsInput ? dsInput->GetPoints() : graphInput->GetPoints();
+      coordinates = points ? points->GetData() : nullptr;
+      const int numScalars = static_cast<int>(this->ScalarArrayNames.size());
+      const int numVectors = static_cast<int>(this->VectorArrayNames.size());
+      for (size_t cc = 0; cc < this->CoordinateScalarVariableNames.size(); cc++)
+      {
+        coordinateScalarVariables.push_back({ nullptr, numScalars + static_cast<int>(cc),
+          { this->SelectedCoordinateScalarComponents[cc], 0, 0 } });
+      }
+      for (size_t cc = 0; cc < this->CoordinateVectorVariableNames.size(); cc++)
+      {
+        const vtkTuple<int, 3>& components = this->SelectedCoordinateVectorComponents[cc];
+        coordinateVectorVariables.push_back({ nullptr, numVectors + static_cast<int>(cc),
+          { components[0], components[1], components[2] } });
+      }
+    }
+
+    using BackendType = vtkArrayCalculatorBackend<TFunctionParser>;
+    auto implicitArray = vtkSmartPointer<vtkImplicitArray<BackendType>>::New();
+    implicitArray->ConstructBackend(functionParser.Get(), resultType == SCALAR_RESULT ? 1 : 3,
+      numTuples, std::move(scalarVariables), std::move(vectorVariables), coordinates,
+      std::move(coordinateScalarVariables), std::move(coordinateVectorVariables));
+    implicitArray->SetNumberOfComponents(resultType == SCALAR_RESULT ? 1 : 3);
+    implicitArray->SetNumberOfTuples(numTuples);
+    resultArray = implicitArray;
+  }
+  else
+  {
+    vtkArrayCalculatorWorker<TFunctionParser> arrayCalculatorWorker;
+    if (!vtkArrayDispatch::Dispatch::Execute(resultArray.Get(), arrayCalculatorWorker, dsInput,
+          graphInput, inFD, attributeType, this->Function, this->ReplaceInvalidValues,
+          this->ReplacementValue, this->IgnoreMissingArrays, this->ScalarArrayNames,
+          this->VectorArrayNames, this->ScalarVariableNames, this->VectorVariableNames,
+          this->SelectedScalarComponents, this->SelectedVectorComponents,
+          this->CoordinateScalarVariableNames, this->CoordinateVectorVariableNames,
+          this->SelectedCoordinateScalarComponents, this->SelectedCoordinateVectorComponents,
+          scalarArrays, vectorArrays, scalarArrayIndices, vectorArrayIndices, numTuples))
+    {
+      arrayCalculatorWorker(resultArray.Get(), dsInput, graphInput, inFD, attributeType,
+        this->Function, this->ReplaceInvalidValues, this->ReplacementValue,
+        this->IgnoreMissingArrays, this->ScalarArrayNames, this->VectorArrayNames,
+        this->ScalarVariableNames, this->VectorVariableNames, this->SelectedScalarComponents,
+        this->SelectedVectorComponents, this->CoordinateScalarVariableNames,
+        this->CoordinateVectorVariableNames, this->SelectedCoordinateScalarComponents,
+        this->SelectedCoordinateVectorComponents, scalarArrays, vectorArrays, scalarArrayIndices,
+        vectorArrayIndices, numTuples);
+    }
   }
 
   output->ShallowCopy(input);
@@ -1207,6 +1455,7 @@ void vtkArrayCalculator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Result Array Type: " << vtkImageScalarTypeNameMacro(this->ResultArrayType)
      << endl;
 
+  os << indent << "Implicit Result: " << (this->ImplicitResult ? "On" : "Off") << endl;
   os << indent << "Coordinate Results: " << this->CoordinateResults << endl;
   os << indent << "Attribute Type: " << this->GetAttributeTypeAsString() << endl;
   os << indent << "Replace Invalid Values: " << (this->ReplaceInvalidValues ? "On" : "Off") << endl;
@@ -145,6 +145,22 @@ public:
   vtkSetMacro(ResultArrayType, int);
   ///@}
 
+  ///@{
+  /**
+   * Set whether to output the result as a vtkImplicitArray that evaluates the
+   * function on demand instead of storing every value. Tuples accessed in order are
+   * evaluated by blocks, so that a derived field that is only thresholded or
+   * colored by costs no memory, and a calculator using the implicit result of
+   * another one evaluates both functions in a single pass. The implicit array keeps
+   * references to the arrays used as variables and reflects their later changes.
+   * It always holds doubles: ResultArrayType is ignored. Coordinate results are
+   * always stored. Initial value is false.
+   */
+  vtkGetMacro(ImplicitResult, bool);
+  vtkSetMacro(ImplicitResult, bool);
+  vtkBooleanMacro(ImplicitResult, bool);
+  ///@}
+
   ///@{
   /**
    * Set whether to output results as coordinates.  ResultArrayName will be
@@ -357,6 +373,7 @@ protected:
   std::vector<vtkTuple<int, 3>> SelectedCoordinateVectorComponents;
 
   int ResultArrayType;
+  bool ImplicitResult;
 
 private:
   vtkArrayCalculator(const vtkArrayCalculator&) = delete;
@@ -4,6 +4,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityFilterInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -16,10 +17,13 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkToImplicitTypeErasureStrategy.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
@@ -210,7 +214,12 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
-  if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  if (this->ParallelLabeling && !this->InScalars)
+  {
+    largestRegionId = this->LabelRegionsInParallel(input);
+    this->UpdateProgress(0.9);
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -597,6 +606,73 @@ void vtkConnectivityFilter::TraverseAndMark(vtkDataSet* input)
   } // while wave is not empty
 }
 
+//-------------------------------------------------------------------------------------------------
+vtkIdType vtkConnectivityFilter::LabelRegionsInParallel(vtkDataSet* input)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkConnectedRegionLabeling labeling(input, this);
+  if (!labeling.BuildForest(this->Visited))
+  {
+    std::fill_n(this->Visited, numCells, -1);
+    return 0;
+  }
+  this->UpdateProgress(0.5);
+
+  vtkIdType largestRegionId = 0;
+  if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+  { // regions have been seeded, everything considered in same region
+    std::vector<vtkIdType> seedPoints;
+    std::vector<vtkIdType> seedCells;
+    if (this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+    { // loop over points, find closest one
+      double minDist2 = VTK_DOUBLE_MAX, x[3];
+      vtkIdType minId = 0;
+      for (vtkIdType i = 0; i < numPts; i++)
+      {
+        input->GetPoint(i, x);
+        const double dist2 = vtkMath::Distance2BetweenPoints(x, this->ClosestPoint);
+        if (dist2 < minDist2)
+        {
+          minId = i;
+          minDist2 = dist2;
+        }
+      }
+      seedPoints.push_back(minId);
+    }
+    else
+    {
+      std::vector<vtkIdType>& seeds =
+        this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ? seedPoints : seedCells;
+      seeds.assign(this->Seeds->begin(), this->Seeds->end());
+    }
+    this->NumCellsInRegion = labeling.LabelSeededRegions(this->Visited, seedPoints, seedCells);
+    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+  }
+  else
+  { // visit all cells marking with region number
+    this->RegionNumber = labeling.LabelAllRegions(this->Visited, this->RegionSizes);
+    vtkIdType maxCellsInRegion = 0;
+    for (vtkIdType regionId = 0; regionId < this->RegionNumber; ++regionId)
+    {
+      if (this->RegionSizes->GetValue(regionId) > maxCellsInRegion)
+      {
+        maxCellsInRegion = this->RegionSizes->GetValue(regionId);
+        largestRegionId = regionId;
+      }
+    }
+  }
+
+  vtkSMPTools::For(0, numCells, [this](vtkIdType begin, vtkIdType end) {
+    std::copy(this->Visited + begin, this->Visited + end,
+      this->NewCellScalars->GetPointer(0) + begin);
+  });
+  this->PointNumber = labeling.MapPoints(this->PointMap, this->NewScalars);
+  return largestRegionId;
+}
+
 //-------------------------------------------------------------------------------------------------
 void vtkConnectivityFilter::OrderRegionIds(
   vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds)
@@ -798,6 +874,7 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
   os << indent << "Compress Arrays: " << this->CompressArrays << "\n";
+  os << indent << "Parallel Labeling: " << (this->ParallelLabeling ? "On\n" : "Off\n");
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -218,6 +218,22 @@ public:
   vtkBooleanMacro(CompressArrays, bool);
   ///@}
 
+  ///@{
+  /**
+   * Set/get the labeling of the regions in parallel. When on, the points of
+   * the cells are merged in a lock-free union-find forest, in parallel over
+   * the cells, instead of growing each region with a serial wave over the
+   * cell neighbors. This supports all the extraction modes and gives the same
+   * regions, region ids and extracted cells, but the output points are
+   * ordered as the input points instead of in traversal order. The serial
+   * traversal is used when ScalarConnectivity is on.
+   * Default is false.
+   */
+  vtkSetMacro(ParallelLabeling, bool);
+  vtkGetMacro(ParallelLabeling, bool);
+  vtkBooleanMacro(ParallelLabeling, bool);
+  ///@}
+
 protected:
   vtkConnectivityFilter();
   ~vtkConnectivityFilter() override;
@@ -279,6 +295,12 @@ protected:
    */
   vtkSmartPointer<vtkDataArray> CompressWithImplicit(vtkDataArray* array);
 
+  /**
+   * Mark the cells and points of the regions in parallel, see ParallelLabeling.
+   * Return the id of the largest region.
+   */
+  vtkIdType LabelRegionsInParallel(vtkDataSet* input);
+
 private:
   // used to support algorithm execution
   vtkNew<vtkFloatArray> CellScalars;
@@ -296,6 +318,7 @@ private:
   vtkIdList* PointIds = nullptr;
   vtkIdList* CellIds = nullptr;
   bool CompressArrays = true;
+  bool ParallelLabeling = false;
 
   vtkConnectivityFilter(const vtkConnectivityFilter&) = delete;
   void operator=(const vtkConnectivityFilter&) = delete;
@@ -0,0 +1,302 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkConnectivityFilterInternal
+ * @brief   threaded labeling of the connected regions of a dataset
+ *
+ * vtkConnectivityFilterInternal provides the threaded region labeling shared
+ * by vtkConnectivityFilter and vtkPolyDataConnectivityFilter. Cells are
+ * connected when they share a point, so instead of growing each region with
+ * a wave over the cell links, the points of every cell are merged in a
+ * union-find forest of the points, in parallel over the cells. The forest is
+ * lock-free: a root is only ever linked under a root of smaller id with a
+ * compare-and-swap, and finds compress the paths they walk with path
+ * halving. A region of cells is then a tree of the forest.
+ *
+ * The regions are numbered in the order of their first cell, as the serial
+ * traversal does, so the region ids, the region sizes and the extracted
+ * cells match the ones of the serial traversal. The output points are
+ * numbered in the order of the input points instead of the traversal order.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectivityFilterInternal_h
+#define vtkConnectivityFilterInternal_h
+
+#include "vtkAlgorithm.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+//------------------------------------------------------------------------------
+class vtkConnectedRegionLabeling
+{
+public:
+  vtkConnectedRegionLabeling(vtkDataSet* input, vtkAlgorithm* filter)
+    : Input(input)
+    , Filter(filter)
+    , Parents(input->GetNumberOfPoints())
+    , RootRegions(input->GetNumberOfPoints(), -1)
+  {
+  }
+
+  /**
+   * Merge the points of each cell in the forest, in parallel over the cells,
+   * and write the root of each cell to cellRoots, or -1 for cells without
+   * points. Return false when the filter is aborted.
+   */
+  bool BuildForest(vtkIdType* cellRoots)
+  {
+    const vtkIdType numPts = this->Input->GetNumberOfPoints();
+    const vtkIdType numCells = this->Input->GetNumberOfCells();
+    vtkSMPTools::For(0, numPts, [this](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        this->Parents[ptId].store(ptId, std::memory_order_relaxed);
+      }
+    });
+
+    // GetCellPoints() is thread safe once called from a single thread.
+    vtkNew<vtkIdList> ptIds;
+    this->Input->GetCellPoints(0, ptIds);
+
+    vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* cellPtIds = localPtIds.Local();
+      const bool isFirst = vtkSMPTools::GetSingleThread();
+      const vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (cellId % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->Filter->CheckAbort();
+          }
+          if (this->Filter->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        vtkIdType npts;
+        const vtkIdType* pts;
+        this->Input->GetCellPoints(cellId, npts, pts, cellPtIds);
+        for (vtkIdType i = 1; i < npts; ++i)
+        {
+          this->Union(pts[0], pts[i]);
+        }
+      }
+    });
+    if (this->Filter->GetAbortOutput())
+    {
+      return false;
+    }
+
+    // The forest is complete, the roots of the cells can be found.
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* cellPtIds = localPtIds.Local();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        vtkIdType npts;
+        const vtkIdType* pts;
+        this->Input->GetCellPoints(cellId, npts, pts, cellPtIds);
+        cellRoots[cellId] = npts > 0 ? this->Find(pts[0]) : -1;
+      }
+    });
+    return true;
+  }
+
+  /**
+   * Replace the roots of the cells written by BuildForest() by the ids of
+   * their regions, numbered in the order of their first cell, and append the
+   * number of cells of each region to regionSizes. Return the number of
+   * regions.
+   */
+  vtkIdType LabelAllRegions(vtkIdType* cellRoots, vtkIdTypeArray* regionSizes)
+  {
+    const vtkIdType numCells = this->Input->GetNumberOfCells();
+    vtkIdType numRegions = 0;
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      const vtkIdType root = cellRoots[cellId];
+      vtkIdType regionId;
+      if (root < 0)
+      {
+        // A cell without points is a region on its own.
+        regionId = numRegions++;
+        regionSizes->InsertValue(regionId, 0);
+      }
+      else if ((regionId = this->RootRegions[root]) < 0)
+      {
+        regionId = this->RootRegions[root] = numRegions++;
+        regionSizes->InsertValue(regionId, 0);
+      }
+      regionSizes->SetValue(regionId, regionSizes->GetValue(regionId) + 1);
+      cellRoots[cellId] = regionId;
+    }
+    return numRegions;
+  }
+
+  /**
+   * Replace the roots of the cells written by BuildForest() by 0 for the
+   * cells connected to one of the seed points or seed cells, which form a
+   * single region, and by -1 for the others. Return the number of cells of
+   * the region.
+   */
+  vtkIdType LabelSeededRegions(vtkIdType* cellRoots, const std::vector<vtkIdType>& seedPoints,
+    const std::vector<vtkIdType>& seedCells)
+  {
+    const vtkIdType numPts = this->Input->GetNumberOfPoints();
+    const vtkIdType numCells = this->Input->GetNumberOfCells();
+    std::vector<unsigned char> seededRoots(numPts, 0);
+    for (vtkIdType ptId : seedPoints)
+    {
+      if (ptId >= 0 && ptId < numPts)
+      {
+        seededRoots[this->Find(ptId)] = 1;
+      }
+    }
+    std::vector<unsigned char> seededCells;
+    for (vtkIdType cellId : seedCells)
+    {
+      if (cellId >= 0 && cellId < numCells)
+      {
+        if (cellRoots[cellId] >= 0)
+        {
+          seededRoots[cellRoots[cellId]] = 1;
+        }
+        else
+        {
+          // A cell without points is only connected to itself.
+          seededCells.resize(numCells, 0);
+          seededCells[cellId] = 1;
+        }
+      }
+    }
+
+    // Only the roots of cells are the roots of regions: seed points that are
+    // not used by any cell select no region.
+    vtkIdType count = 0;
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      const vtkIdType root = cellRoots[cellId];
+      if (root >= 0 ? seededRoots[root] != 0 : !seededCells.empty() && seededCells[cellId] != 0)
+      {
+        if (root >= 0)
+        {
+          this->RootRegions[root] = 0;
+        }
+        cellRoots[cellId] = 0;
+        ++count;
+      }
+      else
+      {
+        cellRoots[cellId] = -1;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * Number the points of the labeled regions in the order of the input
+   * points: pointMap receives the output id of each input point, or -1, and
+   * pointRegions the region of each output point. Return the number of
+   * output points.
+   */
+  vtkIdType MapPoints(vtkIdType* pointMap, vtkIdTypeArray* pointRegions)
+  {
+    const vtkIdType numPts = this->Input->GetNumberOfPoints();
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        pointMap[ptId] = this->RootRegions[this->Find(ptId)];
+      }
+    });
+    vtkIdType numOutputPts = 0;
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      const vtkIdType regionId = pointMap[ptId];
+      if (regionId >= 0)
+      {
+        pointRegions->SetValue(numOutputPts, regionId);
+        pointMap[ptId] = numOutputPts++;
+      }
+    }
+    return numOutputPts;
+  }
+
+private:
+  // Find the root of ptId, halving the path to it.
+  vtkIdType Find(vtkIdType ptId)
+  {
+    while (true)
+    {
+      vtkIdType parent = this->Parents[ptId].load(std::memory_order_relaxed);
+      if (parent == ptId)
+      {
+        return ptId;
+      }
+      const vtkIdType grandParent = this->Parents[parent].load(std::memory_order_relaxed);
+      if (grandParent == parent)
+      {
+        return parent;
+      }
+      // A concurrent union or find may change the parent first, which is fine.
+      this->Parents[ptId].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+      ptId = grandParent;
+    }
+  }
+
+  // Merge the trees of ptId0 and ptId1, linking the root of larger id under
+  // the other one.
+  void Union(vtkIdType ptId0, vtkIdType ptId1)
+  {
+    while (true)
+    {
+      ptId0 = this->Find(ptId0);
+      ptId1 = this->Find(ptId1);
+      if (ptId0 == ptId1)
+      {
+        return;
+      }
+      if (ptId0 < ptId1)
+      {
+        std::swap(ptId0, ptId1);
+      }
+      vtkIdType root = ptId0;
+      if (this->Parents[ptId0].compare_exchange_strong(root, ptId1))
+      {
+        return;
+      }
+    }
+  }
+
+  vtkDataSet* Input;
+  vtkAlgorithm* Filter;
+  std::vector<std::atomic<vtkIdType>> Parents;
+  std::vector<vtkIdType> RootRegions;
+};
+
+} // anonymous namespace
+
+#endif // vtkConnectivityFilterInternal_h
+// VTK-HeaderTest-Exclude: vtkConnectivityFilterInternal.h
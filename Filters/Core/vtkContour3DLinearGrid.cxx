@@ -351,6 +351,160 @@ struct ContourCells : public ContourCellsBase<TInputPointsArray, TOutputPointsAr
   void Reduce() override { this->TContourCellsBase::Reduce(); } // Reduce
 };                                                              // ContourCells
 
+// Fast path operator() without scalar tree, contouring all the values in a
+// single traversal of the cells. The scalars of each cell are loaded once and
+// classified against every value; the points are gathered per value and per
+// thread so that the output is ordered as if each value was processed in turn.
+template <typename TInputPointsArray, typename TOutputPointsArray, typename TScalarsArray>
+struct ContourCellsMultiValue
+  : public ContourCellsBase<TInputPointsArray, TOutputPointsArray, TScalarsArray>
+{
+  using TContourCellsBase = ContourCellsBase<TInputPointsArray, TOutputPointsArray, TScalarsArray>;
+  using LocalPointsType = typename TContourCellsBase::LocalPointsType;
+  using ProducePoints = typename TContourCellsBase::ProducePoints;
+  using ProduceTriangles = typename TContourCellsBase::ProduceTriangles;
+
+  struct LocalMultiDataType
+  {
+    std::vector<LocalPointsType> LocalPts;
+    CellIter LocalCellIter;
+  };
+
+  const double* Values;
+  int NumValues;
+  vtkSMPThreadLocal<LocalMultiDataType> LocalMultiData;
+
+  ContourCellsMultiValue(vtkContour3DLinearGrid* filter, TInputPointsArray* inPts,
+    TOutputPointsArray* outPts, TScalarsArray* scalars, CellIter* iter, const double* values,
+    int numValues, vtkCellArray* tris, vtkIdType totalPts, vtkIdType totalTris)
+    : TContourCellsBase(filter, inPts, outPts, scalars, iter, values[0], tris, totalPts, totalTris)
+    , Values(values)
+    , NumValues(numValues)
+  {
+  }
+  ~ContourCellsMultiValue() override = default;
+
+  // Set up the iteration process.
+  void Initialize() override
+  {
+    auto& localData = this->LocalMultiData.Local();
+    localData.LocalCellIter = *(this->Iter);
+    localData.LocalPts.resize(this->NumValues);
+  }
+
+  // operator() method extracts points from cells (points taken three at a
+  // time form a triangle) for all the contour values.
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    auto& localData = this->LocalMultiData.Local();
+    CellIter* cellIter = &localData.LocalCellIter;
+    const vtkIdType* c = cellIter->Initialize(cellId);
+    unsigned short isoCase, numEdges, i;
+    const unsigned short* edges;
+    double s[MAX_CELL_VERTS], sMin, sMax, value, deltaScalar;
+    float t;
+    unsigned char v0, v1;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    auto inPts = vtk::DataArrayTupleRange<3>(this->InPts);
+    auto scalars = vtk::DataArrayValueRange<1>(this->Scalars);
+    vtkIdType checkAbortInterval = std::min((endCellId - cellId) / 10 + 1, (vtkIdType)1000);
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      // Load the cell scalars once for all the values
+      sMin = sMax = s[0] = static_cast<double>(scalars[c[0]]);
+      for (i = 1; i < cellIter->NumVerts; ++i)
+      {
+        s[i] = static_cast<double>(scalars[c[i]]);
+        sMin = std::min(sMin, s[i]);
+        sMax = std::max(sMax, s[i]);
+      }
+
+      for (int vidx = 0; vidx < this->NumValues; ++vidx)
+      {
+        value = this->Values[vidx];
+        if (value > sMax || value <= sMin)
+        {
+          continue; // the case is either empty or full
+        }
+        // Compute case by repeated masking of scalar value
+        for (isoCase = 0, i = 0; i < cellIter->NumVerts; ++i)
+        {
+          isoCase |= (s[i] >= value ? BaseCell::Mask[i] : 0);
+        }
+        edges = cellIter->GetCase(isoCase);
+
+        if (*edges > 0)
+        {
+          auto& lPts = localData.LocalPts[vidx];
+          numEdges = *edges++;
+          for (i = 0; i < numEdges; ++i, edges += 2)
+          {
+            v0 = edges[0];
+            v1 = edges[1];
+            const auto x0 = inPts[c[v0]];
+            const auto x1 = inPts[c[v1]];
+            deltaScalar = s[v1] - s[v0];
+            t = (deltaScalar == 0.0 ? 0.0 : (value - s[v0]) / deltaScalar);
+            lPts.emplace_back(x0[0] + t * (x1[0] - x0[0]));
+            lPts.emplace_back(x0[1] + t * (x1[1] - x0[1]));
+            lPts.emplace_back(x0[2] + t * (x1[2] - x0[2]));
+          } // for all edges in this case
+        }   // if contour passes through this cell
+      }     // for all contour values
+      c = cellIter->Next(); // move to the next cell
+    }                       // for all cells in this batch
+  }
+
+  // Composite results from each thread, value after value so that the
+  // triangles of each value are contiguous in the output.
+  void Reduce() override
+  {
+    vtkIdType numPts = 0;
+    this->NumThreadsUsed = 0;
+    std::vector<LocalPointsType*> localPts;
+    std::vector<vtkIdType> localPtOffsets;
+    for (int vidx = 0; vidx < this->NumValues; ++vidx)
+    {
+      for (auto& localData : this->LocalMultiData)
+      {
+        localPts.push_back(&localData.LocalPts[vidx]);
+        localPtOffsets.push_back((this->TotalPts + numPts));
+        numPts += static_cast<vtkIdType>(localData.LocalPts[vidx].size() / 3);
+        this->NumThreadsUsed += (vidx == 0 ? 1 : 0);
+      }
+    }
+
+    // (Re)Allocate space for output.
+    this->NumPts = numPts;
+    this->NumTris = numPts / 3;
+    this->NewPts->WriteVoidPointer(0, 3 * (this->NumPts + this->TotalPts));
+    this->NewPolys->ResizeExact(
+      this->NumTris + this->TotalTris, 3 * (this->NumTris + this->TotalTris));
+
+    // Copy points output to VTK structures, then produce the triangles. As
+    // every triangle has its own three points, the triangles of all the
+    // values are produced at once.
+    ProducePoints producePts(localPts, localPtOffsets, this->NewPts);
+    EXECUTE_SMPFOR(this->Filter->GetSequentialProcessing(),
+      static_cast<vtkIdType>(localPts.size()), producePts);
+    ProduceTriangles produceTris(this->TotalTris, this->NewPolys);
+    EXECUTE_SMPFOR(this->Filter->GetSequentialProcessing(), this->NumTris, produceTris);
+  } // Reduce
+};  // ContourCellsMultiValue
+
 // Fast path operator() with a scalar tree
 template <typename TInputPointsArray, typename TOutputPointsArray, typename TScalarsArray>
 struct ContourCellsST
@@ -471,6 +625,23 @@ struct ProcessFastPathWorker
   }
 };
 
+// Dispatch worker for Fast path processing of several contour values in a
+// single traversal of the cells (without scalar tree).
+struct ProcessFastPathMultiValueWorker
+{
+  template <typename TInputPointsArray, typename TOutputPointsArray, typename TScalarsArray>
+  void operator()(TInputPointsArray* inPts, TOutputPointsArray* outPts, TScalarsArray* scalars,
+    vtkContour3DLinearGrid* filter, vtkIdType numCells, CellIter* cellIter, const double* values,
+    int numValues, vtkCellArray* tris, int& numThreads)
+  {
+    using TContourCells =
+      ContourCellsMultiValue<TInputPointsArray, TOutputPointsArray, TScalarsArray>;
+    TContourCells contour(
+      filter, inPts, outPts, scalars, cellIter, values, numValues, tris, 0, 0);
+    EXECUTE_REDUCED_SMPFOR(filter->GetSequentialProcessing(), numCells, contour, numThreads);
+  }
+};
+
 //========================= GENERAL PATH (POINT MERGING) =======================
 // Use vtkStaticEdgeLocatorTemplate for edge-based point merging. Processing is
 // available with and without a scalar tree.
@@ -1531,7 +1702,21 @@ void vtkContour3DLinearGrid::ProcessPiece(
 
   // Now produce the output: fast path or general path
   bool mergePoints = this->MergePoints || this->ComputeNormals || this->InterpolateAttributes;
-  if (!mergePoints)
+  if (!mergePoints && !stree && numContours > 1)
+  { // fast path, all the contour values are processed in a single traversal
+    using ScalarsList = vtkTypeList::Create<unsigned int, int, float, double>;
+    using Dispatcher = vtkArrayDispatch::Dispatch3ByValueType<vtkArrayDispatch::Reals,
+      vtkArrayDispatch::Reals, ScalarsList>;
+
+    ProcessFastPathMultiValueWorker worker;
+    if (!Dispatcher::Execute(inPts->GetData(), outPts->GetData(), inScalars, worker, this,
+          numCells, cellIter, values, numContours, newPolys.Get(), this->NumberOfThreadsUsed))
+    {
+      worker(inPts->GetData(), outPts->GetData(), inScalars, this, numCells, cellIter, values,
+        numContours, newPolys.Get(), this->NumberOfThreadsUsed);
+    }
+  }
+  else if (!mergePoints)
   { // fast path
     // Generate all of the points at once (for multiple contours) and then produce the triangles.
     for (int vidx = 0; vidx < numContours; vidx++)
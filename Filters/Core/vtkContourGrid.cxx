@@ -26,7 +26,7 @@
 #include "vtkSimpleScalarTree.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
-#include "vtkUnstructuredGridBase.h"
+#include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
 #include <cmath>
@@ -52,6 +52,7 @@ vtkContourGrid::vtkContourGrid()
   this->ScalarTree = nullptr;
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->SequentialProcessing = false;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(
@@ -171,6 +172,22 @@ void vtkContourGridExecute(vtkContourGrid* self, vtkDataSet* input, vtkPolyData*
     newPts->SetDataType(VTK_DOUBLE);
   }
 
+  // Without scalar tree, unstructured grids are contoured in parallel.
+  vtkUnstructuredGrid* ugrid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (!useScalarTree && ugrid && !self->GetSequentialProcessing())
+  {
+    // if we did not ask for scalars to be computed, don't copy them
+    if (!computeScalars)
+    {
+      outPd->CopyScalarsOff();
+    }
+    vtkContourHelper::ContourUnstructuredGrid(self, ugrid, inScalars, values,
+      static_cast<int>(numContours), inPd, locator, output, newPts->GetDataType(),
+      generateTriangles);
+    newPts->Delete();
+    return;
+  }
+
   newPts->Allocate(estimatedSize, estimatedSize);
   newVerts = vtkCellArray::New();
   newVerts->AllocateEstimate(estimatedSize, 1);
@@ -514,6 +531,7 @@ void vtkContourGrid::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Compute Normals: " << (this->ComputeNormals ? "On\n" : "Off\n");
   os << indent << "Compute Scalars: " << (this->ComputeScalars ? "On\n" : "Off\n");
   os << indent << "Use Scalar Tree: " << (this->UseScalarTree ? "On\n" : "Off\n");
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 
   this->ContourValues->PrintSelf(os, indent.GetNextIndent());
 
@@ -159,6 +159,20 @@ public:
   int GetOutputPointsPrecision() const;
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the contouring
+   * process. By default, sequential processing is off: when no scalar tree is
+   * used, the cells of a vtkUnstructuredGrid, including polyhedra and higher
+   * order cells, are contoured in parallel with vtkSMPTools, see
+   * vtkContourHelper::ContourUnstructuredGrid(). The order of the output
+   * points and cells then depends on the number of threads.
+   */
+  vtkSetMacro(SequentialProcessing, vtkTypeBool);
+  vtkGetMacro(SequentialProcessing, vtkTypeBool);
+  vtkBooleanMacro(SequentialProcessing, vtkTypeBool);
+  ///@}
+
 protected:
   vtkContourGrid();
   ~vtkContourGrid() override;
@@ -177,6 +191,7 @@ protected:
   vtkScalarTree* ScalarTree;
 
   int OutputPointsPrecision;
+  vtkTypeBool SequentialProcessing;
   vtkEdgeTable* EdgeTable;
 
 private:
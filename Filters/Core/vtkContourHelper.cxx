@@ -2,17 +2,213 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkContourHelper.h"
 
+#include "vtkAlgorithm.h"
 #include "vtkCell.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
+#include "vtkCellTypes.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkIdListCollection.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkPolygonBuilder.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
 
-//------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// Contour the cells of a given dimension of an unstructured grid. The same
+// functor is used for the three dimensions so that each thread appends its
+// verts, lines and polys, and their cell data, in this order to its output.
+struct ContourCellsFunctor
+{
+  struct LocalDataType
+  {
+    vtkSmartPointer<vtkPolyData> Output;
+    vtkSmartPointer<vtkIncrementalPointLocator> Locator;
+    vtkSmartPointer<vtkGenericCell> Cell;
+    vtkSmartPointer<vtkDoubleArray> CellScalars;
+    vtkSmartPointer<vtkIdList> PointIds;
+    std::shared_ptr<vtkContourHelper> Helper;
+  };
+
+  vtkAlgorithm* Filter;
+  vtkUnstructuredGrid* Input;
+  vtkDataArray* Scalars;
+  const double* Values;
+  int NumValues;
+  vtkPointData* InPd;
+  vtkIncrementalPointLocator* Locator;
+  int PointsType;
+  bool OutputTriangles;
+  const double* Bounds;
+  vtkIdType EstimatedSize;
+  int Dimension = 1;
+  vtkSMPThreadLocal<LocalDataType> LocalData;
+
+  ContourCellsFunctor(vtkAlgorithm* filter, vtkUnstructuredGrid* input, vtkDataArray* scalars,
+    const double* values, int numValues, vtkPointData* inPd, vtkIncrementalPointLocator* locator,
+    int pointsType, bool outputTriangles, const double* bounds, vtkIdType estimatedSize)
+    : Filter(filter)
+    , Input(input)
+    , Scalars(scalars)
+    , Values(values)
+    , NumValues(numValues)
+    , InPd(inPd)
+    , Locator(locator)
+    , PointsType(pointsType)
+    , OutputTriangles(outputTriangles)
+    , Bounds(bounds)
+    , EstimatedSize(estimatedSize)
+  {
+  }
+
+  // Initialize() is invoked for each dimension; the thread outputs are only
+  // created the first time.
+  void Initialize()
+  {
+    LocalDataType& localData = this->LocalData.Local();
+    if (localData.Output)
+    {
+      return;
+    }
+    vtkNew<vtkPoints> points;
+    points->SetDataType(this->PointsType);
+    points->Allocate(this->EstimatedSize, this->EstimatedSize);
+    vtkNew<vtkCellArray> verts;
+    verts->AllocateEstimate(this->EstimatedSize, 1);
+    vtkNew<vtkCellArray> lines;
+    lines->AllocateEstimate(this->EstimatedSize, 2);
+    vtkNew<vtkCellArray> polys;
+    polys->AllocateEstimate(this->EstimatedSize, 4);
+    localData.Output = vtkSmartPointer<vtkPolyData>::New();
+    localData.Output->SetPoints(points);
+    localData.Output->SetVerts(verts);
+    localData.Output->SetLines(lines);
+    localData.Output->SetPolys(polys);
+    vtkPointData* outPd = localData.Output->GetPointData();
+    vtkCellData* outCd = localData.Output->GetCellData();
+    outPd->InterpolateAllocate(this->InPd, this->EstimatedSize, this->EstimatedSize);
+    outCd->CopyAllocate(this->Input->GetCellData(), this->EstimatedSize, this->EstimatedSize);
+
+    localData.Locator = vtk::TakeSmartPointer(this->Locator->NewInstance());
+    localData.Locator->InitPointInsertion(
+      points, this->Bounds, this->Input->GetNumberOfPoints());
+    localData.Cell = vtkSmartPointer<vtkGenericCell>::New();
+    localData.CellScalars = vtkSmartPointer<vtkDoubleArray>::New();
+    localData.CellScalars->SetNumberOfComponents(this->Scalars->GetNumberOfComponents());
+    localData.PointIds = vtkSmartPointer<vtkIdList>::New();
+    localData.Helper = std::make_shared<vtkContourHelper>(localData.Locator, verts, lines, polys,
+      this->InPd, this->Input->GetCellData(), outPd, outCd,
+      static_cast<int>(this->EstimatedSize), this->OutputTriangles);
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    LocalDataType& localData = this->LocalData.Local();
+    vtkGenericCell* cell = localData.Cell;
+    vtkDoubleArray* cellScalars = localData.CellScalars;
+    vtkIdList* pointIds = localData.PointIds;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endCellId - cellId) / 10 + 1, (vtkIdType)1000);
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      int cellType = this->Input->GetCellType(cellId);
+      if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
+      { // Protect against new cell types added.
+        continue;
+      }
+      if (vtkCellTypes::GetDimension(static_cast<unsigned char>(cellType)) != this->Dimension)
+      {
+        continue;
+      }
+
+      this->Input->GetCellPoints(cellId, pointIds);
+      cellScalars->SetNumberOfTuples(pointIds->GetNumberOfIds());
+      this->Scalars->GetTuples(pointIds, cellScalars);
+      double range[2] = { std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::lowest() };
+      for (const double val : vtk::DataArrayValueRange(cellScalars))
+      {
+        range[0] = std::min(range[0], val);
+        range[1] = std::max(range[1], val);
+      }
+      bool needCell = false;
+      for (int i = 0; i < this->NumValues && !needCell; ++i)
+      {
+        needCell = this->Values[i] >= range[0] && this->Values[i] <= range[1];
+      }
+      if (!needCell)
+      {
+        continue;
+      }
+
+      this->Input->GetCell(cellId, cell);
+      for (int i = 0; i < this->NumValues; ++i)
+      {
+        if (this->Values[i] >= range[0] && this->Values[i] <= range[1])
+        {
+          localData.Helper->Contour(cell, this->Values[i], cellScalars, cellId);
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Append the cells of a thread output to the merged output, mapping their
+// point ids through the point map of the thread.
+void AppendCells(vtkCellArray* cells, const std::vector<vtkIdType>& pointMap, vtkCellArray* output)
+{
+  std::vector<vtkIdType> ids;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  auto iter = vtk::TakeSmartPointer(cells->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    iter->GetCurrentCell(npts, pts);
+    ids.resize(npts);
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      ids[i] = pointMap[pts[i]];
+    }
+    output->InsertNextCell(npts, ids.data());
+  }
+}
+}
+
+//------------------------------------------------------------------------------
 vtkContourHelper::vtkContourHelper(vtkIncrementalPointLocator* locator, vtkCellArray* outVerts,
   vtkCellArray* outLines, vtkCellArray* outPolys, vtkPointData* inPd, vtkCellData* inCd,
   vtkPointData* outPd, vtkCellData* outCd, int trisEstimatedSize, bool outputTriangles)
@@ -89,4 +285,126 @@ void vtkContourHelper::Contour(
       this->InPd, this->OutPd, this->InCd, cellId, this->OutCd);
   }
 }
+
+//------------------------------------------------------------------------------
+void vtkContourHelper::ContourUnstructuredGrid(vtkAlgorithm* filter, vtkUnstructuredGrid* input,
+  vtkDataArray* scalars, const double* values, int numValues, vtkPointData* inPd,
+  vtkIncrementalPointLocator* locator, vtkPolyData* output, int pointsType, bool outputTriangles)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType estimatedSize = static_cast<vtkIdType>(std::pow(static_cast<double>(numCells), .75));
+  estimatedSize = std::max<vtkIdType>(estimatedSize / 1024 * 1024, 1024);
+
+  // Not thread safe so compute first.
+  double bounds[6];
+  input->GetBounds(bounds);
+
+  // Contour the cells from low to high dimensions. We skip 0d cells (points),
+  // because they cannot be contoured.
+  ContourCellsFunctor contour(filter, input, scalars, values, numValues, inPd, locator,
+    pointsType, outputTriangles, bounds, estimatedSize);
+  for (contour.Dimension = 1; contour.Dimension <= 3 && !filter->GetAbortOutput();
+       ++contour.Dimension)
+  {
+    vtkSMPTools::For(0, numCells, contour);
+  }
+
+  // Merge the outputs of the threads. The points are inserted in the locator
+  // to merge the points shared by cells contoured by different threads.
+  std::vector<vtkPolyData*> threadOutputs;
+  for (auto& localData : contour.LocalData)
+  {
+    threadOutputs.push_back(localData.Output);
+  }
+  if (threadOutputs.empty())
+  {
+    return;
+  }
+  int numThreads = static_cast<int>(threadOutputs.size());
+  vtkDataSetAttributes::FieldList ptList(numThreads);
+  vtkDataSetAttributes::FieldList cellList(numThreads);
+  vtkIdType numPts = 0, numVerts = 0, numLines = 0, numPolys = 0;
+  for (int t = 0; t < numThreads; ++t)
+  {
+    vtkPolyData* threadOutput = threadOutputs[t];
+    if (t == 0)
+    {
+      ptList.InitializeFieldList(threadOutput->GetPointData());
+      cellList.InitializeFieldList(threadOutput->GetCellData());
+    }
+    else
+    {
+      ptList.IntersectFieldList(threadOutput->GetPointData());
+      cellList.IntersectFieldList(threadOutput->GetCellData());
+    }
+    numPts += threadOutput->GetNumberOfPoints();
+    numVerts += threadOutput->GetNumberOfVerts();
+    numLines += threadOutput->GetNumberOfLines();
+    numPolys += threadOutput->GetNumberOfPolys();
+  }
+
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(pointsType);
+  newPts->Allocate(numPts);
+  vtkNew<vtkCellArray> newVerts;
+  vtkNew<vtkCellArray> newLines;
+  vtkNew<vtkCellArray> newPolys;
+  vtkPointData* outPd = output->GetPointData();
+  vtkCellData* outCd = output->GetCellData();
+  outPd->InterpolateAllocate(ptList, numPts);
+  outCd->CopyAllocate(cellList, numVerts + numLines + numPolys);
+  locator->InitPointInsertion(newPts, bounds, input->GetNumberOfPoints());
+
+  vtkIdType vertOffset = 0;
+  vtkIdType lineOffset = numVerts;
+  vtkIdType polyOffset = numVerts + numLines;
+  std::vector<vtkIdType> pointMap;
+  for (int t = 0; t < numThreads; ++t)
+  {
+    vtkPolyData* threadOutput = threadOutputs[t];
+    vtkPointData* threadPd = threadOutput->GetPointData();
+    vtkIdType numThreadPts = threadOutput->GetNumberOfPoints();
+    pointMap.resize(numThreadPts);
+    double x[3];
+    for (vtkIdType ptId = 0; ptId < numThreadPts; ++ptId)
+    {
+      threadOutput->GetPoint(ptId, x);
+      if (locator->InsertUniquePoint(x, pointMap[ptId]))
+      {
+        outPd->CopyData(ptList, threadPd, t, ptId, pointMap[ptId]);
+      }
+    }
+
+    AppendCells(threadOutput->GetVerts(), pointMap, newVerts);
+    AppendCells(threadOutput->GetLines(), pointMap, newLines);
+    AppendCells(threadOutput->GetPolys(), pointMap, newPolys);
+
+    vtkCellData* threadCd = threadOutput->GetCellData();
+    vtkIdType threadVerts = threadOutput->GetNumberOfVerts();
+    vtkIdType threadLines = threadOutput->GetNumberOfLines();
+    vtkIdType threadPolys = threadOutput->GetNumberOfPolys();
+    outCd->CopyData(cellList, threadCd, t, vertOffset, threadVerts, 0);
+    outCd->CopyData(cellList, threadCd, t, lineOffset, threadLines, threadVerts);
+    outCd->CopyData(cellList, threadCd, t, polyOffset, threadPolys, threadVerts + threadLines);
+    vertOffset += threadVerts;
+    lineOffset += threadLines;
+    polyOffset += threadPolys;
+  }
+
+  output->SetPoints(newPts);
+  if (newVerts->GetNumberOfCells())
+  {
+    output->SetVerts(newVerts);
+  }
+  if (newLines->GetNumberOfCells())
+  {
+    output->SetLines(newLines);
+  }
+  if (newPolys->GetNumberOfCells())
+  {
+    output->SetPolys(newPolys);
+  }
+  locator->Initialize(); // releases leftover memory
+  output->Squeeze();
+}
 VTK_ABI_NAMESPACE_END
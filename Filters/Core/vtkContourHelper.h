@@ -14,6 +14,9 @@
  * When working with multidimensional dataset, it is needed to process cells
  * from low to high dimensions.
  *
+ * ContourUnstructuredGrid() contours all the cells of a vtkUnstructuredGrid
+ * in parallel with vtkSMPTools, using one helper per thread.
+ *
  * @sa
  * vtkContourGrid vtkCutter vtkContourFilter
  */
@@ -26,11 +29,14 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkIncrementalPointLocator;
+class vtkAlgorithm;
 class vtkCellArray;
 class vtkPointData;
 class vtkCellData;
 class vtkCell;
 class vtkDataArray;
+class vtkPolyData;
+class vtkUnstructuredGrid;
 
 class VTKFILTERSCORE_EXPORT vtkContourHelper
 {
@@ -72,6 +78,34 @@ public:
    */
   void Contour(vtkCell* cell, double value, vtkDataArray* cellScalars, vtkIdType cellId);
 
+  /**
+   * Contour all the cells of an unstructured grid, of any type including
+   * polyhedra and higher order cells, for the given values with vtkSMPTools.
+   *
+   * Each thread contours ranges of cells with its own vtkGenericCell,
+   * vtkContourHelper, output and locator, a new instance of the class of
+   * `locator`. The outputs of the threads are then merged in `output` with
+   * `locator`, so that the points shared by the cells of different threads are
+   * merged as they would be in serial. Cells are processed from low to high
+   * dimensions, and the point and cell data of `output` must not be allocated
+   * but their copy flags are honored.
+   *
+   * @param filter Algorithm checked for abort
+   * @param input Grid to contour
+   * @param scalars Point scalars to contour
+   * @param values Contour values
+   * @param numValues Number of contour values
+   * @param inPd Input point data, interpolated on the output points
+   * @param locator Locator used to merge the points of the output
+   * @param output Contour, points of type pointsType are created
+   * @param pointsType Data type of the output points
+   * @param outputTriangles See the constructor
+   */
+  static void ContourUnstructuredGrid(vtkAlgorithm* filter, vtkUnstructuredGrid* input,
+    vtkDataArray* scalars, const double* values, int numValues, vtkPointData* inPd,
+    vtkIncrementalPointLocator* locator, vtkPolyData* output, int pointsType,
+    bool outputTriangles);
+
 private:
   vtkContourHelper(const vtkContourHelper&) = delete;
   vtkContourHelper& operator=(const vtkContourHelper&) = delete;
@@ -35,6 +35,7 @@
 #include "vtkStructuredGrid.h"
 #include "vtkSynchronizedTemplates3D.h"
 #include "vtkSynchronizedTemplatesCutter3D.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGridBase.h"
 
 #include <algorithm>
@@ -804,15 +805,12 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
     inPD = input->GetPointData();
   }
   outPD = output->GetPointData();
-  outPD->InterpolateAllocate(inPD, estimatedSize, estimatedSize / 2);
-  outCD->CopyAllocate(inCD, estimatedSize, estimatedSize / 2);
 
   // locator used to merge potentially duplicate points
   if (this->Locator == nullptr)
   {
     this->CreateDefaultLocator();
   }
-  this->Locator->InitPointInsertion(newPoints, input->GetBounds());
 
   // Loop over all points evaluating scalar function at each point
   if (inputPointSet)
@@ -821,6 +819,30 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
     this->CutFunction->FunctionValue(dataArrayInput, cutScalars);
   }
 
+  // Unless the output must be sorted by cell, unstructured grids are cut in
+  // parallel.
+  vtkUnstructuredGrid* ugrid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (ugrid && this->SortBy == VTK_SORT_BY_VALUE)
+  {
+    vtkContourHelper::ContourUnstructuredGrid(this, ugrid, cutScalars, contourValues,
+      static_cast<int>(numContours), inPD, this->Locator, output, newPoints->GetDataType(),
+      this->GenerateTriangles != 0);
+    cutScalars->Delete();
+    if (this->GenerateCutScalars)
+    {
+      inPD->Delete();
+    }
+    newPoints->Delete();
+    newVerts->Delete();
+    newLines->Delete();
+    newPolys->Delete();
+    return;
+  }
+
+  outPD->InterpolateAllocate(inPD, estimatedSize, estimatedSize / 2);
+  outCD->CopyAllocate(inCD, estimatedSize, estimatedSize / 2);
+  this->Locator->InitPointInsertion(newPoints, input->GetBounds());
+
   vtkSmartPointer<vtkCellIterator> cellIter =
     vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
   vtkNew<vtkGenericCell> cell;
@@ -178,7 +178,9 @@ public:
    * This order should be used if the extracted polygons must be rendered
    * in a back-to-front or front-to-back order. This is very problem
    * dependent.
-   * For most applications, the default order is fine (and faster).
+   * For most applications, the default order is fine (and faster). With the
+   * default order, vtkUnstructuredGrid inputs that are not cut by the
+   * specialized plane cutters are processed in parallel with vtkSMPTools.
 
    * Sort by cell is going to have a problem if the input has 2D and 3D cells.
    * Cell data will be scrambled because with
@@ -255,6 +255,21 @@ public:
   vtkBooleanMacro(RandomPointInsertion, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to insert the points in spatial order: the points are
+   * binned by a vtkStaticPointLocator, in parallel, and inserted bucket after
+   * bucket, so that the search for the triangle containing a point starts
+   * close to it. This greatly speeds up the triangulation of large point
+   * sets. The triangulation is the same as with the other orders, except for
+   * degenerate (e.g., cocircular) points, whose triangulation depends on the
+   * insertion order. When on, RandomPointInsertion is ignored. Off by default.
+   */
+  vtkSetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkGetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkBooleanMacro(SpatialPointInsertion, vtkTypeBool);
+  ///@}
+
 protected:
   vtkDelaunay2D();
 
@@ -265,6 +280,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   vtkTypeBool RandomPointInsertion;
+  vtkTypeBool SpatialPointInsertion;
 
   // Transform input points (if necessary)
   vtkSmartPointer<vtkAbstractTransform> Transform;
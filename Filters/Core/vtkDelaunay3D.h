@@ -252,6 +252,21 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to insert the points in spatial order: the points are
+   * binned by a vtkStaticPointLocator, in parallel, and inserted bucket after
+   * bucket, so that the search for the tetrahedron containing a point starts
+   * close to it. This greatly speeds up the tetrahedralization of large point
+   * sets. The tetrahedralization is the same as with the given order, except
+   * for degenerate (e.g., cospherical) points, whose tetrahedralization
+   * depends on the insertion order. Off by default.
+   */
+  vtkSetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkGetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkBooleanMacro(SpatialPointInsertion, vtkTypeBool);
+  ///@}
+
 protected:
   vtkDelaunay3D();
   ~vtkDelaunay3D() override;
@@ -267,6 +282,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  vtkTypeBool SpatialPointInsertion;
 
   vtkIncrementalPointLocator* Locator; // help locate points faster
 
@@ -6,6 +6,7 @@
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -159,8 +160,15 @@ int vtkElevationFilter::RequestData(
     return 1;
   }
 
-  // Allocate space for the elevation scalar data.
-  vtkSmartPointer<vtkFloatArray> newScalars = vtkSmartPointer<vtkFloatArray>::New();
+  // Allocate space for the elevation scalar data, reusing the previous
+  // scalars when the executive keeps them.
+  vtkSmartPointer<vtkDataArray> reusable = vtkDemandDrivenPipeline::GetReusableArray(
+    outputVector->GetInformationObject(0), vtkDataObject::POINT, "Elevation", VTK_FLOAT, 1);
+  vtkSmartPointer<vtkFloatArray> newScalars = vtkArrayDownCast<vtkFloatArray>(reusable);
+  if (!newScalars)
+  {
+    newScalars = vtkSmartPointer<vtkFloatArray>::New();
+  }
   newScalars->SetNumberOfTuples(numPts);
 
   // Set up 1D parametric system and make sure it is valid.
@@ -291,6 +291,7 @@ ExtractedCellsT ExtractCells(vtkDataSet* input, const CellWorkT& work, unsigned
   // set cell array
   result.Connectivity.TakeReference(vtkCellArray::New());
   result.Connectivity->SetData(offsets, connectivity);
+  result.Connectivity->ConvertToPreferredStorage();
   return result;
 }
 
@@ -383,8 +384,10 @@ void ExtractPolyhedralFaces(
   // Prepare return result
   result.PolyFaceLocations.TakeReference(vtkCellArray::New());
   result.PolyFaceLocations->SetData(offsetsPoly, connectivityPoly);
+  result.PolyFaceLocations->ConvertToPreferredStorage();
   result.PolyFaces.TakeReference(vtkCellArray::New());
   result.PolyFaces->SetData(offsetsPolyFaces, connectivityPolyFaces);
+  result.PolyFaces->ConvertToPreferredStorage();
 }
 
 //------------------------------------------------------------------------------
@@ -17,6 +17,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSIMDKernels.h"
 #include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
@@ -125,9 +126,10 @@ public:
   vtkFlyingEdges3DAlgorithm();
 
   // The three main passes of the algorithm.
-  void ProcessXEdge(double value, T const* inPtr, vtkIdType row, vtkIdType slice); // PASS 1
-  void ProcessYZEdges(vtkIdType row, vtkIdType slice);                             // PASS 2
-  void GenerateOutput(double value, T* inPtr, vtkIdType row, vtkIdType slice);     // PASS 4
+  void ProcessXEdge(double value, T const* inPtr, vtkIdType row, vtkIdType slice,
+    unsigned char* xCases, vtkIdType* edgeMetaData);                           // PASS 1
+  void ProcessYZEdges(vtkIdType row, vtkIdType slice);                         // PASS 2
+  void GenerateOutput(double value, T* inPtr, vtkIdType row, vtkIdType slice); // PASS 4
 
   // Optional copying of cell data
   void InterpolateCellData(ArrayList* cellArrays, vtkIdType row, vtkIdType slice);
@@ -310,19 +312,26 @@ public:
     eIds[11] = eIds[10] + this->EdgeUses[eCase][11];
   }
 
-  // Threading integration via SMPTools
+  // Threading integration via SMPTools. Pass1 classifies the x-edges for a
+  // batch of contour values at once: each x-row is read once from memory and
+  // classified against every value of the batch, the cases and metadata of
+  // the ith value being written in the ith XCases and EdgeMetaData arrays
+  // starting at Algo->XCases and Algo->EdgeMetaData.
   template <class TT>
   class Pass1
   {
   public:
     vtkFlyingEdges3DAlgorithm<TT>* Algo;
-    double Value;
+    const double* Values;
+    vtkIdType NumValues;
     vtkFlyingEdges3D* Filter;
-    Pass1(vtkFlyingEdges3DAlgorithm<TT>* algo, double value, vtkFlyingEdges3D* filter)
+    Pass1(vtkFlyingEdges3DAlgorithm<TT>* algo, const double* values, vtkIdType numValues,
+      vtkFlyingEdges3D* filter)
       : Filter(filter)
     {
       this->Algo = algo;
-      this->Value = value;
+      this->Values = values;
+      this->NumValues = numValues;
     }
     void operator()(vtkIdType slice, vtkIdType end)
     {
@@ -346,7 +355,12 @@ public:
 
         for (row = 0, rowPtr = slicePtr; row < this->Algo->Dims[1]; ++row)
         {
-          this->Algo->ProcessXEdge(this->Value, rowPtr, row, slice);
+          for (vtkIdType vidx = 0; vidx < this->NumValues; ++vidx)
+          {
+            this->Algo->ProcessXEdge(this->Values[vidx], rowPtr, row, slice,
+              this->Algo->XCases + vidx * this->Algo->SliceOffset * this->Algo->Dims[2],
+              this->Algo->EdgeMetaData + vidx * this->Algo->NumberOfEdges * 6);
+          }
           rowPtr += this->Algo->Inc1;
         } // for all rows in this slice
         slicePtr += this->Algo->Inc2;
@@ -964,62 +978,90 @@ void vtkFlyingEdges3DAlgorithm<T>::GeneratePoints(double value, unsigned char lo
   }
 }
 
+//------------------------------------------------------------------------------
+// Classify the x-edges of a row of contiguous float or double scalars with the
+// vectorized kernels. Return false for other scalar types.
+template <class T>
+bool ClassifyXEdges(
+  T const*, vtkIdType, double, unsigned char*, vtkIdType&, vtkIdType&, vtkIdType&)
+{
+  return false;
+}
+
+bool ClassifyXEdges(float const* inPtr, vtkIdType nxcells, double value, unsigned char* ePtr,
+  vtkIdType& sum, vtkIdType& minInt, vtkIdType& maxInt)
+{
+  sum = vtk::detail::simd::ClassifyEdges(inPtr, nxcells, value, ePtr, minInt, maxInt);
+  return true;
+}
+
+bool ClassifyXEdges(double const* inPtr, vtkIdType nxcells, double value, unsigned char* ePtr,
+  vtkIdType& sum, vtkIdType& minInt, vtkIdType& maxInt)
+{
+  sum = vtk::detail::simd::ClassifyEdges(inPtr, nxcells, value, ePtr, minInt, maxInt);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // PASS 1: Process a single volume x-row (and all of the voxel edges that
 // compose the row). Determine the x-edges case classification, count the
 // number of x-edge intersections, and figure out where intersections along
 // the x-row begins and ends (i.e., gather information for computational
-// trimming).
+// trimming). The results are written in the xCases and edgeMetaData arrays.
 template <class T>
-void vtkFlyingEdges3DAlgorithm<T>::ProcessXEdge(
-  double value, T const* const inPtr, vtkIdType row, vtkIdType slice)
+void vtkFlyingEdges3DAlgorithm<T>::ProcessXEdge(double value, T const* const inPtr,
+  vtkIdType row, vtkIdType slice, unsigned char* xCases, vtkIdType* edgeMetaData)
 {
   vtkIdType nxcells = this->Dims[0] - 1;
   vtkIdType minInt = nxcells, maxInt = 0;
-  vtkIdType* edgeMetaData;
-  unsigned char edgeCase, *ePtr = this->XCases + slice * this->SliceOffset + row * nxcells;
+  unsigned char edgeCase, *ePtr = xCases + slice * this->SliceOffset + row * nxcells;
   double s0, s1 = static_cast<double>(*inPtr);
   vtkIdType sum = 0;
 
   // run along the entire x-edge computing edge cases
-  edgeMetaData = this->EdgeMetaData + (slice * this->Dims[1] + row) * 6;
+  edgeMetaData += (slice * this->Dims[1] + row) * 6;
   std::fill_n(edgeMetaData, 6, 0);
 
   // pull this out help reduce false sharing
   vtkIdType inc0 = this->Inc0;
 
-  for (vtkIdType i = 0; i < nxcells; ++i, ++ePtr)
+  // Contiguous float and double scalars are classified several at a time. The
+  // loop below is the reference implementation for the other cases.
+  if (inc0 != 1 || !ClassifyXEdges(inPtr, nxcells, value, ePtr, sum, minInt, maxInt))
   {
-    s0 = s1;
-    s1 = static_cast<double>(*(inPtr + (i + 1) * inc0));
-
-    if (s0 >= value)
-    {
-      edgeCase = vtkFlyingEdges3DAlgorithm::LeftAbove;
-    }
-    else
-    {
-      edgeCase = vtkFlyingEdges3DAlgorithm::Below;
-    }
-    if (s1 >= value)
+    for (vtkIdType i = 0; i < nxcells; ++i, ++ePtr)
     {
-      edgeCase |= vtkFlyingEdges3DAlgorithm::RightAbove;
-    }
-
-    this->SetXEdge(ePtr, edgeCase);
+      s0 = s1;
+      s1 = static_cast<double>(*(inPtr + (i + 1) * inc0));
 
-    // if edge intersects contour
-    if (edgeCase == vtkFlyingEdges3DAlgorithm::LeftAbove ||
-      edgeCase == vtkFlyingEdges3DAlgorithm::RightAbove)
-    {
-      ++sum; // increment number of intersections along x-edge
-      if (i < minInt)
+      if (s0 >= value)
+      {
+        edgeCase = vtkFlyingEdges3DAlgorithm::LeftAbove;
+      }
+      else
+      {
+        edgeCase = vtkFlyingEdges3DAlgorithm::Below;
+      }
+      if (s1 >= value)
       {
-        minInt = i;
+        edgeCase |= vtkFlyingEdges3DAlgorithm::RightAbove;
       }
-      maxInt = i + 1;
-    } // if contour interacts with this x-edge
-  }   // for all x-cell edges along this x-edge
+
+      this->SetXEdge(ePtr, edgeCase);
+
+      // if edge intersects contour
+      if (edgeCase == vtkFlyingEdges3DAlgorithm::LeftAbove ||
+        edgeCase == vtkFlyingEdges3DAlgorithm::RightAbove)
+      {
+        ++sum; // increment number of intersections along x-edge
+        if (i < minInt)
+        {
+          minInt = i;
+        }
+        maxInt = i + 1;
+      } // if contour interacts with this x-edge
+    } // for all x-cell edges along this x-edge
+  }
 
   edgeMetaData[0] += sum; // write back the number of intersections along x-edge
 
@@ -1380,7 +1422,7 @@ void vtkFlyingEdges3DAlgorithm<T>::Contour(vtkFlyingEdges3D* self, vtkImageData*
   algo.Dims[2] = algo.Max2 - algo.Min2 + 1;
   algo.NumberOfEdges = algo.Dims[1] * algo.Dims[2];
   algo.SliceOffset = (algo.Dims[0] - 1) * algo.Dims[1];
-  algo.XCases = new unsigned char[(algo.Dims[0] - 1) * algo.NumberOfEdges];
+  vtkIdType xCasesSize = (algo.Dims[0] - 1) * algo.NumberOfEdges;
 
   // Also allocate the characterization (metadata) array for the x edges.
   // This array tracks the number of x-, y- and z- intersections on the voxel
@@ -1388,7 +1430,17 @@ void vtkFlyingEdges3DAlgorithm<T>::Contour(vtkFlyingEdges3D* self, vtkImageData*
   // the xMin_i and xMax_i (minimum index of first intersection, maximum
   // index of intersection for the ith x-row, the so-called trim edges used
   // for computational trimming).
-  algo.EdgeMetaData = new vtkIdType[algo.NumberOfEdges * 6];
+  vtkIdType edgeMetaDataSize = algo.NumberOfEdges * 6;
+
+  // The x-edges of several contour values are classified in a single pass
+  // over the scalars, which requires a pair of XCases and EdgeMetaData arrays
+  // per value. The batch of values is limited so that these arrays take no
+  // more memory than the input scalars.
+  vtkIdType batchSize = (algo.Dims[0] * algo.NumberOfEdges * static_cast<vtkIdType>(sizeof(T))) /
+    (xCasesSize + edgeMetaDataSize * static_cast<vtkIdType>(sizeof(vtkIdType)));
+  batchSize = std::max<vtkIdType>(1, std::min(batchSize, numContours));
+  unsigned char* xCases = new unsigned char[batchSize * xCasesSize];
+  vtkIdType* edgeMetaData = new vtkIdType[batchSize * edgeMetaDataSize];
 
   // Interpolating attributes and other stuff. Interpolate extra attributes only if they
   // exist and the user requests it.
@@ -1409,9 +1461,17 @@ void vtkFlyingEdges3DAlgorithm<T>::Contour(vtkFlyingEdges3D* self, vtkImageData*
     // PASS 1: Traverse all x-rows building edge cases and counting number of
     // intersections (i.e., accumulate information necessary for later output
     // memory allocation, e.g., the number of output points along the x-rows
-    // are counted).
-    Pass1<T> pass1(&algo, value, self);
-    vtkSMPTools::For(0, algo.Dims[2], pass1);
+    // are counted). This is done for a batch of values at once.
+    vtkIdType batchIdx = vidx % batchSize;
+    if (batchIdx == 0)
+    {
+      algo.XCases = xCases;
+      algo.EdgeMetaData = edgeMetaData;
+      Pass1<T> pass1(&algo, values + vidx, std::min(batchSize, numContours - vidx), self);
+      vtkSMPTools::For(0, algo.Dims[2], pass1);
+    }
+    algo.XCases = xCases + batchIdx * xCasesSize;
+    algo.EdgeMetaData = edgeMetaData + batchIdx * edgeMetaDataSize;
 
     // PASS 2: Traverse all voxel x-rows and process voxel y&z edges.  The
     // result is a count of the number of y- and z-intersections, as well as
@@ -1525,8 +1585,8 @@ void vtkFlyingEdges3DAlgorithm<T>::Contour(vtkFlyingEdges3D* self, vtkImageData*
   } // for all contour values
 
   // Clean up and return
-  delete[] algo.XCases;
-  delete[] algo.EdgeMetaData;
+  delete[] xCases;
+  delete[] edgeMetaData;
 }
 
 } // anonymous namespace
@@ -2,18 +2,24 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkGlyph3D.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -21,7 +27,104 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// A source prepared for the threaded copy of the glyphs: its points,
+// transformed by the source transform, and the cells of its four cell arrays,
+// copied once and shared by all the glyphs.
+struct GlyphSource
+{
+  vtkPolyData* Source = nullptr;
+  vtkIdType NumberOfPoints = 0;
+  std::vector<double> Points;
+  vtkDataArray* Normals = nullptr;
+  std::vector<vtkIdType> Offsets[4];
+  std::vector<vtkIdType> Connectivity[4];
+
+  void Prepare(vtkPolyData* source, vtkTransform* sourceTransform)
+  {
+    this->Source = source;
+    this->NumberOfPoints = source->GetNumberOfPoints();
+    this->Points.resize(3 * this->NumberOfPoints);
+    for (vtkIdType ptId = 0; ptId < this->NumberOfPoints; ++ptId)
+    {
+      double* x = this->Points.data() + 3 * ptId;
+      source->GetPoint(ptId, x);
+      if (sourceTransform)
+      {
+        sourceTransform->TransformPoint(x, x);
+      }
+    }
+    this->Normals = source->GetPointData()->GetNormals();
+
+    vtkCellArray* cellArrays[4] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+      source->GetStrips() };
+    vtkNew<vtkIdList> ptIds;
+    for (int type = 0; type < 4; ++type)
+    {
+      vtkCellArray* cells = cellArrays[type];
+      this->Offsets[type].assign(1, 0);
+      this->Connectivity[type].clear();
+      for (vtkIdType cellId = 0; cellId < cells->GetNumberOfCells(); ++cellId)
+      {
+        vtkIdType npts;
+        const vtkIdType* pts;
+        cells->GetCellAtId(cellId, npts, pts, ptIds);
+        this->Connectivity[type].insert(this->Connectivity[type].end(), pts, pts + npts);
+        this->Offsets[type].push_back(static_cast<vtkIdType>(this->Connectivity[type].size()));
+      }
+    }
+  }
+
+  vtkIdType GetNumberOfCells(int type) const
+  {
+    return this->Offsets[type].empty() ? 0
+                                       : static_cast<vtkIdType>(this->Offsets[type].size()) - 1;
+  }
+};
+
+//------------------------------------------------------------------------------
+// The offsets of a glyph in the output: the number of glyphs, points, cells
+// and connectivity ids of each cell type preceding it.
+struct GlyphOffsets
+{
+  vtkIdType Glyphs = 0;
+  vtkIdType Points = 0;
+  vtkIdType Cells[4] = { 0, 0, 0, 0 };
+  vtkIdType Connectivity[4] = { 0, 0, 0, 0 };
+
+  void Add(const GlyphSource& glyph)
+  {
+    ++this->Glyphs;
+    this->Points += glyph.NumberOfPoints;
+    for (int type = 0; type < 4; ++type)
+    {
+      this->Cells[type] += glyph.GetNumberOfCells(type);
+      this->Connectivity[type] += static_cast<vtkIdType>(glyph.Connectivity[type].size());
+    }
+  }
+
+  void Add(const GlyphOffsets& other)
+  {
+    this->Glyphs += other.Glyphs;
+    this->Points += other.Points;
+    for (int type = 0; type < 4; ++type)
+    {
+      this->Cells[type] += other.Cells[type];
+      this->Connectivity[type] += other.Connectivity[type];
+    }
+  }
+};
+
+// Number of input points a thread processes at once.
+constexpr vtkIdType GlyphBatchSize = 1000;
+} // anonymous namespace
+
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
@@ -52,6 +155,7 @@ vtkGlyph3D::vtkGlyph3D()
   this->SetPointIdsName("InputPointIds");
   this->SetNumberOfInputPorts(2);
   this->FillCellData = 0;
+  this->OutputInstances = 0;
   this->SourceTransform = nullptr;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 
@@ -125,40 +229,19 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   vtkPointData* pd;
   vtkDataArray* inCScalars; // Scalars for Coloring
   unsigned char* inGhostLevels = nullptr;
-  vtkDataArray *inNormals, *sourceNormals = nullptr;
+  vtkDataArray* inNormals;
   vtkDataArray* sourceTCoords = nullptr;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  vtkPoints* sourcePts = nullptr;
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
-  vtkPoints* newPts;
-  vtkDataArray* newScalars = nullptr;
-  vtkDataArray* newVectors = nullptr;
-  vtkDataArray* newNormals = nullptr;
-  vtkDataArray* newTCoords = nullptr;
-  double x[3], v[3], vNew[3], s = 0.0, vMag = 0.0, value, tc[3];
-  vtkTransform* trans = vtkTransform::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdList* cellPts;
-  int npts;
-  vtkIdList* pts;
-  vtkIdType ptIncr, cellIncr, cellId;
+  vtkDataArray* array3D = nullptr;
+  vtkIdType numPts, inPtId;
   int haveVectors, haveNormals, haveTCoords = 0;
-  double scalex, scaley, scalez, den;
+  double den;
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
   int numberOfSources = this->GetNumberOfInputConnections(1);
-  vtkIdTypeArray* pointIds = nullptr;
   vtkSmartPointer<vtkPolyData> source = this->GetSource(0, sourceVector);
-  vtkNew<vtkIdList> srcPointIdList;
-  vtkNew<vtkIdList> dstPointIdList;
-  vtkNew<vtkIdList> srcCellIdList;
-  vtkNew<vtkIdList> dstCellIdList;
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  pts = vtkIdList::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   pd = input->GetPointData();
   inNormals = this->GetInputArrayToProcess(2, input);
   inCScalars = this->GetInputArrayToProcess(3, input);
@@ -185,8 +268,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   if (numPts < 1)
   {
     vtkDebugMacro(<< "No points to glyph!");
-    pts->Delete();
-    trans->Delete();
     return true;
   }
 
@@ -207,6 +288,15 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   {
     haveVectors = 0;
   }
+  if (haveVectors && this->VectorMode != VTK_FOLLOW_CAMERA_DIRECTION)
+  {
+    array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+    if (array3D->GetNumberOfComponents() > 3)
+    {
+      vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
+      return false;
+    }
+  }
 
   if ((this->IndexMode == VTK_INDEXING_BY_SCALAR && !inSScalars) ||
     (this->IndexMode == VTK_INDEXING_BY_VECTOR &&
@@ -216,8 +306,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     if (source == nullptr)
     {
       vtkErrorMacro(<< "Indexing on but don't have data to index with");
-      pts->Delete();
-      trans->Delete();
       return true;
     }
     else
@@ -249,24 +337,25 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     source = defaultSource;
   }
 
+  // Prepare the sources once, so that the threads share their points and
+  // cells. The instances do not need the geometry of the sources.
+  std::vector<GlyphSource> sources;
   if (this->IndexMode != VTK_INDEXING_OFF)
   {
     pd = nullptr;
     haveNormals = 1;
-    for (numSourcePts = numSourceCells = i = 0; i < numberOfSources; i++)
+    sources.resize(numberOfSources);
+    for (int i = 0; i < numberOfSources; i++)
     {
-      source = this->GetSource(i, sourceVector);
-      if (source != nullptr)
+      vtkPolyData* indexedSource = this->GetSource(i, sourceVector);
+      if (indexedSource != nullptr)
       {
-        if (source->GetNumberOfPoints() > numSourcePts)
+        if (!this->OutputInstances)
         {
-          numSourcePts = source->GetNumberOfPoints();
+          sources[i].Prepare(indexedSource, this->SourceTransform);
         }
-        if (source->GetNumberOfCells() > numSourceCells)
-        {
-          numSourceCells = source->GetNumberOfCells();
-        }
-        if (!(sourceNormals = source->GetPointData()->GetNormals()))
+        sources[i].Source = indexedSource;
+        if (!indexedSource->GetPointData()->GetNormals())
         {
           haveNormals = 0;
         }
@@ -275,46 +364,163 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   }
   else
   {
-    sourcePts = source->GetPoints();
-    numSourcePts = sourcePts->GetNumberOfPoints();
-    numSourceCells = source->GetNumberOfCells();
+    sources.resize(1);
+    if (!this->OutputInstances)
+    {
+      sources[0].Prepare(source, this->SourceTransform);
+    }
+    sources[0].Source = source;
+    haveNormals = source->GetPointData()->GetNormals() ? 1 : 0;
+    sourceTCoords = source->GetPointData()->GetTCoords();
+    haveTCoords = sourceTCoords ? 1 : 0;
+  }
+  if (this->OutputInstances)
+  {
+    // The normals and texture coordinates belong to the sources.
+    haveNormals = haveTCoords = 0;
+  }
 
-    sourceNormals = source->GetPointData()->GetNormals();
-    if (sourceNormals)
+  // Compute the scale, the vector and the scalar of an input point.
+  auto computeScale = [&](vtkIdType ptId, double scale[3], double v[3], double& vMag, double& s) {
+    scale[0] = scale[1] = scale[2] = 1.0;
+    v[0] = v[1] = v[2] = 0.0;
+    vMag = 0.0;
+    if (inSScalars)
     {
-      haveNormals = 1;
+      s = inSScalars->GetComponent(ptId, 0);
+      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scale[0] = scale[1] = scale[2] = s;
+      }
     }
-    else
+
+    if (haveVectors)
     {
-      haveNormals = 0;
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        vMag = 1.0; // v will be set when orienting the glyph
+      }
+      else
+      {
+        array3D->GetTuple(ptId, v);
+        vMag = vtkMath::Norm(v);
+        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        {
+          scale[0] = v[0];
+          scale[1] = v[1];
+          scale[2] = v[2];
+        }
+        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+        {
+          scale[0] = scale[1] = scale[2] = vMag;
+        }
+      }
     }
 
-    sourceTCoords = source->GetPointData()->GetTCoords();
-    if (sourceTCoords)
+    // Clamp data scale if enabled
+    if (this->Clamping)
     {
-      haveTCoords = 1;
+      for (int i = 0; i < 3; ++i)
+      {
+        scale[i] = (scale[i] < this->Range[0]
+            ? this->Range[0]
+            : (scale[i] > this->Range[1] ? this->Range[1] : scale[i]));
+        scale[i] = (scale[i] - this->Range[0]) / den;
+      }
     }
-    else
+  };
+
+  // Pass 1, serial as IsPointVisible() may not be thread safe: select the
+  // source of each input point, or -1 when the point is not glyphed, and
+  // count the output of each batch of points.
+  const vtkIdType numBatches = (numPts - 1) / GlyphBatchSize + 1;
+  std::vector<int> sourceIndices(numPts, -1);
+  std::vector<GlyphOffsets> batchOffsets(numBatches + 1);
+  for (inPtId = 0; inPtId < numPts; inPtId++)
+  {
+    if (!(inPtId % 10000))
     {
-      haveTCoords = 0;
+      this->UpdateProgress(0.1 * inPtId / numPts);
+      if (this->CheckAbort())
+      {
+        return true;
+      }
     }
 
-    // Prepare to copy output.
-    pd = input->GetPointData();
-    outputPD->CopyAllocate(pd, numPts * numSourcePts);
-    if (this->FillCellData)
+    // Compute index into table of glyphs
+    int index = 0;
+    if (this->IndexMode != VTK_INDEXING_OFF)
     {
-      outputCD->CopyGlobalIdsOn();
-      outputCD->CopyAllocate(pd, numPts * numSourceCells);
+      double scale[3], v[3], vMag, s = 0.0;
+      computeScale(inPtId, scale, v, vMag, s);
+      double value = this->IndexMode == VTK_INDEXING_BY_SCALAR ? s : vMag;
+      index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
+      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+    }
+
+    // Make sure we're not indexing into empty glyph
+    if (sources[index].Source == nullptr)
+    {
+      continue;
+    }
+
+    // Check ghost points.
+    // If we are processing a piece, we do not want to duplicate glyphs on the borders.
+    if (inGhostLevels &&
+      inGhostLevels[inPtId] &
+        (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT))
+    {
+      continue;
     }
+
+    if (inputUG && !inputUG->IsPointVisible(inPtId))
+    {
+      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
+      // it.
+      continue;
+    }
+
+    if (!this->IsPointVisible(input, inPtId))
+    {
+      continue;
+    }
+
+    sourceIndices[inPtId] = index;
+    batchOffsets[inPtId / GlyphBatchSize + 1].Add(sources[index]);
   }
 
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  dstCellIdList->SetNumberOfIds(numSourceCells);
+  // The offsets of each batch are the sums of the output of the previous ones.
+  for (vtkIdType batch = 0; batch < numBatches; ++batch)
+  {
+    batchOffsets[batch + 1].Add(batchOffsets[batch]);
+  }
+  const GlyphOffsets& totals = batchOffsets[numBatches];
+  const vtkIdType numOutPts = this->OutputInstances ? totals.Glyphs : totals.Points;
+  vtkIdType numOutCells = 0;
+  vtkIdType typeStarts[4];
+  for (int type = 0; type < 4; ++type)
+  {
+    typeStarts[type] = numOutCells;
+    numOutCells += totals.Cells[type];
+  }
+
+  // Allocate the output arrays to their final size so that the threads can
+  // set their values.
+  ArrayList pointArrays;
+  ArrayList cellArrays;
+  if (pd)
+  {
+    outputPD->CopyAllocate(pd, numOutPts);
+    pointArrays.AddArrays(numOutPts, pd, outputPD, 0.0, false);
+    if (this->FillCellData && !this->OutputInstances)
+    {
+      outputCD->CopyGlobalIdsOn();
+      outputCD->CopyAllocate(pd, numOutCells);
+      cellArrays.AddArrays(numOutCells, pd, outputCD, 0.0, false);
+    }
+  }
 
-  newPts = vtkPoints::New();
+  vtkNew<vtkPoints> newPts;
 
   // Set the desired precision for the points in the output.
   if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
@@ -329,27 +535,30 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   {
     newPts->SetDataType(VTK_DOUBLE);
   }
+  newPts->SetNumberOfPoints(numOutPts);
 
-  newPts->Allocate(numPts * numSourcePts);
+  vtkSmartPointer<vtkIdTypeArray> pointIds;
+  vtkSmartPointer<vtkDataArray> newScalars;
+  vtkSmartPointer<vtkFloatArray> newVectors;
+  vtkSmartPointer<vtkFloatArray> newNormals;
+  vtkSmartPointer<vtkFloatArray> newTCoords;
   if (this->GeneratePointIds)
   {
-    pointIds = vtkIdTypeArray::New();
+    pointIds = vtkSmartPointer<vtkIdTypeArray>::New();
     pointIds->SetName(this->PointIdsName);
-    pointIds->Allocate(numPts * numSourcePts);
-    outputPD->AddArray(pointIds);
-    pointIds->Delete();
+    pointIds->SetNumberOfValues(numOutPts);
   }
   if (this->ColorMode == VTK_COLOR_BY_SCALAR && inCScalars)
   {
-    newScalars = inCScalars->NewInstance();
+    newScalars.TakeReference(inCScalars->NewInstance());
     newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
-    newScalars->Allocate(inCScalars->GetNumberOfComponents() * numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numOutPts);
     newScalars->SetName(inCScalars->GetName());
   }
   else if ((this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
   {
-    newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars = vtkSmartPointer<vtkFloatArray>::New();
+    newScalars->SetNumberOfTuples(numOutPts);
     newScalars->SetName("GlyphScale");
     if (this->ScaleMode == VTK_SCALE_BY_SCALAR)
     {
@@ -358,391 +567,318 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   }
   else if ((this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
   {
-    newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars = vtkSmartPointer<vtkFloatArray>::New();
+    newScalars->SetNumberOfTuples(numOutPts);
     newScalars->SetName("VectorMagnitude");
   }
   if (haveVectors)
   {
-    newVectors = vtkFloatArray::New();
+    newVectors = vtkSmartPointer<vtkFloatArray>::New();
     newVectors->SetNumberOfComponents(3);
-    newVectors->Allocate(3 * numPts * numSourcePts);
+    newVectors->SetNumberOfTuples(numOutPts);
     newVectors->SetName("GlyphVector");
   }
   if (haveNormals)
   {
-    newNormals = vtkFloatArray::New();
+    newNormals = vtkSmartPointer<vtkFloatArray>::New();
     newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(numOutPts);
     newNormals->SetName("Normals");
   }
   if (haveTCoords)
   {
-    newTCoords = vtkFloatArray::New();
-    int numComps = sourceTCoords->GetNumberOfComponents();
-    newTCoords->SetNumberOfComponents(numComps);
-    newTCoords->Allocate(numComps * numPts * numSourcePts);
+    newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+    newTCoords->SetNumberOfComponents(sourceTCoords->GetNumberOfComponents());
+    newTCoords->SetNumberOfTuples(numOutPts);
     newTCoords->SetName("TCoords");
   }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->AllocateEstimate(numPts * numSourceCells, 3);
-
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
+  // The instances carry the rotation, the scale and the source of each glyph.
+  vtkNew<vtkFloatArray> orientations;
+  vtkNew<vtkFloatArray> scaleFactors;
+  vtkNew<vtkIntArray> glyphIndices;
+  if (this->OutputInstances)
+  {
+    orientations->SetName("GlyphOrientation");
+    orientations->SetNumberOfComponents(4);
+    orientations->SetNumberOfTuples(numOutPts);
+    scaleFactors->SetName("GlyphScaleFactors");
+    scaleFactors->SetNumberOfComponents(3);
+    scaleFactors->SetNumberOfTuples(numOutPts);
+    glyphIndices->SetName("GlyphIndex");
+    glyphIndices->SetNumberOfValues(this->IndexMode != VTK_INDEXING_OFF ? numOutPts : 0);
+  }
 
-  // Traverse all Input points, transforming Source points and copying
-  // point attributes.
-  //
-  ptIncr = 0;
-  cellIncr = 0;
-  for (inPtId = 0; inPtId < numPts; inPtId++)
+  // The cells of each type of all the glyphs.
+  vtkNew<vtkIdTypeArray> newOffsets[4];
+  vtkNew<vtkIdTypeArray> newConnectivity[4];
+  for (int type = 0; type < 4 && !this->OutputInstances; ++type)
   {
-    scalex = scaley = scalez = 1.0;
-    if (!(inPtId % 10000))
+    newOffsets[type]->SetNumberOfValues(totals.Cells[type] + 1);
+    newOffsets[type]->SetValue(totals.Cells[type], totals.Connectivity[type]);
+    newConnectivity[type]->SetNumberOfValues(totals.Connectivity[type]);
+  }
+
+  // Orient the glyph of an input point located at x.
+  auto orient = [&](vtkTransform* trans, const double x[3], double v[3], double vMag) {
+    if (!haveVectors || !this->Orient)
     {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->CheckAbort())
-      {
-        break;
-      }
+      return;
     }
-
-    // Get the scalar and vector data
-    if (inSScalars)
+    if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
     {
-      s = inSScalars->GetComponent(inPtId, 0);
-      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = s;
-      }
+      // v = glyphNormal_World (glyph normal direction in World coordinate system)
+      v[0] = this->FollowedCameraPosition[0] - x[0];
+      v[1] = this->FollowedCameraPosition[1] - x[1];
+      v[2] = this->FollowedCameraPosition[2] - x[2];
+      vtkMath::Normalize(v);
+      double glyphRight_World[3]; // glyph right direction in World coordinate system
+      vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
+      // glyph up direction in World coordinate system
+      // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
+      // orthogonal to the normal direction)
+      double glyphUp_World[3];
+      vtkMath::Cross(v, glyphRight_World, glyphUp_World);
+      double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
+        glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2], glyphUp_World[2],
+        v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
+      trans->Concatenate(glyphToWorld);
     }
-
-    if (haveVectors)
+    else if (vMag > 0.0)
     {
-      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      // if there is no y or z component
+      if (v[1] == 0.0 && v[2] == 0.0)
       {
-        vMag = 1.0; // v will be set later
-      }
-      else
-      {
-        vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
-        if (array3D->GetNumberOfComponents() > 3)
-        {
-          vtkErrorMacro(<< "vtkDataArray " << array3D->GetName()
-                        << " has more than 3 components.\n");
-          pts->Delete();
-          trans->Delete();
-          if (newPts)
-          {
-            newPts->Delete();
-          }
-          if (newVectors)
-          {
-            newVectors->Delete();
-          }
-          return false;
-        }
-
-        v[0] = 0;
-        v[1] = 0;
-        v[2] = 0;
-        array3D->GetTuple(inPtId, v);
-        vMag = vtkMath::Norm(v);
-        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        if (v[0] < 0) // just flip x if we need to
         {
-          scalex = v[0];
-          scaley = v[1];
-          scalez = v[2];
-        }
-        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
-        {
-          scalex = scaley = scalez = vMag;
+          trans->RotateWXYZ(180.0, 0, 1, 0);
         }
       }
-    }
-
-    // Clamp data scale if enabled
-    if (this->Clamping)
-    {
-      scalex = (scalex < this->Range[0] ? this->Range[0]
-                                        : (scalex > this->Range[1] ? this->Range[1] : scalex));
-      scalex = (scalex - this->Range[0]) / den;
-      scaley = (scaley < this->Range[0] ? this->Range[0]
-                                        : (scaley > this->Range[1] ? this->Range[1] : scaley));
-      scaley = (scaley - this->Range[0]) / den;
-      scalez = (scalez < this->Range[0] ? this->Range[0]
-                                        : (scalez > this->Range[1] ? this->Range[1] : scalez));
-      scalez = (scalez - this->Range[0]) / den;
-    }
-
-    // Compute index into table of glyphs
-    if (this->IndexMode != VTK_INDEXING_OFF)
-    {
-      if (this->IndexMode == VTK_INDEXING_BY_SCALAR)
-      {
-        value = s;
-      }
       else
       {
-        value = vMag;
-      }
-
-      int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
-      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
-
-      source = this->GetSource(index, sourceVector);
-      if (source != nullptr)
-      {
-        sourcePts = source->GetPoints();
-        sourceNormals = source->GetPointData()->GetNormals();
-        numSourcePts = sourcePts->GetNumberOfPoints();
-        numSourceCells = source->GetNumberOfCells();
+        trans->RotateWXYZ(180.0, (v[0] + vMag) / 2.0, v[1] / 2.0, v[2] / 2.0);
       }
     }
+  };
 
-    // Make sure we're not indexing into empty glyph
-    if (source == nullptr)
-    {
-      continue;
-    }
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate glyphs on the borders.
-    if (inGhostLevels &&
-      inGhostLevels[inPtId] &
-        (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT))
-    {
-      continue;
-    }
-
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
-    }
-
-    if (!this->IsPointVisible(input, inPtId))
+  // Scale the data scale of a glyph, if appropriate.
+  auto finalizeScale = [&](double scale[3]) {
+    if (!this->Scaling)
     {
-      continue;
+      scale[0] = scale[1] = scale[2] = 1.0;
+      return false;
     }
-
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
-    // Copy all topology (transformation independent)
-    for (cellId = 0; cellId < numSourceCells; cellId++)
+    for (int i = 0; i < 3; ++i)
     {
-      source->GetCellPoints(cellId, pointIdList);
-      cellPts = pointIdList;
-      npts = cellPts->GetNumberOfIds();
-      for (pts->Reset(), i = 0; i < npts; i++)
+      scale[i] = this->ScaleMode == VTK_DATA_SCALING_OFF ? this->ScaleFactor
+                                                         : scale[i] * this->ScaleFactor;
+      if (scale[i] == 0.0)
       {
-        pts->InsertId(i, cellPts->GetId(i) + ptIncr);
+        scale[i] = 1.0e-10;
       }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
     }
-
-    // translate Source to Input point
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
-
-    if (haveVectors)
+    return true;
+  };
+
+  // Pass 2: generate the glyphs, or the instances, of each batch of points in
+  // parallel. GetPoint() is thread safe once called from a single thread.
+  double x0[3];
+  input->GetPoint(0, x0);
+  vtkSMPThreadLocalObject<vtkTransform> localTransforms;
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    vtkTransform* trans = localTransforms.Local();
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
     {
-      // Copy Input vector
-      for (i = 0; i < numSourcePts; i++)
+      if (isFirst)
       {
-        newVectors->InsertTuple(i + ptIncr, v);
+        this->CheckAbort();
       }
-      if (this->Orient)
+      if (this->GetAbortOutput())
       {
-        if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+        return;
+      }
+      GlyphOffsets offsets = batchOffsets[batch];
+      const vtkIdType endPtId = std::min((batch + 1) * GlyphBatchSize, numPts);
+      for (vtkIdType ptId = batch * GlyphBatchSize; ptId < endPtId; ++ptId)
+      {
+        const int index = sourceIndices[ptId];
+        if (index < 0)
         {
-          // v = glyphNormal_World (glyph normal direction in World coordinate system)
-          v[0] = this->FollowedCameraPosition[0] - x[0];
-          v[1] = this->FollowedCameraPosition[1] - x[1];
-          v[2] = this->FollowedCameraPosition[2] - x[2];
-          vtkMath::Normalize(v);
-          double glyphRight_World[3]; // glyph right direction in World coordinate system
-          vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
-          // glyph up direction in World coordinate system
-          // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
-          // orthogonal to the normal direction)
-          double glyphUp_World[3];
-          vtkMath::Cross(v, glyphRight_World, glyphUp_World);
-          double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
-            glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2], glyphUp_World[2],
-            v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
-          trans->Concatenate(glyphToWorld);
+          continue;
+        }
+        const GlyphSource& glyph = sources[index];
+        double x[3], v[3], scale[3], vMag, s = 0.0;
+        computeScale(ptId, scale, v, vMag, s);
+        input->GetPoint(ptId, x);
+
+        // The output points of this glyph: a single point for an instance.
+        const vtkIdType ptIncr = this->OutputInstances ? offsets.Glyphs : offsets.Points;
+        const vtkIdType numGlyphPts = this->OutputInstances ? 1 : glyph.NumberOfPoints;
+        for (vtkIdType i = ptIncr; i < ptIncr + numGlyphPts; ++i)
+        {
+          if (newVectors)
+          {
+            newVectors->SetTuple(i, v);
+          }
+          if (inSScalars && this->ColorMode == VTK_COLOR_BY_SCALE)
+          {
+            newScalars->SetTuple(i, scale); // = scale[1] = scale[2]
+          }
+          else if (inCScalars && this->ColorMode == VTK_COLOR_BY_SCALAR)
+          {
+            newScalars->SetTuple(i, ptId, inCScalars);
+          }
+          if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
+          {
+            newScalars->SetTuple(i, &vMag);
+          }
+          if (pointIds)
+          {
+            pointIds->SetValue(i, ptId);
+          }
+          if (pd)
+          {
+            pointArrays.Copy(ptId, i);
+          }
         }
-        else if (vMag > 0.0)
+
+        trans->Identity();
+        if (this->OutputInstances)
         {
-          // if there is no y or z component
-          if (v[1] == 0.0 && v[2] == 0.0)
+          newPts->SetPoint(ptIncr, x);
+          orient(trans, x, v, vMag);
+          double rotation[3][3];
+          double quaternion[4];
+          vtkMatrix4x4* matrix = trans->GetMatrix();
+          for (int i = 0; i < 3; ++i)
           {
-            if (v[0] < 0) // just flip x if we need to
+            for (int j = 0; j < 3; ++j)
             {
-              trans->RotateWXYZ(180.0, 0, 1, 0);
+              rotation[i][j] = matrix->GetElement(i, j);
             }
           }
-          else
+          vtkMath::Matrix3x3ToQuaternion(rotation, quaternion);
+          orientations->SetTuple(ptIncr, quaternion);
+          finalizeScale(scale);
+          scaleFactors->SetTuple(ptIncr, scale);
+          if (this->IndexMode != VTK_INDEXING_OFF)
           {
-            vNew[0] = (v[0] + vMag) / 2.0;
-            vNew[1] = v[1] / 2.0;
-            vNew[2] = v[2] / 2.0;
-            trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+            glyphIndices->SetValue(ptIncr, index);
           }
+          offsets.Glyphs++;
+          continue;
         }
-      }
-    }
-
-    if (haveTCoords)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        sourceTCoords->GetTuple(i, tc);
-        newTCoords->InsertTuple(i + ptIncr, tc);
-      }
-    }
-
-    // determine scale factor from scalars if appropriate
-    // Copy scalar value
-    if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &scalex); // = scaley = scalez
-      }
-    }
-    else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr + i);
-      }
-    }
-    if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &vMag);
-      }
-    }
-
-    // scale data if appropriate
-    if (this->Scaling)
-    {
-      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = this->ScaleFactor;
-      }
-      else
-      {
-        scalex *= this->ScaleFactor;
-        scaley *= this->ScaleFactor;
-        scalez *= this->ScaleFactor;
-      }
 
-      if (scalex == 0.0)
-      {
-        scalex = 1.0e-10;
-      }
-      if (scaley == 0.0)
-      {
-        scaley = 1.0e-10;
-      }
-      if (scalez == 0.0)
-      {
-        scalez = 1.0e-10;
-      }
-      trans->Scale(scalex, scaley, scalez);
-    }
-
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
-    {
-      trans->TransformPoints(sourcePts, newPts);
-    }
-
-    if (haveNormals)
-    {
-      trans->TransformNormals(sourceNormals, newNormals);
-    }
+        // Translate, orient and scale the source to the input point.
+        trans->Translate(x[0], x[1], x[2]);
+        orient(trans, x, v, vMag);
+        if (finalizeScale(scale))
+        {
+          trans->Scale(scale[0], scale[1], scale[2]);
+        }
+        for (vtkIdType i = 0; i < glyph.NumberOfPoints; ++i)
+        {
+          double y[3];
+          trans->TransformPoint(glyph.Points.data() + 3 * i, y);
+          newPts->SetPoint(ptIncr + i, y);
+          if (newNormals)
+          {
+            double n[3];
+            glyph.Normals->GetTuple(i, n);
+            trans->TransformNormal(n, n);
+            newNormals->SetTuple(ptIncr + i, n);
+          }
+          if (newTCoords)
+          {
+            newTCoords->SetTuple(ptIncr + i, i, sourceTCoords);
+          }
+        }
 
-    // Copy point data from source (if possible)
-    if (pd)
-    {
-      for (i = 0; i < numSourcePts; ++i)
-      {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
-      }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
-      if (this->FillCellData)
-      {
-        for (i = 0; i < numSourceCells; ++i)
+        // Copy the cells of the source, shifted to the points of the glyph.
+        for (int type = 0; type < 4; ++type)
         {
-          srcCellIdList->SetId(i, inPtId);
-          dstCellIdList->SetId(i, cellIncr + i);
+          const vtkIdType numCells = glyph.GetNumberOfCells(type);
+          const vtkIdType cellIncr = offsets.Cells[type];
+          const vtkIdType connIncr = offsets.Connectivity[type];
+          vtkIdType* cellOffsets = newOffsets[type]->GetPointer(cellIncr);
+          for (vtkIdType i = 0; i < numCells; ++i)
+          {
+            cellOffsets[i] = glyph.Offsets[type][i] + connIncr;
+          }
+          vtkIdType* conn = newConnectivity[type]->GetPointer(connIncr);
+          for (vtkIdType id : glyph.Connectivity[type])
+          {
+            *conn++ = id + ptIncr;
+          }
+          if (pd && this->FillCellData)
+          {
+            for (vtkIdType i = 0; i < numCells; ++i)
+            {
+              cellArrays.Copy(ptId, typeStarts[type] + cellIncr + i);
+            }
+          }
         }
-        outputCD->CopyData(pd, srcCellIdList, dstCellIdList);
+        offsets.Add(glyph);
       }
     }
+  });
+  if (this->GetAbortOutput())
+  {
+    return true;
+  }
 
-    // If point ids are to be generated, do it here
-    if (this->GeneratePointIds)
+  // Update ourselves
+  //
+  output->SetPoints(newPts);
+  if (!this->OutputInstances)
+  {
+    vtkNew<vtkCellArray> cells[4];
+    for (int type = 0; type < 4; ++type)
     {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        pointIds->InsertNextValue(inPtId);
-      }
+      cells[type]->SetData(newOffsets[type], newConnectivity[type]);
+    }
+    output->SetVerts(cells[0]);
+    output->SetLines(cells[1]);
+    output->SetPolys(cells[2]);
+    output->SetStrips(cells[3]);
+  }
+  else
+  {
+    outputPD->AddArray(orientations);
+    outputPD->AddArray(scaleFactors);
+    if (this->IndexMode != VTK_INDEXING_OFF)
+    {
+      outputPD->AddArray(glyphIndices);
     }
-
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
   }
 
-  // Update ourselves and release memory
-  //
-  output->SetPoints(newPts);
-  newPts->Delete();
+  if (pointIds)
+  {
+    outputPD->AddArray(pointIds);
+  }
 
   if (newScalars)
   {
     int idx = outputPD->AddArray(newScalars);
     outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-    newScalars->Delete();
   }
 
   if (newVectors)
   {
     outputPD->SetVectors(newVectors);
-    newVectors->Delete();
   }
 
   if (newNormals)
   {
     outputPD->SetNormals(newNormals);
-    newNormals->Delete();
   }
 
   if (newTCoords)
   {
     outputPD->SetTCoords(newTCoords);
-    newTCoords->Delete();
   }
 
-  output->Squeeze();
-  trans->Delete();
-  pts->Delete();
-
   return true;
 }
 
@@ -893,6 +1029,7 @@ void vtkGlyph3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Fill Cell Data: " << (this->FillCellData ? "On\n" : "Off\n");
+  os << indent << "Output Instances: " << (this->OutputInstances ? "On\n" : "Off\n");
 
   os << indent << "SourceTransform: ";
   if (this->SourceTransform)
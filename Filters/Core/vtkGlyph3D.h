@@ -61,6 +61,19 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * The glyphs are generated in parallel with vtkSMPTools. The cells of the
+ * output are grouped by type, as in any vtkPolyData: the verts of all the
+ * glyphs, then their lines, polys and strips. IsPointVisible() is always
+ * called from the calling thread.
+ *
+ * @warning
+ * When OutputInstances is on, the glyphs are not copied: the output is a list
+ * of instances instead, one point per glyph without cells, carrying the
+ * transform of the glyph in point data arrays. Rendering this list with a
+ * vtkGlyph3DMapper, whose source is the source of this filter, draws the
+ * same glyphs at a fraction of the memory cost.
+ *
  * @sa
  * vtkTensorGlyph
  */
@@ -290,6 +303,26 @@ public:
   vtkBooleanMacro(FillCellData, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Enable/disable the output of the glyph instances instead of the glyphs.
+   * When on, the output has one point per glyph, at the input point, and no
+   * cells. The point data holds, for each glyph, its rotation as a
+   * (w, x, y, z) quaternion in the "GlyphOrientation" array, its scale along
+   * each axis in the "GlyphScaleFactors" array and, when indexing is on, its
+   * index in the table of sources in the "GlyphIndex" array, along with the
+   * color scalars, the "GlyphVector" vectors, the point ids and the point data
+   * of the input point. The source and the SourceTransform are not applied.
+   * A vtkGlyph3DMapper with OrientationMode set to QUATERNION, ScaleMode set to
+   * SCALE_BY_COMPONENTS, a ScaleFactor of 1 and, when indexing, SourceIndexing
+   * on, renders these instances with the glyph sources directly.
+   * Off by default.
+   */
+  vtkSetMacro(OutputInstances, vtkTypeBool);
+  vtkGetMacro(OutputInstances, vtkTypeBool);
+  vtkBooleanMacro(OutputInstances, vtkTypeBool);
+  ///@}
+
   /**
    * This can be overwritten by subclass to return 0 when a point is
    * blanked. Default implementation is to always return 1;
@@ -357,6 +390,7 @@ protected:
   int IndexMode;                  // what to use to index into glyph table
   vtkTypeBool GeneratePointIds;   // produce input points ids for each output point
   vtkTypeBool FillCellData;       // whether to fill output cell data
+  vtkTypeBool OutputInstances;    // whether to output instances instead of glyphs
   char* PointIdsName;
   vtkTransform* SourceTransform;
   int OutputPointsPrecision;
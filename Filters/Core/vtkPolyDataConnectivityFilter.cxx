@@ -5,6 +5,7 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityFilterInternal.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -16,6 +17,7 @@
 #include "vtkPolyData.h"
 
 #include <algorithm> // for fill_n
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
@@ -47,6 +49,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->VisitedPointIds = vtkIdList::New();
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->ParallelLabeling = 0;
 }
 
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
@@ -122,7 +125,11 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   //
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  const bool parallelLabeling = this->ParallelLabeling && !this->InScalars;
+  if (!parallelLabeling)
+  {
+    this->Mesh->BuildLinks();
+  }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -174,7 +181,12 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
   vtkIdType checkAbortInterval = 0;
 
-  if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  if (parallelLabeling)
+  {
+    largestRegionId = this->LabelRegionsInParallel();
+    this->UpdateProgress(0.9);
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -532,6 +544,70 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark()
   } // while wave is not empty
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkPolyDataConnectivityFilter::LabelRegionsInParallel()
+{
+  const vtkIdType numPts = this->Mesh->GetNumberOfPoints();
+  const vtkIdType numCells = this->Mesh->GetNumberOfCells();
+  vtkConnectedRegionLabeling labeling(this->Mesh, this);
+  if (!labeling.BuildForest(this->Visited))
+  {
+    std::fill_n(this->Visited, numCells, -1);
+    return 0;
+  }
+  this->UpdateProgress(0.5);
+
+  vtkIdType largestRegionId = 0;
+  if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+  { // regions have been seeded, everything considered in same region
+    std::vector<vtkIdType> seedPoints;
+    std::vector<vtkIdType> seedCells;
+    if (this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+    { // loop over points, find closest one
+      double minDist2 = VTK_DOUBLE_MAX, x[3];
+      vtkIdType minId = 0;
+      for (vtkIdType i = 0; i < numPts; i++)
+      {
+        this->Mesh->GetPoint(i, x);
+        const double dist2 = vtkMath::Distance2BetweenPoints(x, this->ClosestPoint);
+        if (dist2 < minDist2)
+        {
+          minId = i;
+          minDist2 = dist2;
+        }
+      }
+      seedPoints.push_back(minId);
+    }
+    else
+    {
+      std::vector<vtkIdType>& seeds =
+        this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ? seedPoints : seedCells;
+      seeds.assign(this->Seeds->begin(), this->Seeds->end());
+    }
+    this->NumCellsInRegion = labeling.LabelSeededRegions(this->Visited, seedPoints, seedCells);
+    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+  }
+  else
+  { // visit all cells marking with region number
+    this->RegionNumber = labeling.LabelAllRegions(this->Visited, this->RegionSizes);
+    vtkIdType maxCellsInRegion = 0;
+    for (vtkIdType regionId = 0; regionId < this->RegionNumber; ++regionId)
+    {
+      if (this->RegionSizes->GetValue(regionId) > maxCellsInRegion)
+      {
+        maxCellsInRegion = this->RegionSizes->GetValue(regionId);
+        largestRegionId = regionId;
+      }
+    }
+  }
+
+  this->PointNumber =
+    labeling.MapPoints(this->PointMap, vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars));
+  return largestRegionId;
+}
+
 //------------------------------------------------------------------------------
 int vtkPolyDataConnectivityFilter::IsScalarConnected(vtkIdType cellId)
 {
@@ -675,5 +751,6 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Parallel Labeling: " << (this->ParallelLabeling ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -216,6 +216,22 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the labeling of the regions in parallel. When on, the points
+   * of the cells are merged in a lock-free union-find forest, in parallel
+   * over the cells, instead of growing each region with a serial wave over
+   * the cell links, which are then not built. This supports all the
+   * extraction modes and gives the same regions, region ids and extracted
+   * cells, but the output points are ordered as the input points instead of
+   * in traversal order. The serial traversal is used when ScalarConnectivity
+   * is on. Default is OFF.
+   */
+  vtkSetMacro(ParallelLabeling, vtkTypeBool);
+  vtkGetMacro(ParallelLabeling, vtkTypeBool);
+  vtkBooleanMacro(ParallelLabeling, vtkTypeBool);
+  ///@}
+
 protected:
   vtkPolyDataConnectivityFilter();
   ~vtkPolyDataConnectivityFilter() override;
@@ -241,6 +257,10 @@ protected:
 
   void TraverseAndMark();
 
+  // Mark the cells and points of the regions in parallel, see
+  // ParallelLabeling. Return the id of the largest region.
+  vtkIdType LabelRegionsInParallel();
+
   // used to support algorithm execution
   vtkDataArray* CellScalars;
   vtkIdList* NeighborCellPointIds;
@@ -260,6 +280,7 @@ protected:
 
   vtkTypeBool MarkVisitedPointIds;
   int OutputPointsPrecision;
+  vtkTypeBool ParallelLabeling;
 
 private:
   vtkPolyDataConnectivityFilter(const vtkPolyDataConnectivityFilter&) = delete;
@@ -11,6 +11,7 @@
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
+#include "vtkInformationStringVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkNew.h"
@@ -176,6 +177,19 @@ vtkSmartPointer<vtkFloatArray> vtkPolyDataNormals::GetPointNormals(
   return pointNormals;
 }
 
+//-----------------------------------------------------------------------------
+int vtkPolyDataNormals::FillInputPortInformation(int port, vtkInformation* info)
+{
+  if (!this->Superclass::FillInputPortInformation(port, info))
+  {
+    return 0;
+  }
+  info->Set(vtkAlgorithm::INPUT_DEPENDS_ON_DECLARED_ARRAYS(), 1);
+  vtkAlgorithm::INPUT_DECLARED_ARRAYS()->Append(
+    info, vtkDataSetAttributes::GetAttributeTypeAsString(vtkDataSetAttributes::NORMALS));
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 // Generate normals for polygon meshes
 int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
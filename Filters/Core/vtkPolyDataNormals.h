@@ -200,6 +200,10 @@ protected:
   // Usual data generation method
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  // Declare that only the structure and the active normals of the input are
+  // read, so that changes of other input arrays do not recompute the normals.
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
   double FeatureAngle;
   vtkTypeBool Splitting;
   vtkTypeBool Consistency;
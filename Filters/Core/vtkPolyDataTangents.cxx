@@ -13,8 +13,12 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
-
+#include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
+#include "vtkStaticCellLinksTemplate.h"
+
+#include <algorithm>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 struct TangentComputation
@@ -194,23 +198,30 @@ int vtkPolyDataTangents::RequestData(vtkInformation* vtkNotUsed(request),
 
   if (this->ComputePointTangents)
   {
-    vtkIdType cellId = 0;
-    vtkIdType npts;
-    const vtkIdType* pts;
-    for (inPolys->InitTraversal(); inPolys->GetNextCell(npts, pts); ++cellId)
-    {
-      for (vtkIdType i = 0; i < npts; ++i)
+    // Each point sums the tangents of its triangles in parallel, in the order
+    // of the triangles, so that the sums do not depend on the number of
+    // threads. The tangents of the triangles follow the ones of the verts.
+    vtkStaticCellLinksTemplate<vtkIdType> links;
+    links.ThreadedBuildLinks(numPts, numPolys, inPolys);
+    vtkSMPThreadLocal<std::vector<vtkIdType>> localCells;
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<vtkIdType>& cells = localCells.Local();
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
       {
-        fTangents[3 * pts[i]] += fCellTangents[3 * cellId];
-        fTangents[3 * pts[i] + 1] += fCellTangents[3 * cellId + 1];
-        fTangents[3 * pts[i] + 2] += fCellTangents[3 * cellId + 2];
+        const vtkIdType* ptCells = links.GetCells(ptId);
+        cells.assign(ptCells, ptCells + links.GetNcells(ptId));
+        std::sort(cells.begin(), cells.end());
+        float* tangent = fTangents + 3 * ptId;
+        for (vtkIdType polyId : cells)
+        {
+          const float* cellTangent = fCellTangents + 3 * (numVerts + polyId);
+          tangent[0] += cellTangent[0];
+          tangent[1] += cellTangent[1];
+          tangent[2] += cellTangent[2];
+        }
+        vtkMath::Normalize(tangent);
       }
-    }
-
-    for (vtkIdType i = 0; i < numPts; ++i)
-    {
-      vtkMath::Normalize(fTangents + 3 * i);
-    }
+    });
 
     outPD->SetTangents(pointTangents);
   }
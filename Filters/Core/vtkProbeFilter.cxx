@@ -28,6 +28,8 @@
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -51,6 +53,65 @@ inline bool IsBlankedCell(vtkUnsignedCharArray* gcells, vtkIdType cellId)
   }
   return false;
 }
+
+//------------------------------------------------------------------------------
+// Spread the 21 lower bits of v so that there are two zero bits between each.
+inline uint64_t SpreadBits(uint64_t v)
+{
+  v &= 0x1fffff;
+  v = (v | (v << 32)) & 0x1f00000000ffffULL;
+  v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+  v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+  v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+  v = (v | (v << 2)) & 0x1249249249249249ULL;
+  return v;
+}
+
+//------------------------------------------------------------------------------
+// Return the ids of the points of the input in the order of their Morton
+// codes, computed on a grid of 2^21 cells along each axis of the bounds.
+std::vector<vtkIdType> SortPointsAlongMortonCurve(vtkDataSet* input)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  double bounds[6];
+  input->GetBounds(bounds);
+  double scale[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    const double length = bounds[2 * i + 1] - bounds[2 * i];
+    scale[i] = length > 0.0 ? 2097151.0 / length : 0.0;
+  }
+
+  // make the input API threadsafe by calling it once in a single thread.
+  double x[3];
+  input->GetPoint(0, x);
+
+  std::vector<std::pair<uint64_t, vtkIdType>> codes(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double p[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      input->GetPoint(ptId, p);
+      uint64_t code = 0;
+      for (int i = 0; i < 3; ++i)
+      {
+        const double v = (p[i] - bounds[2 * i]) * scale[i];
+        code |= SpreadBits(static_cast<uint64_t>(vtkMath::ClampValue(v, 0.0, 2097151.0))) << i;
+      }
+      codes[ptId] = std::make_pair(code, ptId);
+    }
+  });
+  vtkSMPTools::Sort(codes.begin(), codes.end());
+
+  std::vector<vtkIdType> order(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      order[i] = codes[i].second;
+    }
+  });
+  return order;
+}
 }
 
 //------------------------------------------------------------------------------
@@ -76,6 +137,7 @@ vtkProbeFilter::vtkProbeFilter()
   this->Tolerance = 1.0;
   this->ComputeTolerance = true;
   this->SnapToCellWithClosestPoint = false;
+  this->SortPointsSpatially = false;
 }
 
 //------------------------------------------------------------------------------
@@ -405,6 +467,7 @@ class vtkProbeFilter::ProbeEmptyPointsWorklet
   vtkCharArray* MaskArray;
   double Tol2;
   int MaxCellSize;
+  const vtkIdType* PointOrder;
 
   struct LocalData
   {
@@ -426,7 +489,8 @@ class vtkProbeFilter::ProbeEmptyPointsWorklet
 public:
   ProbeEmptyPointsWorklet(vtkProbeFilter* probeFilter, int sourceIndex, vtkDataSet* input,
     vtkDataSet* source, vtkPointData* outputPD, vtkFindCellStrategy* strategy,
-    vtkUnsignedCharArray* sourceGhostFlags, vtkCharArray* maskArray, double tol2, int maxCellSize)
+    vtkUnsignedCharArray* sourceGhostFlags, vtkCharArray* maskArray, double tol2, int maxCellSize,
+    const vtkIdType* pointOrder)
     : ProbeFilter(probeFilter)
     , SourceIdx(sourceIndex)
     , Input(input)
@@ -439,6 +503,7 @@ public:
     , MaskArray(maskArray)
     , Tol2(tol2)
     , MaxCellSize(maxCellSize)
+    , PointOrder(pointOrder)
   {
     // instantiate the cell map for polydata
     vtkNew<vtkGenericCell> cell;
@@ -468,7 +533,7 @@ public:
     tlData.LastCellId = -1;
   }
 
-  void operator()(vtkIdType beginPointId, vtkIdType endPointId)
+  void operator()(vtkIdType beginIndex, vtkIdType endIndex)
   {
     // global data
     auto maskArray = this->MaskArray->GetPointer(0);
@@ -492,11 +557,12 @@ public:
     int inside;
     bool foundInCache, insideCellBounds;
     bool isFirst = vtkSMPTools::GetSingleThread();
-    vtkIdType checkAbortInterval = std::min((endPointId - beginPointId) / 10 + 1, (vtkIdType)1000);
+    vtkIdType checkAbortInterval = std::min((endIndex - beginIndex) / 10 + 1, (vtkIdType)1000);
 
-    for (vtkIdType pointId = beginPointId; pointId < endPointId; ++pointId)
+    for (vtkIdType index = beginIndex; index < endIndex; ++index)
     {
-      if (pointId % checkAbortInterval == 0)
+      const vtkIdType pointId = this->PointOrder ? this->PointOrder[index] : index;
+      if (index % checkAbortInterval == 0)
       {
         if (isFirst)
         {
@@ -747,8 +813,16 @@ void vtkProbeFilter::ProbeEmptyPoints(
     }
   }
 
+  // Probing the points along a Morton curve keeps the cell of the previous
+  // point a good guess, and the values are scattered back to the point ids.
+  std::vector<vtkIdType> pointOrder;
+  if (this->SortPointsSpatially && input->GetNumberOfPoints() > 0)
+  {
+    pointOrder = ::SortPointsAlongMortonCurve(input);
+  }
+
   ProbeEmptyPointsWorklet worker(this, srcIdx, input, source, outPD, strategy, sourceGhostFlags,
-    this->MaskPoints, tol2, maxCellSize);
+    this->MaskPoints, tol2, maxCellSize, pointOrder.empty() ? nullptr : pointOrder.data());
   vtkSMPTools::For(0, input->GetNumberOfPoints(), worker);
 
   this->MaskPoints->Modified();
@@ -1280,6 +1354,7 @@ void vtkProbeFilter::PrintSelf(ostream& os, vtkIndent indent)
      << (this->ValidPointMaskArrayName ? this->ValidPointMaskArrayName : "vtkValidPointMask")
      << "\n";
   os << indent << "PassFieldArrays: " << (this->PassFieldArrays ? "On" : " Off") << "\n";
+  os << indent << "SortPointsSpatially: " << (this->SortPointsSpatially ? "On" : "Off") << "\n";
 
   os << indent << "FindCellStrategy: "
      << (this->FindCellStrategy ? this->FindCellStrategy->GetClassName() : "NULL") << "\n";
@@ -192,6 +192,27 @@ public:
   vtkGetMacro(SnapToCellWithClosestPoint, bool);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get whether to probe the points in the order of a Morton curve
+   * through their bounds instead of in the order of their ids. Consecutive
+   * points are then close to each other, so that the cell found for a point
+   * is often the cell of the next one, and the locator data stays in cache.
+   * This speeds up the probing of point sets whose points are not spatially
+   * ordered, such as random or partitioned points. The values are still
+   * stored at the id of each point, but a point on the boundary between
+   * cells may be interpolated in another one of these cells than with the
+   * ordering of the ids.
+   *
+   * Default is off.
+   *
+   * Note: This is not used when the input or the source is a vtkImageData.
+   */
+  vtkSetMacro(SortPointsSpatially, bool);
+  vtkBooleanMacro(SortPointsSpatially, bool);
+  vtkGetMacro(SortPointsSpatially, bool);
+  ///@}
+
   ///@{
   /**
    * Set whether to use the Tolerance field or precompute the tolerance.
@@ -276,6 +297,7 @@ protected:
   double Tolerance;
   bool ComputeTolerance;
   bool SnapToCellWithClosestPoint;
+  bool SortPointsSpatially;
 
   char* ValidPointMaskArrayName;
   vtkIdTypeArray* ValidPoints;
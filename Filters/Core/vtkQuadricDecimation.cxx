@@ -41,9 +41,241 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// Set the geometric part of the quadric of the triangle (point0, point1,
+// point2), the first 11 values of QEM, regularized with variance when
+// regularize is true. Return the area of the triangle, and its unit normal n
+// and offset d.
+double ComputeTriangleQuadric(const double point0[3], const double point1[3],
+  const double point2[3], bool regularize, double variance, double* QEM, double n[3], double& d)
+{
+  double tempP1[3], tempP2[3];
+  for (int i = 0; i < 3; i++)
+  {
+    tempP1[i] = point1[i] - point0[i];
+    tempP2[i] = point2[i] - point0[i];
+  }
+  vtkMath::Cross(tempP1, tempP2, n);
+  double triArea2 = vtkMath::Normalize(n);
+  // triArea2 = (triArea2 * triArea2 * 0.25);
+  triArea2 = triArea2 * 0.5;
+  // I am unsure whether this should be squared or not??
+  d = -vtkMath::Dot(n, point0);
+  // could possible add in angle weights??
+
+  // set the geometric part of the QEM
+  QEM[0] = n[0] * n[0];
+  QEM[1] = n[0] * n[1];
+  QEM[2] = n[0] * n[2];
+  QEM[3] = d * n[0];
+
+  QEM[4] = n[1] * n[1];
+  QEM[5] = n[1] * n[2];
+  QEM[6] = d * n[1];
+
+  QEM[7] = n[2] * n[2];
+  QEM[8] = d * n[2];
+
+  QEM[9] = d * d;
+  QEM[10] = 1;
+
+  if (regularize)
+  {
+    // Add in some regularizing identity \Sigma_n
+    QEM[0] += variance;
+    QEM[4] += variance;
+    QEM[7] += variance;
+
+    // -\Sigma_n . q
+    QEM[3] -= variance * point0[0];
+    QEM[6] -= variance * point0[1];
+    QEM[8] -= variance * point0[2];
+
+    // q^T \Sigma_n q + n^T \Sigma_q n + Tr(\Sigma_n \Sigma_q)
+    QEM[9] += variance * (vtkMath::Dot(point0, point0) + 1 + 3 * variance);
+  }
+  return triArea2;
+}
+
+//------------------------------------------------------------------------------
+// Set the quadric of the plane orthogonal to the triangle (t0, t1, t2) through
+// its boundary edge (t1, t2), the first 11 values of QEM, and return the
+// weight of this constraint.
+double ComputeBoundaryQuadric(const double t0[3], const double t1[3], const double t2[3],
+  bool weighByLength, double weightFactor, double* QEM)
+{
+  double e0[3], e1[3], n[3], c, w;
+  int j;
+
+  // computing a plane which is orthogonal to line t1, t2 and incident
+  // with it
+  for (j = 0; j < 3; j++)
+  {
+    e0[j] = t2[j] - t1[j];
+  }
+  for (j = 0; j < 3; j++)
+  {
+    e1[j] = t0[j] - t1[j];
+  }
+
+  // compute n so that it is orthogonal to e0 and parallel to the
+  // triangle
+  c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
+  for (j = 0; j < 3; j++)
+  {
+    n[j] = e1[j] - c * e0[j];
+  }
+  vtkMath::Normalize(n);
+
+#if defined(_MSC_VER) && _MSC_VER >= 1929
+  // Visual Studio toolset starting at toolset 14.29.30133, when building in Release mode
+  // incorrectly optimizes away the line
+  //    QEM[9] = d * d;
+  // By making volatile, we are telling the compiler not to optimize out
+  // or reorder operations regarding this variable.
+  volatile
+#endif
+    double d = -vtkMath::Dot(n, t1);
+  // The above line might merit some review: The same quadric gets added to t1 and t2 and one
+  // might prefer adding a quadric calculated using t1 at t1 and using t2 at t2
+  w = vtkMath::Norm(e0);
+
+  if (!weighByLength)
+  {
+    /*
+     * The argument for using area instead of length is based on homogeneity here: The quadric
+     * field is already weighted by triangle area. It makes sense weighting the boundary
+     * constraints by area instead of length. Length technically has zero measure in terms of
+     * units of area. The squared version also seems to give more coherent results at the
+     * boundary.
+     */
+    w *= w;
+  }
+  w *= weightFactor;
+
+  // could possible add in
+  // angle weights??
+  QEM[0] = n[0] * n[0];
+  QEM[1] = n[0] * n[1];
+  QEM[2] = n[0] * n[2];
+  QEM[3] = d * n[0];
+
+  QEM[4] = n[1] * n[1];
+  QEM[5] = n[1] * n[2];
+  QEM[6] = d * n[1];
+
+  QEM[7] = n[2] * n[2];
+  QEM[8] = d * n[2];
+
+  QEM[9] = d * d;
+
+  QEM[10] = 1;
+  return w;
+}
+
+//------------------------------------------------------------------------------
+// Compute the point x minimizing the geometric quadric quad of the edge
+// (pt0Id, pt1Id), the sum of the quadrics of its end points, and return the
+// cost of collapsing the edge to x.
+double ComputeGeometricCost(
+  const double* quad, vtkPoints* points, vtkIdType pt0Id, vtkIdType pt1Id, double* x)
+{
+  static const double errorNumber = 1e-10;
+  double temp[3], A[3][3], b[3];
+  double cost = 0.0;
+  const double* index;
+  int i, j;
+  double newPoint[4];
+  double v[3], c, norm, normTemp, temp2[3];
+  double pt1[3], pt2[3];
+
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
+
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
+
+  norm = vtkMath::Norm(A[0]);
+  normTemp = vtkMath::Norm(A[1]);
+  norm = norm > normTemp ? norm : normTemp;
+  normTemp = vtkMath::Norm(A[2]);
+  norm = norm > normTemp ? norm : normTemp;
+
+  if (fabs(vtkMath::Determinant3x3(A)) / (norm * norm * norm) > errorNumber)
+  {
+    // it would be better to use the normal of the matrix to test singularity??
+    vtkMath::LinearSolve3x3(A, b, x);
+  }
+  else
+  {
+    // cheapest point along the edge
+    points->GetPoint(pt0Id, pt1);
+    points->GetPoint(pt1Id, pt2);
+    v[0] = pt2[0] - pt1[0];
+    v[1] = pt2[1] - pt1[1];
+    v[2] = pt2[2] - pt1[2];
+
+    // equation for the edge pt1 + c * v
+    // attempt least squares fit for c for A*(pt1 + c * v) = b
+    vtkMath::Multiply3x3(A, v, temp2);
+    if (vtkMath::Dot(temp2, temp2) > errorNumber)
+    {
+      vtkMath::Multiply3x3(A, pt1, temp);
+      for (i = 0; i < 3; i++)
+        temp[i] = b[i] - temp[i];
+      c = vtkMath::Dot(temp2, temp) / vtkMath::Dot(temp2, temp2);
+      for (i = 0; i < 3; i++)
+        x[i] = pt1[i] + c * v[i];
+    }
+    else
+    {
+      // use mid point
+      // might want to change to best of mid and end points??
+      for (i = 0; i < 3; i++)
+      {
+        x[i] = 0.5 * (pt1[i] + pt2[i]);
+      }
+    }
+  }
+
+  newPoint[0] = x[0];
+  newPoint[1] = x[1];
+  newPoint[2] = x[2];
+  newPoint[3] = 1;
+
+  // Compute the cost
+  // x'*quad*x
+  index = quad;
+  for (i = 0; i < 4; i++)
+  {
+    cost += (*index++) * newPoint[i] * newPoint[i];
+    for (j = i + 1; j < 4; j++)
+    {
+      cost += 2.0 * (*index++) * newPoint[i] * newPoint[j];
+    }
+  }
+
+  return cost;
+}
+}
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
 //------------------------------------------------------------------------------
@@ -264,6 +496,13 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->Mesh->SetPoints(points);
   points->Delete();
   polys->DeepCopy(input->GetPolys());
+  const bool parallelCollapses = this->ParallelCollapses && !this->AttributeErrorMetric;
+  if (parallelCollapses)
+  {
+    // GetCellPoints() and the edits of the collapses are thread safe with the
+    // default storage.
+    polys->ConvertToDefaultStorage();
+  }
   this->Mesh->SetPolys(polys);
   polys->Delete();
   if (this->AttributeErrorMetric || this->MapPointData)
@@ -286,124 +525,144 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
-  vtkDebugMacro(<< "Computing Edges");
-  this->Edges->InitEdgeInsertion(numPts, 1); // storing edge id as attribute
-  this->EdgeCosts->Allocate(this->Mesh->GetPolys()->GetNumberOfCells() * 3);
-  for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
+  if (parallelCollapses)
   {
-    this->Mesh->GetCellPoints(i, npts, pts);
-
-    for (j = 0; j < 3; j++)
+    this->NumberOfComponents = 0;
+    this->ActualReduction = 0.0;
+    this->NumberOfEdgeCollapses = 0;
+    this->CollapseEdgesInParallel(numTris);
+    vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses);
+  }
+  else
+  {
+    vtkDebugMacro(<< "Computing Edges");
+    this->Edges->InitEdgeInsertion(numPts, 1); // storing edge id as attribute
+    this->EdgeCosts->Allocate(this->Mesh->GetPolys()->GetNumberOfCells() * 3);
+    for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
     {
-      if (this->Edges->IsEdge(pts[j], pts[(j + 1) % 3]) == -1)
+      this->Mesh->GetCellPoints(i, npts, pts);
+
+      for (j = 0; j < 3; j++)
       {
-        // If this edge has not been processed, get an id for it, add it to
-        // the edge list (Edges), and add its endpoints to the EndPoint1List
-        // and EndPoint2List (the 2 endpoints to different lists).
-        edgeId = this->Edges->GetNumberOfEdges();
-        this->Edges->InsertEdge(pts[j], pts[(j + 1) % 3], edgeId);
-        this->EndPoint1List->InsertId(edgeId, pts[j]);
-        this->EndPoint2List->InsertId(edgeId, pts[(j + 1) % 3]);
+        if (this->Edges->IsEdge(pts[j], pts[(j + 1) % 3]) == -1)
+        {
+          // If this edge has not been processed, get an id for it, add it to
+          // the edge list (Edges), and add its endpoints to the EndPoint1List
+          // and EndPoint2List (the 2 endpoints to different lists).
+          edgeId = this->Edges->GetNumberOfEdges();
+          this->Edges->InsertEdge(pts[j], pts[(j + 1) % 3], edgeId);
+          this->EndPoint1List->InsertId(edgeId, pts[j]);
+          this->EndPoint2List->InsertId(edgeId, pts[(j + 1) % 3]);
+        }
       }
     }
-  }
 
-  this->UpdateProgress(0.1);
+    this->UpdateProgress(0.1);
 
-  this->NumberOfComponents = 0;
-  if (this->AttributeErrorMetric)
-  {
-    this->ComputeNumberOfComponents();
-  }
-  x = new double[3 + this->NumberOfComponents + this->VolumePreservation];
-  this->CollapseCellIds = vtkIdList::New();
-  this->TempX = new double[3 + this->NumberOfComponents + this->VolumePreservation];
-  this->TempQuad = new double[11 + 4 * this->NumberOfComponents + this->VolumePreservation];
-
-  this->TempB = new double[3 + this->NumberOfComponents + this->VolumePreservation];
-  this->TempA = new double*[3 + this->NumberOfComponents + this->VolumePreservation];
-  this->TempData = new double[(3 + this->NumberOfComponents + this->VolumePreservation) *
-    (3 + this->NumberOfComponents + VolumePreservation)];
-  for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
-  {
-    this->TempA[i] = this->TempData + i * (3 + this->NumberOfComponents + this->VolumePreservation);
-  }
-  this->TargetPoints->SetNumberOfComponents(
-    3 + this->NumberOfComponents + this->VolumePreservation);
-
-  vtkDebugMacro(<< "Computing Quadrics");
-  this->InitializeQuadrics(numPts);
-  this->AddBoundaryConstraints();
-  this->UpdateProgress(0.15);
-
-  vtkDebugMacro(<< "Computing Costs");
-  // Compute the cost of and target point for collapsing each edge.
-  for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
-  {
+    this->NumberOfComponents = 0;
     if (this->AttributeErrorMetric)
     {
-      cost = this->ComputeCost2(i, x);
+      this->ComputeNumberOfComponents();
     }
-    else
+    x = new double[3 + this->NumberOfComponents + this->VolumePreservation];
+    this->CollapseCellIds = vtkIdList::New();
+    this->TempX = new double[3 + this->NumberOfComponents + this->VolumePreservation];
+    this->TempQuad = new double[11 + 4 * this->NumberOfComponents + this->VolumePreservation];
+
+    this->TempB = new double[3 + this->NumberOfComponents + this->VolumePreservation];
+    this->TempA = new double*[3 + this->NumberOfComponents + this->VolumePreservation];
+    this->TempData = new double[(3 + this->NumberOfComponents + this->VolumePreservation) *
+      (3 + this->NumberOfComponents + VolumePreservation)];
+    for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
     {
-      cost = this->ComputeCost(i, x);
+      this->TempA[i] =
+        this->TempData + i * (3 + this->NumberOfComponents + this->VolumePreservation);
     }
-    this->EdgeCosts->Insert(cost, i);
-    this->TargetPoints->InsertTuple(i, x);
-  }
-  this->UpdateProgress(0.20);
+    this->TargetPoints->SetNumberOfComponents(
+      3 + this->NumberOfComponents + this->VolumePreservation);
 
-  // Okay collapse edges until desired reduction is reached
-  this->ActualReduction = 0.0;
-  this->NumberOfEdgeCollapses = 0;
-  edgeId = this->EdgeCosts->Pop(0, cost);
+    vtkDebugMacro(<< "Computing Quadrics");
+    this->InitializeQuadrics(numPts);
+    this->AddBoundaryConstraints();
+    this->UpdateProgress(0.15);
 
-  bool abort = false;
-  while (
-    !abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX && this->ActualReduction < this->TargetReduction)
-  {
-    if (!(this->NumberOfEdgeCollapses % 10000))
+    vtkDebugMacro(<< "Computing Costs");
+    // Compute the cost of and target point for collapsing each edge.
+    for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
     {
-      vtkDebugMacro(<< "Collapsing edge#" << this->NumberOfEdgeCollapses);
-      this->UpdateProgress(0.20 + 0.80 * this->NumberOfEdgeCollapses / numPts);
-      abort = this->CheckAbort();
+      if (this->AttributeErrorMetric)
+      {
+        cost = this->ComputeCost2(i, x);
+      }
+      else
+      {
+        cost = this->ComputeCost(i, x);
+      }
+      this->EdgeCosts->Insert(cost, i);
+      this->TargetPoints->InsertTuple(i, x);
     }
+    this->UpdateProgress(0.20);
 
-    endPtIds[0] = this->EndPoint1List->GetId(edgeId);
-    endPtIds[1] = this->EndPoint2List->GetId(edgeId);
-    this->TargetPoints->GetTuple(edgeId, x);
+    // Okay collapse edges until desired reduction is reached
+    this->ActualReduction = 0.0;
+    this->NumberOfEdgeCollapses = 0;
+    edgeId = this->EdgeCosts->Pop(0, cost);
 
-    // check for a poorly placed point
-    if (!this->IsGoodPlacement(endPtIds[0], endPtIds[1], x))
+    bool abort = false;
+    while (!abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX &&
+      this->ActualReduction < this->TargetReduction)
     {
-      vtkDebugMacro(<< "Poor placement detected " << edgeId << " " << cost);
-      // return the point to the queue but with the max cost so that
-      // when it is recomputed it will be reconsidered
-      this->EdgeCosts->Insert(VTK_DOUBLE_MAX, edgeId);
+      if (!(this->NumberOfEdgeCollapses % 10000))
+      {
+        vtkDebugMacro(<< "Collapsing edge#" << this->NumberOfEdgeCollapses);
+        this->UpdateProgress(0.20 + 0.80 * this->NumberOfEdgeCollapses / numPts);
+        abort = this->CheckAbort();
+      }
 
-      edgeId = this->EdgeCosts->Pop(0, cost);
-      continue;
-    }
+      endPtIds[0] = this->EndPoint1List->GetId(edgeId);
+      endPtIds[1] = this->EndPoint2List->GetId(edgeId);
+      this->TargetPoints->GetTuple(edgeId, x);
 
-    this->NumberOfEdgeCollapses++;
+      // check for a poorly placed point
+      if (!this->IsGoodPlacement(endPtIds[0], endPtIds[1], x))
+      {
+        vtkDebugMacro(<< "Poor placement detected " << edgeId << " " << cost);
+        // return the point to the queue but with the max cost so that
+        // when it is recomputed it will be reconsidered
+        this->EdgeCosts->Insert(VTK_DOUBLE_MAX, edgeId);
 
-    // Set the new coordinates of point0.
-    this->SetPointAttributeArray(endPtIds, x);
-    vtkDebugMacro(<< "Cost: " << cost << " Edge: " << endPtIds[0] << " " << endPtIds[1]);
+        edgeId = this->EdgeCosts->Pop(0, cost);
+        continue;
+      }
 
-    // Merge the quadrics of the two points.
-    this->AddQuadric(endPtIds[1], endPtIds[0]);
+      this->NumberOfEdgeCollapses++;
 
-    this->UpdateEdgeData(endPtIds[0], endPtIds[1]);
+      // Set the new coordinates of point0.
+      this->SetPointAttributeArray(endPtIds, x);
+      vtkDebugMacro(<< "Cost: " << cost << " Edge: " << endPtIds[0] << " " << endPtIds[1]);
 
-    // Update the output triangles.
-    numDeletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1]);
-    this->ActualReduction = (double)numDeletedTris / numTris;
-    edgeId = this->EdgeCosts->Pop(0, cost);
-  }
+      // Merge the quadrics of the two points.
+      this->AddQuadric(endPtIds[1], endPtIds[0]);
 
-  vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses
-                << " Cost: " << cost);
+      this->UpdateEdgeData(endPtIds[0], endPtIds[1]);
+
+      // Update the output triangles.
+      numDeletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1]);
+      this->ActualReduction = (double)numDeletedTris / numTris;
+      edgeId = this->EdgeCosts->Pop(0, cost);
+    }
+
+    vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses
+                  << " Cost: " << cost);
+
+    delete[] x;
+    this->CollapseCellIds->Delete();
+    delete[] this->TempX;
+    delete[] this->TempQuad;
+    delete[] this->TempB;
+    delete[] this->TempA;
+    delete[] this->TempData;
+  }
 
   // clean up working data
   for (i = 0; i < numPts; i++)
@@ -414,13 +673,6 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 
   if (this->VolumePreservation)
     delete[] this->VolumeConstraints;
-  delete[] x;
-  this->CollapseCellIds->Delete();
-  delete[] this->TempX;
-  delete[] this->TempQuad;
-  delete[] this->TempB;
-  delete[] this->TempA;
-  delete[] this->TempData;
 
   // copy the simplified mesh from the working mesh to the output mesh
   for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
@@ -468,7 +720,7 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
   const vtkIdType* pts = nullptr;
   double point0[3], point1[3], point2[3];
   double n[3];
-  double tempP1[3], tempP2[3], d, triArea2;
+  double d, triArea2;
   double data[16];
   double *A[4], x[4];
   int index[4];
@@ -503,51 +755,8 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
     input->GetPoint(pts[0], point0);
     input->GetPoint(pts[1], point1);
     input->GetPoint(pts[2], point2);
-    for (i = 0; i < 3; i++)
-    {
-      tempP1[i] = point1[i] - point0[i];
-      tempP2[i] = point2[i] - point0[i];
-    }
-    vtkMath::Cross(tempP1, tempP2, n);
-    triArea2 = vtkMath::Normalize(n);
-    // triArea2 = (triArea2 * triArea2 * 0.25);
-    triArea2 = triArea2 * 0.5;
-    // I am unsure whether this should be squared or not??
-    d = -vtkMath::Dot(n, point0);
-    // could possible add in angle weights??
-
-    // set the geometric part of the QEM
-    QEM[0] = n[0] * n[0];
-    QEM[1] = n[0] * n[1];
-    QEM[2] = n[0] * n[2];
-    QEM[3] = d * n[0];
-
-    QEM[4] = n[1] * n[1];
-    QEM[5] = n[1] * n[2];
-    QEM[6] = d * n[1];
-
-    QEM[7] = n[2] * n[2];
-    QEM[8] = d * n[2];
-
-    QEM[9] = d * d;
-    QEM[10] = 1;
-
-    if (this->Regularize)
-    {
-      // Add in some regularizing identity \Sigma_n
-      QEM[0] += regularizationVariance;
-      QEM[4] += regularizationVariance;
-      QEM[7] += regularizationVariance;
-
-      // -\Sigma_n . q
-      QEM[3] -= regularizationVariance * point0[0];
-      QEM[6] -= regularizationVariance * point0[1];
-      QEM[8] -= regularizationVariance * point0[2];
-
-      // q^T \Sigma_n q + n^T \Sigma_q n + Tr(\Sigma_n \Sigma_q)
-      QEM[9] +=
-        regularizationVariance * (vtkMath::Dot(point0, point0) + 1 + 3 * regularizationVariance);
-    }
+    triArea2 = ComputeTriangleQuadric(
+      point0, point1, point2, this->Regularize, regularizationVariance, QEM, n, d);
 
     if (this->AttributeErrorMetric)
     {
@@ -688,8 +897,7 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
   int i, j;
   vtkIdType npts;
   const vtkIdType* pts;
-  double t0[3], t1[3], t2[3];
-  double e0[3], e1[3], n[3], c, w;
+  double t0[3], t1[3], t2[3], w;
   vtkIdList* cellIds = vtkIdList::New();
 
   // allocate local QEM space matrix
@@ -708,70 +916,8 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
         input->GetPoint(pts[(i + 2) % 3], t0);
         input->GetPoint(pts[i], t1);
         input->GetPoint(pts[(i + 1) % 3], t2);
-
-        // computing a plane which is orthogonal to line t1, t2 and incident
-        // with it
-        for (j = 0; j < 3; j++)
-        {
-          e0[j] = t2[j] - t1[j];
-        }
-        for (j = 0; j < 3; j++)
-        {
-          e1[j] = t0[j] - t1[j];
-        }
-
-        // compute n so that it is orthogonal to e0 and parallel to the
-        // triangle
-        c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
-        for (j = 0; j < 3; j++)
-        {
-          n[j] = e1[j] - c * e0[j];
-        }
-        vtkMath::Normalize(n);
-
-#if defined(_MSC_VER) && _MSC_VER >= 1929
-        // Visual Studio toolset starting at toolset 14.29.30133, when building in Release mode
-        // incorrectly optimizes away the line
-        //    QEM[9] = d * d;
-        // By making volatile, we are telling the compiler not to optimize out
-        // or reorder operations regarding this variable.
-        volatile
-#endif
-          double d = -vtkMath::Dot(n, t1);
-        // The above line might merit some review: The same quadric gets added to t1 and t2 and one
-        // might prefer adding a quadric calculated using t1 at t1 and using t2 at t2
-        w = vtkMath::Norm(e0);
-
-        if (!this->WeighBoundaryConstraintsByLength)
-        {
-          /*
-           * The argument for using area instead of length is based on homogeneity here: The quadric
-           * field is already weighted by triangle area. It makes sense weighting the boundary
-           * constraints by area instead of length. Length technically has zero measure in terms of
-           * units of area. The squared version also seems to give more coherent results at the
-           * boundary.
-           */
-          w *= w;
-        }
-        w *= this->BoundaryWeightFactor;
-
-        // could possible add in
-        // angle weights??
-        QEM[0] = n[0] * n[0];
-        QEM[1] = n[0] * n[1];
-        QEM[2] = n[0] * n[2];
-        QEM[3] = d * n[0];
-
-        QEM[4] = n[1] * n[1];
-        QEM[5] = n[1] * n[2];
-        QEM[6] = d * n[1];
-
-        QEM[7] = n[2] * n[2];
-        QEM[8] = d * n[2];
-
-        QEM[9] = d * d;
-
-        QEM[10] = 1;
+        w = ComputeBoundaryQuadric(
+          t0, t1, t2, this->WeighBoundaryConstraintsByLength, this->BoundaryWeightFactor, QEM);
 
         // need to add orthogonal plane with the other Attributes, but this
         // is not clear??
@@ -933,15 +1079,8 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 {
-  static const double errorNumber = 1e-10;
-  double temp[3], A[3][3], b[3];
   vtkIdType pointIds[2];
-  double cost = 0.0;
-  double* index;
-  int i, j;
-  double newPoint[4];
-  double v[3], c, norm, normTemp, temp2[3];
-  double pt1[3], pt2[3];
+  int i;
 
   pointIds[0] = this->EndPoint1List->GetId(edgeId);
   pointIds[1] = this->EndPoint2List->GetId(edgeId);
@@ -952,78 +1091,7 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
-
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
-
-  norm = vtkMath::Norm(A[0]);
-  normTemp = vtkMath::Norm(A[1]);
-  norm = norm > normTemp ? norm : normTemp;
-  normTemp = vtkMath::Norm(A[2]);
-  norm = norm > normTemp ? norm : normTemp;
-
-  if (fabs(vtkMath::Determinant3x3(A)) / (norm * norm * norm) > errorNumber)
-  {
-    // it would be better to use the normal of the matrix to test singularity??
-    vtkMath::LinearSolve3x3(A, b, x);
-  }
-  else
-  {
-    // cheapest point along the edge
-    this->Mesh->GetPoints()->GetPoint(pointIds[0], pt1);
-    this->Mesh->GetPoints()->GetPoint(pointIds[1], pt2);
-    v[0] = pt2[0] - pt1[0];
-    v[1] = pt2[1] - pt1[1];
-    v[2] = pt2[2] - pt1[2];
-
-    // equation for the edge pt1 + c * v
-    // attempt least squares fit for c for A*(pt1 + c * v) = b
-    vtkMath::Multiply3x3(A, v, temp2);
-    if (vtkMath::Dot(temp2, temp2) > errorNumber)
-    {
-      vtkMath::Multiply3x3(A, pt1, temp);
-      for (i = 0; i < 3; i++)
-        temp[i] = b[i] - temp[i];
-      c = vtkMath::Dot(temp2, temp) / vtkMath::Dot(temp2, temp2);
-      for (i = 0; i < 3; i++)
-        x[i] = pt1[i] + c * v[i];
-    }
-    else
-    {
-      // use mid point
-      // might want to change to best of mid and end points??
-      for (i = 0; i < 3; i++)
-      {
-        x[i] = 0.5 * (pt1[i] + pt2[i]);
-      }
-    }
-  }
-
-  newPoint[0] = x[0];
-  newPoint[1] = x[1];
-  newPoint[2] = x[2];
-  newPoint[3] = 1;
-
-  // Compute the cost
-  // x'*quad*x
-  index = this->TempQuad;
-  for (i = 0; i < 4; i++)
-  {
-    cost += (*index++) * newPoint[i] * newPoint[i];
-    for (j = i + 1; j < 4; j++)
-    {
-      cost += 2.0 * (*index++) * newPoint[i] * newPoint[j];
-    }
-  }
-
-  return cost;
+  return ComputeGeometricCost(this->TempQuad, this->Mesh->GetPoints(), pointIds[0], pointIds[1], x);
 }
 
 //------------------------------------------------------------------------------
@@ -1273,16 +1341,22 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
 }
 
 int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
+{
+  return this->CollapseEdge(pt0Id, pt1Id, this->CollapseCellIds);
+}
+
+//------------------------------------------------------------------------------
+int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id, vtkIdList* cellIds)
 {
   int j, numDeleted = 0;
   vtkIdType i, cellId;
   vtkIdType npts;
   const vtkIdType* pts;
 
-  this->Mesh->GetPointCells(pt0Id, this->CollapseCellIds);
-  for (i = 0; i < this->CollapseCellIds->GetNumberOfIds(); i++)
+  this->Mesh->GetPointCells(pt0Id, cellIds);
+  for (i = 0; i < cellIds->GetNumberOfIds(); i++)
   {
-    cellId = this->CollapseCellIds->GetId(i);
+    cellId = cellIds->GetId(i);
     this->Mesh->GetCellPoints(cellId, npts, pts);
     for (j = 0; j < 3; j++)
     {
@@ -1295,11 +1369,11 @@ int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
     }
   }
 
-  this->Mesh->GetPointCells(pt1Id, this->CollapseCellIds);
-  this->Mesh->ResizeCellList(pt0Id, this->CollapseCellIds->GetNumberOfIds());
-  for (i = 0; i < this->CollapseCellIds->GetNumberOfIds(); i++)
+  this->Mesh->GetPointCells(pt1Id, cellIds);
+  this->Mesh->ResizeCellList(pt0Id, cellIds->GetNumberOfIds());
+  for (i = 0; i < cellIds->GetNumberOfIds(); i++)
   {
-    cellId = this->CollapseCellIds->GetId(i);
+    cellId = cellIds->GetId(i);
     this->Mesh->GetCellPoints(cellId, npts, pts);
     // making sure we don't already have the triangle we're about to
     // change this one to
@@ -1322,6 +1396,308 @@ int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
   return numDeleted;
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkQuadricDecimation::CollapseEdgesInParallel(vtkIdType numTris)
+{
+  vtkPolyData* mesh = this->Mesh;
+  vtkPoints* points = mesh->GetPoints();
+  const vtkIdType numPts = mesh->GetNumberOfPoints();
+  const double regularizationVariance =
+    this->Regularize ? std::pow(this->Regularization, 2) : 0.0;
+
+  // GetPointCells() and GetCellPoints() are thread safe now that the cells and
+  // the links of the mesh are built.
+  vtkSMPThreadLocalObject<vtkIdList> localCellIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localPtIds;
+
+  // Each point gathers the quadrics of its triangles, then the constraints of
+  // its boundary edges, in the order in which InitializeQuadrics() and
+  // AddBoundaryConstraints() scatter them.
+  vtkDebugMacro(<< "Computing Quadrics");
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* neighbors = localCellIds.Local();
+    double QEM[11], n[3], d, t0[3], t1[3], t2[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      double* quadric = this->ErrorQuadrics[ptId].Quadric = new double[11];
+      std::fill(quadric, quadric + 11, 0.0);
+      vtkIdType ncells, npts;
+      vtkIdType* cells;
+      const vtkIdType* pts;
+      mesh->GetPointCells(ptId, ncells, cells);
+      for (vtkIdType i = 0; i < ncells; ++i)
+      {
+        mesh->GetCellPoints(cells[i], npts, pts);
+        points->GetPoint(pts[0], t0);
+        points->GetPoint(pts[1], t1);
+        points->GetPoint(pts[2], t2);
+        const double triArea2 =
+          ComputeTriangleQuadric(t0, t1, t2, this->Regularize, regularizationVariance, QEM, n, d);
+        for (int j = 0; j < 11; ++j)
+        {
+          quadric[j] += QEM[j] * triArea2;
+        }
+      }
+      for (vtkIdType i = 0; i < ncells; ++i)
+      {
+        mesh->GetCellPoints(cells[i], npts, pts);
+        for (int k = 0; k < 3; ++k)
+        {
+          if (pts[k] != ptId && pts[(k + 1) % 3] != ptId)
+          {
+            continue;
+          }
+          mesh->GetCellEdgeNeighbors(cells[i], pts[k], pts[(k + 1) % 3], neighbors);
+          if (neighbors->GetNumberOfIds() == 0)
+          {
+            // this is a boundary
+            points->GetPoint(pts[(k + 2) % 3], t0);
+            points->GetPoint(pts[k], t1);
+            points->GetPoint(pts[(k + 1) % 3], t2);
+            const double w = ComputeBoundaryQuadric(t0, t1, t2,
+              this->WeighBoundaryConstraintsByLength, this->BoundaryWeightFactor, QEM);
+            for (int j = 0; j < 11; ++j)
+            {
+              quadric[j] += QEM[j] * w;
+            }
+          }
+        }
+      }
+    }
+  });
+  this->UpdateProgress(0.15);
+
+  // The edges of a point are the ones to its neighbors of larger ids, sorted.
+  auto gatherEdges = [mesh](vtkIdType ptId, std::vector<vtkIdType>& edgeEnds) {
+    vtkIdType ncells, npts;
+    vtkIdType* cells;
+    const vtkIdType* pts;
+    edgeEnds.clear();
+    mesh->GetPointCells(ptId, ncells, cells);
+    for (vtkIdType i = 0; i < ncells; ++i)
+    {
+      mesh->GetCellPoints(cells[i], npts, pts);
+      for (vtkIdType k = 0; k < npts; ++k)
+      {
+        if (pts[k] > ptId)
+        {
+          edgeEnds.push_back(pts[k]);
+        }
+      }
+    }
+    std::sort(edgeEnds.begin(), edgeEnds.end());
+    edgeEnds.erase(std::unique(edgeEnds.begin(), edgeEnds.end()), edgeEnds.end());
+  };
+
+  // A collapse moves its two end points and the edges of their triangles:
+  // collapses whose regions are disjoint do not interfere.
+  auto gatherRegion = [mesh](vtkIdType pt0Id, vtkIdType pt1Id, std::vector<vtkIdType>& region) {
+    vtkIdType ncells, npts;
+    vtkIdType* cells;
+    const vtkIdType* pts;
+    region.clear();
+    for (vtkIdType ptId : { pt0Id, pt1Id })
+    {
+      region.push_back(ptId);
+      mesh->GetPointCells(ptId, ncells, cells);
+      for (vtkIdType i = 0; i < ncells; ++i)
+      {
+        mesh->GetCellPoints(cells[i], npts, pts);
+        region.insert(region.end(), pts, pts + npts);
+      }
+    }
+  };
+
+  // The edges of each point start at EdgeOffsets[ptId]. The costs of the
+  // edges whose end points did not change in the previous round are kept.
+  std::vector<vtkIdType> edgeOffsets, edgeEnds, prevEdgeOffsets, prevEdgeEnds;
+  std::vector<double> edgeCosts, prevEdgeCosts, finiteCosts;
+  std::vector<unsigned char> selected;
+  std::vector<int> lastChanges(numPts, -1);
+  std::vector<std::atomic<vtkIdType>> claims(numPts);
+
+  vtkIdType numDeletedTris = 0;
+  for (int round = 0; this->ActualReduction < this->TargetReduction; ++round)
+  {
+    this->UpdateProgress(0.20 + 0.80 * this->ActualReduction / this->TargetReduction);
+    if (this->CheckAbort())
+    {
+      break;
+    }
+
+    std::swap(edgeOffsets, prevEdgeOffsets);
+    std::swap(edgeEnds, prevEdgeEnds);
+    std::swap(edgeCosts, prevEdgeCosts);
+    edgeOffsets.assign(numPts + 1, 0);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<vtkIdType>& ends = localPtIds.Local();
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        gatherEdges(ptId, ends);
+        edgeOffsets[ptId + 1] = static_cast<vtkIdType>(ends.size());
+      }
+    });
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      edgeOffsets[ptId + 1] += edgeOffsets[ptId];
+    }
+    const vtkIdType numEdges = edgeOffsets[numPts];
+    edgeEnds.resize(numEdges);
+    edgeCosts.resize(numEdges);
+
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<vtkIdType>& ends = localPtIds.Local();
+      double quad[11], x[3];
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        gatherEdges(ptId, ends);
+        const bool unchanged = round > 0 && lastChanges[ptId] != round - 1;
+        const auto prevBegin = unchanged ? prevEdgeEnds.begin() + prevEdgeOffsets[ptId]
+                                         : prevEdgeEnds.end();
+        const auto prevEnd =
+          unchanged ? prevEdgeEnds.begin() + prevEdgeOffsets[ptId + 1] : prevEdgeEnds.end();
+        for (std::size_t k = 0; k < ends.size(); ++k)
+        {
+          const vtkIdType edgeId = edgeOffsets[ptId] + k;
+          const vtkIdType pt1Id = ends[k];
+          edgeEnds[edgeId] = pt1Id;
+          if (unchanged && lastChanges[pt1Id] != round - 1)
+          {
+            const auto prev = std::lower_bound(prevBegin, prevEnd, pt1Id);
+            if (prev != prevEnd && *prev == pt1Id)
+            {
+              edgeCosts[edgeId] = prevEdgeCosts[prev - prevEdgeEnds.begin()];
+              continue;
+            }
+          }
+          for (int j = 0; j < 11; ++j)
+          {
+            quad[j] = this->ErrorQuadrics[ptId].Quadric[j] + this->ErrorQuadrics[pt1Id].Quadric[j];
+          }
+          edgeCosts[edgeId] = ComputeGeometricCost(quad, points, ptId, pt1Id, x);
+        }
+      }
+    });
+
+    // The candidates of the round are the cheapest edges, as many as the
+    // collapses still needed, each collapse deleting about two triangles.
+    finiteCosts.clear();
+    for (double cost : edgeCosts)
+    {
+      if (cost < VTK_DOUBLE_MAX)
+      {
+        finiteCosts.push_back(cost);
+      }
+    }
+    if (finiteCosts.empty())
+    {
+      break;
+    }
+    const vtkIdType numNeeded = static_cast<vtkIdType>(
+      std::ceil(0.5 * (this->TargetReduction * numTris - numDeletedTris)));
+    const vtkIdType numCandidates = std::max<vtkIdType>(
+      1, std::min<vtkIdType>(numNeeded, static_cast<vtkIdType>(finiteCosts.size())));
+    std::nth_element(
+      finiteCosts.begin(), finiteCosts.begin() + numCandidates - 1, finiteCosts.end());
+    const double threshold = finiteCosts[numCandidates - 1];
+
+    // Each candidate claims the points of its region, the cheapest candidate
+    // winning, in the order of the priority queue. The candidates that win
+    // their whole region are collapsed.
+    auto precedes = [&edgeCosts](vtkIdType edge0, vtkIdType edge1) {
+      return edgeCosts[edge0] < edgeCosts[edge1] ||
+        (edgeCosts[edge0] == edgeCosts[edge1] && edge0 < edge1);
+    };
+    vtkSMPTools::Fill(claims.begin(), claims.end(), -1);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<vtkIdType>& region = localPtIds.Local();
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        for (vtkIdType edgeId = edgeOffsets[ptId]; edgeId < edgeOffsets[ptId + 1]; ++edgeId)
+        {
+          if (edgeCosts[edgeId] > threshold)
+          {
+            continue;
+          }
+          gatherRegion(ptId, edgeEnds[edgeId], region);
+          for (vtkIdType regionPtId : region)
+          {
+            vtkIdType claim = claims[regionPtId].load(std::memory_order_relaxed);
+            while ((claim < 0 || precedes(edgeId, claim)) &&
+              !claims[regionPtId].compare_exchange_weak(claim, edgeId, std::memory_order_relaxed))
+            {
+            }
+          }
+        }
+      }
+    });
+    selected.assign(numEdges, 0);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<vtkIdType>& region = localPtIds.Local();
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        for (vtkIdType edgeId = edgeOffsets[ptId]; edgeId < edgeOffsets[ptId + 1]; ++edgeId)
+        {
+          if (edgeCosts[edgeId] > threshold)
+          {
+            continue;
+          }
+          gatherRegion(ptId, edgeEnds[edgeId], region);
+          selected[edgeId] = std::all_of(region.begin(), region.end(), [&](vtkIdType regionPtId) {
+            return claims[regionPtId].load(std::memory_order_relaxed) == edgeId;
+          });
+        }
+      }
+    });
+
+    // Collapse the selected edges concurrently. An edge with a poorly placed
+    // point gets the max cost until one of its end points changes.
+    std::atomic<vtkIdType> roundDeletedTris(0);
+    std::atomic<int> roundCollapses(0);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* cellIds = localCellIds.Local();
+      double quad[11], x[3];
+      vtkIdType deletedTris = 0;
+      int collapses = 0;
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        for (vtkIdType edgeId = edgeOffsets[ptId]; edgeId < edgeOffsets[ptId + 1]; ++edgeId)
+        {
+          if (!selected[edgeId])
+          {
+            continue;
+          }
+          vtkIdType endPtIds[2] = { ptId, edgeEnds[edgeId] };
+          for (int j = 0; j < 11; ++j)
+          {
+            quad[j] = this->ErrorQuadrics[endPtIds[0]].Quadric[j] +
+              this->ErrorQuadrics[endPtIds[1]].Quadric[j];
+          }
+          ComputeGeometricCost(quad, points, endPtIds[0], endPtIds[1], x);
+          if (!this->IsGoodPlacement(endPtIds[0], endPtIds[1], x))
+          {
+            edgeCosts[edgeId] = VTK_DOUBLE_MAX;
+            continue;
+          }
+          this->SetPointAttributeArray(endPtIds, x);
+          this->AddQuadric(endPtIds[1], endPtIds[0]);
+          deletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1], cellIds);
+          lastChanges[endPtIds[0]] = round;
+          ++collapses;
+        }
+      }
+      roundDeletedTris += deletedTris;
+      roundCollapses += collapses;
+    });
+
+    numDeletedTris += roundDeletedTris;
+    this->NumberOfEdgeCollapses += roundCollapses;
+    this->ActualReduction = (double)numDeletedTris / numTris;
+  }
+
+  return numDeletedTris;
+}
+
 // triangle t0, t1, t2 and point x
 // determines if t0 and x are on the same side of the plane defined by
 // t1 and t2, and parallel to the normal of the triangle
@@ -1548,5 +1924,6 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
   os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
   os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+  os << indent << "Parallel Collapses: " << (this->ParallelCollapses ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
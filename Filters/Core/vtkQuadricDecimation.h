@@ -144,6 +144,23 @@ public:
   vtkBooleanMacro(MapPointData, bool);
   ///@}
 
+  ///@{
+  /**
+   * Collapse the edges in rounds of independent collapses instead of one at a
+   * time from a priority queue. Each round considers the cheapest edges, as
+   * many as the collapses still needed to reach TargetReduction, and keeps the
+   * ones whose 1-rings do not overlap the 1-rings of cheaper edges. These
+   * collapses do not interfere and are applied concurrently with vtkSMPTools,
+   * as are the computation of the quadrics and of the costs. The output is
+   * close to, but not the same as, the serial one. Only the geometric error
+   * metric is threaded: this option is ignored when AttributeErrorMetric is
+   * on. Off by default.
+   */
+  vtkSetMacro(ParallelCollapses, bool);
+  vtkGetMacro(ParallelCollapses, bool);
+  vtkBooleanMacro(ParallelCollapses, bool);
+  ///@}
+
   ///@{
   /**
    * If attribute errors are to be included in the metric (i.e.,
@@ -205,6 +222,13 @@ protected:
    * triangles deleted.
    */
   int CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id);
+  int CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id, vtkIdList* cellIds);
+
+  /**
+   * Decimate the mesh with rounds of concurrent edge collapses, see
+   * ParallelCollapses; return the number of triangles deleted.
+   */
+  vtkIdType CollapseEdgesInParallel(vtkIdType numTris);
 
   /**
    * Compute quadric for all vertices
@@ -279,6 +303,7 @@ protected:
   vtkTypeBool VolumePreservation;
 
   bool MapPointData = false;
+  bool ParallelCollapses = false;
 
   vtkTypeBool ScalarsAttribute;
   vtkTypeBool VectorsAttribute;
@@ -0,0 +1,768 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkReorderPointsAndCells.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIndexedArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinksTemplate.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkReorderPointsAndCells);
+
+namespace
+{
+using SortKey = std::pair<uint64_t, vtkIdType>;
+
+//------------------------------------------------------------------------------
+// Spread the 21 lower bits of v so that they occupy every third bit.
+inline uint64_t SpreadBits(uint64_t v)
+{
+  v &= 0x1fffff;
+  v = (v | (v << 32)) & 0x1f00000000ffffULL;
+  v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+  v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+  v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+  v = (v | (v << 2)) & 0x1249249249249249ULL;
+  return v;
+}
+
+//------------------------------------------------------------------------------
+// Map positions to their index along a Morton or a Hilbert curve going
+// through a grid of 2^21 cells along each axis of the bounds. The Hilbert
+// index uses the transform of J. Skilling ("Programming the Hilbert curve",
+// AIP Conference Proceedings 707, 2004), after which the interleaved bits of
+// the coordinates give the index.
+class CurveEncoder
+{
+public:
+  CurveEncoder(const double bounds[6], bool hilbert)
+    : Hilbert(hilbert)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      const double length = bounds[2 * i + 1] - bounds[2 * i];
+      this->Origin[i] = bounds[2 * i];
+      this->Scale[i] = length > 0.0 ? 2097151.0 / length : 0.0;
+    }
+  }
+
+  uint64_t operator()(const double x[3]) const
+  {
+    uint32_t X[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      const double v = (x[i] - this->Origin[i]) * this->Scale[i];
+      X[i] = static_cast<uint32_t>(vtkMath::ClampValue(v, 0.0, 2097151.0));
+    }
+    if (this->Hilbert)
+    {
+      for (uint32_t Q = 1u << 20; Q > 1; Q >>= 1)
+      {
+        const uint32_t P = Q - 1;
+        for (int i = 0; i < 3; ++i)
+        {
+          if (X[i] & Q)
+          {
+            X[0] ^= P;
+          }
+          else
+          {
+            const uint32_t t = (X[0] ^ X[i]) & P;
+            X[0] ^= t;
+            X[i] ^= t;
+          }
+        }
+      }
+      X[1] ^= X[0];
+      X[2] ^= X[1];
+      uint32_t t = 0;
+      for (uint32_t Q = 1u << 20; Q > 1; Q >>= 1)
+      {
+        if (X[2] & Q)
+        {
+          t ^= Q - 1;
+        }
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        X[i] ^= t;
+      }
+    }
+    return (SpreadBits(X[0]) << 2) | (SpreadBits(X[1]) << 1) | SpreadBits(X[2]);
+  }
+
+private:
+  double Origin[3];
+  double Scale[3];
+  bool Hilbert;
+};
+
+//------------------------------------------------------------------------------
+// Sort the keys and write the ids in the sorted order. Equal keys are
+// ordered by id, so that the order does not depend on the number of threads.
+void SortIds(std::vector<SortKey>& keys, vtkIdType* order)
+{
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(keys.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      order[i] = keys[i].second;
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// Order the points along the curve.
+std::vector<vtkIdType> CurvePointOrder(vtkPoints* points, const CurveEncoder& encoder)
+{
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  std::vector<SortKey> keys(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      points->GetPoint(ptId, x);
+      keys[ptId] = std::make_pair(encoder(x), ptId);
+    }
+  });
+  std::vector<vtkIdType> order(numPts);
+  SortIds(keys, order.data());
+  return order;
+}
+
+//------------------------------------------------------------------------------
+// Order the cells of a cell array by the key computed from their points by
+// cellKey(npts, pts), writing their ids shifted by offset.
+template <typename CellKey>
+void SortCells(vtkCellArray* cells, const CellKey& cellKey, vtkIdType offset, vtkIdType* order)
+{
+  const vtkIdType numCells = cells->GetNumberOfCells();
+  std::vector<SortKey> keys(numCells);
+  vtkSMPThreadLocalObject<vtkIdList> tlIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ids = tlIds.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      cells->GetCellAtId(cellId, npts, pts, ids);
+      keys[cellId] = std::make_pair(cellKey(npts, pts), offset + cellId);
+    }
+  });
+  SortIds(keys, order);
+}
+
+//------------------------------------------------------------------------------
+// The graph of the points sharing a cell, stored in compressed rows.
+struct PointGraph
+{
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Neighbors;
+
+  vtkIdType GetDegree(vtkIdType ptId) const
+  {
+    return this->Offsets[ptId + 1] - this->Offsets[ptId];
+  }
+  const vtkIdType* GetNeighbors(vtkIdType ptId) const
+  {
+    return this->Neighbors.data() + this->Offsets[ptId];
+  }
+};
+
+//------------------------------------------------------------------------------
+// Build the graph from the cell links of the input, threaded over the points.
+void BuildPointGraph(vtkPointSet* input, PointGraph& graph)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkStaticCellLinksTemplate<vtkIdType> links;
+  links.BuildLinks(input);
+
+  // make the input API threadsafe by calling it once in a single thread.
+  vtkIdType npts;
+  const vtkIdType* pts;
+  if (input->GetNumberOfCells() > 0)
+  {
+    vtkNew<vtkIdList> ids;
+    input->GetCellPoints(0, npts, pts, ids);
+  }
+
+  vtkSMPThreadLocalObject<vtkIdList> tlIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlNeighbors;
+  auto gatherNeighbors = [&](vtkIdType ptId, vtkIdList* ids, std::vector<vtkIdType>& neighbors) {
+    neighbors.clear();
+    const vtkIdType numCells = links.GetNcells(ptId);
+    const vtkIdType* cells = links.GetCells(ptId);
+    for (vtkIdType i = 0; i < numCells; ++i)
+    {
+      vtkIdType numCellPts;
+      const vtkIdType* cellPts;
+      input->GetCellPoints(cells[i], numCellPts, cellPts, ids);
+      for (vtkIdType j = 0; j < numCellPts; ++j)
+      {
+        if (cellPts[j] != ptId)
+        {
+          neighbors.push_back(cellPts[j]);
+        }
+      }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+  };
+
+  graph.Offsets.assign(numPts + 1, 0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ids = tlIds.Local();
+    std::vector<vtkIdType>& neighbors = tlNeighbors.Local();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      gatherNeighbors(ptId, ids, neighbors);
+      graph.Offsets[ptId + 1] = static_cast<vtkIdType>(neighbors.size());
+    }
+  });
+  std::partial_sum(graph.Offsets.begin(), graph.Offsets.end(), graph.Offsets.begin());
+
+  graph.Neighbors.resize(graph.Offsets[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ids = tlIds.Local();
+    std::vector<vtkIdType>& neighbors = tlNeighbors.Local();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      gatherNeighbors(ptId, ids, neighbors);
+      std::copy(neighbors.begin(), neighbors.end(), graph.Neighbors.begin() + graph.Offsets[ptId]);
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// Visit the connected component of root breadth first, marking its points
+// with stamp and adding them to queue. Return the number of levels below
+// root, and in lastLevel the position of the first point of the last level
+// in queue.
+int BreadthFirst(const PointGraph& graph, vtkIdType root, vtkIdType stamp,
+  std::vector<vtkIdType>& mark, std::vector<vtkIdType>& queue, std::size_t& lastLevel)
+{
+  queue.clear();
+  queue.push_back(root);
+  mark[root] = stamp;
+  std::size_t levelBegin = 0;
+  for (int depth = 0;; ++depth)
+  {
+    const std::size_t levelEnd = queue.size();
+    for (std::size_t i = levelBegin; i < levelEnd; ++i)
+    {
+      const vtkIdType ptId = queue[i];
+      const vtkIdType* neighbors = graph.GetNeighbors(ptId);
+      for (vtkIdType j = 0; j < graph.GetDegree(ptId); ++j)
+      {
+        if (mark[neighbors[j]] != stamp)
+        {
+          mark[neighbors[j]] = stamp;
+          queue.push_back(neighbors[j]);
+        }
+      }
+    }
+    if (queue.size() == levelEnd)
+    {
+      lastLevel = levelBegin;
+      return depth;
+    }
+    levelBegin = levelEnd;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Find a pseudo-peripheral point of the component of seed with the algorithm
+// of Gibbs, Poole and Stockmeyer as modified by George and Liu: restart from
+// the point of smallest degree of the last level while the depth increases.
+vtkIdType FindPseudoPeripheralPoint(const PointGraph& graph, vtkIdType seed, vtkIdType& stamp,
+  std::vector<vtkIdType>& mark, std::vector<vtkIdType>& queue)
+{
+  std::size_t lastLevel;
+  vtkIdType root = seed;
+  int depth = BreadthFirst(graph, root, ++stamp, mark, queue, lastLevel);
+  for (;;)
+  {
+    vtkIdType candidate = queue[lastLevel];
+    for (std::size_t i = lastLevel + 1; i < queue.size(); ++i)
+    {
+      if (graph.GetDegree(queue[i]) < graph.GetDegree(candidate))
+      {
+        candidate = queue[i];
+      }
+    }
+    const int candidateDepth = BreadthFirst(graph, candidate, ++stamp, mark, queue, lastLevel);
+    if (candidateDepth <= depth)
+    {
+      return root;
+    }
+    root = candidate;
+    depth = candidateDepth;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Order the points with the reverse Cuthill-McKee algorithm: each connected
+// component is visited breadth first from a pseudo-peripheral point, adding
+// the unvisited neighbors of each point by increasing degree, and the
+// resulting order is reversed.
+std::vector<vtkIdType> ReverseCuthillMcKeeOrder(const PointGraph& graph, vtkIdType numPts)
+{
+  std::vector<vtkIdType> order;
+  order.reserve(numPts);
+  std::vector<char> visited(numPts, 0);
+  std::vector<vtkIdType> mark(numPts, 0);
+  std::vector<vtkIdType> queue;
+  vtkIdType stamp = 0;
+  auto byDegree = [&graph](vtkIdType a, vtkIdType b) {
+    const vtkIdType degreeA = graph.GetDegree(a);
+    const vtkIdType degreeB = graph.GetDegree(b);
+    return degreeA < degreeB || (degreeA == degreeB && a < b);
+  };
+
+  for (vtkIdType seed = 0; seed < numPts; ++seed)
+  {
+    if (visited[seed])
+    {
+      continue;
+    }
+    const vtkIdType root = FindPseudoPeripheralPoint(graph, seed, stamp, mark, queue);
+    std::size_t head = order.size();
+    order.push_back(root);
+    visited[root] = 1;
+    while (head < order.size())
+    {
+      const vtkIdType ptId = order[head++];
+      const std::size_t first = order.size();
+      const vtkIdType* neighbors = graph.GetNeighbors(ptId);
+      for (vtkIdType j = 0; j < graph.GetDegree(ptId); ++j)
+      {
+        if (!visited[neighbors[j]])
+        {
+          visited[neighbors[j]] = 1;
+          order.push_back(neighbors[j]);
+        }
+      }
+      std::sort(order.begin() + first, order.end(), byDegree);
+    }
+  }
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+//------------------------------------------------------------------------------
+// Create the cell array made of the cells of order, shifted by offset (or of
+// all the cells in their order if order is nullptr), with their point ids
+// mapped through pointMap if it is not nullptr.
+vtkSmartPointer<vtkCellArray> PermuteCells(
+  vtkCellArray* cells, const vtkIdType* order, vtkIdType offset, const vtkIdType* pointMap)
+{
+  const vtkIdType numCells = cells->GetNumberOfCells();
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numCells + 1);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  offsetsPtr[0] = 0;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      offsetsPtr[cellId + 1] = cells->GetCellSize(order ? order[cellId] - offset : cellId);
+    }
+  });
+  std::partial_sum(offsetsPtr, offsetsPtr + numCells + 1, offsetsPtr);
+
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(offsetsPtr[numCells]);
+  vtkIdType* connectivityPtr = connectivity->GetPointer(0);
+  vtkSMPThreadLocalObject<vtkIdList> tlIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ids = tlIds.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      cells->GetCellAtId(order ? order[cellId] - offset : cellId, npts, pts, ids);
+      vtkIdType* outPts = connectivityPtr + offsetsPtr[cellId];
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        outPts[i] = pointMap ? pointMap[pts[i]] : pts[i];
+      }
+    }
+  });
+
+  auto result = vtkSmartPointer<vtkCellArray>::New();
+  result->SetData(offsets, connectivity);
+  result->ConvertToPreferredStorage();
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Copy the tuples of the arrays in the order given and add the original ids.
+void PermuteAttributes(ArrayList& arrays, const std::vector<vtkIdType>& order,
+  vtkDataSetAttributes* outData, const char* originalIdsName)
+{
+  const vtkIdType numTuples = static_cast<vtkIdType>(order.size());
+  vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      arrays.Copy(order[i], i);
+    }
+  });
+
+  if (originalIdsName)
+  {
+    vtkNew<vtkIdTypeArray> originalIds;
+    originalIds->SetName(originalIdsName);
+    originalIds->SetNumberOfValues(numTuples);
+    std::copy(order.begin(), order.end(), originalIds->GetPointer(0));
+    outData->AddArray(originalIds);
+  }
+}
+
+//------------------------------------------------------------------------------
+struct IndexedArrayWorker
+{
+  template <typename ArrayType>
+  void operator()(
+    ArrayType* array, vtkIdTypeArray* indexes, vtkSmartPointer<vtkDataArray>& result) const
+  {
+    using ValueType = vtk::GetAPIType<ArrayType>;
+    vtkNew<vtkIndexedArray<ValueType>> indexedArray;
+    indexedArray->SetName(array->GetName());
+    indexedArray->SetBackend(
+      std::make_shared<vtkIndexedImplicitBackend<ValueType>>(indexes, array));
+    indexedArray->SetNumberOfComponents(array->GetNumberOfComponents());
+    indexedArray->SetNumberOfTuples(indexes->GetNumberOfTuples());
+    result = indexedArray;
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> NewIndexedArray(vtkDataArray* array, vtkIdTypeArray* indexes)
+{
+  using Dispatcher = vtkArrayDispatch::DispatchByValueType<vtkArrayDispatch::AllTypes>;
+  IndexedArrayWorker worker;
+  vtkSmartPointer<vtkDataArray> result;
+  if (!Dispatcher::Execute(array, worker, indexes, result))
+  {
+    worker(array, indexes, result); // fallback
+  }
+  return result;
+}
+}
+
+//------------------------------------------------------------------------------
+vtkReorderPointsAndCells::vtkReorderPointsAndCells()
+{
+  this->OrderingMode = HILBERT;
+  this->ReorderPoints = true;
+  this->ReorderCells = true;
+  this->GenerateOriginalIds = true;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> vtkReorderPointsAndCells::GetArrayInInputOrder(
+  vtkDataArray* array, vtkIdTypeArray* originalIds)
+{
+  if (!array || !originalIds || array->GetNumberOfTuples() != originalIds->GetNumberOfTuples())
+  {
+    return nullptr;
+  }
+
+  // The inverse of the permutation gives the output id of each input id.
+  const vtkIdType numTuples = originalIds->GetNumberOfTuples();
+  vtkNew<vtkIdTypeArray> outputIds;
+  outputIds->SetNumberOfValues(numTuples);
+  const vtkIdType* originalIdsPtr = originalIds->GetPointer(0);
+  vtkIdType* outputIdsPtr = outputIds->GetPointer(0);
+  vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      outputIdsPtr[originalIdsPtr[i]] = i;
+    }
+  });
+  return ::NewIndexedArray(array, outputIds);
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> vtkReorderPointsAndCells::GetArrayInOutputOrder(
+  vtkDataArray* array, vtkIdTypeArray* originalIds)
+{
+  if (!array || !originalIds)
+  {
+    return nullptr;
+  }
+  return ::NewIndexedArray(array, originalIds);
+}
+
+//------------------------------------------------------------------------------
+int vtkReorderPointsAndCells::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPointSet* input = vtkPointSet::GetData(inputVector[0]);
+  vtkPointSet* output = vtkPointSet::GetData(outputVector);
+  vtkUnstructuredGrid* inGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  vtkPolyData* inPolyData = vtkPolyData::SafeDownCast(input);
+  if (!inGrid && !inPolyData)
+  {
+    vtkErrorMacro("The input must be a vtkUnstructuredGrid or a vtkPolyData.");
+    return 0;
+  }
+
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  if (!inPts || numPts == 0 || (!this->ReorderPoints && !this->ReorderCells))
+  {
+    output->ShallowCopy(input);
+    return 1;
+  }
+
+  // The cell arrays, in the order of the cell ids.
+  std::vector<vtkCellArray*> cellArrays;
+  if (inGrid)
+  {
+    cellArrays.push_back(inGrid->GetCells());
+  }
+  else
+  {
+    cellArrays = { inPolyData->GetVerts(), inPolyData->GetLines(), inPolyData->GetPolys(),
+      inPolyData->GetStrips() };
+  }
+
+  // Order the points, keeping the rank of each input point in the order.
+  const bool rcm = this->OrderingMode == REVERSE_CUTHILL_MCKEE;
+  const CurveEncoder encoder(input->GetBounds(), this->OrderingMode == HILBERT);
+  std::vector<vtkIdType> pointOrder;
+  std::vector<vtkIdType> pointRank;
+  if (this->ReorderPoints || rcm)
+  {
+    if (rcm)
+    {
+      PointGraph graph;
+      ::BuildPointGraph(input, graph);
+      pointOrder = ::ReverseCuthillMcKeeOrder(graph, numPts);
+    }
+    else
+    {
+      pointOrder = ::CurvePointOrder(inPts, encoder);
+    }
+    pointRank.resize(numPts);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        pointRank[pointOrder[i]] = i;
+      }
+    });
+  }
+  this->UpdateProgress(0.4);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Order the cells within each cell array: by the curve index of their
+  // centroid, or by the smallest rank of their points.
+  std::vector<vtkIdType> cellOrder;
+  if (this->ReorderCells)
+  {
+    cellOrder.resize(numCells);
+    vtkIdType offset = 0;
+    for (vtkCellArray* cells : cellArrays)
+    {
+      if (rcm)
+      {
+        auto cellKey = [&pointRank](vtkIdType npts, const vtkIdType* pts) {
+          uint64_t key = std::numeric_limits<uint64_t>::max();
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            key = std::min(key, static_cast<uint64_t>(pointRank[pts[i]]));
+          }
+          return key;
+        };
+        ::SortCells(cells, cellKey, offset, cellOrder.data() + offset);
+      }
+      else
+      {
+        auto cellKey = [inPts, &encoder](vtkIdType npts, const vtkIdType* pts) {
+          double centroid[3] = { 0.0, 0.0, 0.0 };
+          double x[3];
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            inPts->GetPoint(pts[i], x);
+            vtkMath::Add(centroid, x, centroid);
+          }
+          if (npts > 0)
+          {
+            vtkMath::MultiplyScalar(centroid, 1.0 / npts);
+          }
+          return encoder(centroid);
+        };
+        ::SortCells(cells, cellKey, offset, cellOrder.data() + offset);
+      }
+      offset += cells->GetNumberOfCells();
+    }
+  }
+  this->UpdateProgress(0.6);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Permute the cells and renumber their points.
+  const vtkIdType* pointMap = this->ReorderPoints ? pointRank.data() : nullptr;
+  std::vector<vtkSmartPointer<vtkCellArray>> outCellArrays;
+  vtkIdType offset = 0;
+  for (vtkCellArray* cells : cellArrays)
+  {
+    const vtkIdType* order = this->ReorderCells ? cellOrder.data() + offset : nullptr;
+    outCellArrays.push_back(::PermuteCells(cells, order, offset, pointMap));
+    offset += cells->GetNumberOfCells();
+  }
+
+  // Permute the points and the point data.
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  if (this->ReorderPoints)
+  {
+    outPD->CopyAllocate(inPD, numPts);
+    ArrayList arrays;
+    arrays.AddArrays(numPts, inPD, outPD, 0.0, false);
+    vtkStdString pointsName = "Points";
+    vtkNew<vtkPoints> outPts;
+    outPts->SetData(vtkArrayDownCast<vtkDataArray>(
+      arrays.AddArrayPair(numPts, inPts->GetData(), pointsName, 0.0, false)));
+    ::PermuteAttributes(
+      arrays, pointOrder, outPD, this->GenerateOriginalIds ? "vtkOriginalPointIds" : nullptr);
+    output->SetPoints(outPts);
+  }
+  else
+  {
+    output->SetPoints(inPts);
+    outPD->PassData(inPD);
+  }
+
+  // Permute the cell data.
+  vtkCellData* inCD = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  if (this->ReorderCells)
+  {
+    outCD->CopyAllocate(inCD, numCells);
+    ArrayList arrays;
+    arrays.AddArrays(numCells, inCD, outCD, 0.0, false);
+    ::PermuteAttributes(
+      arrays, cellOrder, outCD, this->GenerateOriginalIds ? "vtkOriginalCellIds" : nullptr);
+  }
+  else
+  {
+    outCD->PassData(inCD);
+  }
+  this->UpdateProgress(0.9);
+
+  if (inGrid)
+  {
+    vtkUnstructuredGrid* outGrid = vtkUnstructuredGrid::SafeDownCast(output);
+    vtkSmartPointer<vtkUnsignedCharArray> types = inGrid->GetCellTypesArray();
+    if (types && this->ReorderCells)
+    {
+      vtkUnsignedCharArray* inTypes = types;
+      types = vtkSmartPointer<vtkUnsignedCharArray>::New();
+      types->SetNumberOfValues(numCells);
+      vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cellId = begin; cellId < end; ++cellId)
+        {
+          types->SetValue(cellId, inTypes->GetValue(cellOrder[cellId]));
+        }
+      });
+    }
+
+    // The faces of the polyhedra keep their order, only the face locations
+    // of the cells are permuted.
+    vtkSmartPointer<vtkCellArray> faces = inGrid->GetPolyhedronFaces();
+    vtkSmartPointer<vtkCellArray> faceLocations = inGrid->GetPolyhedronFaceLocations();
+    if (types && faces && faceLocations && faceLocations->GetNumberOfCells() > 0)
+    {
+      if (pointMap)
+      {
+        faces = ::PermuteCells(faces, nullptr, 0, pointMap);
+      }
+      if (this->ReorderCells)
+      {
+        faceLocations = ::PermuteCells(faceLocations, cellOrder.data(), 0, nullptr);
+      }
+      outGrid->SetPolyhedralCells(types, outCellArrays[0], faceLocations, faces);
+    }
+    else if (types)
+    {
+      outGrid->SetCells(types, outCellArrays[0]);
+    }
+  }
+  else
+  {
+    vtkPolyData* outPolyData = vtkPolyData::SafeDownCast(output);
+    outPolyData->SetVerts(outCellArrays[0]);
+    outPolyData->SetLines(outCellArrays[1]);
+    outPolyData->SetPolys(outCellArrays[2]);
+    outPolyData->SetStrips(outCellArrays[3]);
+  }
+  output->GetFieldData()->PassData(input->GetFieldData());
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkReorderPointsAndCells::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkReorderPointsAndCells::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Ordering Mode: ";
+  if (this->OrderingMode == MORTON)
+  {
+    os << "Morton\n";
+  }
+  else if (this->OrderingMode == HILBERT)
+  {
+    os << "Hilbert\n";
+  }
+  else
+  {
+    os << "Reverse Cuthill-McKee\n";
+  }
+  os << indent << "Reorder Points: " << (this->ReorderPoints ? "On\n" : "Off\n");
+  os << indent << "Reorder Cells: " << (this->ReorderCells ? "On\n" : "Off\n");
+  os << indent << "Generate Original Ids: " << (this->GenerateOriginalIds ? "On\n" : "Off\n");
+}
+
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkReorderPointsAndCells
+ * @brief   renumber the points and cells of a mesh for better memory locality
+ *
+ * vtkReorderPointsAndCells is a filter that takes a vtkUnstructuredGrid or
+ * a vtkPolyData as input and produces an output of the same type, with the
+ * same points and cells, renumbered so that points and cells close to each
+ * other in space (or in the mesh) are also close to each other in memory.
+ * Meshes produced by solvers or readers often have poor locality; renumbering
+ * them once reduces the cache and TLB misses of every downstream filter
+ * traversing the cells and accessing their points (locators, gradients,
+ * contouring, rendering...).
+ *
+ * Three orderings are available. MORTON and HILBERT sort the points along a
+ * Morton (Z-order) or a Hilbert space filling curve, computed on a grid of
+ * 2^21 cells along each axis of the bounds, and the cells along the same
+ * curve using their centroids. The Hilbert curve has no jumps and usually
+ * gives a better locality than the Morton curve, for a slightly larger cost.
+ * REVERSE_CUTHILL_MCKEE renumbers the points with the reverse Cuthill-McKee
+ * algorithm on the graph of the points sharing a cell, which reduces the
+ * bandwidth of the point adjacency (useful for sparse solvers). The cells
+ * are then sorted by the smallest new id of their points.
+ *
+ * All the point and cell data arrays are permuted, with their types
+ * preserved. The cells of a vtkPolyData are only reordered within each of
+ * its cell arrays (verts, lines, polys and strips), so that its cell ids
+ * remain in this order. The faces of polyhedra are renumbered but not
+ * reordered. By default, the ids of the input points and cells are stored
+ * in the output in the "vtkOriginalPointIds" point data array and in the
+ * "vtkOriginalCellIds" cell data array: these map each output id to its
+ * input id. GetArrayInInputOrder() and GetArrayInOutputOrder() use them to
+ * create vtkIndexedArray views mapping arrays between the two orders without
+ * copying their values.
+ *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Using TBB or other
+ * non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly. The
+ * output does not depend on the number of threads.
+ *
+ * @sa
+ * vtkIndexedArray vtkStaticCleanUnstructuredGrid vtkProbeFilter
+ */
+
+#ifndef vtkReorderPointsAndCells_h
+#define vtkReorderPointsAndCells_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkPointSetAlgorithm.h"
+#include "vtkSmartPointer.h" // For the indexed arrays
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+class vtkIdTypeArray;
+
+class VTKFILTERSCORE_EXPORT vtkReorderPointsAndCells : public vtkPointSetAlgorithm
+{
+public:
+  ///@{
+  /**
+   * Standard methods for instantiation, obtaining type information, and
+   * printing the state of the object.
+   */
+  static vtkReorderPointsAndCells* New();
+  vtkTypeMacro(vtkReorderPointsAndCells, vtkPointSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  ///@}
+
+  /**
+   * The orderings of the points and cells.
+   */
+  enum OrderingModes
+  {
+    MORTON = 0,
+    HILBERT = 1,
+    REVERSE_CUTHILL_MCKEE = 2
+  };
+
+  ///@{
+  /**
+   * Specify how the points and cells are ordered. By default, they are
+   * sorted along a Hilbert curve.
+   */
+  vtkSetClampMacro(OrderingMode, int, MORTON, REVERSE_CUTHILL_MCKEE);
+  vtkGetMacro(OrderingMode, int);
+  void SetOrderingModeToMorton() { this->SetOrderingMode(MORTON); }
+  void SetOrderingModeToHilbert() { this->SetOrderingMode(HILBERT); }
+  void SetOrderingModeToReverseCuthillMcKee() { this->SetOrderingMode(REVERSE_CUTHILL_MCKEE); }
+  ///@}
+
+  ///@{
+  /**
+   * Indicate whether the points and the cells are reordered. When only one
+   * of them is reordered, the other one keeps the order of the input. Both
+   * are on by default.
+   */
+  vtkSetMacro(ReorderPoints, bool);
+  vtkGetMacro(ReorderPoints, bool);
+  vtkBooleanMacro(ReorderPoints, bool);
+  vtkSetMacro(ReorderCells, bool);
+  vtkGetMacro(ReorderCells, bool);
+  vtkBooleanMacro(ReorderCells, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Indicate whether the "vtkOriginalPointIds" and "vtkOriginalCellIds"
+   * arrays, giving the input id of each output point and cell, are added to
+   * the output. They are only added for the points or cells that are
+   * reordered. On by default.
+   */
+  vtkSetMacro(GenerateOriginalIds, bool);
+  vtkGetMacro(GenerateOriginalIds, bool);
+  vtkBooleanMacro(GenerateOriginalIds, bool);
+  ///@}
+
+  /**
+   * Return a vtkIndexedArray presenting an output array in the order of the
+   * input, given the original ids of the output ("vtkOriginalPointIds" or
+   * "vtkOriginalCellIds"). This is used to map the results computed on the
+   * output back onto the input. Return nullptr if the arrays do not have the
+   * same number of tuples.
+   */
+  static vtkSmartPointer<vtkDataArray> GetArrayInInputOrder(
+    vtkDataArray* array, vtkIdTypeArray* originalIds);
+
+  /**
+   * Return a vtkIndexedArray presenting an input array in the order of the
+   * output, given the original ids of the output. The values are not copied.
+   */
+  static vtkSmartPointer<vtkDataArray> GetArrayInOutputOrder(
+    vtkDataArray* array, vtkIdTypeArray* originalIds);
+
+protected:
+  vtkReorderPointsAndCells();
+  ~vtkReorderPointsAndCells() override = default;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  int OrderingMode;
+  bool ReorderPoints;
+  bool ReorderCells;
+  bool GenerateOriginalIds;
+
+private:
+  vtkReorderPointsAndCells(const vtkReorderPointsAndCells&) = delete;
+  void operator=(const vtkReorderPointsAndCells&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
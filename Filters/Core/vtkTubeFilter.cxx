@@ -5,15 +5,23 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTubeFilter);
@@ -40,6 +48,7 @@ vtkTubeFilter::vtkTubeFilter()
   this->TextureLength = 1.0;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->ParallelGeneration = false;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(
@@ -71,6 +80,42 @@ struct IdPointsEqual
   vtkPoints* Points;
 };
 
+// The strips of a tube are written through a writer: the serial traversal
+// inserts them in the output cell array, the threaded generation writes them
+// at the offsets of their polyline.
+struct vtkInsertTubeStrips
+{
+  vtkCellArray* Strips;
+  vtkCellData* InCD;
+  vtkCellData* OutCD;
+  vtkIdType InCellId;
+
+  void BeginStrip(vtkIdType npts)
+  {
+    vtkIdType outCellId = this->Strips->InsertNextCell(npts);
+    this->OutCD->CopyData(this->InCD, this->InCellId, outCellId);
+  }
+  void AddPoint(vtkIdType ptId) { this->Strips->InsertCellPoint(ptId); }
+};
+
+struct vtkWriteTubeStrips
+{
+  vtkIdType* Offsets;
+  vtkIdType* Connectivity;
+  vtkCellData* InCD;
+  vtkCellData* OutCD;
+  vtkIdType InCellId;
+  vtkIdType OutCellId; // next strip of the polyline
+  vtkIdType ConnId;    // next connectivity entry of the polyline
+
+  void BeginStrip(vtkIdType vtkNotUsed(npts))
+  {
+    this->Offsets[this->OutCellId] = this->ConnId;
+    this->OutCD->CopyData(this->InCD, this->InCellId, this->OutCellId++);
+  }
+  void AddPoint(vtkIdType ptId) { this->Connectivity[this->ConnId++] = ptId; }
+};
+
 }
 
 int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
@@ -227,68 +272,76 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
   // the line cellIds start after the last vert cellId
   inCellId = input->GetNumberOfVerts();
-  int checkAbortInterval = std::min(numLines / 10 + 1, (vtkIdType)1000);
-  int progressCounter = 0;
-  for (inLines->InitTraversal(); inLines->GetNextCell(npts, ptsOrig) && !abort; inCellId++)
+  if (this->ParallelGeneration)
+  {
+    this->GenerateTubesInParallel(input, newPts, outPD, outCD, newNormals, newTCoords, newStrips,
+      inScalars, range, inVectors, maxSpeed, inNormals, generateNormals != 0);
+  }
+  else
   {
-    this->UpdateProgress((double)inCellId / numLines);
-    if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
+    int checkAbortInterval = std::min(numLines / 10 + 1, (vtkIdType)1000);
+    int progressCounter = 0;
+    for (inLines->InitTraversal(); inLines->GetNextCell(npts, ptsOrig) && !abort; inCellId++)
     {
-      abort = this->CheckAbort();
-      break;
-    }
-    progressCounter++;
+      this->UpdateProgress((double)inCellId / numLines);
+      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
+      {
+        abort = this->CheckAbort();
+        break;
+      }
+      progressCounter++;
 
-    // Make a copy of point indices to avoid modifying input polydata cells
-    // while removing degenerate lines.
-    if (npts < 2)
-    {
-      continue; // skip tubing this polyline
-    }
-    std::vector<vtkIdType> ptsCopy(ptsOrig, ptsOrig + npts);
-    vtkIdType* pts = ptsCopy.data();
+      // Make a copy of point indices to avoid modifying input polydata cells
+      // while removing degenerate lines.
+      if (npts < 2)
+      {
+        continue; // skip tubing this polyline
+      }
+      std::vector<vtkIdType> ptsCopy(ptsOrig, ptsOrig + npts);
+      vtkIdType* pts = ptsCopy.data();
 
-    // remove degenerate lines to avoid warnings
-    npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(inPts)) - pts);
-    if (npts < 2)
-    {
-      continue; // skip tubing this polyline
-    }
+      // remove degenerate lines to avoid warnings
+      npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(inPts)) - pts);
+      if (npts < 2)
+      {
+        continue; // skip tubing this polyline
+      }
 
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-    {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
-    }
+      // If necessary calculate normals, each polyline calculates its
+      // normals independently, avoiding conflicts at shared vertices.
+      if (generateNormals)
+      {
+        singlePolyline->Reset(); // avoid instantiation
+        singlePolyline->InsertNextCell(npts, pts);
+        vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
+      }
 
-    // Generate the points around the polyline. The tube is not stripped
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars,
-          range, inVectors, maxSpeed, inNormals))
-    {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip tubing this polyline
-    }
+      // Generate the points around the polyline. The tube is not stripped
+      // if the polyline is bad.
+      //
+      if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars,
+            range, inVectors, maxSpeed, inNormals))
+      {
+        vtkWarningMacro(<< "Could not generate points!");
+        continue; // skip tubing this polyline
+      }
 
-    // Generate the strips for this polyline (including caps)
-    //
-    this->GenerateStrips(offset, npts, pts, inCellId, cd, outCD, newStrips);
+      // Generate the strips for this polyline (including caps)
+      //
+      this->GenerateStrips(offset, npts, pts, inCellId, cd, outCD, newStrips);
 
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
-    {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
-    }
+      // Generate the texture coordinates for this polyline
+      //
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      }
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
+      // Compute the new offset for the next polyline
+      offset = this->ComputeOffset(offset, npts);
 
-  } // for all polylines
+    } // for all polylines
+  }
 
   singlePolyline->Delete();
 
@@ -326,6 +379,173 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Generate the tubes of all the polylines in parallel. The points and strips
+// of each polyline are counted first, then the tubes are generated at their
+// offsets, so that the output is the one of the serial traversal. The normals
+// of each polyline are computed in an array local to the thread, the
+// polylines sharing points get the same normals as in the serial traversal.
+void vtkTubeFilter::GenerateTubesInParallel(vtkPolyData* input, vtkPoints* newPts,
+  vtkPointData* outPD, vtkCellData* outCD, vtkFloatArray* newNormals, vtkFloatArray* newTCoords,
+  vtkCellArray* newStrips, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
+  double maxSpeed, vtkDataArray* inNormals, bool generateNormals)
+{
+  vtkPoints* inPts = input->GetPoints();
+  vtkPointData* pd = input->GetPointData();
+  vtkCellData* cd = input->GetCellData();
+  vtkCellArray* inLines = input->GetLines();
+  const vtkIdType numPts = inPts->GetNumberOfPoints();
+  const vtkIdType numLines = inLines->GetNumberOfCells();
+  // the line cellIds start after the last vert cellId
+  const vtkIdType firstCellId = input->GetNumberOfVerts();
+
+  // Copy the point ids of a polyline without its degenerate segments, and
+  // return their number, or 0 if the polyline is not tubed.
+  vtkSMPThreadLocalObject<vtkIdList> localCellPts;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localPts;
+  auto copyLinePoints = [&](vtkIdType lineId) -> vtkIdType {
+    vtkIdType npts;
+    const vtkIdType* ptsOrig;
+    inLines->GetCellAtId(lineId, npts, ptsOrig, localCellPts.Local());
+    if (npts < 2)
+    {
+      return 0;
+    }
+    std::vector<vtkIdType>& pts = localPts.Local();
+    pts.assign(ptsOrig, ptsOrig + npts);
+    npts = static_cast<vtkIdType>(
+      std::unique(pts.begin(), pts.end(), IdPointsEqual(inPts)) - pts.begin());
+    return npts < 2 ? 0 : npts;
+  };
+
+  std::vector<vtkIdType> lineSizes(numLines);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType lineId = begin; lineId < end; ++lineId)
+    {
+      lineSizes[lineId] = copyLinePoints(lineId);
+    }
+  });
+
+  const vtkIdType numSideStrips = (this->NumberOfSides + this->OnRatio - 1) / this->OnRatio;
+  const vtkIdType numCapStrips = this->Capping ? 2 : 0;
+  std::vector<vtkIdType> pointOffsets(numLines + 1);
+  std::vector<vtkIdType> stripOffsets(numLines + 1);
+  std::vector<vtkIdType> connOffsets(numLines + 1);
+  std::vector<unsigned char> failedLines(numLines, 0);
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> connectivity;
+  vtkSMPThreadLocalObject<vtkFloatArray> localNormals;
+  vtkSMPThreadLocalObject<vtkCellArray> localPolyline;
+
+  // The polylines whose points cannot be generated are skipped, as in the
+  // serial traversal, by generating the other ones again.
+  bool failed = true;
+  while (failed && !this->GetAbortOutput())
+  {
+    vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType lineId = begin; lineId < end; ++lineId)
+      {
+        const vtkIdType npts = lineSizes[lineId];
+        pointOffsets[lineId] = npts > 0 ? this->ComputeOffset(0, npts) : 0;
+        stripOffsets[lineId] = npts > 0 ? numSideStrips + numCapStrips : 0;
+        connOffsets[lineId] =
+          npts > 0 ? 2 * npts * numSideStrips + this->NumberOfSides * numCapStrips : 0;
+      }
+    });
+    const vtkIdType numNewPts = pointOffsets[numLines] = vtkSMPTools::ExclusiveScan(
+      pointOffsets.begin(), pointOffsets.end() - 1, pointOffsets.begin(), vtkIdType(0));
+    const vtkIdType numStrips = stripOffsets[numLines] = vtkSMPTools::ExclusiveScan(
+      stripOffsets.begin(), stripOffsets.end() - 1, stripOffsets.begin(), vtkIdType(0));
+    const vtkIdType connSize = connOffsets[numLines] = vtkSMPTools::ExclusiveScan(
+      connOffsets.begin(), connOffsets.end() - 1, connOffsets.begin(), vtkIdType(0));
+
+    // Inserting in arrays which have their final size is thread safe.
+    newPts->SetNumberOfPoints(numNewPts);
+    newNormals->SetNumberOfTuples(numNewPts);
+    if (newTCoords)
+    {
+      newTCoords->SetNumberOfTuples(numNewPts);
+    }
+    outPD->SetNumberOfTuples(numNewPts);
+    outCD->SetNumberOfTuples(numStrips);
+    offsets->SetNumberOfValues(numStrips + 1);
+    offsets->SetValue(numStrips, connSize);
+    connectivity->SetNumberOfValues(connSize);
+
+    std::atomic<bool> anyFailed(false);
+    vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+      const bool isFirst = vtkSMPTools::GetSingleThread();
+      const vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+      for (vtkIdType lineId = begin; lineId < end; ++lineId)
+      {
+        if (lineId % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        const vtkIdType npts = lineSizes[lineId];
+        if (npts == 0)
+        {
+          continue; // skip tubing this polyline
+        }
+        copyLinePoints(lineId);
+        const vtkIdType* pts = localPts.Local().data();
+
+        vtkDataArray* lineNormals = inNormals;
+        if (generateNormals)
+        {
+          vtkFloatArray* normals = localNormals.Local();
+          if (normals->GetNumberOfTuples() != numPts)
+          {
+            normals->SetNumberOfComponents(3);
+            normals->SetNumberOfTuples(numPts);
+          }
+          vtkCellArray* polyline = localPolyline.Local();
+          polyline->Reset();
+          polyline->InsertNextCell(npts, pts);
+          vtkPolyLine::GenerateSlidingNormals(inPts, polyline, normals);
+          lineNormals = normals;
+        }
+
+        const vtkIdType offset = pointOffsets[lineId];
+        if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals,
+              inScalars, range, inVectors, maxSpeed, lineNormals))
+        {
+          failedLines[lineId] = 1;
+          anyFailed = true;
+          continue;
+        }
+        vtkWriteTubeStrips writer = { offsets->GetPointer(0), connectivity->GetPointer(0), cd,
+          outCD, firstCellId + lineId, stripOffsets[lineId], connOffsets[lineId] };
+        this->WriteStrips(offset, npts, writer);
+        if (newTCoords)
+        {
+          this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+        }
+      }
+    });
+
+    failed = anyFailed;
+    for (vtkIdType lineId = 0; failed && lineId < numLines; ++lineId)
+    {
+      if (failedLines[lineId])
+      {
+        vtkWarningMacro(<< "Could not generate points!");
+        failedLines[lineId] = 0;
+        lineSizes[lineId] = 0;
+      }
+    }
+  }
+
+  newStrips->SetData(offsets, connectivity);
+}
+
 int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
   vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
   vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
@@ -555,11 +775,10 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
   return 1;
 }
 
-void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
-  const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
-  vtkCellArray* newStrips)
+template <typename StripWriter>
+void vtkTubeFilter::WriteStrips(vtkIdType offset, vtkIdType npts, StripWriter& writer)
 {
-  vtkIdType i, outCellId;
+  vtkIdType i;
   int k;
   int i1, i2, i3;
 
@@ -569,13 +788,12 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
     {
       i1 = k % this->NumberOfSides;
       i2 = (k + 1) % this->NumberOfSides;
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
+      writer.BeginStrip(npts * 2);
       for (i = 0; i < npts; i++)
       {
         i3 = i * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
+        writer.AddPoint(offset + i2 + i3);
+        writer.AddPoint(offset + i1 + i3);
       }
     } // for each side of the tube
   }
@@ -585,13 +803,12 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
     {
       i1 = 2 * (k % this->NumberOfSides) + 1;
       i2 = 2 * ((k + 1) % this->NumberOfSides);
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
+      writer.BeginStrip(npts * 2);
       for (i = 0; i < npts; i++)
       {
         i3 = i * 2 * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
+        writer.AddPoint(offset + i2 + i3);
+        writer.AddPoint(offset + i1 + i3);
       }
     } // for each side of the tube
   }
@@ -609,50 +826,56 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
     }
 
     // The start cap
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + 1);
+    writer.BeginStrip(this->NumberOfSides);
+    writer.AddPoint(startIdx);
+    writer.AddPoint(startIdx + 1);
     for (i1 = this->NumberOfSides - 1, i2 = 2, k = 0; k < (this->NumberOfSides - 2); k++)
     {
       if ((k % 2))
       {
         idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
+        writer.AddPoint(idx);
         i2++;
       }
       else
       {
         idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
+        writer.AddPoint(idx);
         i1--;
       }
     }
 
     // The end cap - reversed order to be consistent with normal
     startIdx += this->NumberOfSides;
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + this->NumberOfSides - 1);
+    writer.BeginStrip(this->NumberOfSides);
+    writer.AddPoint(startIdx);
+    writer.AddPoint(startIdx + this->NumberOfSides - 1);
     for (i1 = this->NumberOfSides - 2, i2 = 1, k = 0; k < (this->NumberOfSides - 2); k++)
     {
       if ((k % 2))
       {
         idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
+        writer.AddPoint(idx);
         i1--;
       }
       else
       {
         idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
+        writer.AddPoint(idx);
         i2++;
       }
     }
   }
 }
 
+void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
+  const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
+  vtkCellArray* newStrips)
+{
+  vtkInsertTubeStrips writer = { newStrips, cd, outCD, inCellId };
+  this->WriteStrips(offset, npts, writer);
+}
+
 void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
   vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords)
 {
@@ -839,5 +1062,6 @@ void vtkTubeFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Generate TCoords: " << this->GetGenerateTCoordsAsString() << endl;
   os << indent << "Texture Length: " << this->TextureLength << endl;
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << endl;
+  os << indent << "Parallel Generation: " << (this->ParallelGeneration ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -220,6 +220,18 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the threaded generation of the tubes. When on, the points and
+   * strips of each polyline are counted first, and the tubes are then
+   * generated in parallel over the polylines at their offsets in the output,
+   * which is identical to the serial output. Initial value is off.
+   */
+  vtkSetMacro(ParallelGeneration, vtkTypeBool);
+  vtkGetMacro(ParallelGeneration, vtkTypeBool);
+  vtkBooleanMacro(ParallelGeneration, vtkTypeBool);
+  ///@}
+
 protected:
   vtkTubeFilter();
   ~vtkTubeFilter() override = default;
@@ -240,6 +252,7 @@ protected:
   int GenerateTCoords; // control texture coordinate generation
   int OutputPointsPrecision;
   double TextureLength; // this length is mapped to [0,1) texture space
+  vtkTypeBool ParallelGeneration;
 
   // Helper methods
   int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
@@ -256,6 +269,13 @@ protected:
   double Theta;
 
 private:
+  void GenerateTubesInParallel(vtkPolyData* input, vtkPoints* newPts, vtkPointData* outPD,
+    vtkCellData* outCD, vtkFloatArray* newNormals, vtkFloatArray* newTCoords,
+    vtkCellArray* newStrips, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
+    double maxSpeed, vtkDataArray* inNormals, bool generateNormals);
+  template <typename StripWriter>
+  void WriteStrips(vtkIdType offset, vtkIdType npts, StripWriter& writer);
+
   vtkTubeFilter(const vtkTubeFilter&) = delete;
   void operator=(const vtkTubeFilter&) = delete;
 };
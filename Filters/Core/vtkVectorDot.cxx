@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkVectorDot.h"
 
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkArrayDispatch.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
@@ -11,6 +12,7 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSIMDKernels.h"
 #include "vtkSMPTools.h"
 
 #include <algorithm>
@@ -22,6 +24,22 @@ vtkStandardNewMacro(vtkVectorDot);
 namespace
 {
 
+// Contiguous float and double arrays of the same type use the vectorized kernels.
+template <typename NormArrayT, typename VecArrayT>
+bool ComputeDots(NormArrayT*, VecArrayT*, vtkFloatArray*, vtkIdType, vtkIdType, float[2])
+{
+  return false;
+}
+
+template <typename ValueT>
+bool ComputeDots(vtkAOSDataArrayTemplate<ValueT>* normals, vtkAOSDataArrayTemplate<ValueT>* vectors,
+  vtkFloatArray* scalars, vtkIdType begin, vtkIdType end, float range[2])
+{
+  vtk::detail::simd::Dot3(normals->GetPointer(3 * begin), vectors->GetPointer(3 * begin),
+    end - begin, scalars->GetPointer(begin), range);
+  return true;
+}
+
 template <typename NormArrayT, typename VecArrayT>
 struct DotWorker
 {
@@ -46,6 +64,14 @@ struct DotWorker
     float& min = this->LocalMin.Local();
     float& max = this->LocalMax.Local();
 
+    float range[2] = { min, max };
+    if (ComputeDots(this->Normals, this->Vectors, this->Scalars, begin, end, range))
+    {
+      min = range[0];
+      max = range[1];
+      return;
+    }
+
     // Restrict the iterator ranges to [begin,end)
     const auto normals = vtk::DataArrayTupleRange<3>(this->Normals, begin, end);
     const auto vectors = vtk::DataArrayTupleRange<3>(this->Vectors, begin, end);
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkVectorNorm.h"
 
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
@@ -11,6 +12,7 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSIMDKernels.h"
 #include "vtkSMPTools.h"
 
 #include <cmath>
@@ -28,6 +30,27 @@ struct vtkVectorNormAlgorithm
   TV* Vectors = nullptr;
   float* Scalars = nullptr;
 };
+// Contiguous float and double vectors are processed with the vectorized kernels.
+template <class T>
+bool ComputeMagnitudes(T*, vtkIdType, vtkIdType, float*, float&)
+{
+  return false;
+}
+
+bool ComputeMagnitudes(
+  vtkAOSDataArrayTemplate<float>* vectors, vtkIdType begin, vtkIdType end, float* s, float& max)
+{
+  vtk::detail::simd::Magnitude3(vectors->GetPointer(3 * begin), end - begin, s, max);
+  return true;
+}
+
+bool ComputeMagnitudes(
+  vtkAOSDataArrayTemplate<double>* vectors, vtkIdType begin, vtkIdType end, float* s, float& max)
+{
+  vtk::detail::simd::Magnitude3(vectors->GetPointer(3 * begin), end - begin, s, max);
+  return true;
+}
+
 // Interface dot product computation to SMP tools.
 template <class T>
 struct NormOp
@@ -50,6 +73,35 @@ struct NormOp
     float* s = this->Algo->Scalars + k;
     bool isFirst = vtkSMPTools::GetSingleThread();
     vtkIdType checkAbortInterval = std::min((end - k) / 10 + 1, (vtkIdType)1000);
+
+    // Contiguous float and double vectors, processed by chunks to check for abort
+    float kernelMax = 0.0f;
+    bool vectorized = true;
+    while (k < end)
+    {
+      if (isFirst)
+      {
+        this->Filter->CheckAbort();
+      }
+      if (this->Filter->GetAbortOutput())
+      {
+        break;
+      }
+      const vtkIdType chunkEnd = std::min(k + checkAbortInterval, end);
+      if (!ComputeMagnitudes(this->Algo->Vectors, k, chunkEnd, s, kernelMax))
+      {
+        vectorized = false;
+        break;
+      }
+      s += chunkEnd - k;
+      k = chunkEnd;
+    }
+    if (vectorized)
+    {
+      max = (kernelMax > max ? kernelMax : max);
+      return;
+    }
+
     for (auto v : vectorRange)
     {
       if (k % checkAbortInterval == 0)
@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the parallel clipping of an unstructured grid mixing linear cells
+// and polyhedra gives the same output as the sequential one.
+
+#include "vtkCellData.h"
+#include "vtkClipDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A grid of n^3 voxels, every other one stored as a polyhedron and the others
+// as hexahedra.
+void CreateGrid(int n, vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Distance");
+  for (int k = 0; k <= n; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        double x[3] = { static_cast<double>(i) / n, static_cast<double>(j) / n,
+          static_cast<double>(k) / n };
+        points->InsertNextPoint(x);
+        scalars->InsertNextValue(
+          (x[0] - 0.5) * (x[0] - 0.5) + (x[1] - 0.5) * (x[1] - 0.5) + x[2] * x[2]);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+
+  auto id = [n](int i, int j, int k) -> vtkIdType { return i + (n + 1) * (j + (n + 1) * k); };
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType p[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        if ((i + j + k) % 2)
+        {
+          const vtkIdType faces[] = { 4, p[0], p[3], p[2], p[1], 4, p[4], p[5], p[6], p[7], 4,
+            p[0], p[1], p[5], p[4], 4, p[1], p[2], p[6], p[5], 4, p[2], p[3], p[7], p[6], 4, p[3],
+            p[0], p[4], p[7] };
+          grid->InsertNextCell(VTK_POLYHEDRON, 8, p, 6, faces);
+        }
+        else
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, p);
+        }
+      }
+    }
+  }
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+  }
+  grid->GetCellData()->AddArray(cellIds);
+}
+
+//------------------------------------------------------------------------------
+bool Compare(vtkUnstructuredGrid* sequential, vtkUnstructuredGrid* parallel, const char* name)
+{
+  if (sequential->GetNumberOfCells() == 0)
+  {
+    std::cerr << name << ": empty output." << std::endl;
+    return false;
+  }
+  if (sequential->GetNumberOfPoints() != parallel->GetNumberOfPoints() ||
+    sequential->GetNumberOfCells() != parallel->GetNumberOfCells())
+  {
+    std::cerr << name << ": " << parallel->GetNumberOfPoints() << " points and "
+              << parallel->GetNumberOfCells() << " cells instead of "
+              << sequential->GetNumberOfPoints() << " and " << sequential->GetNumberOfCells()
+              << std::endl;
+    return false;
+  }
+  vtkIdType numberOfPolyhedra[2] = { 0, 0 };
+  vtkIdType numberOfFaces[2] = { 0, 0 };
+  double cellIdSum[2] = { 0.0, 0.0 };
+  vtkUnstructuredGrid* grids[2] = { sequential, parallel };
+  vtkNew<vtkIdList> faceStream;
+  for (int g = 0; g < 2; ++g)
+  {
+    vtkDataArray* cellIds = grids[g]->GetCellData()->GetArray("CellIds");
+    if (!cellIds || cellIds->GetNumberOfTuples() != grids[g]->GetNumberOfCells())
+    {
+      std::cerr << name << ": wrong cell data." << std::endl;
+      return false;
+    }
+    for (vtkIdType cellId = 0; cellId < grids[g]->GetNumberOfCells(); ++cellId)
+    {
+      cellIdSum[g] += cellIds->GetComponent(cellId, 0);
+      if (grids[g]->GetCellType(cellId) == VTK_POLYHEDRON)
+      {
+        ++numberOfPolyhedra[g];
+        grids[g]->GetFaceStream(cellId, faceStream);
+        numberOfFaces[g] += faceStream->GetId(0);
+      }
+    }
+  }
+  if (numberOfPolyhedra[0] == 0 || numberOfPolyhedra[0] != numberOfPolyhedra[1] ||
+    numberOfFaces[0] != numberOfFaces[1] || cellIdSum[0] != cellIdSum[1])
+  {
+    std::cerr << name << ": " << numberOfPolyhedra[1] << " polyhedra with " << numberOfFaces[1]
+              << " faces instead of " << numberOfPolyhedra[0] << " with " << numberOfFaces[0]
+              << ", or wrong cell data" << std::endl;
+    return false;
+  }
+  vtkDataArray* distance = parallel->GetPointData()->GetArray("Distance");
+  if (!distance || distance->GetNumberOfTuples() != parallel->GetNumberOfPoints())
+  {
+    std::cerr << name << ": wrong point data." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestClipDataSetThreaded(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  CreateGrid(10, grid);
+
+  // Clip with the input scalars.
+  vtkNew<vtkClipDataSet> clip;
+  clip->SetInputData(grid);
+  clip->SetValue(0.3);
+  clip->GenerateClippedOutputOn();
+  clip->SequentialProcessingOn();
+  clip->Update();
+  vtkNew<vtkUnstructuredGrid> sequential;
+  sequential->DeepCopy(clip->GetOutput());
+  vtkNew<vtkUnstructuredGrid> sequentialClipped;
+  sequentialClipped->DeepCopy(clip->GetClippedOutput());
+  clip->SequentialProcessingOff();
+  clip->Update();
+  if (!Compare(sequential, clip->GetOutput(), "Scalars") ||
+    !Compare(sequentialClipped, clip->GetClippedOutput(), "Scalars, clipped output"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Clip with an implicit function.
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.55, 0.45, 0.5);
+  plane->SetNormal(1.0, 0.5, 0.25);
+  clip->SetClipFunction(plane);
+  clip->SetValue(0.0);
+  clip->GenerateClippedOutputOff();
+  clip->SequentialProcessingOn();
+  clip->Update();
+  sequential->DeepCopy(clip->GetOutput());
+  clip->SequentialProcessingOff();
+  clip->Update();
+  if (!Compare(sequential, clip->GetOutput(), "Plane"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the curvatures computed by vtkCurvatures on a sphere do not
+// depend on the number of threads, and that they are close to the curvatures
+// of the sphere.
+
+#include "vtkCurvatures.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> ComputeCurvature(vtkPolyData* input, int type, int numThreads)
+{
+  vtkNew<vtkCurvatures> curvatures;
+  curvatures->SetInputData(input);
+  curvatures->SetCurvatureType(type);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numThreads }, [&]() { curvatures->Update(); });
+  return curvatures->GetOutput();
+}
+}
+
+//------------------------------------------------------------------------------
+int TestCurvaturesThreaded(int, char*[])
+{
+  const double radius = 2.0;
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(radius);
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+
+  const char* names[4] = { "Gauss_Curvature", "Mean_Curvature", "Maximum_Curvature",
+    "Minimum_Curvature" };
+  const double expected[4] = { 1.0 / (radius * radius), 1.0 / radius, 1.0 / radius,
+    1.0 / radius };
+  for (int type = VTK_CURVATURE_GAUSS; type <= VTK_CURVATURE_MINIMUM; ++type)
+  {
+    vtkSmartPointer<vtkPolyData> serial = ComputeCurvature(sphere->GetOutput(), type, 1);
+    vtkSmartPointer<vtkPolyData> threaded = ComputeCurvature(sphere->GetOutput(), type, 0);
+    vtkDataArray* serialValues = serial->GetPointData()->GetArray(names[type]);
+    vtkDataArray* threadedValues = threaded->GetPointData()->GetArray(names[type]);
+    if (!serialValues || !threadedValues ||
+      serialValues->GetNumberOfTuples() != sphere->GetOutput()->GetNumberOfPoints() ||
+      threadedValues->GetNumberOfTuples() != serialValues->GetNumberOfTuples())
+    {
+      std::cerr << "Missing " << names[type] << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    double average = 0.0;
+    for (vtkIdType ptId = 0; ptId < serialValues->GetNumberOfTuples(); ++ptId)
+    {
+      if (serialValues->GetTuple1(ptId) != threadedValues->GetTuple1(ptId))
+      {
+        std::cerr << names[type] << " at point " << ptId << " is "
+                  << threadedValues->GetTuple1(ptId) << " instead of "
+                  << serialValues->GetTuple1(ptId) << " with a single thread." << std::endl;
+        return EXIT_FAILURE;
+      }
+      average += std::abs(serialValues->GetTuple1(ptId));
+    }
+    average /= serialValues->GetNumberOfTuples();
+    if (std::abs(average - expected[type]) > 0.1 * expected[type])
+    {
+      std::cerr << "Average " << names[type] << " is " << average << " instead of "
+                << expected[type] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
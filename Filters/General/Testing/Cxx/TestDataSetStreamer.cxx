@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataSetStreamer.h"
+#include "vtkElevationFilter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMathUtilities.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+int TestDataSetStreamer(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(128);
+  sphere->SetPhiResolution(128);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->SetLowPoint(0.0, 0.0, -0.5);
+  elevation->SetHighPoint(0.0, 0.0, 0.5);
+  elevation->Update();
+  // The output of the elevation filter is replaced by the pieces.
+  vtkNew<vtkPolyData> reference;
+  reference->DeepCopy(elevation->GetOutput());
+
+  // Allow a quarter of the whole sphere in memory.
+  vtkNew<vtkDataSetStreamer> streamer;
+  streamer->SetInputConnection(elevation->GetOutputPort());
+  streamer->SetMemoryLimit(std::max(reference->GetActualMemorySize() / 4, 1ul));
+  streamer->SetOutputDataSetType(VTK_POLY_DATA);
+  streamer->SetHistogramArrayName("Elevation");
+  streamer->SetNumberOfHistogramBins(10);
+  streamer->Update();
+
+  if (streamer->GetNumberOfPieces() < 4)
+  {
+    std::cerr << "Streamed " << streamer->GetNumberOfPieces() << " pieces only." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkPolyData* output = vtkPolyData::SafeDownCast(streamer->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfCells() != reference->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of appended cells." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  double bounds[6];
+  reference->GetBounds(bounds);
+  for (int i = 0; i < 6; ++i)
+  {
+    if (!vtkMathUtilities::FuzzyCompare(bounds[i], streamer->GetBounds()[i], 1e-6))
+    {
+      std::cerr << "Wrong bounds." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Every point of every piece is counted.
+  vtkIdTypeArray* histogram = streamer->GetHistogram();
+  vtkIdType count = 0;
+  for (vtkIdType i = 0; i < histogram->GetNumberOfTuples(); ++i)
+  {
+    count += histogram->GetValue(i);
+  }
+  if (histogram->GetNumberOfTuples() != 10 || count != output->GetNumberOfPoints())
+  {
+    std::cerr << "Wrong histogram: " << count << " values for " << output->GetNumberOfPoints()
+              << " points." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Without a memory limit, the initial number of pieces is used.
+  streamer->SetMemoryLimit(0);
+  streamer->SetInitialNumberOfPieces(3);
+  streamer->AppendPiecesOff();
+  streamer->Update();
+  if (streamer->GetNumberOfPieces() != 3 ||
+    streamer->GetOutputDataObject(0)->GetNumberOfElements(vtkDataObject::CELL) != 0)
+  {
+    std::cerr << "Wrong streaming without memory limit." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel search of vtkIntersectionPolyDataFilter finds the
+// same intersection lines as the OBB tree search, that it does not depend on
+// the number of threads, and that vtkBooleanOperationPolyDataFilter computes
+// the same union with it.
+
+#include "vtkBooleanOperationPolyDataFilter.h"
+#include "vtkCellArray.h"
+#include "vtkIntersectionPolyDataFilter.h"
+#include "vtkMassProperties.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> CreateSphere(double x, int resolution)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(x, 0.1, 0.0);
+  sphere->SetRadius(1.0);
+  sphere->SetThetaResolution(resolution);
+  sphere->SetPhiResolution(resolution);
+  sphere->Update();
+  return sphere->GetOutput();
+}
+
+//------------------------------------------------------------------------------
+// Return the total length of the intersection lines.
+double ComputeLength(vtkPolyData* lines)
+{
+  double length = 0.0;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* cells = lines->GetLines();
+  for (cells->InitTraversal(); cells->GetNextCell(npts, pts);)
+  {
+    double x[3], y[3];
+    lines->GetPoint(pts[0], x);
+    lines->GetPoint(pts[npts - 1], y);
+    length += std::sqrt(vtkMath::Distance2BetweenPoints(x, y));
+  }
+  return length;
+}
+
+//------------------------------------------------------------------------------
+bool SameOutputs(vtkPolyData* output0, vtkPolyData* output1)
+{
+  if (output0->GetNumberOfPoints() != output1->GetNumberOfPoints() ||
+    output0->GetNumberOfCells() != output1->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < output0->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    output0->GetPoint(ptId, x);
+    output1->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+double ComputeArea(vtkPolyData* surface)
+{
+  vtkNew<vtkMassProperties> mass;
+  mass->SetInputData(surface);
+  mass->Update();
+  return mass->GetSurfaceArea();
+}
+}
+
+//------------------------------------------------------------------------------
+int TestIntersectionPolyDataFilterParallel(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> sphere0 = CreateSphere(0.0, 40);
+  vtkSmartPointer<vtkPolyData> sphere1 = CreateSphere(0.7, 31);
+
+  vtkNew<vtkIntersectionPolyDataFilter> intersections[2];
+  for (int parallel = 0; parallel < 2; ++parallel)
+  {
+    intersections[parallel]->SetInputData(0, sphere0);
+    intersections[parallel]->SetInputData(1, sphere1);
+    intersections[parallel]->SetParallelIntersection(parallel != 0);
+    intersections[parallel]->Update();
+  }
+  vtkIntersectionPolyDataFilter* serial = intersections[0];
+  vtkIntersectionPolyDataFilter* parallel = intersections[1];
+  if (serial->GetNumberOfIntersectionLines() == 0 ||
+    serial->GetNumberOfIntersectionLines() != parallel->GetNumberOfIntersectionLines() ||
+    serial->GetNumberOfIntersectionPoints() != parallel->GetNumberOfIntersectionPoints())
+  {
+    std::cerr << "Got " << parallel->GetNumberOfIntersectionLines() << " lines and "
+              << parallel->GetNumberOfIntersectionPoints() << " points instead of "
+              << serial->GetNumberOfIntersectionLines() << " and "
+              << serial->GetNumberOfIntersectionPoints() << std::endl;
+    return EXIT_FAILURE;
+  }
+  const double serialLength = ComputeLength(serial->GetOutput(0));
+  const double parallelLength = ComputeLength(parallel->GetOutput(0));
+  if (std::abs(serialLength - parallelLength) > 1e-6 * serialLength)
+  {
+    std::cerr << "Intersection length " << parallelLength << " instead of " << serialLength
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (int i = 1; i < 3; ++i)
+  {
+    if (serial->GetOutput(i)->GetNumberOfCells() != parallel->GetOutput(i)->GetNumberOfCells())
+    {
+      std::cerr << "Got " << parallel->GetOutput(i)->GetNumberOfCells() << " cells in output "
+                << i << " instead of " << serial->GetOutput(i)->GetNumberOfCells() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The parallel search does not depend on the number of threads.
+  vtkNew<vtkIntersectionPolyDataFilter> singleThread;
+  singleThread->SetInputData(0, sphere0);
+  singleThread->SetInputData(1, sphere1);
+  singleThread->SetParallelIntersection(true);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { singleThread->Update(); });
+  for (int i = 0; i < 3; ++i)
+  {
+    if (!SameOutputs(singleThread->GetOutput(i), parallel->GetOutput(i)))
+    {
+      std::cerr << "Output " << i << " depends on the number of threads." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The boolean union has the same area with both searches.
+  double areas[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkNew<vtkBooleanOperationPolyDataFilter> boolean;
+    boolean->SetInputData(0, sphere0);
+    boolean->SetInputData(1, sphere1);
+    boolean->SetOperationToUnion();
+    boolean->SetParallelIntersection(i != 0);
+    boolean->Update();
+    areas[i] = ComputeArea(boolean->GetOutput());
+  }
+  if (areas[0] <= 0.0 || std::abs(areas[0] - areas[1]) > 1e-5 * areas[0])
+  {
+    std::cerr << "Union area " << areas[1] << " instead of " << areas[0] << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -186,6 +186,21 @@ vtkIdType vtkApproximatingSubdivisionFilter::InterpolatePosition(
   return outputPts->InsertNextPoint(x);
 }
 
+void vtkApproximatingSubdivisionFilter::InterpolatePosition(vtkPoints* inputPts,
+  vtkPoints* outputPts, vtkIdType ptId, vtkIdList* stencil, const double* weights)
+{
+  double xx[3], x[3] = { 0.0, 0.0, 0.0 };
+  for (vtkIdType i = 0; i < stencil->GetNumberOfIds(); i++)
+  {
+    inputPts->GetPoint(stencil->GetId(i), xx);
+    for (int j = 0; j < 3; j++)
+    {
+      x[j] += xx[j] * weights[i];
+    }
+  }
+  outputPts->SetPoint(ptId, x);
+}
+
 void vtkApproximatingSubdivisionFilter::GenerateSubdivisionCells(
   vtkPolyData* inputDS, vtkIntArray* edgeData, vtkCellArray* outputPolys, vtkCellData* outputCD)
 {
@@ -197,6 +212,12 @@ void vtkApproximatingSubdivisionFilter::GenerateSubdivisionCells(
   vtkIdType newCellPts[3];
   vtkCellData* inputCD = inputDS->GetCellData();
 
+  if (vtkSubdivisionFilter::HasOnlyTriangles(inputDS))
+  {
+    this->GenerateSubdivisionTriangles(inputDS, edgeData, outputPolys, outputCD);
+    return;
+  }
+
   // Now create new cells from existing points and generated edge points
   for (cellId = 0; cellId < numCells; cellId++)
   {
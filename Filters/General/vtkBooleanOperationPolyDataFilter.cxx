@@ -23,6 +23,7 @@ vtkBooleanOperationPolyDataFilter::vtkBooleanOperationPolyDataFilter()
   this->Tolerance = 1e-6;
   this->Operation = VTK_UNION;
   this->ReorientDifferenceCells = 1;
+  this->ParallelIntersection = 0;
 
   this->SetNumberOfInputPorts(2);
   this->SetNumberOfOutputPorts(2);
@@ -88,6 +89,7 @@ int vtkBooleanOperationPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(re
   PolyDataIntersection->SetInputConnection(1, this->GetInputConnection(1, 0));
   PolyDataIntersection->SplitFirstOutputOn();
   PolyDataIntersection->SplitSecondOutputOn();
+  PolyDataIntersection->SetParallelIntersection(this->ParallelIntersection);
   PolyDataIntersection->SetContainerAlgorithm(this);
   PolyDataIntersection->Update();
 
@@ -229,6 +231,7 @@ void vtkBooleanOperationPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << "\n";
   os << indent << "ReorientDifferenceCells: " << this->ReorientDifferenceCells << "\n";
+  os << indent << "ParallelIntersection: " << this->ParallelIntersection << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -82,6 +82,17 @@ public:
   vtkGetMacro(Tolerance, double);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the parallel search of the intersections between the two
+   * input surfaces. See vtkIntersectionPolyDataFilter::SetParallelIntersection.
+   * Defaults to off.
+   */
+  vtkSetMacro(ParallelIntersection, vtkTypeBool);
+  vtkGetMacro(ParallelIntersection, vtkTypeBool);
+  vtkBooleanMacro(ParallelIntersection, vtkTypeBool);
+  ///@}
+
 protected:
   vtkBooleanOperationPolyDataFilter();
   ~vtkBooleanOperationPolyDataFilter() override;
@@ -126,6 +137,11 @@ private:
    */
   vtkTypeBool ReorientDifferenceCells;
   ///@}
+
+  /**
+   * Whether the intersections are searched in parallel.
+   */
+  vtkTypeBool ParallelIntersection;
 };
 
 VTK_ABI_NAMESPACE_END
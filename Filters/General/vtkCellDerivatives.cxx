@@ -10,9 +10,13 @@
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkInformation.h"
+#include "vtkIdList.h"
 #include "vtkInformationVector.h"
+#include "vtkLinearCellKernels.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
@@ -57,8 +61,13 @@ struct CellDerivatives
   int ComputeVectorDerivs;
   int ComputeVorticity;
 
+  // The points of point sets, for the linear cells computed without vtkCell
+  bool LinearCells;
+  vtkSmartPointer<vtkDataArray> Points;
+
   // A convenience to avoid repeated allocations
   vtkSMPThreadLocal<vtkSmartPointer<vtkGenericCell>> Cell;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> CellPointIds;
   vtkSMPThreadLocal<vtkSmartPointer<vtkDoubleArray>> CellScalars;
   vtkSMPThreadLocal<vtkSmartPointer<vtkDoubleArray>> CellVectors;
   vtkCellDerivatives* Filter;
@@ -76,6 +85,7 @@ struct CellDerivatives
     , ComputeScalarDerivs(csd)
     , ComputeVectorDerivs(cvd)
     , ComputeVorticity(cv)
+    , LinearCells(false)
     , Filter(filter)
   {
     if (this->ComputeScalarDerivs)
@@ -91,11 +101,23 @@ struct CellDerivatives
         pd->BuildCells();
       }
     }
+    vtkPointSet* ps = vtkPointSet::SafeDownCast(input);
+    if (ps && ps->GetPoints())
+    {
+      this->LinearCells = true;
+      this->Points = ps->GetPoints()->GetData();
+    }
+    else
+    {
+      this->Points = vtkSmartPointer<vtkDoubleArray>::New();
+      this->Points->SetNumberOfComponents(3);
+    }
   }
 
   void Initialize()
   {
     this->Cell.Local().TakeReference(vtkGenericCell::New());
+    this->CellPointIds.Local().TakeReference(vtkIdList::New());
     this->CellScalars.Local().TakeReference(vtkDoubleArray::New());
     if (this->ComputeScalarDerivs)
     {
@@ -112,6 +134,8 @@ struct CellDerivatives
     int subId;
     double pcoords[3], derivs[9], tens[9], w[3], *scalars, *vectors;
     vtkGenericCell* cell = this->Cell.Local();
+    vtkIdList* cellPointIds = this->CellPointIds.Local();
+    double x[3 * vtkLinearCellKernels::MaximumNumberOfPoints];
     vtkDoubleArray* cellScalars = this->CellScalars.Local();
     vtkDoubleArray* cellVectors = this->CellVectors.Local();
     vtkDoubleArray* outGradients = this->OutGradients;
@@ -123,6 +147,7 @@ struct CellDerivatives
     int computeVectorDerivs = this->ComputeVectorDerivs;
     int computeVorticity = this->ComputeVorticity;
     bool isFirst = vtkSMPTools::GetSingleThread();
+    const auto points = vtk::DataArrayTupleRange<3>(this->Points);
 
     for (; cellId < endCellId; ++cellId)
     {
@@ -134,24 +159,55 @@ struct CellDerivatives
       {
         break;
       }
-      this->Input->GetCell(cellId, cell);
-      subId = cell->GetParametricCenter(pcoords);
+      // Linear cells of point sets avoid copying the cell and its virtual
+      // calls, the other cells go through vtkCell.
+      const int cellType = this->LinearCells ? this->Input->GetCellType(cellId) : VTK_EMPTY_CELL;
+      const bool linear = vtkLinearCellKernels::IsSupported(cellType);
+      vtkIdList* ptIds;
+      if (linear)
+      {
+        ptIds = cellPointIds;
+        this->Input->GetCellPoints(cellId, ptIds);
+        vtkLinearCellKernels::GatherPoints(
+          points, ptIds->GetNumberOfIds(), ptIds->GetPointer(0), x);
+        vtkLinearCellKernels::ParametricCenter(cellType, pcoords);
+      }
+      else
+      {
+        this->Input->GetCell(cellId, cell);
+        subId = cell->GetParametricCenter(pcoords);
+        ptIds = cell->PointIds;
+      }
 
       if (computeScalarDerivs)
       {
-        cellScalars->SetNumberOfTuples(cell->GetNumberOfPoints());
-        inScalars->GetTuples(cell->PointIds, cellScalars);
+        cellScalars->SetNumberOfTuples(ptIds->GetNumberOfIds());
+        inScalars->GetTuples(ptIds, cellScalars);
         scalars = cellScalars->GetPointer(0);
-        cell->Derivatives(subId, pcoords, scalars, 1, derivs);
+        if (linear)
+        {
+          vtkLinearCellKernels::Derivatives(cellType, x, pcoords, scalars, 1, derivs);
+        }
+        else
+        {
+          cell->Derivatives(subId, pcoords, scalars, 1, derivs);
+        }
         outGradients->SetTuple(cellId, derivs);
       }
 
       if (computeVectorDerivs || computeVorticity)
       {
-        cellVectors->SetNumberOfTuples(cell->GetNumberOfPoints());
-        inVectors->GetTuples(cell->PointIds, cellVectors);
+        cellVectors->SetNumberOfTuples(ptIds->GetNumberOfIds());
+        inVectors->GetTuples(ptIds, cellVectors);
         vectors = cellVectors->GetPointer(0);
-        cell->Derivatives(0, pcoords, vectors, 3, derivs);
+        if (linear)
+        {
+          vtkLinearCellKernels::Derivatives(cellType, x, pcoords, vectors, 3, derivs);
+        }
+        else
+        {
+          cell->Derivatives(0, pcoords, vectors, 3, derivs);
+        }
 
         // Insert appropriate tensor
         if (this->TensorMode == VTK_TENSOR_MODE_COMPUTE_GRADIENT)
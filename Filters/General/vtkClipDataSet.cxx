@@ -16,14 +16,20 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkNonLinearCell.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyhedron.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkClipDataSet);
 vtkCxxSetObjectMacro(vtkClipDataSet, ClipFunction, vtkImplicitFunction);
@@ -118,6 +124,313 @@ vtkUnstructuredGrid* vtkClipDataSet::GetClippedOutput()
   return vtkUnstructuredGrid::SafeDownCast(this->GetExecutive()->GetOutputData(1));
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Return the type of an output cell of npts points generated by clipping
+// cell. isSameCell is true when the cell is passed through as is.
+VTKCellType GetClippedCellType(vtkGenericCell* cell, vtkIdType npts, bool isSameCell)
+{
+  if (isSameCell)
+  {
+    return static_cast<VTKCellType>(cell->GetCellType());
+  }
+  else if (cell->GetCellType() == VTK_POLYHEDRON)
+  {
+    return VTK_POLYHEDRON;
+  }
+  else
+  {
+    switch (cell->GetCellDimension())
+    {
+      case 0: // points are generated--------------------------------
+        return (npts > 1 ? VTK_POLY_VERTEX : VTK_VERTEX);
+
+      case 1: // lines are generated---------------------------------
+        return (npts > 2 ? VTK_POLY_LINE : VTK_LINE);
+
+      case 2: // polygons are generated------------------------------
+        return (npts == 3 ? VTK_TRIANGLE : (npts == 4 ? VTK_QUAD : VTK_POLYGON));
+
+      case 3: // tetrahedra or wedges are generated------------------
+        return (npts == 4 ? VTK_TETRA : VTK_WEDGE);
+
+      default:
+        vtkErrorWithObjectMacro(nullptr, "Dimension cannot be lower than 0 or higher than 3");
+        break;
+    }
+  }
+
+  return VTK_EMPTY_CELL;
+}
+
+//------------------------------------------------------------------------------
+// Clip the cells of an unstructured grid in parallel. Each thread clips
+// ranges of cells with its own cell, locator, points and point data, and
+// produces the connectivity, types and cell data of both outputs.
+struct ClipCellsFunctor
+{
+  struct LocalDataType
+  {
+    vtkSmartPointer<vtkPoints> Points;
+    vtkSmartPointer<vtkIncrementalPointLocator> Locator;
+    vtkSmartPointer<vtkPointData> PointData;
+    vtkSmartPointer<vtkCellArray> Connectivity[2];
+    vtkSmartPointer<vtkUnsignedCharArray> Types[2];
+    vtkSmartPointer<vtkCellData> CellData[2];
+    vtkSmartPointer<vtkGenericCell> Cell;
+    vtkSmartPointer<vtkFloatArray> CellScalars;
+  };
+
+  vtkClipDataSet* Filter;
+  vtkUnstructuredGrid* Input;
+  vtkDataArray* ClipScalars;
+  vtkPointData* InPD;
+  double Value;
+  int NumberOfOutputs;
+  int PointsType;
+  const double* Bounds;
+  vtkIdType EstimatedSize;
+  vtkSMPThreadLocal<LocalDataType> LocalData;
+
+  ClipCellsFunctor(vtkClipDataSet* filter, vtkUnstructuredGrid* input, vtkDataArray* clipScalars,
+    vtkPointData* inPD, double value, int numOutputs, int pointsType, const double* bounds,
+    vtkIdType estimatedSize)
+    : Filter(filter)
+    , Input(input)
+    , ClipScalars(clipScalars)
+    , InPD(inPD)
+    , Value(value)
+    , NumberOfOutputs(numOutputs)
+    , PointsType(pointsType)
+    , Bounds(bounds)
+    , EstimatedSize(estimatedSize)
+  {
+  }
+
+  void Initialize()
+  {
+    LocalDataType& localData = this->LocalData.Local();
+    localData.Points = vtkSmartPointer<vtkPoints>::New();
+    localData.Points->SetDataType(this->PointsType);
+    localData.Points->Allocate(this->EstimatedSize, this->EstimatedSize / 2);
+    vtkIncrementalPointLocator* locator = this->Filter->GetLocator();
+    localData.Locator = vtk::TakeSmartPointer(locator->NewInstance());
+    localData.Locator->SetTolerance(locator->GetTolerance());
+    localData.Locator->InitPointInsertion(localData.Points, this->Bounds);
+    localData.PointData = vtkSmartPointer<vtkPointData>::New();
+    localData.PointData->InterpolateAllocate(
+      this->InPD, this->EstimatedSize, this->EstimatedSize / 2);
+    for (int i = 0; i < this->NumberOfOutputs; ++i)
+    {
+      localData.Connectivity[i] = vtkSmartPointer<vtkCellArray>::New();
+      localData.Connectivity[i]->AllocateEstimate(this->EstimatedSize, 1);
+      localData.Types[i] = vtkSmartPointer<vtkUnsignedCharArray>::New();
+      localData.Types[i]->Allocate(this->EstimatedSize, this->EstimatedSize / 2);
+      localData.CellData[i] = vtkSmartPointer<vtkCellData>::New();
+      localData.CellData[i]->CopyAllocate(
+        this->Input->GetCellData(), this->EstimatedSize, this->EstimatedSize / 2);
+    }
+    localData.Cell = vtkSmartPointer<vtkGenericCell>::New();
+    localData.CellScalars = vtkSmartPointer<vtkFloatArray>::New();
+    localData.CellScalars->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    LocalDataType& localData = this->LocalData.Local();
+    vtkGenericCell* cell = localData.Cell;
+    vtkFloatArray* cellScalars = localData.CellScalars;
+    vtkCellData* inCD = this->Input->GetCellData();
+    bool stableClip = this->Filter->GetStableClipNonLinear();
+    int insideOut = this->Filter->GetInsideOut();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endCellId - cellId) / 10 + 1, (vtkIdType)1000);
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+
+      this->Input->GetCell(cellId, cell);
+      vtkIdList* cellIds = cell->GetPointIds();
+      vtkIdType npts = cellIds->GetNumberOfIds();
+      vtkNonLinearCell* nonLinearCell =
+        vtkNonLinearCell::SafeDownCast(cell->GetRepresentativeCell());
+      for (vtkIdType i = 0; i < npts; i++)
+      {
+        double s = this->ClipScalars->GetComponent(cellIds->GetId(i), 0);
+        cellScalars->InsertTuple(i, &s);
+      }
+
+      for (int i = 0; i < this->NumberOfOutputs; ++i)
+      {
+        vtkCellArray* conn = localData.Connectivity[i];
+        vtkIdType numCells = conn->GetNumberOfCells();
+        bool sameCell = false;
+        if (stableClip && nonLinearCell != nullptr)
+        {
+          sameCell = nonLinearCell->StableClip(this->Value, cellScalars, localData.Locator, conn,
+            this->InPD, localData.PointData, inCD, cellId, localData.CellData[i], insideOut);
+        }
+        else
+        {
+          cell->Clip(this->Value, cellScalars, localData.Locator, conn, this->InPD,
+            localData.PointData, inCD, cellId, localData.CellData[i], insideOut);
+        }
+        for (vtkIdType newCellId = numCells; newCellId < conn->GetNumberOfCells(); ++newCellId)
+        {
+          localData.Types[i]->InsertNextValue(
+            GetClippedCellType(cell, conn->GetCellSize(newCellId), sameCell));
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Append the cells of a thread to an output, mapping their point ids through
+// the point map of the thread. Polyhedra are stored as face streams, whose
+// face sizes must not be mapped.
+void AppendClippedCells(vtkCellArray* cells, vtkUnsignedCharArray* types,
+  const std::vector<vtkIdType>& pointMap, vtkCellArray* outCells, vtkUnsignedCharArray* outTypes)
+{
+  std::vector<vtkIdType> ids;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < cells->GetNumberOfCells(); ++cellId)
+  {
+    cells->GetCellAtId(cellId, npts, pts);
+    unsigned char type = types->GetValue(cellId);
+    ids.assign(pts, pts + npts);
+    if (type == VTK_POLYHEDRON)
+    {
+      for (vtkIdType face = 0, i = 1; face < pts[0] && i < npts; ++face)
+      {
+        for (vtkIdType end = i + 1 + pts[i]; ++i < end;)
+        {
+          ids[i] = pointMap[pts[i]];
+        }
+      }
+    }
+    else
+    {
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        ids[i] = pointMap[pts[i]];
+      }
+    }
+    outCells->InsertNextCell(npts, ids.data());
+    outTypes->InsertNextValue(type);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Clip the cells of an unstructured grid in parallel, then merge the points
+// of the threads with the locator of the filter and gather the cells and
+// attributes of the threads in the outputs.
+void ClipUnstructuredGrid(vtkClipDataSet* filter, vtkUnstructuredGrid* input,
+  vtkDataArray* clipScalars, vtkPointData* inPD, double value, int numOutputs,
+  vtkIdType estimatedSize, vtkPoints* newPoints, vtkUnstructuredGrid* outputs[2])
+{
+  // GetBounds is not thread safe, compute the bounds before threading.
+  double bounds[6];
+  input->GetBounds(bounds);
+  ClipCellsFunctor functor(filter, input, clipScalars, inPD, value, numOutputs,
+    newPoints->GetDataType(), bounds, estimatedSize);
+  vtkSMPTools::For(0, input->GetNumberOfCells(), functor);
+
+  std::vector<ClipCellsFunctor::LocalDataType*> threads;
+  for (auto& localData : functor.LocalData)
+  {
+    threads.push_back(&localData);
+  }
+  int numThreads = static_cast<int>(threads.size());
+
+  vtkDataSetAttributes::FieldList ptList(numThreads);
+  vtkIdType numPts = 0;
+  for (int t = 0; t < numThreads; ++t)
+  {
+    numPts += threads[t]->Points->GetNumberOfPoints();
+    if (t == 0)
+    {
+      ptList.InitializeFieldList(threads[t]->PointData);
+    }
+    else
+    {
+      ptList.IntersectFieldList(threads[t]->PointData);
+    }
+  }
+
+  // Merge the points shared by the cells of different threads.
+  vtkIncrementalPointLocator* locator = filter->GetLocator();
+  locator->InitPointInsertion(newPoints, bounds, numPts);
+  vtkPointData* outPD = outputs[0]->GetPointData();
+  outPD->InterpolateAllocate(ptList, numPts);
+  std::vector<std::vector<vtkIdType>> pointMaps(numThreads);
+  for (int t = 0; t < numThreads; ++t)
+  {
+    vtkPoints* points = threads[t]->Points;
+    std::vector<vtkIdType>& pointMap = pointMaps[t];
+    pointMap.resize(points->GetNumberOfPoints());
+    double x[3];
+    for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+    {
+      points->GetPoint(ptId, x);
+      if (locator->InsertUniquePoint(x, pointMap[ptId]))
+      {
+        outPD->CopyData(ptList, threads[t]->PointData, t, ptId, pointMap[ptId]);
+      }
+    }
+  }
+
+  for (int i = 0; i < numOutputs; ++i)
+  {
+    vtkDataSetAttributes::FieldList cellList(numThreads);
+    vtkIdType numCells = 0;
+    for (int t = 0; t < numThreads; ++t)
+    {
+      numCells += threads[t]->Types[i]->GetNumberOfValues();
+      if (t == 0)
+      {
+        cellList.InitializeFieldList(threads[t]->CellData[i]);
+      }
+      else
+      {
+        cellList.IntersectFieldList(threads[t]->CellData[i]);
+      }
+    }
+    vtkNew<vtkCellArray> conn;
+    conn->AllocateEstimate(numCells, 1);
+    vtkNew<vtkUnsignedCharArray> types;
+    types->Allocate(numCells);
+    vtkCellData* outCD = outputs[i]->GetCellData();
+    outCD->CopyAllocate(cellList, numCells);
+    for (int t = 0; t < numThreads; ++t)
+    {
+      vtkIdType offset = types->GetNumberOfValues();
+      AppendClippedCells(threads[t]->Connectivity[i], threads[t]->Types[i], pointMaps[t], conn,
+        types);
+      outCD->CopyData(
+        cellList, threads[t]->CellData[i], t, offset, types->GetNumberOfValues() - offset, 0);
+    }
+    outputs[i]->SetPoints(newPoints);
+    outputs[i]->SetCells(types, conn);
+  }
+}
+}
+
 //------------------------------------------------------------------------------
 //
 // Clip through data generating surface.
@@ -286,11 +599,21 @@ int vtkClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
     {
       inPD->SetScalars(tmpScalars);
     }
-    double pt[3];
-    for (i = 0; i < numPts; i++)
+    vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
+    if (inputPointSet)
     {
-      input->GetPoint(i, pt);
-      tmpScalars->SetValue(i, this->ClipFunction->FunctionValue(pt));
+      // Evaluate all the points at once, which implicit functions may do in
+      // parallel.
+      this->ClipFunction->FunctionValue(inputPointSet->GetPoints()->GetData(), tmpScalars);
+    }
+    else
+    {
+      double pt[3];
+      for (i = 0; i < numPts; i++)
+      {
+        input->GetPoint(i, pt);
+        tmpScalars->SetValue(i, this->ClipFunction->FunctionValue(pt));
+      }
     }
     clipScalars = tmpScalars;
   }
@@ -322,6 +645,27 @@ int vtkClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
   //  {
   //  outPD->CopyScalarsOn();
   //  }
+  vtkUnstructuredGrid* ugrid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (ugrid && !this->SequentialProcessing)
+  {
+    double value = 0.0;
+    if (this->UseValueAsOffset || !this->ClipFunction)
+    {
+      value = this->Value;
+    }
+    vtkUnstructuredGrid* outputs[2] = { output, clippedOutput };
+    ClipUnstructuredGrid(
+      this, ugrid, clipScalars, inPD, value, numOutputs, estimatedSize, newPoints, outputs);
+    if (this->ClipFunction)
+    {
+      clipScalars->Delete();
+      inPD->Delete();
+    }
+    this->Locator->Initialize(); // release any extra memory
+    output->Squeeze();
+    return 1;
+  }
+
   vtkDataSetAttributes* tempDSA = vtkDataSetAttributes::New();
   tempDSA->InterpolateAllocate(inPD, 1, 2);
   outPD->InterpolateAllocate(inPD, estimatedSize, estimatedSize / 2);
@@ -392,46 +736,12 @@ int vtkClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
       }
     }
 
-    auto getCellType = [](vtkGenericCell* gCell, vtkIdType nPts, bool isSameCell) {
-      if (isSameCell)
-      {
-        return static_cast<VTKCellType>(gCell->GetCellType());
-      }
-      else if (gCell->GetCellType() == VTK_POLYHEDRON)
-      {
-        return VTK_POLYHEDRON;
-      }
-      else
-      {
-        switch (gCell->GetCellDimension())
-        {
-          case 0: // points are generated--------------------------------
-            return (nPts > 1 ? VTK_POLY_VERTEX : VTK_VERTEX);
-
-          case 1: // lines are generated---------------------------------
-            return (nPts > 2 ? VTK_POLY_LINE : VTK_LINE);
-
-          case 2: // polygons are generated------------------------------
-            return (nPts == 3 ? VTK_TRIANGLE : (nPts == 4 ? VTK_QUAD : VTK_POLYGON));
-
-          case 3: // tetrahedra or wedges are generated------------------
-            return (nPts == 4 ? VTK_TETRA : VTK_WEDGE);
-
-          default:
-            vtkErrorWithObjectMacro(nullptr, "Dimension cannot be lower than 0 or higher than 3");
-            break;
-        }
-      }
-
-      return VTK_EMPTY_CELL;
-    };
-
     for (i = 0; i < numOutputs; i++)
     {
       for (j = 0; j < numNew[i]; j++)
       {
         conn[i]->GetNextCell(npts, pts);
-        types[i]->InsertNextValue(getCellType(cell, npts, sameCell[i]));
+        types[i]->InsertNextValue(GetClippedCellType(cell, npts, sameCell[i]));
       }
     }
   }
@@ -658,5 +968,7 @@ void vtkClipDataSet::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UseValueAsOffset: " << (this->UseValueAsOffset ? "On\n" : "Off\n");
 
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
+  os << indent << "StableClipNonLinear: " << (this->StableClipNonLinear ? "On\n" : "Off\n");
+  os << indent << "SequentialProcessing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -191,6 +191,19 @@ public:
   vtkBooleanMacro(StableClipNonLinear, bool);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the clipping. By
+   * default, sequential processing is off: the cells of a vtkUnstructuredGrid,
+   * including polyhedra and higher order cells, are clipped in parallel with
+   * vtkSMPTools. The order of the output points and cells then depends on the
+   * number of threads.
+   */
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkClipDataSet(vtkImplicitFunction* cf = nullptr);
   ~vtkClipDataSet() override;
@@ -223,6 +236,7 @@ protected:
   int OutputPointsPrecision;
 
   bool StableClipNonLinear = true;
+  bool SequentialProcessing = false;
 
 private:
   vtkClipDataSet(const vtkClipDataSet&) = delete;
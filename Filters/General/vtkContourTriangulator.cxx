@@ -544,9 +544,10 @@ void vtkCCSMakePolysFromLines(vtkPolyData* data, vtkIdType firstLine, vtkIdType
   // Bitfield for marking lines as used
   vtkCCSBitArray usedLines;
 
-  // Require cell links to get lines from pointIds
-  data->EditableOn();
-  data->BuildLinks(data->GetPoints()->GetNumberOfPoints());
+  // Require cell links to get lines from pointIds. The links are only read,
+  // so the data is not made editable and the static links are built in
+  // parallel, unless the data is already editable.
+  data->BuildLinks(data->GetEditable() ? data->GetPoints()->GetNumberOfPoints() : 0);
 
   size_t numNewPolys = 0;
   vtkIdType remainingLines = endLine - firstLine;
@@ -16,11 +16,16 @@
 #include "vtkPolyData.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinksTemplate.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 #include "vtkTriangleStrip.h"
 
-#include <memory> // For unique_ptr
+#include <algorithm>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCurvatures);
@@ -62,12 +67,9 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
     return;
   }
 
-  int numPts = polyData->GetNumberOfPoints();
+  const vtkIdType numPts = polyData->GetNumberOfPoints();
 
   //     create-allocate
-  const vtkNew<vtkIdList> vertices;
-  const vtkNew<vtkIdList> vertices_n;
-  const vtkNew<vtkIdList> neighbours;
   const vtkNew<vtkDoubleArray> meanCurvature;
   meanCurvature->SetName("Mean_Curvature");
   meanCurvature->SetNumberOfComponents(1);
@@ -75,130 +77,160 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
   // Get the array so we can write to it directly
   double* meanCurvatureData = meanCurvature->GetPointer(0);
 
-  //     create-allocate
-  double n_f[3]; // normal of facet (could be stored for later?)
-  double n_n[3]; // normal of edge
-  double t[3];   // to store the cross product of n_f n_n
-  double ore[3]; // origin of e
-  double end[3]; // end of e
-  double oth[3]; //     third vertex necessary for comp of n
-  double vn0[3];
-  double vn1[3]; // vertices for computation of neighbour's n
-  double vn2[3];
-  double e[3]; // edge (oriented)
-
+  // GetPointCells() and GetCellEdgeNeighbors() are thread safe once the
+  // links are built.
   polyData->BuildLinks();
-  // data init
-  const int F = polyData->GetNumberOfCells();
-  // init, preallocate the mean curvature
-  const std::unique_ptr<int[]> num_neighb(new int[numPts]);
-  for (int v = 0; v < numPts; v++)
+
+  // Compute the curvature contribution of the edge (v_l, v_r) of facet f with
+  // vertex v_o, if the edge has a single neighbor n > f, so that every edge
+  // comes only once.
+  auto edgeCurvature = [polyData](vtkIdType f, vtkIdType v_l, vtkIdType v_r, vtkIdType v_o,
+                         vtkIdList* vertices_n, vtkIdList* neighbours, double& Hf) -> bool
   {
-    meanCurvatureData[v] = 0.0;
-    num_neighb[v] = 0;
-  }
+    polyData->GetCellEdgeNeighbors(f, v_l, v_r, neighbours);
 
-  //     main loop
-  vtkDebugMacro(<< "Main loop: loop over facets such that id > id of neighb");
-  vtkDebugMacro(<< "so that every edge comes only once");
+    vtkIdType n; // n short for neighbor
 
-  for (vtkIdType f = 0; f < F; ++f)
-  {
-    if (this->CheckAbort())
+    // compute only if there is really ONE neighbour
+    // AND meanCurvature has not been computed yet!
+    // (ensured by n > f)
+    if (neighbours->GetNumberOfIds() != 1 || (n = neighbours->GetId(0)) <= f)
     {
-      break;
+      return false;
     }
-    polyData->GetCellPoints(f, vertices);
-    const vtkIdType nv = vertices->GetNumberOfIds();
 
-    for (vtkIdType v = 0; v < nv; v++)
+    double n_f[3]; // normal of facet (could be stored for later?)
+    double n_n[3]; // normal of edge
+    double t[3];   // to store the cross product of n_f n_n
+    double ore[3]; // origin of e
+    double end[3]; // end of e
+    double oth[3]; //     third vertex necessary for comp of n
+    double vn0[3];
+    double vn1[3]; // vertices for computation of neighbour's n
+    double vn2[3];
+    double e[3]; // edge (oriented)
+
+    // find 3 corners of f: in order!
+    polyData->GetPoint(v_l, ore);
+    polyData->GetPoint(v_r, end);
+    polyData->GetPoint(v_o, oth);
+    // compute normal of f
+    vtkTriangle::ComputeNormal(ore, end, oth, n_f);
+    // compute common edge
+    e[0] = end[0];
+    e[1] = end[1];
+    e[2] = end[2];
+    e[0] -= ore[0];
+    e[1] -= ore[1];
+    e[2] -= ore[2];
+    const double length = vtkMath::Normalize(e);
+    double Af = vtkTriangle::TriangleArea(ore, end, oth);
+    // find 3 corners of n: in order!
+    polyData->GetCellPoints(n, vertices_n);
+    polyData->GetPoint(vertices_n->GetId(0), vn0);
+    polyData->GetPoint(vertices_n->GetId(1), vn1);
+    polyData->GetPoint(vertices_n->GetId(2), vn2);
+    Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
+    // compute normal of n
+    vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
+    // the cosine is n_f * n_n
+    const double cs = vtkMath::Dot(n_f, n_n);
+    // the sin is (n_f x n_n) * e
+    vtkMath::Cross(n_f, n_n, t);
+    const double sn = vtkMath::Dot(t, e);
+    // signed angle in [-pi,pi]
+    if (sn != 0.0 || cs != 0.0)
     {
-      // get neighbour
-      const vtkIdType v_l = vertices->GetId(v);
-      const vtkIdType v_r = vertices->GetId((v + 1) % nv);
-      const vtkIdType v_o = vertices->GetId((v + 2) % nv);
-      polyData->GetCellEdgeNeighbors(f, v_l, v_r, neighbours);
-
-      vtkIdType n; // n short for neighbor
-
-      // compute only if there is really ONE neighbour
-      // AND meanCurvature has not been computed yet!
-      // (ensured by n > f)
-      if (neighbours->GetNumberOfIds() == 1 && (n = neighbours->GetId(0)) > f)
+      const double angle = atan2(sn, cs);
+      Hf = length * angle;
+    }
+    else
+    {
+      Hf = 0.0;
+    }
+    // weight Hf by the area of the facets
+    if (Af != 0.0)
+    {
+      (Hf /= Af) *= 3.0;
+    }
+    return true;
+  };
+
+  //     main loop
+  vtkDebugMacro(<< "Main loop: each point gathers the edges of its facets");
+
+  // Each point gathers the contributions of the edges of its facets, in
+  // the order of the facets, so that the sums are the ones of a traversal
+  // of the facets whatever the number of threads.
+  vtkSMPThreadLocalObject<vtkIdList> localVertices;
+  vtkSMPThreadLocalObject<vtkIdList> localVerticesN;
+  vtkSMPThreadLocalObject<vtkIdList> localNeighbours;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localCells;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* vertices = localVertices.Local();
+    vtkIdList* vertices_n = localVerticesN.Local();
+    vtkIdList* neighbours = localNeighbours.Local();
+    std::vector<vtkIdType>& cells = localCells.Local();
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    const vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
       {
-        double Hf; // temporary store
-
-        // find 3 corners of f: in order!
-        polyData->GetPoint(v_l, ore);
-        polyData->GetPoint(v_r, end);
-        polyData->GetPoint(v_o, oth);
-        // compute normal of f
-        vtkTriangle::ComputeNormal(ore, end, oth, n_f);
-        // compute common edge
-        e[0] = end[0];
-        e[1] = end[1];
-        e[2] = end[2];
-        e[0] -= ore[0];
-        e[1] -= ore[1];
-        e[2] -= ore[2];
-        const double length = vtkMath::Normalize(e);
-        double Af = vtkTriangle::TriangleArea(ore, end, oth);
-        // find 3 corners of n: in order!
-        polyData->GetCellPoints(n, vertices_n);
-        polyData->GetPoint(vertices_n->GetId(0), vn0);
-        polyData->GetPoint(vertices_n->GetId(1), vn1);
-        polyData->GetPoint(vertices_n->GetId(2), vn2);
-        Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
-        // compute normal of n
-        vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
-        // the cosine is n_f * n_n
-        const double cs = vtkMath::Dot(n_f, n_n);
-        // the sin is (n_f x n_n) * e
-        vtkMath::Cross(n_f, n_n, t);
-        const double sn = vtkMath::Dot(t, e);
-        // signed angle in [-pi,pi]
-        if (sn != 0.0 || cs != 0.0)
+        if (isFirst)
         {
-          const double angle = atan2(sn, cs);
-          Hf = length * angle;
+          this->CheckAbort();
         }
-        else
+        if (this->GetAbortOutput())
         {
-          Hf = 0.0;
+          break;
         }
-        // add weighted Hf to scalar at v_l and v_r
-        if (Af != 0.0)
+      }
+      vtkIdType ncells;
+      vtkIdType* pointCells;
+      polyData->GetPointCells(ptId, ncells, pointCells);
+      cells.assign(pointCells, pointCells + ncells);
+      std::sort(cells.begin(), cells.end());
+      cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+      double H = 0.0;
+      int num_neighb = 0;
+      for (vtkIdType f : cells)
+      {
+        polyData->GetCellPoints(f, vertices);
+        const vtkIdType nv = vertices->GetNumberOfIds();
+        for (vtkIdType v = 0; v < nv; v++)
         {
-          (Hf /= Af) *= 3.0;
+          // get neighbour
+          const vtkIdType v_l = vertices->GetId(v);
+          const vtkIdType v_r = vertices->GetId((v + 1) % nv);
+          const vtkIdType v_o = vertices->GetId((v + 2) % nv);
+          double Hf;
+          if ((v_l == ptId || v_r == ptId) &&
+            edgeCurvature(f, v_l, v_r, v_o, vertices_n, neighbours, Hf))
+          {
+            // add weighted Hf to scalar at v_l and v_r
+            for (int i = (v_l == ptId) + (v_r == ptId); i > 0; --i)
+            {
+              H += Hf;
+              ++num_neighb;
+            }
+          }
         }
-        meanCurvatureData[v_l] += Hf;
-        meanCurvatureData[v_r] += Hf;
-        num_neighb[v_l] += 1;
-        num_neighb[v_r] += 1;
       }
-    }
-  }
 
-  // put curvature in vtkArray
-  for (int v = 0; v < numPts; v++)
-  {
-    if (num_neighb[v] > 0)
-    {
-      const double Hf = 0.5 * meanCurvatureData[v] / num_neighb[v];
-      if (this->InvertMeanCurvature)
+      // put curvature in vtkArray
+      if (num_neighb > 0)
       {
-        meanCurvatureData[v] = -Hf;
+        const double Hf = 0.5 * H / num_neighb;
+        meanCurvatureData[ptId] = this->InvertMeanCurvature ? -Hf : Hf;
       }
       else
       {
-        meanCurvatureData[v] = Hf;
+        meanCurvatureData[ptId] = 0.0;
       }
     }
-    else
-    {
-      meanCurvatureData[v] = 0.0;
-    }
-  }
+  });
 
   mesh->GetPointData()->AddArray(meanCurvature);
   mesh->GetPointData()->SetActiveScalars("Mean_Curvature");
@@ -261,80 +293,111 @@ void vtkCurvatures::GetGaussCurvature(vtkPolyData* output)
 void vtkCurvatures::ComputeGaussCurvature(
   vtkCellArray* facets, vtkPolyData* output, double* gaussCurvatureData)
 {
-  double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
-
-  double A, alpha0, alpha1, alpha2;
-
-  vtkIdType f;
-  const vtkIdType* vert = nullptr;
-
   // other data
-  vtkIdType Nv = output->GetNumberOfPoints();
-
-  const std::unique_ptr<double[]> K(new double[Nv]);
-  const std::unique_ptr<double[]> dA(new double[Nv]);
-  double pi2 = 2.0 * vtkMath::Pi();
-  for (int k = 0; k < Nv; k++)
-  {
-    K[k] = pi2;
-    dA[k] = 0.0;
-  }
-
-  facets->InitTraversal();
-  while (facets->GetNextCell(f, vert))
-  {
-    if (this->CheckAbort())
+  const vtkIdType Nv = output->GetNumberOfPoints();
+  const vtkIdType numFacets = facets->GetNumberOfCells();
+
+  // The links of the facets, built once, let each point gather the angles
+  // and areas of its facets in parallel.
+  vtkStaticCellLinksTemplate<vtkIdType> links;
+  links.ThreadedBuildLinks(Nv, numFacets, facets);
+
+  const double pi2 = 2.0 * vtkMath::Pi();
+  vtkSMPThreadLocalObject<vtkIdList> localVertices;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localFacets;
+  vtkSMPTools::For(0, Nv, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* vertices = localVertices.Local();
+    std::vector<vtkIdType>& pointFacets = localFacets.Local();
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    const vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
     {
-      break;
-    }
-    output->GetPoint(vert[0], v0);
-    output->GetPoint(vert[1], v1);
-    output->GetPoint(vert[2], v2);
-    // edges
-    e0[0] = v1[0];
-    e0[1] = v1[1];
-    e0[2] = v1[2];
-    e0[0] -= v0[0];
-    e0[1] -= v0[1];
-    e0[2] -= v0[2];
-
-    e1[0] = v2[0];
-    e1[1] = v2[1];
-    e1[2] = v2[2];
-    e1[0] -= v1[0];
-    e1[1] -= v1[1];
-    e1[2] -= v1[2];
-
-    e2[0] = v0[0];
-    e2[1] = v0[1];
-    e2[2] = v0[2];
-    e2[0] -= v2[0];
-    e2[1] -= v2[1];
-    e2[2] -= v2[2];
-
-    alpha0 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e1, e2);
-    alpha1 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e2, e0);
-    alpha2 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e0, e1);
-
-    // surf. area
-    A = double(vtkTriangle::TriangleArea(v0, v1, v2));
-    // UPDATE
-    dA[vert[0]] += A;
-    dA[vert[1]] += A;
-    dA[vert[2]] += A;
-    K[vert[0]] -= alpha1;
-    K[vert[1]] -= alpha2;
-    K[vert[2]] -= alpha0;
-  }
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      // Gather the facets in their order, so that the sums are the ones of
+      // a traversal of the facets whatever the number of threads.
+      const vtkIdType* cells = links.GetCells(ptId);
+      pointFacets.assign(cells, cells + links.GetNcells(ptId));
+      std::sort(pointFacets.begin(), pointFacets.end());
+      pointFacets.erase(std::unique(pointFacets.begin(), pointFacets.end()), pointFacets.end());
+
+      double K = pi2;
+      double dA = 0.0;
+      for (vtkIdType f : pointFacets)
+      {
+        vtkIdType npts;
+        const vtkIdType* vert;
+        facets->GetCellAtId(f, npts, vert, vertices);
+        if (vert[0] != ptId && vert[1] != ptId && vert[2] != ptId)
+        {
+          continue; // only the first three points make the facet
+        }
+        output->GetPoint(vert[0], v0);
+        output->GetPoint(vert[1], v1);
+        output->GetPoint(vert[2], v2);
+        // edges
+        e0[0] = v1[0];
+        e0[1] = v1[1];
+        e0[2] = v1[2];
+        e0[0] -= v0[0];
+        e0[1] -= v0[1];
+        e0[2] -= v0[2];
+
+        e1[0] = v2[0];
+        e1[1] = v2[1];
+        e1[2] = v2[2];
+        e1[0] -= v1[0];
+        e1[1] -= v1[1];
+        e1[2] -= v1[2];
+
+        e2[0] = v0[0];
+        e2[1] = v0[1];
+        e2[2] = v0[2];
+        e2[0] -= v2[0];
+        e2[1] -= v2[1];
+        e2[2] -= v2[2];
+
+        // surf. area
+        const double A = double(vtkTriangle::TriangleArea(v0, v1, v2));
+        // UPDATE
+        for (int i = 0; i < 3; ++i)
+        {
+          if (vert[i] == ptId)
+          {
+            dA += A;
+          }
+        }
+        if (vert[0] == ptId)
+        {
+          K -= vtkMath::Pi() - vtkMath::AngleBetweenVectors(e2, e0); // alpha1
+        }
+        if (vert[1] == ptId)
+        {
+          K -= vtkMath::Pi() - vtkMath::AngleBetweenVectors(e0, e1); // alpha2
+        }
+        if (vert[2] == ptId)
+        {
+          K -= vtkMath::Pi() - vtkMath::AngleBetweenVectors(e1, e2); // alpha0
+        }
+      }
 
-  // put curvature in vtkArray
-  for (int v = 0; v < Nv; v++)
-  {
-    if (dA[v] > 0.0)
-    {
-      gaussCurvatureData[v] = 3.0 * K[v] / dA[v];
+      // put curvature in vtkArray
+      if (dA > 0.0)
+      {
+        gaussCurvatureData[ptId] = 3.0 * K / dA;
+      }
     }
-  }
+  });
 }
 
 void vtkCurvatures::GetMaximumCurvature(vtkPolyData* input, vtkPolyData* output)
@@ -0,0 +1,316 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataSetStreamer.h"
+
+#include "vtkAppendDataSets.h"
+#include "vtkBoundingBox.h"
+#include "vtkDataArray.h"
+#include "vtkDataObjectTypes.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkDataSetStreamer);
+
+//------------------------------------------------------------------------------
+vtkDataSetStreamer::vtkDataSetStreamer()
+  : OutputDataSetType(VTK_UNSTRUCTURED_GRID)
+  , HistogramArrayAssociation(vtkDataObject::FIELD_ASSOCIATION_POINTS)
+{
+  this->SetNumberOfInputPorts(1);
+  this->SetNumberOfOutputPorts(1);
+
+  this->NumberOfPasses = 1;
+  vtkMath::UninitializeBounds(this->Bounds);
+
+  this->Append = vtkAppendDataSets::New();
+  this->Append->SetContainerAlgorithm(this);
+  this->Histogram = vtkIdTypeArray::New();
+  this->Histogram->SetName("Histogram");
+}
+
+//------------------------------------------------------------------------------
+vtkDataSetStreamer::~vtkDataSetStreamer()
+{
+  this->Append->Delete();
+  this->Histogram->Delete();
+  this->SetHistogramArrayName(nullptr);
+}
+
+//------------------------------------------------------------------------------
+void vtkDataSetStreamer::SetInitialNumberOfPieces(int num)
+{
+  num = std::max(num, 1);
+  if (this->InitialNumberOfPieces == num)
+  {
+    return;
+  }
+  this->InitialNumberOfPieces = num;
+  this->NumberOfPasses = num;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkIdTypeArray* vtkDataSetStreamer::GetHistogram()
+{
+  return this->HistogramArrayName ? this->Histogram : nullptr;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeBool vtkDataSetStreamer::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+  {
+    return this->RequestDataObject(request, inputVector, outputVector);
+  }
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//------------------------------------------------------------------------------
+int vtkDataSetStreamer::RequestDataObject(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  if (this->OutputDataSetType != VTK_UNSTRUCTURED_GRID && this->OutputDataSetType != VTK_POLY_DATA)
+  {
+    vtkErrorMacro(<< "Unsupported output type: " << this->OutputDataSetType);
+    return 0;
+  }
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!output || output->GetDataObjectType() != this->OutputDataSetType)
+  {
+    vtkSmartPointer<vtkDataObject> newOutput =
+      vtk::TakeSmartPointer(vtkDataObjectTypes::NewDataObject(this->OutputDataSetType));
+    outInfo->Set(vtkDataObject::DATA_OBJECT(), newOutput);
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkDataSetStreamer::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+
+  int outPiece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  int outNumPieces = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+    outPiece * this->NumberOfPasses + this->CurrentIndex);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+    outNumPieces * this->NumberOfPasses);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkDataSetStreamer::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (this->CurrentIndex == 0)
+  {
+    this->ResetReductions();
+  }
+
+  vtkDataSet* input = vtkDataSet::GetData(inputVector[0], 0);
+  const unsigned long pieceSize = input ? input->GetActualMemorySize() : 0;
+  const unsigned int maximumNumberOfPieces = static_cast<unsigned int>(this->MaximumNumberOfPieces);
+  if (this->MemoryLimit > 0 && pieceSize > this->MemoryLimit &&
+    this->NumberOfPasses < maximumNumberOfPieces)
+  {
+    // Restart with smaller pieces. At least double the number of pieces so
+    // that the number of restarts stays small when the data is not evenly
+    // distributed.
+    const double ratio = static_cast<double>(pieceSize) / this->MemoryLimit;
+    const double estimate = std::ceil(this->NumberOfPasses * ratio);
+    const unsigned int numberOfPieces = static_cast<unsigned int>(
+      std::min(std::max(estimate, 2.0 * this->NumberOfPasses), double(maximumNumberOfPieces)));
+    vtkDebugMacro(<< "Piece of " << pieceSize << " KiB exceeds the memory limit, streaming "
+                  << numberOfPieces << " pieces instead of " << this->NumberOfPasses);
+    this->NumberOfPasses = numberOfPieces;
+    this->CurrentIndex = 0;
+    request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+    return 1;
+  }
+  if (this->MemoryLimit > 0 && pieceSize > this->MemoryLimit)
+  {
+    vtkWarningMacro(<< "Piece of " << pieceSize << " KiB exceeds the memory limit with "
+                    << this->NumberOfPasses << " pieces.");
+  }
+  this->MaximumPieceMemorySize = std::max(this->MaximumPieceMemorySize, pieceSize);
+
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
+//------------------------------------------------------------------------------
+void vtkDataSetStreamer::ResetReductions()
+{
+  this->MaximumPieceMemorySize = 0;
+  vtkMath::UninitializeBounds(this->Bounds);
+  this->Append->RemoveAllInputConnections(0);
+  this->Histogram->SetNumberOfTuples(this->NumberOfHistogramBins);
+  this->Histogram->FillValue(0);
+}
+
+//------------------------------------------------------------------------------
+int vtkDataSetStreamer::ExecutePass(
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
+{
+  vtkDataSet* input = vtkDataSet::GetData(inputVector[0], 0);
+  if (!input)
+  {
+    return 1;
+  }
+
+  if (input->GetNumberOfPoints() > 0)
+  {
+    if (vtkMath::AreBoundsInitialized(this->Bounds))
+    {
+      vtkBoundingBox bounds(this->Bounds);
+      bounds.AddBounds(input->GetBounds());
+      bounds.GetBounds(this->Bounds);
+    }
+    else
+    {
+      input->GetBounds(this->Bounds);
+    }
+  }
+
+  if (this->HistogramArrayName)
+  {
+    this->AddToHistogram(input);
+  }
+
+  if (this->AppendPieces)
+  {
+    // The input is replaced by the next piece, keep a shallow copy.
+    vtkSmartPointer<vtkDataSet> copy = vtk::TakeSmartPointer(input->NewInstance());
+    copy->ShallowCopy(input);
+    this->Append->AddInputData(copy);
+  }
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkDataSetStreamer::AddToHistogram(vtkDataSet* input)
+{
+  vtkDataSetAttributes* attributes = input->GetAttributes(
+    this->HistogramArrayAssociation == vtkDataObject::FIELD_ASSOCIATION_CELLS
+      ? vtkDataObject::CELL
+      : vtkDataObject::POINT);
+  vtkDataArray* array = attributes->GetArray(this->HistogramArrayName);
+  if (!array)
+  {
+    return;
+  }
+  const int component = this->HistogramArrayComponent;
+  if (component < 0 || component >= array->GetNumberOfComponents())
+  {
+    vtkWarningMacro(<< "No component " << component << " in " << this->HistogramArrayName);
+    return;
+  }
+
+  const int numberOfBins = this->NumberOfHistogramBins;
+  const double minimum = this->HistogramRange[0];
+  const double width = this->HistogramRange[1] - minimum;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localBins;
+  vtkSMPTools::For(0, array->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+    std::vector<vtkIdType>& bins = localBins.Local();
+    bins.resize(numberOfBins, 0);
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const double value = array->GetComponent(i, component);
+      if (!(value >= minimum && value <= minimum + width))
+      {
+        continue;
+      }
+      int bin = width > 0.0 ? static_cast<int>((value - minimum) / width * numberOfBins) : 0;
+      ++bins[std::min(bin, numberOfBins - 1)];
+    }
+  });
+
+  vtkIdType* histogram = this->Histogram->GetPointer(0);
+  for (const std::vector<vtkIdType>& bins : localBins)
+  {
+    for (int i = 0; i < static_cast<int>(bins.size()); ++i)
+    {
+      histogram[i] += bins[i];
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkDataSetStreamer::PostExecute(
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
+{
+  vtkDataSet* output = vtkDataSet::GetData(outputVector, 0);
+  this->NumberOfPieces = static_cast<int>(this->NumberOfPasses);
+  this->NumberOfPasses = this->InitialNumberOfPieces;
+
+  if (this->AppendPieces && this->Append->GetNumberOfInputConnections(0) > 0)
+  {
+    this->Append->SetOutputDataSetType(this->OutputDataSetType);
+    this->Append->Update();
+    output->ShallowCopy(this->Append->GetOutputDataObject(0));
+    this->Append->RemoveAllInputConnections(0);
+    this->Append->GetOutputDataObject(0)->Initialize();
+  }
+  else
+  {
+    output->Initialize();
+  }
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkDataSetStreamer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "MemoryLimit: " << this->MemoryLimit << endl;
+  os << indent << "InitialNumberOfPieces: " << this->InitialNumberOfPieces << endl;
+  os << indent << "MaximumNumberOfPieces: " << this->MaximumNumberOfPieces << endl;
+  os << indent << "NumberOfPieces: " << this->NumberOfPieces << endl;
+  os << indent << "MaximumPieceMemorySize: " << this->MaximumPieceMemorySize << endl;
+  os << indent << "AppendPieces: " << this->AppendPieces << endl;
+  os << indent << "OutputDataSetType: " << this->OutputDataSetType << endl;
+  os << indent << "HistogramArrayName: "
+     << (this->HistogramArrayName ? this->HistogramArrayName : "(none)") << endl;
+  os << indent << "HistogramArrayAssociation: " << this->HistogramArrayAssociation << endl;
+  os << indent << "HistogramArrayComponent: " << this->HistogramArrayComponent << endl;
+  os << indent << "HistogramRange: " << this->HistogramRange[0] << ", " << this->HistogramRange[1]
+     << endl;
+  os << indent << "NumberOfHistogramBins: " << this->NumberOfHistogramBins << endl;
+}
+
+//------------------------------------------------------------------------------
+int vtkDataSetStreamer::FillOutputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataSet");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkDataSetStreamer::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+  return 1;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkDataSetStreamer
+ * @brief   stream any dataset through its input pipeline under a memory limit
+ *
+ * vtkDataSetStreamer updates its input pipeline piece by piece, using the
+ * UPDATE_PIECE_NUMBER and UPDATE_NUMBER_OF_PIECES requests of
+ * vtkStreamingDemandDrivenPipeline, and reduces the pieces as they are
+ * produced:
+ *
+ * - the bounds of all the pieces are accumulated, see GetBounds(),
+ * - when HistogramArrayName is set, the values of that array are binned in
+ *   a histogram, see GetHistogram(),
+ * - when AppendPieces is on, the pieces are appended to the output with
+ *   vtkAppendDataSets. The pieces should then be small, for instance the
+ *   surface extracted by a vtkDataSetSurfaceFilter connected upstream with
+ *   OutputDataSetType set to VTK_POLY_DATA.
+ *
+ * The number of pieces is chosen from the memory limit: the streaming starts
+ * with InitialNumberOfPieces pieces. When the memory size of a piece exceeds
+ * MemoryLimit, the streaming restarts with enough pieces for the pieces to fit
+ * in memory, assuming the data is evenly distributed among them. As readers
+ * partition the data differently for different numbers of pieces, the pieces
+ * already reduced are discarded. Set InitialNumberOfPieces to a reasonable
+ * estimate to avoid executing the first piece of a dataset that does not fit
+ * in memory.
+ *
+ * @attention
+ * The appended output and the histogram count the duplicated ghost
+ * cells and boundary points of the pieces, if any.
+ *
+ * @sa
+ * vtkPolyDataStreamer vtkMemoryLimitImageDataStreamer vtkStreamerBase
+ */
+
+#ifndef vtkDataSetStreamer_h
+#define vtkDataSetStreamer_h
+
+#include "vtkFiltersGeneralModule.h" // For export macro
+#include "vtkStreamerBase.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAppendDataSets;
+class vtkDataSet;
+class vtkIdTypeArray;
+
+class VTKFILTERSGENERAL_EXPORT vtkDataSetStreamer : public vtkStreamerBase
+{
+public:
+  static vtkDataSetStreamer* New();
+  vtkTypeMacro(vtkDataSetStreamer, vtkStreamerBase);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set / Get the maximum memory size of a piece in kibibytes (1024 bytes).
+   * 0, the default, streams InitialNumberOfPieces pieces.
+   */
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+  ///@}
+
+  ///@{
+  /**
+   * Set / Get the number of pieces the streaming starts with. Default is 1.
+   */
+  void SetInitialNumberOfPieces(int num);
+  vtkGetMacro(InitialNumberOfPieces, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set / Get the maximum number of pieces the streaming can be divided in
+   * to honor MemoryLimit. Default is 65536.
+   */
+  vtkSetClampMacro(MaximumNumberOfPieces, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPieces, int);
+  ///@}
+
+  /**
+   * Return the number of pieces of the last execution.
+   */
+  vtkGetMacro(NumberOfPieces, int);
+
+  /**
+   * Return the memory size in kibibytes of the largest piece of the last
+   * execution.
+   */
+  vtkGetMacro(MaximumPieceMemorySize, unsigned long);
+
+  ///@{
+  /**
+   * When on, the default, the pieces are appended to the output. When off, the
+   * output is empty and only the bounds and the histogram are computed.
+   */
+  vtkSetMacro(AppendPieces, bool);
+  vtkGetMacro(AppendPieces, bool);
+  vtkBooleanMacro(AppendPieces, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set / Get the type of the output, VTK_UNSTRUCTURED_GRID, the default, or
+   * VTK_POLY_DATA. See vtkAppendDataSets::SetOutputDataSetType().
+   */
+  vtkSetMacro(OutputDataSetType, int);
+  vtkGetMacro(OutputDataSetType, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set / Get the name of the array to compute the histogram of, nullptr by
+   * default. HistogramArrayAssociation is vtkDataObject::FIELD_ASSOCIATION_POINTS,
+   * the default, or vtkDataObject::FIELD_ASSOCIATION_CELLS.
+   */
+  vtkSetStringMacro(HistogramArrayName);
+  vtkGetStringMacro(HistogramArrayName);
+  vtkSetMacro(HistogramArrayAssociation, int);
+  vtkGetMacro(HistogramArrayAssociation, int);
+  vtkSetMacro(HistogramArrayComponent, int);
+  vtkGetMacro(HistogramArrayComponent, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set / Get the range and the number of bins of the histogram. Values
+   * outside of the range are not counted. Default is [0, 1] and 256 bins.
+   */
+  vtkSetVector2Macro(HistogramRange, double);
+  vtkGetVector2Macro(HistogramRange, double);
+  vtkSetClampMacro(NumberOfHistogramBins, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfHistogramBins, int);
+  ///@}
+
+  /**
+   * Return the number of values in each bin of the histogram of the last
+   * execution, or nullptr when HistogramArrayName is not set.
+   */
+  vtkIdTypeArray* GetHistogram();
+
+  ///@{
+  /**
+   * Return the bounds of all the pieces of the last execution.
+   */
+  vtkGetVector6Macro(Bounds, double);
+  ///@}
+
+  vtkTypeBool ProcessRequest(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+protected:
+  vtkDataSetStreamer();
+  ~vtkDataSetStreamer() override;
+
+  int FillOutputPortInformation(int port, vtkInformation* info) override;
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
+  virtual int RequestDataObject(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+  int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int ExecutePass(vtkInformationVector** inputVector, vtkInformationVector* outputVector) override;
+  int PostExecute(vtkInformationVector** inputVector, vtkInformationVector* outputVector) override;
+
+  unsigned long MemoryLimit = 0;
+  int InitialNumberOfPieces = 1;
+  int MaximumNumberOfPieces = 65536;
+  int NumberOfPieces = 0;
+  unsigned long MaximumPieceMemorySize = 0;
+  bool AppendPieces = true;
+  int OutputDataSetType;
+  char* HistogramArrayName = nullptr;
+  int HistogramArrayAssociation;
+  int HistogramArrayComponent = 0;
+  double HistogramRange[2] = { 0.0, 1.0 };
+  int NumberOfHistogramBins = 256;
+  double Bounds[6];
+
+private:
+  vtkDataSetStreamer(const vtkDataSetStreamer&) = delete;
+  void operator=(const vtkDataSetStreamer&) = delete;
+
+  void ResetReductions();
+  void AddToHistogram(vtkDataSet* input);
+
+  vtkAppendDataSets* Append;
+  vtkIdTypeArray* Histogram;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
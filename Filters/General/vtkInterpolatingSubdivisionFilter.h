@@ -49,6 +49,9 @@ protected:
     vtkIntArray* edgeData, vtkIdList* cellIds);
   vtkIdType InterpolatePosition(
     vtkPoints* inputPts, vtkPoints* outputPts, vtkIdList* stencil, double* weights);
+  // Thread safe version writing the point at ptId of the presized outputPts.
+  void InterpolatePosition(vtkPoints* inputPts, vtkPoints* outputPts, vtkIdType ptId,
+    vtkIdList* stencil, const double* weights);
 
 private:
   vtkInterpolatingSubdivisionFilter(const vtkInterpolatingSubdivisionFilter&) = delete;
@@ -12,6 +12,7 @@
 #include "vtkInformationVector.h"
 #include "vtkLine.h"
 #include "vtkLongArray.h"
+#include "vtkNew.h"
 #include "vtkOBBTree.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
@@ -20,16 +21,22 @@
 #include "vtkPoints.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
+#include "vtkStaticCellLocator.h"
 #include "vtkTransform.h"
 #include "vtkTransformPolyDataFilter.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <list>
 #include <map>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // Helper typedefs and data structures.
@@ -77,6 +84,17 @@ public:
   static int FindTriangleIntersections(
     vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg);
 
+  // Finds all triangle triangle intersections between the two meshes in
+  // parallel, with a vtkStaticCellLocator of the second mesh as broad phase,
+  // and adds them in the order of the cells of the first and second meshes
+  void FindTriangleIntersectionsInParallel();
+
+  // Adds the intersection (outpt0, outpt1) of the triangle cellId0 of the first
+  // mesh and of the triangle cellId1 of the second mesh to the intersection
+  // lines and to the edge, line, and surface maps
+  void AddIntersection(vtkIdType cellId0, const vtkIdType* triPtIds0, vtkIdType cellId1,
+    const vtkIdType* triPtIds1, double outpt0[3], double outpt1[3], const double surfaceid[2]);
+
   // Runs the split mesh for the designated input surface
   int SplitMesh(int inputIndex, vtkPolyData* output, vtkPolyData* intersectionLines);
 
@@ -219,11 +237,6 @@ int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
   vtkPolyData* mesh0 = info->Mesh[0];
   vtkPolyData* mesh1 = info->Mesh[1];
   vtkOBBTree* obbTree1 = info->OBBTree1;
-  vtkCellArray* intersectionLines = info->IntersectionLines;
-  vtkIdTypeArray* intersectionSurfaceId = info->SurfaceId;
-  vtkIdTypeArray* intersectionCellIds0 = info->CellIds[0];
-  vtkIdTypeArray* intersectionCellIds1 = info->CellIds[1];
-  vtkPointLocator* pointMerger = info->PointMerger;
   double tolerance = info->Tolerance;
 
   // The number of cells in OBBTree
@@ -288,167 +301,325 @@ int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
             // and surface maps!
             if (intersects)
             {
-              vtkIdType lineId = intersectionLines->GetNumberOfCells();
+              info->AddIntersection(
+                cellId0, triPtIds0, cellId1, triPtIds1, outpt0, outpt1, surfaceid);
+            }
+          }
+        }
+      }
+    }
+  }
 
-              vtkIdType ptId0, ptId1;
-              int unique[2];
-              unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
-              unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
+  return 1;
+}
 
-              int addline = 1;
-              if (ptId0 == ptId1)
-              {
-                addline = 0;
-              }
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::AddIntersection(vtkIdType cellId0,
+  const vtkIdType* triPtIds0, vtkIdType cellId1, const vtkIdType* triPtIds1, double outpt0[3],
+  double outpt1[3], const double surfaceid[2])
+{
+  // Set up local structures to hold Impl array information
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkCellArray* intersectionLines = this->IntersectionLines;
+  vtkIdTypeArray* intersectionSurfaceId = this->SurfaceId;
+  vtkIdTypeArray* intersectionCellIds0 = this->CellIds[0];
+  vtkIdTypeArray* intersectionCellIds1 = this->CellIds[1];
+  vtkPointLocator* pointMerger = this->PointMerger;
 
-              if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
-              {
-                intersectionSurfaceId->InsertValue(ptId0, 3);
-              }
-              else
-              {
-                if (unique[0])
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId0) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                  }
-                }
-                if (unique[1])
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId1) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                  }
-                }
-              }
+  vtkIdType lineId = intersectionLines->GetNumberOfCells();
 
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  vtkIdType ptId0, ptId1;
+  int unique[2];
+  unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
+  unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
 
-              // Check to see if duplicate line. Line can only be a duplicate
-              // line if both points are not unique and they don't
-              // equal each other
-              if (!unique[0] && !unique[1] && ptId0 != ptId1)
-              {
-                vtkSmartPointer<vtkPolyData> lineTest = vtkSmartPointer<vtkPolyData>::New();
-                lineTest->SetPoints(pointMerger->GetPoints());
-                lineTest->SetLines(intersectionLines);
-                lineTest->BuildLinks();
-                int newLine = info->CheckLine(lineTest, ptId0, ptId1);
-                if (newLine == 0)
-                {
-                  addline = 0;
-                }
-              }
-              if (addline)
-              {
-                // If the line is new and does not consist of two identical
-                // points, add the line to the intersection and update
-                // mapping information
-                intersectionLines->InsertNextCell(2);
-                intersectionLines->InsertCellPoint(ptId0);
-                intersectionLines->InsertCellPoint(ptId1);
-
-                intersectionCellIds0->InsertNextValue(cellId0);
-                intersectionCellIds1->InsertNextValue(cellId1);
-
-                info->PointCellIds[0]->InsertValue(ptId0, cellId0);
-                info->PointCellIds[0]->InsertValue(ptId1, cellId0);
-                info->PointCellIds[1]->InsertValue(ptId0, cellId1);
-                info->PointCellIds[1]->InsertValue(ptId1, cellId1);
-
-                info->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
-                info->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
-
-                // Check which edges of cellId0 and cellId1 outpt0 and
-                // outpt1 are on, if any.
-                int isOnEdge = 0;
-                int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
-                for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
-                {
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p1++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p1++;
-                  }
-                }
-                // Special cases caught by tolerance and not from the Point
-                // Merger
-                if (m0p0 > 0 && m1p0 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, 3);
-                }
-                if (m0p1 > 0 && m1p1 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, 3);
-                }
-              }
-              // Add information about origin surface to std::maps for
-              // checks later
-              if (intersectionSurfaceId->GetValue(ptId0) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId0) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              if (intersectionSurfaceId->GetValue(ptId1) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId1) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-            }
-          }
+  int addline = 1;
+  if (ptId0 == ptId1)
+  {
+    addline = 0;
+  }
+
+  if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
+  {
+    intersectionSurfaceId->InsertValue(ptId0, 3);
+  }
+  else
+  {
+    if (unique[0])
+    {
+      intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId0) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+      }
+    }
+    if (unique[1])
+    {
+      intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId1) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
+      }
+    }
+  }
+
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+
+  // Check to see if duplicate line. Line can only be a duplicate
+  // line if both points are not unique and they don't
+  // equal each other
+  if (!unique[0] && !unique[1] && ptId0 != ptId1)
+  {
+    vtkSmartPointer<vtkPolyData> lineTest = vtkSmartPointer<vtkPolyData>::New();
+    lineTest->SetPoints(pointMerger->GetPoints());
+    lineTest->SetLines(intersectionLines);
+    lineTest->BuildLinks();
+    int newLine = this->CheckLine(lineTest, ptId0, ptId1);
+    if (newLine == 0)
+    {
+      addline = 0;
+    }
+  }
+  if (addline)
+  {
+    // If the line is new and does not consist of two identical
+    // points, add the line to the intersection and update
+    // mapping information
+    intersectionLines->InsertNextCell(2);
+    intersectionLines->InsertCellPoint(ptId0);
+    intersectionLines->InsertCellPoint(ptId1);
+
+    intersectionCellIds0->InsertNextValue(cellId0);
+    intersectionCellIds1->InsertNextValue(cellId1);
+
+    this->PointCellIds[0]->InsertValue(ptId0, cellId0);
+    this->PointCellIds[0]->InsertValue(ptId1, cellId0);
+    this->PointCellIds[1]->InsertValue(ptId0, cellId1);
+    this->PointCellIds[1]->InsertValue(ptId1, cellId1);
+
+    this->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
+    this->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
+
+    // Check which edges of cellId0 and cellId1 outpt0 and
+    // outpt1 are on, if any.
+    int isOnEdge = 0;
+    int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
+    for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
+    {
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p1++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p1++;
+      }
+    }
+    // Special cases caught by tolerance and not from the Point
+    // Merger
+    if (m0p0 > 0 && m1p0 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId0, 3);
+    }
+    if (m0p1 > 0 && m1p1 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId1, 3);
+    }
+  }
+  // Add information about origin surface to std::maps for
+  // checks later
+  if (intersectionSurfaceId->GetValue(ptId0) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId0) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  if (intersectionSurfaceId->GetValue(ptId1) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId1) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersectionsInParallel()
+{
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  const double tolerance = this->Tolerance;
+  const vtkIdType numCells0 = mesh0->GetNumberOfCells();
+
+  // Build the cells of the meshes and the locator before threading, so that
+  // the threads only read them.
+  mesh0->BuildCells();
+  mesh1->BuildCells();
+  vtkNew<vtkStaticCellLocator> locator1;
+  locator1->SetDataSet(mesh1);
+  locator1->BuildLocator();
+
+  // The intersecting triangle pairs found by each thread.
+  struct TriangleIntersection
+  {
+    vtkIdType CellIds[2];
+    double Points[2][3];
+    double SurfaceIds[2];
+  };
+  vtkSMPThreadLocal<std::vector<TriangleIntersection>> localIntersections;
+  vtkSMPThreadLocalObject<vtkIdList> localCandidates;
+  vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+  vtkIntersectionPolyDataFilter* parent = this->ParentFilter;
+
+  vtkSMPTools::For(0, numCells0, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<TriangleIntersection>& intersections = localIntersections.Local();
+    vtkIdList* candidates = localCandidates.Local();
+    vtkIdList* ptIds = localPtIds.Local();
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    const vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+
+    for (vtkIdType cellId0 = begin; cellId0 < end; ++cellId0)
+    {
+      if (cellId0 % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          parent->CheckAbort();
+        }
+        if (parent->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      if (mesh0->GetCellType(cellId0) != VTK_TRIANGLE)
+      {
+        continue;
+      }
+
+      vtkIdType npts;
+      const vtkIdType* pts;
+      mesh0->GetCellPoints(cellId0, npts, pts, ptIds);
+      double triPts0[3][3];
+      double bounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN,
+        VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+      for (int i = 0; i < 3; ++i)
+      {
+        mesh0->GetPoint(pts[i], triPts0[i]);
+        for (int j = 0; j < 3; ++j)
+        {
+          bounds[2 * j] = std::min(bounds[2 * j], triPts0[i][j] - tolerance);
+          bounds[2 * j + 1] = std::max(bounds[2 * j + 1], triPts0[i][j] + tolerance);
+        }
+      }
+
+      // The bins of the locator only approximate the bounds of the
+      // triangles, so check the bounds of the candidates before the exact
+      // intersection test.
+      locator1->FindCellsWithinBounds(bounds, candidates);
+      std::sort(candidates->begin(), candidates->end());
+      for (vtkIdType cellId1 : *candidates)
+      {
+        if (mesh1->GetCellType(cellId1) != VTK_TRIANGLE)
+        {
+          continue;
+        }
+        mesh1->GetCellPoints(cellId1, npts, pts, ptIds);
+        double triPts1[3][3];
+        for (int i = 0; i < 3; ++i)
+        {
+          mesh1->GetPoint(pts[i], triPts1[i]);
+        }
+        bool overlaps = true;
+        for (int j = 0; j < 3 && overlaps; ++j)
+        {
+          overlaps =
+            std::max({ triPts1[0][j], triPts1[1][j], triPts1[2][j] }) >= bounds[2 * j] &&
+            std::min({ triPts1[0][j], triPts1[1][j], triPts1[2][j] }) <= bounds[2 * j + 1];
+        }
+        if (!overlaps)
+        {
+          continue;
+        }
+
+        // Coplanar triangle intersection is not handled, as in
+        // FindTriangleIntersections.
+        TriangleIntersection intersection;
+        int coplanar = 0;
+        const int intersects = vtkIntersectionPolyDataFilter::TriangleTriangleIntersection(
+          triPts0[0], triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar,
+          intersection.Points[0], intersection.Points[1], intersection.SurfaceIds, tolerance);
+        if (intersects && !coplanar)
+        {
+          intersection.CellIds[0] = cellId0;
+          intersection.CellIds[1] = cellId1;
+          intersections.push_back(intersection);
         }
       }
     }
+  });
+
+  // Add the intersections in the order of the triangle pairs, so that the
+  // intersection lines do not depend on the number of threads.
+  std::vector<TriangleIntersection> intersections;
+  for (auto& local : localIntersections)
+  {
+    intersections.insert(intersections.end(), local.begin(), local.end());
   }
+  vtkSMPTools::Sort(intersections.begin(), intersections.end(),
+    [](const TriangleIntersection& a, const TriangleIntersection& b) {
+      return a.CellIds[0] < b.CellIds[0] ||
+        (a.CellIds[0] == b.CellIds[0] && a.CellIds[1] < b.CellIds[1]);
+    });
 
-  return 1;
+  vtkNew<vtkIdList> triPtIds0;
+  vtkNew<vtkIdList> triPtIds1;
+  for (TriangleIntersection& intersection : intersections)
+  {
+    mesh0->GetCellPoints(intersection.CellIds[0], triPtIds0);
+    mesh1->GetCellPoints(intersection.CellIds[1], triPtIds1);
+    this->AddIntersection(intersection.CellIds[0], triPtIds0->GetPointer(0),
+      intersection.CellIds[1], triPtIds1->GetPointer(0), intersection.Points[0],
+      intersection.Points[1], intersection.SurfaceIds);
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -1905,6 +2076,7 @@ vtkIntersectionPolyDataFilter::vtkIntersectionPolyDataFilter()
   this->ComputeIntersectionPointArray = 0;
   this->Tolerance = 1e-6;
   this->RelativeSubtriangleArea = 1e-4;
+  this->ParallelIntersection = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -1925,6 +2097,7 @@ void vtkIntersectionPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ComputeIntersectionPointArray: " << this->ComputeIntersectionPointArray << "\n";
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "RelativeSubtriangleArea: " << this->RelativeSubtriangleArea << "\n";
+  os << indent << "ParallelIntersection: " << this->ParallelIntersection << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -2273,31 +2446,35 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   vtkSmartPointer<vtkPolyData> mesh1 = vtkSmartPointer<vtkPolyData>::New();
   mesh1->DeepCopy(input1);
 
-  // Find the triangle-triangle intersections between mesh0 and mesh1
+  // Find the triangle-triangle intersections between mesh0 and mesh1. The
+  // parallel search uses a vtkStaticCellLocator instead of the OBB trees.
   vtkSmartPointer<vtkOBBTree> obbTree0 = vtkSmartPointer<vtkOBBTree>::New();
-  obbTree0->SetDataSet(mesh0);
-  obbTree0->SetNumberOfCellsPerNode(10);
-  obbTree0->SetMaxLevel(1000000);
-  obbTree0->SetTolerance(this->Tolerance);
-  obbTree0->AutomaticOn();
-  obbTree0->BuildLocator();
-
-  if (this->CheckAbort())
+  vtkSmartPointer<vtkOBBTree> obbTree1 = vtkSmartPointer<vtkOBBTree>::New();
+  if (!this->ParallelIntersection)
   {
-    return 1;
-  }
+    obbTree0->SetDataSet(mesh0);
+    obbTree0->SetNumberOfCellsPerNode(10);
+    obbTree0->SetMaxLevel(1000000);
+    obbTree0->SetTolerance(this->Tolerance);
+    obbTree0->AutomaticOn();
+    obbTree0->BuildLocator();
 
-  vtkSmartPointer<vtkOBBTree> obbTree1 = vtkSmartPointer<vtkOBBTree>::New();
-  obbTree1->SetDataSet(mesh1);
-  obbTree1->SetNumberOfCellsPerNode(10);
-  obbTree1->SetMaxLevel(1000000);
-  obbTree1->SetTolerance(this->Tolerance);
-  obbTree1->AutomaticOn();
-  obbTree1->BuildLocator();
+    if (this->CheckAbort())
+    {
+      return 1;
+    }
 
-  if (this->CheckAbort())
-  {
-    return 1;
+    obbTree1->SetDataSet(mesh1);
+    obbTree1->SetNumberOfCellsPerNode(10);
+    obbTree1->SetMaxLevel(1000000);
+    obbTree1->SetTolerance(this->Tolerance);
+    obbTree1->AutomaticOn();
+    obbTree1->BuildLocator();
+
+    if (this->CheckAbort())
+    {
+      return 1;
+    }
   }
 
   // Set up the structure for determining exact triangle-triangle
@@ -2370,8 +2547,20 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   }
 
   // This performs the triangle intersection search
-  obbTree0->IntersectWithOBBTree(
-    obbTree1, nullptr, vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersections, impl);
+  if (this->ParallelIntersection)
+  {
+    impl->FindTriangleIntersectionsInParallel();
+  }
+  else
+  {
+    obbTree0->IntersectWithOBBTree(
+      obbTree1, nullptr, vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersections, impl);
+  }
+  if (this->CheckAbort())
+  {
+    delete impl;
+    return 1;
+  }
 
   int rawLines = outputIntersection->GetNumberOfLines();
 
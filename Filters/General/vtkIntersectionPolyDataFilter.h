@@ -146,6 +146,20 @@ public:
   vtkSetMacro(RelativeSubtriangleArea, double);
   ///@}
 
+  ///@{
+  /**
+   * If on, find the triangle-triangle intersections in parallel with
+   * vtkSMPTools, using a vtkStaticCellLocator of the second input as broad
+   * phase instead of OBB trees. The intersection lines are the same, but their
+   * points and lines may be numbered differently than with the serial search,
+   * and so may be the cells of the split outputs. The remeshing of the split
+   * cells stays serial. Defaults to off.
+   */
+  vtkGetMacro(ParallelIntersection, vtkTypeBool);
+  vtkSetMacro(ParallelIntersection, vtkTypeBool);
+  vtkBooleanMacro(ParallelIntersection, vtkTypeBool);
+  ///@}
+
   /**
    * Given two triangles defined by points (p1, q1, r1) and (p2, q2,
    * r2), returns whether the two triangles intersect. If they do,
@@ -193,6 +207,7 @@ private:
   int Status;
   double Tolerance;
   double RelativeSubtriangleArea;
+  vtkTypeBool ParallelIntersection;
 
   class Impl; // Implementation class
 };
@@ -10,6 +10,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -611,6 +612,14 @@ static inline int vtkOBBTreeLineIntersectsTriangle(const double p1[3], const dou
   return 0;
 }
 
+//------------------------------------------------------------------------------
+void vtkOBBTree::FindCells(
+  vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords, vtkDoubleArray* weights)
+{
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 },
+    [&]() { this->Superclass::FindCells(points, cellIds, pcoords, weights); });
+}
+
 //------------------------------------------------------------------------------
 // just check whether a point lies inside or outside the DataSet,
 // assuming that the data is a closed vtkPolyData surface.
@@ -122,6 +122,14 @@ public:
   int IntersectWithLine(
     const double a0[3], const double a1[3], vtkPoints* points, vtkIdList* cellIds) override;
 
+  /**
+   * Find the cells containing a batch of points. vtkOBBTree does not
+   * implement FindCell() and falls back to vtkDataSet::FindCell(), which is
+   * not thread safe, so the points are located in a single thread.
+   */
+  void FindCells(vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords = nullptr,
+    vtkDoubleArray* weights = nullptr) override;
+
   /**
    * Compute an OBB from the list of points given. Return the corner point
    * and the three axes defining the orientation of the OBB. Also return
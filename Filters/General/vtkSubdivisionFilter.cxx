@@ -8,15 +8,24 @@
 #include "vtkCellIterator.h"
 #include "vtkEdgeTable.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <sstream>
+#include <vector>
 
 // Construct object with number of subdivisions set to 1, check for
 // triangles set to 1
@@ -87,6 +96,141 @@ int vtkSubdivisionFilter::RequestData(vtkInformation* vtkNotUsed(request),
   }
   return 1;
 }
+
+//------------------------------------------------------------------------------
+bool vtkSubdivisionFilter::HasOnlyTriangles(vtkPolyData* inputDS)
+{
+  return inputDS->GetNumberOfVerts() == 0 && inputDS->GetNumberOfLines() == 0 &&
+    inputDS->GetNumberOfStrips() == 0 && inputDS->GetPolys()->IsHomogeneous() == 3;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkSubdivisionFilter::EnumerateEdges(
+  vtkPolyData* inputDS, vtkIdType firstId, vtkIntArray* edgeData, vtkIdTypeArray* edges)
+{
+  using EdgeTupleType = EdgeTuple<vtkIdType, vtkIdType>;
+  vtkCellArray* polys = inputDS->GetPolys();
+  const vtkIdType numTris = polys->GetNumberOfCells();
+
+  // Gather the edges of the triangles, each one with the rank of its visit in
+  // the traversal of the triangles.
+  std::vector<EdgeTupleType> edgeTuples(3 * numTris);
+  vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ptIds = localPtIds.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      polys->GetCellAtId(cellId, npts, pts, ptIds);
+      vtkIdType p1 = pts[2];
+      for (int edgeId = 0; edgeId < 3; ++edgeId)
+      {
+        const vtkIdType visit = 3 * cellId + edgeId;
+        edgeTuples[visit] = EdgeTupleType(p1, pts[edgeId], visit);
+        p1 = pts[edgeId];
+      }
+    }
+  });
+
+  // Group the visits of each edge, and flag the first one.
+  vtkStaticEdgeLocatorTemplate<vtkIdType, vtkIdType> locator;
+  vtkIdType numEdges;
+  const vtkIdType* offsets = locator.MergeEdges(3 * numTris, edgeTuples.data(), numEdges);
+  std::vector<vtkIdType> firstVisits(numEdges);
+  std::vector<vtkIdType> ranks(3 * numTris, 0);
+  std::atomic<bool> nonManifold(false);
+  vtkSMPTools::For(0, numEdges, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType edgeId = begin; edgeId < end; ++edgeId)
+    {
+      if (offsets[edgeId + 1] - offsets[edgeId] > 2)
+      {
+        nonManifold = true;
+      }
+      vtkIdType firstVisit = edgeTuples[offsets[edgeId]].Data;
+      for (vtkIdType i = offsets[edgeId] + 1; i < offsets[edgeId + 1]; ++i)
+      {
+        firstVisit = std::min(firstVisit, edgeTuples[i].Data);
+      }
+      firstVisits[edgeId] = firstVisit;
+      ranks[firstVisit] = 1;
+    }
+  });
+  if (nonManifold)
+  {
+    vtkErrorMacro("Dataset is non-manifold and cannot be subdivided.");
+    return -1;
+  }
+
+  // The edges are numbered in the order of their first visit.
+  vtkSMPTools::ExclusiveScan(ranks.begin(), ranks.end(), ranks.begin(), vtkIdType(0));
+  edges->SetNumberOfComponents(3);
+  edges->SetNumberOfTuples(numEdges);
+  vtkSMPTools::For(0, numEdges, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ptIds = localPtIds.Local();
+    for (vtkIdType edgeId = begin; edgeId < end; ++edgeId)
+    {
+      const vtkIdType firstVisit = firstVisits[edgeId];
+      const vtkIdType rank = ranks[firstVisit];
+      vtkIdType npts;
+      const vtkIdType* pts;
+      polys->GetCellAtId(firstVisit / 3, npts, pts, ptIds);
+      const int visitedEdge = static_cast<int>(firstVisit % 3);
+      vtkIdType* edge = edges->GetPointer(3 * rank);
+      edge[0] = pts[(visitedEdge + 2) % 3];
+      edge[1] = pts[visitedEdge];
+      edge[2] = offsets[edgeId + 1] - offsets[edgeId];
+      for (vtkIdType i = offsets[edgeId]; i < offsets[edgeId + 1]; ++i)
+      {
+        const vtkIdType visit = edgeTuples[i].Data;
+        edgeData->SetTypedComponent(
+          visit / 3, static_cast<int>(visit % 3), static_cast<int>(firstId + rank));
+      }
+    }
+  });
+  return numEdges;
+}
+
+//------------------------------------------------------------------------------
+void vtkSubdivisionFilter::GenerateSubdivisionTriangles(
+  vtkPolyData* inputDS, vtkIntArray* edgeData, vtkCellArray* outputPolys, vtkCellData* outputCD)
+{
+  vtkCellArray* polys = inputDS->GetPolys();
+  vtkCellData* inputCD = inputDS->GetCellData();
+  const vtkIdType numTris = polys->GetNumberOfCells();
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(4 * numTris + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(12 * numTris);
+  outputCD->SetNumberOfTuples(4 * numTris);
+
+  vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ptIds = localPtIds.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      // The original point ids and the ids stored as edge data, in the
+      // order of the serial subdivision.
+      vtkIdType npts;
+      const vtkIdType* pts;
+      polys->GetCellAtId(cellId, npts, pts, ptIds);
+      const int* edgePts = edgeData->GetPointer(3 * cellId);
+      const vtkIdType newCellPts[12] = { pts[0], edgePts[1], edgePts[0], edgePts[1], pts[1],
+        edgePts[2], edgePts[2], pts[2], edgePts[0], edgePts[1], edgePts[2], edgePts[0] };
+      std::copy(newCellPts, newCellPts + 12, connectivity->GetPointer(12 * cellId));
+      for (vtkIdType i = 0; i < 4; ++i)
+      {
+        offsets->SetValue(4 * cellId + i, 12 * cellId + 3 * i);
+        outputCD->CopyData(inputCD, cellId, 4 * cellId + i);
+      }
+    }
+  });
+  offsets->SetValue(4 * numTris, 12 * numTris);
+  outputPolys->SetData(offsets, connectivity);
+}
+
+//------------------------------------------------------------------------------
 void vtkSubdivisionFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
@@ -19,6 +19,7 @@ VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
 class vtkCellData;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkIntArray;
 class vtkPoints;
 class vtkPointData;
@@ -55,6 +56,31 @@ protected:
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Return whether inputDS only holds triangles, in which case the edges,
+   * the points and the cells of each level are generated in parallel.
+   */
+  static bool HasOnlyTriangles(vtkPolyData* inputDS);
+
+  /**
+   * Number the edges of the triangles of inputDS from firstId, in parallel,
+   * in the order in which a traversal of the triangles and of their edges
+   * (pts[2],pts[0]), (pts[0],pts[1]) and (pts[1],pts[2]) first visits them.
+   * edgeData receives the id of each edge of each triangle. edges receives
+   * three components per edge: its points, ordered as in the first triangle
+   * visiting it, and the number of triangles using it. Return the number of
+   * edges, or -1 when an edge is used by more than two triangles.
+   */
+  vtkIdType EnumerateEdges(
+    vtkPolyData* inputDS, vtkIdType firstId, vtkIntArray* edgeData, vtkIdTypeArray* edges);
+
+  /**
+   * Split each triangle of inputDS in four triangles using the points of its
+   * edges stored in edgeData, in parallel over the triangles.
+   */
+  void GenerateSubdivisionTriangles(
+    vtkPolyData* inputDS, vtkIntArray* edgeData, vtkCellArray* outputPolys, vtkCellData* outputCD);
+
   int NumberOfSubdivisions;
   vtkTypeBool CheckForTriangles;
 
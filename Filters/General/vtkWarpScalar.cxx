@@ -355,7 +355,6 @@ int vtkWarpScalar::RequestData(vtkInformation* vtkNotUsed(request),
       vtkIdType typeSize = cTypes->GetNumberOfTuples();
       cTypes->InsertTuples(typeSize, typeSize, 0, cTypes);
       // update the output UG
-      ugOutput->SetEditable(true);
       ugOutput->SetCells(cTypes, topCopy);
     }
     this->AppendArrays(output->GetPointData());
@@ -0,0 +1,273 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded extraction of vtkDataSetSurfaceFilter extracts the
+// same surface as the serial extraction from a mesh of quadratic tetrahedra
+// with hidden cells and 0D, 1D and 2D cells, at the first subdivision levels.
+
+#include "vtkCellData.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A cube of n^3 hexahedra split in 6 quadratic tetrahedra each. The points
+// lie on a lattice of twice the resolution, which holds the mid-edge points.
+void CreateQuadraticTets(vtkUnstructuredGrid* grid, int n)
+{
+  const int dim = 2 * n + 1;
+  auto pointId = [dim](int i, int j, int k) { return i + dim * (j + dim * k); };
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        points->InsertNextPoint(0.5 * i, 0.5 * j, 0.5 * k);
+        scalars->InsertNextValue(0.5 * i + j + 1.5 * k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+
+  // The tetrahedra around the diagonal of the hexahedra, which are
+  // conforming across the hexahedra.
+  const int permutations[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 },
+    { 2, 0, 1 }, { 2, 1, 0 } };
+  grid->AllocateExact(6 * n * n * n + 3, 10);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        for (const auto& axes : permutations)
+        {
+          int corners[4][3] = { { 2 * i, 2 * j, 2 * k } };
+          for (int c = 1; c < 4; ++c)
+          {
+            std::copy(corners[c - 1], corners[c - 1] + 3, corners[c]);
+            corners[c][axes[c - 1]] += 2;
+          }
+          // The edges of vtkQuadraticTetra: 01, 12, 20, 03, 13, 23.
+          const int edges[6][2] = { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 0, 3 }, { 1, 3 }, { 2, 3 } };
+          vtkIdType ids[10];
+          for (int c = 0; c < 4; ++c)
+          {
+            ids[c] = pointId(corners[c][0], corners[c][1], corners[c][2]);
+          }
+          for (int e = 0; e < 6; ++e)
+          {
+            const int* p0 = corners[edges[e][0]];
+            const int* p1 = corners[edges[e][1]];
+            ids[4 + e] = pointId((p0[0] + p1[0]) / 2, (p0[1] + p1[1]) / 2, (p0[2] + p1[2]) / 2);
+          }
+          grid->InsertNextCell(VTK_QUADRATIC_TETRA, 10, ids);
+        }
+      }
+    }
+  }
+
+  // A vertex, a line and a quadratic triangle on the side of the cube.
+  const vtkIdType vertex[1] = { pointId(0, 0, 0) };
+  grid->InsertNextCell(VTK_VERTEX, 1, vertex);
+  const vtkIdType line[2] = { pointId(0, 0, 0), pointId(2, 2, 2) };
+  grid->InsertNextCell(VTK_LINE, 2, line);
+  const vtkIdType triangle[6] = { pointId(0, 0, 2 * n), pointId(2, 0, 2 * n),
+    pointId(0, 2, 2 * n), pointId(1, 0, 2 * n), pointId(1, 1, 2 * n), pointId(0, 1, 2 * n) };
+  grid->InsertNextCell(VTK_QUADRATIC_TRIANGLE, 6, triangle);
+
+  // Ids of the cells, and a few hidden tetrahedra: their faces hide the faces
+  // of their neighbors, but they are not extracted.
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+    ghosts->InsertNextValue(cellId % 37 == 5 ? vtkDataSetAttributes::HIDDENCELL : 0);
+  }
+  grid->GetCellData()->AddArray(cellIds);
+  grid->GetCellData()->AddArray(ghosts);
+}
+
+//------------------------------------------------------------------------------
+// Describe each cell of a surface by its type, its input cell and the sorted
+// coordinates of its points, and sort the descriptions so that they do not
+// depend on the order of the cells or of their points.
+std::vector<std::vector<double>> DescribeCells(vtkPolyData* surface)
+{
+  std::vector<std::vector<double>> cells;
+  vtkDataArray* cellIds = surface->GetCellData()->GetArray("CellIds");
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < surface->GetNumberOfCells(); ++cellId)
+  {
+    surface->GetCellPoints(cellId, ptIds);
+    std::vector<std::vector<double>> points;
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+    {
+      double x[3];
+      surface->GetPoint(ptIds->GetId(i), x);
+      points.push_back({ x[0], x[1], x[2] });
+    }
+    std::sort(points.begin(), points.end());
+    std::vector<double> cell = { static_cast<double>(surface->GetCellType(cellId)),
+      cellIds->GetTuple1(cellId) };
+    for (const auto& x : points)
+    {
+      cell.insert(cell.end(), x.begin(), x.end());
+    }
+    cells.push_back(cell);
+  }
+  std::sort(cells.begin(), cells.end());
+  return cells;
+}
+
+//------------------------------------------------------------------------------
+// Check that the point data of a surface is the one of its points.
+bool CheckPointData(vtkPolyData* surface)
+{
+  vtkDataArray* scalars = surface->GetPointData()->GetArray("Scalars");
+  if (!scalars || scalars->GetNumberOfTuples() != surface->GetNumberOfPoints())
+  {
+    std::cerr << "Missing point data." << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < surface->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    surface->GetPoint(ptId, x);
+    if (std::abs(scalars->GetTuple1(ptId) - (x[0] + 2.0 * x[1] + 3.0 * x[2])) > 1e-10)
+    {
+      std::cerr << "Wrong point data at point " << ptId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestSubdivisionLevel(vtkUnstructuredGrid* grid, int level)
+{
+  vtkNew<vtkDataSetSurfaceFilter> surfaceFilters[2];
+  for (int parallel = 0; parallel < 2; ++parallel)
+  {
+    surfaceFilters[parallel]->SetInputData(grid);
+    surfaceFilters[parallel]->SetNonlinearSubdivisionLevel(level);
+    surfaceFilters[parallel]->SetPassThroughCellIds(true);
+    surfaceFilters[parallel]->SetPassThroughPointIds(true);
+    surfaceFilters[parallel]->SetParallelExtraction(parallel != 0);
+    surfaceFilters[parallel]->Update();
+  }
+  vtkPolyData* serial = surfaceFilters[0]->GetOutput();
+  vtkPolyData* parallel = surfaceFilters[1]->GetOutput();
+
+  if (serial->GetNumberOfPoints() != parallel->GetNumberOfPoints() ||
+    serial->GetNumberOfVerts() != parallel->GetNumberOfVerts() ||
+    serial->GetNumberOfLines() != parallel->GetNumberOfLines() ||
+    serial->GetNumberOfPolys() != parallel->GetNumberOfPolys())
+  {
+    std::cerr << "Got " << parallel->GetNumberOfPoints() << " points and "
+              << parallel->GetNumberOfPolys() << " polygons instead of "
+              << serial->GetNumberOfPoints() << " and " << serial->GetNumberOfPolys()
+              << std::endl;
+    return false;
+  }
+  if (DescribeCells(serial) != DescribeCells(parallel))
+  {
+    std::cerr << "The cells differ from the serial extraction." << std::endl;
+    return false;
+  }
+  if (!CheckPointData(serial) || !CheckPointData(parallel))
+  {
+    return false;
+  }
+
+  // The original ids are the ids of the input cells and points.
+  vtkDataArray* cellIds = parallel->GetCellData()->GetArray("CellIds");
+  vtkDataArray* originalCellIds =
+    parallel->GetCellData()->GetArray(surfaceFilters[1]->GetOriginalCellIdsName());
+  vtkDataArray* originalPointIds =
+    parallel->GetPointData()->GetArray(surfaceFilters[1]->GetOriginalPointIdsName());
+  if (!originalCellIds || !originalPointIds)
+  {
+    std::cerr << "Missing original ids." << std::endl;
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellId < parallel->GetNumberOfCells(); ++cellId)
+  {
+    if (originalCellIds->GetTuple1(cellId) != cellIds->GetTuple1(cellId))
+    {
+      std::cerr << "Wrong original id for cell " << cellId << std::endl;
+      return false;
+    }
+  }
+  for (vtkIdType ptId = 0; ptId < parallel->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    parallel->GetPoint(ptId, x);
+    grid->GetPoint(static_cast<vtkIdType>(originalPointIds->GetTuple1(ptId)), y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Wrong original id for point " << ptId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDataSetSurfaceFilterParallel(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  CreateQuadraticTets(grid, 6);
+
+  for (int level = 0; level < 2; ++level)
+  {
+    if (!TestSubdivisionLevel(grid, level))
+    {
+      std::cerr << "Failed with subdivision level " << level << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Higher subdivision levels use the serial extraction.
+  vtkNew<vtkDataSetSurfaceFilter> surfaceFilters[2];
+  for (int parallel = 0; parallel < 2; ++parallel)
+  {
+    surfaceFilters[parallel]->SetInputData(grid);
+    surfaceFilters[parallel]->SetNonlinearSubdivisionLevel(2);
+    surfaceFilters[parallel]->SetParallelExtraction(parallel != 0);
+    surfaceFilters[parallel]->Update();
+  }
+  if (surfaceFilters[0]->GetOutput()->GetNumberOfCells() !=
+    surfaceFilters[1]->GetOutput()->GetNumberOfCells())
+  {
+    std::cerr << "Subdivision level 2 does not use the serial extraction." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
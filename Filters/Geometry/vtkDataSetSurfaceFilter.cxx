@@ -3,6 +3,7 @@
 
 #include "vtkDataSetSurfaceFilter.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkBezierCurve.h"
 #include "vtkBezierQuadrilateral.h"
 #include "vtkBezierTriangle.h"
@@ -26,9 +27,14 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPyramid.h"
+#include "vtkQuadraticTetra.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridGeometryFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticFaceHashLinksTemplate.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
 #include "vtkStructuredGrid.h"
@@ -45,9 +51,11 @@
 #include "vtkWedge.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <numeric>
 #include <unordered_map>
+#include <vector>
 
 namespace
 {
@@ -356,6 +364,7 @@ vtkDataSetSurfaceFilter::vtkDataSetSurfaceFilter()
 
   this->AllowInterpolation = true;
   this->Delegation = false;
+  this->ParallelExtraction = false;
 }
 
 //------------------------------------------------------------------------------
@@ -1292,6 +1301,7 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "FastMode: " << this->GetFastMode() << endl;
   os << indent << "AllowInterpolation: " << this->GetAllowInterpolation() << endl;
   os << indent << "Delegation: " << this->GetDelegation() << endl;
+  os << indent << "ParallelExtraction: " << this->GetParallelExtraction() << endl;
 }
 
 //========================================================================
@@ -1388,12 +1398,378 @@ int vtkDataSetSurfaceFilter::UnstructuredGridBaseExecute(
   return this->UnstructuredGridExecuteInternal(input, output, handleSubdivision);
 }
 
+//------------------------------------------------------------------------------
+// Threaded extraction of the surface of unstructured grids with nonlinear cells.
+namespace
+{
+// The largest number of points of a face extracted by the threaded extraction.
+constexpr int MaxSurfaceFacePoints = 16;
+
+// A boundary face of a 3D cell, or a 0D, 1D or 2D cell when FaceId is negative.
+struct vtkSurfaceItem
+{
+  vtkIdType CellId;
+  int FaceId;
+
+  bool operator<(const vtkSurfaceItem& other) const
+  {
+    return this->CellId < other.CellId ||
+      (this->CellId == other.CellId && this->FaceId < other.FaceId);
+  }
+};
+
+// The point ids of a face, sorted so that the faces of adjacent cells can be
+// compared: the corners first, then the other points.
+struct vtkSurfaceFaceKey
+{
+  vtkIdType CellId;
+  int FaceId;
+  int Type;
+  int NumberOfCorners;
+  int NumberOfPoints;
+  bool Matched;
+  vtkIdType Points[MaxSurfaceFacePoints];
+};
+
+//------------------------------------------------------------------------------
+bool IsNonlinearSurfaceType(int cellType)
+{
+  return cellType == VTK_QUADRATIC_TRIANGLE || cellType == VTK_BIQUADRATIC_TRIANGLE ||
+    cellType == VTK_QUADRATIC_QUAD || cellType == VTK_BIQUADRATIC_QUAD ||
+    cellType == VTK_QUADRATIC_LINEAR_QUAD;
+}
+
+//------------------------------------------------------------------------------
+// The cells supported by the threaded extraction: the linear 0D, 1D and 2D
+// cells, the quadratic 2D cells and the 3D cells whose faces are such cells.
+bool IsThreadedSurfaceType(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_EMPTY_CELL:
+    case VTK_VERTEX:
+    case VTK_POLY_VERTEX:
+    case VTK_LINE:
+    case VTK_POLY_LINE:
+    case VTK_TRIANGLE:
+    case VTK_TRIANGLE_STRIP:
+    case VTK_POLYGON:
+    case VTK_PIXEL:
+    case VTK_QUAD:
+    case VTK_TETRA:
+    case VTK_VOXEL:
+    case VTK_HEXAHEDRON:
+    case VTK_WEDGE:
+    case VTK_PYRAMID:
+    case VTK_PENTAGONAL_PRISM:
+    case VTK_HEXAGONAL_PRISM:
+    case VTK_QUADRATIC_TETRA:
+    case VTK_QUADRATIC_HEXAHEDRON:
+    case VTK_QUADRATIC_WEDGE:
+    case VTK_QUADRATIC_PYRAMID:
+    case VTK_TRIQUADRATIC_HEXAHEDRON:
+    case VTK_TRIQUADRATIC_PYRAMID:
+    case VTK_QUADRATIC_LINEAR_WEDGE:
+    case VTK_BIQUADRATIC_QUADRATIC_WEDGE:
+    case VTK_BIQUADRATIC_QUADRATIC_HEXAHEDRON:
+      return true;
+    default:
+      return IsNonlinearSurfaceType(cellType);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Extract the boundary faces of the 3D cells, matched in parallel over the
+// hashes of vtkStaticFaceHashLinksTemplate, and generate the output cells of
+// the boundary faces and of the other cells in two passes: one to count them
+// and one to write them at their offsets.
+class vtkThreadedSurfaceExtraction
+{
+public:
+  vtkThreadedSurfaceExtraction(vtkUnstructuredGrid* input, vtkAlgorithm* filter,
+    int subdivisionLevel, bool matchIgnoringCellOrder)
+    : Input(input)
+    , Filter(filter)
+    , SubdivisionLevel(subdivisionLevel)
+    , MatchIgnoringCellOrder(matchIgnoringCellOrder)
+    , PointGhosts(input->GetPointGhostArray())
+    , CellGhosts(input->GetCellGhostArray())
+  {
+  }
+
+  /**
+   * Append to faces the boundary faces of the 3D cells that are not hidden,
+   * sorted by cell and face ids so that the output does not depend on the
+   * threads. Return false when the filter is aborted.
+   */
+  bool FindBoundaryFaces(std::vector<vtkSurfaceItem>& faces)
+  {
+    const std::size_t numItems = faces.size();
+    vtkStaticFaceHashLinksTemplate<vtkIdType, vtkTypeInt8> links;
+    links.BuildHashLinks(this->Input);
+    // The last hash holds the 0D, 1D and 2D cells.
+    const vtkIdType numHashes = links.GetNumberOfHashes() - 1;
+
+    vtkSMPThreadLocal<std::vector<vtkSurfaceItem>> localFaces;
+    vtkSMPThreadLocal<std::vector<vtkSurfaceFaceKey>> localKeys;
+    vtkSMPTools::For(0, numHashes, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<vtkSurfaceItem>& boundaryFaces = localFaces.Local();
+      std::vector<vtkSurfaceFaceKey>& keys = localKeys.Local();
+      vtkGenericCell* cell = this->Cells.Local();
+      vtkIdList* ptIds = this->PtIds.Local();
+      const bool isFirst = vtkSMPTools::GetSingleThread();
+      const vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+      for (vtkIdType hash = begin; hash < end; ++hash)
+      {
+        if (hash % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->Filter->CheckAbort();
+          }
+          if (this->Filter->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        const vtkIdType numFaces = links.GetNumberOfFacesInHash(hash);
+        const vtkIdType* cellIds = links.GetCellIdOfFacesInHash(hash);
+        const vtkTypeInt8* faceIds = links.GetFaceIdOfFacesInHash(hash);
+        if (numFaces == 1)
+        {
+          // A face alone in its hash is a boundary face.
+          this->AddBoundaryFace(cellIds[0], faceIds[0], boundaryFaces);
+          continue;
+        }
+        keys.resize(numFaces);
+        for (vtkIdType i = 0; i < numFaces; ++i)
+        {
+          this->LoadFaceKey(cellIds[i], faceIds[i], keys[i], cell, ptIds);
+        }
+        for (vtkIdType i = 0; i < numFaces; ++i)
+        {
+          for (vtkIdType j = i + 1; j < numFaces; ++j)
+          {
+            if (this->Match(keys[i], keys[j]))
+            {
+              keys[i].Matched = keys[j].Matched = true;
+            }
+          }
+          if (!keys[i].Matched)
+          {
+            this->AddBoundaryFace(keys[i].CellId, keys[i].FaceId, boundaryFaces);
+          }
+        }
+      }
+    });
+    if (this->Filter->GetAbortOutput())
+    {
+      return false;
+    }
+
+    for (const std::vector<vtkSurfaceItem>& boundaryFaces : localFaces)
+    {
+      faces.insert(faces.end(), boundaryFaces.begin(), boundaryFaces.end());
+    }
+    vtkSMPTools::Sort(faces.begin() + numItems, faces.end());
+    return true;
+  }
+
+  /**
+   * Call emit(npts, pts) with the input point ids of each output cell of an
+   * item: the cell itself for 0D and 1D cells, and the polygons of a 2D cell
+   * or a boundary face, triangulated at the first subdivision level for
+   * quadratic ones.
+   */
+  template <typename TEmit>
+  void VisitItem(const vtkSurfaceItem& item, TEmit&& emit)
+  {
+    vtkGenericCell* cell = this->Cells.Local();
+    vtkIdList* ptIds = this->PtIds.Local();
+    vtkCell* source = nullptr;
+    int cellType;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    if (item.FaceId < 0)
+    {
+      cellType = this->Input->GetCellType(item.CellId);
+      if (this->SubdivisionLevel >= 1 && IsNonlinearSurfaceType(cellType))
+      {
+        // The triangulation of some quadratic cells depends on their points.
+        this->Input->GetCell(item.CellId, cell);
+        source = cell;
+      }
+      else
+      {
+        this->Input->GetCellPoints(item.CellId, npts, pts, ptIds);
+      }
+    }
+    else
+    {
+      this->Input->GetCell(item.CellId, cell);
+      source = cell->GetFace(item.FaceId);
+      cellType = source->GetCellType();
+    }
+    if (source)
+    {
+      npts = source->GetNumberOfPoints();
+      pts = source->PointIds->GetPointer(0);
+    }
+
+    if (IsNonlinearSurfaceType(cellType))
+    {
+      if (this->SubdivisionLevel < 1)
+      {
+        // The first points of a quadratic cell are the ones of its linear cell.
+        const bool isTriangle =
+          cellType == VTK_QUADRATIC_TRIANGLE || cellType == VTK_BIQUADRATIC_TRIANGLE;
+        cellType = isTriangle ? VTK_TRIANGLE : VTK_QUAD;
+        npts = isTriangle ? 3 : 4;
+      }
+      else
+      {
+        if (this->PointGhosts)
+        {
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            if (this->PointGhosts->GetValue(pts[i]) & vtkDataSetAttributes::HIDDENPOINT)
+            {
+              return;
+            }
+          }
+        }
+        vtkIdList* triIds = this->TriIds.Local();
+        source->TriangulateLocalIds(0, triIds);
+        for (vtkIdType i = 0; i + 2 < triIds->GetNumberOfIds(); i += 3)
+        {
+          const vtkIdType tri[3] = { pts[triIds->GetId(i)], pts[triIds->GetId(i + 1)],
+            pts[triIds->GetId(i + 2)] };
+          emit(3, tri);
+        }
+        return;
+      }
+    }
+
+    switch (cellType)
+    {
+      case VTK_PIXEL:
+      {
+        const vtkIdType quad[4] = { pts[0], pts[1], pts[3], pts[2] };
+        emit(4, quad);
+        break;
+      }
+      case VTK_TRIANGLE_STRIP:
+      {
+        // Change strips to triangles so we do not have to worry about order.
+        vtkIdType tri[3] = { pts[0], pts[1], 0 };
+        int toggle = 0;
+        for (vtkIdType i = 2; i < npts; ++i)
+        {
+          tri[2] = pts[i];
+          emit(3, tri);
+          tri[toggle] = tri[2];
+          toggle = !toggle;
+        }
+        break;
+      }
+      case VTK_EMPTY_CELL:
+        break;
+      default:
+        emit(npts, pts);
+    }
+  }
+
+private:
+  // Add a boundary face, unless its cell is hidden.
+  void AddBoundaryFace(vtkIdType cellId, int faceId, std::vector<vtkSurfaceItem>& faces)
+  {
+    if (!this->CellGhosts ||
+      !(this->CellGhosts->GetValue(cellId) & vtkDataSetAttributes::HIDDENCELL))
+    {
+      faces.push_back({ cellId, faceId });
+    }
+  }
+
+  void LoadFaceKey(
+    vtkIdType cellId, int faceId, vtkSurfaceFaceKey& key, vtkGenericCell* cell, vtkIdList* ptIds)
+  {
+    key.CellId = cellId;
+    key.FaceId = faceId;
+    key.Matched = false;
+    const int cellType = this->Input->GetCellType(cellId);
+    if (cellType == VTK_TETRA || cellType == VTK_QUADRATIC_TETRA)
+    {
+      // Avoid the cell construction for the most common cells.
+      vtkIdType npts;
+      const vtkIdType* pts;
+      this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+      const bool isLinear = cellType == VTK_TETRA;
+      const vtkIdType* faceVerts =
+        isLinear ? vtkTetra::GetFaceArray(faceId) : vtkQuadraticTetra::GetFaceArray(faceId);
+      key.Type = isLinear ? VTK_TRIANGLE : VTK_QUADRATIC_TRIANGLE;
+      key.NumberOfCorners = 3;
+      key.NumberOfPoints = isLinear ? 3 : 6;
+      for (int i = 0; i < key.NumberOfPoints; ++i)
+      {
+        key.Points[i] = pts[faceVerts[i]];
+      }
+    }
+    else
+    {
+      this->Input->GetCell(cellId, cell);
+      vtkCell* face = cell->GetFace(faceId);
+      key.Type = face->GetCellType() == VTK_PIXEL ? VTK_QUAD : face->GetCellType();
+      key.NumberOfPoints =
+        std::min(static_cast<int>(face->GetNumberOfPoints()), MaxSurfaceFacePoints);
+      key.NumberOfCorners = face->IsLinear() ? key.NumberOfPoints : face->GetNumberOfEdges();
+      std::copy_n(face->PointIds->GetPointer(0), key.NumberOfPoints, key.Points);
+    }
+    std::sort(key.Points, key.Points + key.NumberOfCorners);
+    std::sort(key.Points + key.NumberOfCorners, key.Points + key.NumberOfPoints);
+  }
+
+  // Faces match when they have the same corners, and unless the order of the
+  // cells is ignored, the same type and points.
+  bool Match(const vtkSurfaceFaceKey& key0, const vtkSurfaceFaceKey& key1) const
+  {
+    if (key0.NumberOfCorners != key1.NumberOfCorners ||
+      !std::equal(key0.Points, key0.Points + key0.NumberOfCorners, key1.Points))
+    {
+      return false;
+    }
+    return this->MatchIgnoringCellOrder ||
+      (key0.Type == key1.Type && key0.NumberOfPoints == key1.NumberOfPoints &&
+        std::equal(key0.Points + key0.NumberOfCorners, key0.Points + key0.NumberOfPoints,
+          key1.Points + key1.NumberOfCorners));
+  }
+
+  vtkUnstructuredGrid* Input;
+  vtkAlgorithm* Filter;
+  int SubdivisionLevel;
+  bool MatchIgnoringCellOrder;
+  vtkUnsignedCharArray* PointGhosts;
+  vtkUnsignedCharArray* CellGhosts;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cells;
+  vtkSMPThreadLocalObject<vtkIdList> PtIds;
+  vtkSMPThreadLocalObject<vtkIdList> TriIds;
+};
+} // anonymous namespace
+
 //========================================================================
 // Tris are now degenerate quads so we only need one hash table.
 // We might want to change the method names from QuadHash to just Hash.
 int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
   vtkUnstructuredGridBase* input, vtkPolyData* output, bool handleSubdivision)
 {
+  if (handleSubdivision && this->ParallelExtraction)
+  {
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+    if (grid && this->ParallelUnstructuredGridExecute(grid, output))
+    {
+      return 1;
+    }
+  }
+
   vtkSmartPointer<vtkUnstructuredGrid> tempInput;
   if (handleSubdivision)
   {
@@ -2278,6 +2654,234 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Threaded version of UnstructuredGridExecuteInternal() for the unstructured
+// grids that need subdivision. Return 0 when the input is not supported and
+// the serial extraction must be used.
+int vtkDataSetSurfaceFilter::ParallelUnstructuredGridExecute(
+  vtkUnstructuredGrid* input, vtkPolyData* output)
+{
+  // Higher subdivision levels share the interpolated points of adjacent faces
+  // through the edge map, they use the serial extraction.
+  if (this->NonlinearSubdivisionLevel > 1 || input->GetNumberOfCells() == 0)
+  {
+    return 0;
+  }
+  vtkUnsignedCharArray* types = input->GetDistinctCellTypesArray();
+  for (vtkIdType i = 0; i < types->GetNumberOfValues(); ++i)
+  {
+    if (!IsThreadedSurfaceType(types->GetValue(i)))
+    {
+      return 0;
+    }
+  }
+
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkUnsignedCharArray* ghostCells = input->GetCellGhostArray();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+
+  // The items of the verts, of the lines, and of the polygons: the 2D cells
+  // followed by the boundary faces of the 3D cells. As in the serial
+  // extraction, only the verts of hidden cells are extracted.
+  std::vector<vtkSurfaceItem> items[3];
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    const int cellType = input->GetCellType(cellId);
+    if (cellType == VTK_VERTEX || cellType == VTK_POLY_VERTEX)
+    {
+      items[0].push_back({ cellId, -1 });
+    }
+    else if (cellType == VTK_EMPTY_CELL || vtkCellTypes::GetDimension(cellType) == 3 ||
+      (ghostCells &&
+        (ghostCells->GetValue(cellId) & vtkDataSetAttributes::CellGhostTypes::HIDDENCELL)))
+    {
+      continue;
+    }
+    else
+    {
+      const bool isLine = cellType == VTK_LINE || cellType == VTK_POLY_LINE;
+      items[isLine ? 1 : 2].push_back({ cellId, -1 });
+    }
+  }
+
+  vtkThreadedSurfaceExtraction extraction(
+    input, this, this->NonlinearSubdivisionLevel, this->MatchBoundariesIgnoringCellOrder != 0);
+  if (!extraction.FindBoundaryFaces(items[2]))
+  {
+    return 1;
+  }
+  this->UpdateProgress(0.5);
+
+  // Count the output cells and their points for each item, then turn the
+  // counts into offsets.
+  std::vector<vtkIdType> cellOffsets[3];
+  std::vector<vtkIdType> connOffsets[3];
+  vtkIdType numOutCells = 0;
+  for (int type = 0; type < 3; ++type)
+  {
+    const std::vector<vtkSurfaceItem>& typeItems = items[type];
+    const vtkIdType numItems = static_cast<vtkIdType>(typeItems.size());
+    cellOffsets[type].resize(numItems + 1, 0);
+    connOffsets[type].resize(numItems + 1, 0);
+    vtkSMPTools::For(0, numItems, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        vtkIdType numItemCells = 0;
+        vtkIdType numItemConn = 0;
+        extraction.VisitItem(typeItems[i], [&](vtkIdType npts, const vtkIdType*) {
+          ++numItemCells;
+          numItemConn += npts;
+        });
+        cellOffsets[type][i] = numItemCells;
+        connOffsets[type][i] = numItemConn;
+      }
+    });
+    numOutCells += vtkSMPTools::ExclusiveScan(
+      cellOffsets[type].begin(), cellOffsets[type].end(), cellOffsets[type].begin(), vtkIdType(0));
+    vtkSMPTools::ExclusiveScan(
+      connOffsets[type].begin(), connOffsets[type].end(), connOffsets[type].begin(), vtkIdType(0));
+  }
+
+  // Write the cells with the input point ids, and the input cell of each
+  // output cell.
+  std::vector<vtkIdType> sourceCells(numOutCells);
+  vtkNew<vtkIdTypeArray> offsets[3];
+  vtkNew<vtkIdTypeArray> connectivity[3];
+  vtkIdType typeCellOffset = 0;
+  for (int type = 0; type < 3; ++type)
+  {
+    const std::vector<vtkSurfaceItem>& typeItems = items[type];
+    const vtkIdType numTypeCells = cellOffsets[type].back();
+    const vtkIdType connSize = connOffsets[type].back();
+    offsets[type]->SetNumberOfValues(numTypeCells + 1);
+    connectivity[type]->SetNumberOfValues(connSize);
+    vtkIdType* offsetsPtr = offsets[type]->GetPointer(0);
+    vtkIdType* connPtr = connectivity[type]->GetPointer(0);
+    vtkIdType* typeSourceCells = sourceCells.data() + typeCellOffset;
+    vtkSMPTools::For(
+      0, static_cast<vtkIdType>(typeItems.size()), [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          vtkIdType outCellId = cellOffsets[type][i];
+          vtkIdType conn = connOffsets[type][i];
+          extraction.VisitItem(typeItems[i], [&](vtkIdType npts, const vtkIdType* pts) {
+            offsetsPtr[outCellId] = conn;
+            typeSourceCells[outCellId++] = typeItems[i].CellId;
+            std::copy(pts, pts + npts, connPtr + conn);
+            conn += npts;
+          });
+        }
+      });
+    offsetsPtr[numTypeCells] = connSize;
+    typeCellOffset += numTypeCells;
+  }
+  this->UpdateProgress(0.7);
+
+  // Only the used points are extracted, in the order of the input points.
+  std::vector<std::atomic<unsigned char>> usedPts(numPts);
+  for (int type = 0; type < 3; ++type)
+  {
+    vtkIdType* connPtr = connectivity[type]->GetPointer(0);
+    vtkSMPTools::For(
+      0, connectivity[type]->GetNumberOfValues(), [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          usedPts[connPtr[i]].store(1, std::memory_order_relaxed);
+        }
+      });
+  }
+  std::vector<vtkIdType> pointMap(numPts);
+  std::vector<vtkIdType> sourcePts;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (usedPts[ptId].load(std::memory_order_relaxed))
+    {
+      pointMap[ptId] = static_cast<vtkIdType>(sourcePts.size());
+      sourcePts.push_back(ptId);
+    }
+  }
+  const vtkIdType numOutPts = static_cast<vtkIdType>(sourcePts.size());
+  for (int type = 0; type < 3; ++type)
+  {
+    vtkIdType* connPtr = connectivity[type]->GetPointer(0);
+    vtkSMPTools::For(
+      0, connectivity[type]->GetNumberOfValues(), [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          connPtr[i] = pointMap[connPtr[i]];
+        }
+      });
+  }
+
+  // Copy the points and the attributes.
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(input->GetPoints()->GetDataType());
+  newPts->SetNumberOfPoints(numOutPts);
+  vtkDataArray* inCoords = input->GetPoints()->GetData();
+  vtkDataArray* outCoords = newPts->GetData();
+  outputPD->CopyGlobalIdsOn();
+  outputPD->CopyAllocate(inputPD, numOutPts);
+  ArrayList ptArrays;
+  ptArrays.AddArrays(numOutPts, inputPD, outputPD, 0.0, false);
+  vtkSMPTools::For(0, numOutPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      outCoords->SetTuple(ptId, sourcePts[ptId], inCoords);
+      ptArrays.Copy(sourcePts[ptId], ptId);
+    }
+  });
+
+  outputCD->CopyGlobalIdsOn();
+  outputCD->CopyAllocate(inputCD, numOutCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numOutCells, inputCD, outputCD, 0.0, false);
+  vtkSMPTools::For(0, numOutCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      cellArrays.Copy(sourceCells[cellId], cellId);
+    }
+  });
+
+  if (this->PassThroughCellIds)
+  {
+    vtkNew<vtkIdTypeArray> originalCellIds;
+    originalCellIds->SetName(this->GetOriginalCellIdsName());
+    originalCellIds->SetNumberOfValues(numOutCells);
+    std::copy(sourceCells.begin(), sourceCells.end(), originalCellIds->GetPointer(0));
+    outputCD->AddArray(originalCellIds);
+  }
+  if (this->PassThroughPointIds)
+  {
+    vtkNew<vtkIdTypeArray> originalPointIds;
+    originalPointIds->SetName(this->GetOriginalPointIdsName());
+    originalPointIds->SetNumberOfValues(numOutPts);
+    std::copy(sourcePts.begin(), sourcePts.end(), originalPointIds->GetPointer(0));
+    outputPD->AddArray(originalPointIds);
+  }
+
+  output->SetPoints(newPts);
+  vtkNew<vtkCellArray> cells[3];
+  for (int type = 0; type < 3; ++type)
+  {
+    cells[type]->SetData(offsets[type], connectivity[type]);
+  }
+  if (cells[0]->GetNumberOfCells() > 0)
+  {
+    output->SetVerts(cells[0]);
+  }
+  if (cells[1]->GetNumberOfCells() > 0)
+  {
+    output->SetLines(cells[1]);
+  }
+  output->SetPolys(cells[2]);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkDataSetSurfaceFilter::InitializeQuadHash(vtkIdType numPoints)
 {
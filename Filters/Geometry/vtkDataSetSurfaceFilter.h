@@ -91,6 +91,7 @@ class vtkIdTypeArray;
 class vtkImageData;
 class vtkRectilinearGrid;
 class vtkStructuredGrid;
+class vtkUnstructuredGrid;
 class vtkUnstructuredGridBase;
 
 // Helper structure for hashing faces.
@@ -217,6 +218,23 @@ public:
   vtkBooleanMacro(Delegation, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Extract the surface of unstructured grids with nonlinear cells using
+   * threads (default is off). The boundary faces of the 3D cells are matched
+   * in parallel over the hashes of their smallest corner id, and the output
+   * cells, including the triangulation of the quadratic faces, are generated
+   * in parallel. The output has the same cells and attributes as the serial
+   * extraction, but the boundary faces follow the order of their cells and
+   * the output points follow the order of the input points. Higher nonlinear
+   * subdivision levels than 1, Lagrange and Bezier cells, polyhedra and
+   * nonlinear 1D cells use the serial extraction.
+   */
+  vtkSetMacro(ParallelExtraction, vtkTypeBool);
+  vtkGetMacro(ParallelExtraction, vtkTypeBool);
+  vtkBooleanMacro(ParallelExtraction, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Direct access methods so that this class can be used as an
@@ -369,11 +387,13 @@ protected:
   vtkTypeBool AllowInterpolation;
   vtkTypeBool Delegation;
   bool FastMode;
+  vtkTypeBool ParallelExtraction;
 
 private:
   int UnstructuredGridBaseExecute(vtkDataSet* input, vtkPolyData* output);
   int UnstructuredGridExecuteInternal(
     vtkUnstructuredGridBase* input, vtkPolyData* output, bool handleSubdivision);
+  int ParallelUnstructuredGridExecute(vtkUnstructuredGrid* input, vtkPolyData* output);
 
   int StructuredExecuteNoBlanking(
     vtkDataSet* input, vtkPolyData* output, vtkIdType* ext, vtkIdType* wholeExt);
@@ -213,24 +213,38 @@ int vtkGeometryFilter::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // Prepare to delegate based on dataset type and characteristics.
+  int ret;
   if (vtkPolyData::SafeDownCast(input))
   {
-    return this->PolyDataExecute(input, output, excFaces);
+    ret = this->PolyDataExecute(input, output, excFaces);
   }
   else if (vtkUnstructuredGridBase::SafeDownCast(input))
   {
-    return this->UnstructuredGridExecute(input, output, nullptr, excFaces);
+    ret = this->UnstructuredGridExecute(input, output, nullptr, excFaces);
   }
   else if (vtkImageData::SafeDownCast(input) || vtkRectilinearGrid::SafeDownCast(input) ||
     vtkStructuredGrid::SafeDownCast(input))
   {
-    return this->StructuredExecute(input, output, wholeExtent, excFaces);
+    ret = this->StructuredExecute(input, output, wholeExtent, excFaces);
   }
   else
   {
     // Use the general case
-    return this->DataSetExecute(input, output, excFaces);
+    ret = this->DataSetExecute(input, output, excFaces);
   }
+
+  // The cell arrays of the output are generated by this filter, they may be
+  // converted to 32-bit storage.
+  vtkCellArray* outputCells[4] = { output->GetVerts(), output->GetLines(), output->GetPolys(),
+    output->GetStrips() };
+  for (auto cells : outputCells)
+  {
+    if (cells->GetNumberOfCells() > 0)
+    {
+      cells->ConvertToPreferredStorage();
+    }
+  }
+  return ret;
 }
 
 //------------------------------------------------------------------------------
@@ -20,6 +20,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkProp3D.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkSignedCharArray.h"
 #include "vtkTransform.h"
@@ -294,10 +295,10 @@ int vtkDepthSortPolyData::RequestData(vtkInformation* vtkNotUsed(request),
           // sort cell ids by depth
           if (this->Direction == VTK_DIRECTION_FRONT_TO_BACK) {
             ::lessf<VTK_TT> comp(depth);
-            std::sort(order, order + nCells, comp);
+            vtkSMPTools::Sort(order, order + nCells, comp);
           } else {
             ::greaterf<VTK_TT> comp(depth);
-            std::sort(order, order + nCells, comp);
+            vtkSMPTools::Sort(order, order + nCells, comp);
           }
 
           delete[] depth;);
@@ -329,12 +330,12 @@ int vtkDepthSortPolyData::RequestData(vtkInformation* vtkNotUsed(request),
       if (this->Direction == VTK_DIRECTION_FRONT_TO_BACK)
       {
         ::lessf<double> comp(depth);
-        std::sort(order, order + nCells, comp);
+        vtkSMPTools::Sort(order, order + nCells, comp);
       }
       else
       {
         ::greaterf<double> comp(depth);
-        std::sort(order, order + nCells, comp);
+        vtkSMPTools::Sort(order, order + nCells, comp);
       }
 
       delete[] weight;
@@ -0,0 +1,252 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded subdivision of triangle meshes numbers the new
+// points in the order of the serial edge traversal, passes the cell data to
+// the new triangles, and does not depend on the number of threads, for the
+// Linear, Loop and Butterfly schemes on closed and open meshes.
+
+#include "vtkButterflySubdivisionFilter.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkEdgeTable.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLinearSubdivisionFilter.h"
+#include "vtkLoopSubdivisionFilter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <type_traits>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A sphere, or half of it, with a linear point scalar and the ids of the cells.
+void CreateSphere(vtkPolyData* sphere, bool half)
+{
+  vtkNew<vtkSphereSource> source;
+  source->SetThetaResolution(24);
+  source->SetPhiResolution(16);
+  source->SetEndTheta(half ? 180.0 : 360.0);
+  source->Update();
+  sphere->ShallowCopy(source->GetOutput());
+  sphere->GetPointData()->Initialize();
+
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Linear");
+  scalars->SetNumberOfTuples(sphere->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < sphere->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    sphere->GetPoint(ptId, x);
+    scalars->SetValue(ptId, x[0] + 2.0 * x[1] + 3.0 * x[2]);
+  }
+  sphere->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < sphere->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+  }
+  sphere->GetCellData()->AddArray(cellIds);
+}
+
+//------------------------------------------------------------------------------
+// Check that the point of each edge of each input triangle has the id the
+// serial traversal gives it, and that the new triangles keep the cell data of
+// their parent.
+bool CheckNumbering(vtkPolyData* input, vtkPolyData* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkNew<vtkEdgeTable> edgeTable;
+  edgeTable->InitEdgeInsertion(numPts);
+  vtkIdType numEdges = 0;
+  vtkDataArray* cellIds = output->GetCellData()->GetArray("CellIds");
+  if (output->GetNumberOfCells() != 4 * numCells || !cellIds)
+  {
+    std::cerr << "Got " << output->GetNumberOfCells() << " cells instead of " << 4 * numCells
+              << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkIdList> pts;
+  vtkNew<vtkIdList> newPts;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    input->GetCellPoints(cellId, pts);
+    vtkIdType edgePts[3];
+    vtkIdType p1 = pts->GetId(2);
+    for (int edgeId = 0; edgeId < 3; ++edgeId)
+    {
+      const vtkIdType p2 = pts->GetId(edgeId);
+      vtkIdType id = edgeTable->IsEdge(p1, p2);
+      if (id < 0)
+      {
+        edgeTable->InsertEdge(p1, p2);
+        id = numEdges++;
+      }
+      edgePts[edgeId] = numPts + id;
+      p1 = p2;
+    }
+    const vtkIdType expected[12] = { pts->GetId(0), edgePts[1], edgePts[0], edgePts[1],
+      pts->GetId(1), edgePts[2], edgePts[2], pts->GetId(2), edgePts[0], edgePts[1], edgePts[2],
+      edgePts[0] };
+    for (vtkIdType i = 0; i < 4; ++i)
+    {
+      output->GetCellPoints(4 * cellId + i, newPts);
+      bool same = newPts->GetNumberOfIds() == 3 && cellIds->GetTuple1(4 * cellId + i) == cellId;
+      for (vtkIdType j = 0; same && j < 3; ++j)
+      {
+        same = newPts->GetId(j) == expected[3 * i + j];
+      }
+      if (!same)
+      {
+        std::cerr << "Wrong triangle " << i << " of cell " << cellId << std::endl;
+        return false;
+      }
+    }
+  }
+  if (output->GetNumberOfPoints() != numPts + numEdges)
+  {
+    std::cerr << "Got " << output->GetNumberOfPoints() << " points instead of "
+              << numPts + numEdges << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool SameOutputs(vtkPolyData* output0, vtkPolyData* output1)
+{
+  if (output0->GetNumberOfPoints() != output1->GetNumberOfPoints() ||
+    output0->GetNumberOfCells() != output1->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkDataArray* scalars0 = output0->GetPointData()->GetArray("Linear");
+  vtkDataArray* scalars1 = output1->GetPointData()->GetArray("Linear");
+  for (vtkIdType ptId = 0; ptId < output0->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    output0->GetPoint(ptId, x);
+    output1->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+      scalars0->GetTuple1(ptId) != scalars1->GetTuple1(ptId))
+    {
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> pts0;
+  vtkNew<vtkIdList> pts1;
+  for (vtkIdType cellId = 0; cellId < output0->GetNumberOfCells(); ++cellId)
+  {
+    output0->GetCellPoints(cellId, pts0);
+    output1->GetCellPoints(cellId, pts1);
+    if (pts0->GetNumberOfIds() != pts1->GetNumberOfIds() ||
+      !std::equal(pts0->begin(), pts0->end(), pts1->begin()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename FilterT>
+bool TestSubdivision(vtkPolyData* input)
+{
+  vtkNew<FilterT> level1;
+  level1->SetInputData(input);
+  level1->Update();
+  if (!CheckNumbering(input, level1->GetOutput()))
+  {
+    return false;
+  }
+
+  // The linear scheme interpolates the linear scalar exactly.
+  vtkPolyData* output = level1->GetOutput();
+  vtkDataArray* scalars = output->GetPointData()->GetArray("Linear");
+  if (!scalars || scalars->GetNumberOfTuples() != output->GetNumberOfPoints())
+  {
+    std::cerr << "Missing point data." << std::endl;
+    return false;
+  }
+  if (std::is_same<FilterT, vtkLinearSubdivisionFilter>::value)
+  {
+    for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+    {
+      double x[3];
+      output->GetPoint(ptId, x);
+      if (std::abs(scalars->GetTuple1(ptId) - (x[0] + 2.0 * x[1] + 3.0 * x[2])) > 1e-5)
+      {
+        std::cerr << "Wrong point data at point " << ptId << std::endl;
+        return false;
+      }
+    }
+  }
+
+  // Several levels do not depend on the number of threads.
+  vtkSmartPointer<vtkPolyData> outputs[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkNew<FilterT> subdivision;
+    subdivision->SetInputData(input);
+    subdivision->SetNumberOfSubdivisions(3);
+    if (i == 0)
+    {
+      vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { subdivision->Update(); });
+    }
+    else
+    {
+      subdivision->Update();
+    }
+    outputs[i] = subdivision->GetOutput();
+  }
+  if (outputs[0]->GetNumberOfCells() != 64 * input->GetNumberOfCells() ||
+    !SameOutputs(outputs[0], outputs[1]))
+  {
+    std::cerr << "The outputs depend on the number of threads." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestSubdivisionFiltersParallel(int, char*[])
+{
+  for (bool half : { false, true })
+  {
+    vtkNew<vtkPolyData> sphere;
+    CreateSphere(sphere, half);
+    const char* mesh = half ? " on a half sphere." : " on a sphere.";
+    if (!TestSubdivision<vtkLinearSubdivisionFilter>(sphere))
+    {
+      std::cerr << "vtkLinearSubdivisionFilter failed" << mesh << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!TestSubdivision<vtkLoopSubdivisionFilter>(sphere))
+    {
+      std::cerr << "vtkLoopSubdivisionFilter failed" << mesh << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!TestSubdivision<vtkButterflySubdivisionFilter>(sphere))
+    {
+      std::cerr << "vtkButterflySubdivisionFilter failed" << mesh << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -5,12 +5,19 @@
 #include "vtkCellArray.h"
 #include "vtkEdgeTable.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <atomic>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkButterflySubdivisionFilter);
 
@@ -25,26 +32,24 @@ static const double butterflyWeights[8] = { .5, .5, .125, .125, -.0625, -.0625,
 int vtkButterflySubdivisionFilter::GenerateSubdivisionPoints(
   vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts, vtkPointData* outputPD)
 {
+  if (vtkSubdivisionFilter::HasOnlyTriangles(inputDS))
+  {
+    return this->GenerateSubdivisionPointsInParallel(inputDS, edgeData, outputPts, outputPD);
+  }
+
   const vtkIdType* pts = nullptr;
-  vtkIdType cellId, newId, i, j;
+  vtkIdType cellId, newId;
   int edgeId;
   vtkIdType npts = 0;
   vtkIdType p1, p2;
-  int valence1, valence2;
   vtkCellArray* inputPolys = inputDS->GetPolys();
   vtkSmartPointer<vtkEdgeTable> edgeTable = vtkSmartPointer<vtkEdgeTable>::New();
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
-  vtkSmartPointer<vtkIdList> p1CellIds = vtkSmartPointer<vtkIdList>::New();
-  vtkSmartPointer<vtkIdList> p2CellIds = vtkSmartPointer<vtkIdList>::New();
   vtkSmartPointer<vtkIdList> stencil = vtkSmartPointer<vtkIdList>::New();
-  vtkSmartPointer<vtkIdList> stencil1 = vtkSmartPointer<vtkIdList>::New();
-  vtkSmartPointer<vtkIdList> stencil2 = vtkSmartPointer<vtkIdList>::New();
   vtkPoints* inputPts = inputDS->GetPoints();
   vtkPointData* inputPD = inputDS->GetPointData();
 
   double weights[256];
-  double weights1[256];
-  double weights2[256];
 
   // Create an edge table to keep track of which edges we've processed
   edgeTable->InitEdgeInsertion(inputDS->GetNumberOfPoints());
@@ -72,55 +77,8 @@ int vtkButterflySubdivisionFilter::GenerateSubdivisionPoints(
         edgeTable->InsertEdge(p1, p2);
 
         inputDS->GetCellEdgeNeighbors(-1, p1, p2, cellIds);
-        // If this is a boundary edge. we need to use a special subdivision rule
-        if (cellIds->GetNumberOfIds() == 1)
-        {
-          // Compute new Position and PointData using the same subdivision scheme
-          this->GenerateBoundaryStencil(p1, p2, inputDS, stencil, weights);
-        } // boundary edge
-        else if (cellIds->GetNumberOfIds() == 2)
-        {
-          // find the valence of the two points
-          inputDS->GetPointCells(p1, p1CellIds);
-          valence1 = p1CellIds->GetNumberOfIds();
-          inputDS->GetPointCells(p2, p2CellIds);
-          valence2 = p2CellIds->GetNumberOfIds();
-
-          if (valence1 == 6 && valence2 == 6)
-          {
-            this->GenerateButterflyStencil(p1, p2, inputDS, stencil, weights);
-          }
-          else if (valence1 == 6 && valence2 != 6)
-          {
-            this->GenerateLoopStencil(p2, p1, inputDS, stencil, weights);
-          }
-          else if (valence1 != 6 && valence2 == 6)
-          {
-            this->GenerateLoopStencil(p1, p2, inputDS, stencil, weights);
-          }
-          else
-          {
-            // Edge connects two extraordinary vertices
-            this->GenerateLoopStencil(p2, p1, inputDS, stencil1, weights1);
-            this->GenerateLoopStencil(p1, p2, inputDS, stencil2, weights2);
-            // combine the two stencils and halve the weights
-            vtkIdType total = stencil1->GetNumberOfIds() + stencil2->GetNumberOfIds();
-            stencil->SetNumberOfIds(total);
-
-            j = 0;
-            for (i = 0; i < stencil1->GetNumberOfIds(); i++)
-            {
-              stencil->InsertId(j, stencil1->GetId(i));
-              weights[j++] = weights1[i] * .5;
-            }
-            for (i = 0; i < stencil2->GetNumberOfIds(); i++)
-            {
-              stencil->InsertId(j, stencil2->GetId(i));
-              weights[j++] = weights2[i] * .5;
-            }
-          }
-        }
-        else
+        if (!this->GenerateEdgeStencil(
+              p1, p2, cellIds->GetNumberOfIds(), inputDS, stencil, weights))
         {
           vtkErrorMacro("Dataset is non-manifold and cannot be subdivided.");
           return 0;
@@ -144,12 +102,126 @@ int vtkButterflySubdivisionFilter::GenerateSubdivisionPoints(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkButterflySubdivisionFilter::GenerateEdgeStencil(vtkIdType p1, vtkIdType p2,
+  vtkIdType numCells, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
+{
+  // If this is a boundary edge. we need to use a special subdivision rule
+  if (numCells == 1)
+  {
+    // Compute new Position and PointData using the same subdivision scheme
+    this->GenerateBoundaryStencil(p1, p2, polys, stencilIds, weights);
+  } // boundary edge
+  else if (numCells == 2)
+  {
+    // find the valence of the two points
+    vtkIdType valence1, valence2;
+    vtkIdType* cells;
+    polys->GetPointCells(p1, valence1, cells);
+    polys->GetPointCells(p2, valence2, cells);
+
+    if (valence1 == 6 && valence2 == 6)
+    {
+      this->GenerateButterflyStencil(p1, p2, polys, stencilIds, weights);
+    }
+    else if (valence1 == 6 && valence2 != 6)
+    {
+      this->GenerateLoopStencil(p2, p1, polys, stencilIds, weights);
+    }
+    else if (valence1 != 6 && valence2 == 6)
+    {
+      this->GenerateLoopStencil(p1, p2, polys, stencilIds, weights);
+    }
+    else
+    {
+      // Edge connects two extraordinary vertices
+      vtkNew<vtkIdList> stencil1;
+      vtkNew<vtkIdList> stencil2;
+      double weights1[256];
+      double weights2[256];
+      this->GenerateLoopStencil(p2, p1, polys, stencil1, weights1);
+      this->GenerateLoopStencil(p1, p2, polys, stencil2, weights2);
+      // combine the two stencils and halve the weights
+      vtkIdType total = stencil1->GetNumberOfIds() + stencil2->GetNumberOfIds();
+      stencilIds->SetNumberOfIds(total);
+
+      vtkIdType j = 0;
+      for (vtkIdType i = 0; i < stencil1->GetNumberOfIds(); i++)
+      {
+        stencilIds->InsertId(j, stencil1->GetId(i));
+        weights[j++] = weights1[i] * .5;
+      }
+      for (vtkIdType i = 0; i < stencil2->GetNumberOfIds(); i++)
+      {
+        stencilIds->InsertId(j, stencil2->GetId(i));
+        weights[j++] = weights2[i] * .5;
+      }
+    }
+  }
+  else
+  {
+    return 0;
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkButterflySubdivisionFilter::GenerateSubdivisionPointsInParallel(
+  vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts, vtkPointData* outputPD)
+{
+  vtkPoints* inputPts = inputDS->GetPoints();
+  vtkPointData* inputPD = inputDS->GetPointData();
+  const vtkIdType numPts = inputDS->GetNumberOfPoints();
+
+  // The point of each edge follows the old points, numbered as the serial
+  // traversal of the triangles would.
+  vtkNew<vtkIdTypeArray> edges;
+  const vtkIdType numEdges = this->EnumerateEdges(inputDS, numPts, edgeData, edges);
+  if (numEdges < 0)
+  {
+    return 0;
+  }
+  outputPts->Resize(numPts + numEdges);
+  outputPts->SetNumberOfPoints(numPts + numEdges);
+  outputPD->SetNumberOfTuples(numPts + numEdges);
+  outputPD->CopyData(inputPD, 0, numPts, 0);
+
+  vtkSMPThreadLocalObject<vtkIdList> localStencil;
+  vtkSMPTools::For(0, numEdges, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* stencil = localStencil.Local();
+    double weights[256];
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    const vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType edgeId = begin; edgeId < end; ++edgeId)
+    {
+      if (edgeId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      const vtkIdType* edge = edges->GetPointer(3 * edgeId);
+      this->GenerateEdgeStencil(edge[0], edge[1], edge[2], inputDS, stencil, weights);
+      this->InterpolatePosition(inputPts, outputPts, numPts + edgeId, stencil, weights);
+      outputPD->InterpolatePoint(inputPD, numPts + edgeId, stencil, weights);
+    }
+  });
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkButterflySubdivisionFilter::GenerateLoopStencil(
   vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
 {
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
-  vtkCell* cell;
+  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
+  vtkIdType npts;
+  const vtkIdType* cell;
   vtkIdType startCell, nextCell, tp2, p;
   int shift[255];
   int processed = 0;
@@ -168,11 +240,11 @@ void vtkButterflySubdivisionFilter::GenerateLoopStencil(
   tp2 = p2;
   while (nextCell != startCell)
   {
-    cell = polys->GetCell(nextCell);
+    polys->GetCellPoints(nextCell, npts, cell, ptIds);
     p = -1;
     for (int i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != tp2)
+      if ((p = cell[i]) != p1 && cell[i] != tp2)
       {
         break;
       }
@@ -225,11 +297,11 @@ void vtkButterflySubdivisionFilter::GenerateLoopStencil(
   }
   else
   { // K == 2. p1 must be on a boundary edge,
-    cell = polys->GetCell(startCell);
+    polys->GetCellPoints(startCell, npts, cell, ptIds);
     p = -1;
     for (int i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+      if ((p = cell[i]) != p1 && cell[i] != p2)
       {
         break;
       }
@@ -250,6 +322,7 @@ void vtkButterflySubdivisionFilter::GenerateBoundaryStencil(
   vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
 {
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
   vtkIdType* cells;
   vtkIdType ncells;
   const vtkIdType* pts;
@@ -262,7 +335,7 @@ void vtkButterflySubdivisionFilter::GenerateBoundaryStencil(
   p0 = -1;
   for (i = 0; i < ncells && p0 == -1; i++)
   {
-    polys->GetCellPoints(cells[i], npts, pts);
+    polys->GetCellPoints(cells[i], npts, pts, ptIds);
     for (j = 0; j < npts; j++)
     {
       if (pts[j] == p1 || pts[j] == p2)
@@ -282,7 +355,7 @@ void vtkButterflySubdivisionFilter::GenerateBoundaryStencil(
   p3 = -1;
   for (i = 0; i < ncells && p3 == -1; i++)
   {
-    polys->GetCellPoints(cells[i], npts, pts);
+    polys->GetCellPoints(cells[i], npts, pts, ptIds);
     for (j = 0; j < npts; j++)
     {
       if (pts[j] == p1 || pts[j] == p2 || pts[j] == p0)
@@ -321,7 +394,9 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
 {
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
-  vtkCell* cell;
+  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
+  vtkIdType npts;
+  const vtkIdType* cell;
   int i;
   vtkIdType cell0, cell1;
   vtkIdType p, p3, p4, p5, p6, p7, p8;
@@ -330,21 +405,21 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   cell0 = cellIds->GetId(0);
   cell1 = cellIds->GetId(1);
 
-  cell = polys->GetCell(cell0);
+  polys->GetCellPoints(cell0, npts, cell, ptIds);
   p3 = -1;
   for (i = 0; i < 3; i++)
   {
-    if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+    if ((p = cell[i]) != p1 && cell[i] != p2)
     {
       p3 = p;
       break;
     }
   }
-  cell = polys->GetCell(cell1);
+  polys->GetCellPoints(cell1, npts, cell, ptIds);
   p4 = -1;
   for (i = 0; i < 3; i++)
   {
-    if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+    if ((p = cell[i]) != p1 && cell[i] != p2)
     {
       p4 = p;
       break;
@@ -355,10 +430,10 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   p5 = -1;
   if (cellIds->GetNumberOfIds() > 0)
   {
-    cell = polys->GetCell(cellIds->GetId(0));
+    polys->GetCellPoints(cellIds->GetId(0), npts, cell, ptIds);
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p3)
+      if ((p = cell[i]) != p1 && cell[i] != p3)
       {
         p5 = p;
         break;
@@ -370,10 +445,10 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   p6 = -1;
   if (cellIds->GetNumberOfIds() > 0)
   {
-    cell = polys->GetCell(cellIds->GetId(0));
+    polys->GetCellPoints(cellIds->GetId(0), npts, cell, ptIds);
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p2 && cell->GetPointId(i) != p3)
+      if ((p = cell[i]) != p2 && cell[i] != p3)
       {
         p6 = p;
         break;
@@ -385,10 +460,10 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   p7 = -1;
   if (cellIds->GetNumberOfIds() > 0)
   {
-    cell = polys->GetCell(cellIds->GetId(0));
+    polys->GetCellPoints(cellIds->GetId(0), npts, cell, ptIds);
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p4)
+      if ((p = cell[i]) != p1 && cell[i] != p4)
       {
         p7 = p;
         break;
@@ -400,10 +475,10 @@ void vtkButterflySubdivisionFilter::GenerateButterflyStencil(
   polys->GetCellEdgeNeighbors(cell1, p2, p4, cellIds);
   if (cellIds->GetNumberOfIds() > 0)
   {
-    cell = polys->GetCell(cellIds->GetId(0));
+    polys->GetCellPoints(cellIds->GetId(0), npts, cell, ptIds);
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p2 && cell->GetPointId(i) != p4)
+      if ((p = cell[i]) != p2 && cell[i] != p4)
       {
         p8 = p;
         break;
@@ -61,6 +61,10 @@ protected:
 private:
   int GenerateSubdivisionPoints(vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts,
     vtkPointData* outputPD) override;
+  int GenerateSubdivisionPointsInParallel(
+    vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts, vtkPointData* outputPD);
+  int GenerateEdgeStencil(vtkIdType p1, vtkIdType p2, vtkIdType numCells, vtkPolyData* polys,
+    vtkIdList* stencilIds, double* weights);
   void GenerateButterflyStencil(
     vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights);
   void GenerateLoopStencil(
@@ -5,9 +5,15 @@
 #include "vtkCellArray.h"
 #include "vtkEdgeTable.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkLinearSubdivisionFilter);
@@ -20,6 +26,11 @@ void vtkLinearSubdivisionFilter::PrintSelf(ostream& os, vtkIndent indent)
 int vtkLinearSubdivisionFilter::GenerateSubdivisionPoints(
   vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts, vtkPointData* outputPD)
 {
+  if (vtkSubdivisionFilter::HasOnlyTriangles(inputDS))
+  {
+    return this->GenerateSubdivisionPointsInParallel(inputDS, edgeData, outputPts, outputPD);
+  }
+
   const vtkIdType* pts = nullptr;
   int edgeId;
   vtkIdType npts, cellId, newId;
@@ -92,4 +103,55 @@ int vtkLinearSubdivisionFilter::GenerateSubdivisionPoints(
 
   return 1;
 }
+
+//------------------------------------------------------------------------------
+int vtkLinearSubdivisionFilter::GenerateSubdivisionPointsInParallel(
+  vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts, vtkPointData* outputPD)
+{
+  vtkPoints* inputPts = inputDS->GetPoints();
+  vtkPointData* inputPD = inputDS->GetPointData();
+  const vtkIdType numPts = inputDS->GetNumberOfPoints();
+
+  // The point of each edge follows the old points, numbered as the serial
+  // traversal of the triangles would.
+  vtkNew<vtkIdTypeArray> edges;
+  const vtkIdType numEdges = this->EnumerateEdges(inputDS, numPts, edgeData, edges);
+  if (numEdges < 0)
+  {
+    return 0;
+  }
+  outputPts->Resize(numPts + numEdges);
+  outputPts->SetNumberOfPoints(numPts + numEdges);
+  outputPD->SetNumberOfTuples(numPts + numEdges);
+  outputPD->CopyData(inputPD, 0, numPts, 0);
+
+  vtkSMPThreadLocalObject<vtkIdList> localPointIds;
+  vtkSMPTools::For(0, numEdges, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* pointIds = localPointIds.Local();
+    pointIds->SetNumberOfIds(2);
+    double weights[2] = { .5, .5 };
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    const vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType edgeId = begin; edgeId < end; ++edgeId)
+    {
+      if (edgeId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      const vtkIdType* edge = edges->GetPointer(3 * edgeId);
+      pointIds->SetId(0, edge[0]);
+      pointIds->SetId(1, edge[1]);
+      this->InterpolatePosition(inputPts, outputPts, numPts + edgeId, pointIds, weights);
+      outputPD->InterpolatePoint(inputPD, numPts + edgeId, pointIds, weights);
+    }
+  });
+  return 1;
+}
 VTK_ABI_NAMESPACE_END
@@ -49,6 +49,11 @@ protected:
     vtkPointData* outputPD) override;
 
 private:
+  // Generate the points of the edges in parallel over the edges, when the
+  // input only holds triangles.
+  int GenerateSubdivisionPointsInParallel(
+    vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts, vtkPointData* outputPD);
+
   vtkLinearSubdivisionFilter(const vtkLinearSubdivisionFilter&) = delete;
   void operator=(const vtkLinearSubdivisionFilter&) = delete;
 };
@@ -7,15 +7,22 @@
 #include "vtkCellIterator.h"
 #include "vtkEdgeTable.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <atomic>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkLoopSubdivisionFilter);
 
@@ -30,6 +37,11 @@ static const double LoopWeights[4] = { .375, .375, .125, .125 };
 int vtkLoopSubdivisionFilter::GenerateSubdivisionPoints(
   vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts, vtkPointData* outputPD)
 {
+  if (vtkSubdivisionFilter::HasOnlyTriangles(inputDS))
+  {
+    return this->GenerateSubdivisionPointsInParallel(inputDS, edgeData, outputPts, outputPD);
+  }
+
   const vtkIdType* pts = nullptr;
   vtkIdType numPts, cellId, newId;
   int edgeId;
@@ -126,13 +138,85 @@ int vtkLoopSubdivisionFilter::GenerateSubdivisionPoints(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkLoopSubdivisionFilter::GenerateSubdivisionPointsInParallel(
+  vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts, vtkPointData* outputPD)
+{
+  vtkPoints* inputPts = inputDS->GetPoints();
+  vtkPointData* inputPD = inputDS->GetPointData();
+  const vtkIdType numPts = inputDS->GetNumberOfPoints();
+
+  // The even points keep the ids of the old points, and the odd point of each
+  // edge follows them, numbered as the serial traversal of the triangles would.
+  vtkNew<vtkIdTypeArray> edges;
+  const vtkIdType numEdges = this->EnumerateEdges(inputDS, numPts, edgeData, edges);
+  if (numEdges < 0)
+  {
+    return 0;
+  }
+  outputPts->SetNumberOfPoints(numPts + numEdges);
+  outputPD->SetNumberOfTuples(numPts + numEdges);
+
+  std::atomic<bool> failed(false);
+  vtkSMPThreadLocalObject<vtkIdList> localStencil;
+  vtkSMPTools::For(0, numPts + numEdges, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* stencil = localStencil.Local();
+    double weights[256];
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    const vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType ptId = begin; ptId < end && !failed; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      if (ptId < numPts)
+      {
+        if (!this->GenerateEvenStencil(ptId, inputDS, stencil, weights))
+        {
+          failed = true;
+          break;
+        }
+      }
+      else
+      {
+        const vtkIdType* edge = edges->GetPointer(3 * (ptId - numPts));
+        if (edge[2] == 1)
+        {
+          // boundary edge
+          stencil->SetNumberOfIds(2);
+          stencil->SetId(0, edge[0]);
+          stencil->SetId(1, edge[1]);
+          weights[0] = .5;
+          weights[1] = .5;
+        }
+        else
+        {
+          this->GenerateOddStencil(edge[0], edge[1], inputDS, stencil, weights);
+        }
+      }
+      this->InterpolatePosition(inputPts, outputPts, ptId, stencil, weights);
+      outputPD->InterpolatePoint(inputPD, ptId, stencil, weights);
+    }
+  });
+  return failed ? 0 : 1;
+}
+
 //------------------------------------------------------------------------------
 int vtkLoopSubdivisionFilter::GenerateEvenStencil(
   vtkIdType p1, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
 {
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
   vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
-  vtkCell* cell;
+  vtkIdType npts;
+  const vtkIdType* cell;
 
   int i;
   vtkIdType j;
@@ -179,11 +263,11 @@ int vtkLoopSubdivisionFilter::GenerateEvenStencil(
   // walk around the loop counter-clockwise and get cells
   for (j = 0; j < numCellsInLoop; j++)
   {
-    cell = polys->GetCell(nextCell);
+    polys->GetCellPoints(nextCell, npts, cell, ptIds);
     p = -1;
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+      if ((p = cell[i]) != p1 && cell[i] != p2)
       {
         break;
       }
@@ -206,11 +290,11 @@ int vtkLoopSubdivisionFilter::GenerateEvenStencil(
   p2 = bp1;
   for (; j < numCellsInLoop && startCell != -1; j++)
   {
-    cell = polys->GetCell(nextCell);
+    polys->GetCellPoints(nextCell, npts, cell, ptIds);
     p = -1;
     for (i = 0; i < 3; i++)
     {
-      if ((p = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+      if ((p = cell[i]) != p1 && cell[i] != p2)
       {
         break;
       }
@@ -267,7 +351,9 @@ void vtkLoopSubdivisionFilter::GenerateOddStencil(
   vtkIdType p1, vtkIdType p2, vtkPolyData* polys, vtkIdList* stencilIds, double* weights)
 {
   vtkSmartPointer<vtkIdList> cellIds = vtkSmartPointer<vtkIdList>::New();
-  vtkCell* cell;
+  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
+  vtkIdType npts;
+  const vtkIdType* cell;
   int i;
   vtkIdType cell0, cell1;
   vtkIdType p3 = 0, p4 = 0;
@@ -276,18 +362,18 @@ void vtkLoopSubdivisionFilter::GenerateOddStencil(
   cell0 = cellIds->GetId(0);
   cell1 = cellIds->GetId(1);
 
-  cell = polys->GetCell(cell0);
+  polys->GetCellPoints(cell0, npts, cell, ptIds);
   for (i = 0; i < 3; i++)
   {
-    if ((p3 = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+    if ((p3 = cell[i]) != p1 && cell[i] != p2)
     {
       break;
     }
   }
-  cell = polys->GetCell(cell1);
+  polys->GetCellPoints(cell1, npts, cell, ptIds);
   for (i = 0; i < 3; i++)
   {
-    if ((p4 = cell->GetPointId(i)) != p1 && cell->GetPointId(i) != p2)
+    if ((p4 = cell[i]) != p1 && cell[i] != p2)
     {
       break;
     }
@@ -68,6 +68,11 @@ protected:
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
 private:
+  // Generate the even and the odd points in parallel over the points, when
+  // the input only holds triangles.
+  int GenerateSubdivisionPointsInParallel(
+    vtkPolyData* inputDS, vtkIntArray* edgeData, vtkPoints* outputPts, vtkPointData* outputPD);
+
   vtkLoopSubdivisionFilter(const vtkLoopSubdivisionFilter&) = delete;
   void operator=(const vtkLoopSubdivisionFilter&) = delete;
 };
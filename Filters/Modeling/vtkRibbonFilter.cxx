@@ -5,14 +5,23 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkRibbonFilter);
@@ -33,6 +42,7 @@ vtkRibbonFilter::vtkRibbonFilter()
 
   this->GenerateTCoords = 0;
   this->TextureLength = 1.0;
+  this->ParallelGeneration = false;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(
@@ -163,56 +173,64 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   //
   this->Theta = vtkMath::RadiansFromDegrees(this->Angle);
   vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
-  for (inCellId = 0, inLines->InitTraversal(); inLines->GetNextCell(npts, pts) && !abort;
-       inCellId++)
+  if (this->ParallelGeneration)
   {
-    this->UpdateProgress((double)inCellId / numLines);
-    abort = this->CheckAbort();
-
-    if (npts < 2)
+    this->GenerateRibbonsInParallel(input, newPts, outPD, outCD, newNormals, newTCoords, newStrips,
+      inScalars, range, inNormals, generateNormals != 0);
+  }
+  else
+  {
+    for (inCellId = 0, inLines->InitTraversal(); inLines->GetNextCell(npts, pts) && !abort;
+         inCellId++)
     {
-      vtkWarningMacro(<< "Less than two points in line!");
-      continue; // skip tubing this polyline
-    }
+      this->UpdateProgress((double)inCellId / numLines);
+      abort = this->CheckAbort();
 
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-    {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      if (!vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals))
+      if (npts < 2)
       {
-        vtkWarningMacro(<< "No normals for line!");
+        vtkWarningMacro(<< "Less than two points in line!");
         continue; // skip tubing this polyline
       }
-    }
 
-    // Generate the points around the polyline. The strip is not created
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(
-          offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
-    {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip ribboning this polyline
-    }
+      // If necessary calculate normals, each polyline calculates its
+      // normals independently, avoiding conflicts at shared vertices.
+      if (generateNormals)
+      {
+        singlePolyline->Reset(); // avoid instantiation
+        singlePolyline->InsertNextCell(npts, pts);
+        if (!vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals))
+        {
+          vtkWarningMacro(<< "No normals for line!");
+          continue; // skip tubing this polyline
+        }
+      }
+
+      // Generate the points around the polyline. The strip is not created
+      // if the polyline is bad.
+      //
+      if (!this->GeneratePoints(
+            offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
+      {
+        vtkWarningMacro(<< "Could not generate points!");
+        continue; // skip ribboning this polyline
+      }
 
-    // Generate the strip for this polyline
-    //
-    this->GenerateStrip(offset, npts, pts, inCellId, cd, outCD, newStrips);
+      // Generate the strip for this polyline
+      //
+      this->GenerateStrip(offset, npts, pts, inCellId, cd, outCD, newStrips);
 
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
-    {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
-    }
+      // Generate the texture coordinates for this polyline
+      //
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      }
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
+      // Compute the new offset for the next polyline
+      offset = this->ComputeOffset(offset, npts);
 
-  } // for all polylines
+    } // for all polylines
+  }
 
   singlePolyline->Delete();
 
@@ -244,6 +262,173 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Generate the ribbons of all the polylines in parallel. The points of each
+// polyline are counted first, then the ribbons are generated at their
+// offsets, so that the output is the one of the serial traversal. The normals
+// of each polyline are computed in an array local to the thread, the
+// polylines sharing points get the same normals as in the serial traversal.
+void vtkRibbonFilter::GenerateRibbonsInParallel(vtkPolyData* input, vtkPoints* newPts,
+  vtkPointData* outPD, vtkCellData* outCD, vtkFloatArray* newNormals, vtkFloatArray* newTCoords,
+  vtkCellArray* newStrips, vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals,
+  bool generateNormals)
+{
+  vtkPoints* inPts = input->GetPoints();
+  vtkPointData* pd = input->GetPointData();
+  vtkCellData* cd = input->GetCellData();
+  vtkCellArray* inLines = input->GetLines();
+  const vtkIdType numPts = inPts->GetNumberOfPoints();
+  const vtkIdType numLines = inLines->GetNumberOfCells();
+
+  // The number of points of each polyline, or 0 if it is not ribboned.
+  std::vector<vtkIdType> lineSizes(numLines);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType lineId = begin; lineId < end; ++lineId)
+    {
+      const vtkIdType npts = inLines->GetCellSize(lineId);
+      lineSizes[lineId] = npts < 2 ? 0 : npts;
+    }
+  });
+  for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+  {
+    if (lineSizes[lineId] == 0)
+    {
+      vtkWarningMacro(<< "Less than two points in line!");
+    }
+  }
+
+  // A ribbon has two points per point of its polyline, and a single strip
+  // through all of them, so the connectivity of a strip is its points.
+  std::vector<vtkIdType> pointOffsets(numLines + 1);
+  std::vector<vtkIdType> stripIds(numLines);
+  std::vector<unsigned char> failedLines(numLines, 0);
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> connectivity;
+  vtkSMPThreadLocalObject<vtkIdList> localCellPts;
+  vtkSMPThreadLocalObject<vtkFloatArray> localNormals;
+  vtkSMPThreadLocalObject<vtkCellArray> localPolyline;
+
+  // The polylines whose normals or points cannot be generated are skipped,
+  // as in the serial traversal, by generating the other ones again.
+  bool failed = true;
+  while (failed && !this->GetAbortOutput())
+  {
+    vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType lineId = begin; lineId < end; ++lineId)
+      {
+        pointOffsets[lineId] = this->ComputeOffset(0, lineSizes[lineId]);
+        stripIds[lineId] = lineSizes[lineId] > 0 ? 1 : 0;
+      }
+    });
+    const vtkIdType numNewPts = pointOffsets[numLines] = vtkSMPTools::ExclusiveScan(
+      pointOffsets.begin(), pointOffsets.end() - 1, pointOffsets.begin(), vtkIdType(0));
+    const vtkIdType numStrips =
+      vtkSMPTools::ExclusiveScan(stripIds.begin(), stripIds.end(), stripIds.begin(), vtkIdType(0));
+
+    // Inserting in arrays which have their final size is thread safe.
+    newPts->SetNumberOfPoints(numNewPts);
+    newNormals->SetNumberOfTuples(numNewPts);
+    if (newTCoords)
+    {
+      newTCoords->SetNumberOfTuples(numNewPts);
+    }
+    outPD->SetNumberOfTuples(numNewPts);
+    outCD->SetNumberOfTuples(numStrips);
+    offsets->SetNumberOfValues(numStrips + 1);
+    offsets->SetValue(numStrips, numNewPts);
+    connectivity->SetNumberOfValues(numNewPts);
+
+    std::atomic<bool> anyFailed(false);
+    vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* cellPts = localCellPts.Local();
+      const bool isFirst = vtkSMPTools::GetSingleThread();
+      const vtkIdType checkAbortInterval = std::min((end - begin) / 10 + 1, (vtkIdType)1000);
+      for (vtkIdType lineId = begin; lineId < end; ++lineId)
+      {
+        if (lineId % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        if (lineSizes[lineId] == 0)
+        {
+          continue; // skip ribboning this polyline
+        }
+        vtkIdType npts;
+        const vtkIdType* pts;
+        inLines->GetCellAtId(lineId, npts, pts, cellPts);
+
+        vtkDataArray* lineNormals = inNormals;
+        if (generateNormals)
+        {
+          vtkFloatArray* normals = localNormals.Local();
+          if (normals->GetNumberOfTuples() != numPts)
+          {
+            normals->SetNumberOfComponents(3);
+            normals->SetNumberOfTuples(numPts);
+          }
+          vtkCellArray* polyline = localPolyline.Local();
+          polyline->Reset();
+          polyline->InsertNextCell(npts, pts);
+          if (!vtkPolyLine::GenerateSlidingNormals(inPts, polyline, normals))
+          {
+            failedLines[lineId] = 1;
+            anyFailed = true;
+            continue;
+          }
+          lineNormals = normals;
+        }
+
+        const vtkIdType offset = pointOffsets[lineId];
+        if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals,
+              inScalars, range, lineNormals))
+        {
+          failedLines[lineId] = 2;
+          anyFailed = true;
+          continue;
+        }
+        const vtkIdType stripId = stripIds[lineId];
+        offsets->SetValue(stripId, offset);
+        outCD->CopyData(cd, lineId, stripId);
+        for (vtkIdType i = 0; i < 2 * npts; ++i)
+        {
+          connectivity->SetValue(offset + i, offset + i);
+        }
+        if (newTCoords)
+        {
+          this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+        }
+      }
+    });
+
+    failed = anyFailed;
+    for (vtkIdType lineId = 0; failed && lineId < numLines; ++lineId)
+    {
+      if (failedLines[lineId] == 1)
+      {
+        vtkWarningMacro(<< "No normals for line!");
+      }
+      else if (failedLines[lineId] == 2)
+      {
+        vtkWarningMacro(<< "Could not generate points!");
+      }
+      if (failedLines[lineId])
+      {
+        failedLines[lineId] = 0;
+        lineSizes[lineId] = 0;
+      }
+    }
+  }
+
+  newStrips->SetData(offsets, connectivity);
+}
+
 int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
   vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
   vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals)
@@ -510,5 +695,6 @@ void vtkRibbonFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Generate TCoords: " << this->GetGenerateTCoordsAsString() << endl;
   os << indent << "Texture Length: " << this->TextureLength << endl;
+  os << indent << "Parallel Generation: " << (this->ParallelGeneration ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -136,6 +136,18 @@ public:
   vtkGetMacro(TextureLength, double);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the threaded generation of the ribbons. When on, the points
+   * of each polyline are counted first, and the ribbons are then generated in
+   * parallel over the polylines at their offsets in the output, which is
+   * identical to the serial output. The default is Off
+   */
+  vtkSetMacro(ParallelGeneration, vtkTypeBool);
+  vtkGetMacro(ParallelGeneration, vtkTypeBool);
+  vtkBooleanMacro(ParallelGeneration, vtkTypeBool);
+  ///@}
+
 protected:
   vtkRibbonFilter();
   ~vtkRibbonFilter() override;
@@ -149,6 +161,7 @@ protected:
   vtkTypeBool UseDefaultNormal;
   int GenerateTCoords;  // control texture coordinate generation
   double TextureLength; // this length is mapped to [0,1) texture space
+  vtkTypeBool ParallelGeneration;
 
   // Helper methods
   int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
@@ -164,6 +177,11 @@ protected:
   double Theta;
 
 private:
+  void GenerateRibbonsInParallel(vtkPolyData* input, vtkPoints* newPts, vtkPointData* outPD,
+    vtkCellData* outCD, vtkFloatArray* newNormals, vtkFloatArray* newTCoords,
+    vtkCellArray* newStrips, vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals,
+    bool generateNormals);
+
   vtkRibbonFilter(const vtkRibbonFilter&) = delete;
   void operator=(const vtkRibbonFilter&) = delete;
 };
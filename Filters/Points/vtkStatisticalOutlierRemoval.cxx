@@ -12,6 +12,9 @@
 #include "vtkSMPTools.h"
 #include "vtkStaticPointLocator.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkStatisticalOutlierRemoval);
 vtkCxxSetObjectMacro(vtkStatisticalOutlierRemoval, Locator, vtkAbstractPointLocator);
@@ -28,6 +31,7 @@ struct ComputeMeanDistance
 {
   const T* Points;
   vtkAbstractPointLocator* Locator;
+  vtkStaticPointLocator* StaticLocator;
   int SampleSize;
   float* Distance;
   double Mean;
@@ -38,9 +42,16 @@ struct ComputeMeanDistance
   vtkSMPThreadLocal<double> ThreadMean;
   vtkSMPThreadLocal<vtkIdType> ThreadCount;
 
+  // The static point locator finds the closest points of blocks of points at
+  // once, in flat arrays.
+  vtkSMPThreadLocal<std::vector<double>> Queries;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> Ids;
+  vtkSMPThreadLocal<std::vector<double>> Dist2;
+
   ComputeMeanDistance(T* points, vtkAbstractPointLocator* loc, int size, float* d)
     : Points(points)
     , Locator(loc)
+    , StaticLocator(vtkStaticPointLocator::SafeDownCast(loc))
     , SampleSize(size)
     , Distance(d)
     , Mean(0.0)
@@ -64,12 +75,16 @@ struct ComputeMeanDistance
   // mean distances and count (for averaging in the Reduce() method).
   void operator()(vtkIdType ptId, vtkIdType endPtId)
   {
+    if (this->StaticLocator)
+    {
+      this->ComputeBlocks(ptId, endPtId);
+      return;
+    }
+
     const T* px = this->Points + 3 * ptId;
     const T* py;
     double x[3], y[3];
     vtkIdList*& pIds = this->PIds.Local();
-    double& threadMean = this->ThreadMean.Local();
-    vtkIdType& threadCount = this->ThreadCount.Local();
 
     for (; ptId < endPtId; ++ptId)
     {
@@ -97,20 +112,67 @@ struct ComputeMeanDistance
         }
       } // sum the lengths of all samples exclusing current point
 
-      // Average the lengths; again exclude ourselves
-      if (numPts > 0)
+      this->SetDistance(ptId, sum, numPts);
+    }
+  }
+
+  // Same as above with the batched queries of the static point locator, which
+  // also returns the squared distances.
+  void ComputeBlocks(vtkIdType ptId, vtkIdType endPtId)
+  {
+    const vtkIdType blockSize = 1024;
+    const int numSamples = this->SampleSize + 1;
+    std::vector<double>& queries = this->Queries.Local();
+    std::vector<vtkIdType>& ids = this->Ids.Local();
+    std::vector<double>& dist2 = this->Dist2.Local();
+
+    for (; ptId < endPtId; ptId += blockSize)
+    {
+      const vtkIdType numQueries = std::min(blockSize, endPtId - ptId);
+      queries.resize(3 * numQueries);
+      ids.resize(numQueries * numSamples);
+      dist2.resize(numQueries * numSamples);
+      const T* px = this->Points + 3 * ptId;
+      for (vtkIdType i = 0; i < 3 * numQueries; ++i)
       {
-        this->Distance[ptId] = sum / static_cast<double>(numPts - 1);
-        threadMean += this->Distance[ptId];
-        threadCount++;
+        queries[i] = static_cast<double>(px[i]);
       }
-      else // ignore if no points are found, something bad has happened
+      this->StaticLocator->FindClosestNPoints(
+        numQueries, queries.data(), numSamples, ids.data(), dist2.data());
+
+      for (vtkIdType q = 0; q < numQueries; ++q)
       {
-        this->Distance[ptId] = VTK_FLOAT_MAX; // the effect is to eliminate it
+        const vtkIdType* qIds = ids.data() + q * numSamples;
+        const double* qDist2 = dist2.data() + q * numSamples;
+        double sum = 0.0;
+        vtkIdType numPts = 0;
+        for (int sample = 0; sample < numSamples && qIds[sample] >= 0; ++sample, ++numPts)
+        {
+          if (qIds[sample] != ptId + q) // exclude ourselves
+          {
+            sum += sqrt(qDist2[sample]);
+          }
+        }
+        this->SetDistance(ptId + q, sum, numPts);
       }
     }
   }
 
+  // Average the lengths; again exclude ourselves
+  void SetDistance(vtkIdType ptId, double sum, vtkIdType numPts)
+  {
+    if (numPts > 0)
+    {
+      this->Distance[ptId] = sum / static_cast<double>(numPts - 1);
+      this->ThreadMean.Local() += this->Distance[ptId];
+      this->ThreadCount.Local()++;
+    }
+    else // ignore if no points are found, something bad has happened
+    {
+      this->Distance[ptId] = VTK_FLOAT_MAX; // the effect is to eliminate it
+    }
+  }
+
   // Compute the mean by compositing all threads
   void Reduce()
   {
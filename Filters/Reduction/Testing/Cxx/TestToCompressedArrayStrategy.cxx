@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkToCompressedArrayStrategy.h"
+
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+bool CheckStructure(vtkDataArray* base, vtkDataArray* result)
+{
+  if (!result)
+  {
+    std::cout << "Generated a nullptr result" << std::endl;
+    return false;
+  }
+  if (result->GetNumberOfComponents() != base->GetNumberOfComponents())
+  {
+    std::cout << "Result does not have same number of components as base" << std::endl;
+    return false;
+  }
+  if (result->GetNumberOfTuples() != base->GetNumberOfTuples())
+  {
+    std::cout << "Result does not have same number of tuples as base" << std::endl;
+    return false;
+  }
+  if (result->GetDataType() != base->GetDataType())
+  {
+    std::cout << "Result does not have same data type as base" << std::endl;
+    return false;
+  }
+  if (std::string(result->GetName()) != base->GetName())
+  {
+    std::cout << "Result does not have same name as base" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Access the result concurrently and out of order to stress the chunk cache
+double MaximumError(vtkDataArray* base, vtkDataArray* result)
+{
+  auto baseRange = vtk::DataArrayValueRange(base);
+  auto resultRange = vtk::DataArrayValueRange(result);
+  const vtkIdType nVals = static_cast<vtkIdType>(baseRange.size());
+  vtkSMPThreadLocal<double> maxErrors(0.0);
+  vtkSMPTools::For(0, nVals, [&](vtkIdType begin, vtkIdType end) {
+    double& localMax = maxErrors.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType idx = (i * 7919) % nVals;
+      localMax = std::max(localMax, std::abs(baseRange[idx] - resultRange[idx]));
+    }
+  });
+  double maxError = 0.0;
+  for (double localMax : maxErrors)
+  {
+    maxError = std::max(maxError, localMax);
+  }
+  return maxError;
+}
+}
+
+int TestToCompressedArrayStrategy(int, char*[])
+{
+  vtkNew<vtkDoubleArray> base;
+  base->SetNumberOfComponents(3);
+  base->SetNumberOfTuples(100000);
+  base->SetName("Base");
+  for (vtkIdType i = 0; i < base->GetNumberOfTuples(); ++i)
+  {
+    const double t = 1e-3 * i;
+    base->SetTuple3(i, std::sin(t), std::cos(t) * std::exp(-0.01 * t), 10.0 * t * t);
+  }
+
+  vtkNew<vtkToCompressedArrayStrategy> strat;
+  strat->SetChunkSize(1000);
+  strat->SetCacheSize(2);
+  auto opt = strat->EstimateReduction(base);
+  if (!opt.IsSome || opt.Value <= 0.0 || opt.Value >= 1.0)
+  {
+    std::cout << "Could not compress smooth array losslessly" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const double losslessReduction = opt.Value;
+
+  vtkSmartPointer<vtkDataArray> result = strat->Reduce(base);
+  if (!::CheckStructure(base, result))
+  {
+    return EXIT_FAILURE;
+  }
+  if (::MaximumError(base, result) != 0.0)
+  {
+    std::cout << "Lossless compression did not preserve the values" << std::endl;
+    return EXIT_FAILURE;
+  }
+  double tuple[3];
+  result->GetTuple(54321, tuple);
+  if (tuple[0] != base->GetComponent(54321, 0) || tuple[1] != base->GetComponent(54321, 1) ||
+    tuple[2] != base->GetComponent(54321, 2))
+  {
+    std::cout << "Tuple access does not match base" << std::endl;
+    return EXIT_FAILURE;
+  }
+  strat->ClearCache();
+
+  const double tolerance = 1e-4;
+  strat->ErrorBoundedOn();
+  strat->SetTolerance(tolerance);
+  opt = strat->EstimateReduction(base);
+  if (!opt.IsSome || opt.Value >= losslessReduction)
+  {
+    std::cout << "Error bounded compression does not improve on lossless compression" << std::endl;
+    return EXIT_FAILURE;
+  }
+  result = strat->Reduce(base);
+  if (!::CheckStructure(base, result))
+  {
+    return EXIT_FAILURE;
+  }
+  double error = ::MaximumError(base, result);
+  if (error > tolerance * (1.0 + 1e-6))
+  {
+    std::cout << "Error bounded compression is not within tolerance: " << error << " > "
+              << tolerance << std::endl;
+    return EXIT_FAILURE;
+  }
+  strat->ClearCache();
+
+  // integral arrays always use the lossless encoding
+  vtkNew<vtkIntArray> ints;
+  ints->SetNumberOfComponents(1);
+  ints->SetNumberOfTuples(50000);
+  ints->SetName("Ints");
+  auto intRange = vtk::DataArrayValueRange<1>(ints);
+  for (vtkIdType i = 0; i < ints->GetNumberOfTuples(); ++i)
+  {
+    intRange[i] = static_cast<int>(1000.0 * std::sin(1e-3 * i));
+  }
+  opt = strat->EstimateReduction(ints);
+  if (!opt.IsSome)
+  {
+    std::cout << "Could not compress smooth integral array" << std::endl;
+    return EXIT_FAILURE;
+  }
+  result = strat->Reduce(ints);
+  if (!::CheckStructure(ints, result) || ::MaximumError(ints, result) != 0.0)
+  {
+    std::cout << "Compression of integral array is not lossless" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
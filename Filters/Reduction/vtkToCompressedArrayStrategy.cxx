@@ -0,0 +1,578 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkToCompressedArrayStrategy.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
+#include "vtkImplicitArray.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using Dispatch = vtkArrayDispatch::DispatchByArray<vtkArrayDispatch::AllArrays>;
+
+// Quantized values must stay exactly representable once converted back to double
+constexpr double MAX_QUANTIZED_VALUE = 4.0e15;
+
+enum class ChunkEncoding : unsigned char
+{
+  Raw,
+  XorShuffle,
+  Quantized
+};
+
+struct CompressedChunk
+{
+  ChunkEncoding Encoding = ChunkEncoding::Raw;
+  std::vector<unsigned char> Bytes;
+};
+
+struct CompressedPayload
+{
+  std::vector<CompressedChunk> Chunks;
+  vtkIdType NumberOfTuples = 0;
+  int NumberOfComponents = 1;
+  vtkIdType ChunkSize = 1;
+  double Tolerance = 0.0;
+
+  std::size_t GetNumberOfBytes() const
+  {
+    std::size_t nBytes = 0;
+    for (const auto& chunk : this->Chunks)
+    {
+      nBytes += chunk.Bytes.size();
+    }
+    return nBytes;
+  }
+};
+
+template <std::size_t Size>
+struct UnsignedOfSize;
+template <>
+struct UnsignedOfSize<1>
+{
+  using type = std::uint8_t;
+};
+template <>
+struct UnsignedOfSize<2>
+{
+  using type = std::uint16_t;
+};
+template <>
+struct UnsignedOfSize<4>
+{
+  using type = std::uint32_t;
+};
+template <>
+struct UnsignedOfSize<8>
+{
+  using type = std::uint64_t;
+};
+
+//-------------------------------------------------------------------------
+// Gather the bytes of equal significance of all the words together
+template <typename WordT>
+void ShuffleBytes(const std::vector<WordT>& words, std::vector<unsigned char>& bytes)
+{
+  const std::size_t nWords = words.size();
+  const unsigned char* in = reinterpret_cast<const unsigned char*>(words.data());
+  bytes.resize(nWords * sizeof(WordT));
+  for (std::size_t b = 0; b < sizeof(WordT); ++b)
+  {
+    unsigned char* out = bytes.data() + b * nWords;
+    for (std::size_t i = 0; i < nWords; ++i)
+    {
+      out[i] = in[i * sizeof(WordT) + b];
+    }
+  }
+}
+
+//-------------------------------------------------------------------------
+template <typename WordT>
+void UnshuffleBytes(const std::vector<unsigned char>& bytes, std::vector<WordT>& words)
+{
+  const std::size_t nWords = words.size();
+  unsigned char* out = reinterpret_cast<unsigned char*>(words.data());
+  for (std::size_t b = 0; b < sizeof(WordT); ++b)
+  {
+    const unsigned char* in = bytes.data() + b * nWords;
+    for (std::size_t i = 0; i < nWords; ++i)
+    {
+      out[i * sizeof(WordT) + b] = in[i];
+    }
+  }
+}
+
+//-------------------------------------------------------------------------
+// Returns false if the codec does not reduce the size of the input
+bool CompressBytes(
+  vtkLZ4DataCompressor* lz4, const std::vector<unsigned char>& in, std::vector<unsigned char>& out)
+{
+  out.resize(lz4->GetMaximumCompressionSpace(in.size()));
+  std::size_t size = lz4->Compress(in.data(), in.size(), out.data(), out.size());
+  if (!size || size >= in.size())
+  {
+    return false;
+  }
+  out.resize(size);
+  out.shrink_to_fit();
+  return true;
+}
+
+//-------------------------------------------------------------------------
+bool UncompressBytes(
+  vtkLZ4DataCompressor* lz4, const CompressedChunk& chunk, std::vector<unsigned char>& out)
+{
+  return lz4->Uncompress(chunk.Bytes.data(), chunk.Bytes.size(), out.data(), out.size()) ==
+    out.size();
+}
+
+//-------------------------------------------------------------------------
+// A tolerance of 0 means lossless encoding
+template <typename ValueType>
+CompressedChunk EncodeChunk(const ValueType* values, std::size_t nVals, int nComps,
+  double tolerance, vtkLZ4DataCompressor* lz4)
+{
+  CompressedChunk chunk;
+  std::vector<unsigned char> shuffled;
+  const std::size_t stride = static_cast<std::size_t>(nComps);
+
+  if (tolerance > 0.0 && std::is_floating_point<ValueType>::value)
+  {
+    const double step = 2.0 * tolerance;
+    std::vector<std::int64_t> quantized(nVals);
+    bool bounded = true;
+    for (std::size_t i = 0; i < nVals && bounded; ++i)
+    {
+      const double value = static_cast<double>(values[i]);
+      const double scaled = std::round(value / step);
+      // also rejects NaN and infinite values
+      bounded = std::abs(scaled) < MAX_QUANTIZED_VALUE;
+      if (bounded)
+      {
+        quantized[i] = static_cast<std::int64_t>(scaled);
+        const ValueType decoded = static_cast<ValueType>(quantized[i] * step);
+        bounded = std::abs(static_cast<double>(decoded) - value) <= tolerance;
+      }
+    }
+    if (bounded)
+    {
+      // zigzag encoded differences with the previous tuple
+      std::vector<std::uint64_t> words(nVals);
+      for (std::size_t i = 0; i < nVals; ++i)
+      {
+        const std::int64_t delta =
+          i >= stride ? quantized[i] - quantized[i - stride] : quantized[i];
+        words[i] =
+          (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63);
+      }
+      ::ShuffleBytes(words, shuffled);
+      if (::CompressBytes(lz4, shuffled, chunk.Bytes))
+      {
+        chunk.Encoding = ChunkEncoding::Quantized;
+        return chunk;
+      }
+    }
+  }
+
+  using WordT = typename UnsignedOfSize<sizeof(ValueType)>::type;
+  std::vector<WordT> words(nVals);
+  std::memcpy(words.data(), values, nVals * sizeof(ValueType));
+  for (std::size_t i = nVals; i-- > stride;)
+  {
+    words[i] ^= words[i - stride];
+  }
+  ::ShuffleBytes(words, shuffled);
+  if (::CompressBytes(lz4, shuffled, chunk.Bytes))
+  {
+    chunk.Encoding = ChunkEncoding::XorShuffle;
+    return chunk;
+  }
+
+  chunk.Encoding = ChunkEncoding::Raw;
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+  chunk.Bytes.assign(bytes, bytes + nVals * sizeof(ValueType));
+  return chunk;
+}
+
+//-------------------------------------------------------------------------
+template <typename ValueType>
+bool DecodeChunk(const CompressedChunk& chunk, std::size_t nVals, int nComps, double tolerance,
+  vtkLZ4DataCompressor* lz4, ValueType* values)
+{
+  const std::size_t stride = static_cast<std::size_t>(nComps);
+  switch (chunk.Encoding)
+  {
+    case ChunkEncoding::Raw:
+    {
+      if (chunk.Bytes.size() != nVals * sizeof(ValueType))
+      {
+        return false;
+      }
+      std::memcpy(values, chunk.Bytes.data(), chunk.Bytes.size());
+      return true;
+    }
+    case ChunkEncoding::XorShuffle:
+    {
+      using WordT = typename UnsignedOfSize<sizeof(ValueType)>::type;
+      std::vector<unsigned char> shuffled(nVals * sizeof(WordT));
+      if (!::UncompressBytes(lz4, chunk, shuffled))
+      {
+        return false;
+      }
+      std::vector<WordT> words(nVals);
+      ::UnshuffleBytes(shuffled, words);
+      for (std::size_t i = stride; i < nVals; ++i)
+      {
+        words[i] ^= words[i - stride];
+      }
+      std::memcpy(values, words.data(), nVals * sizeof(ValueType));
+      return true;
+    }
+    case ChunkEncoding::Quantized:
+    {
+      std::vector<unsigned char> shuffled(nVals * sizeof(std::uint64_t));
+      if (!::UncompressBytes(lz4, chunk, shuffled))
+      {
+        return false;
+      }
+      std::vector<std::uint64_t> words(nVals);
+      ::UnshuffleBytes(shuffled, words);
+      const double step = 2.0 * tolerance;
+      std::vector<std::int64_t> quantized(nVals);
+      for (std::size_t i = 0; i < nVals; ++i)
+      {
+        const std::int64_t delta =
+          static_cast<std::int64_t>(words[i] >> 1) ^ -static_cast<std::int64_t>(words[i] & 1);
+        quantized[i] = i >= stride ? quantized[i - stride] + delta : delta;
+        values[i] = static_cast<ValueType>(quantized[i] * step);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+//-------------------------------------------------------------------------
+/*
+ * Read-only backend decoding the chunks of a payload on demand and keeping the most recently used
+ * ones in a cache shared by all threads.
+ */
+template <typename ValueType>
+class CompressedBackend
+{
+public:
+  CompressedBackend(std::shared_ptr<const CompressedPayload> payload, int cacheSize)
+    : Payload(std::move(payload))
+    , CacheSize(static_cast<std::size_t>(cacheSize))
+    , ChunkValues(this->Payload->ChunkSize * this->Payload->NumberOfComponents)
+  {
+  }
+
+  ValueType operator()(vtkIdType idx) const
+  {
+    const vtkIdType chunkId = idx / this->ChunkValues;
+    return this->GetChunk(chunkId)[idx - chunkId * this->ChunkValues];
+  }
+
+  void mapTuple(vtkIdType tupleIdx, ValueType* tuple) const
+  {
+    const int nComps = this->Payload->NumberOfComponents;
+    const vtkIdType chunkId = tupleIdx / this->Payload->ChunkSize;
+    const ValueType* values =
+      this->GetChunk(chunkId) + (tupleIdx - chunkId * this->Payload->ChunkSize) * nComps;
+    std::copy(values, values + nComps, tuple);
+  }
+
+  ValueType mapComponent(vtkIdType tupleIdx, int comp) const
+  {
+    return (*this)(tupleIdx * this->Payload->NumberOfComponents + comp);
+  }
+
+  unsigned long getMemorySize() const
+  {
+    std::size_t nBytes = this->Payload->GetNumberOfBytes();
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      for (const auto& entry : this->Cache)
+      {
+        nBytes += entry.second->size() * sizeof(ValueType);
+      }
+    }
+    return static_cast<unsigned long>(std::max<std::size_t>(1, (nBytes + 1023) / 1024));
+  }
+
+private:
+  using DecodedChunk = std::shared_ptr<const std::vector<ValueType>>;
+
+  struct LastChunk
+  {
+    vtkIdType Id = -1;
+    DecodedChunk Values;
+  };
+
+  const ValueType* GetChunk(vtkIdType chunkId) const
+  {
+    LastChunk& last = this->Last.Local();
+    if (last.Id == chunkId)
+    {
+      return last.Values->data();
+    }
+    last.Values = this->Lookup(chunkId);
+    if (!last.Values)
+    {
+      last.Values = this->Decode(chunkId);
+      this->Insert(chunkId, last.Values);
+    }
+    last.Id = chunkId;
+    return last.Values->data();
+  }
+
+  DecodedChunk Lookup(vtkIdType chunkId) const
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    for (auto it = this->Cache.begin(); it != this->Cache.end(); ++it)
+    {
+      if (it->first == chunkId)
+      {
+        this->Cache.splice(this->Cache.begin(), this->Cache, it);
+        return this->Cache.front().second;
+      }
+    }
+    return nullptr;
+  }
+
+  void Insert(vtkIdType chunkId, const DecodedChunk& values) const
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto found = std::find_if(this->Cache.begin(), this->Cache.end(),
+      [chunkId](const std::pair<vtkIdType, DecodedChunk>& entry) {
+        return entry.first == chunkId;
+      });
+    if (found != this->Cache.end())
+    {
+      // another thread decoded the same chunk in the meantime
+      return;
+    }
+    this->Cache.emplace_front(chunkId, values);
+    while (this->Cache.size() > this->CacheSize)
+    {
+      this->Cache.pop_back();
+    }
+  }
+
+  DecodedChunk Decode(vtkIdType chunkId) const
+  {
+    const CompressedPayload& payload = *this->Payload;
+    const vtkIdType nTuples =
+      std::min(payload.ChunkSize, payload.NumberOfTuples - chunkId * payload.ChunkSize);
+    const std::size_t nVals = static_cast<std::size_t>(nTuples * payload.NumberOfComponents);
+    auto values = std::make_shared<std::vector<ValueType>>(nVals);
+    if (!::DecodeChunk(payload.Chunks[chunkId], nVals, payload.NumberOfComponents,
+          payload.Tolerance, this->Compressor, values->data()))
+    {
+      vtkErrorWithObjectMacro(nullptr, "Failed to decode chunk " << chunkId << " of array.");
+      std::fill(values->begin(), values->end(), ValueType(0));
+    }
+    return values;
+  }
+
+  std::shared_ptr<const CompressedPayload> Payload;
+  std::size_t CacheSize;
+  vtkIdType ChunkValues;
+  vtkNew<vtkLZ4DataCompressor> Compressor;
+
+  mutable std::mutex Mutex;
+  mutable std::list<std::pair<vtkIdType, DecodedChunk>> Cache;
+  mutable vtkSMPThreadLocal<LastChunk> Last;
+};
+
+//-------------------------------------------------------------------------
+struct ArrayCompressor
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* arr, vtkIdType chunkSize, double tolerance,
+    std::shared_ptr<const CompressedPayload>& result)
+  {
+    using VType = vtk::GetAPIType<ArrayT>;
+
+    auto payload = std::make_shared<CompressedPayload>();
+    payload->NumberOfTuples = arr->GetNumberOfTuples();
+    payload->NumberOfComponents = arr->GetNumberOfComponents();
+    payload->ChunkSize = chunkSize;
+    payload->Tolerance = tolerance;
+    const vtkIdType nChunks = (payload->NumberOfTuples + chunkSize - 1) / chunkSize;
+    payload->Chunks.resize(nChunks);
+
+    const int nComps = payload->NumberOfComponents;
+    const vtkIdType nTuples = payload->NumberOfTuples;
+    auto range = vtk::DataArrayValueRange(arr);
+    vtkNew<vtkLZ4DataCompressor> lz4;
+    vtkSMPTools::For(0, nChunks, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<VType> values;
+      for (vtkIdType chunkId = begin; chunkId < end; ++chunkId)
+      {
+        const vtkIdType first = chunkId * chunkSize;
+        const vtkIdType last = std::min(first + chunkSize, nTuples);
+        values.assign(range.begin() + first * nComps, range.begin() + last * nComps);
+        payload->Chunks[chunkId] =
+          ::EncodeChunk(values.data(), values.size(), nComps, tolerance, lz4);
+      }
+    });
+    result = payload;
+  }
+};
+
+//-------------------------------------------------------------------------
+struct CompressedArrayGenerator
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* arr, const std::shared_ptr<const CompressedPayload>& payload,
+    int cacheSize, vtkSmartPointer<vtkDataArray>& target)
+  {
+    using VType = vtk::GetAPIType<ArrayT>;
+    using Backend = CompressedBackend<VType>;
+
+    vtkNew<vtkImplicitArray<Backend>> compressed;
+    compressed->SetBackend(std::make_shared<Backend>(payload, cacheSize));
+    compressed->SetNumberOfComponents(arr->GetNumberOfComponents());
+    compressed->SetNumberOfTuples(arr->GetNumberOfTuples());
+    compressed->SetName(arr->GetName());
+    target = compressed;
+  }
+};
+
+}
+
+VTK_ABI_NAMESPACE_BEGIN
+//-------------------------------------------------------------------------
+struct vtkToCompressedArrayStrategy::vtkInternals
+{
+  void ClearCache()
+  {
+    this->CachedArray = nullptr;
+    this->CachedPayload = nullptr;
+  }
+
+  std::shared_ptr<const CompressedPayload> GetPayload(
+    vtkDataArray* arr, vtkIdType chunkSize, double tolerance)
+  {
+    if (this->CachedPayload && arr == this->CachedArray &&
+      arr->GetMTime() == this->CachedArrayMTime && chunkSize == this->CachedPayload->ChunkSize &&
+      tolerance == this->CachedPayload->Tolerance)
+    {
+      return this->CachedPayload;
+    }
+    this->ClearCache();
+    std::shared_ptr<const CompressedPayload> payload;
+    ::ArrayCompressor compressor;
+    if (!::Dispatch::Execute(arr, compressor, chunkSize, tolerance, payload))
+    {
+      return nullptr;
+    }
+    this->CachedArray = arr;
+    this->CachedArrayMTime = arr->GetMTime();
+    this->CachedPayload = payload;
+    return payload;
+  }
+
+  // only used to identify the cached payload, never dereferenced
+  vtkDataArray* CachedArray = nullptr;
+  vtkMTimeType CachedArrayMTime = 0;
+  std::shared_ptr<const CompressedPayload> CachedPayload;
+};
+
+//-------------------------------------------------------------------------
+vtkObjectFactoryNewMacro(vtkToCompressedArrayStrategy);
+
+//-------------------------------------------------------------------------
+vtkToCompressedArrayStrategy::vtkToCompressedArrayStrategy()
+  : Internals(std::unique_ptr<vtkInternals>(new vtkInternals()))
+{
+}
+
+//-------------------------------------------------------------------------
+vtkToCompressedArrayStrategy::~vtkToCompressedArrayStrategy() = default;
+
+//-------------------------------------------------------------------------
+void vtkToCompressedArrayStrategy::PrintSelf(std::ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ChunkSize: " << this->ChunkSize << std::endl;
+  os << indent << "CacheSize: " << this->CacheSize << std::endl;
+  os << indent << "ErrorBounded: " << (this->ErrorBounded ? "On" : "Off") << std::endl;
+  os << std::flush;
+}
+
+//-------------------------------------------------------------------------
+vtkToImplicitStrategy::Optional vtkToCompressedArrayStrategy::EstimateReduction(vtkDataArray* arr)
+{
+  if (!arr)
+  {
+    vtkWarningMacro("Cannot transform nullptr to compressed array.");
+    return vtkToImplicitStrategy::Optional();
+  }
+  vtkIdType nVals = arr->GetNumberOfValues();
+  if (!nVals)
+  {
+    return vtkToImplicitStrategy::Optional();
+  }
+  auto payload = this->Internals->GetPayload(
+    arr, this->ChunkSize, this->ErrorBounded ? this->Tolerance : 0.0);
+  if (!payload)
+  {
+    return vtkToImplicitStrategy::Optional();
+  }
+  double reduction = static_cast<double>(payload->GetNumberOfBytes()) /
+    (static_cast<double>(nVals) * arr->GetDataTypeSize());
+  return reduction < 1.0 ? vtkToImplicitStrategy::Optional(reduction)
+                         : vtkToImplicitStrategy::Optional();
+}
+
+//-------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> vtkToCompressedArrayStrategy::Reduce(vtkDataArray* arr)
+{
+  vtkSmartPointer<vtkDataArray> res = nullptr;
+  if (!arr)
+  {
+    vtkWarningMacro("Cannot transform nullptr to compressed array.");
+    return res;
+  }
+  vtkIdType nVals = arr->GetNumberOfValues();
+  if (!nVals)
+  {
+    return res;
+  }
+  auto payload = this->Internals->GetPayload(
+    arr, this->ChunkSize, this->ErrorBounded ? this->Tolerance : 0.0);
+  if (!payload)
+  {
+    vtkWarningMacro("Cannot compress arrays of type " << arr->GetClassName() << ".");
+    return res;
+  }
+  ::CompressedArrayGenerator generator;
+  ::Dispatch::Execute(arr, generator, payload, this->CacheSize, res);
+  return res;
+}
+
+//-------------------------------------------------------------------------
+void vtkToCompressedArrayStrategy::ClearCache()
+{
+  this->Internals->ClearCache();
+}
+VTK_ABI_NAMESPACE_END
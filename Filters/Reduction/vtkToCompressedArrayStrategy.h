@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkToCompressedArrayStrategy_h
+#define vtkToCompressedArrayStrategy_h
+
+#include "vtkFiltersReductionModule.h" // for export
+#include "vtkToImplicitStrategy.h"
+
+#include <memory> // for std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+/**
+ * @class vtkToCompressedArrayStrategy
+ *
+ * Strategy to transform an explicit array into an implicit array storing its tuples in compressed
+ * chunks.
+ *
+ * The tuples of the input array are split into chunks of `ChunkSize` tuples. Each chunk is
+ * encoded independently with the LZ4 codec of `vtkLZ4DataCompressor`, after a transform making
+ * smooth fields more compressible:
+ * - by default the encoding is lossless: each value is XOR-ed with the same component of the
+ *   previous tuple and the bytes of the values are shuffled so that the bytes of equal
+ *   significance are contiguous.
+ * - when `ErrorBounded` is on, floating point values are quantized with a step of twice the
+ *   `Tolerance` and the differences between consecutive tuples are encoded instead, so that every
+ *   decoded value is within `Tolerance` of the original one. Integral arrays are always encoded
+ *   losslessly.
+ *
+ * Chunks are decoded on demand when the resulting array is accessed and the last `CacheSize`
+ * decoded chunks are kept in a least recently used cache shared by all threads. Each thread also
+ * holds on to the last chunk it accessed. The resulting array is read-only.
+ *
+ * Unlike the other strategies, this one does not rely on a particular structure of the data and
+ * works best for smooth fields that are not affine by parts, such as most simulation results.
+ *
+ * The chunks computed by `EstimateReduction` are kept until `ClearCache` is called or another
+ * array is estimated so that `Reduce` does not compress the same array twice.
+ *
+ * @sa
+ * vtkToImplicitStrategy vtkToImplicitArrayFilter vtkLZ4DataCompressor
+ */
+class VTKFILTERSREDUCTION_EXPORT vtkToCompressedArrayStrategy final : public vtkToImplicitStrategy
+{
+public:
+  static vtkToCompressedArrayStrategy* New();
+  vtkTypeMacro(vtkToCompressedArrayStrategy, vtkToImplicitStrategy);
+  void PrintSelf(std::ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Number of tuples encoded together in a chunk. Larger chunks compress better but make random
+   * accesses to the resulting array more expensive.
+   *
+   * Default value: 4096
+   */
+  vtkSetClampMacro(ChunkSize, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(ChunkSize, vtkIdType);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of decoded chunks kept in memory by each resulting array.
+   *
+   * Default value: 8
+   */
+  vtkSetClampMacro(CacheSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(CacheSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * When on, floating point arrays are quantized so that decoded values are within `Tolerance`
+   * of the input values. When off, the encoding is lossless.
+   *
+   * Default value: false
+   */
+  vtkSetMacro(ErrorBounded, bool);
+  vtkGetMacro(ErrorBounded, bool);
+  vtkBooleanMacro(ErrorBounded, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Implements parent API
+   */
+  vtkToImplicitStrategy::Optional EstimateReduction(vtkDataArray*) override;
+  vtkSmartPointer<vtkDataArray> Reduce(vtkDataArray*) override;
+  ///@}
+
+  /**
+   * Destroys the chunks compressed for the last array passed to `EstimateReduction`
+   */
+  void ClearCache() override;
+
+protected:
+  vtkToCompressedArrayStrategy();
+  ~vtkToCompressedArrayStrategy() override;
+
+  vtkIdType ChunkSize = 4096;
+  int CacheSize = 8;
+  bool ErrorBounded = false;
+
+private:
+  vtkToCompressedArrayStrategy(const vtkToCompressedArrayStrategy&) = delete;
+  void operator=(const vtkToCompressedArrayStrategy&) = delete;
+
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkToCompressedArrayStrategy_h
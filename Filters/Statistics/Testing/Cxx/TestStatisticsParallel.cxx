@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded learn phases of vtkDescriptiveStatistics and
+// vtkOrderStatistics compute the moments and histograms of a column spanning
+// several chunks of rows, with and without ghost rows, and that the moments
+// do not depend on the number of threads.
+
+#include "vtkDataSetAttributes.h"
+#include "vtkDescriptiveStatistics.h"
+#include "vtkDoubleArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkOrderStatistics.h"
+#include "vtkSMPTools.h"
+#include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A column of values with many repetitions, and every eleventh row a ghost.
+void CreateTable(vtkTable* table, vtkIdType nRow, bool withGhosts)
+{
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfValues(nRow);
+  for (vtkIdType r = 0; r < nRow; ++r)
+  {
+    values->SetValue(r, 0.5 * ((r * 7919) % 1001) - 100.0);
+  }
+  table->AddColumn(values);
+
+  if (withGhosts)
+  {
+    vtkNew<vtkUnsignedCharArray> ghosts;
+    ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+    ghosts->SetNumberOfValues(nRow);
+    for (vtkIdType r = 0; r < nRow; ++r)
+    {
+      ghosts->SetValue(r, r % 11 == 3 ? vtkDataSetAttributes::DUPLICATEPOINT : 0);
+    }
+    table->GetRowData()->AddArray(ghosts);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkTable* LearnModel(vtkStatisticsAlgorithm* statistics, vtkTable* table, unsigned int block)
+{
+  statistics->SetInputData(vtkStatisticsAlgorithm::INPUT_DATA, table);
+  statistics->AddColumn("Values");
+  statistics->SetLearnOption(true);
+  statistics->SetDeriveOption(false);
+  statistics->SetAssessOption(false);
+  statistics->SetTestOption(false);
+  statistics->Update();
+  vtkMultiBlockDataSet* model = vtkMultiBlockDataSet::SafeDownCast(
+    statistics->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL));
+  return model ? vtkTable::SafeDownCast(model->GetBlock(block)) : nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool TestDescriptive(vtkTable* table)
+{
+  vtkDataArray* values = vtkArrayDownCast<vtkDataArray>(table->GetColumnByName("Values"));
+  vtkUnsignedCharArray* ghosts = table->GetRowData()->GetGhostArray();
+
+  // Two-pass references.
+  double n = 0.0, sum = 0.0;
+  for (vtkIdType r = 0; r < values->GetNumberOfTuples(); ++r)
+  {
+    if (!ghosts || !ghosts->GetValue(r))
+    {
+      n += 1.0;
+      sum += values->GetTuple1(r);
+    }
+  }
+  const double mean = sum / n;
+  double m2 = 0.0, m3 = 0.0, m4 = 0.0;
+  for (vtkIdType r = 0; r < values->GetNumberOfTuples(); ++r)
+  {
+    if (!ghosts || !ghosts->GetValue(r))
+    {
+      const double delta = values->GetTuple1(r) - mean;
+      m2 += delta * delta;
+      m3 += delta * delta * delta;
+      m4 += delta * delta * delta * delta;
+    }
+  }
+
+  vtkNew<vtkDescriptiveStatistics> statistics;
+  vtkTable* primary = LearnModel(statistics, table, 0);
+  if (!primary || primary->GetNumberOfRows() != 1)
+  {
+    std::cerr << "Missing primary statistics." << std::endl;
+    return false;
+  }
+  const double expected[4] = { mean, m2, m3, m4 };
+  const char* names[4] = { "Mean", "M2", "M3", "M4" };
+  if (primary->GetValueByName(0, "Cardinality").ToDouble() != n)
+  {
+    std::cerr << "Wrong cardinality." << std::endl;
+    return false;
+  }
+  // The moments are compared relative to the powers of the standard deviation.
+  const double sigma = std::sqrt(m2 / n);
+  const double scales[4] = { sigma, n * sigma * sigma, n * std::pow(sigma, 3.0),
+    n * std::pow(sigma, 4.0) };
+  for (int i = 0; i < 4; ++i)
+  {
+    const double value = primary->GetValueByName(0, names[i]).ToDouble();
+    if (std::abs(value - expected[i]) > 1e-9 * scales[i])
+    {
+      std::cerr << names[i] << " is " << value << " instead of " << expected[i] << std::endl;
+      return false;
+    }
+  }
+
+  // The chunks are merged in the same order with any number of threads.
+  vtkNew<vtkDescriptiveStatistics> singleThread;
+  vtkTable* singlePrimary = nullptr;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 },
+    [&]() { singlePrimary = LearnModel(singleThread, table, 0); });
+  for (int i = 0; i < 4; ++i)
+  {
+    if (singlePrimary->GetValueByName(0, names[i]).ToDouble() !=
+      primary->GetValueByName(0, names[i]).ToDouble())
+    {
+      std::cerr << names[i] << " depends on the number of threads." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestOrder(vtkTable* table)
+{
+  vtkDataArray* values = vtkArrayDownCast<vtkDataArray>(table->GetColumnByName("Values"));
+  vtkUnsignedCharArray* ghosts = table->GetRowData()->GetGhostArray();
+  std::map<double, vtkIdType> reference;
+  for (vtkIdType r = 0; r < values->GetNumberOfTuples(); ++r)
+  {
+    if (!ghosts || !ghosts->GetValue(r))
+    {
+      ++reference[values->GetTuple1(r)];
+    }
+  }
+
+  vtkNew<vtkOrderStatistics> statistics;
+  vtkTable* histogram = LearnModel(statistics, table, 0);
+  if (!histogram || histogram->GetNumberOfRows() != static_cast<vtkIdType>(reference.size()))
+  {
+    std::cerr << "Wrong histogram size." << std::endl;
+    return false;
+  }
+  vtkIdType r = 0;
+  for (const auto& bin : reference)
+  {
+    if (histogram->GetValueByName(r, "Value").ToDouble() != bin.first ||
+      histogram->GetValueByName(r, "Cardinality").ToLongLong() != bin.second)
+    {
+      std::cerr << "Wrong histogram bin " << r << std::endl;
+      return false;
+    }
+    ++r;
+  }
+
+  // Quantization still bounds the size of the histogram.
+  vtkNew<vtkOrderStatistics> quantized;
+  quantized->SetQuantize(true);
+  quantized->SetMaximumHistogramSize(100);
+  histogram = LearnModel(quantized, table, 0);
+  if (!histogram || histogram->GetNumberOfRows() > 100)
+  {
+    std::cerr << "The histogram is not quantized." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestStatisticsParallel(int, char*[])
+{
+  for (bool withGhosts : { false, true })
+  {
+    vtkNew<vtkTable> table;
+    CreateTable(table, 300007, withGhosts);
+    if (!TestDescriptive(table))
+    {
+      std::cerr << "vtkDescriptiveStatistics failed" << (withGhosts ? " with ghosts." : ".")
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!TestOrder(table))
+    {
+      std::cerr << "vtkOrderStatistics failed" << (withGhosts ? " with ghosts." : ".")
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
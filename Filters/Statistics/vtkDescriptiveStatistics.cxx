@@ -5,6 +5,8 @@
 #include "vtkDescriptiveStatistics.h"
 #include "vtkStatisticsAlgorithmPrivate.h"
 
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataObjectCollection.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDoubleArray.h"
@@ -14,18 +16,135 @@
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
 #include <limits>
 #include <set>
 #include <sstream>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// The rows of a column are processed by chunks of this size, in parallel.
+// Columns that fit in one chunk are processed exactly as by a serial pass.
+constexpr vtkIdType RowsPerChunk = 65536;
+
+// Moments of the values of a chunk of rows, updated one value at a time and
+// merged with the pairwise update formulas of Aggregate.
+struct Moments
+{
+  double Cardinality = 0.;
+  double Minimum = std::numeric_limits<double>::max();
+  double Maximum = std::numeric_limits<double>::min();
+  double Mean = 0.;
+  double M2 = 0.;
+  double M3 = 0.;
+  double M4 = 0.;
+
+  void Add(double val)
+  {
+    double n = this->Cardinality + 1.;
+    double inv_n = 1. / n;
+    double delta = val - this->Mean;
+
+    double A = delta * inv_n;
+    this->Mean += A;
+    this->M4 += A *
+      (A * A * delta * this->Cardinality * (n * (n - 3.) + 3.) + 6. * A * this->M2 -
+        4. * this->M3);
+
+    double B = val - this->Mean;
+    this->M3 += A * (B * delta * (n - 2.) - 3. * this->M2);
+    this->M2 += delta * B;
+
+    this->Minimum = std::min(this->Minimum, val);
+    this->Maximum = std::max(this->Maximum, val);
+    this->Cardinality = n;
+  }
+
+  void Merge(const Moments& other)
+  {
+    if (other.Cardinality == 0.)
+    {
+      return;
+    }
+    if (this->Cardinality == 0.)
+    {
+      *this = other;
+      return;
+    }
+
+    double n = this->Cardinality;
+    double n_c = other.Cardinality;
+    double N = n + n_c;
+
+    double delta = other.Mean - this->Mean;
+    double delta_sur_N = delta / N;
+    double delta2_sur_N2 = delta_sur_N * delta_sur_N;
+
+    double n2 = n * n;
+    double n_c2 = n_c * n_c;
+    double prod_n = n * n_c;
+
+    this->M4 += other.M4 + delta2_sur_N2 * delta2_sur_N2 * prod_n * (n * n2 + n_c * n_c2) +
+      6. * (n2 * other.M2 + n_c2 * this->M2) * delta2_sur_N2 +
+      4. * (n * other.M3 - n_c * this->M3) * delta_sur_N;
+
+    this->M3 += other.M3 + prod_n * (n - n_c) * delta * delta2_sur_N2 +
+      3. * (n * other.M2 - n_c * this->M2) * delta_sur_N;
+
+    this->M2 += other.M2 + prod_n * delta * delta_sur_N;
+
+    this->Mean += n_c * delta_sur_N;
+    this->Minimum = std::min(this->Minimum, other.Minimum);
+    this->Maximum = std::max(this->Maximum, other.Maximum);
+    this->Cardinality = N;
+  }
+};
+
+// Compute in parallel the moments of each chunk of rows of a single component
+// array, and merge them in the order of the chunks so that the result does
+// not depend on the number of threads.
+struct LearnMomentsWorker
+{
+  template <typename ArrayT>
+  void operator()(
+    ArrayT* array, vtkUnsignedCharArray* ghosts, unsigned char ghostsToSkip, Moments& moments)
+  {
+    const auto values = vtk::DataArrayValueRange<1>(array);
+    const vtkIdType nRow = array->GetNumberOfTuples();
+    const vtkIdType numChunks = (nRow + RowsPerChunk - 1) / RowsPerChunk;
+    std::vector<Moments> chunks(numChunks);
+
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+        const vtkIdType endRow = std::min(nRow, (chunk + 1) * RowsPerChunk);
+        for (vtkIdType r = chunk * RowsPerChunk; r < endRow; ++r)
+        {
+          if (!ghosts || !(ghosts->GetValue(r) & ghostsToSkip))
+          {
+            chunks[chunk].Add(static_cast<double>(values[r]));
+          }
+        }
+      }
+    });
+
+    for (const Moments& chunk : chunks)
+    {
+      moments.Merge(chunk);
+    }
+  }
+};
+}
+
 vtkObjectFactoryNewMacro(vtkDescriptiveStatistics);
 
 //------------------------------------------------------------------------------
@@ -335,7 +454,25 @@ void vtkDescriptiveStatistics::Learn(
       mom4 = 0.;
     }
 
-    if (numberOfGhostlessRow)
+    vtkDataArray* dataCol =
+      vtkArrayDownCast<vtkDataArray>(inData->GetColumnByName(varName.c_str()));
+    if (numberOfGhostlessRow && dataCol && dataCol->GetNumberOfComponents() == 1)
+    {
+      Moments moments;
+      LearnMomentsWorker worker;
+      if (!vtkArrayDispatch::Dispatch::Execute(
+            dataCol, worker, ghosts, this->GhostsToSkip, moments))
+      {
+        worker(dataCol, ghosts, this->GhostsToSkip, moments);
+      }
+      minVal = moments.Minimum;
+      maxVal = moments.Maximum;
+      mean = moments.Mean;
+      mom2 = moments.M2;
+      mom3 = moments.M3;
+      mom4 = moments.M4;
+    }
+    else if (numberOfGhostlessRow)
     {
       double n, inv_n, val, delta, A, B;
       vtkIdType numberOfSkippedElements = 0;
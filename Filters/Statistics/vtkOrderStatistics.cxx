@@ -5,6 +5,8 @@
 #include "vtkOrderStatistics.h"
 #include "vtkStatisticsAlgorithmPrivate.h"
 
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
@@ -19,6 +21,7 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <map>
@@ -61,6 +64,55 @@ struct GhostsCounter
   vtkIdType GlobalNumberOfGhosts;
   vtkSMPThreadLocal<vtkIdType> NumberOfGhosts;
 };
+
+//==============================================================================
+// Copy the first component of the non ghost rows of an array, in parallel when
+// there are no ghosts.
+struct CopyValuesWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, vtkUnsignedCharArray* ghosts, unsigned char ghostsToSkip,
+    std::vector<double>& values)
+  {
+    const auto tuples = vtk::DataArrayTupleRange(array);
+    const vtkIdType nRow = tuples.size();
+    if (!ghosts)
+    {
+      values.resize(nRow);
+      vtkSMPTools::For(0, nRow, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType r = begin; r < end; ++r)
+        {
+          values[r] = static_cast<double>(tuples[r][0]);
+        }
+      });
+      return;
+    }
+    values.clear();
+    for (vtkIdType r = 0; r < nRow; ++r)
+    {
+      if (!(ghosts->GetValue(r) & ghostsToSkip))
+      {
+        values.push_back(static_cast<double>(tuples[r][0]));
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Sort the values in parallel and count each distinct value, which gives the
+// histogram in increasing order of values.
+void SortedHistogram(
+  std::vector<double>& values, std::vector<std::pair<double, vtkIdType>>& histogram)
+{
+  vtkSMPTools::Sort(values.begin(), values.end());
+  histogram.clear();
+  for (std::vector<double>::const_iterator vit = values.begin(); vit != values.end();)
+  {
+    std::vector<double>::const_iterator next = std::upper_bound(vit, values.cend(), *vit);
+    histogram.emplace_back(*vit, static_cast<vtkIdType>(next - vit));
+    vit = next;
+  }
+}
 } // anonymous namespace
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -238,15 +290,22 @@ void vtkOrderStatistics::Learn(
       // Downcast column to data array for efficient data access
       vtkDataArray* dvals = vtkArrayDownCast<vtkDataArray>(vals);
 
-      // Calculate histogram
-      std::map<double, vtkIdType> histogram;
-      for (vtkIdType r = 0; r < nRow; ++r)
+      // Calculate histogram with a parallel sort of the values
+      std::vector<double> values;
+      CopyValuesWorker worker;
+      if (!vtkArrayDispatch::Dispatch::Execute(
+            dvals, worker, ghosts, this->GhostsToSkip, values))
       {
-        if (!ghosts || !(ghosts->GetValue(r) & this->GhostsToSkip))
-        {
-          ++histogram[dvals->GetTuple1(r)];
-        }
+        worker(dvals, ghosts, this->GhostsToSkip, values);
       }
+      std::vector<double> readings;
+      std::vector<std::pair<double, vtkIdType>> histogram;
+      if (this->Quantize)
+      {
+        // Keep the values, which are sorted to build the histogram
+        readings = values;
+      }
+      SortedHistogram(values, histogram);
 
       // If maximum size was requested, make sure it is satisfied
       if (this->Quantize)
@@ -266,19 +325,15 @@ void vtkOrderStatistics::Learn(
           double width = (maxi - mini) / std::round(Nq / 2.);
 
           // Now re-calculate histogram by quantizing values
-          histogram.clear();
-          double reading;
-          double quantum;
-          for (vtkIdType r = 0; r < nRow; ++r)
-          {
-            if (ghosts && (ghosts->GetValue(r) & this->GhostsToSkip))
-            {
-              continue;
-            }
-            reading = dvals->GetTuple1(r);
-            quantum = mini + std::round((reading - mini) / width) * width;
-            ++histogram[quantum];
-          }
+          values.resize(readings.size());
+          vtkSMPTools::For(
+            0, static_cast<vtkIdType>(readings.size()), [&](vtkIdType begin, vtkIdType end) {
+              for (vtkIdType r = begin; r < end; ++r)
+              {
+                values[r] = mini + std::round((readings[r] - mini) / width) * width;
+              }
+            });
+          SortedHistogram(values, histogram);
 
           // Update histogram size for conditional clause
           Nq = static_cast<vtkIdType>(histogram.size());
@@ -286,11 +341,10 @@ void vtkOrderStatistics::Learn(
       }
 
       // Store histogram
-      for (std::map<double, vtkIdType>::iterator mit = histogram.begin(); mit != histogram.end();
-           ++mit)
+      for (const auto& bin : histogram)
       {
-        row->SetValue(0, mit->first);
-        row->SetValue(1, mit->second);
+        row->SetValue(0, bin.first);
+        row->SetValue(1, bin.second);
         histogramTab->InsertNextRow(row);
       }
     } // if ( vals->IsA("vtkDataArray") )
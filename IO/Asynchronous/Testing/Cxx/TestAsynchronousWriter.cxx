@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Write several time steps of a data set in the background with XML and HDF
+// writers, modifying the data set between the writes, and read them back. The
+// HDF writes are only tested when the IOHDF module is enabled.
+
+#include "vtkAsynchronousWriter.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#if VTK_MODULE_ENABLE_VTK_IOHDF
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+#endif
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int NumberOfSteps = 5;
+
+void SetStepArray(vtkPolyData* polyData, int step)
+{
+  // Replace the array instead of modifying it in place: the queued shallow
+  // copies still reference the previous one.
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Step");
+  values->SetNumberOfTuples(polyData->GetNumberOfPoints());
+  values->FillValue(step);
+  polyData->GetPointData()->AddArray(values);
+}
+
+bool CheckStep(vtkDataSet* dataSet, vtkIdType numberOfPoints, int step)
+{
+  vtkDataArray* values = dataSet ? dataSet->GetPointData()->GetArray("Step") : nullptr;
+  if (!values || dataSet->GetNumberOfPoints() != numberOfPoints)
+  {
+    std::cerr << "Step " << step << " was not written correctly" << std::endl;
+    return false;
+  }
+  double range[2];
+  values->GetRange(range);
+  if (range[0] != step || range[1] != step)
+  {
+    std::cerr << "Wrong values written for step " << step << ": " << range[0] << ", " << range[1]
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+std::vector<std::string> WriteSteps(
+  vtkAlgorithm* writer, vtkPolyData* polyData, const std::string& prefix, const char* extension)
+{
+  vtkNew<vtkAsynchronousWriter> asyncWriter;
+  asyncWriter->SetWriter(writer);
+  asyncWriter->SetMaximumQueueSize(2);
+  asyncWriter->SetInputData(polyData);
+  std::vector<std::string> fileNames;
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    ::SetStepArray(polyData, step);
+    fileNames.push_back(prefix + std::to_string(step) + extension);
+    asyncWriter->SetFileName(fileNames.back().c_str());
+    if (!asyncWriter->Write())
+    {
+      std::cerr << "Could not queue step " << step << std::endl;
+      return std::vector<std::string>();
+    }
+    if (asyncWriter->GetNumberOfPendingWrites() > 3)
+    {
+      std::cerr << "The queue of the asynchronous writer is not bounded" << std::endl;
+      return std::vector<std::string>();
+    }
+  }
+  asyncWriter->WaitForCompletion();
+  if (asyncWriter->GetNumberOfPendingWrites() != 0 || asyncWriter->GetNumberOfFailedWrites() != 0)
+  {
+    std::cerr << "Asynchronous writes did not complete successfully" << std::endl;
+    return std::vector<std::string>();
+  }
+  return fileNames;
+}
+}
+
+int TestAsynchronousWriter(int argc, char* argv[])
+{
+  char* tempDirC =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string tempDir = tempDirC;
+  delete[] tempDirC;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  vtkNew<vtkPolyData> polyData;
+  polyData->ShallowCopy(sphere->GetOutput());
+  const vtkIdType numberOfPoints = polyData->GetNumberOfPoints();
+
+  vtkNew<vtkXMLPolyDataWriter> xmlWriter;
+  xmlWriter->SetDataModeToAppended();
+  std::vector<std::string> xmlFiles =
+    ::WriteSteps(xmlWriter, polyData, tempDir + "/TestAsynchronousWriter", ".vtp");
+  if (xmlFiles.size() != NumberOfSteps)
+  {
+    return EXIT_FAILURE;
+  }
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    vtkNew<vtkXMLPolyDataReader> reader;
+    reader->SetFileName(xmlFiles[step].c_str());
+    reader->Update();
+    if (!::CheckStep(reader->GetOutput(), numberOfPoints, step))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+#if VTK_MODULE_ENABLE_VTK_IOHDF
+  vtkNew<vtkHDFWriter> hdfWriter;
+  hdfWriter->SetOverwrite(true);
+  std::vector<std::string> hdfFiles =
+    ::WriteSteps(hdfWriter, polyData, tempDir + "/TestAsynchronousWriter", ".vtkhdf");
+  if (hdfFiles.size() != NumberOfSteps)
+  {
+    return EXIT_FAILURE;
+  }
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    vtkNew<vtkHDFReader> reader;
+    reader->SetFileName(hdfFiles[step].c_str());
+    reader->Update();
+    if (!::CheckStep(
+          vtkDataSet::SafeDownCast(reader->GetOutputDataObject(0)), numberOfPoints, step))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+#endif
+  return EXIT_SUCCESS;
+}
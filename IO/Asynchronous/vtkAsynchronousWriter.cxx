@@ -0,0 +1,305 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkAsynchronousWriter.h"
+
+#include "vtkDataCompressor.h"
+#include "vtkDataObject.h"
+#include "vtkErrorCode.h"
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkXMLStructuredDataWriter.h"
+#include "vtkXMLUnstructuredDataWriter.h"
+#include "vtkXMLWriterBase.h"
+
+#if VTK_MODULE_ENABLE_VTK_IOHDF
+#include "vtkHDFWriter.h"
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+//****************************************************************************
+namespace
+{
+/**
+ * Return a new writer of the same type as `writer` with the same settings, or
+ * nullptr when the writer type is not supported.
+ */
+vtkSmartPointer<vtkAlgorithm> CloneWriter(vtkAlgorithm* writer, const char* fileName)
+{
+  if (auto xmlWriter = vtkXMLWriterBase::SafeDownCast(writer))
+  {
+    auto clone = vtkSmartPointer<vtkXMLWriterBase>::Take(xmlWriter->NewInstance());
+    clone->SetFileName(fileName ? fileName : xmlWriter->GetFileName());
+    clone->SetByteOrder(xmlWriter->GetByteOrder());
+    clone->SetHeaderType(xmlWriter->GetHeaderType());
+    clone->SetIdType(xmlWriter->GetIdType());
+    clone->SetDataMode(xmlWriter->GetDataMode());
+    clone->SetEncodeAppendedData(xmlWriter->GetEncodeAppendedData());
+    clone->SetBlockSize(xmlWriter->GetBlockSize());
+    clone->SetOverlapCompressionAndWrite(xmlWriter->GetOverlapCompressionAndWrite());
+    clone->SetWriteTimeValue(xmlWriter->GetWriteTimeValue());
+    // Do not share the compressor as the template may be reconfigured while
+    // the clone is writing.
+    vtkDataCompressor* compressor = xmlWriter->GetCompressor();
+    if (compressor)
+    {
+      auto compressorClone = vtkSmartPointer<vtkDataCompressor>::Take(compressor->NewInstance());
+      compressorClone->SetCompressionLevel(compressor->GetCompressionLevel());
+      clone->SetCompressor(compressorClone);
+    }
+    else
+    {
+      clone->SetCompressor(nullptr);
+    }
+    if (auto unstructured = vtkXMLUnstructuredDataWriter::SafeDownCast(xmlWriter))
+    {
+      auto unstructuredClone = vtkXMLUnstructuredDataWriter::SafeDownCast(clone);
+      unstructuredClone->SetNumberOfPieces(unstructured->GetNumberOfPieces());
+      unstructuredClone->SetWritePiece(unstructured->GetWritePiece());
+      unstructuredClone->SetGhostLevel(unstructured->GetGhostLevel());
+    }
+    else if (auto structured = vtkXMLStructuredDataWriter::SafeDownCast(xmlWriter))
+    {
+      auto structuredClone = vtkXMLStructuredDataWriter::SafeDownCast(clone);
+      structuredClone->SetNumberOfPieces(structured->GetNumberOfPieces());
+      structuredClone->SetWritePiece(structured->GetWritePiece());
+      structuredClone->SetGhostLevel(structured->GetGhostLevel());
+      structuredClone->SetWriteExtent(structured->GetWriteExtent());
+    }
+    return clone;
+  }
+
+#if VTK_MODULE_ENABLE_VTK_IOHDF
+  if (auto hdfWriter = vtkHDFWriter::SafeDownCast(writer))
+  {
+    auto clone = vtkSmartPointer<vtkHDFWriter>::Take(hdfWriter->NewInstance());
+    clone->SetFileName(fileName ? fileName : hdfWriter->GetFileName());
+    clone->SetOverwrite(hdfWriter->GetOverwrite());
+    clone->SetChunkSize(hdfWriter->GetChunkSize());
+    clone->SetCompressionLevel(hdfWriter->GetCompressionLevel());
+    clone->SetCompressionFilter(hdfWriter->GetCompressionFilter());
+    clone->SetUseExternalComposite(hdfWriter->GetUseExternalComposite());
+    clone->SetUseExternalTimeSteps(hdfWriter->GetUseExternalTimeSteps());
+    clone->SetUseExternalPartitions(hdfWriter->GetUseExternalPartitions());
+    return clone;
+  }
+#endif
+
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+bool RunWriter(vtkAlgorithm* writer, vtkDataObject* input)
+{
+  writer->SetInputDataObject(0, input);
+  if (auto xmlWriter = vtkXMLWriterBase::SafeDownCast(writer))
+  {
+    return xmlWriter->Write() != 0;
+  }
+  if (auto baseWriter = vtkWriter::SafeDownCast(writer))
+  {
+    return baseWriter->Write() != 0;
+  }
+  writer->Modified();
+  writer->UpdateWholeExtent();
+  return writer->GetErrorCode() == vtkErrorCode::NoError;
+}
+}
+
+VTK_ABI_NAMESPACE_BEGIN
+//****************************************************************************
+class vtkAsynchronousWriter::vtkInternals
+{
+public:
+  using JobType = std::pair<vtkSmartPointer<vtkAlgorithm>, vtkSmartPointer<vtkDataObject>>;
+
+  ~vtkInternals()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Terminate = true;
+    }
+    this->QueueChanged.notify_all();
+    if (this->Thread.joinable())
+    {
+      this->Thread.join();
+    }
+  }
+
+  void Push(JobType&& job, int maximumQueueSize)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    if (!this->Thread.joinable())
+    {
+      this->Thread = std::thread(&vtkInternals::Run, this);
+    }
+    // Apply backpressure: wait for the background thread to catch up.
+    this->QueueChanged.wait(
+      lock, [&]() { return static_cast<int>(this->Jobs.size()) < maximumQueueSize; });
+    this->Jobs.push_back(std::move(job));
+    lock.unlock();
+    this->QueueChanged.notify_all();
+  }
+
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->QueueChanged.wait(lock, [&]() { return this->Jobs.empty() && !this->Writing; });
+  }
+
+  int GetNumberOfPendingWrites()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return static_cast<int>(this->Jobs.size()) + (this->Writing ? 1 : 0);
+  }
+
+  int GetNumberOfFailedWrites()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->NumberOfFailedWrites;
+  }
+
+  void AddFailedWrite()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    ++this->NumberOfFailedWrites;
+  }
+
+private:
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->QueueChanged.wait(lock, [&]() { return this->Terminate || !this->Jobs.empty(); });
+      if (this->Jobs.empty())
+      {
+        // Terminate is only honored once every queued write is done.
+        return;
+      }
+      JobType job = std::move(this->Jobs.front());
+      this->Jobs.pop_front();
+      this->Writing = true;
+      lock.unlock();
+      this->QueueChanged.notify_all();
+
+      bool success = ::RunWriter(job.first, job.second);
+      // Release the data before notifying that the write is done.
+      job = JobType();
+
+      lock.lock();
+      this->Writing = false;
+      if (!success)
+      {
+        ++this->NumberOfFailedWrites;
+        vtkLog(ERROR, "Asynchronous write failed.");
+      }
+      this->QueueChanged.notify_all();
+    }
+  }
+
+  std::mutex Mutex;
+  std::condition_variable QueueChanged;
+  std::deque<JobType> Jobs;
+  std::thread Thread;
+  bool Writing = false;
+  bool Terminate = false;
+  int NumberOfFailedWrites = 0;
+};
+
+vtkStandardNewMacro(vtkAsynchronousWriter);
+vtkCxxSetObjectMacro(vtkAsynchronousWriter, Writer, vtkAlgorithm);
+
+//------------------------------------------------------------------------------
+vtkAsynchronousWriter::vtkAsynchronousWriter()
+  : Internals(new vtkInternals())
+{
+}
+
+//------------------------------------------------------------------------------
+vtkAsynchronousWriter::~vtkAsynchronousWriter()
+{
+  // Wait for the queued writes to complete.
+  delete this->Internals;
+  this->Internals = nullptr;
+  this->SetWriter(nullptr);
+  this->SetFileName(nullptr);
+}
+
+//------------------------------------------------------------------------------
+int vtkAsynchronousWriter::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataObject");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousWriter::WriteData()
+{
+  vtkDataObject* input = this->GetInput();
+  if (!this->Writer)
+  {
+    vtkErrorMacro(<< "No writer to write the input with.");
+    return;
+  }
+
+  // Copy the input so that the caller may keep on modifying its data object.
+  auto copy = vtkSmartPointer<vtkDataObject>::Take(input->NewInstance());
+  if (this->DeepCopyInput)
+  {
+    copy->DeepCopy(input);
+  }
+  else
+  {
+    copy->ShallowCopy(input);
+  }
+
+  vtkSmartPointer<vtkAlgorithm> writer = ::CloneWriter(this->Writer, this->FileName);
+  if (!writer)
+  {
+    // Unknown writers cannot be safely copied, use them synchronously.
+    if (!::RunWriter(this->Writer, copy))
+    {
+      this->Internals->AddFailedWrite();
+    }
+    this->Writer->SetInputDataObject(0, nullptr);
+    return;
+  }
+  this->Internals->Push(std::make_pair(writer, copy), this->MaximumQueueSize);
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousWriter::WaitForCompletion()
+{
+  this->Internals->Wait();
+}
+
+//------------------------------------------------------------------------------
+int vtkAsynchronousWriter::GetNumberOfPendingWrites()
+{
+  return this->Internals->GetNumberOfPendingWrites();
+}
+
+//------------------------------------------------------------------------------
+int vtkAsynchronousWriter::GetNumberOfFailedWrites()
+{
+  return this->Internals->GetNumberOfFailedWrites();
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Writer: " << this->Writer << "\n";
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "MaximumQueueSize: " << this->MaximumQueueSize << "\n";
+  os << indent << "DeepCopyInput: " << (this->DeepCopyInput ? "true" : "false") << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class    vtkAsynchronousWriter
+ * @brief    writes data objects from a background thread with a wrapped writer
+ *
+ * vtkAsynchronousWriter wraps a VTK XML writer (any vtkXMLWriterBase) or a
+ * vtkHDFWriter when the IOHDF module is enabled. Each call to Write() copies
+ * the input and the settings of the wrapped writer, queues the copies and
+ * returns immediately. A single background thread then serializes the queued
+ * data objects in order, so the caller, typically an in situ simulation, can
+ * resume its computation without waiting for the disk.
+ *
+ * The input is shallow copied by default: the arrays are shared with the
+ * queued copy, so the caller may replace the arrays of its data object but
+ * must not modify them in place until the write is done. Turn DeepCopyInput on
+ * when the producer reuses its arrays in place.
+ *
+ * At most MaximumQueueSize data objects wait to be written. When the queue is
+ * full, Write() blocks until the oldest queued write starts, which bounds the
+ * memory held by the queue.
+ *
+ * The wrapped writer is only used as a template and may be reconfigured as soon
+ * as Write() returns. The FileName of this writer, when set, overrides the one
+ * of the wrapped writer. Writers of other types are run synchronously by
+ * Write().
+ *
+ * @note vtkHDFWriter needs a thread-safe HDF5 build when the application uses
+ * HDF5 concurrently from other threads.
+ *
+ * @sa vtkThreadedImageWriter
+ */
+
+#ifndef vtkAsynchronousWriter_h
+#define vtkAsynchronousWriter_h
+
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkWriter.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKIOASYNCHRONOUS_EXPORT vtkAsynchronousWriter : public vtkWriter
+{
+public:
+  static vtkAsynchronousWriter* New();
+  vtkTypeMacro(vtkAsynchronousWriter, vtkWriter);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set/Get the writer used as a template for the background writes.
+   */
+  void SetWriter(vtkAlgorithm* writer);
+  vtkGetObjectMacro(Writer, vtkAlgorithm);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the name of the file written by the next call to Write(). When not
+   * set, the file name of the wrapped writer is used.
+   */
+  vtkSetFilePathMacro(FileName);
+  vtkGetFilePathMacro(FileName);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum number of data objects waiting to be written.
+   * Default is 2.
+   */
+  vtkSetClampMacro(MaximumQueueSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumQueueSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get whether the input is deep copied instead of shallow copied before
+   * being queued. Default is false.
+   */
+  vtkSetMacro(DeepCopyInput, bool);
+  vtkGetMacro(DeepCopyInput, bool);
+  vtkBooleanMacro(DeepCopyInput, bool);
+  ///@}
+
+  /**
+   * Block until all the queued data objects are written.
+   */
+  void WaitForCompletion();
+
+  /**
+   * Return the number of data objects queued or being written.
+   */
+  int GetNumberOfPendingWrites();
+
+  /**
+   * Return the number of background writes that failed since this writer was
+   * created.
+   */
+  int GetNumberOfFailedWrites();
+
+protected:
+  vtkAsynchronousWriter();
+  ~vtkAsynchronousWriter() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  void WriteData() override;
+
+  vtkAlgorithm* Writer = nullptr;
+  char* FileName = nullptr;
+  int MaximumQueueSize = 2;
+  bool DeepCopyInput = false;
+
+private:
+  vtkAsynchronousWriter(const vtkAsynchronousWriter&) = delete;
+  void operator=(const vtkAsynchronousWriter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
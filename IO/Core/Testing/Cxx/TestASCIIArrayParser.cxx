@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkASCIIArrayParser.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define Check(expr, message)                                                                       \
+  if (!(expr))                                                                                     \
+  {                                                                                                \
+    std::cout << __FILE__ << " L." << __LINE__ << " | " << #expr << " failed: \n"                  \
+              << message << std::endl;                                                             \
+    return false;                                                                                  \
+  }                                                                                                \
+  static_cast<void>(0)
+
+namespace
+{
+// Large enough to be split in several chunks
+constexpr int NumberOfValues = 200000;
+
+std::string MakeText()
+{
+  std::string text = "\n ";
+  for (int i = 0; i < NumberOfValues; ++i)
+  {
+    text += std::to_string(i - NumberOfValues / 2);
+    text += (i % 9 == 8) ? "\r\n\t" : " ";
+  }
+  return text;
+}
+
+bool TestDoubleParse()
+{
+  std::string text;
+  for (int i = 0; i < NumberOfValues; ++i)
+  {
+    text += std::to_string(0.25 * i) + ((i % 6 == 5) ? "\n" : "  ");
+  }
+  const char* begin = text.data();
+  const char* end = begin + text.size();
+  Check(vtkASCIIArrayParser::CountWords(begin, end) == NumberOfValues, "Wrong number of words");
+
+  std::vector<double> values(NumberOfValues);
+  const char* parsedEnd = nullptr;
+  vtkIdType count =
+    vtkASCIIArrayParser::Parse(begin, end, NumberOfValues, values.data(), &parsedEnd);
+  Check(count == NumberOfValues, "Wrong number of values: " << count);
+  for (int i = 0; i < NumberOfValues; ++i)
+  {
+    Check(values[i] == 0.25 * i, "Wrong value at " << i << ": " << values[i]);
+  }
+  Check(parsedEnd == begin + text.find_last_not_of(" \n") + 1, "Wrong end of parsed text");
+
+  std::string special = " nan -inf 1e-3 ";
+  count = vtkASCIIArrayParser::Parse(
+    special.data(), special.data() + special.size(), 3, values.data(), &parsedEnd);
+  Check(count == 3 && std::isnan(values[0]) && std::isinf(values[1]) && values[1] < 0 &&
+      values[2] == 1e-3,
+    "Wrong special values");
+  return true;
+}
+
+bool TestIntParse()
+{
+  const std::string text = MakeText();
+  const char* begin = text.data();
+  const char* end = begin + text.size();
+
+  std::vector<int> values(NumberOfValues);
+  vtkIdType count = vtkASCIIArrayParser::Parse(begin, end, NumberOfValues, values.data());
+  Check(count == NumberOfValues, "Wrong number of values: " << count);
+  for (int i = 0; i < NumberOfValues; ++i)
+  {
+    Check(values[i] == i - NumberOfValues / 2, "Wrong value at " << i << ": " << values[i]);
+  }
+
+  // Only the requested number of values is parsed
+  const char* parsedEnd = nullptr;
+  count = vtkASCIIArrayParser::Parse(begin, end, 10, values.data(), &parsedEnd);
+  Check(count == 10, "Wrong number of values: " << count);
+  Check(std::string(parsedEnd - 6, parsedEnd) == "-99991", "Wrong end of parsed text");
+
+  // Parsing stops on the first invalid word
+  std::string invalid = text;
+  const std::size_t position = invalid.find(" 1234 ");
+  invalid[position + 2] = '.';
+  count = vtkASCIIArrayParser::Parse(
+    invalid.data(), invalid.data() + invalid.size(), NumberOfValues, values.data());
+  Check(count == NumberOfValues / 2 + 1234, "Wrong number of values before error: " << count);
+
+  // Characters are parsed as integers
+  const std::string chars = "65 -1 127";
+  std::vector<signed char> charValues(3);
+  count =
+    vtkASCIIArrayParser::Parse(chars.data(), chars.data() + chars.size(), 3, charValues.data());
+  Check(count == 3 && charValues[0] == 65 && charValues[1] == -1 && charValues[2] == 127,
+    "Wrong char values");
+  return true;
+}
+
+bool TestEmptyParse()
+{
+  const std::string text = " \n\t ";
+  Check(vtkASCIIArrayParser::CountWords(text.data(), text.data() + text.size()) == 0,
+    "Wrong number of words");
+  float value = 0;
+  const char* parsedEnd = nullptr;
+  Check(vtkASCIIArrayParser::Parse(text.data(), text.data() + text.size(), 1, &value,
+          &parsedEnd) == 0 &&
+      parsedEnd == text.data(),
+    "Parsed a value from whitespaces");
+  return true;
+}
+}
+
+int TestASCIIArrayParser(int, char*[])
+{
+  if (!::TestDoubleParse() || !::TestIntParse() || !::TestEmptyParse())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkASCIIArrayParser.h"
+
+#include "vtkSMPTools.h"
+#include "vtkValueFromString.h"
+
+#include <algorithm>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+
+namespace
+{
+// Chunks smaller than this are not worth a task of their own
+constexpr std::size_t MinimumChunkSize = 1 << 16;
+
+//------------------------------------------------------------------------------
+inline bool IsSpace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+//------------------------------------------------------------------------------
+// Type used to parse a word for a given output type
+template <typename T>
+struct ParsedType
+{
+  using Type = T;
+};
+template <>
+struct ParsedType<char>
+{
+  using Type = int;
+};
+template <>
+struct ParsedType<signed char>
+{
+  using Type = int;
+};
+template <>
+struct ParsedType<unsigned char>
+{
+  using Type = int;
+};
+
+//------------------------------------------------------------------------------
+struct Chunk
+{
+  const char* Begin;
+  const char* End;
+  // Number of words starting in the chunk
+  vtkIdType NumberOfWords = 0;
+  // Index of the first word of the chunk in the whole buffer
+  vtkIdType Offset = 0;
+  vtkIdType NumberOfValues = 0;
+  const char* ParsedEnd = nullptr;
+};
+
+//------------------------------------------------------------------------------
+// Split the buffer in chunks that start on whitespace, so that no word spans
+// two chunks, and count the words of each chunk.
+std::vector<Chunk> SplitAndCount(const char* begin, const char* end)
+{
+  const std::size_t size = static_cast<std::size_t>(end - begin);
+  const std::size_t numChunks = std::max<std::size_t>(1,
+    std::min<std::size_t>(size / MinimumChunkSize,
+      4 * static_cast<std::size_t>(vtkSMPTools::GetEstimatedNumberOfThreads())));
+  std::vector<Chunk> chunks(numChunks);
+  const char* chunkBegin = begin;
+  for (std::size_t i = 0; i < numChunks; ++i)
+  {
+    const char* chunkEnd = (i + 1 == numChunks) ? end : begin + (i + 1) * size / numChunks;
+    chunkEnd = std::max(chunkEnd, chunkBegin);
+    while (chunkEnd < end && !::IsSpace(*chunkEnd))
+    {
+      ++chunkEnd;
+    }
+    chunks[i].Begin = chunkBegin;
+    chunks[i].End = chunkEnd;
+    chunkBegin = chunkEnd;
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numChunks), [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      Chunk& chunk = chunks[i];
+      vtkIdType count = 0;
+      bool inWord = false;
+      for (const char* p = chunk.Begin; p != chunk.End; ++p)
+      {
+        const bool space = ::IsSpace(*p);
+        count += (!space && !inWord) ? 1 : 0;
+        inWord = !space;
+      }
+      chunk.NumberOfWords = count;
+    }
+  });
+
+  vtkIdType offset = 0;
+  for (Chunk& chunk : chunks)
+  {
+    chunk.Offset = offset;
+    offset += chunk.NumberOfWords;
+  }
+  return chunks;
+}
+
+//------------------------------------------------------------------------------
+// Number of values the chunk has to parse to honor maxValues
+inline vtkIdType GetNumberOfValuesToParse(const Chunk& chunk, vtkIdType maxValues)
+{
+  return std::max<vtkIdType>(0, std::min(chunk.NumberOfWords, maxValues - chunk.Offset));
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void ParseChunk(Chunk& chunk, vtkIdType maxValues, T* output)
+{
+  const vtkIdType numValues = ::GetNumberOfValuesToParse(chunk, maxValues);
+  const char* p = chunk.Begin;
+  vtkIdType count = 0;
+  while (count < numValues)
+  {
+    // There is a word left in the chunk, so this stops before its end
+    while (::IsSpace(*p))
+    {
+      ++p;
+    }
+    const char* wordEnd = p;
+    while (wordEnd != chunk.End && !::IsSpace(*wordEnd))
+    {
+      ++wordEnd;
+    }
+    typename ParsedType<T>::Type value;
+    if (vtkValueFromString(p, wordEnd, value) != static_cast<std::size_t>(wordEnd - p))
+    {
+      break;
+    }
+    output[chunk.Offset + count] = static_cast<T>(value);
+    ++count;
+    p = wordEnd;
+  }
+  chunk.NumberOfValues = count;
+  chunk.ParsedEnd = p;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+vtkIdType ParseValues(
+  const char* begin, const char* end, vtkIdType maxValues, T* output, const char** parsedEnd)
+{
+  if (parsedEnd)
+  {
+    *parsedEnd = begin;
+  }
+  if (begin >= end || maxValues <= 0)
+  {
+    return 0;
+  }
+
+  std::vector<Chunk> chunks = ::SplitAndCount(begin, end);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      ::ParseChunk(chunks[i], maxValues, output);
+    }
+  });
+
+  // Values are only valid up to the first chunk that stopped on an error
+  vtkIdType numValues = 0;
+  for (const Chunk& chunk : chunks)
+  {
+    numValues += chunk.NumberOfValues;
+    if (chunk.NumberOfValues > 0 && parsedEnd)
+    {
+      *parsedEnd = chunk.ParsedEnd;
+    }
+    if (chunk.NumberOfValues < ::GetNumberOfValuesToParse(chunk, maxValues))
+    {
+      break;
+    }
+  }
+  return numValues;
+}
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkASCIIArrayParser::CountWords(const char* begin, const char* end)
+{
+  if (begin >= end)
+  {
+    return 0;
+  }
+  std::vector<Chunk> chunks = ::SplitAndCount(begin, end);
+  return chunks.back().Offset + chunks.back().NumberOfWords;
+}
+
+#define vtkASCIIArrayParserDefineParse(type)                                                       \
+  vtkIdType vtkASCIIArrayParser::Parse(                                                            \
+    const char* begin, const char* end, vtkIdType maxValues, type* output, const char** parsedEnd) \
+  {                                                                                                \
+    return ::ParseValues(begin, end, maxValues, output, parsedEnd);                               \
+  }
+
+vtkASCIIArrayParserDefineParse(char)
+vtkASCIIArrayParserDefineParse(signed char)
+vtkASCIIArrayParserDefineParse(unsigned char)
+vtkASCIIArrayParserDefineParse(short)
+vtkASCIIArrayParserDefineParse(unsigned short)
+vtkASCIIArrayParserDefineParse(int)
+vtkASCIIArrayParserDefineParse(unsigned int)
+vtkASCIIArrayParserDefineParse(long)
+vtkASCIIArrayParserDefineParse(unsigned long)
+vtkASCIIArrayParserDefineParse(long long)
+vtkASCIIArrayParserDefineParse(unsigned long long)
+vtkASCIIArrayParserDefineParse(float)
+vtkASCIIArrayParserDefineParse(double)
+
+#undef vtkASCIIArrayParserDefineParse
+
+VTK_ABI_NAMESPACE_END
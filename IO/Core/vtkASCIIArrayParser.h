@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkASCIIArrayParser
+ * @brief   Parse large whitespace separated ASCII arrays with multiple threads.
+ *
+ * vtkASCIIArrayParser converts a buffer holding whitespace separated numbers,
+ * such as the ASCII arrays of the legacy and XML VTK formats, to values. The
+ * buffer is split at whitespace boundaries into chunks that are parsed
+ * concurrently with vtkSMPTools and vtkValueFromString. Each value is written
+ * at its position in the output, so no concatenation of partial results is
+ * needed.
+ *
+ * `char`, `signed char` and `unsigned char` values are parsed as integers, as
+ * the ASCII VTK formats write them.
+ *
+ * @sa vtkValueFromString vtkResourceParser
+ */
+
+#ifndef vtkASCIIArrayParser_h
+#define vtkASCIIArrayParser_h
+
+#include "vtkIOCoreModule.h"  // For export macro
+#include "vtkType.h"          // For vtkIdType
+#include "vtkWrappingHints.h" // For VTK_WRAPEXCLUDE
+
+VTK_ABI_NAMESPACE_BEGIN
+
+class VTKIOCORE_EXPORT VTK_WRAPEXCLUDE vtkASCIIArrayParser
+{
+public:
+  /**
+   * Return the number of whitespace separated words in [begin, end).
+   */
+  static vtkIdType CountWords(const char* begin, const char* end);
+
+  ///@{
+  /**
+   * Parse at most `maxValues` values from the whitespace separated words of
+   * [begin, end) into `output`, which must be able to hold them. Parsing stops
+   * at the first word that is not a valid value of the output type, the
+   * following words are left unparsed even though their content in `output`
+   * may have been modified.
+   *
+   * Return the number of values parsed. When `parsedEnd` is not null, it is
+   * set to the end of the last word parsed, or to `begin` when no value has
+   * been parsed.
+   */
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues, char* output,
+    const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues,
+    signed char* output, const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues,
+    unsigned char* output, const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues, short* output,
+    const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues,
+    unsigned short* output, const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues, int* output,
+    const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues,
+    unsigned int* output, const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues, long* output,
+    const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues,
+    unsigned long* output, const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues,
+    long long* output, const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues,
+    unsigned long long* output, const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues, float* output,
+    const char** parsedEnd = nullptr);
+  static vtkIdType Parse(const char* begin, const char* end, vtkIdType maxValues, double* output,
+    const char** parsedEnd = nullptr);
+  ///@}
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+
+// VTK-HeaderTest-Exclude: vtkASCIIArrayParser.h
@@ -1,10 +1,13 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "vtkAlgorithm.h"
 #include "vtkAppendDataSets.h"
+#include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkHDFReader.h"
 #include "vtkImageData.h"
+#include "vtkInformation.h"
 #include "vtkLogger.h"
 #include "vtkMathUtilities.h"
 #include "vtkNew.h"
@@ -13,6 +16,7 @@
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTestUtilities.h"
 #include "vtkTesting.h"
 #include "vtkUniformGrid.h"
@@ -24,6 +28,7 @@
 #include "vtkXMLUniformGridAMRReader.h"
 #include "vtkXMLUnstructuredGridReader.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iterator>
 #include <string>
@@ -103,6 +108,83 @@ int TestImageCellData(const std::string& dataRoot)
   return !vtkTestUtilities::CompareDataObjects(data, expectedData);
 }
 
+//----------------------------------------------------------------------------
+int TestImageSubExtent(
+  const std::string& dataRoot, const std::string& hdfName, const std::string& xmlName)
+{
+  // Reading a sub extent of an ImageData file
+  // ------------------------------------------------------------
+  std::string fileName = dataRoot + "/Data/" + hdfName;
+  std::cout << "Testing sub extent: " << fileName << std::endl;
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  int* wholeExtent = reader->GetOutputInformation(0)->Get(
+    vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
+  int subExtent[6];
+  for (int i = 0; i < 3; ++i)
+  {
+    const int length = wholeExtent[2 * i + 1] - wholeExtent[2 * i];
+    subExtent[2 * i] = wholeExtent[2 * i] + length / 4;
+    subExtent[2 * i + 1] = wholeExtent[2 * i] + (3 * length) / 4;
+  }
+  vtkAlgorithm* algorithm = reader;
+  algorithm->UpdateExtent(subExtent);
+  vtkImageData* data = vtkImageData::SafeDownCast(reader->GetOutput());
+
+  vtkNew<vtkXMLImageDataReader> expectedReader;
+  expectedReader->SetFileName((dataRoot + "/Data/" + xmlName).c_str());
+  algorithm = expectedReader;
+  algorithm->UpdateExtent(subExtent);
+  vtkImageData* expectedData = expectedReader->GetOutput();
+
+  int* extent = data->GetExtent();
+  if (!std::equal(extent, extent + 6, subExtent))
+  {
+    std::cerr << "Error: vtkImageData with wrong extent: "
+              << "expecting "
+              << "[" << subExtent[0] << ", " << subExtent[1] << ", " << subExtent[2] << ", "
+              << subExtent[3] << ", " << subExtent[4] << ", " << subExtent[5] << "]"
+              << " got "
+              << "[" << extent[0] << ", " << extent[1] << ", " << extent[2] << ", " << extent[3]
+              << ", " << extent[4] << ", " << extent[5] << "]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!vtkTestUtilities::CompareDataObjects(data, expectedData))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A slice still holds one layer of cell data
+  subExtent[5] = subExtent[4];
+  algorithm = reader;
+  algorithm->UpdateExtent(subExtent);
+  data = vtkImageData::SafeDownCast(reader->GetOutput());
+  for (int i = 0; i < data->GetCellData()->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = data->GetCellData()->GetAbstractArray(i);
+    if (array->GetNumberOfTuples() != data->GetNumberOfCells())
+    {
+      std::cerr << "Error: wrong number of tuples in slice array " << array->GetName() << ": "
+                << array->GetNumberOfTuples() << " instead of " << data->GetNumberOfCells()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  for (int i = 0; i < data->GetPointData()->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = data->GetPointData()->GetAbstractArray(i);
+    if (array->GetNumberOfTuples() != data->GetNumberOfPoints())
+    {
+      std::cerr << "Error: wrong number of tuples in slice array " << array->GetName() << ": "
+                << array->GetNumberOfTuples() << " instead of " << data->GetNumberOfPoints()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
 //----------------------------------------------------------------------------
 int TestUnstructuredGrid(const std::string& dataRoot, bool parallel)
 {
@@ -339,6 +421,12 @@ int TestHDFReader(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+  if (TestImageSubExtent(dataRoot, "mandelbrot-vti.hdf", "mandelbrot.vti") ||
+    TestImageSubExtent(dataRoot, "wavelet_cell_data.hdf", "wavelet_cell_data.vti"))
+  {
+    return EXIT_FAILURE;
+  }
+
   if (TestUnstructuredGrid(dataRoot, false))
   {
     return EXIT_FAILURE;
@@ -64,6 +64,8 @@ int TestPolyDataTemporalWithOffset(const std::string& dataRoot);
 int TestUGTemporalWithCachePartitioned(const std::string& dataRoot);
 int TestUGTemporalPartitionedNoCache(const std::string& dataRoot);
 int TestImageDataTemporalWithCache(const std::string& dataRoot);
+int TestUGTemporalWithCachePrefetch(const std::string& dataRoot);
+int TestImageDataTemporalWithSmallCachePrefetch(const std::string& dataRoot);
 int TestPolyDataTemporalWithCache(const std::string& dataRoot);
 int TestPolyDataTemporalFieldData(const std::string& dataRoot);
 int TestOverlappingAMRTemporal(const std::string& dataRoot);
@@ -82,6 +84,8 @@ int TestHDFReaderTemporal(int argc, char* argv[])
   res |= ::TestUGTemporalPartitionedNoCache(dataRoot);
   res |= ::TestUGTemporalWithCachePartitioned(dataRoot);
   res |= ::TestImageDataTemporalWithCache(dataRoot);
+  res |= ::TestUGTemporalWithCachePrefetch(dataRoot);
+  res |= ::TestImageDataTemporalWithSmallCachePrefetch(dataRoot);
   res |= ::TestPolyDataTemporalWithCache(dataRoot);
   res |= ::TestPolyDataTemporalFieldData(dataRoot);
   res |= ::TestOverlappingAMRTemporal(dataRoot);
@@ -665,6 +669,28 @@ int TestImageDataTemporalWithCache(const std::string& dataRoot)
   return TestImageDataTemporalBase(opener);
 }
 
+//------------------------------------------------------------------------------
+int TestUGTemporalWithCachePrefetch(const std::string& dataRoot)
+{
+  OpenerWorklet opener(dataRoot + "/Data/transient_sphere.hdf");
+  opener.GetReader()->UseCacheOn();
+  opener.GetReader()->PrefetchNextStepOn();
+  opener.GetReader()->SetMergeParts(false);
+  return TestUGTemporalPartitioned(opener, dataRoot, true);
+}
+
+//------------------------------------------------------------------------------
+int TestImageDataTemporalWithSmallCachePrefetch(const std::string& dataRoot)
+{
+  // A cache smaller than a time step discards arrays before they are used again
+  OpenerWorklet opener(dataRoot + "/Data/transient_wavelet.hdf");
+  opener.GetReader()->UseCacheOn();
+  opener.GetReader()->PrefetchNextStepOn();
+  opener.GetReader()->SetCacheMemoryLimit(1);
+  opener.GetReader()->SetMergeParts(false);
+  return TestImageDataTemporalBase(opener);
+}
+
 int TestPolyDataTemporalBase(
   OpenerWorklet& opener, const std::string& dataRoot, bool testMeshMTime = false)
 {
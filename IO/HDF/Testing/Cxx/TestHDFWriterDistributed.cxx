@@ -88,6 +88,56 @@ bool TestDistributedObject(
   return true;
 }
 
+/**
+ * Write a distributed sphere in a single file with collective IO, when HDF5 supports it, and
+ * compare the read pieces to the original ones.
+ */
+bool TestDistributedCollective(
+  vtkMPIController* controller, const std::string& tempDir, bool usePolyData)
+{
+  int myRank = controller->GetLocalProcessId();
+  int nbRanks = controller->GetNumberOfProcesses();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetPhiResolution(50);
+  sphere->SetThetaResolution(50);
+
+  vtkNew<vtkRedistributeDataSetFilter> redistribute;
+  redistribute->SetGenerateGlobalCellIds(false);
+  redistribute->SetInputConnection(sphere->GetOutputPort());
+
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputConnection(redistribute->GetOutputPort());
+
+  std::string filePath =
+    tempDir + "/parallel_collective_sphere_" + (usePolyData ? "PD" : "UG") + ".vtkhdf";
+
+  {
+    vtkNew<vtkHDFWriter> writer;
+    writer->SetInputConnection(
+      usePolyData ? surface->GetOutputPort() : redistribute->GetOutputPort());
+    writer->SetFileName(filePath.c_str());
+    writer->UseCollectiveIOOn();
+    writer->Write();
+  }
+
+  controller->Barrier();
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(filePath.c_str());
+  reader->UpdatePiece(myRank, nbRanks, 0);
+
+  vtkDataObject* originalPiece =
+    usePolyData ? surface->GetOutputDataObject(0) : redistribute->GetOutputDataObject(0);
+  if (!vtkTestUtilities::CompareDataObjects(reader->GetOutputDataObject(0), originalPiece))
+  {
+    vtkLog(ERROR, "Original and collectively written piece do not match");
+    return false;
+  }
+
+  return true;
+}
+
 /**
  * Pipeline used for this test:
  * Cow > Redistribute > (usePolyData ? SurfaceFilter ) > Generate Time steps > Harmonics >
@@ -271,6 +321,8 @@ int TestHDFWriterDistributed(int argc, char* argv[])
   bool res = true;
   res &= ::TestDistributedPolyData(controller, tempDir);
   res &= ::TestDistributedUnstructuredGrid(controller, tempDir);
+  res &= ::TestDistributedCollective(controller, tempDir, true);
+  res &= ::TestDistributedCollective(controller, tempDir, false);
   res &= ::TestDistributedUnstructuredGridTemporal(controller, tempDir, dataRoot);
   res &= ::TestDistributedUnstructuredGridTemporalStatic(controller, tempDir, dataRoot);
   res &= ::TestDistributedPolyDataTemporal(controller, tempDir, dataRoot);
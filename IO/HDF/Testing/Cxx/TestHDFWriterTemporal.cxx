@@ -159,6 +159,8 @@ bool TestTemporalStaticMesh(
   HDFWriter->SetFileName(tempPath.c_str());
   HDFWriter->SetWriteAllTimeSteps(true);
   HDFWriter->SetCompressionLevel(1);
+  // Let the writer choose the chunk size
+  HDFWriter->SetChunkSize(0);
   if (!HDFWriter->Write())
   {
     vtkLog(ERROR, "An error occured while writing the static mesh HDF file");
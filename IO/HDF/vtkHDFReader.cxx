@@ -39,9 +39,13 @@
 #include <cassert>
 #include <cctype>
 #include <functional>
+#include <list>
 #include <locale>
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "vtkPointData.h"
@@ -88,9 +92,12 @@ vtkSmartPointer<vtkDataArray> ReadFromFileOrCache(ImplT* impl, std::shared_ptr<C
 {
   vtkSmartPointer<vtkDataArray> array;
   std::string cacheName = name + name_modifier;
-  if (cache && cache->CheckExistsAndEqual(tag, cacheName, offset, size))
+  const std::string cachePath = impl->GetGroupPath() + "/" + cacheName;
+  vtkSmartPointer<vtkAbstractArray> cached =
+    cache ? cache->Get(tag, cachePath, offset, size) : nullptr;
+  if (cached)
   {
-    array = vtkDataArray::SafeDownCast(cache->Get(tag, cacheName));
+    array = vtkDataArray::SafeDownCast(cached);
     if (!array)
     {
       vtkErrorWithObjectMacro(nullptr, "Cannot read the " << cacheName << " array from cache");
@@ -108,7 +115,7 @@ vtkSmartPointer<vtkDataArray> ReadFromFileOrCache(ImplT* impl, std::shared_ptr<C
     }
     if (cache)
     {
-      cache->Set(tag, cacheName, offset, size, array);
+      cache->Set(tag, cachePath, offset, size, array);
     }
   }
   return array;
@@ -216,7 +223,12 @@ void UpdateGeometryIfRequired(vtkDataObjT* data, vtkCompositeDataSet* compositeD
 //----------------------------------------------------------------------------
 /*
  * A data cache for avoiding supplemental read of data that doesn't change from
- * one time step to the next
+ * one time step to the next, or that has already been read for a previous time step
+ *
+ * The arrays are kept in a store that is shared with the reader prefetching the next
+ * time step. The store discards the least recently used arrays once its memory limit is
+ * reached. The reader side of the cache tracks the extent last served for each array so
+ * that a geometry taken from the store for another time step is detected as a change.
  *
  * Comment: The cache could be improved to also conserve the MeshMTime of the
  * DataSets by adding supplemental storage for the intermediate geometrical containers
@@ -227,82 +239,121 @@ void UpdateGeometryIfRequired(vtkDataObjT* data, vtkCompositeDataSet* compositeD
 struct vtkHDFReader::DataCache
 {
   /*
-   * The key is a pair of:
+   * The key of the last served extents is a pair of:
    * - first: an int flag referring to the attribute type
-   * - second: a unique name associated to the array for that attribute type
+   * - second: a unique name associated to the array for that attribute type, made of the path
+   *   of the dataset in the file, the name of the array and the piece
    */
   using KeyT = std::pair<int, std::string>;
   /*
-   * The values of the map are also pairs with:
-   * - first: the extent of the last read array in the file
-   * - second: a vtkSmartPointer to the array itself for quick access
+   * The arrays of the store are identified by their key and their extent in the file, the
+   * extent being specific to the time step and the piece.
    */
-  using ValueT = std::pair<std::vector<vtkIdType>, vtkSmartPointer<vtkAbstractArray>>;
-  bool Has(int attribute, const std::string& key)
-  {
-    return (this->Map.find(KeyT{ attribute, key }) != this->Map.end());
-  }
+  using StoreKeyT = std::pair<KeyT, std::vector<vtkIdType>>;
 
-  template <typename T>
-  bool CheckExistsAndEqual(int attribute, const std::string& name, const T& currentOffset)
+  struct Store
   {
-    if (!this->Has(attribute, name))
+    struct EntryT
     {
-      return false;
+      StoreKeyT Key;
+      vtkSmartPointer<vtkAbstractArray> Array;
+      unsigned long Size;
+    };
+
+    vtkSmartPointer<vtkAbstractArray> Get(const StoreKeyT& key)
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto it = this->Index.find(key);
+      if (it == this->Index.end())
+      {
+        return nullptr;
+      }
+      // move to the most recently used position
+      this->Entries.splice(this->Entries.begin(), this->Entries, it->second);
+      return it->second->Array;
     }
-    const auto& lastOffsets = this->Map.find(KeyT{ attribute, name })->second;
-    if (lastOffsets.first.size() != currentOffset.size())
+
+    void Set(const StoreKeyT& key, vtkAbstractArray* array)
     {
-      return false;
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto it = this->Index.find(key);
+      if (it != this->Index.end())
+      {
+        this->Size -= it->second->Size;
+        this->Entries.erase(it->second);
+        this->Index.erase(it);
+      }
+      const unsigned long size = array->GetActualMemorySize();
+      this->Entries.push_front(EntryT{ key, array, size });
+      this->Index.emplace(key, this->Entries.begin());
+      this->Size += size;
+      this->Evict();
+    }
+
+    void SetMemoryLimit(unsigned long limit)
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->MemoryLimit = limit;
+      this->Evict();
     }
-    for (std::size_t iO = 0; iO < lastOffsets.first.size(); ++iO)
+
+  private:
+    // Never discards the most recently used array
+    void Evict()
     {
-      if (lastOffsets.first[iO] != static_cast<vtkIdType>(currentOffset[iO]))
+      while (this->Size > this->MemoryLimit && this->Entries.size() > 1)
       {
-        return false;
+        const EntryT& last = this->Entries.back();
+        this->Size -= last.Size;
+        this->Index.erase(last.Key);
+        this->Entries.pop_back();
       }
     }
-    return true;
-  }
 
-  template <typename T, typename ArrayT>
-  void Set(int attribute, const std::string& name, const T& offset, vtkSmartPointer<ArrayT> array)
+    std::mutex Mutex;
+    std::list<EntryT> Entries;
+    std::map<StoreKeyT, std::list<EntryT>::iterator> Index;
+    unsigned long Size = 0;
+    unsigned long MemoryLimit = VTK_UNSIGNED_LONG_MAX;
+  };
+
+  /*
+   * Return the array stored for this extent, or nullptr if there is none.
+   */
+  template <typename T>
+  vtkSmartPointer<vtkAbstractArray> Get(int attribute, const std::string& name, const T& extent)
   {
-    std::vector<vtkIdType> buff(offset.size());
-    std::copy(offset.begin(), offset.end(), buff.begin());
-    this->Map.emplace(KeyT{ attribute, name },
-      ValueT{ std::move(buff), static_cast<vtkSmartPointer<vtkAbstractArray>>(array) });
-    this->HasBeenUpdated = true;
+    StoreKeyT key = MakeKey(attribute, name, extent);
+    vtkSmartPointer<vtkAbstractArray> array = this->Arrays->Get(key);
+    if (array)
+    {
+      this->Serve(key);
+    }
+    return array;
   }
 
   template <typename OffT>
-  bool CheckExistsAndEqual(
-    int attribute, const std::string& name, const OffT& currentOffset, const OffT& currentSize)
+  vtkSmartPointer<vtkAbstractArray> Get(
+    int attribute, const std::string& name, const OffT& offset, const OffT& size)
+  {
+    std::vector<vtkIdType> buff{ static_cast<vtkIdType>(offset), static_cast<vtkIdType>(size) };
+    return this->Get(attribute, name, buff);
+  }
+
+  template <typename T, typename ArrayT>
+  void Set(int attribute, const std::string& name, const T& extent, vtkSmartPointer<ArrayT> array)
   {
-    std::vector<vtkIdType> buff{ static_cast<vtkIdType>(currentOffset),
-      static_cast<vtkIdType>(currentSize) };
-    return this->CheckExistsAndEqual(attribute, name, buff);
+    StoreKeyT key = MakeKey(attribute, name, extent);
+    this->Arrays->Set(key, array);
+    this->Serve(key);
   }
 
   template <typename OffT, typename ArrayT>
   void Set(int attribute, const std::string& name, const OffT& offset, const OffT& size,
     vtkSmartPointer<ArrayT> array)
   {
-    auto key = KeyT{ attribute, name };
     std::vector<vtkIdType> buff{ static_cast<vtkIdType>(offset), static_cast<vtkIdType>(size) };
-    this->Map.emplace(
-      key, ValueT{ std::move(buff), static_cast<vtkSmartPointer<vtkAbstractArray>>(array) });
-    this->HasBeenUpdated = true;
-  }
-
-  vtkSmartPointer<vtkAbstractArray> Get(int attribute, const std::string& name)
-  {
-    auto it = this->Map.find(KeyT{ attribute, name });
-    if (it == this->Map.end())
-    {
-      return nullptr;
-    }
-    return it->second.second;
+    this->Set(attribute, name, buff, array);
   }
 
   void ResetCacheUpdatedStatus() { this->HasBeenUpdated = false; }
@@ -318,8 +369,40 @@ struct vtkHDFReader::DataCache
   }
   bool HasBeenUpdated = false;
 
+  std::shared_ptr<Store> Arrays = std::make_shared<Store>();
+
+  // Reader and background thread used to prefetch the next time step
+  vtkSmartPointer<vtkHDFReader> Prefetcher;
+  std::thread PrefetchThread;
+
 private:
-  std::map<KeyT, ValueT> Map;
+  template <typename T>
+  static StoreKeyT MakeKey(int attribute, const std::string& name, const T& extent)
+  {
+    std::vector<vtkIdType> buff(extent.size());
+    std::copy(extent.begin(), extent.end(), buff.begin());
+    return StoreKeyT{ KeyT{ attribute, name }, std::move(buff) };
+  }
+
+  /*
+   * Flag the cache as updated when the array served for a key changes from the last one
+   */
+  void Serve(const StoreKeyT& key)
+  {
+    auto it = this->LastServed.find(key.first);
+    if (it == this->LastServed.end())
+    {
+      this->LastServed.emplace(key.first, key.second);
+      this->HasBeenUpdated = true;
+    }
+    else if (it->second != key.second)
+    {
+      it->second = key.second;
+      this->HasBeenUpdated = true;
+    }
+  }
+
+  std::map<KeyT, std::vector<vtkIdType>> LastServed;
 };
 
 //----------------------------------------------------------------------------
@@ -355,6 +438,7 @@ vtkHDFReader::vtkHDFReader()
 //----------------------------------------------------------------------------
 vtkHDFReader::~vtkHDFReader()
 {
+  this->WaitForPrefetch();
   delete this->Impl;
   this->SetFileName(nullptr);
   for (int i = 0; i < vtkHDFUtilities::GetNumberOfAttributeTypes(); ++i)
@@ -379,6 +463,10 @@ void vtkHDFReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Step: " << this->Step << "\n";
   os << indent << "TimeValue: " << this->TimeValue << "\n";
   os << indent << "TimeRange: " << this->TimeRange[0] << " - " << this->TimeRange[1] << "\n";
+  os << indent << "UseCache: " << (this->UseCache ? "true" : "false") << "\n";
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << "\n";
+  os << indent << "PrefetchNextStep: " << (this->PrefetchNextStep ? "true" : "false") << "\n";
+  os << indent << "UseMemoryMapping: " << (this->UseMemoryMapping ? "true" : "false") << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -497,6 +585,7 @@ int vtkHDFReader::RequestDataObject(vtkInformation*, vtkInformationVector** vtkN
     { VTK_OVERLAPPING_AMR, "vtkOverlappingAMR" },
     { VTK_PARTITIONED_DATA_SET_COLLECTION, "vtkPartitionedDataSetCollection" },
     { VTK_MULTIBLOCK_DATA_SET, "vtkMultiBlockDataSet" } };
+  this->WaitForPrefetch();
 
   vtkInformation* info = outputVector->GetInformationObject(0);
   vtkDataObject* output = info->Get(vtkDataObject::DATA_OBJECT());
@@ -606,6 +695,7 @@ int vtkHDFReader::RequestDataObject(vtkInformation*, vtkInformationVector** vtkN
 int vtkHDFReader::RequestInformation(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
 {
+  this->WaitForPrefetch();
   if (!this->FileName)
   {
     vtkErrorMacro("Requires valid input file name");
@@ -748,6 +838,7 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
     return 0;
   }
 
+  const std::string cachePath = this->Impl->GetGroupPath() + "/";
   // in the same order as vtkDataObject::AttributeTypes: POINT, CELL
   for (int attributeType = 0; attributeType < vtkDataObject::FIELD; ++attributeType)
   {
@@ -759,6 +850,7 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
       {
         vtkSmartPointer<vtkDataArray> array;
         std::vector<hsize_t> fileExtent = ::ReduceDimension(updateExtent.data(), this->WholeExtent);
+        const std::size_t nSpatialDims = fileExtent.size() / 2;
         std::vector<int> extentBuffer(fileExtent.size(), 0);
         std::copy(
           updateExtent.begin(), updateExtent.begin() + extentBuffer.size(), extentBuffer.begin());
@@ -780,14 +872,31 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
         // Create the memory space, reverse axis order for VTK fortran order,
         // because VTK stores 2D/3D arrays in memory along columns (fortran order) rather
         // than along rows (C order)
+        // Only the hyperslab of the update extent is read from the file.
         for (std::size_t iDim = 0; iDim < fileExtent.size() / 2; ++iDim)
         {
           std::size_t rIDim = (fileExtent.size() / 2) - 1 - iDim;
-          // if an extent value is negative it won't go into an hsize_t
-          if (extentBuffer[rIDim * 2] < 0)
+          if (rIDim < nSpatialDims)
           {
-            extentBuffer[rIDim * 2 + 1] -= extentBuffer[rIDim * 2];
-            extentBuffer[rIDim * 2] = 0;
+            // the dataset is indexed from the start of the whole extent
+            const int wholeStart = this->WholeExtent[rIDim * 2];
+            const int wholeLength = this->WholeExtent[rIDim * 2 + 1] - wholeStart;
+            extentBuffer[rIDim * 2] -= wholeStart;
+            extentBuffer[rIDim * 2 + 1] -= wholeStart;
+            if (!pointModifier && extentBuffer[rIDim * 2] == extentBuffer[rIDim * 2 + 1] &&
+              wholeLength > 0)
+            {
+              // a flat update extent still has one layer of cells: the one it
+              // lies on, or the last one when it is on the upper boundary
+              if (extentBuffer[rIDim * 2] == wholeLength)
+              {
+                --extentBuffer[rIDim * 2];
+              }
+              else
+              {
+                ++extentBuffer[rIDim * 2 + 1];
+              }
+            }
           }
           fileExtent[iDim * 2] = extentBuffer[rIDim * 2];
           fileExtent[iDim * 2 + 1] = extentBuffer[rIDim * 2 + 1] + pointModifier;
@@ -797,9 +906,12 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
           // Add one to the extent for the time dimension if needed
           fileExtent[1] += 1;
         }
-        if (this->UseCache && this->Cache->CheckExistsAndEqual(attributeType, name, fileExtent))
+        vtkSmartPointer<vtkAbstractArray> cached = this->UseCache
+          ? this->Cache->Get(attributeType, cachePath + name, fileExtent)
+          : nullptr;
+        if (cached)
         {
-          array = vtkDataArray::SafeDownCast(this->Cache->Get(attributeType, name));
+          array = vtkDataArray::SafeDownCast(cached);
           if (!array)
           {
             vtkErrorMacro("Error retrieving array " + name + " from cache.");
@@ -814,13 +926,13 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
             vtkErrorMacro("Error reading array " << name);
             return 0;
           }
+          if (this->UseCache)
+          {
+            this->Cache->Set(attributeType, cachePath + name, fileExtent, array);
+          }
         }
         array->SetName(name.c_str());
         data->GetAttributesAsFieldData(attributeType)->AddArray(array);
-        if (this->UseCache)
-        {
-          this->Cache->Set(attributeType, name, fileExtent, array);
-        }
       }
     }
   }
@@ -831,6 +943,7 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
 int vtkHDFReader::AddFieldArrays(vtkDataObject* data)
 {
   const std::vector<std::string> names = this->Impl->GetArrayNames(vtkDataObject::FIELD);
+  const std::string cachePath = this->Impl->GetGroupPath() + "/";
   for (const std::string& name : names)
   {
     vtkSmartPointer<vtkAbstractArray> array;
@@ -845,17 +958,11 @@ int vtkHDFReader::AddFieldArrays(vtkDataObject* data)
         continue;
       }
     }
-    if (this->UseCache &&
-      this->Cache->CheckExistsAndEqual(vtkDataObject::FIELD, name, offset, size[1]))
+    if (this->UseCache)
     {
-      array = this->Cache->Get(vtkDataObject::FIELD, name);
-      if (!array)
-      {
-        vtkErrorMacro("Error retrieving array " + name + " from cache.");
-        return 0;
-      }
+      array = this->Cache->Get(vtkDataObject::FIELD, cachePath + name, offset, size[1]);
     }
-    else
+    if (!array)
     {
       if ((array = vtk::TakeSmartPointer(
              this->Impl->NewFieldArray(name.c_str(), offset, size[1], size[0]))) == nullptr)
@@ -864,12 +971,12 @@ int vtkHDFReader::AddFieldArrays(vtkDataObject* data)
         return 0;
       }
       array->SetName(name.c_str());
+      if (this->UseCache)
+      {
+        this->Cache->Set(vtkDataObject::FIELD, cachePath + name, offset, size[1], array);
+      }
     }
     data->GetAttributesAsFieldData(vtkDataObject::FIELD)->AddArray(array);
-    if (this->UseCache)
-    {
-      this->Cache->Set(vtkDataObject::FIELD, name, offset, size[1], array);
-    }
   }
   if (this->GetHasTemporalData())
   {
@@ -1609,6 +1716,7 @@ int vtkHDFReader::Read(vtkInformation* vtkNotUsed(outInfo), vtkOverlappingAMR* d
 int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
 {
+  this->WaitForPrefetch();
   this->MeshGeometryChangedFromPreviousTimeStep = false;
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   int ok = 1;
@@ -1627,6 +1735,7 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
     vtkErrorMacro(<< "Merge Parts and Use Cache are both enabled which is not supported for now.");
     return 0;
   }
+  this->Cache->Arrays->SetMemoryLimit(this->CacheMemoryLimit);
 
   if (this->HasTransientData)
   {
@@ -1695,7 +1804,73 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
     vtkErrorMacro("HDF dataset type unknown: " << dataSetType);
     return 0;
   }
-  return ok && this->AddFieldArrays(output);
+  ok = ok && this->AddFieldArrays(output);
+  // AMR arrays are never cached so there is nothing to prefetch for them
+  if (ok && this->UseCache && this->PrefetchNextStep && this->GetHasTemporalData() &&
+    this->Step + 1 < this->NumberOfSteps && dataSetType != VTK_OVERLAPPING_AMR)
+  {
+    this->PrefetchStep(outInfo, this->Step + 1);
+  }
+  return ok;
+}
+
+//----------------------------------------------------------------------------
+void vtkHDFReader::PrefetchStep(vtkInformation* outInfo, vtkIdType step)
+{
+  std::shared_ptr<DataCache> cache = this->Cache;
+  if (!cache->Prefetcher)
+  {
+    cache->Prefetcher = vtk::TakeSmartPointer(vtkHDFReader::New());
+    // The prefetcher only fills the shared store, so it keeps its own view of the cache
+    cache->Prefetcher->Cache->Arrays = cache->Arrays;
+  }
+  vtkHDFReader* prefetcher = cache->Prefetcher;
+  prefetcher->SetFileName(this->FileName);
+  for (int i = 0; i < vtkHDFUtilities::GetNumberOfAttributeTypes(); ++i)
+  {
+    prefetcher->DataArraySelection[i]->CopySelections(this->DataArraySelection[i]);
+  }
+  prefetcher->SetUseCache(true);
+  prefetcher->SetMergeParts(false);
+  prefetcher->SetUseMemoryMapping(this->UseMemoryMapping);
+  prefetcher->SetCacheMemoryLimit(this->CacheMemoryLimit);
+  prefetcher->SetMaximumLevelsToReadByDefaultForAMR(this->MaximumLevelsToReadByDefaultForAMR);
+  prefetcher->AttributesOriginalIdName = this->AttributesOriginalIdName;
+  prefetcher->SetStep(step);
+
+  const int piece = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER())
+    ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER())
+    : 0;
+  const int numPieces = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES())
+    ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES())
+    : 1;
+  const int ghostLevels =
+    outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS())
+    ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS())
+    : 0;
+  std::array<int, 6> extent;
+  const bool hasExtent = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()) &&
+    this->Impl->GetDataSetType() == VTK_IMAGE_DATA;
+  if (hasExtent)
+  {
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent.data());
+  }
+
+  cache->PrefetchThread = std::thread(
+    [prefetcher, piece, numPieces, ghostLevels, extent, hasExtent]() {
+      prefetcher->UpdatePiece(piece, numPieces, ghostLevels, hasExtent ? extent.data() : nullptr);
+      // The arrays of interest are in the store, the output is not needed anymore
+      prefetcher->GetOutputDataObject(0)->Initialize();
+    });
+}
+
+//----------------------------------------------------------------------------
+void vtkHDFReader::WaitForPrefetch()
+{
+  if (this->Cache->PrefetchThread.joinable())
+  {
+    this->Cache->PrefetchThread.join();
+  }
 }
 
 //----------------------------------------------------------------------------
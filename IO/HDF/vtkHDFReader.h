@@ -138,7 +138,8 @@ public:
    * Boolean property determining whether to use the internal cache or not (default is false).
    *
    * Internal cache is useful when reading temporal data to never re-read something that has
-   * already been cached.
+   * already been cached. The cache keeps the arrays read for every dataset, piece and time step
+   * until CacheMemoryLimit is reached, then discards the least recently used arrays first.
    *
    * @note Incompatible with MergeParts as vtkAppendDataSet which is used internally doesn't
    * support static mesh.
@@ -148,6 +149,45 @@ public:
   vtkBooleanMacro(UseCache, bool);
   ///@}
 
+  ///@{
+  /**
+   * Maximum amount of memory, in kibibytes, used by the arrays of the internal cache (default is
+   * 1 GiB). The arrays read for the current step are kept even when they exceed this limit.
+   */
+  vtkGetMacro(CacheMemoryLimit, unsigned long);
+  vtkSetMacro(CacheMemoryLimit, unsigned long);
+  ///@}
+
+  ///@{
+  /**
+   * Boolean property determining whether the next time step is read into the internal cache by a
+   * background thread once a time step has been read (default is false). The next update of the
+   * reader then takes the arrays of the next time step from the cache, which smooths the playback
+   * of temporal data. Only used when UseCache is true.
+   *
+   * @note The background thread reads the file while the rest of the pipeline executes, which
+   * needs a thread-safe HDF5 build when the application uses HDF5 from other threads.
+   */
+  vtkGetMacro(PrefetchNextStep, bool);
+  vtkSetMacro(PrefetchNextStep, bool);
+  vtkBooleanMacro(PrefetchNextStep, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Boolean property determining whether attribute arrays should point into a private memory
+   * mapping of the file instead of being read into memory (default is false).
+   *
+   * Only datasets stored contiguously and uncompressed, with a native data type, in a file opened
+   * with the default HDF5 file driver can be mapped. Other datasets are read as usual. Pages of the
+   * file are only loaded when the values of the arrays are accessed, and modifying a mapped array
+   * never modifies the file.
+   */
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+  ///@}
+
   ///@{
   /**
    * Boolean property determining whether to merge partitions when reading unstructured data.
@@ -297,6 +337,9 @@ protected:
   unsigned int MaximumLevelsToReadByDefaultForAMR = 0;
 
   bool UseCache = false;
+  unsigned long CacheMemoryLimit = 1048576;
+  bool PrefetchNextStep = false;
+  bool UseMemoryMapping = false;
   struct DataCache;
   std::shared_ptr<DataCache> Cache;
 
@@ -349,6 +392,18 @@ private:
    */
   void CleanOriginalIds(vtkPartitionedDataSet* output);
 
+  /**
+   * Start reading the given step of the piece requested in outInfo into the internal cache from
+   * a background thread.
+   */
+  void PrefetchStep(vtkInformation* outInfo, vtkIdType step);
+
+  /**
+   * Block until the background read started by PrefetchStep, if any, is done. Must be called
+   * before any access to the file.
+   */
+  void WaitForPrefetch();
+
   bool MeshGeometryChangedFromPreviousTimeStep = true;
 
   vtkNew<vtkDataObjectMeshCache> MeshCache;
@@ -83,6 +83,7 @@ bool vtkHDFReader::Implementation::OpenGroupAsVTKGroup(const std::string& groupP
     // the file doesn't exist or we try to read a non-VTKHDF file
     return false;
   }
+  this->GroupPath = groupPath;
 
   return true;
 }
@@ -95,6 +96,7 @@ bool vtkHDFReader::Implementation::RetrieveHDFInformation(const std::string& roo
   {
     return false;
   }
+  this->GroupPath = rootName;
   return true;
 }
 
@@ -231,8 +233,8 @@ std::vector<std::string> vtkHDFReader::Implementation::GetOrderedChildrenOfGroup
 vtkDataArray* vtkHDFReader::Implementation::NewArray(
   int attributeType, const char* name, const std::vector<hsize_t>& fileExtent)
 {
-  return vtkHDFUtilities::NewArrayForGroup(
-    this->AttributeDataGroup[attributeType], name, fileExtent);
+  return vtkHDFUtilities::NewArrayForGroup(this->AttributeDataGroup[attributeType], name,
+    fileExtent, this->Reader->GetUseMemoryMapping());
 }
 
 //------------------------------------------------------------------------------
@@ -240,8 +242,8 @@ vtkDataArray* vtkHDFReader::Implementation::NewArray(
   int attributeType, const char* name, hsize_t offset, hsize_t size)
 {
   std::vector<hsize_t> fileExtent = { offset, offset + size };
-  return vtkHDFUtilities::NewArrayForGroup(
-    this->AttributeDataGroup[attributeType], name, fileExtent);
+  return vtkHDFUtilities::NewArrayForGroup(this->AttributeDataGroup[attributeType], name,
+    fileExtent, this->Reader->GetUseMemoryMapping());
 }
 
 //------------------------------------------------------------------------------
@@ -146,6 +146,11 @@ public:
    */
   bool OpenGroupAsVTKGroup(const std::string& groupPath);
 
+  /**
+   * Return the path of the group currently considered as the root of the file.
+   */
+  const std::string& GetGroupPath() const { return this->GroupPath; }
+
   /**
    * Initialize meta information of the implementation based on root name specified.
    */
@@ -181,6 +186,7 @@ public:
 
 private:
   std::string FileName;
+  std::string GroupPath;
   hid_t File;
   hid_t VTKGroup;
   // in the same order as vtkDataObject::AttributeTypes: POINT, CELL, FIELD
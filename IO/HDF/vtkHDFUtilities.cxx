@@ -191,9 +191,94 @@ bool NewArray(
 }
 
 //------------------------------------------------------------------------------
+/**
+ * Map the fileExtent slab of the dataset into the array instead of reading it.
+ * This is only possible when the dataset is stored contiguously in a file opened
+ * with the default (sec2) driver, with the native type of T, and when the slab
+ * is itself contiguous: every dimension but the first one is fully selected.
+ * Returns false without any error message when the dataset cannot be mapped.
+ */
 template <typename T>
-vtkDataArray* NewArray(
-  hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents)
+bool MapArray(hid_t dataset, const std::vector<hsize_t>& fileExtent,
+  vtkAOSDataArrayTemplate<T>* array, vtkIdType numberOfValues)
+{
+  if (numberOfValues <= 0)
+  {
+    return false;
+  }
+  vtkHDF::ScopedH5PHandle createPlist = H5Dget_create_plist(dataset);
+  if (createPlist < 0 || H5Pget_layout(createPlist) != H5D_CONTIGUOUS)
+  {
+    return false;
+  }
+  vtkHDF::ScopedH5THandle fileType = H5Dget_type(dataset);
+  if (fileType < 0 || H5Tequal(fileType, vtkHDFUtilities::TemplateTypeToHdfNativeType<T>()) <= 0)
+  {
+    return false;
+  }
+  haddr_t address = H5Dget_offset(dataset);
+  if (address == HADDR_UNDEF)
+  {
+    return false;
+  }
+  vtkHDF::ScopedH5FHandle file = H5Iget_file_id(dataset);
+  if (file < 0)
+  {
+    return false;
+  }
+  vtkHDF::ScopedH5PHandle accessPlist = H5Fget_access_plist(file);
+  if (accessPlist < 0 || H5Pget_driver(accessPlist) != H5FD_SEC2)
+  {
+    return false;
+  }
+
+  vtkHDF::ScopedH5SHandle filespace = H5Dget_space(dataset);
+  int ndims = filespace < 0 ? -1 : H5Sget_simple_extent_ndims(filespace);
+  if (ndims <= 0)
+  {
+    return false;
+  }
+  std::vector<hsize_t> dims(ndims);
+  if (H5Sget_simple_extent_dims(filespace, dims.data(), nullptr) < 0)
+  {
+    return false;
+  }
+  // the dimensions after the first one, including the components, need to be complete
+  hsize_t stride = 1;
+  for (size_t i = 1; i < dims.size(); ++i)
+  {
+    size_t j = i << 1;
+    if (j + 1 < fileExtent.size() && (fileExtent[j] != 0 || fileExtent[j + 1] != dims[i]))
+    {
+      return false;
+    }
+    stride *= dims[i];
+  }
+  const hsize_t start = fileExtent.empty() ? 0 : fileExtent[0];
+  if (fileExtent.size() > 1 && fileExtent[1] > dims[0])
+  {
+    return false;
+  }
+  const vtkTypeInt64 offset = static_cast<vtkTypeInt64>(address + start * stride * sizeof(T));
+
+  ssize_t nameLength = H5Fget_name(file, nullptr, 0);
+  if (nameLength <= 0)
+  {
+    return false;
+  }
+  std::string fileName(static_cast<size_t>(nameLength) + 1, '\0');
+  if (H5Fget_name(file, &fileName[0], fileName.size()) < 0)
+  {
+    return false;
+  }
+  fileName.resize(static_cast<size_t>(nameLength));
+  return array->MapFile(fileName.c_str(), offset, numberOfValues);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+vtkDataArray* NewArray(hid_t dataset, const std::vector<hsize_t>& fileExtent,
+  hsize_t numberOfComponents, bool useMemoryMapping)
 {
   int numberOfTuples = 1;
   size_t ndims = fileExtent.size() / 2;
@@ -204,6 +289,12 @@ vtkDataArray* NewArray(
   }
   auto array = vtkAOSDataArrayTemplate<T>::SafeDownCast(::NewVtkDataArray<T>());
   array->SetNumberOfComponents(numberOfComponents);
+  if (useMemoryMapping &&
+    ::MapArray(dataset, fileExtent, array,
+      static_cast<vtkIdType>(numberOfTuples) * static_cast<vtkIdType>(numberOfComponents)))
+  {
+    return array;
+  }
   array->SetNumberOfTuples(numberOfTuples);
   T* data = array->GetPointer(0);
   if (!::NewArray(dataset, fileExtent, numberOfComponents, data))
@@ -214,8 +305,8 @@ vtkDataArray* NewArray(
   return array;
 }
 
-using ArrayReader = vtkDataArray*(
-  hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents);
+using ArrayReader = vtkDataArray*(hid_t dataset, const std::vector<hsize_t>& fileExtent,
+  hsize_t numberOfComponents, bool useMemoryMapping);
 using TypeReaderMap = std::map<::TypeDescription, ArrayReader*>;
 
 //------------------------------------------------------------------------------
@@ -810,7 +901,8 @@ hid_t vtkHDFUtilities::OpenDataSet(
 
 //------------------------------------------------------------------------------
 vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t dataset, hid_t nativeType,
-  const std::vector<hsize_t>& dims, const std::vector<hsize_t>& parameterExtent)
+  const std::vector<hsize_t>& dims, const std::vector<hsize_t>& parameterExtent,
+  bool useMemoryMapping)
 {
   vtkDataArray* array = nullptr;
   try
@@ -862,7 +954,7 @@ vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t dataset, hid_t nativeType,
     }
     else
     {
-      array = builder(dataset, extent, numberOfComponents);
+      array = builder(dataset, extent, numberOfComponents, useMemoryMapping);
     }
   }
   catch (const std::exception& e)
@@ -874,8 +966,8 @@ vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t dataset, hid_t nativeType,
 }
 
 //------------------------------------------------------------------------------
-vtkDataArray* vtkHDFUtilities::NewArrayForGroup(
-  hid_t group, const char* name, const std::vector<hsize_t>& parameterExtent)
+vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t group, const char* name,
+  const std::vector<hsize_t>& parameterExtent, bool useMemoryMapping)
 {
   std::vector<hsize_t> dims;
   hid_t tempNativeType = H5I_INVALID_HID;
@@ -887,7 +979,8 @@ vtkDataArray* vtkHDFUtilities::NewArrayForGroup(
     return nullptr;
   }
 
-  return vtkHDFUtilities::NewArrayForGroup(dataset, nativeType, dims, parameterExtent);
+  return vtkHDFUtilities::NewArrayForGroup(
+    dataset, nativeType, dims, parameterExtent, useMemoryMapping);
 }
 
 //------------------------------------------------------------------------------
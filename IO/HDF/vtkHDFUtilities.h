@@ -184,11 +184,16 @@ VTKIOHDF_EXPORT hid_t OpenDataSet(
  * fileExtent.size()>>1 == ndims - in this case we read a scalar
  * fileExtent.size()>>1 + 1 == ndims - in this case we read an array with
  *                           the number of components > 1.
+ * When useMemoryMapping is true, the array points into a private mapping of
+ * the file instead of holding a copy of the values whenever the dataset is
+ * contiguous, uncompressed, has a native type and the slab is contiguous.
+ * Otherwise the slab is read as usual.
  */
 VTKIOHDF_EXPORT vtkDataArray* NewArrayForGroup(hid_t dataset, hid_t nativeType,
-  const std::vector<hsize_t>& dims, const std::vector<hsize_t>& parameterExtent);
-VTKIOHDF_EXPORT vtkDataArray* NewArrayForGroup(
-  hid_t group, const char* name, const std::vector<hsize_t>& parameterExtent);
+  const std::vector<hsize_t>& dims, const std::vector<hsize_t>& parameterExtent,
+  bool useMemoryMapping = false);
+VTKIOHDF_EXPORT vtkDataArray* NewArrayForGroup(hid_t group, const char* name,
+  const std::vector<hsize_t>& parameterExtent, bool useMemoryMapping = false);
 ///@}
 
 /**
@@ -3,6 +3,7 @@
 #include "vtkHDFWriter.h"
 
 #include "vtkAbstractArray.h"
+#include "vtkCommunicator.h"
 #include "vtkDataAssembly.h"
 #include "vtkDataObjectTree.h"
 #include "vtkDataObjectTreeIterator.h"
@@ -224,6 +225,9 @@ void vtkHDFWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Overwrite: " << (this->Overwrite ? "yes" : "no") << "\n";
   os << indent << "WriteAllTimeSteps: " << (this->WriteAllTimeSteps ? "yes" : "no") << "\n";
   os << indent << "ChunkSize: " << this->ChunkSize << "\n";
+  os << indent << "CompressionLevel: " << this->CompressionLevel << "\n";
+  os << indent << "CompressionFilter: " << this->CompressionFilter << "\n";
+  os << indent << "UseCollectiveIO: " << (this->UseCollectiveIO ? "yes" : "no") << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -231,10 +235,32 @@ void vtkHDFWriter::WriteData()
 {
   this->Impl->SetSubFilesReady(false);
 
+  vtkDataObject* input = vtkDataObject::SafeDownCast(this->GetInput());
+
   // Root file group only needs to be opened for the first timestep
   if (this->CurrentTimeIndex == 0)
   {
-    if (this->NbPieces > 1)
+    bool collective = false;
+    if (this->UseCollectiveIO && this->NbPieces > 1)
+    {
+      collective = this->Impl->IsCollectiveIOAvailable() && !this->IsTemporal &&
+        (vtkPolyData::SafeDownCast(input) || vtkUnstructuredGrid::SafeDownCast(input));
+      if (!collective)
+      {
+        vtkWarningMacro(<< "Collective IO is not available for this input, writing one file per "
+                           "process.");
+      }
+    }
+
+    if (collective)
+    {
+      if (!this->Impl->CreateFile(this->Overwrite, this->FileName, true))
+      {
+        vtkErrorMacro(<< "Could not create file collectively : " << this->FileName);
+        return;
+      }
+    }
+    else if (this->NbPieces > 1)
     {
       const std::string partitionSuffix = "part" + std::to_string(this->CurrentPiece);
       const std::string filePath =
@@ -254,8 +280,6 @@ void vtkHDFWriter::WriteData()
   // Wait for the file to be created
   this->Controller->Barrier();
 
-  vtkDataObject* input = vtkDataObject::SafeDownCast(this->GetInput());
-
   if (this->NbPieces == 1 && this->IsTemporal && this->UseExternalTimeSteps)
   {
     // Write the time step data in an external file
@@ -266,6 +290,7 @@ void vtkHDFWriter::WriteData()
     writer->SetInputData(input);
     writer->SetFileName(subFilePath.c_str());
     writer->SetCompressionLevel(this->CompressionLevel);
+    writer->SetCompressionFilter(this->CompressionFilter);
     writer->SetChunkSize(this->ChunkSize);
     writer->SetUseExternalComposite(this->UseExternalComposite);
     writer->SetUseExternalPartitions(this->UseExternalPartitions);
@@ -295,8 +320,13 @@ void vtkHDFWriter::WriteData()
 
   this->UpdatePreviousStepMeshMTime(input);
 
+  if (this->Impl->GetCollective())
+  {
+    // Closing the file is collective too, do it while all processes are writing
+    this->Impl->CloseFile();
+  }
   // Write the metafile for distributed datasets, gathering information from all timesteps
-  if (this->NbPieces > 1)
+  else if (this->NbPieces > 1)
   {
     this->WriteDistributedMetafile(input);
   }
@@ -493,6 +523,7 @@ bool vtkHDFWriter::WriteDatasetToFile(hid_t group, vtkPartitionedDataSet* input)
       writer->SetInputData(input->GetPartition(partIndex));
       writer->SetFileName(subFilePath.c_str());
       writer->SetCompressionLevel(this->CompressionLevel);
+      writer->SetCompressionFilter(this->CompressionFilter);
       writer->SetChunkSize(this->ChunkSize);
       if (!writer->Write())
       {
@@ -886,7 +917,24 @@ bool vtkHDFWriter::InitializePointDatasets(hid_t group, vtkPoints* points)
 {
   int components = 3;
   hid_t datatype = vtkHDFUtilities::getH5TypeFromVtkType(VTK_DOUBLE);
-  if (points)
+  if (this->Impl->GetCollective())
+  {
+    // Datasets are created collectively with the same type on all processes: use the type of the
+    // points when they agree, doubles otherwise.
+    int localTypes[2] = { VTK_INT_MIN, VTK_INT_MAX };
+    if (points && points->GetData())
+    {
+      localTypes[0] = points->GetDataType();
+      localTypes[1] = -points->GetDataType();
+    }
+    int globalTypes[2];
+    this->Controller->AllReduce(localTypes, globalTypes, 2, vtkCommunicator::MAX_OP);
+    if (globalTypes[0] == -globalTypes[1])
+    {
+      datatype = vtkHDFUtilities::getH5TypeFromVtkType(globalTypes[0]);
+    }
+  }
+  else if (points)
   {
     vtkAbstractArray* pointArray = points->GetData();
     datatype = vtkHDFUtilities::getH5TypeFromVtkType(pointArray->GetDataType());
@@ -909,8 +957,8 @@ bool vtkHDFWriter::InitializePrimitiveDataset(hid_t group)
 {
   hsize_t largeChunkSize[] = { static_cast<hsize_t>(this->ChunkSize), 1 };
   bool initResult = true;
-  initResult &=
-    this->Impl->InitDynamicDataset(group, "Offsets", H5T_STD_I64LE, SINGLE_COLUMN, largeChunkSize);
+  initResult &= this->Impl->InitDynamicDataset(
+    group, "Offsets", H5T_STD_I64LE, SINGLE_COLUMN, largeChunkSize, this->CompressionLevel);
   initResult &= this->Impl->InitDynamicDataset(
     group, "NumberOfCells", H5T_STD_I64LE, SINGLE_COLUMN, SMALL_CHUNK);
   initResult &= this->Impl->InitDynamicDataset(
@@ -993,7 +1041,19 @@ bool vtkHDFWriter::AppendConnectivity(hid_t group, vtkCellArray* input)
 //------------------------------------------------------------------------------
 bool vtkHDFWriter::AppendPoints(hid_t group, vtkPointSet* input)
 {
-  if (input->GetPoints() != nullptr && input->GetPoints()->GetData() != nullptr)
+  if (this->Impl->GetCollective() &&
+    (input->GetPoints() == nullptr || input->GetPoints()->GetData() == nullptr))
+  {
+    // Processes without points still take part in the collective write
+    vtkNew<vtkDoubleArray> noPoints;
+    noPoints->SetNumberOfComponents(3);
+    if (!this->Impl->AddOrCreateDataset(group, "Points", H5T_IEEE_F64LE, noPoints))
+    {
+      vtkErrorMacro(<< "Can not create points dataset when creating: " << this->FileName);
+      return false;
+    }
+  }
+  else if (input->GetPoints() != nullptr && input->GetPoints()->GetData() != nullptr)
   {
     if (!this->Impl->AddOrCreateDataset(
           group, "Points", H5T_IEEE_F64LE, input->GetPoints()->GetData()))
@@ -1132,6 +1192,12 @@ bool vtkHDFWriter::AppendDataSetAttributes(
                         << " when creating: " << this->FileName);
         continue;
       }
+      if (this->Impl->GetCollective() && array->GetDataType() == VTK_STRING)
+      {
+        vtkWarningMacro(<< "String array " << arrayName << " can not be written collectively in: "
+                        << this->FileName);
+        continue;
+      }
 
       // For temporal data, also add the offset in the steps group
       if (this->IsTemporal && !this->AppendDataArrayOffset(array, arrayName, offsetsGroupName))
@@ -1236,6 +1302,12 @@ bool vtkHDFWriter::AppendFieldDataArrays(hid_t baseGroup, vtkDataObject* input,
                       << " when creating: " << this->FileName);
       return true;
     }
+    if (this->Impl->GetCollective() && array->GetDataType() == VTK_STRING)
+    {
+      vtkWarningMacro(<< "String array " << arrayName << " can not be written collectively in: "
+                      << this->FileName);
+      continue;
+    }
 
     // For temporal data, also add the offset in the steps group
     if (this->IsTemporal && !this->AppendDataArrayOffset(array, arrayName, offsetsGroupName))
@@ -1323,6 +1395,8 @@ bool vtkHDFWriter::AppendExternalBlock(vtkDataObject* block, const std::string&
   writer->SetInputData(block);
   writer->SetFileName(subfileName.c_str());
   writer->SetCompressionLevel(this->CompressionLevel);
+  writer->SetCompressionFilter(this->CompressionFilter);
+  writer->SetChunkSize(this->ChunkSize);
   writer->SetUseExternalPartitions(this->UseExternalPartitions);
   if (!writer->Write())
   {
@@ -107,6 +107,9 @@ public:
    * data, please check this documentation:
    * https://docs.hdfgroup.org/hdf5/develop/_l_b_dset_layout.html
    *
+   * A chunk size of 0 selects chunks of about 1Mb, the size of the default chunk cache of HDF5,
+   * whatever the size of the values stored in each dataset.
+   *
    * Defaults to 25000 (to fit with the default chunk cache of 1Mb of HDF5).
    */
   vtkSetMacro(ChunkSize, int);
@@ -130,6 +133,29 @@ public:
   vtkGetMacro(CompressionLevel, int);
   ///@}
 
+  enum CompressionFilterType
+  {
+    DEFLATE,
+    ZSTD,
+    BLOSC
+  };
+
+  ///@{
+  /**
+   * Get/set the HDF5 filter used to compress datasets when CompressionLevel is not 0.
+   * ZSTD and BLOSC (using its zstd codec with byte shuffling) need the corresponding HDF5 filter
+   * plugin, found through HDF5_PLUGIN_PATH, both to write and to read the file. DEFLATE is used
+   * when the filter is not available.
+   *
+   * Default to DEFLATE.
+   */
+  vtkSetClampMacro(CompressionFilter, int, DEFLATE, BLOSC);
+  vtkGetMacro(CompressionFilter, int);
+  void SetCompressionFilterToDeflate() { this->SetCompressionFilter(DEFLATE); }
+  void SetCompressionFilterToZstd() { this->SetCompressionFilter(ZSTD); }
+  void SetCompressionFilterToBlosc() { this->SetCompressionFilter(BLOSC); }
+  ///@}
+
   ///@{
   /**
    * When set, write composite leaf blocks in different files,
@@ -175,6 +201,27 @@ public:
   vtkGetMacro(UseExternalPartitions, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set and the input is distributed over several MPI processes, all processes open
+   * the same file with the MPI-IO driver of HDF5 and write their part into shared datasets with
+   * collective hyperslab writes, instead of writing one file per process and a meta-file
+   * referencing them. The position of the part of each process is computed with an exclusive scan
+   * over the processes of the controller, so that the file is the same as the one written for the
+   * corresponding vtkPartitionedDataSet.
+   *
+   * This requires a HDF5 library built with MPI-IO support and a vtkMPIController. Only non
+   * temporal vtkPolyData and vtkUnstructuredGrid are written collectively; one file per time step
+   * can be written by changing the FileName between writes. All processes must have the same
+   * arrays, with the same types, and string arrays are not written. Other cases fall back to
+   * one file per process.
+   * Default is false.
+   */
+  vtkSetMacro(UseCollectiveIO, bool);
+  vtkGetMacro(UseCollectiveIO, bool);
+  vtkBooleanMacro(UseCollectiveIO, bool);
+  ///@}
+
 protected:
   /**
    * Override vtkWriter's ProcessRequest method, in order to dispatch the request
@@ -379,8 +426,10 @@ private:
   bool UseExternalComposite = false;
   bool UseExternalTimeSteps = false;
   bool UseExternalPartitions = false;
+  bool UseCollectiveIO = false;
   int ChunkSize = 25000;
   int CompressionLevel = 0;
+  int CompressionFilter = DEFLATE;
 
   // Temporal-related private variables
   double* timeSteps = nullptr;
@@ -8,9 +8,36 @@
 
 #include "vtk_hdf5.h"
 
+// Collective writes need a HDF5 library with MPI-IO support, see vtk_hdf5.h
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI && defined(H5_HAVE_PARALLEL)
+#define VTK_HDF_WRITER_MPIIO 1
+#include "vtkMPI.h"
+#include "vtkMPICommunicator.h"
+#include "vtkMultiProcessController.h"
+#else
+#define VTK_HDF_WRITER_MPIIO 0
+#endif
+
 #include <algorithm>
 #include <numeric>
 
+#if VTK_HDF_WRITER_MPIIO
+namespace
+{
+//------------------------------------------------------------------------------
+MPI_Comm GetMPICommunicator(vtkMultiProcessController* controller)
+{
+  vtkMPICommunicator* communicator =
+    controller ? vtkMPICommunicator::SafeDownCast(controller->GetCommunicator()) : nullptr;
+  if (!communicator || !communicator->GetMPIComm() || !communicator->GetMPIComm()->GetHandle())
+  {
+    return MPI_COMM_NULL;
+  }
+  return *communicator->GetMPIComm()->GetHandle();
+}
+}
+#endif
+
 VTK_ABI_NAMESPACE_BEGIN
 
 namespace PATH
@@ -97,18 +124,58 @@ bool vtkHDFWriter::Implementation::WriteHeader(hid_t group, const char* hdfType)
 }
 
 //------------------------------------------------------------------------------
-bool vtkHDFWriter::Implementation::CreateFile(bool overwrite, const std::string& filename)
+bool vtkHDFWriter::Implementation::CreateFile(
+  bool overwrite, const std::string& filename, bool collective)
 {
   // Create file
   vtkDebugWithObjectMacro(
     this->Writer, << "Creating file " << this->Writer->CurrentPiece << ": " << filename);
 
+  vtkHDF::ScopedH5PHandle fileAccess{ H5Pcreate(H5P_FILE_ACCESS) };
+  vtkHDF::ScopedH5PHandle transfer;
+  if (fileAccess == H5I_INVALID_HID)
+  {
+    return false;
+  }
+  if (collective)
+  {
+#if VTK_HDF_WRITER_MPIIO
+    if (H5Pset_fapl_mpio(fileAccess, ::GetMPICommunicator(this->Writer->GetController()),
+          MPI_INFO_NULL) < 0)
+    {
+      return false;
+    }
+    // Metadata is also written and read collectively, so that it does not
+    // bottleneck on a single process with many processes.
+    H5Pset_coll_metadata_write(fileAccess, true);
+    H5Pset_all_coll_metadata_ops(fileAccess, true);
+    transfer = H5Pcreate(H5P_DATASET_XFER);
+    if (transfer == H5I_INVALID_HID || H5Pset_dxpl_mpio(transfer, H5FD_MPIO_COLLECTIVE) < 0)
+    {
+      return false;
+    }
+#ifndef H5_HAVE_PARALLEL_FILTERED_WRITES
+    if (this->Writer->GetCompressionLevel() != 0)
+    {
+      vtkWarningWithObjectMacro(this->Writer,
+        << "HDF5 does not support compression with collective writes, writing uncompressed data.");
+    }
+#endif
+#else
+    vtkErrorWithObjectMacro(this->Writer,
+      << "HDF5 has no MPI-IO support, cannot create " << filename << " collectively.");
+    return false;
+#endif
+  }
+
   vtkHDF::ScopedH5FHandle file{ H5Fcreate(
-    filename.c_str(), overwrite ? H5F_ACC_TRUNC : H5F_ACC_EXCL, H5P_DEFAULT, H5P_DEFAULT) };
+    filename.c_str(), overwrite ? H5F_ACC_TRUNC : H5F_ACC_EXCL, H5P_DEFAULT, fileAccess) };
   if (file == H5I_INVALID_HID)
   {
     return false;
   }
+  this->Collective = collective;
+  this->TransferProperties = std::move(transfer);
 
   // Create the root group
   vtkHDF::ScopedH5GHandle root = this->CreateHdfGroupWithLinkOrder(file, "VTKHDF");
@@ -153,6 +220,90 @@ void vtkHDFWriter::Implementation::CloseFile()
   this->StepsGroup = H5I_INVALID_HID;
   this->Root = H5I_INVALID_HID;
   this->File = H5I_INVALID_HID;
+  this->TransferProperties = H5I_INVALID_HID;
+  this->Collective = false;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::IsCollectiveIOAvailable()
+{
+#if VTK_HDF_WRITER_MPIIO
+  return ::GetMPICommunicator(this->Writer->GetController()) != MPI_COMM_NULL;
+#else
+  return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+hid_t vtkHDFWriter::Implementation::GetTransferProperties()
+{
+  return this->Collective ? static_cast<hid_t>(this->TransferProperties) : H5P_DEFAULT;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::SelectCollectiveRows(
+  hid_t dataset, hsize_t localRows, hsize_t numCols, vtkHDF::ScopedH5SHandle& fileSpace)
+{
+#if VTK_HDF_WRITER_MPIIO
+  MPI_Comm communicator = ::GetMPICommunicator(this->Writer->GetController());
+  unsigned long long rows = localRows;
+  unsigned long long offset = 0;
+  unsigned long long total = 0;
+  MPI_Exscan(&rows, &offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+  MPI_Allreduce(&rows, &total, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+  int rank = 0;
+  MPI_Comm_rank(communicator, &rank);
+  if (rank == 0)
+  {
+    // The result of the exclusive scan is undefined on the first process
+    offset = 0;
+  }
+
+  vtkHDF::ScopedH5SHandle currentSpace = H5Dget_space(dataset);
+  if (currentSpace == H5I_INVALID_HID)
+  {
+    return false;
+  }
+  const int numDims = H5Sget_simple_extent_ndims(currentSpace);
+  if (numDims < 1 || numDims > 2 || (numDims == 1 && numCols != 1))
+  {
+    return false;
+  }
+  hsize_t dims[2] = { 0, numCols };
+  H5Sget_simple_extent_dims(currentSpace, dims, nullptr);
+  if (numDims == 2 && dims[1] != numCols)
+  {
+    return false; // Number of components don't match
+  }
+  const hsize_t firstRow = dims[0];
+  if (total > 0)
+  {
+    // Collective operation: all processes extend the dataset the same way
+    dims[0] += total;
+    if (H5Dset_extent(dataset, dims) < 0)
+    {
+      return false;
+    }
+  }
+  fileSpace = H5Dget_space(dataset);
+  if (fileSpace == H5I_INVALID_HID)
+  {
+    return false;
+  }
+  if (localRows == 0)
+  {
+    return H5Sselect_none(fileSpace) >= 0;
+  }
+  const hsize_t start[2] = { firstRow + offset, 0 };
+  const hsize_t count[2] = { localRows, numCols };
+  return H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, nullptr, count, nullptr) >= 0;
+#else
+  (void)dataset;
+  (void)localRows;
+  (void)numCols;
+  (void)fileSpace;
+  return false;
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -393,18 +544,26 @@ vtkHDF::ScopedH5DHandle vtkHDFWriter::Implementation::CreateChunkedHdfDataset(hi
     return H5I_INVALID_HID;
   }
   H5Pset_layout(plist, H5D_CHUNKED);
+  hsize_t chunk[] = { this->GetChunkRows(chunkSize[0], type, numCols), numCols > 1 ? chunkSize[1]
+                                                                                   : 1 };
   if (numCols == 1)
   {
-    H5Pset_chunk(plist, 1, chunkSize);
+    H5Pset_chunk(plist, 1, chunk);
   }
   else
   {
-    H5Pset_chunk(plist, 2, chunkSize); // 2-Dimensional
+    H5Pset_chunk(plist, 2, chunk); // 2-Dimensional
   }
 
-  if (compressionLevel != 0)
+#ifndef H5_HAVE_PARALLEL_FILTERED_WRITES
+  if (this->Collective)
+  {
+    compressionLevel = 0;
+  }
+#endif
+  if (compressionLevel != 0 && !this->SetCompressionFilter(plist, compressionLevel))
   {
-    H5Pset_deflate(plist, compressionLevel);
+    return H5I_INVALID_HID;
   }
 
   vtkHDF::ScopedH5DHandle dset =
@@ -428,8 +587,8 @@ vtkHDF::ScopedH5SHandle vtkHDFWriter::Implementation::CreateDataspaceFromArray(
 }
 
 //------------------------------------------------------------------------------
-vtkHDF::ScopedH5DHandle vtkHDFWriter::Implementation::CreateDatasetFromDataArray(
-  hid_t group, const char* name, hid_t type, vtkAbstractArray* dataArray)
+vtkHDF::ScopedH5DHandle vtkHDFWriter::Implementation::CreateDatasetFromDataArray(hid_t group,
+  const char* name, hid_t type, vtkAbstractArray* dataArray, int compressionLevel)
 {
   // Create dataspace from array
   vtkHDF::ScopedH5SHandle dataspace = CreateDataspaceFromArray(dataArray);
@@ -437,8 +596,23 @@ vtkHDF::ScopedH5DHandle vtkHDFWriter::Implementation::CreateDatasetFromDataArray
   {
     return H5I_INVALID_HID;
   }
-  // Create dataset from dataspace and other arguments
-  vtkHDF::ScopedH5DHandle dataset = this->CreateHdfDataset(group, name, type, dataspace);
+  // Create dataset from dataspace and other arguments. Compression filters
+  // require a chunked layout, which cannot be used for empty datasets.
+  vtkHDF::ScopedH5DHandle dataset;
+  const hsize_t nTuples = static_cast<hsize_t>(dataArray->GetNumberOfTuples());
+  if (compressionLevel != 0 && nTuples > 0)
+  {
+    const hsize_t nComp = static_cast<hsize_t>(dataArray->GetNumberOfComponents());
+    hsize_t chunkSize[] = { static_cast<hsize_t>(this->Writer->GetChunkSize()), nComp };
+    // A chunk may not be larger than a fixed size dataset
+    chunkSize[0] = std::min(this->GetChunkRows(chunkSize[0], type, nComp), nTuples);
+    dataset = this->CreateChunkedHdfDataset(
+      group, name, type, dataspace, nComp, chunkSize, compressionLevel);
+  }
+  else
+  {
+    dataset = this->CreateHdfDataset(group, name, type, dataspace);
+  }
   if (dataset == H5I_INVALID_HID)
   {
     return H5I_INVALID_HID;
@@ -511,6 +685,16 @@ bool vtkHDFWriter::Implementation::AddSingleValueToDataset(
     return false;
   }
 
+  if (this->Collective)
+  {
+    // Each process appends its value after those of the processes of lower rank.
+    // Offsets and trimming are only used by temporal datasets, not written collectively.
+    vtkHDF::ScopedH5SHandle fileSpace;
+    return this->SelectCollectiveRows(dataset, 1, 1, fileSpace) &&
+      H5Dwrite(dataset, H5T_NATIVE_INT, newDataspace, fileSpace, this->GetTransferProperties(),
+        &value) >= 0;
+  }
+
   // Recover dataset and dataspace
   vtkHDF::ScopedH5SHandle currentDataspace = H5Dget_space(dataset);
   if (currentDataspace == H5I_INVALID_HID)
@@ -659,6 +843,17 @@ bool vtkHDFWriter::Implementation::AddOrCreateSingleValueDataset(
 
   if (!H5Lexists(group, name, H5P_DEFAULT))
   {
+    if (this->Collective)
+    {
+      // The values of all processes are appended to an empty dataset
+      hsize_t chunkSize[] = { 1, 1 };
+      if (!this->InitDynamicDataset(group, name, H5T_STD_I64LE, 1, chunkSize))
+      {
+        return false;
+      }
+      vtkHDF::ScopedH5DHandle dataset = H5Dopen(group, name, H5P_DEFAULT);
+      return dataset != H5I_INVALID_HID && this->AddSingleValueToDataset(dataset, value, false);
+    }
     // Dataset needs to be created
     return this->CreateSingleValueDataset(group, name, value) != H5I_INVALID_HID;
   }
@@ -715,6 +910,38 @@ bool vtkHDFWriter::Implementation::AddArrayToDataset(
     return false;
   }
 
+  if (this->Collective)
+  {
+    // Every process takes part in the write, even with no tuple to append
+    const hsize_t nTuples = static_cast<hsize_t>(dataArray->GetNumberOfTuples());
+    const hsize_t nComp = static_cast<hsize_t>(dataArray->GetNumberOfComponents());
+    vtkHDF::ScopedH5SHandle fileSpace;
+    if (!this->SelectCollectiveRows(dataset, nTuples, nComp, fileSpace))
+    {
+      return false;
+    }
+    const hsize_t memDims[2] = { nTuples, nComp };
+    vtkHDF::ScopedH5SHandle memSpace = H5Screate_simple(nComp == 1 ? 1 : 2, memDims, nullptr);
+    hid_t sourceType = vtkHDFUtilities::getH5TypeFromVtkType(dataArray->GetDataType());
+    if (memSpace == H5I_INVALID_HID || sourceType == H5I_INVALID_HID)
+    {
+      return false;
+    }
+    unsigned char empty = 0;
+    void* data = &empty;
+    if (nTuples > 0)
+    {
+      data = dataArray->GetVoidPointer(0);
+    }
+    else
+    {
+      H5Sselect_none(memSpace);
+    }
+    const herr_t status =
+      H5Dwrite(dataset, sourceType, memSpace, fileSpace, this->GetTransferProperties(), data);
+    return status >= 0;
+  }
+
   // Get raw array data
   void* rawArrayData = dataArray->GetVoidPointer(0);
   if (rawArrayData == nullptr)
@@ -854,8 +1081,23 @@ bool vtkHDFWriter::Implementation::AddOrCreateDataset(
 
   if (!H5Lexists(group, name, H5P_DEFAULT))
   {
+    if (this->Collective)
+    {
+      // The arrays of all processes are appended to an empty dataset
+      const int nComp = dataArray->GetNumberOfComponents();
+      hsize_t chunkSize[] = { static_cast<hsize_t>(this->Writer->GetChunkSize()),
+        static_cast<hsize_t>(nComp) };
+      if (!this->InitDynamicDataset(
+            group, name, type, nComp, chunkSize, this->Writer->GetCompressionLevel()))
+      {
+        return false;
+      }
+      vtkHDF::ScopedH5DHandle dataset = H5Dopen(group, name, H5P_DEFAULT);
+      return dataset != H5I_INVALID_HID && this->AddArrayToDataset(dataset, dataArray);
+    }
     // Dataset needs to be created
-    return this->CreateDatasetFromDataArray(group, name, type, dataArray) != H5I_INVALID_HID;
+    return this->CreateDatasetFromDataArray(
+             group, name, type, dataArray, this->Writer->GetCompressionLevel()) != H5I_INVALID_HID;
   }
   else
   {
@@ -1339,6 +1581,54 @@ bool vtkHDFWriter::Implementation::InitDynamicDataset(hid_t group, const char* n
   return dataset != H5I_INVALID_HID;
 }
 
+//------------------------------------------------------------------------------
+hsize_t vtkHDFWriter::Implementation::GetChunkRows(hsize_t chunkRows, hid_t type, hsize_t numCols)
+{
+  if (chunkRows > 0)
+  {
+    return chunkRows;
+  }
+  constexpr hsize_t targetChunkBytes = 1024 * 1024;
+  const hsize_t rowBytes = std::max<hsize_t>(H5Tget_size(type), 1) * std::max<hsize_t>(numCols, 1);
+  return std::max<hsize_t>(targetChunkBytes / rowBytes, 1);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::SetCompressionFilter(hid_t plist, int compressionLevel)
+{
+  // Registered identifiers of the HDF5 zstd and blosc filter plugins
+  constexpr H5Z_filter_t ZSTD_FILTER = 32015;
+  constexpr H5Z_filter_t BLOSC_FILTER = 32001;
+
+  const int filter = this->Writer->GetCompressionFilter();
+  if (filter != vtkHDFWriter::DEFLATE)
+  {
+    const H5Z_filter_t filterId = filter == vtkHDFWriter::ZSTD ? ZSTD_FILTER : BLOSC_FILTER;
+    if (H5Zfilter_avail(filterId) > 0)
+    {
+      if (filter == vtkHDFWriter::ZSTD)
+      {
+        // Spread the levels 1..9 over the zstd levels 1..19
+        const unsigned int cdValues[] = { static_cast<unsigned int>(
+          1 + ((compressionLevel - 1) * 18 + 4) / 8) };
+        return H5Pset_filter(plist, filterId, H5Z_FLAG_OPTIONAL, 1, cdValues) >= 0;
+      }
+      // The first four values are set by the filter, then level, shuffle and compressor (zstd)
+      const unsigned int cdValues[] = { 0, 0, 0, 0, static_cast<unsigned int>(compressionLevel), 1,
+        5 };
+      return H5Pset_filter(plist, filterId, H5Z_FLAG_OPTIONAL, 7, cdValues) >= 0;
+    }
+    if (!this->CompressionFilterFallbackReported)
+    {
+      vtkWarningWithObjectMacro(this->Writer,
+        << "The " << (filter == vtkHDFWriter::ZSTD ? "zstd" : "blosc")
+        << " HDF5 filter is not available, using deflate instead.");
+      this->CompressionFilterFallbackReported = true;
+    }
+  }
+  return H5Pset_deflate(plist, compressionLevel) >= 0;
+}
+
 //------------------------------------------------------------------------------
 vtkHDFWriter::Implementation::Implementation(vtkHDFWriter* writer)
   : Writer(writer)
@@ -40,10 +40,24 @@ public:
    * Create the file from the filename and create the root VTKHDF group.
    * This file is closed on object destruction.
    * Overwrite the file if it exists by default
+   * When `collective` is true, all the processes of the writer controller create the same file
+   * using the MPI-IO driver of HDF5, and data appended to datasets is written collectively, each
+   * process after the ones of lower rank. See `IsCollectiveIOAvailable`.
    * Returns true if the operation was successful
    * If the operation fails, the file may have been created
    */
-  bool CreateFile(bool overwrite, const std::string& filename);
+  bool CreateFile(bool overwrite, const std::string& filename, bool collective = false);
+
+  /**
+   * Return true when the HDF5 library supports MPI-IO and the controller of the writer
+   * is a MPI controller, so that files can be created with `collective` set.
+   */
+  bool IsCollectiveIOAvailable();
+
+  /**
+   * Return true when the current file is written collectively by all processes.
+   */
+  bool GetCollective() { return this->Collective; }
 
   /**
    * Open existing VTKHDF file and set Root and File members.
@@ -217,10 +231,12 @@ public:
 
   /**
    * Creates a dataset in the given group from a dataArray and write data to it
+   * When `compressionLevel` is not 0, the dataset is chunked and compressed with the
+   * compression filter of the writer.
    * Returned scoped handle may be invalid
    */
-  vtkHDF::ScopedH5DHandle CreateDatasetFromDataArray(
-    hid_t group, const char* name, hid_t type, vtkAbstractArray* dataArray);
+  vtkHDF::ScopedH5DHandle CreateDatasetFromDataArray(hid_t group, const char* name, hid_t type,
+    vtkAbstractArray* dataArray, int compressionLevel = 0);
 
   ///@{
   /**
@@ -302,6 +318,9 @@ private:
   std::vector<std::string> SubfileNames;
   std::string HdfType;
   bool SubFilesReady = false;
+  bool CompressionFilterFallbackReported = false;
+  bool Collective = false;
+  vtkHDF::ScopedH5PHandle TransferProperties;
 
   const std::array<std::string, 4> PrimitiveNames = { { "Vertices", "Lines", "Polygons",
     "Strips" } };
@@ -355,6 +374,37 @@ private:
    * to interleave virtual mappings.
    */
   IndexingMode GetDatasetIndexationMode(hid_t group, const char* name);
+
+  /**
+   * Return the number of rows of the chunks of a dataset of `numCols` columns of `type`.
+   * An automatic chunk size (0) yields chunks of about 1 MiB, the size of the default HDF5
+   * chunk cache.
+   */
+  hsize_t GetChunkRows(hsize_t chunkRows, hid_t type, hsize_t numCols);
+
+  /**
+   * Add the compression filter of the writer to the dataset creation property list `plist`.
+   * Fall back to deflate when the filter is not available in the HDF5 library.
+   */
+  bool SetCompressionFilter(hid_t plist, int compressionLevel);
+
+  /**
+   * Return the dataset transfer property list to use when writing data: collective
+   * MPI-IO transfers when the file is written collectively, default ones otherwise.
+   */
+  hid_t GetTransferProperties();
+
+  /**
+   * Select the rows of the current process when all processes append `localRows` rows
+   * of `numCols` columns to `dataset` collectively. The dataset is extended by the rows of all
+   * processes and `fileSpace` is set to the extended dataspace with the rows of the current process
+   * selected, after those of the processes of lower rank. Rows are counted once per process
+   * with an exclusive scan, as the current number of rows of the dataset is the same for all
+   * processes.
+   * Return false on failure, in which case all processes fail.
+   */
+  bool SelectCollectiveRows(
+    hid_t dataset, hsize_t localRows, hsize_t numCols, vtkHDF::ScopedH5SHandle& fileSpace);
 };
 
 VTK_ABI_NAMESPACE_END
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+#include "vtkTesting.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridReader.h"
+#include "vtkUnstructuredGridWriter.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+bool CompareCells(vtkCellArray* expected, vtkCellArray* actual, const char* name)
+{
+  if (!actual || expected->GetNumberOfCells() != actual->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of " << name << std::endl;
+    return false;
+  }
+  vtkNew<vtkIdList> expectedIds;
+  vtkNew<vtkIdList> actualIds;
+  for (vtkIdType cellId = 0; cellId < expected->GetNumberOfCells(); ++cellId)
+  {
+    expected->GetCellAtId(cellId, expectedIds);
+    actual->GetCellAtId(cellId, actualIds);
+    if (expectedIds->GetNumberOfIds() != actualIds->GetNumberOfIds())
+    {
+      std::cerr << "Wrong size for " << name << " " << cellId << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < expectedIds->GetNumberOfIds(); ++i)
+    {
+      if (expectedIds->GetId(i) != actualIds->GetId(i))
+      {
+        std::cerr << "Wrong point id for " << name << " " << cellId << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void AddPoints(vtkPoints* points)
+{
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(0, 1, 0);
+  points->InsertNextPoint(1, 1, 0);
+  points->InsertNextPoint(0, 0, 1);
+}
+
+int TestUnstructuredGrid(const std::string& filename, int fileType)
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  vtkNew<vtkPoints> points;
+  ::AddPoints(points);
+  grid->SetPoints(points);
+  const vtkIdType tri[3] = { 0, 1, 2 };
+  const vtkIdType quad[4] = { 0, 1, 3, 2 };
+  const vtkIdType tetra[4] = { 0, 1, 2, 4 };
+  grid->InsertNextCell(VTK_TRIANGLE, 3, tri);
+  grid->InsertNextCell(VTK_QUAD, 4, quad);
+  grid->InsertNextCell(VTK_TETRA, 4, tetra);
+
+  vtkNew<vtkUnstructuredGridWriter> writer;
+  writer->SetFileVersion(42);
+  writer->SetFileType(fileType);
+  writer->SetFileName(filename.c_str());
+  writer->SetInputData(grid);
+  writer->Write();
+
+  vtkNew<vtkUnstructuredGridReader> reader;
+  reader->SetFileName(filename.c_str());
+  reader->Update();
+  vtkUnstructuredGrid* output = reader->GetOutput();
+  if (!::CompareCells(grid->GetCells(), output->GetCells(), "cell"))
+  {
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    if (grid->GetCellType(cellId) != output->GetCellType(cellId))
+    {
+      std::cerr << "Wrong type for cell " << cellId << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestPolyData(const std::string& filename, int fileType)
+{
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkPoints> points;
+  ::AddPoints(points);
+  polyData->SetPoints(points);
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell({ 4 });
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell({ 0, 4 });
+  lines->InsertNextCell({ 1, 2, 3 });
+  vtkNew<vtkCellArray> polys;
+  polys->InsertNextCell({ 0, 1, 2 });
+  polys->InsertNextCell({ 1, 3, 2 });
+  polyData->SetVerts(verts);
+  polyData->SetLines(lines);
+  polyData->SetPolys(polys);
+
+  vtkNew<vtkPolyDataWriter> writer;
+  writer->SetFileVersion(42);
+  writer->SetFileType(fileType);
+  writer->SetFileName(filename.c_str());
+  writer->SetInputData(polyData);
+  writer->Write();
+
+  vtkNew<vtkPolyDataReader> reader;
+  reader->SetFileName(filename.c_str());
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+  if (!::CompareCells(verts, output->GetVerts(), "vertex") ||
+    !::CompareCells(lines, output->GetLines(), "line") ||
+    !::CompareCells(polys, output->GetPolys(), "polygon"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestLegacyCellsReadWriteVersion42(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string tempDir = testing->GetTempDirectory();
+
+  int res = EXIT_SUCCESS;
+  for (int fileType : { VTK_ASCII, VTK_BINARY })
+  {
+    const std::string suffix = fileType == VTK_ASCII ? "_ascii.vtk" : "_binary.vtk";
+    res |= ::TestUnstructuredGrid(tempDir + "/legacy_cells_ug" + suffix, fileType);
+    res |= ::TestPolyData(tempDir + "/legacy_cells_pd" + suffix, fileType);
+  }
+  return res;
+}
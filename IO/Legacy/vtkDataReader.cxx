@@ -3,6 +3,7 @@
 
 #include "vtkDataReader.h"
 
+#include "vtkASCIIArrayParser.h"
 #include "vtkBitArray.h"
 #include "vtkByteSwap.h"
 #include "vtkCellArray.h"
@@ -30,6 +31,7 @@
 #include "vtkLegacyReaderVersion.h"
 #include "vtkLongArray.h"
 #include "vtkLookupTable.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
@@ -1510,12 +1512,68 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
   return 1;
 }
 
+// ASCII arrays with at least this many values are parsed with multiple threads.
+static constexpr vtkIdType vtkBulkASCIIDataThreshold = 1 << 16;
+
+// Read the text of numValues values at once and parse it with multiple
+// threads. Returns 0, with the stream put back where it was, when the text
+// cannot be parsed that way, so that the stream extraction is used instead.
+template <class T>
+int vtkReadASCIIDataInBulk(istream* IS, T* data, vtkIdType numValues)
+{
+  const std::streampos start = IS->tellg();
+  if (start == std::streampos(-1))
+  {
+    return 0;
+  }
+
+  std::vector<char> text;
+  std::size_t blockSize = static_cast<std::size_t>(numValues) * 16;
+  while (true)
+  {
+    const std::size_t oldSize = text.size();
+    text.resize(oldSize + blockSize);
+    IS->read(text.data() + oldSize, static_cast<std::streamsize>(blockSize));
+    text.resize(oldSize + static_cast<std::size_t>(IS->gcount()));
+    const bool atEnd = !IS->good();
+
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    const char* parsedEnd = nullptr;
+    const vtkIdType numParsed = vtkASCIIArrayParser::Parse(begin, end, numValues, data, &parsedEnd);
+    // The last word parsed may be cut by the end of the text read so far
+    const bool complete = numParsed == numValues && (parsedEnd != end || atEnd);
+    if (complete)
+    {
+      IS->clear();
+      IS->seekg(start + static_cast<std::streamoff>(parsedEnd - begin));
+      return 1;
+    }
+    if (atEnd || vtkASCIIArrayParser::CountWords(begin, end) > numParsed)
+    {
+      // Missing values or a word the parser does not support
+      break;
+    }
+    blockSize = text.size();
+  }
+
+  IS->clear();
+  IS->seekg(start);
+  return 0;
+}
+
 // General templated function to read data of various types.
 template <class T>
 int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
 {
   vtkIdType i, j;
 
+  if (numTuples * numComp >= vtkBulkASCIIDataThreshold &&
+    vtkReadASCIIDataInBulk(self->GetIStream(), data, numTuples * numComp))
+  {
+    return 1;
+  }
+
   for (i = 0; i < numTuples; i++)
   {
     for (j = 0; j < numComp; j++)
@@ -3162,7 +3220,6 @@ int vtkDataReader::ReadCells(vtkSmartPointer<vtkCellArray>& cellArray)
 int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
 {
   char line[256];
-  int i;
 
   if (this->FileType == VTK_BINARY)
   {
@@ -3180,15 +3237,12 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
   }
   else // ascii
   {
-    for (i = 0; i < size; i++)
+    if (!vtkReadASCIIData(this, data, size, 1))
     {
-      if (!this->Read(data + i))
-      {
-        const char* fname = this->CurrentFileName.c_str();
-        vtkErrorMacro(<< "Error reading ascii cell data!"
-                      << " for file: " << (fname ? fname : "(Null FileName)"));
-        return 0;
-      }
+      const char* fname = this->CurrentFileName.c_str();
+      vtkErrorMacro(<< "Error reading ascii cell data!"
+                    << " for file: " << (fname ? fname : "(Null FileName)"));
+      return 0;
     }
   }
 
@@ -3311,6 +3365,59 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data, int skip1, int rea
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkDataReader::ReadCellsLegacy(
+  vtkIdType numCells, vtkIdType size, vtkSmartPointer<vtkCellArray>& cellArray)
+{
+  if (numCells < 0 || size < numCells)
+  {
+    vtkErrorMacro(<< "Invalid legacy cell array size: " << numCells << " cells in " << size
+                  << " values for file: " << this->CurrentFileName);
+    return 0;
+  }
+
+  std::vector<int> data(static_cast<std::size_t>(size));
+  if (!this->ReadCellsLegacy(size, data.data()))
+  {
+    return 0;
+  }
+
+  // Split the (npts, id0, id1, ...) records in offsets and connectivity in a
+  // single pass.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(size - numCells);
+  vtkIdType* offsetPtr = offsets->GetPointer(0);
+  vtkIdType* connPtr = connectivity->GetPointer(0);
+  const int* input = data.data();
+  const int* inputEnd = input + size;
+  offsetPtr[0] = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    const int numCellPts = *input++;
+    if (numCellPts < 0 || numCellPts > inputEnd - input)
+    {
+      vtkErrorMacro(<< "Invalid number of points for cell " << cellId
+                    << " for file: " << this->CurrentFileName);
+      return 0;
+    }
+    connPtr = std::copy(input, input + numCellPts, connPtr);
+    input += numCellPts;
+    offsetPtr[cellId + 1] = offsetPtr[cellId] + numCellPts;
+  }
+  if (input != inputEnd)
+  {
+    vtkWarningMacro(<< "Ignoring " << (inputEnd - input) << " values after the last cell"
+                    << " for file: " << this->CurrentFileName);
+    connectivity->SetNumberOfValues(offsetPtr[numCells]);
+  }
+
+  cellArray = vtkSmartPointer<vtkCellArray>::New();
+  cellArray->SetData(offsets, connectivity);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkDataReader::ConvertGhostLevelsToGhostType(FieldType fieldType, vtkAbstractArray* data) const
 {
@@ -403,6 +403,16 @@ public:
    */
   int ReadCellsLegacy(vtkIdType size, int* data, int skip1, int read2, int skip3);
 
+  /**
+   * Read `numCells` cells stored in `size` ints in the legacy format in a new
+   * vtkCellArray, and update the smartpointer reference passed in. The offsets
+   * and connectivity of the cell array are filled directly from the values read,
+   * without going through the legacy import of vtkCellArray. Return 0 if error.
+   * @note Legacy implementation for file versions < 5.0.
+   */
+  int ReadCellsLegacy(
+    vtkIdType numCells, vtkIdType size, vtkSmartPointer<vtkCellArray>& cellArray);
+
   /**
    * Read the coordinates for a rectilinear grid. The axes parameter specifies
    * which coordinate axes (0,1,2) is being read.
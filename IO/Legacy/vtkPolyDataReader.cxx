@@ -60,24 +60,11 @@ int vtkPolyDataReader::ReadMeshSimple(const std::string& fname, vtkDataObject* d
         return false;
       }
 
-      std::size_t connSize = static_cast<std::size_t>(size);
-      std::vector<int> tempArray(connSize);
-      std::vector<vtkIdType> idArray(connSize);
-
-      if (!this->ReadCellsLegacy(size, tempArray.data()))
+      if (!this->ReadCellsLegacy(ncells, size, cellArray))
       {
         this->CloseVTKFile();
         return false;
       }
-
-      // Convert to id type
-      for (std::size_t connIdx = 0; connIdx < connSize; connIdx++)
-      {
-        idArray[connIdx] = static_cast<vtkIdType>(tempArray[connIdx]);
-      }
-
-      cellArray = vtkSmartPointer<vtkCellArray>::New();
-      cellArray->ImportLegacyFormat(idArray.data(), size);
       return true;
     } // end legacy cell read
   };
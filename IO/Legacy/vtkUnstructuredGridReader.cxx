@@ -148,30 +148,16 @@ int vtkUnstructuredGridReader::ReadMeshSimple(const std::string& fname, vtkDataO
             return 1;
           }
 
-          // the number of ints to read before we get to the piece.
-          skip1 = piece * ncells / numPieces;
-          // the number of ints to read as part of piece.
-          read2 = ((piece + 1) * ncells / numPieces) - skip1;
-          // the number of ints after the piece
-          skip3 = ncells - skip1 - read2;
-
-          const std::size_t connSize = static_cast<std::size_t>(size);
-          std::vector<int> tempArray(connSize);
-          std::vector<vtkIdType> idArray(static_cast<std::size_t>(size));
-
-          if (!this->ReadCellsLegacy(size, tempArray.data(), skip1, read2, skip3))
+          // the whole file is read as a single piece
+          vtkSmartPointer<vtkCellArray> tmpCells;
+          if (!this->ReadCellsLegacy(ncells, size, tmpCells))
           {
             this->CloseVTKFile();
             return 1;
           }
 
-          for (std::size_t connIdx = 0; connIdx < connSize; connIdx++)
-          {
-            idArray[connIdx] = static_cast<vtkIdType>(tempArray[connIdx]);
-          }
-
-          cells = vtkCellArray::New();
-          cells->ImportLegacyFormat(idArray.data(), size);
+          cells = tmpCells;
+          cells->Register(nullptr);
         }
 
         // Update the dataset
@@ -76,6 +76,7 @@ vtkXMLWriterBase* vtkXMLCompositeDataSetWriterHelper::GetWriter(int dataType)
     writer->SetByteOrder(this->Writer->GetByteOrder());
     writer->SetCompressor(this->Writer->GetCompressor());
     writer->SetBlockSize(this->Writer->GetBlockSize());
+    writer->SetOverlapCompressionAndWrite(this->Writer->GetOverlapCompressionAndWrite());
     writer->SetDataMode(this->Writer->GetDataMode());
     writer->SetEncodeAppendedData(this->Writer->GetEncodeAppendedData());
     writer->SetHeaderType(this->Writer->GetHeaderType());
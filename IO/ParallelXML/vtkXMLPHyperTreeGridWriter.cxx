@@ -113,6 +113,7 @@ int vtkXMLPHyperTreeGridWriter::WritePiece(int index)
   pWriter->SetEncodeAppendedData(this->EncodeAppendedData);
   pWriter->SetHeaderType(this->HeaderType);
   pWriter->SetBlockSize(this->BlockSize);
+  pWriter->SetOverlapCompressionAndWrite(this->OverlapCompressionAndWrite);
   pWriter->SetWriteTimeValue(this->GetWriteTimeValue());
 
   // Write the piece.
@@ -111,6 +111,7 @@ int vtkXMLPTableWriter::WritePiece(int index)
   pWriter->SetEncodeAppendedData(this->EncodeAppendedData);
   pWriter->SetHeaderType(this->HeaderType);
   pWriter->SetBlockSize(this->BlockSize);
+  pWriter->SetOverlapCompressionAndWrite(this->OverlapCompressionAndWrite);
   pWriter->SetWriteTimeValue(this->GetWriteTimeValue());
 
   // Write the piece.
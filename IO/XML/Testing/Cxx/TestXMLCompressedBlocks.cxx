@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Read arrays compressed in many small blocks, entirely and partially, with
+// every compressor and data mode to exercise the parallel decompression.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkStructuredData.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+
+namespace
+{
+double Value(int i, int j, int k)
+{
+  return i + 100.0 * j + 10000.0 * k;
+}
+
+bool CheckImage(vtkImageData* image, const int extent[6])
+{
+  int actualExtent[6];
+  image->GetExtent(actualExtent);
+  vtkDataArray* scalars = image->GetPointData()->GetArray("Scalars");
+  if (!scalars)
+  {
+    std::cerr << "Missing array Scalars" << std::endl;
+    return false;
+  }
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        int ijk[3] = { i, j, k };
+        vtkIdType id = vtkStructuredData::ComputePointIdForExtent(actualExtent, ijk);
+        if (scalars->GetComponent(id, 0) != ::Value(i, j, k))
+        {
+          std::cerr << "Wrong value at " << i << ", " << j << ", " << k << ": "
+                    << scalars->GetComponent(id, 0) << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool TestFile(vtkImageData* image, const std::string& fileName, int compressor, bool appended)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetCompressorType(compressor);
+  writer->SetBlockSize(1000);
+  if (appended)
+  {
+    writer->SetDataModeToAppended();
+    writer->EncodeAppendedDataOff();
+  }
+  else
+  {
+    writer->SetDataModeToBinary();
+  }
+  if (!writer->Write())
+  {
+    std::cerr << "Could not write " << fileName << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  if (!::CheckImage(reader->GetOutput(), image->GetExtent()))
+  {
+    std::cerr << "Reading the whole extent of " << fileName << " failed" << std::endl;
+    return false;
+  }
+
+  // Partial rows and slices start and end in the middle of blocks.
+  const int subExtent[6] = { 5, 30, 3, 20, 2, 15 };
+  // the reader hides vtkAlgorithm::UpdateExtent with a member
+  vtkAlgorithm* algorithm = reader;
+  algorithm->UpdateExtent(subExtent);
+  if (!::CheckImage(reader->GetOutput(), subExtent))
+  {
+    std::cerr << "Reading a sub extent of " << fileName << " failed" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestXMLCompressedBlocks(int argc, char* argv[])
+{
+  char* tempDirC =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string tempDir = tempDirC;
+  delete[] tempDirC;
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(40, 30, 20);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (int k = 0; k < 20; ++k)
+  {
+    for (int j = 0; j < 30; ++j)
+    {
+      for (int i = 0; i < 40; ++i)
+      {
+        int ijk[3] = { i, j, k };
+        scalars->SetValue(image->ComputePointId(ijk), ::Value(i, j, k));
+      }
+    }
+  }
+  image->GetPointData()->AddArray(scalars);
+
+  const int compressors[] = { vtkXMLWriterBase::ZLIB, vtkXMLWriterBase::LZ4,
+    vtkXMLWriterBase::LZMA };
+  bool success = true;
+  for (int compressor : compressors)
+  {
+    for (bool appended : { true, false })
+    {
+      std::string fileName = tempDir + "/TestXMLCompressedBlocks" + std::to_string(compressor) +
+        (appended ? "Appended" : "Binary") + ".vti";
+      success &= ::TestFile(image, fileName, compressor, appended);
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
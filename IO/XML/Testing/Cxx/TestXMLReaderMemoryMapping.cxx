@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+bool CompareArrays(vtkDataArray* expected, vtkDataArray* actual)
+{
+  if (!actual || actual->GetNumberOfValues() != expected->GetNumberOfValues() ||
+    actual->GetDataType() != expected->GetDataType())
+  {
+    std::cerr << "Array " << expected->GetName() << " was not read correctly" << std::endl;
+    return false;
+  }
+  auto expectedRange = vtk::DataArrayValueRange(expected);
+  auto actualRange = vtk::DataArrayValueRange(actual);
+  if (!std::equal(expectedRange.begin(), expectedRange.end(), actualRange.begin()))
+  {
+    std::cerr << "Wrong values in array " << expected->GetName() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool IsMapped(vtkDataArray* array)
+{
+  auto doubles = vtkDoubleArray::SafeDownCast(array);
+  auto floats = vtkFloatArray::SafeDownCast(array);
+  return (doubles && doubles->IsFileMapped()) || (floats && floats->IsFileMapped());
+}
+
+bool TestFile(vtkImageData* image, const std::string& fileName, bool compressed)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->AlignAppendedDataOn();
+  if (compressed)
+  {
+    writer->SetCompressorTypeToZLib();
+  }
+  else
+  {
+    writer->SetCompressorTypeToNone();
+  }
+  writer->Write();
+
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UseMemoryMappingOn();
+  reader->Update();
+  vtkPointData* pd = reader->GetOutput()->GetPointData();
+
+  bool success = true;
+  for (const char* name : { "Scalars", "Vectors" })
+  {
+    vtkDataArray* read = pd->GetArray(name);
+    success &= ::CompareArrays(image->GetPointData()->GetArray(name), read);
+    if (read && ::IsMapped(read) == compressed)
+    {
+      std::cerr << "Array " << name << (compressed ? " should not" : " should")
+                << " be mapped from " << fileName << std::endl;
+      success = false;
+    }
+  }
+  return success;
+}
+}
+
+int TestXMLReaderMemoryMapping(int argc, char* argv[])
+{
+  char* tempDirC =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string tempDir = tempDirC;
+  delete[] tempDirC;
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(33, 17, 9);
+  const vtkIdType nPoints = image->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(nPoints);
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(nPoints);
+  for (vtkIdType i = 0; i < nPoints; ++i)
+  {
+    scalars->SetValue(i, 0.25 * i);
+    vectors->SetTuple3(i, i, -i, 0.5f * i);
+  }
+  image->GetPointData()->AddArray(scalars);
+  image->GetPointData()->AddArray(vectors);
+
+  bool success = ::TestFile(image, tempDir + "/TestXMLReaderMemoryMapping.vti", false);
+  success &= ::TestFile(image, tempDir + "/TestXMLReaderMemoryMappingCompressed.vti", true);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::string Write(vtkUnstructuredGrid* grid, bool align)
+{
+  vtkNew<vtkXMLUnstructuredGridWriter> writer;
+  writer->SetInputData(grid);
+  writer->WriteToOutputStringOn();
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorTypeToNone();
+  writer->SetHeaderTypeToUInt64();
+  writer->SetAlignAppendedData(align);
+  writer->Write();
+  return writer->GetOutputString();
+}
+
+// Check the position of every array of the raw appended data section. Without
+// alignment, the arrays must follow each other with no padding, as the writer
+// always did. With alignment, the values of every array must start on 8 bytes.
+bool CheckLayout(const std::string& content, bool aligned)
+{
+  const std::size_t section = content.find("<AppendedData encoding=\"raw\">");
+  if (section == std::string::npos)
+  {
+    std::cerr << "No raw appended data section" << std::endl;
+    return false;
+  }
+  const std::size_t start = content.find('_', section) + 1;
+
+  std::vector<vtkTypeUInt64> offsets;
+  std::size_t pos = content.find("offset=\"");
+  while (pos < section)
+  {
+    offsets.push_back(std::stoull(content.substr(pos + 8)));
+    pos = content.find("offset=\"", pos + 1);
+  }
+  if (offsets.size() < 4)
+  {
+    std::cerr << "Expected at least 4 appended arrays, got " << offsets.size() << std::endl;
+    return false;
+  }
+  std::sort(offsets.begin(), offsets.end());
+
+  vtkTypeUInt64 end = 0;
+  for (const vtkTypeUInt64 offset : offsets)
+  {
+    const vtkTypeUInt64 padding = offset - end;
+    if (offset < end || (!aligned && padding != 0) || (aligned && padding >= 8))
+    {
+      std::cerr << "Unexpected padding of " << padding << " bytes before the array at offset "
+                << offset << (aligned ? " with" : " without") << " alignment" << std::endl;
+      return false;
+    }
+    const std::size_t valuesPosition = start + offset + sizeof(vtkTypeUInt64);
+    if (aligned && valuesPosition % 8 != 0)
+    {
+      std::cerr << "The values of the array at offset " << offset << " are not aligned"
+                << std::endl;
+      return false;
+    }
+    vtkTypeUInt64 numberOfBytes;
+    std::memcpy(&numberOfBytes, content.data() + start + offset, sizeof(numberOfBytes));
+    end = offset + sizeof(vtkTypeUInt64) + numberOfBytes;
+  }
+  if (content.compare(start + end, 1, "\n") != 0)
+  {
+    std::cerr << "The appended data section does not end after the last array" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool CheckRead(const std::string& content, vtkUnstructuredGrid* expected)
+{
+  vtkNew<vtkXMLUnstructuredGridReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content);
+  reader->Update();
+  vtkUnstructuredGrid* output = reader->GetOutput();
+  vtkDataArray* scalars = output->GetPointData()->GetArray("Scalars");
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != expected->GetNumberOfCells() || !scalars)
+  {
+    std::cerr << "The grid was not read correctly" << std::endl;
+    return false;
+  }
+  const auto expectedRange =
+    vtk::DataArrayValueRange(expected->GetPointData()->GetArray("Scalars"));
+  const auto range = vtk::DataArrayValueRange(scalars);
+  if (range.size() != expectedRange.size() ||
+    !std::equal(expectedRange.begin(), expectedRange.end(), range.begin()))
+  {
+    std::cerr << "Wrong values read in the scalars" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestXMLWriterAlignAppendedData(int, char*[])
+{
+  // Odd numbers of points and cells make arrays whose sizes are not multiples
+  // of 8 bytes, so that aligning the next array requires padding.
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  const vtkIdType numberOfTetras = 5;
+  vtkNew<vtkCellArray> cells;
+  for (vtkIdType i = 0; i < numberOfTetras + 3; ++i)
+  {
+    points->InsertNextPoint(i, i % 2, i % 3);
+    scalars->InsertNextValue(0.5 * i);
+  }
+  for (vtkIdType i = 0; i < numberOfTetras; ++i)
+  {
+    const vtkIdType tetra[4] = { i, i + 1, i + 2, i + 3 };
+    cells->InsertNextCell(4, tetra);
+  }
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->SetCells(VTK_TETRA, cells);
+  grid->GetPointData()->AddArray(scalars);
+
+  const std::string unaligned = ::Write(grid, false);
+  const std::string aligned = ::Write(grid, true);
+  if (!::CheckLayout(unaligned, false) || !::CheckLayout(aligned, true) ||
+    !::CheckRead(unaligned, grid) || !::CheckRead(aligned, grid))
+  {
+    return EXIT_FAILURE;
+  }
+  if (aligned == unaligned)
+  {
+    std::cerr << "Aligning the appended data did not pad any array" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
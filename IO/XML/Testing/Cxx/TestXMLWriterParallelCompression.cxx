@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that overlapping the compression and the writing of binary data
+// blocks produces the same output, and that the output can be read back.
+
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+
+namespace
+{
+std::string Write(vtkImageData* image, int compressor, int dataMode, bool overlap)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->WriteToOutputStringOn();
+  writer->SetCompressorType(compressor);
+  writer->SetDataMode(dataMode);
+  writer->EncodeAppendedDataOff();
+  // Small blocks, so that an array is compressed in several batches.
+  writer->SetBlockSize(1024);
+  writer->SetOverlapCompressionAndWrite(overlap);
+  if (!writer->Write())
+  {
+    return std::string();
+  }
+  return writer->GetOutputString();
+}
+
+bool CheckRead(vtkImageData* image, const std::string& content)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content);
+  reader->Update();
+  for (const char* name : { "Doubles", "Ints" })
+  {
+    vtkDataArray* expected = image->GetPointData()->GetArray(name);
+    vtkDataArray* actual = reader->GetOutput()->GetPointData()->GetArray(name);
+    if (!actual || actual->GetNumberOfValues() != expected->GetNumberOfValues())
+    {
+      std::cerr << "Array " << name << " was not read back" << std::endl;
+      return false;
+    }
+    auto expectedRange = vtk::DataArrayValueRange(expected);
+    auto actualRange = vtk::DataArrayValueRange(actual);
+    if (!std::equal(expectedRange.begin(), expectedRange.end(), actualRange.begin()))
+    {
+      std::cerr << "Wrong values read back in array " << name << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLWriterParallelCompression(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(64, 64, 64);
+  const vtkIdType nPoints = image->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("Doubles");
+  doubles->SetNumberOfTuples(nPoints);
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("Ints");
+  ints->SetNumberOfComponents(2);
+  ints->SetNumberOfTuples(nPoints);
+  for (vtkIdType i = 0; i < nPoints; ++i)
+  {
+    doubles->SetValue(i, std::sin(1e-3 * i));
+    ints->SetTypedComponent(i, 0, static_cast<int>(i % 1000));
+    ints->SetTypedComponent(i, 1, static_cast<int>(i / 7));
+  }
+  image->GetPointData()->AddArray(doubles);
+  image->GetPointData()->AddArray(ints);
+
+  const int compressors[] = { vtkXMLWriterBase::ZLIB, vtkXMLWriterBase::LZ4 };
+  for (int compressor : compressors)
+  {
+    for (int dataMode : { vtkXMLWriterBase::Appended, vtkXMLWriterBase::Binary })
+    {
+      std::string serial = ::Write(image, compressor, dataMode, false);
+      std::string overlapped = ::Write(image, compressor, dataMode, true);
+      if (serial.empty() || serial != overlapped)
+      {
+        std::cerr << "Overlapped write differs for compressor " << compressor << " and data mode "
+                  << dataMode << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (!::CheckRead(image, serial))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
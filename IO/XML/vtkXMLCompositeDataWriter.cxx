@@ -474,6 +474,7 @@ void vtkXMLCompositeDataWriter::CreateWriters(vtkCompositeDataSet* hdInput)
       writer->SetByteOrder(this->GetByteOrder());
       writer->SetCompressor(this->GetCompressor());
       writer->SetBlockSize(this->GetBlockSize());
+      writer->SetOverlapCompressionAndWrite(this->GetOverlapCompressionAndWrite());
       writer->SetDataMode(this->GetDataMode());
       writer->SetEncodeAppendedData(this->GetEncodeAppendedData());
       writer->SetHeaderType(this->GetHeaderType());
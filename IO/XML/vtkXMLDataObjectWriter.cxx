@@ -92,6 +92,7 @@ int vtkXMLDataObjectWriter::WriteInternal()
     writer->SetByteOrder(this->GetByteOrder());
     writer->SetCompressor(this->GetCompressor());
     writer->SetBlockSize(this->GetBlockSize());
+    writer->SetOverlapCompressionAndWrite(this->GetOverlapCompressionAndWrite());
     writer->SetDataMode(this->GetDataMode());
     writer->SetEncodeAppendedData(this->GetEncodeAppendedData());
     writer->SetWriteTimeValue(this->GetWriteTimeValue());
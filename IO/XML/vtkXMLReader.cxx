@@ -35,6 +35,10 @@
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
 
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkZstdDataCompressor.h"
+#endif
+
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
 #include <vtksys/SystemTools.hxx>
@@ -132,6 +136,7 @@ vtkXMLReader::vtkXMLReader()
   this->FileStream = nullptr;
   this->StringStream = nullptr;
   this->ReadFromInputString = 0;
+  this->UseMemoryMapping = false;
   this->InputString = "";
   this->InputArray = nullptr;
   this->XMLParser = nullptr;
@@ -230,6 +235,7 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Stream: (none)\n";
   }
+  os << indent << "UseMemoryMapping: " << (this->UseMemoryMapping ? "On" : "Off") << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "ActiveTimeDataArrayName:"
      << (this->ActiveTimeDataArrayName ? this->ActiveTimeDataArrayName : "(null)") << "\n";
@@ -515,6 +521,12 @@ void vtkXMLReader::SetupCompressor(const char* type)
     {
       compressor = vtkLZMADataCompressor::New();
     }
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    else if (strcmp(type, "vtkZstdDataCompressor") == 0)
+    {
+      compressor = vtkZstdDataCompressor::New();
+    }
+#endif
   }
 
   if (!compressor)
@@ -957,6 +969,13 @@ int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da, vtkXMLDataParser* xml
   return result;
 }
 
+//------------------------------------------------------------------------------
+template <typename ValueT>
+bool vtkXMLReaderMapArray(vtkAOSDataArrayTemplate<ValueT>* array, const char* fileName,
+  vtkTypeInt64 position, vtkIdType numValues)
+{
+  return array && array->MapFile(fileName, position, numValues);
+}
 }
 
 //------------------------------------------------------------------------------
@@ -970,23 +989,32 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   }
   this->InReadData = 1;
   int result;
-  vtkArrayIterator* iter = array->NewIterator();
-  if (arrayIndex + numValues > array->GetNumberOfValues())
+  if (this->UseMemoryMapping && arrayIndex == 0 && startIndex == 0 &&
+    numValues == array->GetNumberOfValues() && this->MapArrayValues(da, array))
   {
-    vtkErrorMacro("Array has " << array->GetNumberOfValues() << " allocated elements, but "
-                               << arrayIndex + numValues << " were requested to be read");
-    return 0;
+    result = 1;
   }
-  switch (array->GetDataType())
-  {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
-  }
-  if (iter)
+  else
   {
-    iter->Delete();
+    vtkArrayIterator* iter = array->NewIterator();
+    if (arrayIndex + numValues > array->GetNumberOfValues())
+    {
+      vtkErrorMacro("Array has " << array->GetNumberOfValues() << " allocated elements, but "
+                                 << arrayIndex + numValues << " were requested to be read");
+      return 0;
+    }
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da,
+                                      this->XMLParser, arrayIndex, static_cast<VTK_TT*>(iter),
+                                      startIndex, numValues));
+      default:
+        result = 0;
+    }
+    if (iter)
+    {
+      iter->Delete();
+    }
   }
 
   this->ConvertGhostLevelsToGhostType(fieldType, array, startIndex, numValues);
@@ -1002,6 +1030,44 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   return result;
 }
 
+//------------------------------------------------------------------------------
+bool vtkXMLReader::MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array)
+{
+  vtkTypeInt64 offset = 0;
+  if (!this->FileName || !this->FileStream || this->Stream != this->FileStream ||
+    !da->GetScalarAttribute("offset", offset))
+  {
+    return false;
+  }
+  vtkTypeInt64 position = 0;
+  vtkTypeUInt64 numberOfBytes = 0;
+  if (!this->XMLParser->GetRawAppendedDataExtent(offset, position, numberOfBytes))
+  {
+    return false;
+  }
+  // The stored block must hold exactly the values of the array, anything else
+  // is read as usual to get its error handling.
+  const vtkIdType numValues = array->GetNumberOfValues();
+  if (numValues == 0 ||
+    numberOfBytes != static_cast<vtkTypeUInt64>(numValues) * array->GetDataTypeSize())
+  {
+    return false;
+  }
+  bool mapped = false;
+  switch (array->GetDataType())
+  {
+    vtkTemplateMacro(
+      mapped = ::vtkXMLReaderMapArray(vtkAOSDataArrayTemplate<VTK_TT>::FastDownCast(array),
+        this->FileName, position, numValues));
+  }
+  if (mapped)
+  {
+    vtkDebugMacro("Mapped array " << (array->GetName() ? array->GetName() : "")
+                                  << " from byte " << position << " of " << this->FileName);
+  }
+  return mapped;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLReader::ReadArrayTuples(vtkXMLDataElement* da, vtkIdType arrayTupleIndex,
   vtkAbstractArray* array, vtkIdType startTupleIndex, vtkIdType numTuples, FieldType fieldType)
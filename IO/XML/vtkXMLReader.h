@@ -168,6 +168,25 @@ public:
   void SetColumnArrayStatus(const char* name, int status);
   ///@}
 
+  ///@{
+  /**
+   * When on, arrays stored uncompressed in a raw encoded appended data section,
+   * in the byte order of this machine, are memory mapped from the file instead
+   * of being read. Their values are then only loaded from the file when they
+   * are first accessed. Other arrays are read as usual. Only arrays whose
+   * values are aligned in the file can be mapped, see
+   * vtkXMLWriterBase::SetAlignAppendedData().
+   *
+   * The file must not be modified or truncated while arrays mapped from it are
+   * in use. Writing to a mapped array does not modify the file.
+   *
+   * Default is false.
+   */
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+  ///@}
+
   // For the specified port, copy the information this reader sets up in
   // SetupOutputInformation to outInfo
   virtual void CopyOutputInformation(vtkInformation* vtkNotUsed(outInfo), int vtkNotUsed(port)) {}
@@ -351,6 +370,12 @@ protected:
   virtual int ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
     vtkIdType startIndex, vtkIdType numValues, FieldType type = OTHER);
 
+  /**
+   * Map all the values of an array from the appended data section of the
+   * file, see UseMemoryMapping. Returns false if the array cannot be mapped.
+   */
+  bool MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array);
+
   /**
    * Read an Array values starting at the given tuple index and up to numTuples
    * taking into account the number of components declared in array.
@@ -418,6 +443,9 @@ protected:
   // Default is 0: read from file.
   vtkTypeBool ReadFromInputString;
 
+  // Whether raw appended arrays are mapped from the file.
+  bool UseMemoryMapping;
+
   // The input string.
   std::string InputString;
 
@@ -31,6 +31,8 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -51,10 +53,13 @@
 #include "vtksys/FStream.hxx"
 #include <memory>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 #include <unistd.h> /* unlink */
@@ -67,6 +72,43 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 
+//*****************************************************************************
+struct vtkXMLWriter::CompressionQueue
+{
+  // Uncompressed blocks waiting to be compressed.  The buffers are
+  // reused from one batch to the next.
+  std::vector<std::vector<unsigned char>> Blocks;
+  size_t NumberOfBlocks = 0;
+
+  // Compressed blocks of the previous batch, written to the stream
+  // by a background thread when OverlapCompressionAndWrite is on.
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> Compressed;
+  std::thread Writer;
+  bool WriteResult = true;
+
+  ~CompressionQueue() { this->Wait(); }
+
+  void Wait()
+  {
+    if (this->Writer.joinable())
+    {
+      this->Writer.join();
+    }
+  }
+
+  bool WriteCompressed(vtkOutputStream* dataStream)
+  {
+    for (const auto& block : this->Compressed)
+    {
+      if (!dataStream->Write(block->GetPointer(0), block->GetNumberOfValues()))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
 //*****************************************************************************
 // Friend class to enable access for template functions to the protected
 // writer methods.
@@ -438,6 +480,7 @@ vtkXMLWriter::vtkXMLWriter()
 
   // Initialize compression data.
   this->CompressionHeader = nullptr;
+  this->PendingCompression = new CompressionQueue;
   this->Int32IdTypeBuffer = nullptr;
   this->ByteSwapBuffer = nullptr;
 
@@ -462,6 +505,7 @@ vtkXMLWriter::vtkXMLWriter()
 //------------------------------------------------------------------------------
 vtkXMLWriter::~vtkXMLWriter()
 {
+  delete this->PendingCompression;
   this->DataStream->Delete();
   delete this->OutFile;
   this->OutFile = nullptr;
@@ -1005,6 +1049,13 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the last blocks, and wait for the background
+    // writes to complete.
+    if (!this->FlushCompressionBlocks(true))
+    {
+      result = 0;
+    }
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1238,14 +1289,7 @@ int vtkXMLWriter::WriteBinaryDataBlock(unsigned char* in_data, size_t numWords,
   // Now pass the data to the next write phase.
   if (this->Compressor)
   {
-    int res = this->WriteCompressionBlock(data, numWords * wordSize);
-    this->Stream->flush();
-    if (this->Stream->fail())
-    {
-      this->SetErrorCode(vtkErrorCode::GetLastSystemError());
-      return 0;
-    }
-    return res;
+    return this->WriteCompressionBlock(data, numWords * wordSize);
   }
   else
   {
@@ -1367,27 +1411,86 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // Queue a copy of the data: the caller reuses its buffer for the
+  // next block.
+  CompressionQueue* queue = this->PendingCompression;
+  if (queue->NumberOfBlocks == queue->Blocks.size())
+  {
+    queue->Blocks.emplace_back();
+  }
+  queue->Blocks[queue->NumberOfBlocks++].assign(data, data + size);
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+  // Compress the queued blocks together once there are 256 of them or
+  // they amount to 64MB, which bounds the memory used by the queue.
+  size_t const batchSize = std::min<size_t>(256, std::max<size_t>(67108864 / this->BlockSize, 1));
+  if (queue->NumberOfBlocks < batchSize)
+  {
+    return 1;
+  }
+  return this->FlushCompressionBlocks(false);
+}
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks(bool wait)
+{
+  CompressionQueue* queue = this->PendingCompression;
+
+  // Compress the queued blocks in parallel.  Each block is compressed
+  // independently, so the output does not depend on the number of
+  // threads.
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> compressed(queue->NumberOfBlocks);
+  vtkDataCompressor* compressor = this->Compressor;
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(queue->NumberOfBlocks), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const std::vector<unsigned char>& block = queue->Blocks[i];
+        compressed[i] = vtk::TakeSmartPointer(compressor->Compress(block.data(), block.size()));
+      }
+    });
+  queue->NumberOfBlocks = 0;
+
+  // Wait for the previous batch to be written before writing this one
+  // since the blocks must be written in order.
+  queue->Wait();
   this->Stream->flush();
-  if (this->Stream->fail())
+  bool result = queue->WriteResult && !this->Stream->fail();
+
+  // Store the resulting compressed sizes in the compression header.
+  for (const auto& block : compressed)
   {
-    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    if (!block)
+    {
+      vtkErrorMacro("Error compressing binary data block.");
+      result = false;
+      break;
+    }
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, block->GetNumberOfValues());
   }
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
-
-  outputArray->Delete();
+  queue->Compressed.swap(compressed);
+  if (result && this->OverlapCompressionAndWrite && !wait)
+  {
+    vtkOutputStream* dataStream = this->DataStream;
+    queue->Writer = std::thread(
+      [queue, dataStream]() { queue->WriteResult = queue->WriteCompressed(dataStream); });
+    return 1;
+  }
 
-  return result;
+  // Write the compressed data.
+  if (result)
+  {
+    result = queue->WriteCompressed(this->DataStream);
+    this->Stream->flush();
+  }
+  queue->Compressed.clear();
+  queue->WriteResult = true;
+  if (this->Stream->fail())
+  {
+    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    result = false;
+  }
+  return result ? 1 : 0;
 }
 
 //------------------------------------------------------------------------------
@@ -2027,6 +2130,19 @@ void vtkXMLWriter::WriteArrayAppended(vtkAbstractArray* a, vtkIndent indent, Off
 void vtkXMLWriter::WriteArrayAppendedData(
   vtkAbstractArray* a, vtkTypeInt64 pos, vtkTypeInt64& lastoffset)
 {
+  if (this->AlignAppendedData && !this->EncodeAppendedData && !this->Compressor)
+  {
+    // Pad the appended data so that the values of the array are aligned in
+    // the file, which lets readers memory map them.
+    std::unique_ptr<vtkXMLDataHeader> uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+    ostream& os = *(this->Stream);
+    const vtkTypeInt64 dataPosition = static_cast<vtkTypeInt64>(os.tellp()) + uh->DataSize();
+    const vtkTypeInt64 alignment = 8;
+    for (vtkTypeInt64 i = dataPosition % alignment; i > 0 && i < alignment; ++i)
+    {
+      os.put('\0');
+    }
+  }
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a);
 }
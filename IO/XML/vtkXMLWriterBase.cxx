@@ -9,6 +9,10 @@
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
 
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkZstdDataCompressor.h"
+#endif
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkCxxSetObjectMacro(vtkXMLWriterBase, Compressor, vtkDataCompressor);
 //----------------------------------------------------------------------------
@@ -28,8 +32,10 @@ vtkXMLWriterBase::vtkXMLWriterBase()
 #endif
   , DataMode(vtkXMLWriterBase::Appended)
   , EncodeAppendedData(true)
+  , AlignAppendedData(false)
   , Compressor(vtkZLibDataCompressor::New())
   , BlockSize(32768) // 2^15
+  , OverlapCompressionAndWrite(false)
   , CompressionLevel(5)
   , UsePreviousVersion(true)
 {
@@ -120,6 +126,20 @@ void vtkXMLWriterBase::SetCompressorType(int compressorType)
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
     this->Modified();
   }
+  else if (compressorType == ZSTD)
+  {
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    if (this->Compressor)
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZstdDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+#else
+    vtkWarningMacro("Zstd compressor requested but VTK::IOZstd is not enabled.");
+#endif
+  }
   else
   {
     vtkWarningMacro("Invalid compressorType:" << compressorType);
@@ -258,6 +278,8 @@ void vtkXMLWriterBase::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Compressor: (none)\n";
   }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
+  os << indent << "AlignAppendedData: " << this->AlignAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "OverlapCompressionAndWrite: " << this->OverlapCompressionAndWrite << "\n";
 }
 VTK_ABI_NAMESPACE_END
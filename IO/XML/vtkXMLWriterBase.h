@@ -139,7 +139,8 @@ public:
     NONE,
     ZLIB,
     LZ4,
-    LZMA
+    LZMA,
+    ZSTD
   };
 
   ///@{
@@ -151,6 +152,7 @@ public:
   void SetCompressorTypeToLZ4() { this->SetCompressorType(LZ4); }
   void SetCompressorTypeToZLib() { this->SetCompressorType(ZLIB); }
   void SetCompressorTypeToLZMA() { this->SetCompressorType(LZMA); }
+  void SetCompressorTypeToZstd() { this->SetCompressorType(ZSTD); }
   ///@}
 
   ///@{
@@ -173,6 +175,19 @@ public:
   vtkGetMacro(BlockSize, size_t);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set whether the compressed blocks of binary data are written to
+   * the file by a background thread while the next blocks are
+   * compressed.  The blocks are always compressed in parallel by
+   * vtkSMPTools, and the output is the same whether this is on or off.
+   * Default is off.
+   */
+  vtkSetMacro(OverlapCompressionAndWrite, bool);
+  vtkGetMacro(OverlapCompressionAndWrite, bool);
+  vtkBooleanMacro(OverlapCompressionAndWrite, bool);
+  ///@}
+
   ///@{
   /**
    * Get/Set the data mode used for the file's data.  The options are
@@ -199,6 +214,19 @@ public:
   vtkBooleanMacro(EncodeAppendedData, bool);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set whether the arrays of a raw and uncompressed appended data
+   * section are padded so that their values start 8-byte aligned in the
+   * file. Aligned arrays can be memory mapped by the readers, see
+   * vtkXMLReader::SetUseMemoryMapping(). The padding changes the offsets of
+   * the arrays in the file. The default is off.
+   */
+  vtkSetMacro(AlignAppendedData, bool);
+  vtkGetMacro(AlignAppendedData, bool);
+  vtkBooleanMacro(AlignAppendedData, bool);
+  ///@}
+
   ///@{
   /**
    * Control whether to write "TimeValue" field data.
@@ -255,9 +283,13 @@ protected:
   // Whether to base64-encode the appended data section.
   bool EncodeAppendedData;
 
+  // Whether to align the arrays of a raw uncompressed appended data section.
+  bool AlignAppendedData;
+
   // Compression information.
   vtkDataCompressor* Compressor;
   size_t BlockSize;
+  bool OverlapCompressionAndWrite;
 
   // Compression Level for vtkDataCompressor objects
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
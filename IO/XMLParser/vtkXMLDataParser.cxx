@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkXMLDataParser.h"
 
+#include "vtkASCIIArrayParser.h"
 #include "vtkBase64InputStream.h"
 #include "vtkByteSwap.h"
 #include "vtkCommand.h"
@@ -9,16 +10,19 @@
 #include "vtkEndian.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "vtkXMLUtilities.h"
@@ -40,6 +44,7 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->DataStream = nullptr;
   this->InlineDataStream = vtkBase64InputStream::New();
   this->AppendedDataStream = vtkBase64InputStream::New();
+  this->AppendedDataRaw = false;
 
   this->BlockCompressedSizes = nullptr;
   this->BlockStartOffsets = nullptr;
@@ -165,6 +170,7 @@ void vtkXMLDataParser::StartElement(const char* name, const char** atts)
     {
       this->AppendedDataStream->Delete();
       this->AppendedDataStream = vtkInputStream::New();
+      this->AppendedDataRaw = true;
     }
   }
 }
@@ -746,95 +752,87 @@ size_t vtkXMLDataParser::ReadCompressedData(
     endOffset = totalSize;
   }
 
-  // Find the range of compression blocks to read.
-  vtkTypeUInt64 firstBlock = beginOffset / this->BlockUncompressedSize;
-  vtkTypeUInt64 lastBlock = endOffset / this->BlockUncompressedSize;
-
-  // Find the offset into the first block where the data begin.
-  size_t beginBlockOffset = beginOffset - firstBlock * this->BlockUncompressedSize;
-
-  // Find the offset into the last block where the data end.
-  size_t endBlockOffset = endOffset - lastBlock * this->BlockUncompressedSize;
+  // Find the range of compression blocks to read.  The last block
+  // is not read when the data end exactly at its beginning.
+  vtkTypeUInt64 const blockUncompressedSize = this->BlockUncompressedSize;
+  vtkTypeUInt64 const firstBlock = beginOffset / blockUncompressedSize;
+  vtkTypeUInt64 const endBlock = (endOffset + blockUncompressedSize - 1) / blockUncompressedSize;
 
+  // The compressed blocks are read from the stream sequentially in
+  // batches of about 64MB, and the blocks of a batch are then
+  // uncompressed in parallel straight into the output when they are
+  // entirely requested.
+  size_t const batchSize = 67108864;
+  size_t const length = endOffset - beginOffset;
+  std::vector<unsigned char> compressedBuffer;
   this->UpdateProgress(0);
-  if (firstBlock == lastBlock)
+  for (vtkTypeUInt64 batchBegin = firstBlock; batchBegin < endBlock && !this->Abort;)
   {
-    // Everything fits in one block.
-    unsigned char* blockBuffer = this->ReadBlock(firstBlock);
-    if (!blockBuffer)
+    // Gather the consecutive blocks of this batch.
+    vtkTypeUInt64 batchEnd = batchBegin;
+    size_t compressedSize = 0;
+    do
     {
-      return 0;
-    }
-    size_t n = endBlockOffset - beginBlockOffset;
-    memcpy(data, blockBuffer + beginBlockOffset, n);
-    delete[] blockBuffer;
-
-    // Byte swap this block.  Note that n will always be an integer
-    // multiple of the word size.
-    this->PerformByteSwap(data, n / wordSize, wordSize);
-  }
-  else
-  {
-    // Read all the complete blocks first.
-    size_t length = endOffset - beginOffset;
-    unsigned char* outputPointer = data;
-    size_t blockSize = this->FindBlockSize(firstBlock);
+      compressedSize += this->BlockCompressedSizes[batchEnd++];
+    } while (batchEnd < endBlock && compressedSize < batchSize);
 
-    // Read the first block.
-    unsigned char* blockBuffer = this->ReadBlock(firstBlock);
-    if (!blockBuffer)
+    // Read the compressed data of the whole batch at once.
+    compressedBuffer.resize(compressedSize);
+    if (!this->DataStream->Seek(this->BlockStartOffsets[batchBegin]) ||
+      this->DataStream->Read(compressedBuffer.data(), compressedSize) < compressedSize)
     {
       return 0;
     }
-    size_t n = blockSize - beginBlockOffset;
-    memcpy(outputPointer, blockBuffer + beginBlockOffset, n);
-    delete[] blockBuffer;
 
-    // Byte swap the first block.  Note that n will always be an
-    // integer multiple of the word size.
-    this->PerformByteSwap(outputPointer, n / wordSize, wordSize);
-
-    // Advance the pointer to the beginning of the second block.
-    outputPointer += blockSize - beginBlockOffset;
-
-    // Report progress.
-    this->UpdateProgress(float(outputPointer - data) / length);
-
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
-    {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
+    std::atomic<bool> failed(false);
+    vtkSMPTools::For(batchBegin, batchEnd, [&](vtkTypeUInt64 begin, vtkTypeUInt64 end) {
+      std::vector<unsigned char> blockBuffer;
+      for (vtkTypeUInt64 block = begin; block < end && !failed; ++block)
       {
-        return 0;
-      }
-
-      // Byte swap this block.  Note that blockSize will always be an
-      // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
-
-      // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
-
-      // Report progress.
-      this->UpdateProgress(float(outputPointer - data) / length);
-    }
+        unsigned char const* compressedData = compressedBuffer.data() +
+          (this->BlockStartOffsets[block] - this->BlockStartOffsets[batchBegin]);
+        size_t const blockSize = this->FindBlockSize(block);
+
+        // Find the part of this block that is requested.
+        vtkTypeUInt64 const blockBegin = block * blockUncompressedSize;
+        vtkTypeUInt64 const copyBegin = std::max(blockBegin, beginOffset);
+        vtkTypeUInt64 const copyEnd = std::min(blockBegin + blockSize, endOffset);
+        unsigned char* outputPointer = data + (copyBegin - beginOffset);
+
+        size_t result = 0;
+        if (copyBegin == blockBegin && copyEnd == blockBegin + blockSize)
+        {
+          result = this->Compressor->Uncompress(
+            compressedData, this->BlockCompressedSizes[block], outputPointer, blockSize);
+        }
+        else
+        {
+          blockBuffer.resize(blockSize);
+          result = this->Compressor->Uncompress(
+            compressedData, this->BlockCompressedSizes[block], blockBuffer.data(), blockSize);
+          std::copy(blockBuffer.begin() + (copyBegin - blockBegin),
+            blockBuffer.begin() + (copyEnd - blockBegin), outputPointer);
+        }
+        if (result == 0)
+        {
+          failed = true;
+          return;
+        }
 
-    // Now read the final block, which is incomplete if it exists.
-    if (endBlockOffset > 0 && !this->Abort)
-    {
-      blockBuffer = this->ReadBlock(lastBlock);
-      if (!blockBuffer)
-      {
-        return 0;
+        // Byte swap this part of the block.  Note that its size will
+        // always be an integer multiple of the word size.
+        this->PerformByteSwap(outputPointer, (copyEnd - copyBegin) / wordSize, wordSize);
       }
-      memcpy(outputPointer, blockBuffer, endBlockOffset);
-      delete[] blockBuffer;
-
-      // Byte swap the partial block.  Note that endBlockOffset will
-      // always be an integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, endBlockOffset / wordSize, wordSize);
+    });
+    if (failed)
+    {
+      return 0;
     }
+    batchBegin = batchEnd;
+
+    // Report progress.
+    vtkTypeUInt64 const readEnd = std::min(batchEnd * blockUncompressedSize, endOffset);
+    this->UpdateProgress(float(readEnd - beginOffset) / length);
   }
   this->UpdateProgress(1);
 
@@ -962,6 +960,37 @@ size_t vtkXMLDataParser::ReadAppendedData(
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//------------------------------------------------------------------------------
+bool vtkXMLDataParser::GetRawAppendedDataExtent(
+  vtkTypeInt64 offset, vtkTypeInt64& position, vtkTypeUInt64& numberOfBytes)
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  const int nativeByteOrder = vtkXMLDataParser::BigEndian;
+#else
+  const int nativeByteOrder = vtkXMLDataParser::LittleEndian;
+#endif
+  if (!this->AppendedDataRaw || this->Compressor || this->ByteOrder != nativeByteOrder)
+  {
+    return false;
+  }
+
+  this->DataStream = this->AppendedDataStream;
+  this->SeekG(this->AppendedDataPosition + offset);
+  this->DataStream->SetStream(this->Stream);
+  std::unique_ptr<vtkXMLDataHeader> uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  this->DataStream->StartReading();
+  size_t r = this->DataStream->Read(uh->Data(), headerSize);
+  this->DataStream->EndReading();
+  if (r < headerSize)
+  {
+    return false;
+  }
+  numberOfBytes = uh->Get(0);
+  position = this->AppendedDataPosition + offset + static_cast<vtkTypeInt64>(headerSize);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -1263,6 +1292,30 @@ static unsigned char* vtkXMLParseAsciiBitData(istream& is, int* length)
   return array;
 }
 
+//------------------------------------------------------------------------------
+// Parse all the words of the text with multiple threads. Returns nullptr when
+// one of the words cannot be parsed that way, so that the stream parsing
+// functions above, which stop on the first invalid word, are used instead.
+template <class T>
+T* vtkXMLParseAsciiDataInBulk(const std::string& text, int* length, T*)
+{
+  const char* begin = text.data();
+  const char* end = begin + text.size();
+  const vtkIdType numWords = vtkASCIIArrayParser::CountWords(begin, end);
+  if (numWords > VTK_INT_MAX)
+  {
+    return nullptr;
+  }
+  T* dataBuffer = new T[std::max<vtkIdType>(numWords, 1)];
+  if (vtkASCIIArrayParser::Parse(begin, end, numWords, dataBuffer) != numWords)
+  {
+    delete[] dataBuffer;
+    return nullptr;
+  }
+  *length = static_cast<int>(numWords);
+  return dataBuffer;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLDataParser::ParseAsciiData(int wordType)
 {
@@ -1283,13 +1336,32 @@ int vtkXMLDataParser::ParseAsciiData(int wordType)
 
   int length = 0;
   void* buffer = nullptr;
-  switch (wordType)
+  const vtkTypeInt64 start = this->AsciiDataPosition;
+  if (wordType != VTK_BIT && start >= 0)
   {
-    vtkTemplateMacro(buffer = vtkXMLParseAsciiData(is, &length, static_cast<VTK_TT*>(nullptr), 1));
+    // Inline data ends with the closing tag of the element
+    std::string text;
+    std::getline(is, text, '<');
+    switch (wordType)
+    {
+      vtkTemplateMacro(
+        buffer = vtkXMLParseAsciiDataInBulk(text, &length, static_cast<VTK_TT*>(nullptr)));
+    }
+    is.clear();
+    this->SeekG(buffer ? start + static_cast<vtkTypeInt64>(text.size()) : start);
+  }
 
-    case VTK_BIT:
-      buffer = vtkXMLParseAsciiBitData(is, &length);
-      break;
+  if (!buffer)
+  {
+    switch (wordType)
+    {
+      vtkTemplateMacro(
+        buffer = vtkXMLParseAsciiData(is, &length, static_cast<VTK_TT*>(nullptr), 1));
+
+      case VTK_BIT:
+        buffer = vtkXMLParseAsciiBitData(is, &length);
+        break;
+    }
   }
 
   // Read terminated from failure.  Clear the fail bit so another read
@@ -70,6 +70,17 @@ public:
     return this->ReadAppendedData(offset, buffer, startWord, numWords, VTK_CHAR);
   }
 
+  /**
+   * Locate the data of the appended data section starting at the given
+   * appended data offset when it is stored as is in the stream, that is raw
+   * encoded, uncompressed and in the byte order of this machine. On success,
+   * @a position is the position of the first byte of data in the stream and
+   * @a numberOfBytes is the size of the data. Returns false if the data must
+   * be decoded by ReadAppendedData().
+   */
+  bool GetRawAppendedDataExtent(
+    vtkTypeInt64 offset, vtkTypeInt64& position, vtkTypeUInt64& numberOfBytes);
+
   /**
    * Read from an ascii data section starting at the current position in
    * the stream.  Returns the number of words read.
@@ -224,6 +235,9 @@ protected:
   // The stream to use for appended data.
   vtkInputStream* AppendedDataStream;
 
+  // Whether the appended data is raw encoded.
+  bool AppendedDataRaw;
+
   // Decompression data.
   vtkDataCompressor* Compressor;
   size_t NumberOfBlocks;
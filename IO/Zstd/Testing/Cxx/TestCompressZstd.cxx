@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of vtkZstdDataCompressor
+// .SECTION Description
+//
+
+#include "vtkNew.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+bool RoundTrip(vtkZstdDataCompressor* compressor, const std::vector<unsigned char>& buffer)
+{
+  size_t nlen = compressor->GetMaximumCompressionSpace(buffer.size());
+  std::vector<unsigned char> cbuffer(nlen);
+  size_t rlen = compressor->Compress(buffer.data(), buffer.size(), cbuffer.data(), nlen);
+  if (rlen == 0 || rlen >= buffer.size())
+  {
+    cout << "Compression failed with level " << compressor->GetZstdLevel() << endl;
+    return false;
+  }
+  std::vector<unsigned char> ucbuffer(buffer.size());
+  rlen = compressor->Uncompress(cbuffer.data(), rlen, ucbuffer.data(), ucbuffer.size());
+  if (rlen != buffer.size() || ucbuffer != buffer)
+  {
+    cout << "Uncompression failed with level " << compressor->GetZstdLevel() << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestCompressZstd(int, char*[])
+{
+  const unsigned int start_size = 1000024;
+  std::vector<unsigned char> buffer(start_size);
+  for (unsigned int cc = 0; cc < start_size; cc++)
+  {
+    buffer[cc] = static_cast<unsigned char>((cc * cc / 7) % 251);
+  }
+  buffer[0] = 'v';
+  buffer[1] = 't';
+  buffer[2] = 'k';
+
+  vtkNew<vtkZstdDataCompressor> compressor;
+  for (int level = 1; level <= 9; ++level)
+  {
+    compressor->SetCompressionLevel(level);
+    if (compressor->GetCompressionLevel() != level)
+    {
+      cout << "CompressionLevel " << level << " is not preserved" << endl;
+      return EXIT_FAILURE;
+    }
+    if (!::RoundTrip(compressor, buffer))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Multithreaded compression output is readable by the same compressor.
+  compressor->SetZstdLevel(3);
+  compressor->SetNumberOfThreads(2);
+  if (!::RoundTrip(compressor, buffer))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkZstdDataCompressor.h"
+#include "vtkObjectFactory.h"
+
+#include <zstd.h>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+{
+  this->ZstdLevel = ZSTD_CLEVEL_DEFAULT;
+  this->NumberOfThreads = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor() = default;
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ZstdLevel: " << this->ZstdLevel << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  // A context is created for each call so that a compressor can be used
+  // by several threads at once.
+  ZSTD_CCtx* context = ZSTD_createCCtx();
+  if (!context)
+  {
+    vtkErrorMacro("Zstd error while creating a compression context.");
+    return 0;
+  }
+  ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, this->ZstdLevel);
+  if (this->NumberOfThreads > 0 &&
+    ZSTD_isError(ZSTD_CCtx_setParameter(context, ZSTD_c_nbWorkers, this->NumberOfThreads)))
+  {
+    vtkWarningMacro("The Zstd library does not support multithreading, compressing with a single "
+                    "thread.");
+  }
+  size_t cs =
+    ZSTD_compress2(context, compressedData, compressionSpace, uncompressedData, uncompressedSize);
+  ZSTD_freeCCtx(context);
+  if (ZSTD_isError(cs))
+  {
+    vtkErrorMacro("Zstd error while compressing data: " << ZSTD_getErrorName(cs));
+    return 0;
+  }
+  return cs;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  size_t us = ZSTD_decompress(uncompressedData, uncompressedSize, compressedData, compressedSize);
+  if (ZSTD_isError(us))
+  {
+    vtkErrorMacro("Zstd error while uncompressing data: " << ZSTD_getErrorName(us));
+    return 0;
+  }
+  // Make sure the output size matched that expected.
+  if (us != uncompressedSize)
+  {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected "
+      << uncompressedSize << " and got " << us);
+    return 0;
+  }
+  return us;
+}
+
+//------------------------------------------------------------------------------
+int vtkZstdDataCompressor::GetCompressionLevel()
+{
+  // Invert the mapping of SetCompressionLevel, rounding to the closest level.
+  int level = this->ZstdLevel < 1 ? 1 : (this->ZstdLevel > 19 ? 19 : this->ZstdLevel);
+  int compressionLevel = 1 + ((level - 1) * 8 + 9) / 18;
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << compressionLevel);
+  return compressionLevel;
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  int min = 1;
+  int max = 9;
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  // In order to make an intuitive interface for vtkDataCompressor objects
+  // we accept compressionLevel values 1..9. 1 is fastest, 9 is slowest
+  // 1 is worst compression, 9 is best compression. They are spread over
+  // the Zstandard levels 1..19, the levels above 19 using a lot of memory.
+  compressionLevel =
+    compressionLevel < min ? min : (compressionLevel > max ? max : compressionLevel);
+  this->SetZstdLevel(1 + ((compressionLevel - 1) * 18 + 4) / 8);
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkZstdDataCompressor
+ * @brief   Data compression using Zstandard.
+ *
+ * vtkZstdDataCompressor provides a concrete vtkDataCompressor class
+ * using Zstandard for compressing and uncompressing data. Zstandard
+ * reaches compression ratios close to LZMA while uncompressing almost
+ * as fast as LZ4.
+ *
+ * The generic compression levels 1..9 of vtkDataCompressor are mapped
+ * to Zstandard levels 1..19. The Zstandard level can also be set
+ * directly with SetZstdLevel, including the levels above 19 and the
+ * negative, fastest, levels.
+ *
+ * When NumberOfThreads is positive, each buffer is compressed by that
+ * many threads. This requires a Zstandard library built with
+ * multithreading support and only pays off for large buffers.
+ */
+
+#ifndef vtkZstdDataCompressor_h
+#define vtkZstdDataCompressor_h
+
+#include "vtkDataCompressor.h"
+#include "vtkIOZstdModule.h" // For export macro
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKIOZSTD_EXPORT vtkZstdDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZstdDataCompressor, vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkZstdDataCompressor* New();
+
+  /**
+   *  Get the maximum space that may be needed to store data of the
+   *  given uncompressed size after compression.  This is the minimum
+   *  size of the output buffer that can be passed to the four-argument
+   *  Compress method.
+   */
+  size_t GetMaximumCompressionSpace(size_t size) override;
+  /**
+   *  Get/Set the compression level.
+   */
+  // Compression level getter required by vtkDataCompressor.
+  int GetCompressionLevel() override;
+
+  // Compression level setter required by vtkDataCompressor.
+  void SetCompressionLevel(int compressionLevel) override;
+
+  // Direct setting of the Zstandard level allows more direct
+  // control over the Zstandard compressor
+  vtkSetClampMacro(ZstdLevel, int, -131072, 22);
+  vtkGetMacro(ZstdLevel, int);
+
+  ///@{
+  /**
+   * Get/Set the number of threads compressing each buffer. 0, the
+   * default, compresses in the calling thread.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, 256);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
+protected:
+  vtkZstdDataCompressor();
+  ~vtkZstdDataCompressor() override;
+
+  int ZstdLevel;
+  int NumberOfThreads;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override;
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t uncompressedSize) override;
+
+private:
+  vtkZstdDataCompressor(const vtkZstdDataCompressor&) = delete;
+  void operator=(const vtkZstdDataCompressor&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
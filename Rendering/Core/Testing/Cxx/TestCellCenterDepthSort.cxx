@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Sort the cells of an image with vtkCellCenterDepthSort from various camera
+// positions, and check that every traversal returns all the cells once, from
+// back to front.
+
+#include "vtkCamera.h"
+#include "vtkCellCenterDepthSort.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMatrix4x4.h"
+#include "vtkNew.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool CheckTraversal(vtkCellCenterDepthSort* sort, vtkImageData* image, vtkCamera* camera)
+{
+  double position[3], focalPoint[3];
+  camera->GetPosition(position);
+  camera->GetFocalPoint(focalPoint);
+  const double direction[3] = { position[0] - focalPoint[0], position[1] - focalPoint[1],
+    position[2] - focalPoint[2] };
+
+  const vtkIdType numberOfCells = image->GetNumberOfCells();
+  std::vector<bool> returned(numberOfCells, false);
+  vtkIdType count = 0;
+  double lastDepth = -VTK_DOUBLE_MAX;
+  sort->InitTraversal();
+  while (vtkIdTypeArray* cells = sort->GetNextCells())
+  {
+    if (cells->GetNumberOfTuples() > sort->GetMaxCellsReturned())
+    {
+      std::cerr << "Too many cells returned at once." << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < cells->GetNumberOfTuples(); ++i)
+    {
+      const vtkIdType cellId = cells->GetValue(i);
+      if (cellId < 0 || cellId >= numberOfCells || returned[cellId])
+      {
+        std::cerr << "Cell " << cellId << " is returned twice or does not exist." << std::endl;
+        return false;
+      }
+      returned[cellId] = true;
+      ++count;
+
+      double bounds[6];
+      image->GetCellBounds(cellId, bounds);
+      const double depth = (bounds[0] + bounds[1]) * 0.5 * direction[0] +
+        (bounds[2] + bounds[3]) * 0.5 * direction[1] + (bounds[4] + bounds[5]) * 0.5 * direction[2];
+      if (depth < lastDepth - 1e-4 * (std::abs(depth) + 1.0))
+      {
+        std::cerr << "Cell " << cellId << " is not sorted back to front." << std::endl;
+        return false;
+      }
+      lastDepth = depth;
+    }
+  }
+  if (count != numberOfCells)
+  {
+    std::cerr << "Only " << count << " of the " << numberOfCells << " cells are returned."
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestCellCenterDepthSort(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(41, 31, 21);
+  image->SetOrigin(-20.0, -15.0, -10.0);
+
+  vtkNew<vtkCamera> camera;
+  camera->SetPosition(10.0, 20.0, 100.0);
+  camera->SetFocalPoint(0.0, 0.0, 0.0);
+
+  vtkNew<vtkMatrix4x4> identity;
+  vtkNew<vtkCellCenterDepthSort> sort;
+  sort->SetInput(image);
+  sort->SetCamera(camera);
+  sort->SetModelTransform(identity);
+  sort->SetDirectionToBackToFront();
+  sort->SetMaxCellsReturned(1000);
+  if (!CheckTraversal(sort, image, camera))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Small camera motions reuse the previous order, large ones sort again.
+  const double angles[] = { 0.5, 1.0, 2.0, 90.0, 180.0, 0.1 };
+  for (double angle : angles)
+  {
+    camera->Azimuth(angle);
+    camera->Elevation(angle / 2.0);
+    camera->OrthogonalizeViewUp();
+    if (!CheckTraversal(sort, image, camera))
+    {
+      std::cerr << "After a rotation of " << angle << " degrees." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Render fine spheres far from the camera with the automatic levels of detail
+// of vtkCompositePolyDataMapper, check that coarser levels are rendered once
+// they are built and that the spheres are rendered at full resolution when
+// the camera gets close.
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkCompositePolyDataMapper.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSphereSource.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+vtkIdType CountRenderedTriangles(vtkCompositePolyDataMapper* mapper)
+{
+  vtkIdType count = 0;
+  for (vtkPolyData* polydata : mapper->GetRenderedList())
+  {
+    count += polydata->GetNumberOfPolys();
+  }
+  return count;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestCompositePolyDataMapperAutomaticLOD(int, char*[])
+{
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  vtkIdType numberOfTriangles = 0;
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(2.5 * i, 0.0, 0.0);
+    sphere->SetThetaResolution(200);
+    sphere->SetPhiResolution(200);
+    sphere->Update();
+    blocks->SetBlock(i, sphere->GetOutput());
+    numberOfTriangles += sphere->GetOutput()->GetNumberOfPolys();
+  }
+
+  vtkNew<vtkCompositePolyDataMapper> mapper;
+  mapper->SetInputDataObject(blocks);
+  mapper->AutomaticLODOn();
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+
+  // Far from the camera, the spheres cover a few pixels.
+  vtkCamera* camera = renderer->GetActiveCamera();
+  camera->SetFocalPoint(3.75, 0.0, 0.0);
+  camera->SetPosition(3.75, 0.0, 500.0);
+  renderer->ResetCameraClippingRange();
+  renWin->Render();
+  for (int i = 0; i < 1000 && CountRenderedTriangles(mapper) == numberOfTriangles; ++i)
+  {
+    vtksys::SystemTools::Delay(10);
+    renWin->Render();
+  }
+  const vtkIdType farTriangles = CountRenderedTriangles(mapper);
+  if (farTriangles == 0 || farTriangles >= numberOfTriangles / 4)
+  {
+    std::cerr << farTriangles << " triangles rendered far from the camera, for "
+              << numberOfTriangles << " at full resolution." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Close to the camera, the full resolution is needed.
+  camera->SetPosition(3.75, 0.0, 6.0);
+  renderer->ResetCameraClippingRange();
+  renWin->Render();
+  if (CountRenderedTriangles(mapper) != numberOfTriangles)
+  {
+    std::cerr << CountRenderedTriangles(mapper)
+              << " triangles rendered close to the camera, for " << numberOfTriangles
+              << " at full resolution." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Without levels of detail, the blocks are rendered as they are.
+  camera->SetPosition(3.75, 0.0, 500.0);
+  renderer->ResetCameraClippingRange();
+  mapper->AutomaticLODOff();
+  renWin->Render();
+  if (CountRenderedTriangles(mapper) != numberOfTriangles)
+  {
+    std::cerr << "The levels of detail are rendered when AutomaticLOD is off." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that editing the colors of the lookup table of a mapper that
+// interpolates scalars before mapping rebuilds the color texture map only,
+// and that changing the scalar range rebuilds the texture coordinates.
+
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkLookupTable.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataMapper.h"
+
+#include <cstdlib>
+#include <iostream>
+
+//------------------------------------------------------------------------------
+int TestMapScalarsToTexture(int, char*[])
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scalars;
+  for (int i = 0; i < 10; ++i)
+  {
+    points->InsertNextPoint(i, 0.0, 0.0);
+    scalars->InsertNextValue(0.1f * i);
+  }
+  vtkNew<vtkPolyData> polydata;
+  polydata->SetPoints(points);
+  polydata->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkLookupTable> lut;
+  lut->Build();
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputData(polydata);
+  mapper->SetLookupTable(lut);
+  mapper->SetScalarRange(0.0, 1.0);
+  mapper->InterpolateScalarsBeforeMappingOn();
+
+  mapper->MapScalars(1.0);
+  vtkFloatArray* coordinates = mapper->GetColorCoordinates();
+  vtkImageData* texture = mapper->GetColorTextureMap();
+  if (!coordinates || !texture)
+  {
+    std::cerr << "The scalars are not mapped to a texture." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const vtkMTimeType coordinatesTime = coordinates->GetMTime();
+  const vtkMTimeType textureTime = texture->GetMTime();
+  const float coordinate = coordinates->GetValue(2);
+
+  // New colors, same range.
+  lut->SetHueRange(0.2, 0.8);
+  lut->Build();
+  mapper->MapScalars(1.0);
+  if (mapper->GetColorCoordinates() != coordinates ||
+    mapper->GetColorCoordinates()->GetMTime() != coordinatesTime)
+  {
+    std::cerr << "The texture coordinates were rebuilt for new colors." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (mapper->GetColorTextureMap()->GetMTime() <= textureTime)
+  {
+    std::cerr << "The color texture map was not rebuilt for new colors." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // New range.
+  mapper->SetScalarRange(0.0, 2.0);
+  mapper->MapScalars(1.0);
+  if (mapper->GetColorCoordinates()->GetMTime() <= coordinatesTime ||
+    mapper->GetColorCoordinates()->GetValue(2) == coordinate)
+  {
+    std::cerr << "The texture coordinates were not rebuilt for a new range." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modified scalars.
+  const vtkMTimeType rangeTime = mapper->GetColorCoordinates()->GetMTime();
+  scalars->SetValue(2, 0.9f);
+  scalars->Modified();
+  mapper->MapScalars(1.0);
+  if (mapper->GetColorCoordinates()->GetMTime() <= rangeTime)
+  {
+    std::cerr << "The texture coordinates were not rebuilt for modified scalars." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -11,21 +11,51 @@
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
 #include "vtkObjectFactory.h"
-#include "vtkSortDataArray.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
-#include <stack>
-#include <utility>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
 
 //------------------------------------------------------------------------------
 
-typedef std::pair<vtkIdType, vtkIdType> vtkIdPair;
-
 VTK_ABI_NAMESPACE_BEGIN
-class vtkCellCenterDepthSortStack
+namespace
+{
+// The radix sort processes the 32 bits of the keys in 3 passes of 11 bits.
+const int RadixBits = 11;
+const int RadixSize = 1 << RadixBits;
+const int RadixPasses = 3;
+
+// The number of cells sorted by every task of the radix sort.
+const vtkIdType RadixBlockSize = 65536;
+
+//------------------------------------------------------------------------------
+// Map a float on an unsigned integer with the same order.
+inline uint32_t DepthToKey(float depth)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &depth, sizeof(bits));
+  return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+}
+
+class vtkCellCenterDepthSortInternals
 {
 public:
-  std::stack<vtkIdPair> Stack;
+  // The depths of SortedCells, and the next cell to return.
+  std::vector<float> SortedDepths;
+  vtkIdType NextCell = 0;
+
+  // Whether SortedCells holds the order of the previous traversal.
+  bool HasOrder = false;
+
+  // The buffers of the radix sort.
+  std::vector<uint32_t> Keys[2];
+  std::vector<vtkIdType> Ids[2];
+  std::vector<std::array<vtkIdType, RadixSize>> Histograms;
 };
 
 //------------------------------------------------------------------------------
@@ -46,7 +76,7 @@ vtkCellCenterDepthSort::vtkCellCenterDepthSort()
   this->CellPartitionDepths = vtkFloatArray::New();
   this->CellPartitionDepths->SetNumberOfComponents(1);
 
-  this->ToSort = new vtkCellCenterDepthSortStack;
+  this->Internals = new vtkCellCenterDepthSortInternals;
 }
 
 vtkCellCenterDepthSort::~vtkCellCenterDepthSort()
@@ -57,7 +87,7 @@ vtkCellCenterDepthSort::~vtkCellCenterDepthSort()
   this->CellDepths->Delete();
   this->CellPartitionDepths->Delete();
 
-  delete this->ToSort;
+  delete this->Internals;
 }
 
 void vtkCellCenterDepthSort::PrintSelf(ostream& os, vtkIndent indent)
@@ -135,16 +165,142 @@ void vtkCellCenterDepthSort::ComputeCellCenters()
 
 void vtkCellCenterDepthSort::ComputeDepths()
 {
-  float* vector = this->ComputeProjectionVector();
+  const float* vector = this->ComputeProjectionVector();
+  const float v[3] = { vector[0], vector[1], vector[2] };
   vtkIdType numcells = this->Input->GetNumberOfCells();
 
-  float* center = this->CellCenters->GetPointer(0);
-  float* depth = this->CellDepths->GetPointer(0);
-  for (vtkIdType i = 0; i < numcells; i++)
+  const float* centers = this->CellCenters->GetPointer(0);
+  float* depths = this->CellDepths->GetPointer(0);
+  vtkSMPTools::For(0, numcells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      depths[i] = vtkMath::Dot(centers + 3 * i, v);
+    }
+  });
+}
+
+void vtkCellCenterDepthSort::RadixSortCells()
+{
+  vtkCellCenterDepthSortInternals* internals = this->Internals;
+  const vtkIdType numcells = this->SortedCells->GetNumberOfTuples();
+  const vtkIdType numblocks =
+    std::max<vtkIdType>(1, (numcells + RadixBlockSize - 1) / RadixBlockSize);
+  const float* depths = this->CellDepths->GetPointer(0);
+  const vtkIdType* cellIds = this->SortedCells->GetPointer(0);
+
+  for (int i = 0; i < 2; ++i)
   {
-    *(depth++) = vtkMath::Dot(center, vector);
-    center += 3;
+    internals->Keys[i].resize(numcells);
+    internals->Ids[i].resize(numcells);
+  }
+  internals->Histograms.resize(numblocks);
+  uint32_t* keys = internals->Keys[0].data();
+  vtkIdType* ids = internals->Ids[0].data();
+  vtkSMPTools::For(0, numcells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      ids[i] = cellIds[i];
+      keys[i] = DepthToKey(depths[cellIds[i]]);
+    }
+  });
+
+  // Every pass is a stable counting sort of a digit: the blocks count their
+  // digits, and then scatter their cells after the ones of the lower digits
+  // and of the previous blocks.
+  int current = 0;
+  for (int pass = 0; pass < RadixPasses; ++pass)
+  {
+    const int shift = pass * RadixBits;
+    const uint32_t* inKeys = internals->Keys[current].data();
+    const vtkIdType* inIds = internals->Ids[current].data();
+    uint32_t* outKeys = internals->Keys[1 - current].data();
+    vtkIdType* outIds = internals->Ids[1 - current].data();
+    auto& histograms = internals->Histograms;
+
+    vtkSMPTools::For(0, numblocks, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        auto& histogram = histograms[block];
+        histogram.fill(0);
+        const vtkIdType last = std::min(numcells, (block + 1) * RadixBlockSize);
+        for (vtkIdType i = block * RadixBlockSize; i < last; ++i)
+        {
+          ++histogram[(inKeys[i] >> shift) & (RadixSize - 1)];
+        }
+      }
+    });
+
+    // The digit is skipped when it is the same for all the cells.
+    bool sameDigit = false;
+    for (int digit = 0; digit < RadixSize && !sameDigit; ++digit)
+    {
+      vtkIdType count = 0;
+      for (vtkIdType block = 0; block < numblocks; ++block)
+      {
+        count += histograms[block][digit];
+      }
+      sameDigit = count == numcells;
+    }
+    if (sameDigit)
+    {
+      continue;
+    }
+
+    vtkIdType offset = 0;
+    for (int digit = 0; digit < RadixSize; ++digit)
+    {
+      for (vtkIdType block = 0; block < numblocks; ++block)
+      {
+        const vtkIdType count = histograms[block][digit];
+        histograms[block][digit] = offset;
+        offset += count;
+      }
+    }
+
+    vtkSMPTools::For(0, numblocks, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        auto& offsets = histograms[block];
+        const vtkIdType last = std::min(numcells, (block + 1) * RadixBlockSize);
+        for (vtkIdType i = block * RadixBlockSize; i < last; ++i)
+        {
+          const vtkIdType index = offsets[(inKeys[i] >> shift) & (RadixSize - 1)]++;
+          outKeys[index] = inKeys[i];
+          outIds[index] = inIds[i];
+        }
+      }
+    });
+    current = 1 - current;
+  }
+
+  std::copy(internals->Ids[current].begin(), internals->Ids[current].end(),
+    this->SortedCells->GetPointer(0));
+}
+
+bool vtkCellCenterDepthSort::FixUpSortedCells()
+{
+  const vtkIdType numcells = this->SortedCells->GetNumberOfTuples();
+  vtkIdType* cellIds = this->SortedCells->GetPointer(0);
+  const float* depths = this->CellDepths->GetPointer(0);
+
+  vtkIdType moves = 0;
+  for (vtkIdType i = 1; i < numcells; i++)
+  {
+    const vtkIdType cellId = cellIds[i];
+    const float depth = depths[cellId];
+    vtkIdType j = i;
+    for (; j > 0 && depths[cellIds[j - 1]] > depth; --j)
+    {
+      cellIds[j] = cellIds[j - 1];
+    }
+    cellIds[j] = cellId;
+    moves += i - j;
+    if (moves > numcells)
+    {
+      return false;
+    }
   }
+  return true;
 }
 
 void vtkCellCenterDepthSort::InitTraversal()
@@ -152,6 +308,7 @@ void vtkCellCenterDepthSort::InitTraversal()
   vtkDebugMacro("InitTraversal");
 
   vtkIdType numcells = this->Input->GetNumberOfCells();
+  vtkCellCenterDepthSortInternals* internals = this->Internals;
 
   if ((this->LastSortTime < this->Input->GetMTime()) || (this->LastSortTime < this->MTime))
   {
@@ -161,80 +318,62 @@ void vtkCellCenterDepthSort::InitTraversal()
     this->ComputeCellCenters();
     this->CellDepths->SetNumberOfTuples(numcells);
     this->SortedCells->SetNumberOfTuples(numcells);
-  }
-
-  vtkDebugMacro("Filling SortedCells to initial values.");
-  vtkIdType* id = this->SortedCells->GetPointer(0);
-  for (vtkIdType i = 0; i < numcells; i++)
-  {
-    *(id++) = i;
+    internals->HasOrder = false;
   }
 
   vtkDebugMacro("Calculating depths.");
   this->ComputeDepths();
 
-  while (!this->ToSort->Stack.empty())
-    this->ToSort->Stack.pop();
-  this->ToSort->Stack.emplace(0, numcells);
+  // Start from the order of the previous traversal if the cells did not
+  // change.
+  if (!internals->HasOrder || !this->FixUpSortedCells())
+  {
+    vtkDebugMacro("Sorting the cells.");
+    if (!internals->HasOrder)
+    {
+      vtkIdType* id = this->SortedCells->GetPointer(0);
+      for (vtkIdType i = 0; i < numcells; i++)
+      {
+        *(id++) = i;
+      }
+    }
+    this->RadixSortCells();
+    internals->HasOrder = true;
+  }
+
+  internals->SortedDepths.resize(numcells);
+  const vtkIdType* cellIds = this->SortedCells->GetPointer(0);
+  const float* depths = this->CellDepths->GetPointer(0);
+  float* sortedDepths = internals->SortedDepths.data();
+  vtkSMPTools::For(0, numcells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      sortedDepths[i] = depths[cellIds[i]];
+    }
+  });
+  internals->NextCell = 0;
 
   this->LastSortTime.Modified();
 }
 
 vtkIdTypeArray* vtkCellCenterDepthSort::GetNextCells()
 {
-  if (this->ToSort->Stack.empty())
+  vtkCellCenterDepthSortInternals* internals = this->Internals;
+  const vtkIdType numcells = this->SortedCells->GetNumberOfTuples();
+  if (internals->NextCell >= numcells)
   {
     // Already sorted and returned everything.
     return nullptr;
   }
 
-  vtkIdType* cellIds = this->SortedCells->GetPointer(0);
-  float* cellDepths = this->CellDepths->GetPointer(0);
-  vtkIdPair partition;
-
-  partition = this->ToSort->Stack.top();
-  this->ToSort->Stack.pop();
-  while (partition.second - partition.first > this->MaxCellsReturned)
-  {
-    vtkIdType left = partition.first;
-    vtkIdType right = partition.second - 1;
-    float pivot = cellDepths[static_cast<vtkIdType>(vtkMath::Random(left, right))];
-    while (left <= right)
-    {
-      while ((left <= right) && (cellDepths[left] < pivot))
-        left++;
-      while ((left <= right) && (cellDepths[right] > pivot))
-        right--;
-
-      if (left > right)
-        break;
-
-      std::swap(cellIds[left], cellIds[right]);
-      std::swap(cellDepths[left], cellDepths[right]);
-
-      left++;
-      right--;
-    }
-
-    this->ToSort->Stack.emplace(left, partition.second);
-    partition.second = left;
-  }
-
-  if (partition.second <= partition.first)
-  {
-    // Got a partition of zero size.  Just recurse to get the next one.
-    return this->GetNextCells();
-  }
-
-  vtkIdType firstcell = partition.first;
-  vtkIdType numcells = partition.second - partition.first;
-
-  this->SortedCellPartition->SetArray(cellIds + firstcell, numcells, 1);
-  this->SortedCellPartition->SetNumberOfTuples(numcells);
-  this->CellPartitionDepths->SetArray(cellDepths + firstcell, numcells, 1);
-  this->CellPartitionDepths->SetNumberOfTuples(numcells);
+  vtkIdType firstcell = internals->NextCell;
+  vtkIdType count = std::min<vtkIdType>(this->MaxCellsReturned, numcells - firstcell);
+  internals->NextCell += count;
 
-  vtkSortDataArray::Sort(this->CellPartitionDepths, this->SortedCellPartition);
+  this->SortedCellPartition->SetArray(this->SortedCells->GetPointer(firstcell), count, 1);
+  this->SortedCellPartition->SetNumberOfTuples(count);
+  this->CellPartitionDepths->SetArray(internals->SortedDepths.data() + firstcell, count, 1);
+  this->CellPartitionDepths->SetNumberOfTuples(count);
   return this->SortedCellPartition;
 }
 VTK_ABI_NAMESPACE_END
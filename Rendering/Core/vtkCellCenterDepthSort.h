@@ -11,8 +11,13 @@
  * sort, but it only provides approximate results.  The sorting algorithm
  * finds the centroids of all the cells.  It then performs the dot product
  * of the centroids against a vector pointing in the direction of the
- * camera transformed into object space.  It then performs an ordinary sort
- * on the result.
+ * camera transformed into object space.  It then sorts the cells on the
+ * result with a parallel radix sort.
+ *
+ * The order of the previous traversal is reused when the input has not
+ * changed: as long as the camera moved only slightly, an insertion sort
+ * fixes it up in about linear time. If it needs too many moves, the cells
+ * are sorted again with the radix sort.
  *
  */
 
@@ -25,7 +30,7 @@
 VTK_ABI_NAMESPACE_BEGIN
 class vtkFloatArray;
 
-class vtkCellCenterDepthSortStack;
+class vtkCellCenterDepthSortInternals;
 
 class VTKRENDERINGCORE_EXPORT vtkCellCenterDepthSort : public vtkVisibilitySort
 {
@@ -52,8 +57,20 @@ protected:
   virtual void ComputeCellCenters();
   virtual void ComputeDepths();
 
+  /**
+   * Sort SortedCells by increasing CellDepths with a radix sort.
+   */
+  void RadixSortCells();
+
+  /**
+   * Sort SortedCells by increasing CellDepths with an insertion sort, which
+   * is fast if the cells are almost sorted. Return false, leaving SortedCells
+   * partially sorted, if more moves than cells are needed.
+   */
+  bool FixUpSortedCells();
+
 private:
-  vtkCellCenterDepthSortStack* ToSort;
+  vtkCellCenterDepthSortInternals* Internals;
 
   vtkCellCenterDepthSort(const vtkCellCenterDepthSort&) = delete;
   void operator=(const vtkCellCenterDepthSort&) = delete;
@@ -9,6 +9,9 @@
 #include "vtkCompositePolyDataMapper.h"
 
 #include "vtkActor.h"
+#include "vtkBinnedDecimation.h"
+#include "vtkCamera.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCommand.h"
 #include "vtkCompositeDataDisplayAttributes.h"
@@ -24,6 +27,7 @@
 #include "vtkInformation.h"
 #include "vtkMapper.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -33,14 +37,116 @@
 #include "vtkRenderer.h"
 #include "vtkScalarsToColors.h"
 #include "vtkTexture.h"
+#include "vtkThreadedCallbackQueue.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
 #include <map>
+#include <memory>
 #include <stack>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCompositePolyDataMapper);
 
+namespace
+{
+// Blocks with fewer triangles are always rendered at full resolution.
+const vtkIdType LODMinimumNumberOfTriangles = 1024;
+const int LODMaximumNumberOfLevels = 6;
+
+// The levels of detail of a block, from the finest to the coarsest. They are
+// built in the background and only used once Ready is set.
+struct LODChain
+{
+  vtkPolyData* Source = nullptr;
+  vtkMTimeType SourceMTime = 0;
+  double Bounds[6];
+  std::vector<vtkSmartPointer<vtkPolyData>> Levels;
+  // The size of the bins of each level, in the coordinates of the block.
+  std::vector<double> Errors;
+  std::atomic<bool> Ready{ false };
+};
+
+//------------------------------------------------------------------------------
+bool IsLODCandidate(vtkPolyData* polydata)
+{
+  return polydata->GetNumberOfVerts() == 0 && polydata->GetNumberOfLines() == 0 &&
+    polydata->GetNumberOfStrips() == 0 &&
+    polydata->GetNumberOfPolys() >= LODMinimumNumberOfTriangles &&
+    polydata->GetPolys()->IsHomogeneous() == 3;
+}
+
+//------------------------------------------------------------------------------
+// Decimate the block with coarser and coarser bins, each level keeping at
+// most three quarters of the triangles of the previous one.
+void BuildLODChain(LODChain& chain, vtkPolyData* input)
+{
+  vtkIdType numberOfTriangles = input->GetNumberOfPolys();
+  int divisions = std::max(2, static_cast<int>(std::sqrt(numberOfTriangles / 2.0) / 2.0));
+  std::vector<vtkSmartPointer<vtkPolyData>> levels;
+  std::vector<double> errors;
+  while (divisions >= 2 && static_cast<int>(levels.size()) < LODMaximumNumberOfLevels)
+  {
+    vtkNew<vtkBinnedDecimation> decimation;
+    decimation->SetInputData(input);
+    decimation->SetNumberOfDivisions(divisions, divisions, divisions);
+    decimation->SetPointGenerationModeToBinPoints();
+    decimation->ProducePointDataOn();
+    decimation->ProduceCellDataOn();
+    decimation->Update();
+    vtkPolyData* output = decimation->GetOutput();
+    const vtkIdType levelTriangles = output->GetNumberOfPolys();
+    if (levelTriangles == 0 || output->GetNumberOfPoints() == 0)
+    {
+      break;
+    }
+    if (levelTriangles <= 3 * numberOfTriangles / 4)
+    {
+      vtkSmartPointer<vtkPolyData> level = vtkSmartPointer<vtkPolyData>::New();
+      level->ShallowCopy(output);
+      levels.emplace_back(level);
+      errors.push_back(vtkMath::Norm(decimation->GetDivisionSpacing()));
+      numberOfTriangles = levelTriangles;
+    }
+    divisions /= 2;
+  }
+  chain.Levels.swap(levels);
+  chain.Errors.swap(errors);
+  chain.Ready.store(true);
+}
+
+//------------------------------------------------------------------------------
+// Gather the polydata of the tree with the flat indices of BuildRenderValues.
+void CollectPolyData(vtkDataObject* dobj, unsigned int& flatIndex,
+  std::vector<std::pair<unsigned int, vtkPolyData*>>& blocks)
+{
+  const unsigned int index = flatIndex++;
+  if (auto dObjTree = vtkDataObjectTree::SafeDownCast(dobj))
+  {
+    using Opts = vtk::DataObjectTreeOptions;
+    for (vtkDataObject* child : vtk::Range(dObjTree, Opts::None))
+    {
+      if (!child)
+      {
+        ++flatIndex;
+      }
+      else
+      {
+        CollectPolyData(child, flatIndex, blocks);
+      }
+    }
+  }
+  else if (auto polydata = vtkPolyData::SafeDownCast(dobj))
+  {
+    blocks.emplace_back(index, polydata);
+  }
+}
+}
+
 class vtkCompositePolyDataMapper::vtkInternals
 {
 public:
@@ -76,6 +182,26 @@ public:
    */
   std::map<vtkPolyDataMapper::MapperHashType, vtkSmartPointer<vtkCompositePolyDataMapperDelegator>>
     BatchedDelegators;
+
+  /**
+   * Levels of detail of the blocks by flat index, the selected levels (0 is
+   * the block itself) and the queue building the chains.
+   */
+  std::map<unsigned int, std::shared_ptr<LODChain>> LODChains;
+  std::map<unsigned int, int> LODLevels;
+  vtkTimeStamp LODSelectionTime;
+  vtkIdType LastNumberOfTriangles = 0;
+  vtkSmartPointer<vtkThreadedCallbackQueue> LODQueue;
+
+  vtkPolyData* GetLODPolyData(vtkPolyData* polydata, unsigned int flatIndex)
+  {
+    auto level = this->LODLevels.find(flatIndex);
+    if (level == this->LODLevels.end())
+    {
+      return polydata;
+    }
+    return this->LODChains[flatIndex]->Levels[level->second - 1];
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -179,6 +305,8 @@ void vtkCompositePolyDataMapper::ShallowCopy(vtkAbstractMapper* mapper)
     this->SetCompositeIdArrayName(cpdm->GetCompositeIdArrayName());
     this->SetPointIdArrayName(cpdm->GetPointIdArrayName());
     this->SetProcessIdArrayName(cpdm->GetProcessIdArrayName());
+    this->SetAutomaticLOD(cpdm->GetAutomaticLOD());
+    this->SetLODScreenSpaceError(cpdm->GetLODScreenSpaceError());
   }
   // Now do superclass
   this->vtkPolyDataMapper::ShallowCopy(mapper);
@@ -238,6 +366,8 @@ void vtkCompositePolyDataMapper::SetPauseShiftScale(bool pauseShiftScale)
 void vtkCompositePolyDataMapper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "AutomaticLOD: " << this->AutomaticLOD << endl;
+  os << indent << "LODScreenSpaceError: " << this->LODScreenSpaceError << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -348,11 +478,14 @@ void vtkCompositePolyDataMapper::Render(vtkRenderer* renderer, vtkActor* actor)
     this->DelegatorMTime.Modified();
   }
 
+  this->UpdateLODSelection(renderer, actor, input);
+
   // rebuild the render values if needed.
   this->TempState.Clear();
   this->TempState.Append(actor->GetProperty()->GetMTime(), "actor mtime");
   this->TempState.Append(this->GetMTime(), "this mtime");
   this->TempState.Append(this->DelegatorMTime, "delegator mtime");
+  this->TempState.Append(internals.LODSelectionTime, "lod selection mtime");
   this->TempState.Append(
     actor->GetTexture() ? actor->GetTexture()->GetMTime() : 0, "texture mtime");
 
@@ -447,10 +580,12 @@ void vtkCompositePolyDataMapper::Render(vtkRenderer* renderer, vtkActor* actor)
     delegators.emplace_back(pair.second);
   }
   this->PreRender(delegators, renderer, actor);
+  this->TimeToDraw = 0.0;
   for (auto& iter : internals.BatchedDelegators)
   {
     auto& delegator = iter.second;
     delegator->GetDelegate()->RenderPiece(renderer, actor);
+    this->TimeToDraw += delegator->GetDelegate()->GetTimeToDraw();
 
     for (auto& polydata : delegator->GetRenderedList())
     {
@@ -460,6 +595,158 @@ void vtkCompositePolyDataMapper::Render(vtkRenderer* renderer, vtkActor* actor)
   this->PostRender(delegators, renderer, actor);
 }
 
+//------------------------------------------------------------------------------
+void vtkCompositePolyDataMapper::UpdateLODSelection(
+  vtkRenderer* renderer, vtkActor* actor, vtkDataObject* input)
+{
+  auto& internals = (*this->Internals);
+  std::vector<std::pair<unsigned int, vtkPolyData*>> blocks;
+  if (this->AutomaticLOD && renderer->GetSelector() == nullptr)
+  {
+    unsigned int flatIndex = 0;
+    CollectPolyData(input, flatIndex, blocks);
+  }
+
+  // Keep the chains of the unmodified blocks and build the missing ones in
+  // the background, on shallow copies of the blocks.
+  std::map<unsigned int, std::shared_ptr<LODChain>> chains;
+  vtkIdType fixedTriangles = 0;
+  for (const auto& block : blocks)
+  {
+    vtkPolyData* polydata = block.second;
+    if (!IsLODCandidate(polydata))
+    {
+      fixedTriangles += polydata->GetNumberOfCells();
+      continue;
+    }
+    auto found = internals.LODChains.find(block.first);
+    if (found != internals.LODChains.end() && found->second->Source == polydata &&
+      found->second->SourceMTime == polydata->GetMTime())
+    {
+      chains[block.first] = found->second;
+      continue;
+    }
+    std::shared_ptr<LODChain> chain = std::make_shared<LODChain>();
+    chain->Source = polydata;
+    chain->SourceMTime = polydata->GetMTime();
+    polydata->GetBounds(chain->Bounds);
+    vtkSmartPointer<vtkPolyData> copy = vtkSmartPointer<vtkPolyData>::New();
+    copy->ShallowCopy(polydata);
+    if (!internals.LODQueue)
+    {
+      internals.LODQueue = vtkSmartPointer<vtkThreadedCallbackQueue>::New();
+    }
+    internals.LODQueue->Push([chain, copy]() { BuildLODChain(*chain, copy); });
+    chains[block.first] = chain;
+  }
+  internals.LODChains.swap(chains);
+
+  // The number of pixels per unit of length at the distance of each block.
+  struct Candidate
+  {
+    unsigned int FlatIndex;
+    const LODChain* Chain;
+    double PixelsPerUnit;
+  };
+  std::vector<Candidate> candidates;
+  vtkCamera* camera = renderer->GetActiveCamera();
+  const double height = renderer->GetSize()[1];
+  vtkMatrix4x4* matrix = actor->GetMatrix();
+  double scale = 0.0;
+  for (int j = 0; j < 3; ++j)
+  {
+    const double column[3] = { matrix->GetElement(0, j), matrix->GetElement(1, j),
+      matrix->GetElement(2, j) };
+    scale = std::max(scale, vtkMath::Norm(column));
+  }
+  for (const auto& item : internals.LODChains)
+  {
+    const LODChain* chain = item.second.get();
+    if (!chain->Ready.load())
+    {
+      fixedTriangles += chain->Source->GetNumberOfCells();
+      continue;
+    }
+    double pixelsPerUnit;
+    if (camera->GetParallelProjection())
+    {
+      pixelsPerUnit = height / (2.0 * camera->GetParallelScale());
+    }
+    else
+    {
+      const double* b = chain->Bounds;
+      const double center[4] = { (b[0] + b[1]) / 2.0, (b[2] + b[3]) / 2.0, (b[4] + b[5]) / 2.0,
+        1.0 };
+      double world[4];
+      matrix->MultiplyPoint(center, world);
+      const double radius =
+        scale * std::sqrt(vtkMath::Distance2BetweenPoints(b, b + 3)) / 2.0;
+      const double distance =
+        std::sqrt(vtkMath::Distance2BetweenPoints(world, camera->GetPosition())) - radius;
+      if (distance <= 0.0)
+      {
+        fixedTriangles += chain->Source->GetNumberOfCells();
+        continue;
+      }
+      const double halfAngle = vtkMath::RadiansFromDegrees(camera->GetViewAngle() / 2.0);
+      pixelsPerUnit = height / (2.0 * distance * std::tan(halfAngle));
+    }
+    candidates.push_back({ item.first, chain, scale * pixelsPerUnit });
+  }
+
+  // The triangles that can be drawn in the allocated time, estimated from the
+  // time taken to draw the triangles of the previous render.
+  double budget = VTK_DOUBLE_MAX;
+  if (this->TimeToDraw > 0.0 && internals.LastNumberOfTriangles > 0)
+  {
+    budget = actor->GetAllocatedRenderTime() * internals.LastNumberOfTriangles / this->TimeToDraw;
+  }
+
+  // Select the coarsest levels below the tolerance, doubling it while the
+  // budget is exceeded.
+  std::map<unsigned int, int> levels;
+  vtkIdType numberOfTriangles = fixedTriangles;
+  double tolerance = this->LODScreenSpaceError;
+  for (int iteration = 0; iteration < 32; ++iteration)
+  {
+    levels.clear();
+    numberOfTriangles = fixedTriangles;
+    bool coarsest = true;
+    for (const Candidate& candidate : candidates)
+    {
+      const LODChain* chain = candidate.Chain;
+      int level = 0;
+      while (level < static_cast<int>(chain->Levels.size()) &&
+        chain->Errors[level] * candidate.PixelsPerUnit <= tolerance)
+      {
+        ++level;
+      }
+      coarsest &= level == static_cast<int>(chain->Levels.size());
+      if (level > 0)
+      {
+        levels[candidate.FlatIndex] = level;
+        numberOfTriangles += chain->Levels[level - 1]->GetNumberOfPolys();
+      }
+      else
+      {
+        numberOfTriangles += chain->Source->GetNumberOfPolys();
+      }
+    }
+    if (coarsest || numberOfTriangles <= budget)
+    {
+      break;
+    }
+    tolerance = std::max(2.0 * tolerance, 1.0);
+  }
+  internals.LastNumberOfTriangles = numberOfTriangles;
+
+  if (levels != internals.LODLevels)
+  {
+    internals.LODLevels.swap(levels);
+    internals.LODSelectionTime.Modified();
+  }
+}
+
 //------------------------------------------------------------------------------
 vtkCompositePolyDataMapper::MapperHashType vtkCompositePolyDataMapper::InsertPolyData(
   vtkPolyData* polydata, const unsigned int& flatIndex)
@@ -660,15 +947,16 @@ void vtkCompositePolyDataMapper::BuildRenderValues(
     this->PrototypeMapper->SetScalarRange(internals.BlockState.ScalarRange.top().GetData());
     this->PrototypeMapper->SetLookupTable(internals.BlockState.LookupTable.top());
 
-    const auto hash = this->InsertPolyData(polydata, originalFlatIndex);
+    vtkPolyData* rendered = internals.GetLODPolyData(polydata, originalFlatIndex);
+    const auto hash = this->InsertPolyData(rendered, originalFlatIndex);
     if (hash == std::numeric_limits<MapperHashType>::max())
     {
       return;
     }
-    vtkDebugMacro(<< "Inserted " << polydata << " at " << hash);
+    vtkDebugMacro(<< "Inserted " << rendered << " at " << hash);
     const auto& delegator = internals.BatchedDelegators[hash];
     // because it was incremented few lines above.
-    if (auto inputItem = delegator->Get(polydata))
+    if (auto inputItem = delegator->Get(rendered))
     {
       // Capture the display attributes in the batch element.
       inputItem->Opacity = internals.BlockState.Opacity.top();
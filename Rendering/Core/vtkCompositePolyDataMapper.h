@@ -195,6 +195,31 @@ public:
   vtkBooleanMacro(ColorMissingArraysWithNanColor, bool);
   ///@}
 
+  ///@{
+  /**
+   * When on, chains of levels of detail are built in the background for the
+   * blocks made only of triangles, with vtkBinnedDecimation. Each block is
+   * then rendered with its coarsest level whose error, projected on the
+   * screen, is below LODScreenSpaceError. When the render time allocated to
+   * the actor by the desired update rate of the render window is too short
+   * to draw the selected triangles, the tolerance is raised until it is not.
+   * Blocks are rendered at full resolution until their levels are built and
+   * during hardware selections. Default is false.
+   */
+  vtkSetMacro(AutomaticLOD, bool);
+  vtkGetMacro(AutomaticLOD, bool);
+  vtkBooleanMacro(AutomaticLOD, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the error in pixels tolerated for the levels of detail when
+   * AutomaticLOD is on. Default is 1.
+   */
+  vtkSetClampMacro(LODScreenSpaceError, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(LODScreenSpaceError, double);
+  ///@}
+
   ///@{
   /**
    * Call SetInputArrayToProcess on helpers.
@@ -339,6 +364,12 @@ protected:
   void BuildRenderValues(
     vtkRenderer* renderer, vtkActor* actor, vtkDataObject* dobj, unsigned int& flat_index);
 
+  /**
+   * Select the levels of detail of the blocks for this render and request the
+   * chains of the blocks that do not have one yet.
+   */
+  void UpdateLODSelection(vtkRenderer* renderer, vtkActor* actor, vtkDataObject* input);
+
   /**
    * A prototype of the object factory override mapper.
    * This prototype is reused to hash multiple polydata instead
@@ -357,6 +388,9 @@ protected:
    */
   bool ColorMissingArraysWithNanColor = false;
 
+  bool AutomaticLOD = false;
+  double LODScreenSpaceError = 1.0;
+
   /**
    * Time stamp for computation of bounds.
    */
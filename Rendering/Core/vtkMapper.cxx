@@ -929,12 +929,50 @@ void vtkMapper::MapScalarsToTexture(vtkAbstractArray* scalars, double alpha)
     this->ColorTextureMap->Register(this);
   }
 
+  if (this->CanComputeColorCoordinatesInShader(scalars))
+  {
+    if (this->ColorCoordinates)
+    {
+      this->ColorCoordinates->UnRegister(this);
+      this->ColorCoordinates = nullptr;
+    }
+    this->ColorCoordinatesState.Clear();
+    return;
+  }
+
+  int scalarComponent;
+  // Although I like the feature of applying magnitude to single component
+  // scalars, it is not how the old MapScalars for vertex coloring works.
+  if (this->LookupTable->GetVectorMode() == vtkScalarsToColors::MAGNITUDE &&
+    scalars->GetNumberOfComponents() > 1)
+  {
+    scalarComponent = -1;
+  }
+  else
+  {
+    scalarComponent = this->LookupTable->GetVectorComponent();
+  }
+
   // Create new coordinates if necessary.
-  // Need to compare lookup table in case the range has changed.
-  if (this->ColorCoordinates == nullptr || this->GetMTime() > this->ColorCoordinates->GetMTime() ||
+  // Need to compare the lookup table values in case the range has changed,
+  // a change of its colors alone only needs a new texture map.
+  vtkStateStorage state;
+  state.Append(scalars, "scalars");
+  state.Append(scalars->GetMTime(), "scalars mtime");
+  state.Append(range[0], "range0");
+  state.Append(range[1], "range1");
+  state.Append(this->LookupTable->GetRange()[0], "table range0");
+  state.Append(this->LookupTable->GetRange()[1], "table range1");
+  state.Append(this->LookupTable->GetNumberOfAvailableColors(), "number of colors");
+  state.Append(use_log_scale, "log scale");
+  state.Append(scalarComponent, "component");
+  if (this->ColorCoordinates == nullptr ||
+    this->vtkAbstractMapper::GetMTime() > this->ColorCoordinates->GetMTime() ||
     this->GetExecutive()->GetInputData(0, 0)->GetMTime() > this->ColorCoordinates->GetMTime() ||
-    this->LookupTable->GetMTime() > this->ColorCoordinates->GetMTime())
+    this->ColorCoordinatesState != state)
   {
+    this->ColorCoordinatesState = state;
+
     // Get rid of old colors
     if (this->ColorCoordinates)
     {
@@ -950,18 +988,6 @@ void vtkMapper::MapScalarsToTexture(vtkAbstractArray* scalars, double alpha)
     this->ColorCoordinates->SetNumberOfComponents(2);
     this->ColorCoordinates->SetNumberOfTuples(num);
     float* output = this->ColorCoordinates->GetPointer(0);
-    int scalarComponent;
-    // Although I like the feature of applying magnitude to single component
-    // scalars, it is not how the old MapScalars for vertex coloring works.
-    if (this->LookupTable->GetVectorMode() == vtkScalarsToColors::MAGNITUDE &&
-      scalars->GetNumberOfComponents() > 1)
-    {
-      scalarComponent = -1;
-    }
-    else
-    {
-      scalarComponent = this->LookupTable->GetVectorComponent();
-    }
     switch (scalars->GetDataType())
     {
       vtkTemplateMacro(CreateColorTextureCoordinates(static_cast<VTK_TT*>(input), output, num,
@@ -38,6 +38,7 @@
 #include "vtkAbstractMapper3D.h"
 #include "vtkRenderingCoreModule.h" // For export macro
 #include "vtkSmartPointer.h"        // needed for vtkSmartPointer.
+#include "vtkStateStorage.h"        // for ivar
 #include "vtkSystemIncludes.h"      // For VTK_COLOR_MODE_DEFAULT and _MAP_SCALARS
 #include "vtkWrappingHints.h"       // For VTK_MARSHALAUTO
 #include <vector>                   // for method args
@@ -522,8 +523,22 @@ protected:
   vtkFloatArray* ColorCoordinates;
   // 1D ColorMap used for the texture image.
   vtkImageData* ColorTextureMap;
+  // Values of the scalars and lookup table the ColorCoordinates depend on,
+  // so that editing the colors of the lookup table only rebuilds the texture.
+  vtkStateStorage ColorCoordinatesState;
   void MapScalarsToTexture(vtkAbstractArray* scalars, double alpha);
 
+  /**
+   * Return true when the subclass computes the texture coordinates of the
+   * scalars from the scalars themselves, e.g. in a shader. MapScalarsToTexture
+   * then only builds the ColorTextureMap and leaves ColorCoordinates empty.
+   * Returns false by default.
+   */
+  virtual bool CanComputeColorCoordinatesInShader(vtkAbstractArray* vtkNotUsed(scalars))
+  {
+    return false;
+  }
+
   vtkScalarsToColors* LookupTable;
   vtkTypeBool ScalarVisibility;
   vtkTimeStamp BuildTime;
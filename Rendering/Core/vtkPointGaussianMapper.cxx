@@ -59,5 +59,6 @@ void vtkPointGaussianMapper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OpacityTableSize: " << this->OpacityTableSize << "\n";
   os << indent << "ScaleTableSize: " << this->ScaleTableSize << "\n";
   os << indent << "BoundScale: " << this->BoundScale << "\n";
+  os << indent << "PointBudget: " << this->PointBudget << "\n";
 }
 VTK_ABI_NAMESPACE_END
@@ -192,6 +192,23 @@ public:
   vtkGetVector3Macro(LowpassMatrix, float);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get the maximum number of splats drawn in a frame, in the visible
+   * part of the bounds of the input. The default is 0, meaning that all the
+   * splats are drawn. When a budget is set, the splats are sorted in the
+   * levels of detail of an octree over the bounds of the points, so that
+   * the first ones cover the bounds uniformly and the next ones refine them.
+   * Each frame draws the most detailed prefix of that order that puts about
+   * PointBudget splats in the view frustum, which keeps the frame rate of
+   * very large point clouds bounded. The budget of composite inputs is
+   * shared between the blocks in proportion of their number of splats. The
+   * hardware selection always draws all the splats.
+   */
+  vtkSetClampMacro(PointBudget, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(PointBudget, vtkIdType);
+  ///@}
+
   /**
    * WARNING: INTERNAL METHOD - NOT INTENDED FOR GENERAL USE
    * DO NOT USE THIS METHOD OUTSIDE OF THE RENDERING PROCESS
@@ -221,6 +238,8 @@ protected:
 
   float BoundScale;
 
+  vtkIdType PointBudget = 0;
+
 private:
   vtkPointGaussianMapper(const vtkPointGaussianMapper&) = delete;
   void operator=(const vtkPointGaussianMapper&) = delete;
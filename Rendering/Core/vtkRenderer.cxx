@@ -113,6 +113,7 @@ vtkRenderer::vtkRenderer()
 
   this->UseDepthPeeling = 0;
   this->UseDepthPeelingForVolumes = false;
+  this->UseWeightedBlendedTranslucency = false;
   this->OcclusionRatio = 0.0;
   this->MaximumNumberOfPeels = 4;
   this->LastRenderingUsedDepthPeeling = 0;
@@ -1762,6 +1763,9 @@ void vtkRenderer::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "UseDepthPeeling: " << (this->UseDepthPeeling ? "On" : "Off") << "\n";
 
+  os << indent << "UseWeightedBlendedTranslucency: "
+     << (this->UseWeightedBlendedTranslucency ? "On" : "Off") << "\n";
+
   os << indent << "OcclusionRation: " << this->OcclusionRatio << "\n";
 
   os << indent << "MaximumNumberOfPeels: " << this->MaximumNumberOfPeels << "\n";
@@ -671,6 +671,19 @@ public:
   vtkGetMacro(UseDepthPeelingForVolumes, bool);
   vtkBooleanMacro(UseDepthPeelingForVolumes, bool);
 
+  ///@{
+  /**
+   * Turn on/off weighted blended order-independent translucency when depth
+   * peeling is off. The translucent fragments are then weighted by their
+   * depth and opacity in a single geometry pass, and the volumes are
+   * composited with the translucent geometry instead of over it. Only
+   * supported on OpenGL2. Initial value is off.
+   */
+  vtkSetMacro(UseWeightedBlendedTranslucency, bool);
+  vtkGetMacro(UseWeightedBlendedTranslucency, bool);
+  vtkBooleanMacro(UseWeightedBlendedTranslucency, bool);
+  ///@}
+
   ///@{
   /**
    * In case of use of depth peeling technique for rendering translucent
@@ -1097,6 +1110,13 @@ protected:
    */
   bool UseDepthPeelingForVolumes;
 
+  /**
+   * Weight the translucent fragments by their depth and composite the
+   * volumes with them when depth peeling is off.
+   * Initial value is false.
+   */
+  bool UseWeightedBlendedTranslucency;
+
   /**
    * In case of use of depth peeling technique for rendering translucent
    * material, define the threshold under which the algorithm stops to
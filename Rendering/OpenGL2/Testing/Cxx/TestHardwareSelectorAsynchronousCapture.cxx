@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Capture the selection buffers of a few spheres synchronously and
+// asynchronously with vtkOpenGLHardwareSelector, and check that the
+// asynchronous capture completes in a later render with the same pixel
+// information.
+
+#include "vtkActor.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkDataObject.h"
+#include "vtkNew.h"
+#include "vtkOpenGLHardwareSelector.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const int Size = 200;
+const int Step = 10;
+
+//------------------------------------------------------------------------------
+void SelectionChanged(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+//------------------------------------------------------------------------------
+std::vector<vtkHardwareSelector::PixelInformation> GetPixelInformation(
+  vtkHardwareSelector* selector)
+{
+  std::vector<vtkHardwareSelector::PixelInformation> infos;
+  for (unsigned int y = 0; y < Size; y += Step)
+  {
+    for (unsigned int x = 0; x < Size; x += Step)
+    {
+      const unsigned int position[2] = { x, y };
+      infos.push_back(selector->GetPixelInformation(position));
+    }
+  }
+  return infos;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestHardwareSelectorAsynchronousCapture(int, char*[])
+{
+  vtkNew<vtkRenderer> renderer;
+  for (int i = 0; i < 3; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(i - 1.0, 0.5 * (i - 1), 0.0);
+    sphere->SetRadius(0.6);
+    vtkNew<vtkPolyDataMapper> mapper;
+    mapper->SetInputConnection(sphere->GetOutputPort());
+    vtkNew<vtkActor> actor;
+    actor->SetMapper(mapper);
+    renderer->AddActor(actor);
+  }
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(Size, Size);
+  renWin->AddRenderer(renderer);
+  renderer->ResetCamera();
+  renWin->Render();
+
+  vtkNew<vtkOpenGLHardwareSelector> selector;
+  selector->SetRenderer(renderer);
+  selector->SetArea(0, 0, Size - 1, Size - 1);
+  selector->SetFieldAssociation(vtkDataObject::FIELD_ASSOCIATION_CELLS);
+  if (!selector->CaptureBuffers())
+  {
+    std::cerr << "The selection buffers could not be captured." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::vector<vtkHardwareSelector::PixelInformation> expected =
+    GetPixelInformation(selector);
+  selector->ClearBuffers();
+
+  int completed = 0;
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(SelectionChanged);
+  callback->SetClientData(&completed);
+  selector->AddObserver(vtkCommand::SelectionChangedEvent, callback);
+  if (!selector->CaptureBuffersAsynchronously() || !selector->GetAsynchronousCapturePending())
+  {
+    std::cerr << "The asynchronous capture could not be started." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (completed || selector->GetPixelBuffer(vtkHardwareSelector::ACTOR_PASS))
+  {
+    std::cerr << "The asynchronous capture completed before rendering." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (int i = 0; i < 100 && !completed; ++i)
+  {
+    renWin->Render();
+  }
+  if (!completed)
+  {
+    selector->FinishAsynchronousCapture(true);
+  }
+  if (completed != 1 || selector->GetAsynchronousCapturePending())
+  {
+    std::cerr << "The asynchronous capture completed " << completed << " times." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<vtkHardwareSelector::PixelInformation> infos = GetPixelInformation(selector);
+  int hits = 0;
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    const vtkHardwareSelector::PixelInformation& a = expected[i];
+    const vtkHardwareSelector::PixelInformation& b = infos[i];
+    if (a.Valid != b.Valid || (a.Valid && (a.Prop != b.Prop || a.AttributeID != b.AttributeID)))
+    {
+      std::cerr << "The pixel information " << i << " differs from the synchronous capture."
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    hits += a.Valid ? 1 : 0;
+  }
+  if (hits == 0)
+  {
+    std::cerr << "No sphere was hit." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Render a sphere colored through a texture with the texture coordinates
+// computed on the CPU and in the shader (MapScalarsInShader), for a linear
+// and a log scale, vector magnitudes and NaN values, and check that the
+// images match.
+
+#include "vtkActor.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkLookupTable.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkOpenGLPolyDataMapper.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Size = 200;
+
+//------------------------------------------------------------------------------
+void Render(vtkPolyData* polydata, bool logScale, bool magnitude, bool inShader,
+  vtkUnsignedCharArray* pixels)
+{
+  vtkNew<vtkLookupTable> lut;
+  lut->SetHueRange(0.0, 0.7);
+  lut->SetNumberOfTableValues(64);
+  lut->SetScale(logScale ? VTK_SCALE_LOG10 : VTK_SCALE_LINEAR);
+  lut->SetVectorMode(magnitude ? vtkScalarsToColors::MAGNITUDE : vtkScalarsToColors::COMPONENT);
+  lut->SetVectorComponent(1);
+  lut->SetNanColor(1.0, 1.0, 1.0, 1.0);
+  lut->Build();
+
+  vtkNew<vtkOpenGLPolyDataMapper> mapper;
+  mapper->SetInputData(polydata);
+  mapper->SetLookupTable(lut);
+  mapper->SetScalarRange(0.1, 1.6);
+  mapper->InterpolateScalarsBeforeMappingOn();
+  mapper->SetMapScalarsInShader(inShader);
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(Size, Size);
+  renWin->AddRenderer(renderer);
+  renderer->ResetCamera();
+  renWin->Render();
+  renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, pixels);
+}
+
+//------------------------------------------------------------------------------
+// The coordinates are computed in single precision in the shader, allow a few
+// pixels on the boundaries between texels to pick the neighboring color.
+bool Match(vtkUnsignedCharArray* a, vtkUnsignedCharArray* b)
+{
+  if (a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  vtkIdType different = 0;
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (std::abs(a->GetTypedComponent(i, c) - b->GetTypedComponent(i, c)) > 8)
+      {
+        ++different;
+        break;
+      }
+    }
+  }
+  return different <= a->GetNumberOfTuples() / 100;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestMapScalarsInShader(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+
+  vtkNew<vtkPolyData> polydata;
+  polydata->ShallowCopy(sphere->GetOutput());
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetNumberOfComponents(2);
+  scalars->SetNumberOfTuples(polydata->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < polydata->GetNumberOfPoints(); ++i)
+  {
+    double p[3];
+    polydata->GetPoint(i, p);
+    scalars->SetComponent(i, 0, p[0] + 0.5);
+    scalars->SetComponent(i, 1, 2.0 * p[2] + 1.0);
+  }
+  // a few NaN values
+  for (vtkIdType i = 0; i < polydata->GetNumberOfPoints(); i += 97)
+  {
+    scalars->SetComponent(i, 1, vtkMath::Nan());
+  }
+  polydata->GetPointData()->SetScalars(scalars);
+
+  for (int logScale = 0; logScale < 2; ++logScale)
+  {
+    for (int magnitude = 0; magnitude < 2; ++magnitude)
+    {
+      vtkNew<vtkUnsignedCharArray> expected;
+      vtkNew<vtkUnsignedCharArray> pixels;
+      Render(polydata, logScale != 0, magnitude != 0, false, expected);
+      Render(polydata, logScale != 0, magnitude != 0, true, pixels);
+      if (!Match(expected, pixels))
+      {
+        std::cerr << "The scalars mapped in the shader render differently with"
+                  << (logScale ? " a log" : " a linear") << " scale and "
+                  << (magnitude ? "magnitudes." : "components.") << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
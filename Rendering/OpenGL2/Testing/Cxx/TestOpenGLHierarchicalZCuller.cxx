@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Render spheres hidden behind a wall and a sphere in front of it with
+// vtkOpenGLHierarchicalZCuller, check that only the hidden spheres are culled
+// and that the image is the one rendered without the culler.
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkCubeSource.h"
+#include "vtkNew.h"
+#include "vtkOpenGLHierarchicalZCuller.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Size = 300;
+const int NumberOfHiddenSpheres = 16;
+
+//------------------------------------------------------------------------------
+void AddSphere(vtkRenderer* renderer, double x, double y, double z)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(x, y, z);
+  sphere->SetRadius(0.4);
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  renderer->AddActor(actor);
+}
+
+//------------------------------------------------------------------------------
+bool Render(vtkOpenGLHierarchicalZCuller* culler, vtkUnsignedCharArray* pixels)
+{
+  vtkNew<vtkRenderer> renderer;
+  if (culler)
+  {
+    renderer->AddCuller(culler);
+  }
+
+  vtkNew<vtkCubeSource> wall;
+  wall->SetBounds(-4.0, 4.0, -4.0, 4.0, -0.1, 0.1);
+  vtkNew<vtkPolyDataMapper> wallMapper;
+  wallMapper->SetInputConnection(wall->GetOutputPort());
+  vtkNew<vtkActor> wallActor;
+  wallActor->SetMapper(wallMapper);
+  renderer->AddActor(wallActor);
+
+  for (int i = 0; i < NumberOfHiddenSpheres; ++i)
+  {
+    AddSphere(renderer, (i % 4) - 1.5, (i / 4) - 1.5, -2.0);
+  }
+  AddSphere(renderer, 0.0, 0.0, 2.0);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(Size, Size);
+  renWin->AddRenderer(renderer);
+  renderer->GetActiveCamera()->SetPosition(0.0, 0.0, 10.0);
+  renderer->GetActiveCamera()->SetFocalPoint(0.0, 0.0, 0.0);
+  renderer->ResetCameraClippingRange();
+
+  // The first frame uses all the props as occluders, the next ones the props
+  // that were not culled.
+  for (int frame = 0; frame < 3; ++frame)
+  {
+    renWin->Render();
+    if (culler && culler->GetNumberOfCulledProps() != NumberOfHiddenSpheres)
+    {
+      std::cerr << "Frame " << frame << ": " << culler->GetNumberOfCulledProps()
+                << " props culled instead of " << NumberOfHiddenSpheres << "." << std::endl;
+      return false;
+    }
+  }
+
+  // Moving the camera behind the wall shows the spheres again.
+  renderer->GetActiveCamera()->Azimuth(180.0);
+  renderer->ResetCameraClippingRange();
+  renWin->Render();
+  if (culler && culler->GetNumberOfCulledProps() != 1)
+  {
+    std::cerr << culler->GetNumberOfCulledProps()
+              << " props culled instead of 1 from behind the wall." << std::endl;
+    return false;
+  }
+
+  renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, pixels);
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestOpenGLHierarchicalZCuller(int, char*[])
+{
+  vtkNew<vtkOpenGLHierarchicalZCuller> culler;
+  vtkNew<vtkUnsignedCharArray> expected;
+  vtkNew<vtkUnsignedCharArray> pixels;
+  if (!Render(nullptr, expected) || !Render(culler, pixels))
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (expected->GetNumberOfValues() != pixels->GetNumberOfValues())
+  {
+    std::cerr << "Unexpected number of pixels." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    if (expected->GetValue(i) != pixels->GetValue(i))
+    {
+      std::cerr << "The culled props render differently." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
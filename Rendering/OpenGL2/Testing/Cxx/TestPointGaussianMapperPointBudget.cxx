@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Render a point cloud with vtkPointGaussianMapper without a point budget,
+// with a budget larger than the number of points and with a small one, and
+// check that only the small budget changes the image, and that zooming on the
+// cloud draws more points for the same budget.
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkNew.h"
+#include "vtkPointGaussianMapper.h"
+#include "vtkPointSource.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Size = 200;
+const int NumberOfPoints = 100000;
+
+//------------------------------------------------------------------------------
+vtkIdType CountLitPixels(vtkUnsignedCharArray* pixels)
+{
+  vtkIdType count = 0;
+  for (vtkIdType i = 0; i < pixels->GetNumberOfTuples(); ++i)
+  {
+    if (pixels->GetValue(3 * i) || pixels->GetValue(3 * i + 1) || pixels->GetValue(3 * i + 2))
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestPointGaussianMapperPointBudget(int, char*[])
+{
+  vtkNew<vtkPointSource> points;
+  points->SetNumberOfPoints(NumberOfPoints);
+  points->SetRadius(10.0);
+
+  vtkNew<vtkPointGaussianMapper> mapper;
+  mapper->SetInputConnection(points->GetOutputPort());
+  mapper->SetScaleFactor(0.0);
+  mapper->EmissiveOff();
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(Size, Size);
+  renWin->SetMultiSamples(0);
+  renWin->AddRenderer(renderer);
+  renderer->ResetCamera();
+
+  vtkNew<vtkUnsignedCharArray> expected;
+  renWin->Render();
+  renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, expected);
+
+  // With a budget larger than the cloud, all the points are drawn.
+  vtkNew<vtkUnsignedCharArray> pixels;
+  mapper->SetPointBudget(2 * NumberOfPoints);
+  renWin->Render();
+  renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, pixels);
+  const vtkIdType expectedLit = CountLitPixels(expected);
+  if (CountLitPixels(pixels) != expectedLit)
+  {
+    std::cerr << "A budget larger than the number of points changes the image." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A small budget draws a subset of the points that covers the cloud.
+  mapper->SetPointBudget(NumberOfPoints / 20);
+  renWin->Render();
+  renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, pixels);
+  const vtkIdType budgetLit = CountLitPixels(pixels);
+  if (budgetLit == 0 || budgetLit >= expectedLit)
+  {
+    std::cerr << "The point budget lights " << budgetLit << " pixels out of " << expectedLit
+              << "." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Zooming on the cloud leaves most of it out of the view, more points are
+  // drawn so that about as many of them as the budget are still visible,
+  // instead of the tenth of the budget that would remain in view.
+  renderer->GetActiveCamera()->Zoom(4.0);
+  renWin->Render();
+  renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, pixels);
+  const vtkIdType zoomedLit = CountLitPixels(pixels);
+  mapper->SetPointBudget(0);
+  renWin->Render();
+  renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, expected);
+  if (zoomedLit < budgetLit / 4 || zoomedLit >= CountLitPixels(expected))
+  {
+    std::cerr << "The zoomed point budget lights " << zoomedLit << " pixels." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Render a sphere with the program binary cache of vtkOpenGLShaderCache
+// enabled, then in new windows loading the cached binaries and with
+// corrupted binaries, and check that the images are identical.
+
+#include "vtkActor.h"
+#include "vtkNew.h"
+#include "vtkOpenGLRenderWindow.h"
+#include "vtkOpenGLShaderCache.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkRenderer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <vtksys/Directory.hxx>
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int Size = 200;
+
+//------------------------------------------------------------------------------
+void Render(const std::string& directory, vtkUnsignedCharArray* pixels)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(Size, Size);
+  renWin->AddRenderer(renderer);
+  renWin->Initialize();
+  vtkOpenGLRenderWindow::SafeDownCast(renWin)->GetShaderCache()->SetProgramBinaryCacheDirectory(
+    directory.c_str());
+  renWin->Render();
+  renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, pixels);
+}
+
+//------------------------------------------------------------------------------
+std::vector<std::string> GetBinaries(const std::string& directory)
+{
+  std::vector<std::string> binaries;
+  vtksys::Directory dir;
+  if (dir.Load(directory))
+  {
+    for (unsigned long i = 0; i < dir.GetNumberOfFiles(); ++i)
+    {
+      const std::string name = dir.GetFile(i);
+      if (vtksys::SystemTools::GetFilenameLastExtension(name) == ".bin")
+      {
+        binaries.push_back(directory + "/" + name);
+      }
+    }
+  }
+  return binaries;
+}
+
+//------------------------------------------------------------------------------
+bool Equal(vtkUnsignedCharArray* a, vtkUnsignedCharArray* b)
+{
+  if (a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetValue(i) != b->GetValue(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestShaderProgramBinaryCache(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string directory = std::string(tempDir) + "/TestShaderProgramBinaryCache";
+  delete[] tempDir;
+  vtksys::SystemTools::RemoveADirectory(directory);
+
+  // Compile the programs and write their binaries.
+  vtkNew<vtkUnsignedCharArray> expected;
+  Render(directory, expected);
+  const std::vector<std::string> binaries = GetBinaries(directory);
+  if (binaries.empty())
+  {
+    std::cout << "Program binaries are not supported, skipping the test." << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Load the programs from their binaries.
+  vtkNew<vtkUnsignedCharArray> pixels;
+  Render(directory, pixels);
+  if (!Equal(pixels, expected))
+  {
+    std::cerr << "The programs loaded from their binaries render differently." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Corrupted binaries are discarded, the programs are compiled again and
+  // their binaries replaced.
+  for (const std::string& binary : binaries)
+  {
+    vtksys::ofstream file(binary.c_str(), std::ios::out | std::ios::binary);
+    file << "not a program binary";
+  }
+  Render(directory, pixels);
+  if (!Equal(pixels, expected))
+  {
+    std::cerr << "The programs compiled after corrupted binaries render differently."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (const std::string& binary : binaries)
+  {
+    if (vtksys::SystemTools::FileLength(binary) <= 32)
+    {
+      std::cerr << "The corrupted binary " << binary << " was not replaced." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtksys::SystemTools::RemoveADirectory(directory);
+  return EXIT_SUCCESS;
+}
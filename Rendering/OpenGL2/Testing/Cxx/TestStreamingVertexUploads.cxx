@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Render a deforming sphere whose points are re-uploaded every frame, with
+// and without the streaming uploads of vtkOpenGLVertexBufferObjectGroup, and
+// check that the images are identical.
+
+#include "vtkActor.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkOpenGLBufferObject.h"
+#include "vtkOpenGLPolyDataMapper.h"
+#include "vtkOpenGLVertexBufferObjectGroup.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Size = 200;
+const int NumberOfFrames = 8;
+
+//------------------------------------------------------------------------------
+void Deform(vtkPoints* reference, vtkPoints* points, vtkFloatArray* scalars, int frame)
+{
+  for (vtkIdType i = 0; i < reference->GetNumberOfPoints(); ++i)
+  {
+    double p[3];
+    reference->GetPoint(i, p);
+    const double factor = 1.0 + 0.2 * std::sin(4.0 * p[2] + 0.7 * frame);
+    points->SetPoint(i, factor * p[0], factor * p[1], p[2]);
+    scalars->SetValue(i, static_cast<float>(factor));
+  }
+  points->Modified();
+  scalars->Modified();
+}
+
+//------------------------------------------------------------------------------
+bool Render(bool streaming, vtkUnsignedCharArray* frames[NumberOfFrames])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  vtkNew<vtkPolyData> polydata;
+  polydata->DeepCopy(sphere->GetOutput());
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("factor");
+  scalars->SetNumberOfTuples(polydata->GetNumberOfPoints());
+  polydata->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkOpenGLPolyDataMapper> mapper;
+  mapper->SetInputData(polydata);
+  mapper->SetScalarRange(0.8, 1.2);
+  mapper->GetVBOs()->SetStreamingUploads(streaming);
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddActor(actor);
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(Size, Size);
+  renWin->AddRenderer(renderer);
+
+  for (int frame = 0; frame < NumberOfFrames; ++frame)
+  {
+    Deform(sphere->GetOutput()->GetPoints(), polydata->GetPoints(), scalars, frame);
+    if (frame == 0)
+    {
+      renderer->ResetCamera();
+      if (streaming)
+      {
+        // make the context current to query it
+        renWin->Render();
+        if (!vtkOpenGLBufferObject::IsStreamingSupported())
+        {
+          return false;
+        }
+      }
+    }
+    renWin->Render();
+    renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, frames[frame]);
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestStreamingVertexUploads(int, char*[])
+{
+  vtkNew<vtkUnsignedCharArray> expected[NumberOfFrames];
+  vtkNew<vtkUnsignedCharArray> pixels[NumberOfFrames];
+  vtkUnsignedCharArray* expectedFrames[NumberOfFrames];
+  vtkUnsignedCharArray* frames[NumberOfFrames];
+  for (int i = 0; i < NumberOfFrames; ++i)
+  {
+    expectedFrames[i] = expected[i];
+    frames[i] = pixels[i];
+  }
+
+  Render(false, expectedFrames);
+  if (!Render(true, frames))
+  {
+    std::cout << "Streaming uploads are not supported, skipping the test." << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  for (int frame = 0; frame < NumberOfFrames; ++frame)
+  {
+    vtkUnsignedCharArray* a = expected[frame];
+    vtkUnsignedCharArray* b = pixels[frame];
+    bool equal = a->GetNumberOfValues() == b->GetNumberOfValues();
+    for (vtkIdType i = 0; equal && i < a->GetNumberOfValues(); ++i)
+    {
+      equal = a->GetValue(i) == b->GetValue(i);
+    }
+    if (!equal)
+    {
+      std::cerr << "Frame " << frame << " renders differently with streaming uploads."
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * Render a red translucent sphere in front of a blue one, and check that the
+ * weighted blended translucency lets the nearest sphere dominate the color in
+ * the middle of the image while the average translucency mixes them equally.
+ */
+
+#include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkNew.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+#include <vtkUnsignedCharArray.h>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Size = 200;
+
+//------------------------------------------------------------------------------
+void AddSphere(vtkRenderer* renderer, double z, double r, double g, double b)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(0.0, 0.0, z);
+  sphere->SetRadius(0.5);
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  actor->GetProperty()->SetColor(r, g, b);
+  actor->GetProperty()->SetOpacity(0.5);
+  actor->GetProperty()->SetAmbient(1.0);
+  actor->GetProperty()->SetDiffuse(0.0);
+  renderer->AddActor(actor);
+}
+
+//------------------------------------------------------------------------------
+void RenderCenter(bool weighted, unsigned char color[3])
+{
+  vtkNew<vtkRenderer> renderer;
+  renderer->SetBackground(0.0, 0.0, 0.0);
+  renderer->SetUseWeightedBlendedTranslucency(weighted);
+  AddSphere(renderer, 1.0, 1.0, 0.0, 0.0);
+  AddSphere(renderer, -1.0, 0.0, 0.0, 1.0);
+  renderer->GetActiveCamera()->SetPosition(0.0, 0.0, 4.0);
+  renderer->GetActiveCamera()->SetFocalPoint(0.0, 0.0, 0.0);
+  renderer->ResetCameraClippingRange();
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(Size, Size);
+  renWin->SetMultiSamples(0);
+  renWin->AddRenderer(renderer);
+  renWin->Render();
+
+  vtkNew<vtkUnsignedCharArray> pixels;
+  renWin->GetPixelData(Size / 2, Size / 2, Size / 2, Size / 2, 1, pixels);
+  for (int i = 0; i < 3; ++i)
+  {
+    color[i] = pixels->GetValue(i);
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+int TestWeightedBlendedTranslucency(int, char*[])
+{
+  unsigned char average[3];
+  unsigned char weighted[3];
+  RenderCenter(false, average);
+  RenderCenter(true, weighted);
+
+  if (std::abs(average[0] - average[2]) > 8)
+  {
+    std::cerr << "The average translucency does not mix the spheres equally: "
+              << static_cast<int>(average[0]) << " " << static_cast<int>(average[2]) << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (weighted[0] < weighted[2] + 32)
+  {
+    std::cerr << "The nearest sphere does not dominate the weighted translucency: "
+              << static_cast<int>(weighted[0]) << " " << static_cast<int>(weighted[2])
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -28,6 +28,8 @@
 #include "vtkTextureObject.h"
 #include "vtkTransform.h"
 #include "vtkUnsignedIntArray.h"
+
+#include <algorithm>
 #include <sstream>
 
 namespace
@@ -667,6 +669,13 @@ void vtkOpenGLBatchedPolyDataMapper::DrawIBO(vtkRenderer* renderer, vtkActor* ac
     bool selecting = this->CurrentSelector != nullptr;
     bool tpass = actor->IsRenderingTranslucentPolygonalGeometry();
 
+    // Consecutive elements drawn with the same uniform values are drawn in a
+    // single call, which matters for composite datasets of many blocks.
+    ShaderValues currentValues;
+    ShaderValues values;
+    this->DrawCounts.clear();
+    this->DrawOffsets.clear();
+    this->DrawVertexRanges.clear();
     for (auto& iter : this->VTKPolyDataToGLBatchElement)
     {
       auto glBatchElement = iter.second.get();
@@ -683,41 +692,127 @@ void vtkOpenGLBatchedPolyDataMapper::DrawIBO(vtkRenderer* renderer, vtkActor* ac
         // test against primType even though we should not need to
         if (primType <= vtkOpenGLPolyDataMapper::PrimitiveTriStrips)
         {
-          this->SetShaderValues(
-            prog, glBatchElement, glBatchElement->CellCellMap->GetPrimitiveOffsets()[primType]);
+          this->ComputeShaderValues(
+            glBatchElement, glBatchElement->CellCellMap->GetPrimitiveOffsets()[primType], values);
+          if (!this->DrawCounts.empty() && values != currentValues)
+          {
+            this->DrawBatch(mode);
+          }
+          if (this->DrawCounts.empty())
+          {
+            this->ApplyShaderValues(prog, values);
+            currentValues = values;
+          }
         }
 
         unsigned int count = this->DrawingSelection
           ? static_cast<unsigned int>(CellBO.IBO->IndexCount)
           : glBatchElement->NextIndex[primType] - glBatchElement->StartIndex[primType];
 
-        glDrawRangeElements(mode, static_cast<GLuint>(glBatchElement->StartVertex),
-          static_cast<GLuint>(glBatchElement->NextVertex > 0 ? glBatchElement->NextVertex - 1 : 0),
-          count, GL_UNSIGNED_INT,
+        this->DrawCounts.push_back(static_cast<GLsizei>(count));
+        this->DrawOffsets.push_back(
           reinterpret_cast<const GLvoid*>(glBatchElement->StartIndex[primType] * sizeof(GLuint)));
+        this->DrawVertexRanges.push_back(static_cast<GLuint>(glBatchElement->StartVertex));
+        this->DrawVertexRanges.push_back(
+          static_cast<GLuint>(glBatchElement->NextVertex > 0 ? glBatchElement->NextVertex - 1 : 0));
       }
     }
+    this->DrawBatch(mode);
     CellBO.IBO->Release();
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkOpenGLBatchedPolyDataMapper::DrawBatch(GLenum mode)
+{
+  if (this->DrawCounts.size() == 1)
+  {
+    glDrawRangeElements(mode, this->DrawVertexRanges[0], this->DrawVertexRanges[1],
+      this->DrawCounts[0], GL_UNSIGNED_INT, this->DrawOffsets[0]);
+  }
+  else if (!this->DrawCounts.empty())
+  {
+#ifdef GL_ES_VERSION_3_0
+    for (size_t i = 0; i < this->DrawCounts.size(); ++i)
+    {
+      glDrawRangeElements(mode, this->DrawVertexRanges[2 * i], this->DrawVertexRanges[2 * i + 1],
+        this->DrawCounts[i], GL_UNSIGNED_INT, this->DrawOffsets[i]);
+    }
+#else
+    glMultiDrawElements(mode, this->DrawCounts.data(), GL_UNSIGNED_INT, this->DrawOffsets.data(),
+      static_cast<GLsizei>(this->DrawCounts.size()));
+#endif
+  }
+  this->DrawCounts.clear();
+  this->DrawOffsets.clear();
+  this->DrawVertexRanges.clear();
+}
+
+//------------------------------------------------------------------------------
+bool vtkOpenGLBatchedPolyDataMapper::ShaderValues::operator==(const ShaderValues& other) const
+{
+  return this->PrimitiveIDOffset == other.PrimitiveIDOffset &&
+    this->UseMapperIndex == other.UseMapperIndex &&
+    std::equal(this->MapperIndex, this->MapperIndex + 3, other.MapperIndex) &&
+    this->UseColors == other.UseColors && this->Opacity == other.Opacity &&
+    std::equal(this->AmbientColor, this->AmbientColor + 3, other.AmbientColor) &&
+    std::equal(this->DiffuseColor, this->DiffuseColor + 3, other.DiffuseColor) &&
+    this->UseOverridesColor == other.UseOverridesColor &&
+    this->OverridesColor == other.OverridesColor;
+}
+
 //------------------------------------------------------------------------------
 void vtkOpenGLBatchedPolyDataMapper::SetShaderValues(
   vtkShaderProgram* prog, GLBatchElement* glBatchElement, size_t primOffset)
 {
+  ShaderValues values;
+  this->ComputeShaderValues(glBatchElement, primOffset, values);
+  this->ApplyShaderValues(prog, values);
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLBatchedPolyDataMapper::ApplyShaderValues(
+  vtkShaderProgram* prog, const ShaderValues& values)
+{
+  if (this->PrimIDUsed)
+  {
+    prog->SetUniformi("PrimitiveIDOffset", values.PrimitiveIDOffset);
+  }
+  if (values.UseMapperIndex && prog->IsUniformUsed("mapperIndex"))
+  {
+    prog->SetUniform3f("mapperIndex", values.MapperIndex);
+  }
+  if (values.UseColors)
+  {
+    prog->SetUniformf("opacityUniform", values.Opacity);
+    prog->SetUniform3f("ambientColorUniform", values.AmbientColor);
+    prog->SetUniform3f("diffuseColorUniform", values.DiffuseColor);
+  }
+  if (values.UseOverridesColor)
+  {
+    prog->SetUniformi("OverridesColor", values.OverridesColor);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLBatchedPolyDataMapper::ComputeShaderValues(
+  GLBatchElement* glBatchElement, size_t primOffset, ShaderValues& values)
+{
+  values = ShaderValues();
   if (this->PrimIDUsed)
   {
-    prog->SetUniformi("PrimitiveIDOffset", static_cast<int>(primOffset));
+    values.PrimitiveIDOffset = static_cast<int>(primOffset);
   }
 
   auto& batchElement = glBatchElement->Parent;
   if (this->CurrentSelector)
   {
-    if (this->CurrentSelector->GetCurrentPass() == vtkHardwareSelector::COMPOSITE_INDEX_PASS &&
-      prog->IsUniformUsed("mapperIndex"))
+    if (this->CurrentSelector->GetCurrentPass() == vtkHardwareSelector::COMPOSITE_INDEX_PASS)
     {
       this->CurrentSelector->RenderCompositeIndex(batchElement.FlatIndex);
-      prog->SetUniform3f("mapperIndex", this->CurrentSelector->GetPropColorValue());
+      const float* mapperIndex = this->CurrentSelector->GetPropColorValue();
+      values.UseMapperIndex = true;
+      std::copy(mapperIndex, mapperIndex + 3, values.MapperIndex);
     }
     return;
   }
@@ -763,40 +858,43 @@ void vtkOpenGLBatchedPolyDataMapper::SetShaderValues(
   }
 
   // override the opacity and color
-  prog->SetUniformf("opacityUniform", batchElement.Opacity);
+  values.UseColors = true;
+  values.Opacity = static_cast<float>(batchElement.Opacity);
 
   if (useNanColor)
   {
-    float fnancolor[3] = { static_cast<float>(nanColor[0]), static_cast<float>(nanColor[1]),
-      static_cast<float>(nanColor[2]) };
-    prog->SetUniform3f("ambientColorUniform", fnancolor);
-    prog->SetUniform3f("diffuseColorUniform", fnancolor);
+    for (int i = 0; i < 3; ++i)
+    {
+      values.AmbientColor[i] = static_cast<float>(nanColor[i]);
+      values.DiffuseColor[i] = static_cast<float>(nanColor[i]);
+    }
   }
   else
   {
     if (this->DrawingSelection)
     {
       vtkColor3d& sColor = batchElement.SelectionColor;
-      float selectionColor[3] = { static_cast<float>(sColor[0]), static_cast<float>(sColor[1]),
-        static_cast<float>(sColor[2]) };
-      prog->SetUniform3f("ambientColorUniform", selectionColor);
-      prog->SetUniform3f("diffuseColorUniform", selectionColor);
-      prog->SetUniformf("opacityUniform", batchElement.SelectionOpacity);
+      for (int i = 0; i < 3; ++i)
+      {
+        values.AmbientColor[i] = static_cast<float>(sColor[i]);
+        values.DiffuseColor[i] = static_cast<float>(sColor[i]);
+      }
+      values.Opacity = static_cast<float>(batchElement.SelectionOpacity);
     }
     else
     {
       vtkColor3d& aColor = batchElement.AmbientColor;
-      float ambientColor[3] = { static_cast<float>(aColor[0]), static_cast<float>(aColor[1]),
-        static_cast<float>(aColor[2]) };
       vtkColor3d& dColor = batchElement.DiffuseColor;
-      float diffuseColor[3] = { static_cast<float>(dColor[0]), static_cast<float>(dColor[1]),
-        static_cast<float>(dColor[2]) };
-      prog->SetUniform3f("ambientColorUniform", ambientColor);
-      prog->SetUniform3f("diffuseColorUniform", diffuseColor);
+      for (int i = 0; i < 3; ++i)
+      {
+        values.AmbientColor[i] = static_cast<float>(aColor[i]);
+        values.DiffuseColor[i] = static_cast<float>(dColor[i]);
+      }
     }
     if (this->OverideColorUsed)
     {
-      prog->SetUniformi("OverridesColor", batchElement.OverridesColor);
+      values.UseOverridesColor = true;
+      values.OverridesColor = batchElement.OverridesColor;
     }
   }
 }
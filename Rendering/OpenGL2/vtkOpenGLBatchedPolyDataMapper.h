@@ -26,6 +26,7 @@
 
 #include <cstdint> // for std::uintptr_t
 #include <memory>  // for shared_ptr
+#include <vector>  // for ivar
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCompositePolyDataMapper;
@@ -90,12 +91,45 @@ protected:
   void DrawIBO(vtkRenderer* renderer, vtkActor* actoror, int primType, vtkOpenGLHelper& CellBO,
     GLenum mode, int pointSize);
 
+  /**
+   * Draws the elements collected by DrawIBO with a single call and clears them.
+   */
+  void DrawBatch(GLenum mode);
+
+  /**
+   * Uniform values used to draw the polydata of a glBatchElement. Consecutive
+   * elements with equal values are drawn with a single call.
+   */
+  struct ShaderValues
+  {
+    int PrimitiveIDOffset = 0;
+    bool UseMapperIndex = false;
+    float MapperIndex[3] = { 0.f, 0.f, 0.f };
+    bool UseColors = false;
+    float Opacity = 1.f;
+    float AmbientColor[3] = { 0.f, 0.f, 0.f };
+    float DiffuseColor[3] = { 0.f, 0.f, 0.f };
+    bool UseOverridesColor = false;
+    int OverridesColor = 0;
+
+    bool operator==(const ShaderValues& other) const;
+    bool operator!=(const ShaderValues& other) const { return !(*this == other); }
+  };
+
   /**
    * Applies rendering attributes for the corresponding polydata in the glBatchElement
    */
   virtual void SetShaderValues(
     vtkShaderProgram* prog, GLBatchElement* glBatchElement, size_t primOffset);
 
+  /**
+   * Computes the rendering attributes for the corresponding polydata in the
+   * glBatchElement, applied with ApplyShaderValues.
+   */
+  virtual void ComputeShaderValues(
+    GLBatchElement* glBatchElement, size_t primOffset, ShaderValues& values);
+  void ApplyShaderValues(vtkShaderProgram* prog, const ShaderValues& values);
+
   /**
    * Make sure appropriate shaders are defined, compiled and bound.  This method
    * orchistrates the process, much of the work is done in other methods
@@ -151,6 +185,10 @@ protected:
   std::vector<std::vector<unsigned int>> PickPixels;
   // cached array map
   std::map<vtkAbstractArray*, vtkDataArray*> ColorArrayMap;
+  // counts and offsets of the consecutive elements drawn by DrawIBO in one call
+  std::vector<GLsizei> DrawCounts;
+  std::vector<const GLvoid*> DrawOffsets;
+  std::vector<GLuint> DrawVertexRanges;
 
 private:
   vtkOpenGLBatchedPolyDataMapper(const vtkOpenGLBatchedPolyDataMapper&) = delete;
@@ -67,12 +67,49 @@ struct vtkOpenGLBufferObject::Private
   GLenum Usage;
   GLuint Handle;
   size_t Size;
+
+#ifndef GL_ES_VERSION_3_0
+  // Ring of staging regions for streaming uploads. A region is written again
+  // once the copy that read it has completed.
+  static const int NumberOfStagingRegions = 3;
+  GLuint StagingHandle = 0;
+  unsigned char* StagingPointer = nullptr;
+  size_t StagingRegionSize = 0;
+  int StagingRegion = 0;
+  GLsync StagingFences[NumberOfStagingRegions] = { nullptr, nullptr, nullptr };
+
+  void ReleaseStaging()
+  {
+    for (int i = 0; i < NumberOfStagingRegions; ++i)
+    {
+      if (this->StagingFences[i])
+      {
+        glDeleteSync(this->StagingFences[i]);
+        this->StagingFences[i] = nullptr;
+      }
+    }
+    if (this->StagingHandle != 0)
+    {
+      glBindBuffer(GL_COPY_READ_BUFFER, this->StagingHandle);
+      glUnmapBuffer(GL_COPY_READ_BUFFER);
+      glBindBuffer(GL_COPY_READ_BUFFER, 0);
+      glDeleteBuffers(1, &this->StagingHandle);
+      this->StagingHandle = 0;
+    }
+    this->StagingPointer = nullptr;
+    this->StagingRegionSize = 0;
+    this->StagingRegion = 0;
+  }
+#else
+  void ReleaseStaging() {}
+#endif
 };
 
 //------------------------------------------------------------------------------
 vtkOpenGLBufferObject::vtkOpenGLBufferObject()
 {
   this->Dirty = true;
+  this->Streaming = false;
   this->Internal = new Private;
   this->Internal->Type = convertType(vtkOpenGLBufferObject::ArrayBuffer);
 }
@@ -82,6 +119,7 @@ vtkOpenGLBufferObject::~vtkOpenGLBufferObject()
 {
   if (this->Internal->Handle != 0)
   {
+    this->Internal->ReleaseStaging();
     glDeleteBuffers(1, &this->Internal->Handle);
   }
   delete this->Internal;
@@ -90,11 +128,13 @@ vtkOpenGLBufferObject::~vtkOpenGLBufferObject()
 //------------------------------------------------------------------------------
 void vtkOpenGLBufferObject::ReleaseGraphicsResources()
 {
+  this->Internal->ReleaseStaging();
   if (this->Internal->Handle != 0)
   {
     glBindBuffer(this->Internal->Type, 0);
     glDeleteBuffers(1, &this->Internal->Handle);
     this->Internal->Handle = 0;
+    this->Internal->Size = 0;
   }
 }
 
@@ -184,6 +224,16 @@ size_t vtkOpenGLBufferObject::GetSize()
   return this->Internal->Size;
 }
 
+//------------------------------------------------------------------------------
+bool vtkOpenGLBufferObject::IsStreamingSupported()
+{
+#ifndef GL_ES_VERSION_3_0
+  return GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_buffer_storage;
+#else
+  return false;
+#endif
+}
+
 //------------------------------------------------------------------------------
 bool vtkOpenGLBufferObject::Bind()
 {
@@ -242,6 +292,11 @@ bool vtkOpenGLBufferObject::GenerateBuffer(vtkOpenGLBufferObject::ObjectType obj
 bool vtkOpenGLBufferObject::UploadInternal(
   const void* buffer, size_t size, vtkOpenGLBufferObject::ObjectType objectType)
 {
+  if (this->Streaming && vtkOpenGLBufferObject::IsStreamingSupported())
+  {
+    return this->StreamInternal(buffer, size, objectType);
+  }
+  this->Internal->ReleaseStaging();
   this->Allocate(size, objectType, this->GetUsage());
   return this->UploadRangeInternal(buffer, 0, size, objectType);
 }
@@ -266,6 +321,82 @@ bool vtkOpenGLBufferObject::UploadRangeInternal(
   return true;
 }
 
+//------------------------------------------------------------------------------
+bool vtkOpenGLBufferObject::StreamInternal(
+  const void* buffer, size_t size, vtkOpenGLBufferObject::ObjectType objectType)
+{
+#ifndef GL_ES_VERSION_3_0
+  // keep the storage of the buffer object while its size does not change
+  if (this->Internal->Handle == 0 || this->Internal->Size != size)
+  {
+    if (!this->Allocate(size, objectType, this->GetUsage()))
+    {
+      return false;
+    }
+  }
+  else if (!this->GenerateBuffer(objectType))
+  {
+    this->Error = "Trying to upload array buffer to incompatible buffer.";
+    return false;
+  }
+
+  Private* internal = this->Internal;
+  if (internal->StagingRegionSize < size)
+  {
+    internal->ReleaseStaging();
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLsizeiptr stagingSize =
+      static_cast<GLsizeiptr>(size * Private::NumberOfStagingRegions);
+    glGenBuffers(1, &internal->StagingHandle);
+    glBindBuffer(GL_COPY_READ_BUFFER, internal->StagingHandle);
+    glBufferStorage(GL_COPY_READ_BUFFER, stagingSize, nullptr, flags);
+    internal->StagingPointer =
+      static_cast<unsigned char*>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, stagingSize, flags));
+    if (!internal->StagingPointer)
+    {
+      internal->ReleaseStaging();
+      this->Streaming = false;
+      this->Error = "Failed to map the staging buffer, streaming uploads are turned off.";
+      return this->UploadInternal(buffer, size, objectType);
+    }
+    internal->StagingRegionSize = size;
+  }
+
+  // wait for the copy that last read this region, it usually completed frames ago
+  const int region = internal->StagingRegion;
+  GLsync& fence = internal->StagingFences[region];
+  if (fence)
+  {
+    GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    while (status == GL_TIMEOUT_EXPIRED)
+    {
+      status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+  }
+
+  const size_t regionOffset = region * internal->StagingRegionSize;
+  vtkDebugMacro(<< "streaming: " << size << " bytes through staging region " << region);
+  memcpy(internal->StagingPointer + regionOffset, buffer, size);
+  glBindBuffer(GL_COPY_READ_BUFFER, internal->StagingHandle);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, internal->Handle);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+    static_cast<GLintptr>(regionOffset), 0, static_cast<GLsizeiptr>(size));
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  internal->StagingRegion = (region + 1) % Private::NumberOfStagingRegions;
+
+  glBindBuffer(internal->Type, internal->Handle);
+  this->Dirty = false;
+  return true;
+#else
+  this->Streaming = false;
+  return this->UploadInternal(buffer, size, objectType);
+#endif
+}
+
 //------------------------------------------------------------------------------
 bool vtkOpenGLBufferObject::DownloadRangeInternal(void* buffer, ptrdiff_t offset, size_t size)
 {
@@ -282,5 +413,6 @@ bool vtkOpenGLBufferObject::DownloadRangeInternal(void* buffer, ptrdiff_t offset
 void vtkOpenGLBufferObject::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "Streaming: " << (this->Streaming ? "On" : "Off") << "\n";
 }
 VTK_ABI_NAMESPACE_END
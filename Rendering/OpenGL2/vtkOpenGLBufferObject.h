@@ -98,6 +98,25 @@ public:
    */
   size_t GetSize();
 
+  ///@{
+  /**
+   * When on, Upload writes the data into a persistently mapped ring of
+   * staging buffers guarded by fences and copies it into the buffer object on
+   * the GPU, instead of reallocating the buffer with glBufferData. This avoids
+   * the implicit synchronization of buffers re-uploaded every frame, such as
+   * the points of time-varying data. Ignored when IsStreamingSupported() is
+   * false. Default is off.
+   */
+  void SetStreaming(bool value) { this->Streaming = value; }
+  bool GetStreaming() const { return this->Streaming; }
+  ///@}
+
+  /**
+   * Return true when the current context supports streaming uploads, that is
+   * OpenGL 4.4 or ARB_buffer_storage. Requires a current context.
+   */
+  static bool IsStreamingSupported();
+
   /**
    * Download data from the buffer object.
    */
@@ -136,6 +155,7 @@ protected:
   vtkOpenGLBufferObject();
   ~vtkOpenGLBufferObject() override;
   bool Dirty;
+  bool Streaming;
   std::string Error;
 
   bool UploadInternal(const void* buffer, size_t size, ObjectType objectType);
@@ -144,6 +164,7 @@ protected:
 
 private:
   bool DownloadRangeInternal(void* buffer, ptrdiff_t offset, size_t size);
+  bool StreamInternal(const void* buffer, size_t size, ObjectType objectType);
 
   vtkOpenGLBufferObject(const vtkOpenGLBufferObject&) = delete;
   void operator=(const vtkOpenGLBufferObject&) = delete;
@@ -4,16 +4,21 @@
 
 #include "vtk_glad.h"
 
+#include "vtkCommand.h"
 #include "vtkDataObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkOpenGLFramebufferObject.h"
 #include "vtkOpenGLRenderUtilities.h"
 #include "vtkOpenGLRenderWindow.h"
 #include "vtkOpenGLState.h"
 #include "vtkRenderWindow.h"
 #include "vtkRenderer.h"
+#include "vtkWeakPointer.h"
 
 #include "vtkOpenGLError.h"
 
+#include <cstring>
+
 //#define vtkOpenGLHardwareSelectorDEBUG
 #ifdef vtkOpenGLHardwareSelectorDEBUG
 #include "vtkImageImport.h"
@@ -37,25 +42,46 @@ void annotate(const std::string& str)
 }
 }
 
+// The state of an asynchronous capture.
+class vtkOpenGLHardwareSelector::vtkAsynchronousCapture
+{
+public:
+  // The pixel buffer objects the passes are read in, 0 for the passes that
+  // were not rendered.
+  GLuint Buffers[11] = {};
+  size_t BufferSize = 0;
+  GLsync Fence = nullptr;
+
+  // True while the passes are rendered, the pixel buffers are then read in the
+  // pixel buffer objects and processed later.
+  bool Capturing = false;
+  bool Pending = false;
+
+  vtkWeakPointer<vtkOpenGLRenderWindow> Window;
+  unsigned long ObserverId = 0;
+};
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkOpenGLHardwareSelector);
 
 //------------------------------------------------------------------------------
-#ifdef vtkOpenGLHardwareSelectorDEBUG
 vtkOpenGLHardwareSelector::vtkOpenGLHardwareSelector()
+  : AsynchronousCapture(new vtkAsynchronousCapture)
 {
+#ifdef vtkOpenGLHardwareSelectorDEBUG
   std::cout << "=====vtkOpenGLHardwareSelector::vtkOpenGLHardwareSelector" << endl;
+#endif
 }
 
 //------------------------------------------------------------------------------
 vtkOpenGLHardwareSelector::~vtkOpenGLHardwareSelector()
 {
+#ifdef vtkOpenGLHardwareSelectorDEBUG
   std::cout << "=====vtkOpenGLHardwareSelector::~vtkOpenGLHardwareSelector" << endl;
-}
-#else
-vtkOpenGLHardwareSelector::vtkOpenGLHardwareSelector() = default;
-vtkOpenGLHardwareSelector::~vtkOpenGLHardwareSelector() = default;
 #endif
+  this->ReleaseAsynchronousCapture();
+  delete this->AsynchronousCapture;
+}
 
 //------------------------------------------------------------------------------
 void vtkOpenGLHardwareSelector::PreCapturePass(int pass)
@@ -123,10 +149,204 @@ void vtkOpenGLHardwareSelector::EndSelection()
   return this->Superclass::EndSelection();
 }
 
+//------------------------------------------------------------------------------
+bool vtkOpenGLHardwareSelector::CaptureBuffersAsynchronously()
+{
+  vtkAsynchronousCapture* capture = this->AsynchronousCapture;
+  this->ReleaseAsynchronousCapture();
+  vtkOpenGLRenderWindow* rwin = nullptr;
+  if (this->Renderer)
+  {
+    rwin = vtkOpenGLRenderWindow::SafeDownCast(this->Renderer->GetRenderWindow());
+  }
+  if (!rwin)
+  {
+    vtkErrorMacro("An OpenGL renderer must be set before calling CaptureBuffersAsynchronously.");
+    return false;
+  }
+
+  // OpenGL ES may not read RGB pixels, the pixel buffers are then read back
+  // synchronously and only the notification is deferred.
+#ifndef GL_ES_VERSION_3_0
+  capture->Capturing = true;
+  capture->BufferSize = static_cast<size_t>(this->Area[2] - this->Area[0] + 1) *
+    (this->Area[3] - this->Area[1] + 1) * 3;
+#endif
+  const bool captured = this->CaptureBuffers();
+  capture->Capturing = false;
+  if (!captured)
+  {
+    this->ReleaseAsynchronousCapture();
+    return false;
+  }
+
+#ifndef GL_ES_VERSION_3_0
+  rwin->MakeCurrent();
+  capture->Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glFlush();
+#endif
+  capture->Window = rwin;
+  capture->ObserverId =
+    rwin->AddObserver(vtkCommand::EndEvent, this, &vtkOpenGLHardwareSelector::RenderWindowEnd);
+  capture->Pending = true;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkOpenGLHardwareSelector::GetAsynchronousCapturePending()
+{
+  return this->AsynchronousCapture->Pending;
+}
+
+//------------------------------------------------------------------------------
+bool vtkOpenGLHardwareSelector::FinishAsynchronousCapture(bool wait)
+{
+  vtkAsynchronousCapture* capture = this->AsynchronousCapture;
+  vtkOpenGLRenderWindow* rwin = capture->Window;
+  if (!capture->Pending || !rwin || !rwin->GetInitialized())
+  {
+    this->ReleaseAsynchronousCapture();
+    return false;
+  }
+
+  rwin->MakeCurrent();
+  if (capture->Fence)
+  {
+    GLenum status = glClientWaitSync(capture->Fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED && !wait)
+    {
+      return false;
+    }
+    while (status == GL_TIMEOUT_EXPIRED)
+    {
+      status = glClientWaitSync(capture->Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+    }
+  }
+
+  // Copy the pixel buffer objects to the pixel buffers, the raw ones being
+  // the buffers before they are processed.
+  bool deferred[11] = {};
+  for (int pass = MIN_KNOWN_PASS; pass <= MAX_KNOWN_PASS; ++pass)
+  {
+    if (!capture->Buffers[pass])
+    {
+      continue;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, capture->Buffers[pass]);
+    const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+      static_cast<GLsizeiptr>(capture->BufferSize), GL_MAP_READ_BIT);
+    if (data)
+    {
+      this->PixBuffer[pass] = new unsigned char[capture->BufferSize];
+      memcpy(this->PixBuffer[pass], data, capture->BufferSize);
+      this->RawPixBuffer[pass] = new unsigned char[capture->BufferSize];
+      memcpy(this->RawPixBuffer[pass], data, capture->BufferSize);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+      deferred[pass] = true;
+    }
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  this->ReleaseAsynchronousCapture();
+
+  // Process the pixel buffers in the order of the passes, as the rendering
+  // of each pass does for synchronous captures.
+  for (int pass = MIN_KNOWN_PASS; pass <= MAX_KNOWN_PASS; ++pass)
+  {
+    if (deferred[pass])
+    {
+      this->CurrentPass = pass;
+      this->ProcessPixelBuffers();
+    }
+  }
+  this->CurrentPass = -1;
+
+  this->InvokeEvent(vtkCommand::SelectionChangedEvent);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLHardwareSelector::ReleaseAsynchronousCapture()
+{
+  vtkAsynchronousCapture* capture = this->AsynchronousCapture;
+  vtkOpenGLRenderWindow* rwin = capture->Window;
+  if (rwin)
+  {
+    rwin->RemoveObserver(capture->ObserverId);
+  }
+
+  // The objects of a finalized context are already deleted.
+  if (rwin && rwin->GetInitialized())
+  {
+    rwin->MakeCurrent();
+    for (GLuint& buffer : capture->Buffers)
+    {
+      if (buffer)
+      {
+        glDeleteBuffers(1, &buffer);
+      }
+    }
+    if (capture->Fence)
+    {
+      glDeleteSync(capture->Fence);
+    }
+  }
+  for (GLuint& buffer : capture->Buffers)
+  {
+    buffer = 0;
+  }
+  capture->Fence = nullptr;
+  capture->Window = nullptr;
+  capture->ObserverId = 0;
+  capture->Pending = false;
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLHardwareSelector::RenderWindowEnd(vtkObject*, unsigned long, void*)
+{
+  this->FinishAsynchronousCapture(false);
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLHardwareSelector::ProcessPixelBuffers()
+{
+  // The pixel buffers of an asynchronous capture are processed once they are
+  // read back.
+  if (!this->AsynchronousCapture->Capturing)
+  {
+    this->Superclass::ProcessPixelBuffers();
+  }
+}
+
 //------------------------------------------------------------------------------
 // just add debug output if compiled with vtkOpenGLHardwareSelectorDEBUG
 void vtkOpenGLHardwareSelector::SavePixelBuffer(int passNo)
 {
+  vtkAsynchronousCapture* capture = this->AsynchronousCapture;
+  if (capture->Capturing)
+  {
+    // Start reading the pass in a pixel buffer object, the passes are
+    // rendered in the back buffer.
+    auto rwin = vtkOpenGLRenderWindow::SafeDownCast(this->Renderer->GetRenderWindow());
+    vtkOpenGLState* ostate = rwin->GetState();
+    GLuint& buffer = capture->Buffers[passNo];
+    if (!buffer)
+    {
+      glGenBuffers(1, &buffer);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+    glBufferData(
+      GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(capture->BufferSize), nullptr, GL_STREAM_READ);
+    ostate->PushReadFramebufferBinding();
+    rwin->GetRenderFramebuffer()->Bind(GL_READ_FRAMEBUFFER);
+    rwin->GetRenderFramebuffer()->ActivateReadBuffer(0);
+    ostate->vtkglPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(this->Area[0], this->Area[1], this->Area[2] - this->Area[0] + 1,
+      this->Area[3] - this->Area[1] + 1, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    ostate->PopReadFramebufferBinding();
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return;
+  }
+
   this->Superclass::SavePixelBuffer(passNo);
 
 #ifdef vtkOpenGLHardwareSelectorDEBUG
@@ -300,5 +520,6 @@ void vtkOpenGLHardwareSelector::RenderProcessId(unsigned int processid)
 void vtkOpenGLHardwareSelector::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "AsynchronousCapturePending: " << this->AsynchronousCapture->Pending << endl;
 }
 VTK_ABI_NAMESPACE_END
@@ -8,6 +8,20 @@
  *
  * Implements the device specific code of vtkOpenGLHardwareSelector.
  *
+ * CaptureBuffersAsynchronously() renders the selection passes like
+ * CaptureBuffers() but reads the pixel buffers back in pixel buffer objects
+ * instead of waiting for the GPU with glReadPixels after every pass. The
+ * buffers are processed at the end of a later render of the render window,
+ * once the GPU is done with them, and a vtkCommand::SelectionChangedEvent is
+ * invoked. The observers of the event can then call GetPixelInformation() or
+ * GenerateSelection(), which makes hover picking in large scenes possible
+ * without stalling the rendering at every mouse move:
+ * @code
+ * selector->AddObserver(vtkCommand::SelectionChangedEvent, callback);
+ * selector->SetArea(x, y, x, y);
+ * selector->CaptureBuffersAsynchronously();
+ * @endcode
+ *
  * @sa
  * vtkHardwareSelector
  */
@@ -49,6 +63,27 @@ public:
   void BeginSelection() override;
   void EndSelection() override;
 
+  ///@{
+  /**
+   * Render the selection passes and start reading the pixel buffers back
+   * asynchronously. A pending asynchronous capture is discarded. The capture
+   * is completed by FinishAsynchronousCapture(), which is called at the end
+   * of every render of the render window while the capture is pending.
+   * Return false if the passes could not be rendered.
+   */
+  bool CaptureBuffersAsynchronously();
+  bool GetAsynchronousCapturePending();
+  ///@}
+
+  /**
+   * Complete the pending asynchronous capture if the GPU is done with the
+   * pixel buffers, or always if wait is true, which then blocks until they
+   * are. The pixel buffers are processed as CaptureBuffers() does and a
+   * vtkCommand::SelectionChangedEvent is invoked. Return true if the capture
+   * was completed.
+   */
+  bool FinishAsynchronousCapture(bool wait = false);
+
 protected:
   vtkOpenGLHardwareSelector();
   ~vtkOpenGLHardwareSelector() override;
@@ -62,11 +97,23 @@ protected:
   void EndRenderProp(vtkRenderWindow*) override;
 
   void SavePixelBuffer(int passNo) override;
+  void ProcessPixelBuffers() override;
+
+  /**
+   * Delete the pixel buffer objects and the fence of the asynchronous
+   * capture, and stop observing the render window.
+   */
+  void ReleaseAsynchronousCapture();
 
   int OriginalMultiSample;
   bool OriginalBlending;
 
 private:
+  class vtkAsynchronousCapture;
+  vtkAsynchronousCapture* AsynchronousCapture;
+
+  void RenderWindowEnd(vtkObject*, unsigned long, void*);
+
   vtkOpenGLHardwareSelector(const vtkOpenGLHardwareSelector&) = delete;
   void operator=(const vtkOpenGLHardwareSelector&) = delete;
 };
@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkOpenGLHierarchicalZCuller.h"
+
+#include "vtkCamera.h"
+#include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkObjectFactory.h"
+#include "vtkOpenGLRenderWindow.h"
+#include "vtkOpenGLRenderer.h"
+#include "vtkOpenGLState.h"
+#include "vtkProp.h"
+#include "vtk_glad.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkOpenGLHierarchicalZCuller);
+
+namespace
+{
+// The depth difference under which the bounds of a prop are not considered
+// behind the occluders, so that an occluder never culls itself.
+const float DepthTolerance = 1e-5f;
+}
+
+//------------------------------------------------------------------------------
+vtkOpenGLHierarchicalZCuller::vtkOpenGLHierarchicalZCuller() = default;
+
+//------------------------------------------------------------------------------
+vtkOpenGLHierarchicalZCuller::~vtkOpenGLHierarchicalZCuller() = default;
+
+//------------------------------------------------------------------------------
+void vtkOpenGLHierarchicalZCuller::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfCulledProps: " << this->NumberOfCulledProps << endl;
+  os << indent << "NumberOfOccluders: " << this->Occluders.size() << endl;
+}
+
+//------------------------------------------------------------------------------
+double vtkOpenGLHierarchicalZCuller::Cull(
+  vtkRenderer* ren, vtkProp** propList, int& listLength, int& initialized)
+{
+  this->NumberOfCulledProps = 0;
+
+  // The depth buffer of the render window is only the one of the final image
+  // when no render pass is used.
+  bool cull = vtkOpenGLRenderer::SafeDownCast(ren) &&
+    vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow()) && !ren->GetPass() &&
+    !ren->GetSelector() && listLength > 1;
+  if (cull)
+  {
+    cull = this->BuildDepthPyramid(ren, propList, listLength);
+  }
+
+  double matrix[16];
+  if (cull)
+  {
+    vtkMatrix4x4::DeepCopy(matrix,
+      ren->GetActiveCamera()->GetCompositeProjectionTransformMatrix(
+        ren->GetTiledAspectRatio(), -1, 1));
+  }
+
+  // Remove the occluded props from the list, preserving the order of the
+  // others.
+  double totalTime = 0.0;
+  int length = 0;
+  this->Occluders.clear();
+  for (int i = 0; i < listLength; ++i)
+  {
+    vtkProp* prop = propList[i];
+    const double* bounds = prop->GetBounds();
+    if (cull && bounds && vtkMath::AreBoundsInitialized(bounds) &&
+      this->IsOccluded(bounds, matrix))
+    {
+      ++this->NumberOfCulledProps;
+      continue;
+    }
+
+    if (!initialized)
+    {
+      prop->SetRenderTimeMultiplier(1.0);
+    }
+    totalTime += prop->GetRenderTimeMultiplier();
+    if (prop->HasOpaqueGeometry() && !prop->HasTranslucentPolygonalGeometry())
+    {
+      this->Occluders.insert(prop);
+    }
+    propList[length++] = prop;
+  }
+  for (int i = length; i < listLength; ++i)
+  {
+    propList[i] = nullptr;
+  }
+  listLength = length;
+  this->FirstFrame = false;
+
+  initialized = 1;
+  return totalTime;
+}
+
+//------------------------------------------------------------------------------
+bool vtkOpenGLHierarchicalZCuller::BuildDepthPyramid(
+  vtkRenderer* ren, vtkProp** propList, int listLength)
+{
+  vtkOpenGLRenderWindow* renWin = static_cast<vtkOpenGLRenderWindow*>(ren->GetRenderWindow());
+  vtkOpenGLState* ostate = renWin->GetState();
+
+  int width, height, origin[2];
+  ren->GetTiledSizeAndOrigin(&width, &height, origin, origin + 1);
+  if (width < 1 || height < 1)
+  {
+    return false;
+  }
+
+  // Render the occluders in the depth buffer only. The camera sets the
+  // viewport and clears the buffers of the renderer.
+  {
+    vtkOpenGLState::ScopedglColorMask colorMaskSaver(ostate);
+    vtkOpenGLState::ScopedglDepthMask depthMaskSaver(ostate);
+    vtkOpenGLState::ScopedglEnableDisable depthTestSaver(ostate, GL_DEPTH_TEST);
+    ostate->vtkglColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    ren->GetActiveCamera()->Render(ren);
+    ostate->vtkglDepthMask(GL_TRUE);
+    ostate->vtkglEnable(GL_DEPTH_TEST);
+    for (int i = 0; i < listLength; ++i)
+    {
+      vtkProp* prop = propList[i];
+      if ((this->FirstFrame || this->Occluders.count(prop)) && prop->HasOpaqueGeometry() &&
+        !prop->HasTranslucentPolygonalGeometry())
+      {
+        prop->RenderOpaqueGeometry(ren);
+      }
+    }
+  }
+
+  this->DepthPyramid.resize(1);
+  this->PyramidWidths.assign(1, width);
+  this->PyramidHeights.assign(1, height);
+  this->DepthPyramid[0].resize(static_cast<size_t>(width) * height);
+  if (renWin->GetZbufferData(origin[0], origin[1], origin[0] + width - 1,
+        origin[1] + height - 1, this->DepthPyramid[0].data()) != VTK_OK)
+  {
+    return false;
+  }
+
+  // Each texel of a level is the maximum of the 2x2 texels of the previous
+  // one, the last row and column of odd sizes being repeated.
+  while (width > 1 || height > 1)
+  {
+    const int levelWidth = (width + 1) / 2;
+    const int levelHeight = (height + 1) / 2;
+    const std::vector<float>& previous = this->DepthPyramid.back();
+    std::vector<float> level(static_cast<size_t>(levelWidth) * levelHeight);
+    for (int y = 0; y < levelHeight; ++y)
+    {
+      const float* row0 = previous.data() + static_cast<size_t>(2 * y) * width;
+      const float* row1 =
+        previous.data() + static_cast<size_t>(std::min(2 * y + 1, height - 1)) * width;
+      for (int x = 0; x < levelWidth; ++x)
+      {
+        const int x0 = 2 * x;
+        const int x1 = std::min(2 * x + 1, width - 1);
+        level[static_cast<size_t>(y) * levelWidth + x] =
+          std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+      }
+    }
+    this->DepthPyramid.push_back(std::move(level));
+    this->PyramidWidths.push_back(levelWidth);
+    this->PyramidHeights.push_back(levelHeight);
+    width = levelWidth;
+    height = levelHeight;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkOpenGLHierarchicalZCuller::IsOccluded(const double bounds[6], const double matrix[16]) const
+{
+  // Project the corners of the bounds in normalized device coordinates.
+  double ndcMin[3] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
+  double ndcMax[2] = { VTK_DOUBLE_MIN, VTK_DOUBLE_MIN };
+  for (int i = 0; i < 8; ++i)
+  {
+    const double p[4] = { bounds[i & 1], bounds[2 + ((i >> 1) & 1)], bounds[4 + ((i >> 2) & 1)],
+      1.0 };
+    double clip[4];
+    vtkMatrix4x4::MultiplyPoint(matrix, p, clip);
+    // The bounds cross the near plane, they are visible.
+    if (clip[3] <= 0.0 || clip[2] < -clip[3])
+    {
+      return false;
+    }
+    for (int j = 0; j < 3; ++j)
+    {
+      const double ndc = clip[j] / clip[3];
+      ndcMin[j] = std::min(ndcMin[j], ndc);
+      if (j < 2)
+      {
+        ndcMax[j] = std::max(ndcMax[j], ndc);
+      }
+    }
+  }
+
+  // The bounds outside of the viewport are left to the frustum culler.
+  if (ndcMax[0] < -1.0 || ndcMin[0] > 1.0 || ndcMax[1] < -1.0 || ndcMin[1] > 1.0)
+  {
+    return false;
+  }
+  for (int j = 0; j < 2; ++j)
+  {
+    ndcMin[j] = std::max(ndcMin[j], -1.0);
+    ndcMax[j] = std::min(ndcMax[j], 1.0);
+  }
+
+  // The rectangle of pixels covered by the bounds.
+  const int width = this->PyramidWidths[0];
+  const int height = this->PyramidHeights[0];
+  const int x0 = vtkMath::ClampValue(
+    static_cast<int>(std::floor((ndcMin[0] * 0.5 + 0.5) * width)), 0, width - 1);
+  const int x1 = vtkMath::ClampValue(
+    static_cast<int>(std::floor((ndcMax[0] * 0.5 + 0.5) * width)), 0, width - 1);
+  const int y0 = vtkMath::ClampValue(
+    static_cast<int>(std::floor((ndcMin[1] * 0.5 + 0.5) * height)), 0, height - 1);
+  const int y1 = vtkMath::ClampValue(
+    static_cast<int>(std::floor((ndcMax[1] * 0.5 + 0.5) * height)), 0, height - 1);
+
+  // The first level whose texels are as large as the rectangle, it covers
+  // at most 2x2 texels of it.
+  const int extent = std::max(x1 - x0, y1 - y0) + 1;
+  int level = 0;
+  while ((1 << level) < extent && level + 1 < static_cast<int>(this->DepthPyramid.size()))
+  {
+    ++level;
+  }
+
+  float maxDepth = 0.0f;
+  const std::vector<float>& depths = this->DepthPyramid[level];
+  const int levelWidth = this->PyramidWidths[level];
+  for (int y = (y0 >> level); y <= (y1 >> level); ++y)
+  {
+    for (int x = (x0 >> level); x <= (x1 >> level); ++x)
+    {
+      maxDepth = std::max(maxDepth, depths[static_cast<size_t>(y) * levelWidth + x]);
+    }
+  }
+
+  // The nearest depth of the bounds, with the default depth range.
+  const double minDepth = ndcMin[2] * 0.5 + 0.5;
+  return minDepth > maxDepth + DepthTolerance;
+}
+VTK_ABI_NAMESPACE_END
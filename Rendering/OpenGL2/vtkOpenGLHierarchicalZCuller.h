@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkOpenGLHierarchicalZCuller
+ * @brief   cull the props hidden by other props with a hierarchical depth buffer
+ *
+ * vtkOpenGLHierarchicalZCuller removes from the render list the props whose
+ * bounds are entirely behind the geometry already drawn. It works in two
+ * passes, as vtkWebGPUComputeOcclusionCuller does:
+ *
+ * - the opaque props that were visible at the previous frame (all of them at
+ *   the first frame) are rendered into the depth buffer only, with the
+ *   current camera;
+ * - the depth buffer is read back and reduced into a pyramid of maximum
+ *   depths. The bounds of every prop are projected on the screen and their
+ *   nearest depth is compared to the farthest depth of the pyramid level whose
+ *   texels are about the size of the projected bounds. If the bounds are
+ *   farther, the prop is culled.
+ *
+ * As the occluders are drawn with the current camera, the culling is
+ * conservative: a prop that becomes visible is never culled. The cost is an
+ * extra depth-only rendering of the visible opaque props and a read back of
+ * the depth buffer, which pays off for scenes with a lot of occluded props,
+ * such as the models of industrial plants.
+ *
+ * The culler is used by adding it to the cullers of a vtkOpenGLRenderer:
+ * @code
+ * vtkNew<vtkOpenGLHierarchicalZCuller> culler;
+ * renderer->AddCuller(culler);
+ * @endcode
+ *
+ * The props of a renderer that uses render passes or that is being used for
+ * a hardware selection are not culled.
+ *
+ * @sa
+ * vtkCuller vtkFrustumCoverageCuller
+ */
+
+#ifndef vtkOpenGLHierarchicalZCuller_h
+#define vtkOpenGLHierarchicalZCuller_h
+
+#include "vtkCuller.h"
+#include "vtkRenderingOpenGL2Module.h" // For export macro
+
+#include <set>    // for ivar
+#include <vector> // for ivar
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkProp;
+class vtkRenderer;
+
+class VTKRENDERINGOPENGL2_EXPORT vtkOpenGLHierarchicalZCuller : public vtkCuller
+{
+public:
+  static vtkOpenGLHierarchicalZCuller* New();
+  vtkTypeMacro(vtkOpenGLHierarchicalZCuller, vtkCuller);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Get the number of props culled by the last call to Cull().
+   */
+  vtkGetMacro(NumberOfCulledProps, int);
+
+  /**
+   * WARNING: INTERNAL METHOD - NOT INTENDED FOR GENERAL USE
+   * DO NOT USE THESE METHODS OUTSIDE OF THE RENDERING PROCESS
+   * Perform the cull operation
+   * This method should only be called by vtkRenderer as part of
+   * the render process
+   */
+  double Cull(vtkRenderer* ren, vtkProp** propList, int& listLength, int& initialized) override;
+
+protected:
+  vtkOpenGLHierarchicalZCuller();
+  ~vtkOpenGLHierarchicalZCuller() override;
+
+  /**
+   * Render the occluders in the depth buffer and build the depth pyramid.
+   * Return false if the depth buffer could not be read.
+   */
+  bool BuildDepthPyramid(vtkRenderer* ren, vtkProp** propList, int listLength);
+
+  /**
+   * Return true if the bounds are behind the depth pyramid.
+   */
+  bool IsOccluded(const double bounds[6], const double matrix[16]) const;
+
+  int NumberOfCulledProps = 0;
+
+  // The opaque props that were not culled at the previous frame.
+  std::set<vtkProp*> Occluders;
+  bool FirstFrame = true;
+
+  // The levels of maximum depths, the first one is the depth buffer of the
+  // viewport.
+  std::vector<std::vector<float>> DepthPyramid;
+  std::vector<int> PyramidWidths;
+  std::vector<int> PyramidHeights;
+
+private:
+  vtkOpenGLHierarchicalZCuller(const vtkOpenGLHierarchicalZCuller&) = delete;
+  void operator=(const vtkOpenGLHierarchicalZCuller&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
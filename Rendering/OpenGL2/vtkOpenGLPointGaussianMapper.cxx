@@ -5,11 +5,13 @@
 #include "vtkOpenGLHelper.h"
 
 #include "vtkBoundingBox.h"
+#include "vtkCamera.h"
 #include "vtkCellArray.h"
 #include "vtkCommand.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
@@ -32,6 +34,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkProperty.h"
+#include "vtkSMPTools.h"
 #include "vtkShaderProgram.h"
 #include "vtkUnsignedCharArray.h"
 
@@ -43,7 +46,11 @@
 
 #include "vtkOpenGLPointGaussianMapperHelper.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <numeric>
+#include <random>
+#include <utility>
 
 VTK_ABI_NAMESPACE_BEGIN
 
@@ -63,6 +70,8 @@ vtkOpenGLPointGaussianMapperHelper::vtkOpenGLPointGaussianMapperHelper()
   this->ScaleScale = 1.0;
   this->OpacityOffset = 0.0;
   this->ScaleOffset = 0.0;
+  this->PointBudget = 0;
+  vtkMath::UninitializeBounds(this->LevelOfDetailBounds);
 }
 
 //------------------------------------------------------------------------------
@@ -76,6 +85,7 @@ void vtkOpenGLPointGaussianMapperHelper::PrintSelf(ostream& os, vtkIndent indent
   os << indent << "ScaleScale: " << this->ScaleScale << endl;
   os << indent << "OpacityOffset: " << this->OpacityOffset << endl;
   os << indent << "ScaleOffset: " << this->ScaleOffset << endl;
+  os << indent << "PointBudget: " << this->PointBudget << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -388,8 +398,214 @@ void vtkOpenGLPointGaussianMapperHelperSizes(vtkFloatArray* scales, PointDataTyp
   }
 }
 
+// The splats are sorted in the levels of an octree of this depth over their
+// bounds, the codes of its finest cells using 3 bits per level.
+const int LevelOfDetailDepth = 16;
+
+// The level of the octree whose cells count the splats to estimate how many
+// of them are visible.
+const int LevelOfDetailCoarseLevel = 4;
+
+// Spread the bits of a 16 bits coordinate every 3 bits.
+uint64_t vtkOpenGLPointGaussianMapperHelperSpreadBits(uint64_t x)
+{
+  x &= 0xffff;
+  x = (x | (x << 32)) & 0x1f00000000ffffULL;
+  x = (x | (x << 16)) & 0x1f0000ff0000ffULL;
+  x = (x | (x << 8)) & 0x100f00f00f00f00fULL;
+  x = (x | (x << 4)) & 0x10c30c30c30c30c3ULL;
+  x = (x | (x << 2)) & 0x1249249249249249ULL;
+  return x;
+}
+
+// Compute the code of the finest octree cell of every splat.
+struct vtkOpenGLPointGaussianMapperHelperCodes
+{
+  vtkPoints* Points;
+  const std::vector<unsigned int>& Splats;
+  const double* Bounds;
+  double Scale[3];
+  std::vector<std::pair<uint64_t, unsigned int>>& Codes;
+
+  vtkOpenGLPointGaussianMapperHelperCodes(vtkPoints* points,
+    const std::vector<unsigned int>& splats, const double* bounds,
+    std::vector<std::pair<uint64_t, unsigned int>>& codes)
+    : Points(points)
+    , Splats(splats)
+    , Bounds(bounds)
+    , Codes(codes)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      const double length = bounds[2 * i + 1] - bounds[2 * i];
+      this->Scale[i] = length > 0.0 ? (1 << LevelOfDetailDepth) / length : 0.0;
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const int maxCoordinate = (1 << LevelOfDetailDepth) - 1;
+    double p[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Points->GetPoint(this->Splats[i], p);
+      uint64_t code = 0;
+      for (int j = 0; j < 3; ++j)
+      {
+        const int coordinate = vtkMath::ClampValue(
+          static_cast<int>((p[j] - this->Bounds[2 * j]) * this->Scale[j]), 0, maxCoordinate);
+        code |= vtkOpenGLPointGaussianMapperHelperSpreadBits(coordinate) << j;
+      }
+      this->Codes[i] = std::make_pair(code, this->Splats[i]);
+    }
+  }
+};
+
 } // anonymous namespace
 
+//------------------------------------------------------------------------------
+void vtkOpenGLPointGaussianMapperHelper::BuildLevelOfDetailOrder(
+  vtkPolyData* poly, const std::vector<unsigned int>& splats)
+{
+  poly->GetPoints()->GetBounds(this->LevelOfDetailBounds);
+  const vtkIdType numSplats = static_cast<vtkIdType>(splats.size());
+  std::vector<std::pair<uint64_t, unsigned int>> codes(splats.size());
+  vtkOpenGLPointGaussianMapperHelperCodes worker(
+    poly->GetPoints(), splats, this->LevelOfDetailBounds, codes);
+  vtkSMPTools::For(0, numSplats, worker);
+  vtkSMPTools::Sort(codes.begin(), codes.end());
+
+  // A splat belongs to the first level whose cell it is the first splat of
+  // in the code order, its level being given by the highest bit that differs
+  // from the code of the previous splat. The splats of a level hence add one
+  // splat to every cell of that level that does not have one yet, the
+  // duplicated codes going in an extra last level.
+  const int numLevels = LevelOfDetailDepth + 2;
+  std::vector<unsigned char> levels(splats.size());
+  std::vector<vtkIdType> levelOffsets(numLevels + 1, 0);
+  this->LevelOfDetailCounts.assign(1 << (3 * LevelOfDetailCoarseLevel), 0);
+  for (vtkIdType i = 0; i < numSplats; ++i)
+  {
+    int level = 0;
+    if (i > 0)
+    {
+      uint64_t diff = codes[i].first ^ codes[i - 1].first;
+      int bit = -1;
+      for (; diff; diff >>= 1)
+      {
+        ++bit;
+      }
+      level = bit < 0 ? numLevels - 1 : LevelOfDetailDepth - bit / 3;
+    }
+    levels[i] = static_cast<unsigned char>(level);
+    ++levelOffsets[level + 1];
+    ++this->LevelOfDetailCounts[codes[i].first >>
+      (3 * (LevelOfDetailDepth - LevelOfDetailCoarseLevel))];
+  }
+  std::partial_sum(levelOffsets.begin(), levelOffsets.end(), levelOffsets.begin());
+
+  // The splats of a level are shuffled so that the partially drawn level
+  // refines the whole bounds evenly.
+  std::vector<unsigned int> order(splats.size());
+  std::vector<vtkIdType> positions(levelOffsets.begin(), levelOffsets.end() - 1);
+  for (vtkIdType i = 0; i < numSplats; ++i)
+  {
+    order[positions[levels[i]]++] = codes[i].second;
+  }
+  std::minstd_rand random;
+  for (int level = 0; level < numLevels; ++level)
+  {
+    std::shuffle(order.begin() + levelOffsets[level], order.begin() + levelOffsets[level + 1],
+      random);
+  }
+
+  this->LevelOfDetailIBO->Upload(order, vtkOpenGLIndexBufferObject::ElementArrayBuffer);
+  this->LevelOfDetailIBO->IndexCount = order.size();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkOpenGLPointGaussianMapperHelper::GetLevelOfDetailCount(
+  vtkRenderer* ren, vtkActor* actor)
+{
+  const vtkIdType numSplats = static_cast<vtkIdType>(this->LevelOfDetailIBO->IndexCount);
+  if (this->PointBudget <= 0 || this->PointBudget >= numSplats)
+  {
+    return numSplats;
+  }
+
+  // The frustum planes in model coordinates, their normals point inside.
+  double planes[24];
+  ren->GetActiveCamera()->GetFrustumPlanes(ren->GetTiledAspectRatio(), planes);
+  if (!actor->GetIsIdentity())
+  {
+    vtkMatrix4x4* matrix = actor->GetMatrix();
+    for (int k = 0; k < 6; ++k)
+    {
+      double plane[4];
+      for (int j = 0; j < 4; ++j)
+      {
+        plane[j] = 0.0;
+        for (int i = 0; i < 4; ++i)
+        {
+          plane[j] += planes[4 * k + i] * matrix->GetElement(i, j);
+        }
+      }
+      std::copy(plane, plane + 4, planes + 4 * k);
+    }
+  }
+
+  // Count the splats of the coarse cells that intersect the frustum.
+  const int cellsPerAxis = 1 << LevelOfDetailCoarseLevel;
+  const double* bounds = this->LevelOfDetailBounds;
+  vtkIdType visible = 0;
+  for (size_t key = 0; key < this->LevelOfDetailCounts.size(); ++key)
+  {
+    if (!this->LevelOfDetailCounts[key])
+    {
+      continue;
+    }
+    int cell[3] = { 0, 0, 0 };
+    for (int b = 0; b < LevelOfDetailCoarseLevel; ++b)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        cell[j] |= static_cast<int>((key >> (3 * b + j)) & 1) << b;
+      }
+    }
+    double cellMin[3], cellMax[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      const double length = (bounds[2 * j + 1] - bounds[2 * j]) / cellsPerAxis;
+      cellMin[j] = bounds[2 * j] + cell[j] * length;
+      cellMax[j] = cellMin[j] + length;
+    }
+    bool inside = true;
+    for (int k = 0; k < 6 && inside; ++k)
+    {
+      const double* plane = planes + 4 * k;
+      double distance = plane[3];
+      for (int j = 0; j < 3; ++j)
+      {
+        distance += plane[j] * (plane[j] > 0.0 ? cellMax[j] : cellMin[j]);
+      }
+      inside = distance >= 0.0;
+    }
+    if (inside)
+    {
+      visible += this->LevelOfDetailCounts[key];
+    }
+  }
+
+  // As every prefix of the order covers the bounds evenly, drawing
+  // PointBudget / fraction splats puts about PointBudget of them in view.
+  if (visible == 0)
+  {
+    return this->PointBudget;
+  }
+  const double fraction = static_cast<double>(visible) / numSplats;
+  return std::min(numSplats, static_cast<vtkIdType>(this->PointBudget / fraction));
+}
+
 //------------------------------------------------------------------------------
 bool vtkOpenGLPointGaussianMapperHelper::GetNeedToRebuildBufferObjects(
   vtkRenderer* vtkNotUsed(ren), vtkActor* act)
@@ -505,19 +721,36 @@ void vtkOpenGLPointGaussianMapperHelper::BuildBufferObjects(
     this->Primitives[i].IBO->IndexCount = 0;
   }
 
+  const bool levelOfDetail = this->Owner->GetPointBudget() > 0 && splatCount > 1;
+  std::vector<unsigned int> verts;
   if (poly->GetVerts()->GetNumberOfCells() > 0)
   {
     this->Primitives[PrimitivePoints].IBO->CreatePointIndexBuffer(poly->GetVerts());
+    if (levelOfDetail)
+    {
+      verts.reserve(splatCount);
+      for (auto id : vtk::DataArrayValueRange<1>(poly->GetVerts()->GetConnectivityArray()))
+      {
+        verts.push_back(static_cast<unsigned int>(id));
+      }
+    }
   }
   else
   {
-    std::vector<unsigned int> verts(splatCount);
+    verts.resize(splatCount);
     std::iota(verts.begin(), verts.end(), 0);
     this->Primitives[PrimitivePoints].IBO->Upload(
       verts, vtkOpenGLIndexBufferObject::ElementArrayBuffer);
     this->Primitives[PrimitivePoints].IBO->IndexCount = splatCount;
   }
 
+  // sort the splats in levels of detail to draw them under the point budget
+  this->LevelOfDetailIBO->IndexCount = 0;
+  if (levelOfDetail)
+  {
+    this->BuildLevelOfDetailOrder(poly, verts);
+  }
+
   this->VBOBuildTime.Modified();
 }
 
@@ -530,14 +763,29 @@ void vtkOpenGLPointGaussianMapperHelper::RenderPieceDraw(vtkRenderer* ren, vtkAc
   {
     this->UpdateShaders(this->Primitives[PrimitivePoints], ren, actor);
 
-    this->Primitives[PrimitivePoints].IBO->Bind();
+    // the selection draws all the splats in their original order
+    vtkOpenGLIndexBufferObject* ibo = this->Primitives[PrimitivePoints].IBO;
+    size_t count = ibo->IndexCount;
+    if (this->LevelOfDetailIBO->IndexCount && !ren->GetSelector())
+    {
+      ibo = this->LevelOfDetailIBO;
+      count = static_cast<size_t>(this->GetLevelOfDetailCount(ren, actor));
+    }
+
+    ibo->Bind();
     glDrawRangeElements(GL_POINTS, 0, static_cast<GLuint>(numVerts - 1),
-      static_cast<GLsizei>(this->Primitives[PrimitivePoints].IBO->IndexCount), GL_UNSIGNED_INT,
-      nullptr);
-    this->Primitives[PrimitivePoints].IBO->Release();
+      static_cast<GLsizei>(count), GL_UNSIGNED_INT, nullptr);
+    ibo->Release();
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkOpenGLPointGaussianMapperHelper::ReleaseGraphicsResources(vtkWindow* win)
+{
+  this->LevelOfDetailIBO->ReleaseGraphicsResources();
+  this->Superclass::ReleaseGraphicsResources(win);
+}
+
 namespace
 {
 // helper to get the state of picking
@@ -551,6 +799,16 @@ int getPickState(vtkRenderer* ren)
 
   return vtkHardwareSelector::MIN_KNOWN_PASS - 1;
 }
+
+// helper to get the number of splats drawn for a dataset
+vtkIdType getSplatCount(vtkPolyData* poly)
+{
+  if (poly->GetVerts()->GetNumberOfCells())
+  {
+    return poly->GetVerts()->GetNumberOfConnectivityIds();
+  }
+  return poly->GetNumberOfPoints();
+}
 }
 
 //------------------------------------------------------------------------------
@@ -775,10 +1033,27 @@ void vtkOpenGLPointGaussianMapper::RenderInternal(vtkRenderer* ren, vtkActor* ac
     selector->BeginRenderProp();
   }
 
+  // share the point budget between the blocks
+  double splatCount = 0.0;
+  if (this->PointBudget > 0)
+  {
+    for (auto helper : this->Helpers)
+    {
+      splatCount += getSplatCount(helper->GetInput());
+    }
+  }
+
   for (auto hiter = this->Helpers.begin(); hiter != this->Helpers.end(); ++hiter)
   {
     // make sure the BOs are up to date
     vtkOpenGLPointGaussianMapperHelper* helper = *hiter;
+    helper->PointBudget = 0;
+    if (splatCount > 0.0)
+    {
+      const double share = getSplatCount(helper->GetInput()) / splatCount;
+      helper->PointBudget =
+        std::max<vtkIdType>(1, static_cast<vtkIdType>(this->PointBudget * share));
+    }
     if (selector && selector->GetCurrentPass() == vtkHardwareSelector::COMPOSITE_INDEX_PASS)
     {
       selector->RenderCompositeIndex(helper->FlatIndex);
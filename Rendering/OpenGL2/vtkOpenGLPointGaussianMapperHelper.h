@@ -4,8 +4,12 @@
 #ifndef vtkOpenGLPointGaussianMapperHelper_h
 #define vtkOpenGLPointGaussianMapperHelper_h
 
+#include "vtkNew.h"                      // for ivar
+#include "vtkOpenGLIndexBufferObject.h" // for ivar
 #include "vtkOpenGLPolyDataMapper.h"
 
+#include <vector> // for ivar
+
 VTK_ABI_NAMESPACE_BEGIN
 
 class vtkPointGaussianMapper;
@@ -32,9 +36,14 @@ public:
   bool UsingPoints;
   double BoundScale;
 
+  // the share of the point budget of our Owner, 0 for none
+  vtkIdType PointBudget;
+
   // called by our Owner skips some stuff
   void GaussianRender(vtkRenderer* ren, vtkActor* act);
 
+  void ReleaseGraphicsResources(vtkWindow*) override;
+
 protected:
   vtkOpenGLPointGaussianMapperHelper();
   ~vtkOpenGLPointGaussianMapperHelper() override;
@@ -69,6 +78,20 @@ protected:
 
   void RenderPieceDraw(vtkRenderer* ren, vtkActor* act) override;
 
+  // Description:
+  // Sort the splats in levels of detail, and count them in the cells of a
+  // coarse grid over their bounds
+  void BuildLevelOfDetailOrder(vtkPolyData* poly, const std::vector<unsigned int>& splats);
+
+  // Description:
+  // The number of splats of the level of detail order to draw so that about
+  // PointBudget of them are in the view frustum
+  vtkIdType GetLevelOfDetailCount(vtkRenderer* ren, vtkActor* act);
+
+  vtkNew<vtkOpenGLIndexBufferObject> LevelOfDetailIBO;
+  std::vector<vtkIdType> LevelOfDetailCounts;
+  double LevelOfDetailBounds[6];
+
   // Description:
   // Does the shader source need to be recomputed
   bool GetNeedToRebuildShaders(vtkOpenGLHelper& cellBO, vtkRenderer* ren, vtkActor* act) override;
@@ -87,6 +87,7 @@ vtkOpenGLPolyDataMapper::vtkOpenGLPolyDataMapper()
   this->ForceTextureCoordinates = false;
   this->SelectionType = VTK_POINTS;
   this->UseProgramPointSize = false;
+  this->MapScalarsInShader = false;
 
   this->PrimitiveIDOffset = 0;
 
@@ -763,7 +764,8 @@ void vtkOpenGLPolyDataMapper::ReplaceShaderColor(
                  "  float opacity = opacityUniform * vertexColorVSOutput.a;";
   }
   // handle point color texture map coloring
-  else if (this->InterpolateScalarsBeforeMapping && this->ColorCoordinates &&
+  else if (this->InterpolateScalarsBeforeMapping &&
+    (this->ColorCoordinates || this->VBOs->GetNumberOfComponents("colorScalar")) &&
     !this->DrawingVertices)
   {
     colorImpl += "  vec4 texColor = texture(colortexture, colorTCoordVCVSOutput.st);\n"
@@ -1509,7 +1511,8 @@ void vtkOpenGLPolyDataMapper::ReplaceShaderTCoord(
     // do we have special tcoords for this texture?
     std::string tcoordname = this->GetTextureCoordinateName(it.second.c_str());
     int tcoordComps = this->VBOs->GetNumberOfComponents(tcoordname.c_str());
-    if (tcoordComps == 1 || tcoordComps == 2)
+    if (tcoordComps == 1 || tcoordComps == 2 ||
+      (tcoordname == "colorTCoord" && this->VBOs->GetNumberOfComponents("colorScalar")))
     {
       tcoordnames.insert(tcoordname);
     }
@@ -1583,6 +1586,60 @@ void vtkOpenGLPolyDataMapper::ReplaceShaderTCoord(
     }
   }
 
+  // the texture coordinates of the raw scalars are computed first
+  bool colorScalar = tcoordnames.count("colorTCoord") &&
+    this->VBOs->GetNumberOfComponents("colorTCoord") == 0;
+  if (colorScalar)
+  {
+    vsimpl = "{\n"
+             "  float value;\n"
+             "  if (colorScalarComponent < 0 ||\n"
+             "    colorScalarComponent >= colorScalarNumberOfComponents)\n"
+             "  {\n"
+             "    float sum = 0.0;\n"
+             "    for (int c = 0; c < 4; ++c)\n"
+             "    {\n"
+             "      if (c < colorScalarNumberOfComponents)\n"
+             "      {\n"
+             "        sum += colorScalar[c] * colorScalar[c];\n"
+             "      }\n"
+             "    }\n"
+             "    value = sqrt(sum);\n"
+             "  }\n"
+             "  else\n"
+             "  {\n"
+             "    value = colorScalar[colorScalarComponent];\n"
+             "  }\n"
+             "  if (isnan(value))\n"
+             "  {\n"
+             "    colorTCoord = vec2(0.5, 1.0);\n"
+             "  }\n"
+             "  else\n"
+             "  {\n"
+             "    if (colorScalarLogScale)\n"
+             "    {\n"
+             "      // see vtkLookupTable::ApplyLogScale\n"
+             "      if (colorScalarTableRange.x < 0.0)\n"
+             "      {\n"
+             "        value = value < 0.0 ? -0.30102999566 * log2(-value) :\n"
+             "          (colorScalarTableRange.x > colorScalarTableRange.y ?\n"
+             "          colorScalarLogRange.x : colorScalarLogRange.y);\n"
+             "      }\n"
+             "      else\n"
+             "      {\n"
+             "        value = value > 0.0 ? 0.30102999566 * log2(value) :\n"
+             "          (colorScalarTableRange.x <= colorScalarTableRange.y ?\n"
+             "          colorScalarLogRange.x : colorScalarLogRange.y);\n"
+             "      }\n"
+             "    }\n"
+             "    // 0.49 makes the NaN color win the interpolation next to a NaN\n"
+             "    colorTCoord = vec2(clamp((value - colorScalarPaddedRange.x) *\n"
+             "      colorScalarPaddedRange.y, -1000.0, 1000.0), 0.49);\n"
+             "  }\n"
+             "}\n" +
+      vsimpl;
+  }
+
   vtkShaderProgram::Substitute(VSSource, "//VTK::TCoord::Impl", vsimpl);
 
   // now create the rest of the vertex and geometry shader code
@@ -1602,7 +1659,21 @@ void vtkOpenGLPolyDataMapper::ReplaceShaderTCoord(
     {
       tCoordType = "vec2";
     }
-    vsdec += "in " + tCoordType + " " + it + ";\n";
+    if (colorScalar && it == "colorTCoord")
+    {
+      vsdec += "in vec4 colorScalar;\n"
+               "uniform int colorScalarComponent; // negative for the magnitude\n"
+               "uniform int colorScalarNumberOfComponents;\n"
+               "uniform vec2 colorScalarPaddedRange; // minimum, inverse of the width\n"
+               "uniform bool colorScalarLogScale;\n"
+               "uniform vec2 colorScalarTableRange;\n"
+               "uniform vec2 colorScalarLogRange;\n"
+               "vec2 colorTCoord;\n";
+    }
+    else
+    {
+      vsdec += "in " + tCoordType + " " + it + ";\n";
+    }
     vsdec += "out " + tCoordType + " " + it + "VCVSOutput;\n";
     if (this->SeamlessU)
     {
@@ -2550,7 +2621,8 @@ bool vtkOpenGLPolyDataMapper::GetNeedToRebuildShaders(
     (actor->GetProperty()->GetCoatStrength() > 0.0 ? 0x80 : 0) +
     (actor->GetProperty()->GetAnisotropy() > 0.0 ? 0x100 : 0) +
     (vtkOpenGLRenderer::SafeDownCast(ren)->GetUseImageBasedLighting() ? 0x200 : 0) +
-    ((this->VBOs->GetNumberOfComponents("tcoord") % 4) << 10);
+    ((this->VBOs->GetNumberOfComponents("tcoord") % 4) << 10) +
+    (this->VBOs->GetNumberOfComponents("colorScalar") ? 0x1000 : 0);
 
   if (cellBO.Program == nullptr || cellBO.ShaderSourceTime < this->GetMTime() ||
     cellBO.ShaderSourceTime < actor->GetProperty()->GetMTime() ||
@@ -2688,6 +2760,51 @@ void vtkOpenGLPolyDataMapper::SetCustomUniforms(vtkOpenGLHelper& cellBO, vtkActo
   gu->SetUniforms(cellBO.Program);
 }
 
+//------------------------------------------------------------------------------
+bool vtkOpenGLPolyDataMapper::CanComputeColorCoordinatesInShader(vtkAbstractArray* scalars)
+{
+  vtkDataArray* dataArray = vtkArrayDownCast<vtkDataArray>(scalars);
+  return this->MapScalarsInShader && dataArray && dataArray->GetDataType() != VTK_BIT &&
+    dataArray->GetNumberOfComponents() <= 4;
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLPolyDataMapper::SetColorScalarShaderParameters(vtkShaderProgram* program)
+{
+  // same values as the texture coordinates of vtkMapper::MapScalarsToTexture
+  const double* tableRange = this->LookupTable->GetRange();
+  double range[2] = { tableRange[0], tableRange[1] };
+  const bool useLogScale = (this->LookupTable->UsingLogScale() != 0);
+  if (useLogScale)
+  {
+    vtkLookupTable::GetLogRange(range, range);
+  }
+  const double texelWidth =
+    (range[1] - range[0]) / static_cast<double>(this->LookupTable->GetNumberOfAvailableColors());
+  const double paddedRange[2] = { range[0] - texelWidth, range[1] + texelWidth };
+  const float colorScalarPaddedRange[2] = { static_cast<float>(paddedRange[0]),
+    static_cast<float>(1.0 / (paddedRange[1] - paddedRange[0])) };
+  const float colorScalarTableRange[2] = { static_cast<float>(tableRange[0]),
+    static_cast<float>(tableRange[1]) };
+  const float colorScalarLogRange[2] = { static_cast<float>(range[0]),
+    static_cast<float>(range[1]) };
+
+  const int numberOfComponents = this->VBOs->GetNumberOfComponents("colorScalar");
+  int component = this->LookupTable->GetVectorComponent();
+  if (this->LookupTable->GetVectorMode() == vtkScalarsToColors::MAGNITUDE &&
+    numberOfComponents > 1)
+  {
+    component = -1;
+  }
+
+  program->SetUniformi("colorScalarComponent", component);
+  program->SetUniformi("colorScalarNumberOfComponents", numberOfComponents);
+  program->SetUniform2f("colorScalarPaddedRange", colorScalarPaddedRange);
+  program->SetUniformi("colorScalarLogScale", useLogScale ? 1 : 0);
+  program->SetUniform2f("colorScalarTableRange", colorScalarTableRange);
+  program->SetUniform2f("colorScalarLogRange", colorScalarLogRange);
+}
+
 //------------------------------------------------------------------------------
 void vtkOpenGLPolyDataMapper::SetMapperShaderParameters(
   vtkOpenGLHelper& cellBO, vtkRenderer* ren, vtkActor* actor)
@@ -2696,6 +2813,11 @@ void vtkOpenGLPolyDataMapper::SetMapperShaderParameters(
   // Now to update the VAO too, if necessary.
   cellBO.Program->SetUniformi("PrimitiveIDOffset", this->PrimitiveIDOffset);
 
+  if (cellBO.Program->IsUniformUsed("colorScalarPaddedRange"))
+  {
+    this->SetColorScalarShaderParameters(cellBO.Program);
+  }
+
   if (cellBO.IBO->IndexCount &&
     (this->VBOs->GetMTime() > cellBO.AttributeUpdateTime ||
       cellBO.ShaderSourceTime > cellBO.AttributeUpdateTime ||
@@ -3969,6 +4091,15 @@ void vtkOpenGLPolyDataMapper::BuildBufferObjects(vtkRenderer* ren, vtkActor* act
     colorTCoords = this->ColorCoordinates;
   }
 
+  // Or the raw scalars when the texture coordinates are computed in the shader
+  vtkDataArray* colorScalars = nullptr;
+  if (this->ColorTextureMap && !this->ColorCoordinates && this->MapScalarsInShader)
+  {
+    int cellFlag = 0;
+    colorScalars = vtkArrayDownCast<vtkDataArray>(vtkAbstractMapper::GetAbstractScalars(poly,
+      this->ScalarMode, this->ArrayAccessMode, this->ArrayId, this->ArrayName, cellFlag));
+  }
+
   vtkOpenGLRenderWindow* renWin = vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow());
   vtkOpenGLVertexBufferObjectCache* cache = renWin->GetVBOCache();
 
@@ -3993,6 +4124,7 @@ void vtkOpenGLPolyDataMapper::BuildBufferObjects(vtkRenderer* ren, vtkActor* act
   this->VBOs->CacheDataArray("scalarColor", c, cache, VTK_UNSIGNED_CHAR);
   this->VBOs->CacheDataArray("tcoord", tcoords, cache, VTK_FLOAT);
   this->VBOs->CacheDataArray("colorTCoord", colorTCoords, cache, VTK_FLOAT);
+  this->VBOs->CacheDataArray("colorScalar", colorScalars, cache, VTK_FLOAT);
 
   // Look for tangents attribute
   vtkFloatArray* tangents = vtkFloatArray::SafeDownCast(poly->GetPointData()->GetTangents());
@@ -4056,7 +4188,11 @@ void vtkOpenGLPolyDataMapper::BuildIBO(vtkRenderer* ren, vtkActor* act, vtkPolyD
 
   // do we really need to rebuild the IBO? Since the operation is costly we
   // construct a string of values that impact the IBO and see if that string has
-  // changed
+  // changed. The mapper and polydata mtimes are left out on purpose: they change
+  // with the scalars, the active array or the lookup table, which only affect
+  // the colors.
+  this->TempState.Clear();
+  this->TempState.Append(poly->GetPoints() ? poly->GetPoints()->GetMTime() : 0, "points mtime");
 
   // So...polydata can return a dummy CellArray when there are no lines
   this->TempState.Append(prims[0]->GetNumberOfCells() ? prims[0]->GetMTime() : 0, "prim0 mtime");
@@ -4066,6 +4202,7 @@ void vtkOpenGLPolyDataMapper::BuildIBO(vtkRenderer* ren, vtkActor* act, vtkPolyD
   this->TempState.Append(representation, "representation");
   this->TempState.Append(ef ? ef->GetMTime() : 0, "edge flags mtime");
   this->TempState.Append(draw_surface_with_edges, "draw surface with edges");
+  this->TempState.Append(prop->GetVertexVisibility(), "vertex visibility");
 
   if (this->IBOBuildState != this->TempState)
   {
@@ -4506,6 +4643,7 @@ void vtkOpenGLPolyDataMapper::RemoveAllVertexAttributeMappings()
 void vtkOpenGLPolyDataMapper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "MapScalarsInShader: " << (this->MapScalarsInShader ? "On" : "Off") << "\n";
 }
 
 //------------------------------------------------------------------------------
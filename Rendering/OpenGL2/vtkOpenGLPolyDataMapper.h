@@ -155,6 +155,21 @@ public:
   vtkSetMacro(UseProgramPointSize, bool);
   vtkBooleanMacro(UseProgramPointSize, bool);
 
+  ///@{
+  /**
+   * When on and the scalars are mapped through a texture, see
+   * InterpolateScalarsBeforeMapping, the raw point scalars are uploaded and
+   * the texture coordinates are computed in the vertex shader, including the
+   * NaN color, the above and below range colors and the log scale. Editing the
+   * lookup table then only rebuilds its texture, and no texture coordinates
+   * are computed on the CPU. Scalars with more than 4 components are still
+   * mapped on the CPU. Default is off.
+   */
+  vtkGetMacro(MapScalarsInShader, bool);
+  vtkSetMacro(MapScalarsInShader, bool);
+  vtkBooleanMacro(MapScalarsInShader, bool);
+  ///@}
+
   enum PrimitiveTypes
   {
     PrimitiveStart = 0,
@@ -220,6 +235,14 @@ protected:
   // handle updating shift scale based on pose changes
   virtual void UpdateCameraShiftScale(vtkRenderer* ren, vtkActor* actor);
 
+  bool CanComputeColorCoordinatesInShader(vtkAbstractArray* scalars) override;
+
+  /**
+   * Set the uniforms used by the vertex shader to compute the texture
+   * coordinates of the raw scalars, see MapScalarsInShader.
+   */
+  void SetColorScalarShaderParameters(vtkShaderProgram* program);
+
   /**
    * helper function to get the appropriate coincident params
    */
@@ -432,6 +455,7 @@ protected:
   vtkNew<vtkTransform> VBOInverseTransform;
   vtkNew<vtkMatrix4x4> VBOShiftScale;
   bool UseProgramPointSize;
+  bool MapScalarsInShader;
 
   // if set to true, tcoords will be passed to the
   // VBO even if the mapper knows of no texture maps
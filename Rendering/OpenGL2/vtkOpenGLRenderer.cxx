@@ -517,8 +517,12 @@ int vtkOpenGLRenderer::UpdateGeometry(vtkFrameBufferObjectBase* fbo)
 
   // loop through props and give them a chance to
   // render themselves as volumetric geometry.
-  if (hasTranslucentPolygonalGeometry == 0 || !this->UseDepthPeeling ||
-    !this->UseDepthPeelingForVolumes)
+  // The volumes are rendered with the translucent geometry by dual depth
+  // peeling or weighted blended translucency when requested.
+  const bool volumesWithTranslucentGeometry = this->UseDepthPeeling
+    ? this->UseDepthPeelingForVolumes
+    : this->UseWeightedBlendedTranslucency;
+  if (hasTranslucentPolygonalGeometry == 0 || !volumesWithTranslucentGeometry)
   {
     timer->MarkStartEvent("Volumes");
     for (i = 0; i < this->PropArrayCount; i++)
@@ -642,6 +646,22 @@ void vtkOpenGLRenderer::DeviceRenderTranslucentPolygonalGeometry(vtkFrameBufferO
     this->TranslucentPass->SetTranslucentPass(tp);
     tp->Delete();
 
+    if (this->UseWeightedBlendedTranslucency)
+    {
+      this->TranslucentPass->SetWeightFunctionToDepth();
+      if (!this->TranslucentPass->GetVolumetricPass())
+      {
+        vtkVolumetricPass* vp = vtkVolumetricPass::New();
+        this->TranslucentPass->SetVolumetricPass(vp);
+        vp->Delete();
+      }
+    }
+    else
+    {
+      this->TranslucentPass->SetWeightFunctionToAverage();
+      this->TranslucentPass->SetVolumetricPass(nullptr);
+    }
+
     vtkRenderState s(this);
     s.SetPropArrayAndCount(this->PropArray, this->PropArrayCount);
     s.SetFrameBuffer(fbo);
@@ -8,12 +8,28 @@
 #include "vtkOpenGLRenderWindow.h"
 #include "vtkShader.h"
 #include "vtkShaderProgram.h"
+#include "vtkVersion.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <sstream>
 
+#include "vtksys/FStream.hxx"
 #include "vtksys/MD5.h"
+#include "vtksys/SystemTools.hxx"
 
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// the header of the files of the program binary cache, followed by the
+// format and the length of the binary
+const char ProgramBinaryMagic[8] = { 'V', 'T', 'K', 'P', 'R', 'O', 'G', '1' };
+const std::uint64_t ProgramBinaryHeaderLength =
+  sizeof(ProgramBinaryMagic) + 2 * sizeof(std::uint32_t);
+}
+
 class vtkOpenGLShaderCache::Private
 {
 public:
@@ -22,6 +38,14 @@ public:
   // map of hash to shader program structs
   std::map<std::string, vtkShaderProgram*> ShaderPrograms;
 
+  // whether the context supports program binaries (-1 when not queried yet),
+  // and the identity of its driver, part of the keys of the binaries
+  int ProgramBinarySupport = -1;
+  std::string DriverIdentity;
+
+  // whether the number of threads of the parallel shader compilation is set
+  bool ParallelShaderCompileEnabled = false;
+
   Private() { md5 = vtksysMD5_New(); }
 
   ~Private() { vtksysMD5_Delete(this->md5); }
@@ -47,6 +71,53 @@ public:
 
     hash = md5Hash;
   }
+
+  //-----------------------------------------------------------------------------
+  bool IsProgramBinarySupported()
+  {
+    if (this->ProgramBinarySupport < 0)
+    {
+      this->ProgramBinarySupport = 0;
+#ifndef GL_ES_VERSION_3_0
+      if (GLAD_GL_VERSION_4_1 || GLAD_GL_ARB_get_program_binary)
+#endif
+      {
+        GLint numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        const char* vendor = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
+        const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+        const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+        if (numFormats > 0 && vendor && renderer && version)
+        {
+          std::ostringstream identity;
+          identity << vendor << '\n'
+                   << renderer << '\n'
+                   << version << '\n'
+                   << vtkVersion::GetVTKVersionFull() << '\n';
+          this->DriverIdentity = identity.str();
+          this->ProgramBinarySupport = 1;
+        }
+      }
+    }
+    return this->ProgramBinarySupport == 1;
+  }
+
+  //-----------------------------------------------------------------------------
+  std::string GetProgramBinaryFileName(
+    const char* directory, vtkShaderProgram* shader, unsigned int numberOfOutputs)
+  {
+    std::ostringstream outputs;
+    outputs << "outputs " << numberOfOutputs;
+    std::string hash;
+    this->ComputeMD5({ this->DriverIdentity.c_str(), shader->GetVertexShader()->GetSource().c_str(),
+                       shader->GetFragmentShader()->GetSource().c_str(),
+                       shader->GetGeometryShader()->GetSource().c_str(),
+                       shader->GetTessControlShader()->GetSource().c_str(),
+                       shader->GetTessEvaluationShader()->GetSource().c_str(),
+                       outputs.str().c_str() },
+      hash);
+    return std::string(directory) + "/" + hash + ".bin";
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -60,6 +131,13 @@ vtkOpenGLShaderCache::vtkOpenGLShaderCache()
   this->OpenGLMajorVersion = 0;
   this->OpenGLMinorVersion = 0;
   this->SyncGLSLShaderVersion = false;
+  this->ProgramBinaryCacheDirectory = nullptr;
+
+  const char* directory = std::getenv("VTK_SHADER_PROGRAM_BINARY_CACHE_DIRECTORY");
+  if (directory && *directory)
+  {
+    this->SetProgramBinaryCacheDirectory(directory);
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -73,6 +151,7 @@ vtkOpenGLShaderCache::~vtkOpenGLShaderCache()
   }
 
   delete this->Internal;
+  this->SetProgramBinaryCacheDirectory(nullptr);
 }
 
 // perform System and Output replacements
@@ -262,6 +341,18 @@ unsigned int vtkOpenGLShaderCache::ReplaceShaderValues(std::string& VSSource, st
 
 vtkShaderProgram* vtkOpenGLShaderCache::ReadyShaderProgram(
   std::map<vtkShader::Type, vtkShader*> shaders, vtkTransformFeedback* cap)
+{
+  return this->ReadyShaderProgram(this->PrepareShaderProgram(shaders), cap);
+}
+
+vtkShaderProgram* vtkOpenGLShaderCache::ReadyShaderProgramAsynchronously(
+  std::map<vtkShader::Type, vtkShader*> shaders)
+{
+  return this->ReadyShaderProgramAsynchronously(this->PrepareShaderProgram(shaders));
+}
+
+vtkShaderProgram* vtkOpenGLShaderCache::PrepareShaderProgram(
+  std::map<vtkShader::Type, vtkShader*>& shaders)
 {
   vtkShader* vertShader = nullptr;
   vtkShader* fragShader = nullptr;
@@ -335,7 +426,7 @@ vtkShaderProgram* vtkOpenGLShaderCache::ReadyShaderProgram(
   vtkShaderProgram* shader = this->GetShaderProgram(shaders);
   shader->SetNumberOfOutputs(count);
 
-  return this->ReadyShaderProgram(shader, cap);
+  return shader;
 }
 
 // return nullptr if there is an issue
@@ -384,11 +475,43 @@ vtkShaderProgram* vtkOpenGLShaderCache::ReadyShaderProgram(
   }
 
   // compile if needed
-  if (!shader->GetCompiled() && !shader->CompileShader())
+  if (!shader->GetCompiled() && this->CompileShaderProgram(shader, true) != 1)
+  {
+    return nullptr;
+  }
+
+  // bind if needed
+  if (!this->BindShader(shader))
+  {
+    return nullptr;
+  }
+
+  return shader;
+}
+
+// return nullptr if there is an issue
+vtkShaderProgram* vtkOpenGLShaderCache::ReadyShaderProgramAsynchronously(vtkShaderProgram* shader)
+{
+  if (!shader)
   {
     return nullptr;
   }
 
+  // start, or check, the compilation if needed
+  if (!shader->GetCompiled())
+  {
+    const int status = this->CompileShaderProgram(shader, false);
+    if (status == 0)
+    {
+      return nullptr;
+    }
+    if (status < 0)
+    {
+      // still compiling, do not bind it
+      return shader;
+    }
+  }
+
   // bind if needed
   if (!this->BindShader(shader))
   {
@@ -398,6 +521,71 @@ vtkShaderProgram* vtkOpenGLShaderCache::ReadyShaderProgram(
   return shader;
 }
 
+// return 1 if the program is compiled, 0 if there is an issue and -1 if the
+// driver is still compiling it
+int vtkOpenGLShaderCache::CompileShaderProgram(vtkShaderProgram* shader, bool wait)
+{
+  // load the program binary when it is in the cache
+  const bool cacheBinary = this->ProgramBinaryCacheDirectory &&
+    *this->ProgramBinaryCacheDirectory && !shader->GetTransformFeedback() &&
+    shader->GetComputeShader()->GetSource().empty() && this->Internal->IsProgramBinarySupported();
+  if (!shader->GetCompilePending())
+  {
+    if (cacheBinary && this->LoadProgramBinary(shader))
+    {
+      return 1;
+    }
+
+    shader->BinaryRetrievable = cacheBinary;
+    if (wait || !vtkShaderProgram::IsParallelShaderCompileSupported())
+    {
+      if (!shader->CompileShader())
+      {
+        return 0;
+      }
+      if (cacheBinary)
+      {
+        this->SaveProgramBinary(shader);
+      }
+      return 1;
+    }
+
+    if (!this->Internal->ParallelShaderCompileEnabled)
+    {
+      // let the driver use as many threads as it wants
+#ifndef GL_ES_VERSION_3_0
+      if (GLAD_GL_KHR_parallel_shader_compile)
+      {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+      }
+      else
+      {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+      }
+#endif
+      this->Internal->ParallelShaderCompileEnabled = true;
+    }
+    if (!shader->StartCompileShader())
+    {
+      return 0;
+    }
+  }
+
+  if (!wait && !shader->IsCompileComplete())
+  {
+    return -1;
+  }
+  if (!shader->FinishCompileShader())
+  {
+    return 0;
+  }
+  if (cacheBinary)
+  {
+    this->SaveProgramBinary(shader);
+  }
+  return 1;
+}
+
 vtkShaderProgram* vtkOpenGLShaderCache::GetShaderProgram(
   std::map<vtkShader::Type, vtkShader*> shaders)
 {
@@ -491,6 +679,87 @@ void vtkOpenGLShaderCache::ReleaseGraphicsResources(vtkWindow* win)
     iter->second->ReleaseGraphicsResources(win);
   }
   this->OpenGLMajorVersion = 0;
+  this->Internal->ProgramBinarySupport = -1;
+  this->Internal->ParallelShaderCompileEnabled = false;
+}
+
+bool vtkOpenGLShaderCache::LoadProgramBinary(vtkShaderProgram* shader)
+{
+  if (shader->GetHandle() != 0)
+  {
+    return false;
+  }
+
+  const std::string fileName = this->Internal->GetProgramBinaryFileName(
+    this->ProgramBinaryCacheDirectory, shader, shader->NumberOfOutputs);
+  std::uint32_t format = 0;
+  std::vector<unsigned char> binary;
+  {
+    vtksys::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+    if (!file)
+    {
+      return false;
+    }
+    char magic[sizeof(ProgramBinaryMagic)];
+    std::uint32_t length = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&format), sizeof(format));
+    file.read(reinterpret_cast<char*>(&length), sizeof(length));
+    if (file && std::equal(magic, magic + sizeof(magic), ProgramBinaryMagic) && length > 0 &&
+      vtksys::SystemTools::FileLength(fileName) == ProgramBinaryHeaderLength + length)
+    {
+      binary.resize(length);
+      file.read(reinterpret_cast<char*>(binary.data()), length);
+      if (!file)
+      {
+        binary.clear();
+      }
+    }
+  }
+
+  if (!shader->LoadBinary(format, binary))
+  {
+    // the binary is truncated or was rejected by the driver: compile the
+    // program instead, and replace the binary
+    vtkDebugMacro(<< "Discarding the program binary " << fileName);
+    vtksys::SystemTools::RemoveFile(fileName);
+    return false;
+  }
+  return true;
+}
+
+void vtkOpenGLShaderCache::SaveProgramBinary(vtkShaderProgram* shader)
+{
+  unsigned int format = 0;
+  std::vector<unsigned char> binary;
+  if (!shader->GetBinary(format, binary) ||
+    !vtksys::SystemTools::MakeDirectory(this->ProgramBinaryCacheDirectory))
+  {
+    return;
+  }
+
+  // write a temporary file first, renamed once complete, so that other
+  // applications sharing the directory never read a partial binary
+  const std::string fileName = this->Internal->GetProgramBinaryFileName(
+    this->ProgramBinaryCacheDirectory, shader, shader->NumberOfOutputs);
+  std::ostringstream temporaryName;
+  temporaryName << fileName << "." << this << ".tmp";
+  bool written;
+  {
+    vtksys::ofstream file(temporaryName.str().c_str(), std::ios::out | std::ios::binary);
+    const std::uint32_t binaryFormat = format;
+    const std::uint32_t length = static_cast<std::uint32_t>(binary.size());
+    file.write(ProgramBinaryMagic, sizeof(ProgramBinaryMagic));
+    file.write(reinterpret_cast<const char*>(&binaryFormat), sizeof(binaryFormat));
+    file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    file.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+    written = static_cast<bool>(file);
+  }
+  if (!written || std::rename(temporaryName.str().c_str(), fileName.c_str()) != 0)
+  {
+    vtkDebugMacro(<< "Could not write the program binary " << fileName);
+    vtksys::SystemTools::RemoveFile(temporaryName.str());
+  }
 }
 
 void vtkOpenGLShaderCache::ReleaseCurrentShader()
@@ -528,5 +797,7 @@ int vtkOpenGLShaderCache::BindShader(vtkShaderProgram* shader)
 void vtkOpenGLShaderCache::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ProgramBinaryCacheDirectory: "
+     << (this->ProgramBinaryCacheDirectory ? this->ProgramBinaryCacheDirectory : "(none)") << "\n";
 }
 VTK_ABI_NAMESPACE_END
@@ -5,6 +5,11 @@
  * @brief   manage Shader Programs within a context
  *
  * vtkOpenGLShaderCache manages shader program compilation and binding
+ *
+ * Optionally, the binaries of the linked programs can be stored in a
+ * directory and reused by later runs of the application instead of
+ * compiling and linking the shaders again, see
+ * SetProgramBinaryCacheDirectory().
  */
 
 #ifndef vtkOpenGLShaderCache_h
@@ -58,6 +63,24 @@ public:
   virtual vtkShaderProgram* ReadyShaderProgram(
     vtkShaderProgram* shader, vtkTransformFeedback* cap = nullptr);
 
+  ///@{
+  /**
+   * Same as ReadyShaderProgram(), without waiting for the driver to compile
+   * and link the program when it supports parallel shader compilation (see
+   * vtkShaderProgram::IsParallelShaderCompileSupported()). While the driver
+   * compiles the program in its own threads, the program is returned unbound
+   * with vtkShaderProgram::GetCompilePending() true; call
+   * ReadyShaderProgramAsynchronously() with it again, in a later frame, to
+   * bind it once it is ready. The shaders version performs the shader
+   * replacements and must only be called once per program. Return nullptr on
+   * failure. Without parallel shader compilation support, the program is
+   * compiled and bound before returning, as with ReadyShaderProgram().
+   */
+  virtual vtkShaderProgram* ReadyShaderProgramAsynchronously(
+    std::map<vtkShader::Type, vtkShader*> shaders);
+  virtual vtkShaderProgram* ReadyShaderProgramAsynchronously(vtkShaderProgram* shader);
+  ///@}
+
   /**
    * Release the current shader.  Basically go back to
    * having no shaders loaded.  This is useful for old
@@ -80,6 +103,27 @@ public:
   // Set the time in seconds elapsed since the first render
   void SetElapsedTime(float val) { this->ElapsedTime = val; }
 
+  ///@{
+  /**
+   * Set/Get the directory where the binaries of the linked shader programs
+   * are cached. When set, a program is loaded from its binary in this
+   * directory when there is one, and its binary is written there after it
+   * is compiled otherwise, which avoids compiling the shaders again in later
+   * runs of the application. The binaries are keyed by the shader sources
+   * and by the vendor, renderer and version of the OpenGL driver, so that
+   * they are not reused after a driver or hardware change; binaries rejected
+   * by the driver are removed and the program is compiled as usual.
+   * Programs using transform feedback are not cached. The directory is
+   * created if needed. The default is the value of the
+   * VTK_SHADER_PROGRAM_BINARY_CACHE_DIRECTORY environment variable, or none
+   * (no caching) when it is not set. The cache requires OpenGL 4.1, the
+   * ARB_get_program_binary extension or OpenGL ES 3.0; it is ignored
+   * otherwise.
+   */
+  vtkSetFilePathMacro(ProgramBinaryCacheDirectory);
+  vtkGetFilePathMacro(ProgramBinaryCacheDirectory);
+  ///@}
+
 protected:
   vtkOpenGLShaderCache();
   ~vtkOpenGLShaderCache() override;
@@ -92,8 +136,20 @@ protected:
   virtual vtkShaderProgram* GetShaderProgram(const char* vertexCode, const char* fragmentCode,
     const char* geometryCode, const char* tessControlCode, const char* tessEvalCode);
   virtual vtkShaderProgram* GetShaderProgram(std::map<vtkShader::Type, vtkShader*> shaders);
+
+  // perform the replacements in the shaders and get their program
+  vtkShaderProgram* PrepareShaderProgram(std::map<vtkShader::Type, vtkShader*>& shaders);
+
+  // compile the program, or load it from the binary cache, return 1 on
+  // success, 0 on failure and -1 if the driver is still compiling it (only
+  // when not waiting for it)
+  int CompileShaderProgram(vtkShaderProgram* shader, bool wait);
   virtual int BindShader(vtkShaderProgram* shader);
 
+  // load the binary of the program from, or save it to, the binary cache
+  bool LoadProgramBinary(vtkShaderProgram* shader);
+  void SaveProgramBinary(vtkShaderProgram* shader);
+
   class Private;
   Private* Internal;
   vtkShaderProgram* LastShaderBound;
@@ -104,6 +160,8 @@ protected:
 
   float ElapsedTime;
 
+  char* ProgramBinaryCacheDirectory;
+
 private:
   vtkOpenGLShaderCache(const vtkOpenGLShaderCache&) = delete;
   void operator=(const vtkOpenGLShaderCache&) = delete;
@@ -326,6 +326,11 @@ void vtkOpenGLVertexBufferObjectGroup::BuildAllVBOs(vtkOpenGLVertexBufferObjectC
     }
   }
 
+  for (vboIter i = this->UsedVBOs.begin(); i != this->UsedVBOs.end(); ++i)
+  {
+    i->second->SetStreaming(this->StreamingUploads);
+  }
+
   // we always upload appended data :-(
   for (arrayIter i = this->UsedDataArrays.begin(); i != this->UsedDataArrays.end(); ++i)
   {
@@ -391,5 +396,6 @@ vtkMTimeType vtkOpenGLVertexBufferObjectGroup::GetMTime()
 void vtkOpenGLVertexBufferObjectGroup::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "StreamingUploads: " << (this->StreamingUploads ? "On" : "Off") << "\n";
 }
 VTK_ABI_NAMESPACE_END
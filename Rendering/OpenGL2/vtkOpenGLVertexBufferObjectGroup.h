@@ -158,10 +158,25 @@ public:
    */
   vtkMTimeType GetMTime() override;
 
+  ///@{
+  /**
+   * When on, BuildAllVBOs uploads the VBOs with the streaming mode of
+   * vtkOpenGLBufferObject: the data goes through persistently mapped staging
+   * buffers instead of reallocating the VBOs. Turn it on for data re-uploaded
+   * every frame, such as time-varying points and scalars during playback.
+   * Default is off.
+   */
+  vtkSetMacro(StreamingUploads, bool);
+  vtkGetMacro(StreamingUploads, bool);
+  vtkBooleanMacro(StreamingUploads, bool);
+  ///@}
+
 protected:
   vtkOpenGLVertexBufferObjectGroup();
   ~vtkOpenGLVertexBufferObjectGroup() override;
 
+  bool StreamingUploads = false;
+
   std::map<std::string, vtkOpenGLVertexBufferObject*> UsedVBOs;
   std::map<std::string, std::vector<vtkDataArray*>> UsedDataArrays;
   std::map<std::string, std::map<vtkDataArray*, vtkIdType>> UsedDataArrayMaps;
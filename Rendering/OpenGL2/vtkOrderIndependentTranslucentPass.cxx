@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "vtkOrderIndependentTranslucentPass.h"
+#include "vtkAbstractVolumeMapper.h"
 #include "vtkInformation.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLActor.h"
@@ -30,6 +31,7 @@
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkOrderIndependentTranslucentPass);
 vtkCxxSetObjectMacro(vtkOrderIndependentTranslucentPass, TranslucentPass, vtkRenderPass);
+vtkCxxSetObjectMacro(vtkOrderIndependentTranslucentPass, VolumetricPass, vtkRenderPass);
 
 //------------------------------------------------------------------------------
 vtkOrderIndependentTranslucentPass::vtkOrderIndependentTranslucentPass()
@@ -49,6 +51,8 @@ vtkOrderIndependentTranslucentPass::vtkOrderIndependentTranslucentPass()
   this->ViewportY = 0;
   this->ViewportWidth = 100;
   this->ViewportHeight = 100;
+
+  this->WeightFunctionTime.Modified();
 }
 
 //------------------------------------------------------------------------------
@@ -58,6 +62,7 @@ vtkOrderIndependentTranslucentPass::~vtkOrderIndependentTranslucentPass()
   {
     this->TranslucentPass->Delete();
   }
+  this->SetVolumetricPass(nullptr);
   if (this->TranslucentZTexture)
   {
     this->TranslucentZTexture->UnRegister(this);
@@ -96,6 +101,10 @@ void vtkOrderIndependentTranslucentPass::ReleaseGraphicsResources(vtkWindow* w)
   {
     this->TranslucentPass->ReleaseGraphicsResources(w);
   }
+  if (this->VolumetricPass)
+  {
+    this->VolumetricPass->ReleaseGraphicsResources(w);
+  }
   if (this->TranslucentZTexture)
   {
     this->TranslucentZTexture->ReleaseGraphicsResources(w);
@@ -130,6 +139,37 @@ void vtkOrderIndependentTranslucentPass::PrintSelf(ostream& os, vtkIndent indent
   {
     os << "(none)" << endl;
   }
+
+  os << indent << "VolumetricPass:";
+  if (this->VolumetricPass != nullptr)
+  {
+    this->VolumetricPass->PrintSelf(os, indent);
+  }
+  else
+  {
+    os << "(none)" << endl;
+  }
+
+  os << indent << "WeightFunction: " << (this->WeightFunction == DEPTH ? "Depth" : "Average")
+     << endl;
+}
+
+//------------------------------------------------------------------------------
+void vtkOrderIndependentTranslucentPass::SetWeightFunction(int weightFunction)
+{
+  weightFunction = weightFunction == DEPTH ? DEPTH : AVERAGE;
+  if (this->WeightFunction != weightFunction)
+  {
+    this->WeightFunction = weightFunction;
+    this->WeightFunctionTime.Modified();
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkMTimeType vtkOrderIndependentTranslucentPass::GetShaderStageMTime()
+{
+  return this->WeightFunctionTime.GetMTime();
 }
 
 void vtkOrderIndependentTranslucentPass::BlendFinalPeel(vtkOpenGLRenderWindow* renWin)
@@ -153,6 +193,9 @@ void vtkOrderIndependentTranslucentPass::BlendFinalPeel(vtkOpenGLRenderWindow* r
       "translucentRGBATexture", this->TranslucentRGBATexture->GetTextureUnit());
     this->FinalBlend->Program->SetUniformi(
       "translucentRTexture", this->TranslucentRTexture->GetTextureUnit());
+    // the depth weights of faint fragments are much smaller than one
+    this->FinalBlend->Program->SetUniformf(
+      "minimumWeight", this->WeightFunction == DEPTH ? 1e-6f : 0.01f);
 
     this->FinalBlend->Render();
   }
@@ -276,6 +319,7 @@ void vtkOrderIndependentTranslucentPass::Render(const vtkRenderState* s)
   this->State->PushFramebufferBindings();
   this->Framebuffer->Bind(vtkOpenGLFramebufferObject::GetDrawMode());
   this->Framebuffer->ActivateDrawBuffers(2);
+  this->SetActiveDrawBuffers(2);
 
 #ifdef GL_MULTISAMPLE
   bool multiSampleStatus = this->State->GetEnumState(GL_MULTISAMPLE);
@@ -332,6 +376,39 @@ void vtkOrderIndependentTranslucentPass::Render(const vtkRenderState* s)
   // render the translucent data into the FO
   this->TranslucentPass->Render(s);
 
+  // accumulate the volumes in the same buffers, they do not write depth so
+  // that they are all composited with the translucent geometry
+  int numberOfRenderedVolumes = 0;
+  if (this->VolumetricPass)
+  {
+    // Prevent the volume mappers from replacing the blending of the pass with
+    // their own, as vtkDualDepthPeelingPass does, and set the rest of their
+    // state here instead. The property keys were created by PreRender.
+    size_t numProps = s->GetPropArrayCount();
+    for (size_t i = 0; i < numProps; ++i)
+    {
+      s->GetPropArray()[i]->GetPropertyKeys()->Set(vtkOpenGLActor::GLDepthMaskOverride(), -1);
+    }
+
+    GLint cullFaceMode;
+    this->State->vtkglGetIntegerv(GL_CULL_FACE_MODE, &cullFaceMode);
+    const bool cullFaceEnabled = this->State->GetEnumState(GL_CULL_FACE);
+    this->State->vtkglCullFace(GL_BACK);
+    this->State->vtkglEnable(GL_CULL_FACE);
+    this->State->vtkglDepthMask(GL_FALSE);
+    this->State->vtkglBlendFuncSeparate(GL_ONE, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+
+    this->VolumetricPass->Render(s);
+    numberOfRenderedVolumes = this->VolumetricPass->GetNumberOfRenderedProps();
+
+    this->State->vtkglCullFace(cullFaceMode);
+    this->State->SetEnumState(GL_CULL_FACE, cullFaceEnabled);
+    for (size_t i = 0; i < numProps; ++i)
+    {
+      s->GetPropArray()[i]->GetPropertyKeys()->Remove(vtkOpenGLActor::GLDepthMaskOverride());
+    }
+  }
+
   // back to the original FO
   this->State->PopFramebufferBindings();
 
@@ -372,18 +449,55 @@ void vtkOrderIndependentTranslucentPass::Render(const vtkRenderState* s)
 
   this->PostRender(s);
 
-  this->NumberOfRenderedProps = this->TranslucentPass->GetNumberOfRenderedProps();
+  this->NumberOfRenderedProps =
+    this->TranslucentPass->GetNumberOfRenderedProps() + numberOfRenderedVolumes;
 
   vtkOpenGLCheckErrorMacro("failed after Render");
 }
 
 //------------------------------------------------------------------------------
 bool vtkOrderIndependentTranslucentPass::PostReplaceShaderValues(
-  std::string&, std::string&, std::string& fragmentShader, vtkAbstractMapper*, vtkProp*)
+  std::string&, std::string&, std::string& fragmentShader, vtkAbstractMapper* mapper, vtkProp*)
 {
+  // The depth weight follows the window depth weight of McGuire and Bavoil,
+  // "Weighted Blended Order-Independent Transparency". As the clipping range
+  // is fitted to the props, the window depths span the whole [0, 1] range
+  // and the weight decreases over all of it. The weights stay in the range
+  // of the half float textures when many layers are accumulated.
+  if (this->WeightFunction == DEPTH)
+  {
+    vtkShaderProgram::Substitute(fragmentShader, "//VTK::DepthPeeling::Dec",
+      "//VTK::DepthPeeling::Dec\n"
+      "float oitWeight(float alpha, float depth)\n"
+      "{\n"
+      "  return clamp(pow(min(1.0, alpha * 10.0) + 0.01, 3.0) * 30.0 *\n"
+      "    pow(1.0 - depth * 0.99, 3.0), 1e-4, 30.0);\n"
+      "}\n");
+  }
+  else
+  {
+    vtkShaderProgram::Substitute(fragmentShader, "//VTK::DepthPeeling::Dec",
+      "//VTK::DepthPeeling::Dec\n"
+      "float oitWeight(float alpha, float depth) { return 1.0; }\n");
+  }
+
+  if (vtkAbstractVolumeMapper::SafeDownCast(mapper))
+  {
+    // The color of a ray is already premultiplied, it is accumulated as a
+    // single fragment at the depth where the ray enters the volume. This is
+    // the last statement of the ray casting.
+    vtkShaderProgram::Substitute(fragmentShader, "//VTK::DepthPass::Exit",
+      "  float oitFragmentWeight = oitWeight(gl_FragData[0].a, gl_FragCoord.z);\n"
+      "  gl_FragData[0] = vec4(gl_FragData[0].rgb*oitFragmentWeight, gl_FragData[0].a);\n"
+      "  gl_FragData[1].r = gl_FragData[0].a*oitFragmentWeight;\n");
+    return true;
+  }
+
   vtkShaderProgram::Substitute(fragmentShader, "//VTK::DepthPeeling::Impl",
-    "  gl_FragData[0] = vec4(gl_FragData[0].rgb*gl_FragData[0].a, gl_FragData[0].a);\n"
-    "  gl_FragData[1].r = gl_FragData[0].a;\n");
+    "  float oitFragmentWeight = oitWeight(gl_FragData[0].a, gl_FragCoord.z);\n"
+    "  gl_FragData[0] =\n"
+    "    vec4(gl_FragData[0].rgb*gl_FragData[0].a*oitFragmentWeight, gl_FragData[0].a);\n"
+    "  gl_FragData[1].r = gl_FragData[0].a*oitFragmentWeight;\n");
 
   return true;
 }
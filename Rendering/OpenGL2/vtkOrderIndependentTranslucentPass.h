@@ -7,8 +7,20 @@
  * Simple version that uses average alpha weighted color
  * and correct final computed alpha. Single pass approach.
  *
+ * With the DEPTH weight function, the fragments are also weighted by their
+ * depth and opacity as in the weighted blended order-independent
+ * transparency of McGuire and Bavoil, so that the nearest and most opaque
+ * layers dominate the color as they would when sorted. The geometry is still
+ * rendered once, whatever the number of layers.
+ *
+ * When a VolumetricPass is set, the volumes are rendered in the same
+ * framebuffer after the translucent geometry, each ray being accumulated as
+ * a single fragment at the depth where it enters the volume, so that
+ * volumes and translucent surfaces are composited in depth order. The
+ * volumes must be rendered with an image sample distance of 1.
+ *
  * @sa
- * vtkRenderPass, vtkTranslucentPass, vtkFramebufferPass
+ * vtkRenderPass, vtkTranslucentPass, vtkFramebufferPass, vtkDualDepthPeelingPass
  */
 
 #ifndef vtkOrderIndependentTranslucentPass_h
@@ -16,6 +28,7 @@
 
 #include "vtkOpenGLRenderPass.h"
 #include "vtkRenderingOpenGL2Module.h" // For export macro
+#include "vtkTimeStamp.h"              // For ivar
 #include "vtkWrappingHints.h"          // For VTK_MARSHALAUTO
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -57,9 +70,38 @@ public:
   virtual void SetTranslucentPass(vtkRenderPass* translucentPass);
   ///@}
 
+  ///@{
+  /**
+   * Delegate for rendering the volumes with the translucent geometry. It is
+   * usually set to a vtkVolumetricPass. When it is NULL, the volumes are not
+   * rendered by this pass. Initial value is a NULL pointer.
+   */
+  vtkGetObjectMacro(VolumetricPass, vtkRenderPass);
+  virtual void SetVolumetricPass(vtkRenderPass* volumetricPass);
+  ///@}
+
+  enum WeightFunctionType
+  {
+    AVERAGE = 0,
+    DEPTH = 1
+  };
+
+  ///@{
+  /**
+   * Set/Get the weight of the translucent fragments, AVERAGE for a weight of
+   * one or DEPTH for a weight decreasing with the depth and increasing with
+   * the opacity of the fragments. Initial value is AVERAGE.
+   */
+  void SetWeightFunction(int weightFunction);
+  vtkGetMacro(WeightFunction, int);
+  void SetWeightFunctionToAverage() { this->SetWeightFunction(AVERAGE); }
+  void SetWeightFunctionToDepth() { this->SetWeightFunction(DEPTH); }
+  ///@}
+
   // vtkOpenGLRenderPass virtuals:
   bool PostReplaceShaderValues(std::string& vertexShader, std::string& geometryShader,
     std::string& fragmentShader, vtkAbstractMapper* mapper, vtkProp* prop) override;
+  vtkMTimeType GetShaderStageMTime() override;
 
 protected:
   /**
@@ -73,6 +115,10 @@ protected:
   ~vtkOrderIndependentTranslucentPass() override;
 
   vtkRenderPass* TranslucentPass;
+  vtkRenderPass* VolumetricPass = nullptr;
+
+  int WeightFunction = AVERAGE;
+  vtkTimeStamp WeightFunctionTime;
 
   ///@{
   /**
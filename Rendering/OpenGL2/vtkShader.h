@@ -66,6 +66,18 @@ public:
    */
   bool Compile();
 
+  ///@{
+  /**
+   * Compile the shader in two steps: StartCompile() submits the source to the
+   * driver without waiting for the compilation, which a driver supporting
+   * parallel shader compilation performs in its own threads, and
+   * FinishCompile() waits for the compilation if needed and returns whether
+   * it succeeded. Compile() is both steps.
+   */
+  bool StartCompile();
+  bool FinishCompile();
+  ///@}
+
   /** Delete the shader.
    * @note This should only be done once the ShaderProgram is done with the
    * Shader.
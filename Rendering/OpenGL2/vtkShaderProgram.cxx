@@ -94,6 +94,8 @@ vtkShaderProgram::vtkShaderProgram()
   this->TessEvaluationShaderHandle = 0;
   this->Linked = false;
   this->Bound = false;
+  this->BinaryRetrievable = false;
+  this->CompilePending = false;
 
   this->FileNamePrefixForDebugging = nullptr;
 }
@@ -457,6 +459,15 @@ vtkMTimeType vtkShaderProgram::GetUniformGroupUpdateTime(int gid)
 }
 
 bool vtkShaderProgram::Link()
+{
+  if (this->Linked)
+  {
+    return true;
+  }
+  return this->StartLink() && this->FinishLink();
+}
+
+bool vtkShaderProgram::StartLink()
 {
   if (this->Linked)
   {
@@ -487,8 +498,24 @@ bool vtkShaderProgram::Link()
   }
 #endif
 
-  GLint isCompiled;
+  if (this->BinaryRetrievable)
+  {
+    glProgramParameteri(
+      static_cast<GLuint>(this->Handle), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+
   glLinkProgram(static_cast<GLuint>(this->Handle));
+  return true;
+}
+
+bool vtkShaderProgram::FinishLink()
+{
+  if (this->Linked)
+  {
+    return true;
+  }
+
+  GLint isCompiled;
   glGetProgramiv(static_cast<GLuint>(this->Handle), GL_LINK_STATUS, &isCompiled);
   if (isCompiled == 0)
   {
@@ -562,93 +589,85 @@ bool vtkShaderProgram::Bind()
 // return 0 if there is an issue
 int vtkShaderProgram::CompileShader()
 {
-  if (!this->GetVertexShader()->GetSource().empty() && !this->GetVertexShader()->Compile())
-  {
-    this->ReportShaderError(this->GetVertexShader());
-    return 0;
-  }
-  if (!this->GetFragmentShader()->GetSource().empty() && !this->GetFragmentShader()->Compile())
-  {
-    this->ReportShaderError(this->GetFragmentShader());
-    return 0;
-  }
-  if (!this->GetGeometryShader()->GetSource().empty() && !this->GetGeometryShader()->Compile())
-  {
-    this->ReportShaderError(this->GetGeometryShader());
-    return 0;
-  }
-  if (!this->GetGeometryShader()->GetSource().empty() &&
-    !this->AttachShader(this->GetGeometryShader()))
-  {
-    vtkErrorMacro(<< this->GetError());
-    return 0;
-  }
-  if (!this->GetComputeShader()->GetSource().empty())
-  {
-    if (!this->GetComputeShader()->Compile())
-    {
-      this->ReportShaderError(this->GetComputeShader());
-      return 0;
-    }
-    if (!this->AttachShader(this->GetComputeShader()))
-    {
-      vtkErrorMacro(<< this->GetError());
-      return 0;
-    }
+  return this->StartCompileShader() && this->FinishCompileShader();
+}
 
-    if (!this->Link())
+// return 0 if there is an issue
+int vtkShaderProgram::StartCompileShader()
+{
+  this->CompilePending = false;
+  vtkShader* shaders[6] = { this->VertexShader, this->FragmentShader, this->GeometryShader,
+    this->ComputeShader, this->TessControlShader, this->TessEvaluationShader };
+  for (vtkShader* shader : shaders)
+  {
+    if (!shader->GetSource().empty() && !shader->StartCompile())
     {
-      vtkErrorMacro(<< "Links failed: " << this->GetError());
+      this->ReportShaderError(shader);
       return 0;
     }
-
-    this->Compiled = true;
-    return 1;
   }
-  if (!this->GetTessControlShader()->GetSource().empty())
+
+  if (!this->ComputeShader->GetSource().empty())
   {
-    if (!this->GetTessControlShader()->Compile())
-    {
-      this->ReportShaderError(this->GetTessControlShader());
-      return 0;
-    }
-    if (!this->AttachShader(this->GetTessControlShader()))
+    if (!this->AttachShader(this->ComputeShader))
     {
       vtkErrorMacro(<< this->GetError());
       return 0;
     }
   }
-  if (!this->GetTessEvaluationShader()->GetSource().empty())
+  else
   {
-    if (!this->GetTessEvaluationShader()->Compile())
+    vtkShader* attached[5] = { this->GeometryShader, this->TessControlShader,
+      this->TessEvaluationShader, this->VertexShader, this->FragmentShader };
+    for (vtkShader* shader : attached)
     {
-      this->ReportShaderError(this->GetTessEvaluationShader());
-      return 0;
+      // the vertex and fragment shaders are required
+      const bool optional = shader != this->VertexShader && shader != this->FragmentShader;
+      if ((!optional || !shader->GetSource().empty()) && !this->AttachShader(shader))
+      {
+        vtkErrorMacro(<< this->GetError());
+        return 0;
+      }
     }
-    if (!this->AttachShader(this->GetTessEvaluationShader()))
+
+    // Setup transform feedback:
+    if (this->TransformFeedback)
     {
-      vtkErrorMacro(<< this->GetError());
-      return 0;
+      this->TransformFeedback->BindVaryings(this);
     }
   }
-  if (!this->AttachShader(this->GetVertexShader()))
+
+  if (!this->StartLink())
   {
-    vtkErrorMacro(<< this->GetError());
+    vtkErrorMacro(<< "Links failed: " << this->GetError());
     return 0;
   }
-  if (!this->AttachShader(this->GetFragmentShader()))
+
+  this->CompilePending = true;
+  return 1;
+}
+
+// return 0 if there is an issue
+int vtkShaderProgram::FinishCompileShader()
+{
+  if (!this->CompilePending)
   {
-    vtkErrorMacro(<< this->GetError());
     return 0;
   }
+  this->CompilePending = false;
 
-  // Setup transform feedback:
-  if (this->TransformFeedback)
+  vtkShader* shaders[6] = { this->VertexShader, this->FragmentShader, this->GeometryShader,
+    this->ComputeShader, this->TessControlShader, this->TessEvaluationShader };
+  for (vtkShader* shader : shaders)
   {
-    this->TransformFeedback->BindVaryings(this);
+    if (!shader->GetSource().empty() && !shader->FinishCompile())
+    {
+      this->ReportShaderError(shader);
+      return 0;
+    }
   }
 
-  if (!this->Link())
+  if (!this->FinishLink())
   {
     vtkErrorMacro(<< "Links failed: " << this->GetError());
     return 0;
@@ -658,6 +677,95 @@ int vtkShaderProgram::CompileShader()
   return 1;
 }
 
+bool vtkShaderProgram::IsCompileComplete()
+{
+  if (!this->CompilePending)
+  {
+    return true;
+  }
+#ifdef GL_COMPLETION_STATUS_KHR
+  if (vtkShaderProgram::IsParallelShaderCompileSupported())
+  {
+    // does not wait for the driver, unlike querying the link status
+    GLint complete = GL_TRUE;
+    glGetProgramiv(static_cast<GLuint>(this->Handle), GL_COMPLETION_STATUS_KHR, &complete);
+    return complete != GL_FALSE;
+  }
+#endif
+  return true;
+}
+
+bool vtkShaderProgram::IsParallelShaderCompileSupported()
+{
+#if defined(GL_ES_VERSION_3_0) || defined(GL_ES_VERSION_2_0)
+  return false;
+#else
+  return GLAD_GL_KHR_parallel_shader_compile != 0 || GLAD_GL_ARB_parallel_shader_compile != 0;
+#endif
+}
+
+bool vtkShaderProgram::LoadBinary(unsigned int format, const std::vector<unsigned char>& binary)
+{
+  if (this->Handle != 0 || binary.empty())
+  {
+    return false;
+  }
+
+  GLuint handle_ = glCreateProgram();
+  if (handle_ == 0)
+  {
+    this->Error = "Could not create shader program.";
+    return false;
+  }
+
+  // clear out the list of uniforms used
+  this->ClearMaps();
+
+  glProgramBinary(handle_, static_cast<GLenum>(format), binary.data(),
+    static_cast<GLsizei>(binary.size()));
+  GLint isLinked = 0;
+  glGetProgramiv(handle_, GL_LINK_STATUS, &isLinked);
+  if (isLinked == 0)
+  {
+    glDeleteProgram(handle_);
+    return false;
+  }
+
+  this->Handle = static_cast<int>(handle_);
+  this->Linked = true;
+  this->Compiled = true;
+  return true;
+}
+
+bool vtkShaderProgram::GetBinary(unsigned int& format, std::vector<unsigned char>& binary)
+{
+  if (!this->Linked)
+  {
+    return false;
+  }
+
+  GLint length = 0;
+  glGetProgramiv(static_cast<GLuint>(this->Handle), GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0)
+  {
+    return false;
+  }
+
+  binary.resize(static_cast<size_t>(length));
+  GLsizei written = 0;
+  GLenum binaryFormat = 0;
+  glGetProgramBinary(
+    static_cast<GLuint>(this->Handle), length, &written, &binaryFormat, binary.data());
+  if (written <= 0)
+  {
+    binary.clear();
+    return false;
+  }
+  binary.resize(static_cast<size_t>(written));
+  format = static_cast<unsigned int>(binaryFormat);
+  return true;
+}
+
 void vtkShaderProgram::Release()
 {
   glUseProgram(0);
@@ -668,7 +776,7 @@ void vtkShaderProgram::ReleaseGraphicsResources(vtkWindow* win)
 {
   this->Release();
 
-  if (this->Compiled)
+  if (this->Compiled || this->CompilePending)
   {
     this->DetachShader(this->VertexShader);
     this->DetachShader(this->FragmentShader);
@@ -681,6 +789,7 @@ void vtkShaderProgram::ReleaseGraphicsResources(vtkWindow* win)
     this->TessControlShader->Cleanup();
     this->TessEvaluationShader->Cleanup();
     this->Compiled = false;
+    this->CompilePending = false;
   }
 
   vtkOpenGLRenderWindow* renWin = vtkOpenGLRenderWindow::SafeDownCast(win);
@@ -17,6 +17,7 @@
 
 #include <map>    // For member variables.
 #include <string> // For member variables.
+#include <vector> // For program binaries.
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkMatrix3x3;
@@ -107,6 +108,19 @@ public:
   vtkBooleanMacro(Compiled, bool);
   ///@}
 
+  /**
+   * Return true while the program is being compiled and linked by the driver
+   * in its own threads, see
+   * vtkOpenGLShaderCache::ReadyShaderProgramAsynchronously().
+   */
+  bool GetCompilePending() const { return this->CompilePending; }
+
+  /**
+   * Check if the driver can compile and link shader programs in its own
+   * threads (KHR_parallel_shader_compile or ARB_parallel_shader_compile).
+   */
+  static bool IsParallelShaderCompileSupported();
+
   /**
    * Set/Get the md5 hash of this program
    */
@@ -354,6 +368,20 @@ protected:
    */
   virtual int CompileShader();
 
+  ///@{
+  /**
+   * Compile this shader program and attached shaders in two steps:
+   * StartCompileShader() submits the shaders and the link of the program to
+   * the driver without waiting for them, and FinishCompileShader() waits for
+   * the driver if needed and checks the results. IsCompileComplete() returns
+   * whether FinishCompileShader() would not wait. CompileShader() is both
+   * steps.
+   */
+  int StartCompileShader();
+  int FinishCompileShader();
+  bool IsCompileComplete();
+  ///@}
+
   /**
    * Attempt to link the shader program.
    * @return false on failure. Query error to get the reason.
@@ -361,6 +389,15 @@ protected:
    */
   bool Link();
 
+  ///@{
+  /**
+   * Link the shader program in two steps, without waiting for the driver
+   * between them. Link() is both steps.
+   */
+  bool StartLink();
+  bool FinishLink();
+  ///@}
+
   /**
    * Bind the program in order to use it. If the program has not been linked
    * then link() will be called.
@@ -370,6 +407,21 @@ protected:
   /** Releases the shader program from the current context. */
   void Release();
 
+  /**
+   * Create the program from a binary previously returned by GetBinary(), in
+   * place of compiling and linking its shaders. Return false if the program
+   * already has a handle or if the binary is rejected by the driver (for
+   * instance after a driver update), in which case the program must be
+   * compiled as usual.
+   */
+  bool LoadBinary(unsigned int format, const std::vector<unsigned char>& binary);
+
+  /**
+   * Get the binary of the linked program and its format. Return false if the
+   * driver does not provide it.
+   */
+  bool GetBinary(unsigned int& format, std::vector<unsigned char>& binary);
+
   /************* end **************************************/
 
   vtkShader* VertexShader;
@@ -397,6 +449,14 @@ protected:
   bool Bound;
   bool Compiled;
 
+  // whether the binary of the program is retrieved after linking, in which
+  // case the driver is told to keep it
+  bool BinaryRetrievable;
+
+  // whether the program is being compiled, between StartCompileShader() and
+  // FinishCompileShader()
+  bool CompilePending;
+
   // for glsl 1.5 or later, how many outputs
   // does this shader create
   // they will be bound in order to
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * Render the blocks of a multiblock dataset split over several devices with
+ * vtkMultiDeviceRenderManager, in parallel and one after the other, and check
+ * that the composited images are the one rendered by a single device.
+ */
+
+#include <vtkFloatArray.h>
+#include <vtkMultiBlockDataSet.h>
+#include <vtkMultiDeviceRenderManager.h>
+#include <vtkNew.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+#include <vtkUnsignedCharArray.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+void Render(vtkMultiBlockDataSet* blocks, int numberOfDevices, bool parallel,
+  vtkUnsignedCharArray* colors, vtkFloatArray* depths)
+{
+  vtkNew<vtkRenderer> renderer;
+  renderer->SetBackground(0.1, 0.2, 0.3);
+  double bounds[6];
+  blocks->GetBounds(bounds);
+  renderer->ResetCamera(bounds);
+
+  vtkNew<vtkMultiDeviceRenderManager> manager;
+  manager->SetNumberOfDevices(numberOfDevices);
+  manager->SetRenderInParallel(parallel);
+  manager->SetRenderer(renderer);
+  manager->SetSize(200, 150);
+  manager->AddBlocks(blocks);
+  manager->Render();
+
+  colors->DeepCopy(manager->GetColorBuffer());
+  depths->DeepCopy(manager->GetDepthBuffer());
+}
+
+//------------------------------------------------------------------------------
+bool Compare(vtkUnsignedCharArray* expectedColors, vtkFloatArray* expectedDepths,
+  vtkUnsignedCharArray* colors, vtkFloatArray* depths, const char* name)
+{
+  if (expectedColors->GetNumberOfValues() != colors->GetNumberOfValues() ||
+    expectedDepths->GetNumberOfValues() != depths->GetNumberOfValues())
+  {
+    std::cerr << "Unexpected size of the " << name << " image." << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < colors->GetNumberOfValues(); ++i)
+  {
+    if (std::abs(expectedColors->GetValue(i) - colors->GetValue(i)) > 1)
+    {
+      std::cerr << "Unexpected color in the " << name << " image." << std::endl;
+      return false;
+    }
+  }
+  for (vtkIdType i = 0; i < depths->GetNumberOfValues(); ++i)
+  {
+    if (std::abs(expectedDepths->GetValue(i) - depths->GetValue(i)) > 1e-5f)
+    {
+      std::cerr << "Unexpected depth in the " << name << " image." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestMultiDeviceRenderManager(int, char*[])
+{
+  // Overlapping spheres of different resolutions, so that every device
+  // renders some of them and the depth test between devices matters.
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  for (int i = 0; i < 7; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(0.6 * (i % 3), 0.6 * (i / 3), 0.3 * (i % 2));
+    sphere->SetRadius(0.5);
+    sphere->SetThetaResolution(8 + 4 * i);
+    sphere->SetPhiResolution(8 + 4 * i);
+    sphere->Update();
+    blocks->SetBlock(i, sphere->GetOutput());
+  }
+
+  vtkNew<vtkUnsignedCharArray> expectedColors;
+  vtkNew<vtkFloatArray> expectedDepths;
+  Render(blocks, 1, false, expectedColors, expectedDepths);
+  if (expectedColors->GetNumberOfTuples() != 200 * 150)
+  {
+    std::cerr << "Unexpected size of the single device image." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkUnsignedCharArray> colors;
+  vtkNew<vtkFloatArray> depths;
+  Render(blocks, 3, false, colors, depths);
+  if (!Compare(expectedColors, expectedDepths, colors, depths, "serial"))
+  {
+    return EXIT_FAILURE;
+  }
+  Render(blocks, 3, true, colors, depths);
+  if (!Compare(expectedColors, expectedDepths, colors, depths, "parallel"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
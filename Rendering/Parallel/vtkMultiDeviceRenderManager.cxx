@@ -0,0 +1,311 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkMultiDeviceRenderManager.h"
+
+#include "vtkActor.h"
+#include "vtkBoundingBox.h"
+#include "vtkCamera.h"
+#include "vtkCommand.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkCompressCompositer.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetMapper.h"
+#include "vtkFloatArray.h"
+#include "vtkLight.h"
+#include "vtkLightCollection.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkMultiDeviceRenderManager);
+vtkCxxSetObjectMacro(vtkMultiDeviceRenderManager, Renderer, vtkRenderer);
+
+class vtkMultiDeviceRenderManager::vtkInternals
+{
+public:
+  struct Device
+  {
+    vtkSmartPointer<vtkRenderWindow> Window;
+    vtkSmartPointer<vtkRenderer> Renderer;
+    vtkIdType NumberOfCells = 0;
+
+    // The buffers read back from the device.
+    vtkNew<vtkUnsignedCharArray> Color;
+    vtkNew<vtkFloatArray> Depth;
+
+    // The compressed buffers of the device, then of the subtree of the
+    // devices it is composited with, and the buffers the next level of the
+    // tree is composited in.
+    vtkSmartPointer<vtkUnsignedCharArray> CompressedColor;
+    vtkSmartPointer<vtkFloatArray> CompressedDepth;
+    vtkSmartPointer<vtkUnsignedCharArray> CompositedColor;
+    vtkSmartPointer<vtkFloatArray> CompositedDepth;
+
+    Device()
+      : CompressedColor(vtkSmartPointer<vtkUnsignedCharArray>::New())
+      , CompressedDepth(vtkSmartPointer<vtkFloatArray>::New())
+      , CompositedColor(vtkSmartPointer<vtkUnsignedCharArray>::New())
+      , CompositedDepth(vtkSmartPointer<vtkFloatArray>::New())
+    {
+      this->Color->SetNumberOfComponents(4);
+      this->CompressedColor->SetNumberOfComponents(4);
+      this->CompositedColor->SetNumberOfComponents(4);
+    }
+  };
+
+  std::vector<Device> Devices;
+  vtkNew<vtkUnsignedCharArray> ColorBuffer;
+  vtkNew<vtkFloatArray> DepthBuffer;
+};
+
+//------------------------------------------------------------------------------
+vtkMultiDeviceRenderManager::vtkMultiDeviceRenderManager()
+  : Internals(new vtkInternals)
+{
+  this->Internals->ColorBuffer->SetNumberOfComponents(4);
+  this->SetNumberOfDevices(1);
+}
+
+//------------------------------------------------------------------------------
+vtkMultiDeviceRenderManager::~vtkMultiDeviceRenderManager()
+{
+  this->SetRenderer(nullptr);
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+void vtkMultiDeviceRenderManager::SetNumberOfDevices(int numberOfDevices)
+{
+  numberOfDevices = std::max(numberOfDevices, 1);
+  std::vector<vtkInternals::Device>& devices = this->Internals->Devices;
+  if (static_cast<int>(devices.size()) == numberOfDevices)
+  {
+    return;
+  }
+
+  const int previous = static_cast<int>(devices.size());
+  devices.resize(numberOfDevices);
+  for (int i = previous; i < numberOfDevices; ++i)
+  {
+    vtkInternals::Device& device = devices[i];
+    device.Window = vtkSmartPointer<vtkRenderWindow>::New();
+    device.Window->SetDeviceIndex(i);
+    device.Window->SetOffScreenRendering(1);
+    device.Window->SetMultiSamples(0);
+    device.Window->SwapBuffersOff();
+    device.Renderer = vtkSmartPointer<vtkRenderer>::New();
+    device.Window->AddRenderer(device.Renderer);
+  }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+int vtkMultiDeviceRenderManager::GetNumberOfDevices()
+{
+  return static_cast<int>(this->Internals->Devices.size());
+}
+
+//------------------------------------------------------------------------------
+vtkRenderWindow* vtkMultiDeviceRenderManager::GetDeviceRenderWindow(int device)
+{
+  if (device < 0 || device >= this->GetNumberOfDevices())
+  {
+    vtkErrorMacro("Invalid device " << device << ".");
+    return nullptr;
+  }
+  return this->Internals->Devices[device].Window;
+}
+
+//------------------------------------------------------------------------------
+vtkRenderer* vtkMultiDeviceRenderManager::GetDeviceRenderer(int device)
+{
+  if (device < 0 || device >= this->GetNumberOfDevices())
+  {
+    vtkErrorMacro("Invalid device " << device << ".");
+    return nullptr;
+  }
+  return this->Internals->Devices[device].Renderer;
+}
+
+//------------------------------------------------------------------------------
+void vtkMultiDeviceRenderManager::AddBlocks(vtkDataObject* input)
+{
+  std::vector<vtkDataSet*> blocks = vtkCompositeDataSet::GetDataSets<vtkDataSet>(input);
+  std::stable_sort(blocks.begin(), blocks.end(),
+    [](vtkDataSet* a, vtkDataSet* b) { return a->GetNumberOfCells() > b->GetNumberOfCells(); });
+
+  std::vector<vtkInternals::Device>& devices = this->Internals->Devices;
+  for (vtkDataSet* block : blocks)
+  {
+    auto device = std::min_element(devices.begin(), devices.end(),
+      [](const vtkInternals::Device& a, const vtkInternals::Device& b) {
+        return a.NumberOfCells < b.NumberOfCells;
+      });
+    vtkNew<vtkDataSetMapper> mapper;
+    mapper->SetInputData(block);
+    vtkNew<vtkActor> actor;
+    actor->SetMapper(mapper);
+    device->Renderer->AddActor(actor);
+    device->NumberOfCells += block->GetNumberOfCells();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkMultiDeviceRenderManager::SynchronizeDevices()
+{
+  vtkCamera* camera = this->Renderer->GetActiveCamera();
+  vtkLightCollection* lights = this->Renderer->GetLights();
+
+  // The depths of the devices are only comparable with the same clipping
+  // range, which is computed from the bounds of all of them.
+  vtkBoundingBox bbox;
+  for (vtkInternals::Device& device : this->Internals->Devices)
+  {
+    double bounds[6];
+    device.Renderer->ComputeVisiblePropBounds(bounds);
+    bbox.AddBounds(bounds);
+  }
+
+  for (vtkInternals::Device& device : this->Internals->Devices)
+  {
+    device.Window->SetSize(this->Size);
+    device.Renderer->SetBackground(this->Renderer->GetBackground());
+    device.Renderer->GradientBackgroundOff();
+    device.Renderer->GetActiveCamera()->DeepCopy(camera);
+    if (bbox.IsValid())
+    {
+      double bounds[6];
+      bbox.GetBounds(bounds);
+      device.Renderer->ResetCameraClippingRange(bounds);
+    }
+
+    // The lights are copied as the renderers move the ones following the
+    // camera.
+    if (lights->GetNumberOfItems() > 0)
+    {
+      device.Renderer->RemoveAllLights();
+      lights->InitTraversal();
+      while (vtkLight* light = lights->GetNextItem())
+      {
+        vtkNew<vtkLight> copy;
+        copy->DeepCopy(light);
+        device.Renderer->AddLight(copy);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkMultiDeviceRenderManager::RenderDevice(int index)
+{
+  vtkInternals::Device& device = this->Internals->Devices[index];
+  const vtkIdType numPixels = static_cast<vtkIdType>(this->Size[0]) * this->Size[1];
+
+  device.Window->Render();
+  device.Window->GetRGBACharPixelData(
+    0, 0, this->Size[0] - 1, this->Size[1] - 1, 0, device.Color);
+  device.Window->GetZbufferData(0, 0, this->Size[0] - 1, this->Size[1] - 1, device.Depth);
+  device.Window->ReleaseCurrent();
+
+  device.CompressedColor->SetNumberOfTuples(numPixels);
+  device.CompressedDepth->SetNumberOfTuples(numPixels);
+  vtkCompressCompositer::Compress(
+    device.Depth, device.Color, device.CompressedDepth, device.CompressedColor);
+}
+
+//------------------------------------------------------------------------------
+void vtkMultiDeviceRenderManager::Render()
+{
+  if (!this->Renderer)
+  {
+    vtkErrorMacro("A renderer must be set before calling Render.");
+    return;
+  }
+  if (this->Size[0] < 1 || this->Size[1] < 1)
+  {
+    vtkErrorMacro("Invalid size " << this->Size[0] << "x" << this->Size[1] << ".");
+    return;
+  }
+
+  this->InvokeEvent(vtkCommand::StartEvent);
+  this->SynchronizeDevices();
+
+  std::vector<vtkInternals::Device>& devices = this->Internals->Devices;
+  const int numDevices = static_cast<int>(devices.size());
+  if (this->RenderInParallel && numDevices > 1)
+  {
+    vtkSMPTools::For(0, numDevices, 1, [this](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        this->RenderDevice(static_cast<int>(i));
+      }
+    });
+  }
+  else
+  {
+    for (int i = 0; i < numDevices; ++i)
+    {
+      this->RenderDevice(i);
+    }
+  }
+
+  // Composite the devices in a binary tree, the first device of every pair
+  // receiving the composited buffers.
+  const vtkIdType numPixels = static_cast<vtkIdType>(this->Size[0]) * this->Size[1];
+  for (int step = 1; step < numDevices; step *= 2)
+  {
+    const int numPairs = (numDevices - step + 2 * step - 1) / (2 * step);
+    vtkSMPTools::For(0, numPairs, [&devices, step, numPixels](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType pair = begin; pair < end; ++pair)
+      {
+        vtkInternals::Device& local = devices[2 * step * pair];
+        vtkInternals::Device& remote = devices[2 * step * pair + step];
+        local.CompositedColor->SetNumberOfTuples(numPixels);
+        local.CompositedDepth->SetNumberOfTuples(numPixels);
+        vtkCompressCompositer::CompositeImagePair(local.CompressedDepth, local.CompressedColor,
+          remote.CompressedDepth, remote.CompressedColor, local.CompositedDepth,
+          local.CompositedColor);
+        std::swap(local.CompressedColor, local.CompositedColor);
+        std::swap(local.CompressedDepth, local.CompositedDepth);
+      }
+    });
+  }
+
+  this->Internals->ColorBuffer->SetNumberOfTuples(numPixels);
+  this->Internals->DepthBuffer->SetNumberOfTuples(numPixels);
+  vtkCompressCompositer::Uncompress(devices[0].CompressedDepth, devices[0].CompressedColor,
+    this->Internals->DepthBuffer, this->Internals->ColorBuffer, static_cast<int>(numPixels));
+  this->InvokeEvent(vtkCommand::EndEvent);
+}
+
+//------------------------------------------------------------------------------
+vtkUnsignedCharArray* vtkMultiDeviceRenderManager::GetColorBuffer()
+{
+  return this->Internals->ColorBuffer;
+}
+
+//------------------------------------------------------------------------------
+vtkFloatArray* vtkMultiDeviceRenderManager::GetDepthBuffer()
+{
+  return this->Internals->DepthBuffer;
+}
+
+//------------------------------------------------------------------------------
+void vtkMultiDeviceRenderManager::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Renderer: " << this->Renderer << endl;
+  os << indent << "NumberOfDevices: " << this->GetNumberOfDevices() << endl;
+  os << indent << "Size: " << this->Size[0] << " " << this->Size[1] << endl;
+  os << indent << "RenderInParallel: " << (this->RenderInParallel ? "On" : "Off") << endl;
+}
+VTK_ABI_NAMESPACE_END
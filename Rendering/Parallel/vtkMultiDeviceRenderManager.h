@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkMultiDeviceRenderManager
+ * @brief   sort-last rendering of a scene over the graphics cards of a process
+ *
+ * vtkMultiDeviceRenderManager renders a scene split over several graphics
+ * cards of a single process. It creates an offscreen render window and a
+ * renderer per device, the device index of the window being the index of the
+ * device, which vtkEGLRenderWindow uses to select the graphics card. Every
+ * frame:
+ *
+ * - the camera, the background and the lights of Renderer are copied to the
+ *   renderers of the devices, with a clipping range common to all of them so
+ *   that their depths can be compared;
+ * - the devices render their part of the scene, each one in its own thread
+ *   when RenderInParallel is on;
+ * - their color and depth buffers are composited in a binary tree with the
+ *   run-length encoded depth compositing of vtkCompressCompositer, the pairs
+ *   of a level of the tree being composited in parallel.
+ *
+ * The composited image is then available with GetColorBuffer() and
+ * GetDepthBuffer(). For example, to split the blocks of a multiblock dataset
+ * over the graphics cards of a node:
+ * @code
+ * vtkNew<vtkMultiDeviceRenderManager> manager;
+ * manager->SetNumberOfDevices(window->GetNumberOfDevices());
+ * manager->SetRenderer(renderer);
+ * manager->AddBlocks(multiblock);
+ * manager->Render();
+ * @endcode
+ *
+ * The props of the devices are rendered concurrently, they must not share
+ * mappers nor pipelines that are not up to date. Only opaque geometry is
+ * composited correctly.
+ *
+ * @sa
+ * vtkCompressCompositer vtkCompositeRenderManager vtkEGLRenderWindow
+ */
+
+#ifndef vtkMultiDeviceRenderManager_h
+#define vtkMultiDeviceRenderManager_h
+
+#include "vtkObject.h"
+#include "vtkRenderingParallelModule.h" // For export macro
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataObject;
+class vtkFloatArray;
+class vtkRenderWindow;
+class vtkRenderer;
+class vtkUnsignedCharArray;
+
+class VTKRENDERINGPARALLEL_EXPORT vtkMultiDeviceRenderManager : public vtkObject
+{
+public:
+  static vtkMultiDeviceRenderManager* New();
+  vtkTypeMacro(vtkMultiDeviceRenderManager, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set/Get the renderer whose camera, background and lights are used by the
+   * renderers of all the devices. Its props are not rendered.
+   */
+  virtual void SetRenderer(vtkRenderer*);
+  vtkGetObjectMacro(Renderer, vtkRenderer);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of devices. Every device gets an offscreen render
+   * window whose device index is the index of the device, and a renderer.
+   * Default is 1.
+   */
+  void SetNumberOfDevices(int numberOfDevices);
+  int GetNumberOfDevices();
+  ///@}
+
+  ///@{
+  /**
+   * Get the render window and the renderer of a device. The props of the
+   * part of the scene rendered by the device are added to its renderer.
+   */
+  vtkRenderWindow* GetDeviceRenderWindow(int device);
+  vtkRenderer* GetDeviceRenderer(int device);
+  ///@}
+
+  /**
+   * Add an actor with a vtkDataSetMapper for every leaf dataset of the input
+   * to the renderer of a device. The leaves are given, from the largest to
+   * the smallest, to the device with the fewest cells so far.
+   */
+  void AddBlocks(vtkDataObject* input);
+
+  ///@{
+  /**
+   * Set/Get the size of the images rendered by the devices. Default is
+   * 300x300.
+   */
+  vtkSetVector2Macro(Size, int);
+  vtkGetVector2Macro(Size, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get whether the devices render in parallel, each one in a thread of
+   * vtkSMPTools, or one after the other in the calling thread. Default is on.
+   */
+  vtkSetMacro(RenderInParallel, bool);
+  vtkGetMacro(RenderInParallel, bool);
+  vtkBooleanMacro(RenderInParallel, bool);
+  ///@}
+
+  /**
+   * Render the devices and composite their images.
+   */
+  void Render();
+
+  ///@{
+  /**
+   * Get the RGBA colors and the depths of the composited image, of Size
+   * pixels ordered from the bottom left corner, after Render().
+   */
+  vtkUnsignedCharArray* GetColorBuffer();
+  vtkFloatArray* GetDepthBuffer();
+  ///@}
+
+protected:
+  vtkMultiDeviceRenderManager();
+  ~vtkMultiDeviceRenderManager() override;
+
+  /**
+   * Copy the camera, background and lights of Renderer to the renderers of
+   * the devices.
+   */
+  void SynchronizeDevices();
+
+  /**
+   * Render a device and read back its compressed color and depth buffers.
+   */
+  void RenderDevice(int device);
+
+  vtkRenderer* Renderer = nullptr;
+  int Size[2] = { 300, 300 };
+  bool RenderInParallel = true;
+
+private:
+  vtkMultiDeviceRenderManager(const vtkMultiDeviceRenderManager&) = delete;
+  void operator=(const vtkMultiDeviceRenderManager&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
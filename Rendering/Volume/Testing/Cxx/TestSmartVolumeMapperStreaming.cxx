@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// This test renders a volume larger than the memory budget of a
+// vtkSmartVolumeMapper in the streaming low resolution mode. The interactive
+// renders use the resampled volume, and the still renders must match the
+// rendering of the full resolution volume.
+
+#include <vtkColorTransferFunction.h>
+#include <vtkGPUVolumeRayCastMapper.h>
+#include <vtkNew.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkSmartVolumeMapper.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkVolume.h>
+#include <vtkVolumeProperty.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Size = 300;
+
+//------------------------------------------------------------------------------
+void Render(vtkVolumeMapper* mapper, double desiredUpdateRate, vtkUnsignedCharArray* pixels)
+{
+  vtkNew<vtkColorTransferFunction> color;
+  color->AddRGBPoint(40.0, 0.2, 0.2, 1.0);
+  color->AddRGBPoint(280.0, 1.0, 0.8, 0.2);
+  vtkNew<vtkPiecewiseFunction> opacity;
+  opacity->AddPoint(40.0, 0.0);
+  opacity->AddPoint(280.0, 0.3);
+  vtkNew<vtkVolumeProperty> property;
+  property->SetColor(color);
+  property->SetScalarOpacity(opacity);
+  property->SetInterpolationTypeToLinear();
+
+  vtkNew<vtkVolume> volume;
+  volume->SetMapper(mapper);
+  volume->SetProperty(property);
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddVolume(volume);
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(Size, Size);
+  renWin->SetMultiSamples(0);
+  renWin->AddRenderer(renderer);
+  renWin->SetDesiredUpdateRate(desiredUpdateRate);
+  renderer->ResetCamera();
+  renWin->Render();
+  renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, pixels);
+}
+}
+
+//------------------------------------------------------------------------------
+int TestSmartVolumeMapperStreaming(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-31, 32, -31, 32, -31, 32);
+
+  vtkNew<vtkGPUVolumeRayCastMapper> reference;
+  reference->SetInputConnection(wavelet->GetOutputPort());
+  reference->SetAutoAdjustSampleDistances(0);
+  reference->SetSampleDistance(0.5);
+  vtkNew<vtkUnsignedCharArray> expected;
+  Render(reference, 0.0001, expected);
+
+  // The 64^3 floats do not fit in the memory budget.
+  vtkNew<vtkSmartVolumeMapper> mapper;
+  mapper->SetInputConnection(wavelet->GetOutputPort());
+  mapper->SetRequestedRenderModeToGPU();
+  mapper->SetLowResMode(vtkSmartVolumeMapper::LowResModeStreaming);
+  mapper->SetMaxMemoryInBytes(300000);
+  mapper->SetMaxMemoryFraction(1.0);
+  mapper->SetInteractiveAdjustSampleDistances(0);
+  mapper->SetAutoAdjustSampleDistances(0);
+  mapper->SetSampleDistance(0.5);
+
+  vtkNew<vtkUnsignedCharArray> pixels;
+  Render(mapper, 30.0, pixels);
+  if (mapper->GetLastUsedRenderMode() != vtkSmartVolumeMapper::GPURenderMode)
+  {
+    std::cerr << "The interactive render does not use the GPU." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  Render(mapper, 0.0001, pixels);
+  if (pixels->GetNumberOfValues() != expected->GetNumberOfValues())
+  {
+    std::cerr << "Unexpected number of pixels." << std::endl;
+    return EXIT_FAILURE;
+  }
+  // The partitions may only differ along their boundaries.
+  double error = 0.0;
+  for (vtkIdType i = 0; i < pixels->GetNumberOfValues(); ++i)
+  {
+    error += std::abs(static_cast<int>(pixels->GetValue(i)) - expected->GetValue(i));
+  }
+  error /= pixels->GetNumberOfValues();
+  if (error > 2.0)
+  {
+    std::cerr << "The still render differs from the full resolution volume by " << error
+              << " on average." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
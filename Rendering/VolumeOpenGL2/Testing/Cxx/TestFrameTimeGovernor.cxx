@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * Render a volume and a point cloud with a vtkOpenGLFrameTimeGovernor whose
+ * target frame time cannot be held, check that the quality drops to the
+ * minimum one while interacting and that the settings are restored by the
+ * first still render, measuring the frames with the render timer and with the
+ * wall clock time used when the render timer is not supported.
+ */
+
+#include <vtkActor.h>
+#include <vtkColorTransferFunction.h>
+#include <vtkNew.h>
+#include <vtkOpenGLFrameTimeGovernor.h>
+#include <vtkOpenGLGPUVolumeRayCastMapper.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkPointGaussianMapper.h>
+#include <vtkPointSource.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
+#include <vtkVolume.h>
+#include <vtkVolumeProperty.h>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+bool TestGovernor(bool useRenderTimer, vtkRenderWindow* renWin, vtkRenderer* renderer,
+  vtkGPUVolumeRayCastMapper* volumeMapper, vtkPointGaussianMapper* pointMapper)
+{
+  vtkRenderWindowInteractor* iren = renWin->GetInteractor();
+  vtkNew<vtkOpenGLFrameTimeGovernor> governor;
+  governor->SetTargetFrameTime(1e-9);
+  governor->SetMinimumQuality(0.25);
+  governor->SetUseRenderTimer(useRenderTimer);
+  governor->SetRenderWindow(renWin);
+
+  // Interact until the quality reaches its minimum.
+  renWin->SetDesiredUpdateRate(iren->GetDesiredUpdateRate());
+  for (int i = 0; i < 100 && governor->GetQuality() > governor->GetMinimumQuality(); ++i)
+  {
+    renWin->Render();
+  }
+  if (!governor->GetInteractive() || governor->GetQuality() > governor->GetMinimumQuality())
+  {
+    std::cerr << "The quality does not drop while interacting with UseRenderTimer "
+              << useRenderTimer << ": " << governor->GetQuality() << std::endl;
+    return false;
+  }
+  if (volumeMapper->GetImageSampleDistance() != 2.0f || renderer->GetUseFXAA() ||
+    pointMapper->GetPointBudget() != 2500)
+  {
+    std::cerr << "Unexpected settings at the minimum quality." << std::endl;
+    return false;
+  }
+
+  // The first still render restores the settings.
+  renWin->SetDesiredUpdateRate(iren->GetStillUpdateRate());
+  renWin->Render();
+  if (governor->GetInteractive() || governor->GetQuality() != 1.0 ||
+    volumeMapper->GetImageSampleDistance() != 1.0f || !renderer->GetUseFXAA() ||
+    pointMapper->GetPointBudget() != 0)
+  {
+    std::cerr << "The settings are not restored by the still render." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestFrameTimeGovernor(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> rtSource;
+  rtSource->SetWholeExtent(-10, 10, -10, 10, -10, 10);
+  vtkNew<vtkOpenGLGPUVolumeRayCastMapper> volumeMapper;
+  volumeMapper->SetInputConnection(rtSource->GetOutputPort());
+  volumeMapper->AutoAdjustSampleDistancesOff();
+  volumeMapper->SetImageSampleDistance(1.0);
+  vtkNew<vtkColorTransferFunction> color;
+  color->AddRGBPoint(40.0, 0.2, 0.2, 1.0);
+  color->AddRGBPoint(280.0, 1.0, 0.8, 0.2);
+  vtkNew<vtkPiecewiseFunction> opacity;
+  opacity->AddPoint(40.0, 0.0);
+  opacity->AddPoint(280.0, 0.5);
+  vtkNew<vtkVolume> volume;
+  volume->SetMapper(volumeMapper);
+  volume->GetProperty()->SetColor(color);
+  volume->GetProperty()->SetScalarOpacity(opacity);
+
+  vtkNew<vtkPointSource> points;
+  points->SetNumberOfPoints(10000);
+  points->SetRadius(15.0);
+  vtkNew<vtkPointGaussianMapper> pointMapper;
+  pointMapper->SetInputConnection(points->GetOutputPort());
+  pointMapper->SetScaleFactor(0.2);
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(pointMapper);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddVolume(volume);
+  renderer->AddActor(actor);
+  renderer->UseFXAAOn();
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(300, 300);
+  renWin->AddRenderer(renderer);
+  vtkNew<vtkRenderWindowInteractor> iren;
+  iren->SetRenderWindow(renWin);
+  renderer->ResetCamera();
+
+  // The wall clock time is used when the render timer is not supported, which
+  // is forced by turning it off.
+  if (!::TestGovernor(true, renWin, renderer, volumeMapper, pointMapper) ||
+    !::TestGovernor(false, renWin, renderer, volumeMapper, pointMapper))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * Toggle the shading of a volume with the asynchronous shader compilation of
+ * vtkOpenGLGPUVolumeRayCastMapper, render until the new shader program is
+ * ready, and check that the image is the one rendered with the synchronous
+ * compilation.
+ */
+
+#include <vtkColorTransferFunction.h>
+#include <vtkNew.h>
+#include <vtkOpenGLGPUVolumeRayCastMapper.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkShaderProgram.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkVolume.h>
+#include <vtkVolumeProperty.h>
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Size = 300;
+
+//------------------------------------------------------------------------------
+bool Render(bool asynchronous, vtkUnsignedCharArray* pixels)
+{
+  vtkNew<vtkRTAnalyticSource> rtSource;
+  rtSource->SetWholeExtent(-10, 10, -10, 10, -10, 10);
+
+  vtkNew<vtkOpenGLGPUVolumeRayCastMapper> mapper;
+  mapper->SetInputConnection(rtSource->GetOutputPort());
+  mapper->SetAsynchronousShaderCompilation(asynchronous);
+
+  vtkNew<vtkColorTransferFunction> color;
+  color->AddRGBPoint(40.0, 0.2, 0.2, 1.0);
+  color->AddRGBPoint(280.0, 1.0, 0.8, 0.2);
+  vtkNew<vtkPiecewiseFunction> opacity;
+  opacity->AddPoint(40.0, 0.0);
+  opacity->AddPoint(280.0, 0.5);
+  vtkNew<vtkVolumeProperty> property;
+  property->SetColor(color);
+  property->SetScalarOpacity(opacity);
+  property->SetInterpolationTypeToLinear();
+  property->ShadeOff();
+
+  vtkNew<vtkVolume> volume;
+  volume->SetMapper(mapper);
+  volume->SetProperty(property);
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddVolume(volume);
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(Size, Size);
+  renWin->AddRenderer(renderer);
+  renderer->ResetCamera();
+
+  // The first program is always compiled before rendering.
+  renWin->Render();
+  if (mapper->GetShaderCompilationPending())
+  {
+    std::cerr << "The first shader program is compiled in the background." << std::endl;
+    return false;
+  }
+
+  // Render until the shaded program is ready.
+  property->ShadeOn();
+  renWin->Render();
+  for (int i = 0; i < 1000 && mapper->GetShaderCompilationPending(); ++i)
+  {
+    vtksys::SystemTools::Delay(10);
+    renWin->Render();
+  }
+  if (mapper->GetShaderCompilationPending())
+  {
+    std::cerr << "The shader program compiled in the background is never ready." << std::endl;
+    return false;
+  }
+
+  renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, pixels);
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestGPURayCastAsynchronousShaderCompilation(int, char*[])
+{
+  vtkNew<vtkUnsignedCharArray> expected;
+  vtkNew<vtkUnsignedCharArray> pixels;
+  if (!Render(false, expected) || !Render(true, pixels))
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (expected->GetNumberOfValues() != pixels->GetNumberOfValues())
+  {
+    std::cerr << "Unexpected number of pixels." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    if (expected->GetValue(i) != pixels->GetValue(i))
+    {
+      std::cerr << "The shader program compiled in the background renders differently."
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!vtkShaderProgram::IsParallelShaderCompileSupported())
+  {
+    std::cout << "Parallel shader compilation is not supported, the programs were compiled "
+                 "before rendering."
+              << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
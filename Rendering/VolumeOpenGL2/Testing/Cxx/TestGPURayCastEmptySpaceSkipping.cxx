@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * Render a volume whose opacity is zero over most of its voxels with the
+ * empty space skipping of vtkOpenGLGPUVolumeRayCastMapper, and check that the
+ * image is the one rendered without it.
+ */
+
+#include <vtkCamera.h>
+#include <vtkColorTransferFunction.h>
+#include <vtkNew.h>
+#include <vtkOpenGLGPUVolumeRayCastMapper.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkTextureObject.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkVolume.h>
+#include <vtkVolumeInputHelper.h>
+#include <vtkVolumeProperty.h>
+#include <vtkVolumeTexture.h>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Size = 300;
+
+//------------------------------------------------------------------------------
+bool Render(bool emptySpaceSkipping, vtkUnsignedCharArray* pixels)
+{
+  vtkNew<vtkRTAnalyticSource> rtSource;
+  rtSource->SetWholeExtent(-30, 30, -30, 30, -30, 30);
+
+  vtkNew<vtkOpenGLGPUVolumeRayCastMapper> mapper;
+  mapper->SetInputConnection(rtSource->GetOutputPort());
+  mapper->SetEmptySpaceSkipping(emptySpaceSkipping);
+  mapper->SetEmptySpaceSkippingBrickSize(8);
+  mapper->AutoAdjustSampleDistancesOff();
+  mapper->SetSampleDistance(0.5);
+
+  // Only the center of the wavelet is opaque.
+  vtkNew<vtkColorTransferFunction> color;
+  color->AddRGBPoint(200.0, 0.2, 0.2, 1.0);
+  color->AddRGBPoint(280.0, 1.0, 0.8, 0.2);
+  vtkNew<vtkPiecewiseFunction> opacity;
+  opacity->AddPoint(200.0, 0.0);
+  opacity->AddPoint(280.0, 0.5);
+  vtkNew<vtkVolumeProperty> property;
+  property->SetColor(color);
+  property->SetScalarOpacity(opacity);
+  property->SetInterpolationTypeToLinear();
+
+  vtkNew<vtkVolume> volume;
+  volume->SetMapper(mapper);
+  volume->SetProperty(property);
+  vtkNew<vtkRenderer> renderer;
+  renderer->AddVolume(volume);
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(Size, Size);
+  renWin->AddRenderer(renderer);
+  renderer->ResetCamera();
+  renderer->GetActiveCamera()->Azimuth(30.0);
+  renderer->GetActiveCamera()->Elevation(20.0);
+  renWin->Render();
+
+  const bool hasOccupancy = mapper->AssembledInputs[0].Texture->OccupancyTex != nullptr;
+  if (hasOccupancy != emptySpaceSkipping)
+  {
+    std::cerr << "Unexpected occupancy texture with EmptySpaceSkipping " << emptySpaceSkipping
+              << "." << std::endl;
+    return false;
+  }
+
+  renWin->GetPixelData(0, 0, Size - 1, Size - 1, 1, pixels);
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestGPURayCastEmptySpaceSkipping(int, char*[])
+{
+  vtkNew<vtkUnsignedCharArray> expected;
+  vtkNew<vtkUnsignedCharArray> pixels;
+  if (!Render(false, expected) || !Render(true, pixels))
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (expected->GetNumberOfValues() != pixels->GetNumberOfValues())
+  {
+    std::cerr << "Unexpected number of pixels." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    if (expected->GetValue(i) != pixels->GetValue(i))
+    {
+      std::cerr << "The empty space skipping renders differently." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * Render a green volume and a red translucent sphere with weighted blended
+ * translucency, the sphere being in front of the volume and then behind it,
+ * and check that the nearest of them dominates the color in the middle of the
+ * image. The volume must be blended like the translucent fragments, a volume
+ * blended over them would hide the sphere in front of it.
+ */
+
+#include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkColorTransferFunction.h>
+#include <vtkGPUVolumeRayCastMapper.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkPointData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkSphereSource.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkVolume.h>
+#include <vtkVolumeProperty.h>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Size = 200;
+
+//------------------------------------------------------------------------------
+void RenderCenter(double sphereZ, unsigned char color[3])
+{
+  // A unit cube of constant scalars between z = -1.5 and z = -0.5.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(11, 11, 11);
+  image->SetSpacing(0.1, 0.1, 0.1);
+  image->SetOrigin(-0.5, -0.5, -1.5);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  vtkUnsignedCharArray* scalars =
+    vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetScalars());
+  scalars->FillValue(255);
+
+  vtkNew<vtkGPUVolumeRayCastMapper> volumeMapper;
+  volumeMapper->SetInputData(image);
+  volumeMapper->AutoAdjustSampleDistancesOff();
+  volumeMapper->SetSampleDistance(0.01);
+  vtkNew<vtkColorTransferFunction> volumeColor;
+  volumeColor->AddRGBPoint(0.0, 0.0, 1.0, 0.0);
+  volumeColor->AddRGBPoint(255.0, 0.0, 1.0, 0.0);
+  vtkNew<vtkPiecewiseFunction> volumeOpacity;
+  volumeOpacity->AddPoint(0.0, 0.5);
+  volumeOpacity->AddPoint(255.0, 0.5);
+  vtkNew<vtkVolume> volume;
+  volume->SetMapper(volumeMapper);
+  volume->GetProperty()->SetColor(volumeColor);
+  volume->GetProperty()->SetScalarOpacity(volumeOpacity);
+  volume->GetProperty()->SetScalarOpacityUnitDistance(0.5);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(0.0, 0.0, sphereZ);
+  sphere->SetRadius(0.5);
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  vtkNew<vtkPolyDataMapper> sphereMapper;
+  sphereMapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(sphereMapper);
+  actor->GetProperty()->SetColor(1.0, 0.0, 0.0);
+  actor->GetProperty()->SetOpacity(0.5);
+  actor->GetProperty()->SetAmbient(1.0);
+  actor->GetProperty()->SetDiffuse(0.0);
+
+  vtkNew<vtkRenderer> renderer;
+  renderer->SetBackground(0.0, 0.0, 0.0);
+  renderer->SetUseWeightedBlendedTranslucency(true);
+  renderer->AddVolume(volume);
+  renderer->AddActor(actor);
+  renderer->GetActiveCamera()->SetPosition(0.0, 0.0, 4.0);
+  renderer->GetActiveCamera()->SetFocalPoint(0.0, 0.0, 0.0);
+  renderer->ResetCameraClippingRange();
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(Size, Size);
+  renWin->SetMultiSamples(0);
+  renWin->AddRenderer(renderer);
+  renWin->Render();
+
+  vtkNew<vtkUnsignedCharArray> pixels;
+  renWin->GetPixelData(Size / 2, Size / 2, Size / 2, Size / 2, 1, pixels);
+  for (int i = 0; i < 3; ++i)
+  {
+    color[i] = pixels->GetValue(i);
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+int TestGPURayCastWeightedBlendedTranslucency(int, char*[])
+{
+  unsigned char front[3];
+  unsigned char back[3];
+  RenderCenter(1.0, front);
+  RenderCenter(-3.0, back);
+
+  if (front[0] < front[1] + 32)
+  {
+    std::cerr << "The sphere in front of the volume does not dominate: "
+              << static_cast<int>(front[0]) << " " << static_cast<int>(front[1]) << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (back[1] < back[0] + 32)
+  {
+    std::cerr << "The volume in front of the sphere does not dominate: "
+              << static_cast<int>(back[0]) << " " << static_cast<int>(back[1]) << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
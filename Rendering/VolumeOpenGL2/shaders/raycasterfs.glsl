@@ -109,6 +109,8 @@ void safe_0_vector(inout Ray ray)
 
 //VTK::BinaryMask::Dec
 
+//VTK::EmptySpaceSkipping::Dec
+
 //VTK::CompositeMask::Dec
 
 //VTK::GradientCache::Dec
@@ -284,6 +286,8 @@ vec4 castRay(const float zStart, const float zEnd)
   {
     //VTK::Base::Impl
 
+    //VTK::EmptySpaceSkipping::Impl
+
     //VTK::Cropping::Impl
 
     //VTK::BinaryMask::Impl
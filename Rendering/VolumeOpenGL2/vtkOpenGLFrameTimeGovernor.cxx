@@ -0,0 +1,337 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkOpenGLFrameTimeGovernor.h"
+
+#include "vtkActor.h"
+#include "vtkCommand.h"
+#include "vtkGPUVolumeRayCastMapper.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointGaussianMapper.h"
+#include "vtkProp.h"
+#include "vtkPropCollection.h"
+#include "vtkRenderTimerLog.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderWindowInteractor.h"
+#include "vtkRenderer.h"
+#include "vtkRendererCollection.h"
+#include "vtkTimerLog.h"
+#include "vtkVolume.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkOpenGLFrameTimeGovernor);
+
+namespace
+{
+// The qualities under which the screen space passes of the renderers are
+// turned off.
+const double SSAOQuality = 0.75;
+const double FXAAQuality = 0.5;
+}
+
+// The original settings of the renderers and mappers changed by the governor.
+class vtkOpenGLFrameTimeGovernor::vtkInternals
+{
+public:
+  struct RendererSettings
+  {
+    vtkWeakPointer<vtkRenderer> Renderer;
+    bool UseSSAO;
+    bool UseFXAA;
+    int MaximumNumberOfPeels;
+  };
+  struct VolumeMapperSettings
+  {
+    vtkWeakPointer<vtkGPUVolumeRayCastMapper> Mapper;
+    float ImageSampleDistance;
+  };
+  struct PointMapperSettings
+  {
+    vtkWeakPointer<vtkPointGaussianMapper> Mapper;
+    vtkIdType PointBudget;
+  };
+
+  std::map<vtkRenderer*, RendererSettings> Renderers;
+  std::map<vtkGPUVolumeRayCastMapper*, VolumeMapperSettings> VolumeMappers;
+  std::map<vtkPointGaussianMapper*, PointMapperSettings> PointMappers;
+};
+
+//------------------------------------------------------------------------------
+vtkOpenGLFrameTimeGovernor::vtkOpenGLFrameTimeGovernor()
+  : Timer(vtkTimerLog::New())
+  , Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkOpenGLFrameTimeGovernor::~vtkOpenGLFrameTimeGovernor()
+{
+  this->SetRenderWindow(nullptr);
+  this->Timer->Delete();
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLFrameTimeGovernor::SetRenderWindow(vtkRenderWindow* window)
+{
+  if (this->RenderWindow == window)
+  {
+    return;
+  }
+
+  if (this->RenderWindow)
+  {
+    this->RestoreQuality();
+    this->RenderWindow->RemoveObserver(this->StartObserverId);
+    this->RenderWindow->RemoveObserver(this->EndObserverId);
+  }
+  this->RenderWindow = window;
+  this->Quality = 1.0;
+  this->InteractiveQuality = 1.0;
+  this->Interactive = false;
+  this->WallClockTimeReady = false;
+  if (window)
+  {
+    window->GetRenderTimer()->LoggingEnabledOn();
+    this->StartObserverId = window->AddObserver(
+      vtkCommand::StartEvent, this, &vtkOpenGLFrameTimeGovernor::RenderWindowStart);
+    this->EndObserverId = window->AddObserver(
+      vtkCommand::EndEvent, this, &vtkOpenGLFrameTimeGovernor::RenderWindowEnd);
+  }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkRenderWindow* vtkOpenGLFrameTimeGovernor::GetRenderWindow()
+{
+  return this->RenderWindow;
+}
+
+//------------------------------------------------------------------------------
+bool vtkOpenGLFrameTimeGovernor::IsInteractive()
+{
+  vtkRenderWindowInteractor* interactor = this->RenderWindow->GetInteractor();
+  return interactor &&
+    this->RenderWindow->GetDesiredUpdateRate() > interactor->GetStillUpdateRate();
+}
+
+//------------------------------------------------------------------------------
+bool vtkOpenGLFrameTimeGovernor::IsRenderTimerUsed()
+{
+  return this->UseRenderTimer && this->RenderWindow->GetRenderTimer()->IsSupported();
+}
+
+//------------------------------------------------------------------------------
+bool vtkOpenGLFrameTimeGovernor::UpdateFrameTime()
+{
+  if (!this->IsRenderTimerUsed())
+  {
+    // The wall clock time is measured by RenderWindowEnd.
+    const bool ready = this->WallClockTimeReady;
+    this->WallClockTimeReady = false;
+    return ready;
+  }
+
+  vtkRenderTimerLog* timer = this->RenderWindow->GetRenderTimer();
+  // Only the most recent frame matters, the results arrive a few frames
+  // after the renders.
+  bool ready = false;
+  while (timer->FrameReady())
+  {
+    vtkRenderTimerLog::Frame frame = timer->PopFirstReadyFrame();
+    double time = 0.0;
+    for (const vtkRenderTimerLog::Event& event : frame.Events)
+    {
+      time += event.ElapsedTimeSeconds();
+    }
+    this->LastFrameTime = time;
+    ready = true;
+  }
+  return ready;
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLFrameTimeGovernor::RenderWindowStart(vtkObject*, unsigned long, void*)
+{
+  const bool measured = this->UpdateFrameTime();
+  this->Interactive = this->IsInteractive();
+  if (!this->Interactive)
+  {
+    if (this->Quality < 1.0)
+    {
+      this->Quality = 1.0;
+      this->RestoreQuality();
+    }
+    return;
+  }
+
+  double target = this->TargetFrameTime;
+  if (target <= 0.0)
+  {
+    target = 1.0 / this->RenderWindow->GetDesiredUpdateRate();
+  }
+
+  // The frame time is about proportional to the quality. The square root
+  // damps the correction, as the measured frames were rendered a few frames
+  // ago with another quality.
+  if (measured && this->LastFrameTime > 0.0)
+  {
+    const double ratio = std::sqrt(target / this->LastFrameTime);
+    this->InteractiveQuality = vtkMath::ClampValue(
+      this->InteractiveQuality * std::min(std::max(ratio, 0.5), 2.0), this->MinimumQuality, 1.0);
+  }
+
+  this->Quality = this->InteractiveQuality;
+  this->InvokeEvent(vtkCommand::UpdateEvent, &this->Quality);
+  if (this->Quality < 1.0)
+  {
+    this->ApplyQuality();
+  }
+  else
+  {
+    this->RestoreQuality();
+  }
+  this->Timer->StartTimer();
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLFrameTimeGovernor::RenderWindowEnd(vtkObject*, unsigned long, void*)
+{
+  if (this->Interactive && !this->IsRenderTimerUsed())
+  {
+    this->Timer->StopTimer();
+    this->LastFrameTime = this->Timer->GetElapsedTime();
+    this->WallClockTimeReady = true;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLFrameTimeGovernor::ApplyQuality()
+{
+  const double quality = this->Quality;
+  vtkRendererCollection* renderers = this->RenderWindow->GetRenderers();
+  vtkCollectionSimpleIterator rit;
+  renderers->InitTraversal(rit);
+  while (vtkRenderer* renderer = renderers->GetNextRenderer(rit))
+  {
+    // The settings are saved the first time, or again when another object
+    // was allocated at the address of a deleted one.
+    vtkInternals::RendererSettings& settings = this->Internals->Renderers[renderer];
+    if (!settings.Renderer)
+    {
+      settings.Renderer = renderer;
+      settings.UseSSAO = renderer->GetUseSSAO();
+      settings.UseFXAA = renderer->GetUseFXAA();
+      settings.MaximumNumberOfPeels = renderer->GetMaximumNumberOfPeels();
+    }
+    renderer->SetUseSSAO(settings.UseSSAO && quality >= SSAOQuality);
+    renderer->SetUseFXAA(settings.UseFXAA && quality >= FXAAQuality);
+    if (renderer->GetUseDepthPeeling() && settings.MaximumNumberOfPeels > 0)
+    {
+      renderer->SetMaximumNumberOfPeels(
+        std::max(1, static_cast<int>(std::lround(settings.MaximumNumberOfPeels * quality))));
+    }
+
+    vtkPropCollection* props = renderer->GetViewProps();
+    vtkCollectionSimpleIterator pit;
+    props->InitTraversal(pit);
+    while (vtkProp* prop = props->GetNextProp(pit))
+    {
+      if (vtkVolume* volume = vtkVolume::SafeDownCast(prop))
+      {
+        vtkGPUVolumeRayCastMapper* mapper =
+          vtkGPUVolumeRayCastMapper::SafeDownCast(volume->GetMapper());
+        if (!mapper || mapper->GetAutoAdjustSampleDistances())
+        {
+          continue;
+        }
+        vtkInternals::VolumeMapperSettings& mapperSettings = this->Internals->VolumeMappers[mapper];
+        if (!mapperSettings.Mapper)
+        {
+          mapperSettings.Mapper = mapper;
+          mapperSettings.ImageSampleDistance = mapper->GetImageSampleDistance();
+        }
+
+        // The number of rays is proportional to the quality.
+        const float distance = mapperSettings.ImageSampleDistance;
+        mapper->SetImageSampleDistance(
+          std::min(static_cast<float>(distance / std::sqrt(quality)),
+            std::max(distance, mapper->GetMaximumImageSampleDistance())));
+      }
+      else if (vtkActor* actor = vtkActor::SafeDownCast(prop))
+      {
+        vtkPointGaussianMapper* mapper = vtkPointGaussianMapper::SafeDownCast(actor->GetMapper());
+        vtkDataObject* input = mapper ? mapper->GetInputDataObject(0, 0) : nullptr;
+        if (!input)
+        {
+          continue;
+        }
+        vtkInternals::PointMapperSettings& mapperSettings = this->Internals->PointMappers[mapper];
+        if (!mapperSettings.Mapper)
+        {
+          mapperSettings.Mapper = mapper;
+          mapperSettings.PointBudget = mapper->GetPointBudget();
+        }
+
+        vtkIdType budget = mapperSettings.PointBudget;
+        if (budget == 0)
+        {
+          budget = input->GetNumberOfElements(vtkDataObject::POINT);
+        }
+        mapper->SetPointBudget(std::max<vtkIdType>(1, static_cast<vtkIdType>(budget * quality)));
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLFrameTimeGovernor::RestoreQuality()
+{
+  for (auto& it : this->Internals->Renderers)
+  {
+    vtkInternals::RendererSettings& settings = it.second;
+    if (settings.Renderer)
+    {
+      settings.Renderer->SetUseSSAO(settings.UseSSAO);
+      settings.Renderer->SetUseFXAA(settings.UseFXAA);
+      settings.Renderer->SetMaximumNumberOfPeels(settings.MaximumNumberOfPeels);
+    }
+  }
+  for (auto& it : this->Internals->VolumeMappers)
+  {
+    vtkInternals::VolumeMapperSettings& settings = it.second;
+    if (settings.Mapper)
+    {
+      settings.Mapper->SetImageSampleDistance(settings.ImageSampleDistance);
+    }
+  }
+  for (auto& it : this->Internals->PointMappers)
+  {
+    vtkInternals::PointMapperSettings& settings = it.second;
+    if (settings.Mapper)
+    {
+      settings.Mapper->SetPointBudget(settings.PointBudget);
+    }
+  }
+  this->Internals->Renderers.clear();
+  this->Internals->VolumeMappers.clear();
+  this->Internals->PointMappers.clear();
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenGLFrameTimeGovernor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "RenderWindow: " << this->RenderWindow.GetPointer() << endl;
+  os << indent << "TargetFrameTime: " << this->TargetFrameTime << endl;
+  os << indent << "UseRenderTimer: " << (this->UseRenderTimer ? "On" : "Off") << endl;
+  os << indent << "MinimumQuality: " << this->MinimumQuality << endl;
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "LastFrameTime: " << this->LastFrameTime << endl;
+  os << indent << "Interactive: " << (this->Interactive ? "On" : "Off") << endl;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkOpenGLFrameTimeGovernor
+ * @brief   lower the rendering quality to hold a frame time while interacting
+ *
+ * vtkOpenGLFrameTimeGovernor observes the renders of a render window and
+ * measures the time the graphics card spends on every frame with the render
+ * timer of the window, a vtkOpenGLRenderTimerLog. While the window is
+ * interacted with, it keeps a quality factor between MinimumQuality and 1 so
+ * that the frames take TargetFrameTime, and derives from it before every
+ * render:
+ *
+ * - the ImageSampleDistance of the vtkGPUVolumeRayCastMapper of the volumes
+ *   that do not adjust it themselves, the number of rays being proportional
+ *   to the quality;
+ * - the PointBudget of the vtkPointGaussianMapper of the actors;
+ * - the MaximumNumberOfPeels of the renderers using depth peeling;
+ * - the SSAO of the renderers, turned off under a quality of 0.75, and their
+ *   FXAA, turned off under 0.5.
+ *
+ * Observers of the UpdateEvent of the governor, invoked with a pointer to the
+ * quality as call data, may adjust other settings such as the levels of detail
+ * of glyph mappers.
+ *
+ * The window is interacted with when the desired update rate set by its
+ * interactor is higher than the still update rate of the interactor. The
+ * first render at the still update rate restores the settings of the mappers
+ * and renderers. When the render timer is not supported or not used, the
+ * wall clock time spent in Render() is measured instead.
+ * @code
+ * vtkNew<vtkOpenGLFrameTimeGovernor> governor;
+ * governor->SetTargetFrameTime(1.0 / 30.0);
+ * governor->SetRenderWindow(renderWindow);
+ * @endcode
+ *
+ * @sa
+ * vtkRenderTimerLog vtkOpenGLRenderTimerLog vtkRenderWindowInteractor
+ */
+
+#ifndef vtkOpenGLFrameTimeGovernor_h
+#define vtkOpenGLFrameTimeGovernor_h
+
+#include "vtkObject.h"
+#include "vtkRenderingVolumeOpenGL2Module.h" // For export macro
+#include "vtkWeakPointer.h"                  // For ivar
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkRenderWindow;
+class vtkTimerLog;
+
+class VTKRENDERINGVOLUMEOPENGL2_EXPORT vtkOpenGLFrameTimeGovernor : public vtkObject
+{
+public:
+  static vtkOpenGLFrameTimeGovernor* New();
+  vtkTypeMacro(vtkOpenGLFrameTimeGovernor, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set/Get the render window whose renders are governed. The logging of its
+   * render timer is enabled. Setting another window restores the settings
+   * changed in the previous one.
+   */
+  void SetRenderWindow(vtkRenderWindow* window);
+  vtkRenderWindow* GetRenderWindow();
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the frame time to hold while interacting, in seconds. When 0, the
+   * inverse of the desired update rate of the window is used. Default is 0.
+   */
+  vtkSetClampMacro(TargetFrameTime, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(TargetFrameTime, double);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get whether the frame time is measured on the graphics card with the
+   * render timer of the window. When off, or when the render timer is not
+   * supported, the wall clock time of the renders is used. Default is on.
+   */
+  vtkSetMacro(UseRenderTimer, bool);
+  vtkGetMacro(UseRenderTimer, bool);
+  vtkBooleanMacro(UseRenderTimer, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the lowest quality used while interacting. Default is 0.1.
+   */
+  vtkSetClampMacro(MinimumQuality, double, 0.01, 1.0);
+  vtkGetMacro(MinimumQuality, double);
+  ///@}
+
+  /**
+   * Get the quality of the last render, 1 when the window was not interacted
+   * with.
+   */
+  vtkGetMacro(Quality, double);
+
+  /**
+   * Get the last measured frame time, in seconds.
+   */
+  vtkGetMacro(LastFrameTime, double);
+
+  /**
+   * Get whether the window was interacted with during the last render.
+   */
+  vtkGetMacro(Interactive, bool);
+
+protected:
+  vtkOpenGLFrameTimeGovernor();
+  ~vtkOpenGLFrameTimeGovernor() override;
+
+  /**
+   * Return true if the window is rendered at the interactive update rate of
+   * its interactor.
+   */
+  bool IsInteractive();
+
+  /**
+   * Return true if the frame time is measured with the render timer.
+   */
+  bool IsRenderTimerUsed();
+
+  /**
+   * Update the measured frame time from the ready frames of the render timer,
+   * or from the wall clock time of the last render when the render timer is
+   * not used. Return false if no frame time was measured since the last call.
+   */
+  bool UpdateFrameTime();
+
+  /**
+   * Change the settings of the mappers and the renderers of the window for
+   * the current quality, saving the original ones first.
+   */
+  void ApplyQuality();
+
+  /**
+   * Restore the original settings of the mappers and the renderers.
+   */
+  void RestoreQuality();
+
+  double TargetFrameTime = 0.0;
+  double MinimumQuality = 0.1;
+  double Quality = 1.0;
+  double InteractiveQuality = 1.0;
+  double LastFrameTime = 0.0;
+  bool UseRenderTimer = true;
+  bool Interactive = false;
+  bool WallClockTimeReady = false;
+
+private:
+  vtkOpenGLFrameTimeGovernor(const vtkOpenGLFrameTimeGovernor&) = delete;
+  void operator=(const vtkOpenGLFrameTimeGovernor&) = delete;
+
+  void RenderWindowStart(vtkObject*, unsigned long, void*);
+  void RenderWindowEnd(vtkObject*, unsigned long, void*);
+
+  vtkWeakPointer<vtkRenderWindow> RenderWindow;
+  unsigned long StartObserverId = 0;
+  unsigned long EndObserverId = 0;
+  vtkTimerLog* Timer;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
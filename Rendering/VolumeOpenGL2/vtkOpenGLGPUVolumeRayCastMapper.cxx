@@ -359,6 +359,13 @@ public:
     vtkCamera* cam, vtkVolume* vol, vtkMTimeType renderPassTime, vtkRenderer* ren);
   bool VolumePropertyChanged = true;
 
+  /**
+   * Return true if the bricks of the volume with a null opacity can be
+   * skipped, see vtkOpenGLGPUVolumeRayCastMapper::SetEmptySpaceSkipping().
+   */
+  bool UseEmptySpaceSkipping();
+  bool EmptySpaceSkippingInShader = false;
+
   ///@{
   /**
    * Image XY-Sampling
@@ -476,9 +483,14 @@ public:
   bool PreserveGLState;
   bool DepthMaskOverride;
 
-  vtkShaderProgram* ShaderProgram;
+  vtkShaderProgram* ShaderProgram = nullptr;
   vtkOpenGLShaderCache* ShaderCache;
 
+  // the program compiled in the background while the last one is used, and
+  // whether the program being built may be compiled in the background
+  vtkShaderProgram* PendingShaderProgram = nullptr;
+  bool BuildShaderAsynchronously = false;
+
   vtkOpenGLFramebufferObject* FBO;
   vtkTextureObject* RTTDepthBufferTextureObject;
   vtkTextureObject* RTTDepthTextureObject;
@@ -2184,6 +2196,9 @@ vtkOpenGLGPUVolumeRayCastMapper::vtkOpenGLGPUVolumeRayCastMapper()
   this->Impl = new vtkInternal(this);
   this->ReductionFactor = 1.0;
   this->CurrentPass = RenderPass;
+  this->AsynchronousShaderCompilation = false;
+  this->EmptySpaceSkipping = false;
+  this->EmptySpaceSkippingBrickSize = 16;
 
   this->ResourceCallback = new vtkOpenGLResourceFreeCallback<vtkOpenGLGPUVolumeRayCastMapper>(
     this, &vtkOpenGLGPUVolumeRayCastMapper::ReleaseGraphicsResources);
@@ -2212,6 +2227,16 @@ void vtkOpenGLGPUVolumeRayCastMapper::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "ReductionFactor: " << this->ReductionFactor << "\n";
   os << indent << "CurrentPass: " << this->CurrentPass << "\n";
+  os << indent << "AsynchronousShaderCompilation: " << this->AsynchronousShaderCompilation
+     << "\n";
+  os << indent << "EmptySpaceSkipping: " << this->EmptySpaceSkipping << "\n";
+  os << indent << "EmptySpaceSkippingBrickSize: " << this->EmptySpaceSkippingBrickSize << "\n";
+}
+
+//------------------------------------------------------------------------------
+bool vtkOpenGLGPUVolumeRayCastMapper::GetShaderCompilationPending()
+{
+  return this->Impl->PendingShaderProgram != nullptr;
 }
 
 void vtkOpenGLGPUVolumeRayCastMapper::SetSharedDepthTexture(vtkTextureObject* nt)
@@ -2302,6 +2327,7 @@ void vtkOpenGLGPUVolumeRayCastMapper::ReleaseGraphicsResources(vtkWindow* window
 
   this->Impl->ReleaseGraphicsMaskTransfer(window);
   this->Impl->DeleteMaskTransfer();
+  this->Impl->PendingShaderProgram = nullptr;
 
   this->Impl->ReleaseResourcesTime.Modified();
 }
@@ -2645,6 +2671,24 @@ void vtkOpenGLGPUVolumeRayCastMapper::ReplaceShaderMasking(
       ren, this, vol, this->MaskInput, this->Impl->CurrentMask, this->MaskType, numComps));
 }
 
+//------------------------------------------------------------------------------
+void vtkOpenGLGPUVolumeRayCastMapper::ReplaceShaderEmptySpaceSkipping(
+  std::map<vtkShader::Type, vtkShader*>& shaders, vtkRenderer* ren, vtkVolume* vol,
+  int vtkNotUsed(numComps))
+{
+  vtkShader* fragmentShader = shaders[vtkShader::Fragment];
+
+  this->Impl->EmptySpaceSkippingInShader = this->Impl->UseEmptySpaceSkipping();
+
+  vtkShaderProgram::Substitute(fragmentShader, "//VTK::EmptySpaceSkipping::Dec",
+    vtkvolume::EmptySpaceSkippingDeclaration(
+      ren, this, vol, this->Impl->EmptySpaceSkippingInShader));
+
+  vtkShaderProgram::Substitute(fragmentShader, "//VTK::EmptySpaceSkipping::Impl",
+    vtkvolume::EmptySpaceSkippingImplementation(
+      ren, this, vol, this->Impl->EmptySpaceSkippingInShader));
+}
+
 //------------------------------------------------------------------------------
 void vtkOpenGLGPUVolumeRayCastMapper::ReplaceShaderPicking(
   std::map<vtkShader::Type, vtkShader*>& shaders, vtkRenderer* ren, vtkVolume* vol,
@@ -2780,6 +2824,10 @@ void vtkOpenGLGPUVolumeRayCastMapper::ReplaceShaderValues(
   //---------------------------------------------------------------------------
   this->ReplaceShaderMasking(shaders, ren, vol, noOfComponents);
 
+  // Empty space skipping replacements
+  //---------------------------------------------------------------------------
+  this->ReplaceShaderEmptySpaceSkipping(shaders, ren, vol, noOfComponents);
+
   // Picking replacements
   //---------------------------------------------------------------------------
   this->ReplaceShaderPicking(shaders, ren, vol, noOfComponents);
@@ -2850,7 +2898,27 @@ void vtkOpenGLGPUVolumeRayCastMapper::BuildShader(vtkRenderer* ren)
 
   // Now compile the shader
   //--------------------------------------------------------------------------
-  this->Impl->ShaderProgram = this->Impl->ShaderCache->ReadyShaderProgram(shaders);
+  vtkShaderProgram* lastProgram = this->Impl->ShaderProgram;
+  this->Impl->PendingShaderProgram = nullptr;
+  if (this->Impl->BuildShaderAsynchronously && lastProgram && lastProgram->GetCompiled() &&
+    !this->Impl->NeedToInitializeResources)
+  {
+    vtkShaderProgram* program = this->Impl->ShaderCache->ReadyShaderProgramAsynchronously(shaders);
+    if (program && program->GetCompilePending())
+    {
+      // keep rendering with the last program until the new one is ready
+      this->Impl->PendingShaderProgram = program;
+      this->Impl->ShaderCache->ReadyShaderProgram(lastProgram);
+    }
+    else
+    {
+      this->Impl->ShaderProgram = program;
+    }
+  }
+  else
+  {
+    this->Impl->ShaderProgram = this->Impl->ShaderCache->ReadyShaderProgram(shaders);
+  }
   if (!this->Impl->ShaderProgram || !this->Impl->ShaderProgram->GetCompiled())
   {
     vtkErrorMacro("Shader failed to compile");
@@ -3047,9 +3115,17 @@ bool vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::UpdateInputs(vtkRenderer* ren
       this->Parent->ScalarMode, this->Parent->ArrayAccessMode, this->Parent->ArrayId,
       this->Parent->ArrayName, this->Parent->CellFlag);
 
+    // The volume is split again when the partitions change.
+    const auto& loadedPartitions = it->second.Texture->GetPartitions();
+    const bool partitionsChanged =
+      loadedPartitions[0] != std::max<int>(this->Partitions[0], 1) ||
+      loadedPartitions[1] != std::max<int>(this->Partitions[1], 1) ||
+      loadedPartitions[2] != std::max<int>(this->Partitions[2], 1);
+
     if (this->NeedToInitializeResources || (input->GetMTime() > it->second.Texture->UploadTime) ||
       (scalars != it->second.Texture->GetLoadedScalars()) ||
-      (scalars != nullptr && scalars->GetMTime() > it->second.Texture->UploadTime))
+      (scalars != nullptr && scalars->GetMTime() > it->second.Texture->UploadTime) ||
+      partitionsChanged)
     {
       auto& volInput = this->Parent->AssembledInputs[port];
       auto volumeTex = volInput.Texture.GetPointer();
@@ -3063,6 +3139,9 @@ bool vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::UpdateInputs(vtkRenderer* ren
       // Update vtkVolumeTexture
       it->second.Texture->UpdateVolume(property);
     }
+    it->second.Texture->SetBrickSize(
+      this->Parent->EmptySpaceSkipping ? this->Parent->EmptySpaceSkippingBrickSize : 0);
+    it->second.Texture->UpdateOccupancy(ren, property->GetScalarOpacity(0));
 
     // Volume may have changed, so make sure the helper updates its reference to it.
     it->second.Volume = vol;
@@ -3276,10 +3355,29 @@ void vtkOpenGLGPUVolumeRayCastMapper::GPURender(vtkRenderer* ren, vtkVolume* vol
     if (this->Impl->ShaderRebuildNeeded(cam, vol, renderPassTime, ren))
     {
       this->Impl->LastProjectionParallel = cam->GetParallelProjection();
+      this->Impl->BuildShaderAsynchronously = this->AsynchronousShaderCompilation;
       this->BuildShader(ren);
+      this->Impl->BuildShaderAsynchronously = false;
     }
     else
     {
+      // Switch to the program compiled in the background once it is ready
+      if (this->Impl->PendingShaderProgram)
+      {
+        vtkShaderProgram* program = this->Impl->ShaderCache->ReadyShaderProgramAsynchronously(
+          this->Impl->PendingShaderProgram);
+        if (!program)
+        {
+          vtkErrorMacro("Shader failed to compile");
+          this->Impl->PendingShaderProgram = nullptr;
+        }
+        else if (!program->GetCompilePending())
+        {
+          this->Impl->ShaderProgram = program;
+          this->Impl->PendingShaderProgram = nullptr;
+        }
+      }
+
       // Bind the shader
       this->Impl->ShaderCache->ReadyShaderProgram(this->Impl->ShaderProgram);
       this->InvokeEvent(vtkCommand::UpdateShaderEvent, this->Impl->ShaderProgram);
@@ -3338,7 +3436,26 @@ bool vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::ShaderRebuildNeeded(
     this->SelectionStateTime.GetMTime() > this->ShaderBuildTime.GetMTime() ||
     renderPassTime > this->ShaderBuildTime ||
     ren->GetLights()->GetMTime() > this->ShaderBuildTime.GetMTime() ||
-    this->LastModifiedLightTime(ren->GetLights()) > this->ShaderBuildTime.GetMTime());
+    this->LastModifiedLightTime(ren->GetLights()) > this->ShaderBuildTime.GetMTime() ||
+    this->UseEmptySpaceSkipping() != this->EmptySpaceSkippingInShader);
+}
+
+//------------------------------------------------------------------------------
+bool vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::UseEmptySpaceSkipping()
+{
+  // The occupancy of the bricks is computed from the scalar opacity of a
+  // single component, which is the only one applied by the composite blending
+  // with a 1D transfer function.
+  if (!this->Parent->EmptySpaceSkipping || this->MultiVolume ||
+    this->Parent->AssembledInputs.size() != 1 ||
+    this->Parent->BlendMode != vtkVolumeMapper::COMPOSITE_BLEND || this->Parent->MaskInput)
+  {
+    return false;
+  }
+  auto& input = this->Parent->AssembledInputs.begin()->second;
+  vtkVolumeProperty* property = input.Volume->GetProperty();
+  return property->GetTransferFunctionMode() == vtkVolumeProperty::TF_1D &&
+    !property->GetUseClippedVoxelIntensity() && input.Texture->OccupancyTex != nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -3359,7 +3476,8 @@ void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::RenderWithDepthPass(
     renderPassTime > this->ShaderBuildTime ||
     shaderProperty->GetShaderMTime() > this->ShaderBuildTime ||
     ren->GetLights()->GetMTime() > this->ShaderBuildTime.GetMTime() ||
-    this->LastModifiedLightTime(ren->GetLights()) > this->ShaderBuildTime.GetMTime())
+    this->LastModifiedLightTime(ren->GetLights()) > this->ShaderBuildTime.GetMTime() ||
+    this->UseEmptySpaceSkipping() != this->EmptySpaceSkippingInShader)
   {
     this->LastProjectionParallel = cam->GetParallelProjection();
 
@@ -3506,6 +3624,18 @@ void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::BindTransformations(
         volTex->BlankingTex->Activate();
         prog->SetUniformi("in_blanking", volTex->BlankingTex->GetTextureUnit());
       }
+
+      if (this->EmptySpaceSkippingInShader && volTex->OccupancyTex)
+      {
+        volTex->OccupancyTex->Activate();
+        prog->SetUniformi("in_occupancy", volTex->OccupancyTex->GetTextureUnit());
+        float fvalue3[3];
+        vtkInternal::ToFloat(volTex->BrickedVolumeSize, fvalue3, 3);
+        prog->SetUniform3fv("in_occupancyVolumeSize", 1, &fvalue3);
+        vtkInternal::ToFloat(volTex->BrickGridSize, fvalue3, 3);
+        prog->SetUniform3fv("in_occupancyGridSize", 1, &fvalue3);
+        prog->SetUniformf("in_occupancyBrickSize", static_cast<float>(volTex->GetBrickSize()));
+      }
     }
 
     // Volume matrices (dataset to world)
@@ -3865,6 +3995,10 @@ void vtkOpenGLGPUVolumeRayCastMapper::vtkInternal::FinishRendering(const int num
   {
     auto& input = item.second;
     input.Texture->GetCurrentBlock()->TextureObject->Deactivate();
+    if (input.Texture->OccupancyTex)
+    {
+      input.Texture->OccupancyTex->Deactivate();
+    }
     input.DeactivateTransferFunction(this->Parent->BlendMode);
   }
 
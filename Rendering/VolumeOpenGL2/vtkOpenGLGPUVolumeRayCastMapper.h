@@ -146,6 +146,59 @@ public:
    */
   bool PreLoadData(vtkRenderer* ren, vtkVolume* vol);
 
+  ///@{
+  /**
+   * When on, and when the OpenGL driver supports parallel shader compilation
+   * (see vtkShaderProgram::IsParallelShaderCompileSupported()), the shader
+   * program required by a change of the rendering configuration (for
+   * instance toggling the shading or changing the blend mode) is compiled
+   * by the driver in the background, and the volume keeps being rendered
+   * with the previous shader program until the new one is ready, instead of
+   * stalling the frame. Until then, the rendering does not reflect the
+   * changes that required the new program; use GetShaderCompilationPending()
+   * to know whether to render again. The first shader program, and the ones
+   * of the depth pass, are always compiled before rendering. Off by default.
+   */
+  vtkSetMacro(AsynchronousShaderCompilation, bool);
+  vtkGetMacro(AsynchronousShaderCompilation, bool);
+  vtkBooleanMacro(AsynchronousShaderCompilation, bool);
+  ///@}
+
+  /**
+   * Return true while a shader program is compiled in the background, see
+   * SetAsynchronousShaderCompilation(). The volume must then be rendered
+   * again to use it once ready.
+   */
+  bool GetShaderCompilationPending();
+
+  ///@{
+  /**
+   * When on, the range of the scalars is computed for every brick of
+   * EmptySpaceSkippingBrickSize^3 voxels when the volume is loaded, and the
+   * rays skip the bricks where the scalar opacity transfer function is zero
+   * over that range. This speeds up the rendering of volumes that are mostly
+   * transparent, such as CT scans with a lot of air around the body, at the
+   * cost of a pass over the scalars when they are loaded. The skipping is
+   * only applied to single volumes of single component scalars, loaded in a
+   * single block, rendered with the composite blending and a 1D transfer
+   * function, and without a mask. The rendered image is unchanged. Off by
+   * default.
+   */
+  vtkSetMacro(EmptySpaceSkipping, bool);
+  vtkGetMacro(EmptySpaceSkipping, bool);
+  vtkBooleanMacro(EmptySpaceSkipping, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the size, in voxels, of the bricks used for empty space
+   * skipping. Smaller bricks fit the transparent regions more closely but
+   * increase the cost of the skipping test. Default is 16.
+   */
+  vtkSetClampMacro(EmptySpaceSkippingBrickSize, int, 4, 256);
+  vtkGetMacro(EmptySpaceSkippingBrickSize, int);
+  ///@}
+
   // Description:
   // Delete OpenGL objects.
   // \post done: this->OpenGLObjectsCreated==0
@@ -260,6 +313,8 @@ protected:
     std::map<vtkShader::Type, vtkShader*>& shaders, vtkRenderer* ren, vtkVolume* vol, int numComps);
   void ReplaceShaderMasking(
     std::map<vtkShader::Type, vtkShader*>& shaders, vtkRenderer* ren, vtkVolume* vol, int numComps);
+  void ReplaceShaderEmptySpaceSkipping(
+    std::map<vtkShader::Type, vtkShader*>& shaders, vtkRenderer* ren, vtkVolume* vol, int numComps);
   void ReplaceShaderPicking(
     std::map<vtkShader::Type, vtkShader*>& shaders, vtkRenderer* ren, vtkVolume* vol, int numComps);
   void ReplaceShaderRTT(
@@ -282,6 +337,9 @@ protected:
 
   double ReductionFactor;
   int CurrentPass;
+  bool AsynchronousShaderCompilation;
+  bool EmptySpaceSkipping;
+  int EmptySpaceSkippingBrickSize;
 
 public:
   using VolumeInput = vtkVolumeInputHelper;
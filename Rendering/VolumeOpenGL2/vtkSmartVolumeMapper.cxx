@@ -16,6 +16,7 @@
 #include "vtkImageResample.h"
 #include "vtkOSPRayVolumeInterface.h"
 #include "vtkObjectFactory.h"
+#include "vtkOpenGLGPUVolumeRayCastMapper.h"
 #include "vtkPiecewiseFunction.h"
 #include "vtkPointData.h"
 #include "vtkPointDataToCellData.h"
@@ -221,7 +222,11 @@ void vtkSmartVolumeMapper::Render(vtkRenderer* ren, vtkVolume* vol)
       this->RayCastMapper->Render(ren, vol);
       break;
     case vtkSmartVolumeMapper::GPURenderMode:
-      if (this->LowResGPUNecessary)
+      // In streaming mode, the still renders refine the image with the full
+      // resolution volume.
+      if (this->LowResGPUNecessary &&
+        (this->LowResMode != LowResModeStreaming ||
+          ren->GetRenderWindow()->GetDesiredUpdateRate() >= this->InteractiveUpdateRate))
       {
         usedMapper = this->GPULowResMapper;
       }
@@ -342,6 +347,7 @@ void vtkSmartVolumeMapper::ComputeRenderMode(vtkRenderer* ren, vtkVolume* vol)
   }
 
   double scale[3];
+  bool reduced;
   double spacing[3];
   if (auto imData = vtkImageData::SafeDownCast(this->GetInput()))
   {
@@ -490,10 +496,14 @@ void vtkSmartVolumeMapper::ComputeRenderMode(vtkRenderer* ren, vtkVolume* vol)
       // if the GPU mapper cannot hand the size of the volume.
       this->GPUMapper->GetReductionRatio(scale);
 
+      // In streaming mode, the full resolution volume is split in partitions
+      // that fit in the GPU memory
+      reduced = scale[0] != 1.0 || scale[1] != 1.0 || scale[2] != 1.0;
+      this->SetupStreamingPartitions(LowResMode == LowResModeStreaming && reduced);
+
       // if any of the scale factors is not 1.0, then we do need
       // to use the low res mapper for interactive rendering
-      if (LowResMode == LowResModeResample &&
-        (scale[0] != 1.0 || scale[1] != 1.0 || scale[2] != 1.0))
+      if ((LowResMode == LowResModeResample || LowResMode == LowResModeStreaming) && reduced)
       {
         this->LowResGPUNecessary = 1;
         this->ConnectFilterInput(this->GPUResampleFilter);
@@ -543,6 +553,49 @@ void vtkSmartVolumeMapper::ComputeRenderMode(vtkRenderer* ren, vtkVolume* vol)
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkSmartVolumeMapper::SetupStreamingPartitions(bool streaming)
+{
+  auto glMapper = vtkOpenGLGPUVolumeRayCastMapper::SafeDownCast(this->GPUMapper);
+  if (!glMapper || (!streaming && !this->StreamingPartitions))
+  {
+    return;
+  }
+  this->StreamingPartitions = streaming;
+
+  int partitions[3] = { 1, 1, 1 };
+  vtkImageData* image = vtkImageData::SafeDownCast(this->GPUMapper->GetInput());
+  if (streaming && image)
+  {
+    // Split the longest side of the partitions until they fit in the memory
+    // budget.
+    int dims[3];
+    image->GetDimensions(dims);
+    const double size = static_cast<double>(dims[0]) * dims[1] * dims[2] *
+      image->GetScalarSize() * image->GetNumberOfScalarComponents();
+    const double maxSize =
+      static_cast<double>(this->MaxMemoryInBytes) * static_cast<double>(this->MaxMemoryFraction);
+    while (size / (static_cast<double>(partitions[0]) * partitions[1] * partitions[2]) > maxSize)
+    {
+      int axis = 0;
+      for (int i = 1; i < 3; ++i)
+      {
+        if (dims[i] / partitions[i] > dims[axis] / partitions[axis])
+        {
+          axis = i;
+        }
+      }
+      if (dims[axis] / partitions[axis] < 4 || partitions[axis] >= VTK_UNSIGNED_SHORT_MAX)
+      {
+        break;
+      }
+      ++partitions[axis];
+    }
+  }
+  glMapper->SetPartitions(static_cast<unsigned short>(partitions[0]),
+    static_cast<unsigned short>(partitions[1]), static_cast<unsigned short>(partitions[2]));
+}
+
 //------------------------------------------------------------------------------
 void vtkSmartVolumeMapper::ComputeMagnitudeCellData(vtkDataSet* input, vtkDataArray* arr)
 {
@@ -932,6 +985,7 @@ void vtkSmartVolumeMapper::PrintSelf(ostream& os, vtkIndent indent)
   os << "InterpolationMode: " << this->InterpolationMode << endl;
   os << "MaxMemoryInBytes:" << this->MaxMemoryInBytes << endl;
   os << "MaxMemoryFraction:" << this->MaxMemoryFraction << endl;
+  os << "LowResMode: " << this->LowResMode << endl;
   os << "AutoAdjustSampleDistances: " << this->AutoAdjustSampleDistances << endl;
   os << indent << "SampleDistance: " << this->SampleDistance << endl;
 }
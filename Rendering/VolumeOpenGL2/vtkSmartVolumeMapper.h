@@ -374,12 +374,17 @@ public:
    * LowResResample enable low res mode by automatically resampling the volume,
    * this enable large volume to be displayed at higher frame rate at the cost of
    * rendering quality
+   * LowResStreaming renders the resampled volume while interacting (when the
+   * desired update rate of the render window is at least InteractiveUpdateRate),
+   * and refines the still renders with the full resolution volume, streamed
+   * to the GPU in partitions that each fit in the memory budget.
    * Actual resample factor will be determined using MaxMemoryInBytes and MaxMemoryFraction
    */
   enum LowResModeType
   {
     LowResModeDisabled = 0,
     LowResModeResample = 1,
+    LowResModeStreaming = 2,
   };
 
   vtkSetMacro(LowResMode, int);
@@ -478,6 +483,13 @@ protected:
    */
   void ComputeRenderMode(vtkRenderer* ren, vtkVolume* vol);
 
+  /**
+   * Split the input of the GPU mapper in partitions that fit in the memory
+   * budget when streaming is true, or render it in a single block again if
+   * it was split.
+   */
+  void SetupStreamingPartitions(bool streaming);
+
   /**
    * Expose GPU mapper for additional customization.
    */
@@ -573,6 +585,10 @@ protected:
 
   int LowResMode = LowResModeDisabled;
 
+  // Whether the GPU mapper renders its input in partitions for the streaming
+  // mode.
+  bool StreamingPartitions = false;
+
 private:
   ///@{
   /**
@@ -3701,6 +3701,55 @@ inline std::string BinaryMaskImplementation(vtkRenderer* vtkNotUsed(ren),
   }
 }
 
+//--------------------------------------------------------------------------
+inline std::string EmptySpaceSkippingDeclaration(vtkRenderer* vtkNotUsed(ren),
+  vtkVolumeMapper* vtkNotUsed(mapper), vtkVolume* vtkNotUsed(vol), bool emptySpaceSkipping)
+{
+  if (!emptySpaceSkipping)
+  {
+    return std::string();
+  }
+  return std::string("\
+      \nuniform sampler3D in_occupancy;\
+      \nuniform vec3 in_occupancyVolumeSize;\
+      \nuniform vec3 in_occupancyGridSize;\
+      \nuniform float in_occupancyBrickSize;");
+}
+
+//--------------------------------------------------------------------------
+inline std::string EmptySpaceSkippingImplementation(vtkRenderer* vtkNotUsed(ren),
+  vtkVolumeMapper* vtkNotUsed(mapper), vtkVolume* vtkNotUsed(vol), bool emptySpaceSkipping)
+{
+  if (!emptySpaceSkipping)
+  {
+    return std::string();
+  }
+  // When the brick of the sample has no opacity, the ray is moved to the last
+  // sample in the brick. The step count is updated accordingly for the
+  // termination.
+  return std::string("\
+      \n    vec3 l_voxel = g_dataPos * in_occupancyVolumeSize - vec3(0.5);\
+      \n    vec3 l_brick = clamp(floor(l_voxel / in_occupancyBrickSize), vec3(0.0),\
+      \n      in_occupancyGridSize - vec3(1.0));\
+      \n    if (texelFetch(in_occupancy, ivec3(l_brick), 0).r == 0.0)\
+      \n    {\
+      \n      vec3 l_brickMin = (l_brick * in_occupancyBrickSize + vec3(0.5)) /\
+      \n        in_occupancyVolumeSize;\
+      \n      vec3 l_brickMax = ((l_brick + vec3(1.0)) * in_occupancyBrickSize + vec3(0.5)) /\
+      \n        in_occupancyVolumeSize;\
+      \n      vec3 l_dir = g_dirStep + vec3(equal(g_dirStep, vec3(0.0))) * 1e-20;\
+      \n      vec3 l_exit = max((l_brickMin - g_dataPos) / l_dir,\
+      \n        (l_brickMax - g_dataPos) / l_dir);\
+      \n      float l_steps = ceil(min(l_exit.x, min(l_exit.y, l_exit.z))) - 1.0;\
+      \n      if (l_steps > 0.0)\
+      \n      {\
+      \n        g_dataPos += l_steps * g_dirStep;\
+      \n        g_currentT += l_steps;\
+      \n      }\
+      \n      g_skip = true;\
+      \n    }");
+}
+
 //--------------------------------------------------------------------------
 inline std::string CompositeMaskDeclarationFragment(vtkRenderer* vtkNotUsed(ren),
   vtkVolumeMapper* vtkNotUsed(mapper), vtkVolume* vtkNotUsed(vol), vtkImageData* maskInput,
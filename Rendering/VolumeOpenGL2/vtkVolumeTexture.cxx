@@ -1,7 +1,10 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
+#include "vtkArrayDispatch.h"
 #include "vtkBlockSortHelper.h"
 #include "vtkCamera.h"
 #include "vtkDataArray.h"
@@ -13,8 +16,10 @@
 #include "vtkNew.h"
 #include "vtkOpenGLRenderWindow.h"
 #include "vtkOpenGLState.h"
+#include "vtkPiecewiseFunction.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRenderer.h"
+#include "vtkSMPTools.h"
 #include "vtkTextureObject.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
@@ -23,6 +28,89 @@
 #include "vtk_glad.h"
 
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// The first and last bricks of every voxel along an axis. The bricks overlap
+// by one voxel on each side so that the voxels interpolated by the samples of
+// a brick are all accounted for in its range.
+void ComputeVoxelBricks(int size, int brickSize, int gridSize, std::vector<int>& first,
+  std::vector<int>& last)
+{
+  first.resize(size);
+  last.resize(size);
+  for (int i = 0; i < size; ++i)
+  {
+    first[i] = i > 2 ? (i - 2) / brickSize : 0;
+    last[i] = std::min(gridSize - 1, (i + 1) / brickSize);
+  }
+}
+
+//------------------------------------------------------------------------------
+struct BrickRangesWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, const int size[3], int brickSize, const int gridSize[3],
+    std::vector<float>& ranges)
+  {
+    std::vector<int> first[3], last[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      ComputeVoxelBricks(size[axis], brickSize, gridSize[axis], first[axis], last[axis]);
+    }
+    const auto values = vtk::DataArrayValueRange<1>(array);
+
+    // Every layer of bricks along z is computed by a single thread.
+    vtkSMPTools::For(0, gridSize[2], [&](vtkIdType begin, vtkIdType end) {
+      std::vector<float> rowRanges(2 * gridSize[0]);
+      for (vtkIdType bz = begin; bz < end; ++bz)
+      {
+        const int k0 = std::max(0, static_cast<int>(bz) * brickSize - 1);
+        const int k1 = std::min(size[2] - 1, static_cast<int>(bz + 1) * brickSize + 1);
+        float* layer = ranges.data() + 2 * bz * gridSize[0] * gridSize[1];
+        for (int k = k0; k <= k1; ++k)
+        {
+          for (int j = 0; j < size[1]; ++j)
+          {
+            // The ranges of the row in every brick along x, merged in the
+            // bricks along y.
+            for (int bx = 0; bx < gridSize[0]; ++bx)
+            {
+              rowRanges[2 * bx] = std::numeric_limits<float>::max();
+              rowRanges[2 * bx + 1] = std::numeric_limits<float>::lowest();
+            }
+            vtkIdType index = (static_cast<vtkIdType>(k) * size[1] + j) * size[0];
+            for (int i = 0; i < size[0]; ++i, ++index)
+            {
+              const float value = static_cast<float>(values[index]);
+              if (std::isnan(value))
+              {
+                continue;
+              }
+              for (int bx = first[0][i]; bx <= last[0][i]; ++bx)
+              {
+                rowRanges[2 * bx] = std::min(rowRanges[2 * bx], value);
+                rowRanges[2 * bx + 1] = std::max(rowRanges[2 * bx + 1], value);
+              }
+            }
+            for (int by = first[1][j]; by <= last[1][j]; ++by)
+            {
+              float* brick = layer + 2 * by * gridSize[0];
+              for (int bx = 0; bx < gridSize[0]; ++bx)
+              {
+                brick[2 * bx] = std::min(brick[2 * bx], rowRanges[2 * bx]);
+                brick[2 * bx + 1] = std::max(brick[2 * bx + 1], rowRanges[2 * bx + 1]);
+              }
+            }
+          }
+        }
+      }
+    });
+  }
+};
+}
+
+//------------------------------------------------------------------------------
 vtkVolumeTexture::vtkVolumeTexture()
   : HandleLargeDataTypes(false)
   , InterpolationType(vtkTextureObject::Linear)
@@ -162,9 +250,150 @@ bool vtkVolumeTexture::LoadVolume(
   if (this->ImageDataBlocks.size() == 1)
   {
     VolumeBlock* onlyBlock = this->SortedVolumeBlocks.at(0);
-    return this->LoadTexture(this->InterpolationType, onlyBlock);
+    bool const success = this->LoadTexture(this->InterpolationType, onlyBlock);
+    this->ComputeBrickRanges();
+    return success;
+  }
+
+  this->ComputeBrickRanges();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkVolumeTexture::SetBrickSize(int size)
+{
+  size = std::max(size, 0);
+  if (size != this->BrickSize)
+  {
+    this->BrickSize = size;
+    this->ComputeBrickRanges();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkVolumeTexture::ComputeBrickRanges()
+{
+  this->BrickRanges.clear();
+  this->BrickGridSize[0] = this->BrickGridSize[1] = this->BrickGridSize[2] = 0;
+  this->BrickRangesTime.Modified();
+  if (this->BrickSize <= 0 || !this->Scalars || this->Scalars->GetNumberOfComponents() != 1 ||
+    this->ImageDataBlocks.size() != 1)
+  {
+    return;
   }
 
+  int size[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    size[axis] = this->FullSize[axis];
+    this->BrickedVolumeSize[axis] = size[axis];
+    this->BrickGridSize[axis] = (size[axis] + this->BrickSize - 1) / this->BrickSize;
+  }
+  if (this->Scalars->GetNumberOfTuples() != static_cast<vtkIdType>(size[0]) * size[1] * size[2])
+  {
+    this->BrickGridSize[0] = this->BrickGridSize[1] = this->BrickGridSize[2] = 0;
+    return;
+  }
+
+  const size_t numberOfBricks =
+    static_cast<size_t>(this->BrickGridSize[0]) * this->BrickGridSize[1] * this->BrickGridSize[2];
+  this->BrickRanges.resize(2 * numberOfBricks);
+  for (size_t i = 0; i < numberOfBricks; ++i)
+  {
+    this->BrickRanges[2 * i] = std::numeric_limits<float>::max();
+    this->BrickRanges[2 * i + 1] = std::numeric_limits<float>::lowest();
+  }
+
+  BrickRangesWorker worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(
+        this->Scalars, worker, size, this->BrickSize, this->BrickGridSize, this->BrickRanges))
+  {
+    worker(this->Scalars, size, this->BrickSize, this->BrickGridSize, this->BrickRanges);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkVolumeTexture::UpdateOccupancy(vtkRenderer* ren, vtkPiecewiseFunction* scalarOpacity)
+{
+  if (this->BrickRanges.empty() || !scalarOpacity)
+  {
+    if (this->OccupancyTex)
+    {
+      this->OccupancyTex->ReleaseGraphicsResources(ren->GetRenderWindow());
+      this->OccupancyTex = nullptr;
+    }
+    return false;
+  }
+  if (this->OccupancyTex && this->OccupancyTime > this->BrickRangesTime &&
+    this->OccupancyTime > scalarOpacity->GetMTime())
+  {
+    return true;
+  }
+
+  // The opacity is looked up in a table with a linear interpolation, so the
+  // ranges are widened by a fraction of the table range.
+  double opacityRange[2];
+  scalarOpacity->GetRange(opacityRange);
+  float dataRange[2] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() };
+  for (size_t i = 0; i < this->BrickRanges.size(); i += 2)
+  {
+    dataRange[0] = std::min(dataRange[0], this->BrickRanges[i]);
+    dataRange[1] = std::max(dataRange[1], this->BrickRanges[i + 1]);
+  }
+  const double margin = std::max(opacityRange[1] - opacityRange[0],
+                          static_cast<double>(dataRange[1]) - dataRange[0]) /
+    256.0;
+
+  // Between two nodes, the opacity is between the values of the nodes.
+  const int numberOfNodes = scalarOpacity->GetSize();
+  std::vector<double> nodes(2 * numberOfNodes);
+  for (int i = 0; i < numberOfNodes; ++i)
+  {
+    double node[4];
+    scalarOpacity->GetNodeValue(i, node);
+    nodes[2 * i] = node[0];
+    nodes[2 * i + 1] = node[1];
+  }
+
+  const size_t numberOfBricks = this->BrickRanges.size() / 2;
+  std::vector<unsigned char> occupancy(numberOfBricks, 0);
+  for (size_t i = 0; i < numberOfBricks; ++i)
+  {
+    if (this->BrickRanges[2 * i] > this->BrickRanges[2 * i + 1])
+    {
+      continue;
+    }
+    const double low = this->BrickRanges[2 * i] - margin;
+    const double high = this->BrickRanges[2 * i + 1] + margin;
+    double maxOpacity = std::max(scalarOpacity->GetValue(low), scalarOpacity->GetValue(high));
+    for (int n = 0; n < numberOfNodes && maxOpacity <= 0.0; ++n)
+    {
+      if (nodes[2 * n] >= low && nodes[2 * n] <= high)
+      {
+        maxOpacity = std::max(maxOpacity, nodes[2 * n + 1]);
+      }
+    }
+    occupancy[i] = maxOpacity > 0.0 ? 255 : 0;
+  }
+
+  if (!this->OccupancyTex)
+  {
+    this->OccupancyTex = vtkSmartPointer<vtkTextureObject>::New();
+    this->OccupancyTex->SetContext(vtkOpenGLRenderWindow::SafeDownCast(ren->GetRenderWindow()));
+  }
+  if (!this->OccupancyTex->Create3DFromRaw(this->BrickGridSize[0], this->BrickGridSize[1],
+        this->BrickGridSize[2], 1, VTK_UNSIGNED_CHAR, occupancy.data()))
+  {
+    this->OccupancyTex = nullptr;
+    return false;
+  }
+  this->OccupancyTex->SetWrapR(vtkTextureObject::ClampToEdge);
+  this->OccupancyTex->SetWrapS(vtkTextureObject::ClampToEdge);
+  this->OccupancyTex->SetWrapT(vtkTextureObject::ClampToEdge);
+  this->OccupancyTex->SetMagnificationFilter(vtkTextureObject::Nearest);
+  this->OccupancyTex->SetMinificationFilter(vtkTextureObject::Nearest);
+  this->OccupancyTex->Deactivate();
+  this->OccupancyTime.Modified();
   return true;
 }
 
@@ -578,6 +807,11 @@ void vtkVolumeTexture::ReleaseGraphicsResources(vtkWindow* win)
     this->Texture->ReleaseGraphicsResources(win);
     this->Texture = nullptr;
   }
+  if (this->OccupancyTex)
+  {
+    this->OccupancyTex->ReleaseGraphicsResources(win);
+    this->OccupancyTex = nullptr;
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -919,6 +1153,7 @@ void vtkVolumeTexture::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UploadTime: " << this->UploadTime << '\n';
   os << indent << "CurrentBlockIdx: " << this->CurrentBlockIdx << '\n';
   os << indent << "StreamBlocks: " << this->StreamBlocks << '\n';
+  os << indent << "BrickSize: " << this->BrickSize << '\n';
 }
 
 //------------------------------------------------------------------------------
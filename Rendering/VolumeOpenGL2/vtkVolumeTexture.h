@@ -67,6 +67,7 @@ VTK_ABI_NAMESPACE_BEGIN
 class vtkDataArray;
 class vtkDataSet;
 class vtkImageData;
+class vtkPiecewiseFunction;
 class vtkRenderer;
 class vtkTextureObject;
 class vtkVolumeProperty;
@@ -193,6 +194,29 @@ public:
 
   vtkSmartPointer<vtkTextureObject> BlankingTex;
 
+  ///@{
+  /**
+   * Set the size, in voxels, of the bricks whose scalar range is computed
+   * when the volume is loaded, for empty space skipping. The ranges are only
+   * computed for single block volumes of single component scalars, and
+   * cleared if the size is 0 (the default).
+   */
+  void SetBrickSize(int size);
+  int GetBrickSize() { return this->BrickSize; }
+  ///@}
+
+  /**
+   * Update OccupancyTex, the texture holding one texel per brick which is
+   * zero if the scalar opacity is zero over the range of the brick. Return
+   * false, and release the texture, if the brick ranges are not computed.
+   * Requires an active OpenGL context.
+   */
+  bool UpdateOccupancy(vtkRenderer* ren, vtkPiecewiseFunction* scalarOpacity);
+
+  vtkSmartPointer<vtkTextureObject> OccupancyTex;
+  int BrickGridSize[3] = { 0, 0, 0 };
+  int BrickedVolumeSize[3] = { 0, 0, 0 };
+
 protected:
   vtkVolumeTexture();
   ~vtkVolumeTexture() override;
@@ -274,6 +298,11 @@ private:
   void UpdateInterpolationType(int interpolation);
   void SetInterpolation(int interpolation);
 
+  /**
+   * Compute BrickRanges from the first component of the loaded scalars.
+   */
+  void ComputeBrickRanges();
+
   //----------------------------------------------------------------------------
   vtkTimeStamp UpdateTime;
 
@@ -290,6 +319,13 @@ private:
   Size3 Partitions;
 
   vtkDataArray* Scalars;
+
+  int BrickSize = 0;
+  // The minimum and maximum scalars of every brick, including the voxels
+  // interpolated at its faces.
+  std::vector<float> BrickRanges;
+  vtkTimeStamp BrickRangesTime;
+  vtkTimeStamp OccupancyTime;
 };
 
 VTK_ABI_NAMESPACE_END